@@ -0,0 +1,773 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the port
+#define TB_DEMO_PORT            (9090)
+
+// the loop count
+#define TB_DEMO_LOOP_MAXN       (4)
+
+// the message maxn
+#define TB_DEMO_MESG_MAXN       (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the server context type for the callback mode
+typedef struct __tb_demo_server_t
+{
+    // the aico
+    tb_aico_ref_t       aico;
+
+    // the data
+    tb_byte_t           data[TB_DEMO_MESG_MAXN];
+
+}tb_demo_server_t;
+
+// the client context type for the callback mode
+typedef struct __tb_demo_client_t
+{
+    // the aico
+    tb_aico_ref_t       aico;
+
+    // the index
+    tb_size_t           index;
+
+    // the message size
+    tb_size_t           size;
+
+    // the received size
+    tb_size_t           read;
+
+    // the message
+    tb_char_t           mesg[TB_DEMO_MESG_MAXN];
+
+    // the echo data
+    tb_char_t           data[TB_DEMO_MESG_MAXN];
+
+}tb_demo_client_t;
+
+// the stream copy context type for the coroutine stream mode
+typedef struct __tb_demo_stream_t
+{
+    // the aicp
+    tb_aicp_ref_t       aicp;
+
+    // the input file path
+    tb_char_t           ipath[TB_PATH_MAXN];
+
+    // the output file path
+    tb_char_t           opath[TB_PATH_MAXN];
+
+    // the copied size
+    tb_hize_t           size;
+
+}tb_demo_stream_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the server address
+static tb_ipaddr_t      g_addr;
+
+// the round trip count of each client
+static tb_size_t        g_count = 10000;
+
+// the finished clients
+static tb_atomic_t      g_ok = 0;
+
+// the failed clients
+static tb_atomic_t      g_failed = 0;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * callback implementation
+ */
+static tb_bool_t tb_demo_callback_clos(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->aico && aice->code == TB_AICE_CODE_CLOS, tb_false);
+
+    // exit aico
+    tb_aico_exit(aice->aico);
+
+    // exit context
+    if (aice->priv) tb_free((tb_pointer_t)aice->priv);
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_demo_callback_server_recv(tb_aice_ref_t aice);
+static tb_bool_t tb_demo_callback_server_send(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_SEND, tb_false);
+
+    // the server
+    tb_demo_server_t* server = (tb_demo_server_t*)aice->priv;
+    tb_assert_and_check_return_val(server, tb_false);
+
+    // closed or failed?
+    if (aice->state != TB_STATE_OK) return tb_aico_clos(aice->aico, tb_demo_callback_clos, server);
+
+    // post recv
+    return tb_aico_recv(aice->aico, server->data, sizeof(server->data), tb_demo_callback_server_recv, server);
+}
+static tb_bool_t tb_demo_callback_server_recv(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_RECV, tb_false);
+
+    // the server
+    tb_demo_server_t* server = (tb_demo_server_t*)aice->priv;
+    tb_assert_and_check_return_val(server, tb_false);
+
+    // closed or failed?
+    if (aice->state != TB_STATE_OK) return tb_aico_clos(aice->aico, tb_demo_callback_clos, server);
+
+    // echo it, the aico sends all data
+    return tb_aico_send(aice->aico, server->data, aice->u.recv.real, tb_demo_callback_server_send, server);
+}
+static tb_bool_t tb_demo_callback_acpt(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_ACPT, tb_false);
+
+    // killed or failed? clos the listening aico
+    if (aice->state != TB_STATE_OK) return tb_aico_clos(aice->aico, tb_demo_callback_clos, tb_null);
+
+    // make server
+    tb_demo_server_t* server = tb_malloc0_type(tb_demo_server_t);
+    tb_assert_and_check_return_val(server, tb_true);
+
+    // post recv
+    server->aico = aice->u.acpt.aico;
+    if (!tb_aico_recv(server->aico, server->data, sizeof(server->data), tb_demo_callback_server_recv, server))
+        tb_aico_clos(server->aico, tb_demo_callback_clos, server);
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_demo_callback_client_send(tb_aice_ref_t aice);
+static tb_bool_t tb_demo_callback_client_next(tb_demo_client_t* client)
+{
+    // finished?
+    if (client->index == g_count)
+    {
+        tb_atomic_fetch_and_inc(&g_ok);
+        return tb_aico_clos(client->aico, tb_demo_callback_clos, client);
+    }
+
+    // post send
+    client->size = tb_snprintf(client->mesg, sizeof(client->mesg), "hello %lu", client->index);
+    client->read = 0;
+    return tb_aico_send(client->aico, (tb_byte_t const*)client->mesg, client->size, tb_demo_callback_client_send, client);
+}
+static tb_bool_t tb_demo_callback_client_failed(tb_demo_client_t* client)
+{
+    tb_atomic_fetch_and_inc(&g_failed);
+    return tb_aico_clos(client->aico, tb_demo_callback_clos, client);
+}
+static tb_bool_t tb_demo_callback_client_recv(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_RECV, tb_false);
+
+    // the client
+    tb_demo_client_t* client = (tb_demo_client_t*)aice->priv;
+    tb_assert_and_check_return_val(client, tb_false);
+
+    // closed or failed?
+    if (aice->state != TB_STATE_OK) return tb_demo_callback_client_failed(client);
+
+    // continue to recv it?
+    client->read += aice->u.recv.real;
+    if (client->read < client->size)
+        return tb_aico_recv(client->aico, (tb_byte_t*)client->data + client->read, client->size - client->read, tb_demo_callback_client_recv, client);
+
+    // check echo
+    if (tb_memcmp(client->mesg, client->data, client->size)) return tb_demo_callback_client_failed(client);
+
+    // next
+    client->index++;
+    return tb_demo_callback_client_next(client);
+}
+static tb_bool_t tb_demo_callback_client_send(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_SEND, tb_false);
+
+    // the client
+    tb_demo_client_t* client = (tb_demo_client_t*)aice->priv;
+    tb_assert_and_check_return_val(client, tb_false);
+
+    // closed or failed?
+    if (aice->state != TB_STATE_OK) return tb_demo_callback_client_failed(client);
+
+    // post recv
+    return tb_aico_recv(client->aico, (tb_byte_t*)client->data, client->size, tb_demo_callback_client_recv, client);
+}
+static tb_bool_t tb_demo_callback_client_conn(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_CONN, tb_false);
+
+    // the client
+    tb_demo_client_t* client = (tb_demo_client_t*)aice->priv;
+    tb_assert_and_check_return_val(client, tb_false);
+
+    // closed or failed?
+    if (aice->state != TB_STATE_OK) return tb_demo_callback_client_failed(client);
+
+    // send the first message
+    return tb_demo_callback_client_next(client);
+}
+static tb_bool_t tb_demo_callback_client_start(tb_aicp_ref_t aicp)
+{
+    // make client
+    tb_demo_client_t* client = tb_malloc0_type(tb_demo_client_t);
+    tb_assert_and_check_return_val(client, tb_false);
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // init aico
+        client->aico = tb_aico_init(aicp);
+        tb_assert_and_check_break(client->aico);
+
+        // open aico
+        if (!tb_aico_open_sock_from_type(client->aico, TB_SOCKET_TYPE_TCP, tb_ipaddr_family(&g_addr))) break;
+
+        // post conn
+        if (!tb_aico_conn(client->aico, &g_addr, tb_demo_callback_client_conn, client)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        if (client->aico) tb_aico_exit(client->aico);
+        tb_free(client);
+    }
+
+    // ok?
+    return ok;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * rpool implementation
+ */
+static tb_bool_t tb_demo_rpool_server_recv(tb_aice_ref_t aice);
+static tb_bool_t tb_demo_rpool_server_send(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_SEND, tb_false);
+
+    // free the recv buffer of the pool after sending it
+    tb_aicp_rpool_free(tb_aico_aicp(aice->aico), (tb_byte_t*)aice->u.send.data);
+
+    // closed or failed?
+    if (aice->state != TB_STATE_OK) return tb_aico_clos(aice->aico, tb_demo_callback_clos, tb_null);
+
+    // post recv without buffer, the idle connection holds no buffer
+    return tb_aico_recv(aice->aico, tb_null, 0, tb_demo_rpool_server_recv, tb_null);
+}
+static tb_bool_t tb_demo_rpool_server_recv(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_RECV, tb_false);
+
+    // closed or failed? no buffer has been taken from the pool if no data is received
+    if (aice->state != TB_STATE_OK)
+    {
+        if (aice->u.recv.data) tb_aicp_rpool_free(tb_aico_aicp(aice->aico), aice->u.recv.data);
+        return tb_aico_clos(aice->aico, tb_demo_callback_clos, tb_null);
+    }
+
+    // echo the buffer of the pool, the aico sends all data
+    tb_assert_and_check_return_val(aice->u.recv.data, tb_false);
+    if (!tb_aico_send(aice->aico, aice->u.recv.data, aice->u.recv.real, tb_demo_rpool_server_send, tb_null))
+    {
+        tb_aicp_rpool_free(tb_aico_aicp(aice->aico), aice->u.recv.data);
+        return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_demo_rpool_acpt(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_ACPT, tb_false);
+
+    // killed or failed? clos the listening aico
+    if (aice->state != TB_STATE_OK) return tb_aico_clos(aice->aico, tb_demo_callback_clos, tb_null);
+
+    // post recv without buffer
+    if (!tb_aico_recv(aice->u.acpt.aico, tb_null, 0, tb_demo_rpool_server_recv, tb_null))
+        tb_aico_clos(aice->u.acpt.aico, tb_demo_callback_clos, tb_null);
+
+    // ok
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * coroutine implementation
+ */
+static tb_void_t tb_demo_coroutine_server(tb_cpointer_t priv)
+{
+    // the aico
+    tb_aico_ref_t aico = (tb_aico_ref_t)priv;
+    tb_assert_and_check_return(aico);
+
+    // echo it
+    tb_long_t real = 0;
+    tb_byte_t data[TB_DEMO_MESG_MAXN];
+    while ((real = tb_co_recv(aico, data, sizeof(data))) > 0)
+    {
+        if (tb_co_send(aico, data, real) != real) break;
+    }
+
+    // exit aico
+    tb_co_clos(aico);
+    tb_aico_exit(aico);
+}
+static tb_bool_t tb_demo_coroutine_acpt(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_ACPT, tb_false);
+
+    // killed or failed? clos the listening aico
+    if (aice->state != TB_STATE_OK) return tb_aico_clos(aice->aico, tb_demo_callback_clos, tb_null);
+
+    // start a coroutine for this client
+    if (!tb_co_start(tb_aico_aicp(aice->aico), tb_demo_coroutine_server, aice->u.acpt.aico, 0))
+        tb_aico_clos(aice->u.acpt.aico, tb_demo_callback_clos, tb_null);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_demo_coroutine_client(tb_cpointer_t priv)
+{
+    // the aicp
+    tb_aicp_ref_t aicp = (tb_aicp_ref_t)priv;
+    tb_assert_and_check_return(aicp);
+
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_aico_ref_t   aico = tb_null;
+    do
+    {
+        // init aico
+        aico = tb_aico_init(aicp);
+        tb_assert_and_check_break(aico);
+
+        // open aico
+        if (!tb_aico_open_sock_from_type(aico, TB_SOCKET_TYPE_TCP, tb_ipaddr_family(&g_addr))) break;
+
+        // conn it
+        if (!tb_co_conn(aico, &g_addr)) break;
+
+        // send and recv the messages
+        tb_size_t index = 0;
+        for (index = 0; index < g_count; index++)
+        {
+            // send message
+            tb_char_t mesg[TB_DEMO_MESG_MAXN];
+            tb_size_t size = tb_snprintf(mesg, sizeof(mesg), "hello %lu", index);
+            if (tb_co_send(aico, (tb_byte_t const*)mesg, size) != size) break;
+
+            // recv echo
+            tb_char_t data[TB_DEMO_MESG_MAXN];
+            tb_size_t read = 0;
+            while (read < size)
+            {
+                tb_long_t real = tb_co_recv(aico, (tb_byte_t*)data + read, size - read);
+                tb_check_break(real > 0);
+                read += real;
+            }
+
+            // check echo
+            if (read < size || tb_memcmp(mesg, data, size)) break;
+        }
+
+        // ok?
+        ok = (index == g_count);
+
+    } while (0);
+
+    // save result
+    tb_atomic_fetch_and_inc(ok? &g_ok : &g_failed);
+
+    // exit aico
+    if (aico)
+    {
+        tb_co_clos(aico);
+        tb_aico_exit(aico);
+    }
+}
+
+static tb_void_t tb_demo_coroutine_sleep(tb_cpointer_t priv)
+{
+    // sleep some times, the task aico will be exited when the coroutine is finished
+    tb_size_t i = 0;
+    for (i = 0; i < 3; i++) tb_co_sleep(10 + ((tb_size_t)priv + i) % 50);
+
+    // ok
+    tb_atomic_fetch_and_inc(&g_ok);
+}
+
+static tb_void_t tb_demo_coroutine_stream(tb_cpointer_t priv)
+{
+    // check
+    tb_demo_stream_t* copy = (tb_demo_stream_t*)priv;
+    tb_assert_and_check_return(copy && copy->aicp);
+
+    // done
+    tb_async_stream_ref_t   istream = tb_null;
+    tb_async_stream_ref_t   ostream = tb_null;
+    tb_bool_t               ok = tb_false;
+    do
+    {
+        // init stream
+        istream = tb_async_stream_init_from_file(copy->aicp, copy->ipath, TB_FILE_MODE_RO | TB_FILE_MODE_BINARY);
+        ostream = tb_async_stream_init_from_file(copy->aicp, copy->opath, TB_FILE_MODE_RW | TB_FILE_MODE_CREAT | TB_FILE_MODE_BINARY | TB_FILE_MODE_TRUNC);
+        tb_assert_and_check_break(istream && ostream);
+
+        // open stream
+        if (!tb_co_stream_open(istream) || !tb_co_stream_open(ostream)) break;
+
+        // copy it
+        tb_long_t real = 0;
+        tb_byte_t data[4096];
+        while ((real = tb_co_stream_read(istream, data, sizeof(data))) > 0)
+        {
+            if (!tb_co_stream_writ(ostream, data, real)) break;
+            copy->size += real;
+        }
+
+        // not end?
+        if (real >= 0 || tb_co_state() != TB_STATE_CLOSED) break;
+
+        // sync the cached data before closing it
+        if (!tb_co_stream_sync(ostream, tb_true)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // exit stream
+    if (istream)
+    {
+        tb_co_stream_clos(istream);
+        tb_async_stream_exit(istream);
+    }
+    if (ostream)
+    {
+        tb_co_stream_clos(ostream);
+        tb_async_stream_exit(ostream);
+    }
+
+    // ok?
+    tb_atomic_fetch_and_inc(ok? &g_ok : &g_failed);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_pointer_t tb_demo_loop(tb_cpointer_t priv)
+{
+    // loop aicp
+    tb_aicp_ref_t aicp = (tb_aicp_ref_t)priv;
+    if (aicp) tb_aicp_loop(aicp);
+
+    // exit
+    tb_thread_return(tb_null);
+    return tb_null;
+}
+static tb_void_t tb_demo_sleep(tb_size_t count)
+{
+    // init aicp
+    tb_aicp_ref_t aicp = tb_aicp_init(count + 16);
+    tb_assert_and_check_return(aicp);
+
+    // done loop
+    tb_size_t       i = 0;
+    tb_thread_ref_t loop[TB_DEMO_LOOP_MAXN] = {tb_null};
+    for (i = 0; i < TB_DEMO_LOOP_MAXN; i++) loop[i] = tb_thread_init(tb_null, tb_demo_loop, aicp, 0);
+
+    // start coroutines
+    tb_hong_t time = tb_mclock();
+    for (i = 0; i < count; i++)
+    {
+        if (!tb_co_start(aicp, tb_demo_coroutine_sleep, (tb_cpointer_t)i, 0)) tb_atomic_fetch_and_inc(&g_failed);
+    }
+
+    // wait coroutines
+    while ((tb_size_t)(tb_atomic_get(&g_ok) + tb_atomic_get(&g_failed)) < count) tb_msleep(10);
+    time = tb_mclock() - time;
+
+    // trace
+    tb_trace_i("sleep: coroutines: %lu, ok: %ld, failed: %ld, time: %lld ms", count, tb_atomic_get(&g_ok), tb_atomic_get(&g_failed), time);
+
+    // kill aicp
+    tb_aicp_kill(aicp);
+
+    // wait loop
+    for (i = 0; i < TB_DEMO_LOOP_MAXN; i++)
+    {
+        if (loop[i])
+        {
+            tb_thread_wait(loop[i], -1);
+            tb_thread_exit(loop[i]);
+        }
+    }
+
+    // exit aicp
+    tb_aicp_exit(aicp);
+}
+
+static tb_bool_t tb_demo_stream_file_make(tb_char_t const* path, tb_hize_t size)
+{
+    // init file
+    tb_file_ref_t file = tb_file_init(path, TB_FILE_MODE_RW | TB_FILE_MODE_CREAT | TB_FILE_MODE_BINARY | TB_FILE_MODE_TRUNC);
+    tb_assert_and_check_return_val(file, tb_false);
+
+    // writ data
+    tb_hize_t writ = 0;
+    tb_byte_t data[4096];
+    while (writ < size)
+    {
+        tb_size_t i = 0;
+        tb_size_t n = (tb_size_t)tb_min(size - writ, sizeof(data));
+        for (i = 0; i < n; i++) data[i] = (tb_byte_t)((writ + i) * 31 + ((writ + i) >> 12));
+        if (tb_file_writ(file, data, n) != n) break;
+        writ += n;
+    }
+
+    // exit file
+    tb_file_exit(file);
+
+    // ok?
+    return writ == size;
+}
+static tb_bool_t tb_demo_stream_file_same(tb_char_t const* ipath, tb_char_t const* opath)
+{
+    // init file
+    tb_file_ref_t ifile = tb_file_init(ipath, TB_FILE_MODE_RO | TB_FILE_MODE_BINARY);
+    tb_file_ref_t ofile = tb_file_init(opath, TB_FILE_MODE_RO | TB_FILE_MODE_BINARY);
+
+    // compare them
+    tb_bool_t ok = tb_false;
+    if (ifile && ofile && tb_file_size(ifile) == tb_file_size(ofile))
+    {
+        tb_byte_t   idata[4096];
+        tb_byte_t   odata[4096];
+        tb_long_t   real = 0;
+        while ((real = tb_file_read(ifile, idata, sizeof(idata))) > 0)
+        {
+            if (tb_file_read(ofile, odata, real) != real || tb_memcmp(idata, odata, real)) break;
+        }
+        ok = !real;
+    }
+
+    // exit file
+    if (ifile) tb_file_exit(ifile);
+    if (ofile) tb_file_exit(ofile);
+
+    // ok?
+    return ok;
+}
+static tb_void_t tb_demo_stream(tb_hize_t size)
+{
+    // init the file paths
+    tb_char_t           temp[TB_PATH_MAXN];
+    tb_demo_stream_t    copy = {0};
+    if (!tb_directory_temporary(temp, sizeof(temp))) return ;
+    tb_snprintf(copy.ipath, sizeof(copy.ipath) - 1, "%s/tb_demo_co_stream.in", temp);
+    tb_snprintf(copy.opath, sizeof(copy.opath) - 1, "%s/tb_demo_co_stream.out", temp);
+
+    // make the input file
+    if (!tb_demo_stream_file_make(copy.ipath, size)) return ;
+
+    // init aicp
+    copy.aicp = tb_aicp_init(16);
+    tb_assert_and_check_return(copy.aicp);
+
+    // done loop
+    tb_size_t       i = 0;
+    tb_thread_ref_t loop[TB_DEMO_LOOP_MAXN] = {tb_null};
+    for (i = 0; i < TB_DEMO_LOOP_MAXN; i++) loop[i] = tb_thread_init(tb_null, tb_demo_loop, copy.aicp, 0);
+
+    // copy it
+    tb_hong_t time = tb_mclock();
+    if (!tb_co_start(copy.aicp, tb_demo_coroutine_stream, &copy, 0)) tb_atomic_fetch_and_inc(&g_failed);
+
+    // wait it
+    while (!tb_atomic_get(&g_ok) && !tb_atomic_get(&g_failed)) tb_msleep(10);
+    time = tb_mclock() - time;
+
+    // kill aicp
+    tb_aicp_kill(copy.aicp);
+
+    // wait loop
+    for (i = 0; i < TB_DEMO_LOOP_MAXN; i++)
+    {
+        if (loop[i])
+        {
+            tb_thread_wait(loop[i], -1);
+            tb_thread_exit(loop[i]);
+        }
+    }
+
+    // exit aicp
+    tb_aicp_exit(copy.aicp);
+
+    // verify it
+    tb_bool_t ok = tb_atomic_get(&g_ok) && copy.size == size && tb_demo_stream_file_same(copy.ipath, copy.opath);
+
+    // trace
+    tb_trace_i("stream: copy: %llu/%llu bytes, time: %lld ms, %s", copy.size, size, time, ok? "ok" : "failed");
+
+    // remove the files
+    tb_file_remove(copy.ipath);
+    tb_file_remove(copy.opath);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ *
+ * benchmark the echo round trips of the callback and the coroutine api
+ *
+ * demo asio_co [callback|coroutine|rpool] [clients] [count]
+ *
+ * the rpool mode is the callback mode whose server posts recv without buffer from the recv buffer pool
+ *
+ * start many coroutines which sleep some times and exit
+ *
+ * demo asio_co sleep [coroutines]
+ *
+ * copy a file of the given size by the tb_co_stream_* interfaces in a coroutine and verify it
+ *
+ * demo asio_co stream [size]
+ */
+tb_int_t tb_demo_asio_co_main(tb_int_t argc, tb_char_t** argv)
+{
+    // sleep?
+    if (argv[1] && !tb_strcmp(argv[1], "sleep"))
+    {
+        tb_demo_sleep(argv[2]? tb_atoi(argv[2]) : 10000);
+        return 0;
+    }
+
+    // stream?
+    if (argv[1] && !tb_strcmp(argv[1], "stream"))
+    {
+        tb_demo_stream(argv[2]? tb_atoll(argv[2]) : 3000000);
+        return 0;
+    }
+
+    // the arguments
+    tb_bool_t rpool     = (argv[1] && !tb_strcmp(argv[1], "rpool"))? tb_true : tb_false;
+    tb_bool_t coroutine = !(argv[1] && (rpool || !tb_strcmp(argv[1], "callback")));
+    tb_size_t clients   = (argv[1] && argv[2])? tb_atoi(argv[2]) : 10;
+    if (argv[1] && argv[2] && argv[3]) g_count = tb_atoi(argv[3]);
+    tb_assert_and_check_return_val(clients && g_count, 0);
+
+    // init
+    tb_aicp_ref_t       aicp = tb_null;
+    tb_aico_ref_t       aico = tb_null;
+    tb_thread_ref_t     loop[TB_DEMO_LOOP_MAXN + 1] = {tb_null};
+    do
+    {
+        // init aicp
+        aicp = tb_aicp_init((clients << 1) + 16);
+        tb_assert_and_check_break(aicp);
+
+        // init the recv buffer pool
+        if (rpool && !tb_aicp_rpool_init(aicp, TB_DEMO_MESG_MAXN)) break;
+
+        // init sock aico
+        aico = tb_aico_init(aicp);
+        tb_assert_and_check_break(aico);
+
+        // init addr
+        tb_ipaddr_set(&g_addr, "127.0.0.1", TB_DEMO_PORT, TB_IPADDR_FAMILY_IPV4);
+
+        // open sock aico
+        if (!tb_aico_open_sock_from_type(aico, TB_SOCKET_TYPE_TCP, tb_ipaddr_family(&g_addr))) break;
+
+        // bind port
+        if (!tb_socket_bind(tb_aico_sock(aico), &g_addr)) break;
+
+        // listen sock
+        if (!tb_socket_listen(tb_aico_sock(aico), 1024)) break;
+
+        // post acpt
+        if (!tb_aico_acpt(aico, coroutine? tb_demo_coroutine_acpt : (rpool? tb_demo_rpool_acpt : tb_demo_callback_acpt), tb_null)) break;
+
+        // done loop
+        tb_size_t i = 0;
+        for (i = 0; i < TB_DEMO_LOOP_MAXN; i++) loop[i] = tb_thread_init(tb_null, tb_demo_loop, aicp, 0);
+
+        // start clients
+        tb_hong_t time = tb_mclock();
+        for (i = 0; i < clients; i++)
+        {
+            tb_bool_t ok = coroutine? tb_co_start(aicp, tb_demo_coroutine_client, aicp, 0) : tb_demo_callback_client_start(aicp);
+            if (!ok) tb_atomic_fetch_and_inc(&g_failed);
+        }
+
+        // wait clients
+        while ((tb_size_t)(tb_atomic_get(&g_ok) + tb_atomic_get(&g_failed)) < clients) tb_msleep(10);
+        time = tb_mclock() - time;
+
+        // trace
+        tb_trace_i("%s: clients: %lu, ok: %ld, failed: %ld, round trips: %lu, time: %lld ms, %lld trips/s"
+                   , coroutine? "coroutine" : (rpool? "rpool" : "callback")
+                   , clients
+                   , tb_atomic_get(&g_ok)
+                   , tb_atomic_get(&g_failed)
+                   , clients * g_count
+                   , time
+                   , ((tb_hong_t)(clients * g_count) * 1000) / tb_max(time, 1));
+
+    } while (0);
+
+    // exit aicp
+    if (aicp)
+    {
+        // kill all
+        tb_aicp_kill_all(aicp);
+
+        // wait all
+        tb_aicp_wait_all(aicp, -1);
+
+        // kill aicp
+        tb_aicp_kill(aicp);
+    }
+
+    // wait loop
+    tb_thread_ref_t* l = loop;
+    for (; *l; l++)
+    {
+        tb_thread_wait(*l, -1);
+        tb_thread_exit(*l);
+    }
+
+    // exit aicp
+    if (aicp) tb_aicp_exit(aicp);
+    return 0;
+}
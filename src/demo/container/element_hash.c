@@ -0,0 +1,130 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_void_t tb_demo_element_hash_test_data(tb_byte_t const* data, tb_size_t size)
+{
+    // the element
+    tb_element_t element = tb_element_mem(size, tb_null, tb_null);
+    element.seed = 0x12345678;
+
+    // done
+    __tb_volatile__ tb_size_t   i = 0;
+    __tb_volatile__ tb_size_t   n = 1000000;
+    __tb_volatile__ tb_size_t   v = 0;
+    tb_uint64_t                 t = tb_cycle();
+    for (i = 0; i < n; i++) v += element.hash(&element, data + (i & 7), TB_MAXU32, 0);
+    t = tb_cycle() - t;
+
+    // trace
+    tb_hong_t ns = tb_cycle_to_nclock(t);
+    tb_trace_i("data: size: %lu, %lld ns/hash, %lld MB/s", size, ns / n, ns? ((tb_hong_t)size * n * 1000) / ns : 0);
+}
+static tb_void_t tb_demo_element_hash_test_cstr(tb_bool_t is_case)
+{
+    // the element
+    tb_element_t element = tb_element_str(is_case);
+    element.seed = 0x12345678;
+
+    // make keys
+    tb_size_t i = 0;
+    tb_char_t keys[256][32];
+    for (i = 0; i < tb_arrayn(keys); i++) tb_snprintf(keys[i], sizeof(keys[i]), "%s_key_%lu", is_case? "Case" : "case", i * 2654435761ul);
+
+    // done
+    __tb_volatile__ tb_size_t   n = 1000000;
+    __tb_volatile__ tb_size_t   v = 0;
+    tb_uint64_t                 t = tb_cycle();
+    for (i = 0; i < n; i++) v += element.hash(&element, keys[i & 255], TB_MAXU32, 0);
+    t = tb_cycle() - t;
+
+    // trace
+    tb_trace_i("cstr: case: %s, %lld ns/hash", is_case? "true" : "false", tb_cycle_to_nclock(t) / n);
+}
+static tb_void_t tb_demo_element_hash_test_seed()
+{
+    // the elements with the different seeds
+    tb_element_t e0 = tb_element_str(tb_true);
+    tb_element_t e1 = tb_element_str(tb_true);
+    e0.seed = tb_element_hash_seed();
+    e1.seed = tb_element_hash_seed();
+
+    // the case-insensitive element
+    tb_element_t ei = tb_element_str(tb_false);
+    ei.seed = e0.seed;
+
+    // trace
+    tb_trace_i("seed: %#lx => %#lx, %#lx => %#lx", e0.seed, e0.hash(&e0, "hello", TB_MAXU32, 0), e1.seed, e1.hash(&e1, "hello", TB_MAXU32, 0));
+    tb_trace_i("icase: %#lx == %#lx", ei.hash(&ei, "Hello World", TB_MAXU32, 0), ei.hash(&ei, "hello world", TB_MAXU32, 0));
+    tb_trace_i("index: %#lx, %#lx, %#lx", e0.hash(&e0, "hello", TB_MAXU32, 0), e0.hash(&e0, "hello", TB_MAXU32, 1), e0.hash(&e0, "hello", TB_MAXU32, 2));
+}
+static tb_void_t tb_demo_element_hash_test_map()
+{
+    // init hash map
+    tb_hash_map_ref_t hash_map = tb_hash_map_init(0, tb_element_str(tb_true), tb_element_size());
+    if (hash_map)
+    {
+        // make keys
+        tb_size_t   i = 0;
+        tb_size_t   n = 100000;
+        tb_char_t   key[64];
+        for (i = 0; i < n; i++)
+        {
+            tb_snprintf(key, sizeof(key), "/home/user/project/src/file_%lu.c", i);
+            tb_hash_map_insert(hash_map, key, (tb_cpointer_t)i);
+        }
+
+        // find keys
+        tb_size_t   m = 0;
+        tb_hong_t   t = tb_mclock();
+        for (i = 0; i < n * 10; i++)
+        {
+            tb_snprintf(key, sizeof(key), "/home/user/project/src/file_%lu.c", i % n);
+            if (tb_hash_map_find(hash_map, key) != tb_iterator_tail(hash_map)) m++;
+        }
+        t = tb_mclock() - t;
+
+        // trace
+        tb_trace_i("hash_map: find: %lu/%lu, %lld ms", m, n * 10, t);
+
+        // exit hash map
+        tb_hash_map_exit(hash_map);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_container_element_hash_main(tb_int_t argc, tb_char_t** argv)
+{
+    // init data
+    tb_size_t   i = 0;
+    tb_byte_t*  data = tb_malloc_bytes(4096 + 8);
+    if (data)
+    {
+        // make data
+        for (i = 0; i < 4096 + 8; i++) data[i] = (tb_byte_t)(i * 31 + 7);
+
+        // the data hash
+        static tb_size_t s_sizes[] = {4, 8, 16, 32, 64, 256, 1024, 4096};
+        for (i = 0; i < tb_arrayn(s_sizes); i++) tb_demo_element_hash_test_data(data, s_sizes[i]);
+
+        // exit data
+        tb_free(data);
+    }
+
+    // the cstring hash
+    tb_demo_element_hash_test_cstr(tb_true);
+    tb_demo_element_hash_test_cstr(tb_false);
+
+    // the seed
+    tb_demo_element_hash_test_seed();
+
+    // the hash map
+    tb_demo_element_hash_test_map();
+    return 0;
+}
@@ -0,0 +1,237 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the names count for checking
+#define TB_DEMO_RADIX_TREE_CHECK_COUNT      (20000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_void_t tb_demo_radix_tree_make_name(tb_char_t* name, tb_size_t maxn, tb_size_t parts, tb_size_t fanout)
+{
+    // make the url-like name with the shared prefixes, .e.g /api/v3/user1/...
+    static tb_char_t const* s_parts[] = {"api", "v1", "v2", "v3", "user", "group", "item", "static", "s", "a", "img", "css"};
+    tb_char_t* p = name;
+    tb_char_t* e = name + maxn - 16;
+    tb_size_t  n = tb_random_range(tb_null, 1, parts + 1);
+    while (n-- && p < e) 
+    {
+        tb_size_t i = tb_random_range(tb_null, 0, tb_arrayn(s_parts) + fanout);
+        if (i < tb_arrayn(s_parts)) p += tb_snprintf(p, e - p, "/%s", s_parts[i]);
+        else p += tb_snprintf(p, e - p, "/%lu", i);
+    }
+    *p = '\0';
+}
+static tb_void_t tb_demo_radix_tree_test_check()
+{
+    // init tree
+    tb_radix_tree_ref_t tree = tb_radix_tree_init(tb_element_size());
+    tb_char_t**         names = tb_nalloc0_type(TB_DEMO_RADIX_TREE_CHECK_COUNT, tb_char_t*);
+    if (tree && names)
+    {
+        // insert names, maybe repeat
+        tb_size_t i = 0;
+        tb_size_t n = 0;
+        tb_char_t name[256];
+        for (i = 0; i < TB_DEMO_RADIX_TREE_CHECK_COUNT; i++)
+        {
+            tb_demo_radix_tree_make_name(name, sizeof(name), 6, 300);
+            if (tb_radix_tree_find(tree, name) == tb_iterator_tail(tree)) names[n++] = tb_strdup(name);
+            tb_radix_tree_insert(tree, name, (tb_cpointer_t)tb_strlen(name));
+        }
+
+        // remove the half names
+        tb_size_t m = 0;
+        for (i = 0; i < n; i++)
+        {
+            if (i & 1) 
+            {
+                tb_radix_tree_remove(tree, names[i]);
+                tb_free(names[i]);
+            }
+            else names[m++] = names[i];
+        }
+        n = m;
+
+        // sort names
+        tb_array_iterator_t array_iterator;
+        tb_iterator_ref_t   iterator = tb_iterator_make_for_str(&array_iterator, names, n);
+        tb_sort_all(iterator, tb_null);
+
+        // check the order
+        tb_bool_t ok = tb_radix_tree_size(tree) == n;
+        i = 0;
+        tb_for_all_if (tb_radix_tree_item_ref_t, item, tree, item && ok)
+        {
+            ok = i < n && !tb_strcmp(item->name, names[i]) && (tb_size_t)item->data == tb_strlen(names[i]);
+            i++;
+        }
+        tb_trace_i("check: order: %s, size: %lu", ok && i == n? "ok" : "failed", tb_radix_tree_size(tree));
+
+        // check the reverse order
+        ok = tb_true;
+        tb_rfor_all_if (tb_radix_tree_item_ref_t, ritem, tree, ritem && ok)
+        {
+            i--;
+            ok = !tb_strcmp(ritem->name, names[i]);
+        }
+        tb_trace_i("check: reverse: %s", ok && !i? "ok" : "failed");
+
+        // check the longest prefix with the brute force
+        tb_size_t j = 0;
+        ok = tb_true;
+        for (i = 0; i < 1000 && ok; i++)
+        {
+            tb_demo_radix_tree_make_name(name, sizeof(name), 8, 300);
+
+            tb_char_t const* best = tb_null;
+            for (j = 0; j < n; j++) 
+            {
+                tb_size_t k = tb_strlen(names[j]);
+                if (!tb_strncmp(names[j], name, k) && (!best || k > tb_strlen(best))) best = names[j];
+            }
+
+            tb_size_t itor = tb_radix_tree_longest(tree, name);
+            if (best) ok = itor && !tb_strcmp(((tb_radix_tree_item_ref_t)tb_iterator_item(tree, itor))->name, best);
+            else ok = !itor;
+        }
+        tb_trace_i("check: longest: %s", ok? "ok" : "failed");
+
+        // check the prefix range with the brute force
+        ok = tb_true;
+        for (i = 0; i < 1000 && ok; i++)
+        {
+            // the prefix, maybe be cut in the middle of the part
+            tb_demo_radix_tree_make_name(name, sizeof(name), 3, 300);
+            name[tb_random_range(tb_null, 0, tb_strlen(name) + 1)] = '\0';
+
+            // the count
+            tb_size_t count = 0;
+            tb_size_t prefix = tb_strlen(name);
+            for (j = 0; j < n; j++) if (!tb_strncmp(names[j], name, prefix)) count++;
+
+            // walk the range
+            tb_size_t tail = 0;
+            tb_size_t itor = tb_radix_tree_prefix(tree, name, &tail);
+            for (; itor != tail && ok; itor = tb_iterator_next(tree, itor), count--)
+                ok = count && !tb_strncmp(((tb_radix_tree_item_ref_t)tb_iterator_item(tree, itor))->name, name, prefix);
+            ok = ok && !count;
+        }
+        tb_trace_i("check: prefix: %s", ok? "ok" : "failed");
+
+        // clear it
+        for (i = 0; i < n; i++) tb_radix_tree_remove(tree, names[i]);
+        tb_trace_i("check: remove: %s", !tb_radix_tree_size(tree) && tb_iterator_head(tree) == tb_iterator_tail(tree)? "ok" : "failed");
+
+        // exit names
+        for (i = 0; i < n; i++) tb_free(names[i]);
+    }
+
+    // exit
+    if (names) tb_free(names);
+    if (tree) tb_radix_tree_exit(tree);
+}
+static tb_void_t tb_demo_radix_tree_test_perf(tb_size_t count)
+{
+    // init tree and map
+    tb_radix_tree_ref_t tree = tb_radix_tree_init(tb_element_size());
+    tb_hash_map_ref_t   map = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_LARGE, tb_element_str(tb_true), tb_element_size());
+    if (tree && map)
+    {
+        // insert rules
+        tb_size_t i = 0;
+        tb_char_t name[256];
+        tb_hong_t t = tb_mclock();
+        for (i = 0; i < count; i++)
+        {
+            tb_demo_radix_tree_make_name(name, sizeof(name), 6, 100000);
+            tb_radix_tree_insert(tree, name, (tb_cpointer_t)i);
+        }
+        t = tb_mclock() - t;
+        tb_for_all_if (tb_radix_tree_item_ref_t, item, tree, item) tb_hash_map_insert(map, item->name, item->data);
+
+        // make queries
+        tb_size_t   n = 100000;
+        tb_char_t** queries = tb_nalloc0_type(n, tb_char_t*);
+        if (queries)
+        {
+            for (i = 0; i < n; i++)
+            {
+                tb_demo_radix_tree_make_name(name, sizeof(name), 10, 100000);
+                queries[i] = tb_strdup(name);
+            }
+
+            // the longest prefix match by the radix tree
+            tb_size_t   f1 = 0;
+            tb_hong_t   t1 = tb_mclock();
+            for (i = 0; i < n; i++) if (tb_radix_tree_longest(tree, queries[i])) f1++;
+            t1 = tb_mclock() - t1;
+
+            // the longest prefix match by the hash map, try all prefixes from the longest one
+            tb_size_t   f2 = 0;
+            tb_hong_t   t2 = tb_mclock();
+            for (i = 0; i < n; i++) 
+            {
+                tb_size_t k = tb_strlen(queries[i]);
+                tb_strlcpy(name, queries[i], sizeof(name));
+                for (; k; k--) 
+                {
+                    name[k] = '\0';
+                    if (tb_hash_map_find(map, name) != tb_iterator_tail(map)) 
+                    {
+                        f2++;
+                        break;
+                    }
+                }
+            }
+            t2 = tb_mclock() - t2;
+
+            // trace
+            tb_trace_i("perf: %lu rules, insert: %lld ms, longest: %lu queries, radix_tree: %lld ms, found: %lu, hash_map: %lld ms, found: %lu", tb_radix_tree_size(tree), t, n, t1, f1, t2, f2);
+
+            // exit queries
+            for (i = 0; i < n; i++) tb_free(queries[i]);
+            tb_free(queries);
+        }
+    }
+
+    // exit
+    if (map) tb_hash_map_exit(map);
+    if (tree) tb_radix_tree_exit(tree);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_container_radix_tree_main(tb_int_t argc, tb_char_t** argv)
+{
+    // dump the small tree
+    tb_radix_tree_ref_t tree = tb_radix_tree_init(tb_element_str(tb_true));
+    if (tree)
+    {
+        tb_radix_tree_insert(tree, "/", "root");
+        tb_radix_tree_insert(tree, "/api/", "api");
+        tb_radix_tree_insert(tree, "/api/user/", "user");
+        tb_radix_tree_insert(tree, "/api/version", "version");
+        tb_radix_tree_insert(tree, "/static/", "static");
+#ifdef __tb_debug__
+        tb_radix_tree_dump(tree);
+#endif
+        tb_size_t itor = tb_radix_tree_longest(tree, "/api/user/1234");
+        tb_trace_i("longest: /api/user/1234 => %s", itor? (tb_char_t const*)((tb_radix_tree_item_ref_t)tb_iterator_item(tree, itor))->data : "none");
+        tb_radix_tree_exit(tree);
+    }
+
+    // check it
+    tb_demo_radix_tree_test_check();
+
+    // perf
+    tb_demo_radix_tree_test_perf(argv[1]? tb_atoi(argv[1]) : 1000000);
+    return 0;
+}
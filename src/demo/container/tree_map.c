@@ -0,0 +1,268 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the keys count for checking
+#define TB_DEMO_TREE_MAP_CHECK_COUNT        (50000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_bool_t tb_demo_tree_map_pred_odd(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value)
+{
+    return ((tb_size_t)((tb_tree_map_item_ref_t)item)->name) & 1;
+}
+static tb_bool_t tb_demo_tree_map_check(tb_tree_map_ref_t tree_map, tb_byte_t const* exists, tb_size_t count)
+{
+    // check the order and data
+    tb_size_t   n = 0;
+    tb_size_t   last = 0;
+    tb_bool_t   ok = tb_true;
+    tb_for_all_if (tb_tree_map_item_ref_t, item, tree_map, item && ok)
+    {
+        tb_size_t key = (tb_size_t)item->name;
+        ok = key < count && exists[key] && (!n || key > last) && (tb_size_t)item->data == key * 3;
+        last = key;
+        n++;
+    }
+
+    // check the reverse order
+    tb_size_t m = 0;
+    tb_rfor_all_if (tb_tree_map_item_ref_t, ritem, tree_map, ritem && ok)
+    {
+        tb_size_t key = (tb_size_t)ritem->name;
+        ok = (!m || key < last) && exists[key];
+        last = key;
+        m++;
+    }
+
+    // check size
+    tb_size_t i = 0;
+    tb_size_t size = 0;
+    for (i = 0; i < count; i++) if (exists[i]) size++;
+    return ok && n == size && m == size && tb_tree_map_size(tree_map) == size;
+}
+static tb_bool_t tb_demo_tree_map_check_bounds(tb_tree_map_ref_t tree_map, tb_byte_t const* exists, tb_size_t count)
+{
+    tb_size_t i = 0;
+    tb_bool_t ok = tb_true;
+    for (i = 0; i < 1000 && ok; i++)
+    {
+        // the lower bound
+        tb_size_t key = tb_random_range(tb_null, 0, count);
+        tb_size_t lower = key;
+        while (lower < count && !exists[lower]) lower++;
+        tb_size_t itor = tb_tree_map_lower_bound(tree_map, (tb_cpointer_t)key);
+        ok = lower < count? (itor && (tb_size_t)((tb_tree_map_item_ref_t)tb_iterator_item(tree_map, itor))->name == lower) : !itor;
+
+        // the upper bound
+        tb_size_t upper = key + 1;
+        while (upper < count && !exists[upper]) upper++;
+        itor = tb_tree_map_upper_bound(tree_map, (tb_cpointer_t)key);
+        if (ok) ok = upper < count? (itor && (tb_size_t)((tb_tree_map_item_ref_t)tb_iterator_item(tree_map, itor))->name == upper) : !itor;
+    }
+    return ok;
+}
+static tb_void_t tb_demo_tree_map_test_check(tb_size_t node_size)
+{
+    // init tree map
+    tb_tree_map_ref_t   tree_map = tb_tree_map_init(node_size, tb_element_size(), tb_element_size());
+    tb_byte_t*          exists = tb_malloc0_bytes(TB_DEMO_TREE_MAP_CHECK_COUNT);
+    tb_cpointer_t*      keys = tb_nalloc0_type(TB_DEMO_TREE_MAP_CHECK_COUNT, tb_cpointer_t);
+    tb_cpointer_t*      datas = tb_nalloc0_type(TB_DEMO_TREE_MAP_CHECK_COUNT, tb_cpointer_t);
+    if (tree_map && exists && keys && datas)
+    {
+        // insert and remove keys randomly
+        tb_size_t i = 0;
+        for (i = 0; i < TB_DEMO_TREE_MAP_CHECK_COUNT * 4; i++)
+        {
+            tb_size_t key = tb_random_range(tb_null, 0, TB_DEMO_TREE_MAP_CHECK_COUNT);
+            if (tb_random_range(tb_null, 0, 3))
+            {
+                tb_tree_map_insert(tree_map, (tb_cpointer_t)key, (tb_cpointer_t)(key * 3));
+                exists[key] = 1;
+            }
+            else
+            {
+                tb_tree_map_remove(tree_map, (tb_cpointer_t)key);
+                exists[key] = 0;
+            }
+        }
+        tb_trace_i("check: node: %lu, random: %s, bounds: %s, size: %lu, height: %lu", node_size
+                   , tb_demo_tree_map_check(tree_map, exists, TB_DEMO_TREE_MAP_CHECK_COUNT)? "ok" : "failed"
+                   , tb_demo_tree_map_check_bounds(tree_map, exists, TB_DEMO_TREE_MAP_CHECK_COUNT)? "ok" : "failed"
+                   , tb_tree_map_size(tree_map), tb_tree_map_height(tree_map));
+
+        // remove the odd keys by the iterator
+        tb_remove_if(tree_map, tb_demo_tree_map_pred_odd, tb_null);
+        for (i = 1; i < TB_DEMO_TREE_MAP_CHECK_COUNT; i += 2) exists[i] = 0;
+        tb_trace_i("check: node: %lu, remove_if: %s, size: %lu", node_size, tb_demo_tree_map_check(tree_map, exists, TB_DEMO_TREE_MAP_CHECK_COUNT)? "ok" : "failed", tb_tree_map_size(tree_map));
+
+        // load the sorted keys
+        tb_size_t n = 0;
+        for (i = 0; i < TB_DEMO_TREE_MAP_CHECK_COUNT; i++)
+        {
+            exists[i] = (i % 3) != 1;
+            if (exists[i])
+            {
+                keys[n] = (tb_cpointer_t)i;
+                datas[n] = (tb_cpointer_t)(i * 3);
+                n++;
+            }
+        }
+        tb_bool_t loaded = tb_tree_map_load(tree_map, keys, datas, n);
+        tb_trace_i("check: node: %lu, load: %s, bounds: %s, size: %lu, height: %lu", node_size
+                   , loaded && tb_demo_tree_map_check(tree_map, exists, TB_DEMO_TREE_MAP_CHECK_COUNT)? "ok" : "failed"
+                   , tb_demo_tree_map_check_bounds(tree_map, exists, TB_DEMO_TREE_MAP_CHECK_COUNT)? "ok" : "failed"
+                   , tb_tree_map_size(tree_map), tb_tree_map_height(tree_map));
+
+        // insert and remove keys after loading
+        for (i = 0; i < TB_DEMO_TREE_MAP_CHECK_COUNT; i++)
+        {
+            tb_size_t key = tb_random_range(tb_null, 0, TB_DEMO_TREE_MAP_CHECK_COUNT);
+            if (i & 1)
+            {
+                tb_tree_map_insert(tree_map, (tb_cpointer_t)key, (tb_cpointer_t)(key * 3));
+                exists[key] = 1;
+            }
+            else
+            {
+                tb_tree_map_remove(tree_map, (tb_cpointer_t)key);
+                exists[key] = 0;
+            }
+        }
+        tb_trace_i("check: node: %lu, update: %s, size: %lu", node_size, tb_demo_tree_map_check(tree_map, exists, TB_DEMO_TREE_MAP_CHECK_COUNT)? "ok" : "failed", tb_tree_map_size(tree_map));
+
+        // the unsorted keys cannot be loaded
+        keys[0] = (tb_cpointer_t)1;
+        keys[1] = (tb_cpointer_t)1;
+        tb_trace_i("check: node: %lu, unsorted: %s", node_size, !tb_tree_map_load(tree_map, keys, tb_null, 2)? "ok" : "failed");
+
+        // remove all keys
+        for (i = 0; i < TB_DEMO_TREE_MAP_CHECK_COUNT; i++) tb_tree_map_remove(tree_map, (tb_cpointer_t)i);
+        tb_trace_i("check: node: %lu, clear: %s", node_size, !tb_tree_map_size(tree_map) && tb_iterator_head(tree_map) == tb_iterator_tail(tree_map)? "ok" : "failed");
+    }
+
+    // exit
+    if (datas) tb_free(datas);
+    if (keys) tb_free(keys);
+    if (exists) tb_free(exists);
+    if (tree_map) tb_tree_map_exit(tree_map);
+}
+static tb_void_t tb_demo_tree_map_test_perf(tb_size_t count)
+{
+    // init tree maps
+    tb_tree_map_ref_t   appended = tb_tree_map_init(0, tb_element_size(), tb_element_size());
+    tb_tree_map_ref_t   loaded = tb_tree_map_init(0, tb_element_size(), tb_element_size());
+    tb_tree_map_ref_t   random = tb_tree_map_init(0, tb_element_size(), tb_element_size());
+    tb_cpointer_t*      keys = tb_nalloc0_type(count, tb_cpointer_t);
+    if (appended && loaded && random && keys)
+    {
+        // append the time-series keys, the timestamps in microseconds
+        tb_size_t i = 0;
+        tb_size_t ts = 1000000;
+        tb_hong_t t1 = tb_mclock();
+        for (i = 0; i < count; i++)
+        {
+            ts += tb_random_range(tb_null, 1, 100);
+            keys[i] = (tb_cpointer_t)ts;
+            tb_tree_map_insert(appended, (tb_cpointer_t)ts, (tb_cpointer_t)i);
+        }
+        t1 = tb_mclock() - t1;
+
+        // load the sorted keys
+        tb_hong_t t2 = tb_mclock();
+        tb_tree_map_load(loaded, keys, tb_null, count);
+        t2 = tb_mclock() - t2;
+
+        // insert the keys randomly
+        tb_hong_t t3 = tb_mclock();
+        for (i = 0; i < count; i++) tb_tree_map_insert(random, keys[tb_random_range(tb_null, 0, count)], (tb_cpointer_t)i);
+        t3 = tb_mclock() - t3;
+
+        // find keys
+        tb_size_t f = 0;
+        tb_hong_t t4 = tb_mclock();
+        for (i = 0; i < count; i++) if (tb_tree_map_find(appended, keys[tb_random_range(tb_null, 0, count)])) f++;
+        t4 = tb_mclock() - t4;
+
+        // scan the ranges: [ts, ts + 10000)
+        tb_size_t n = 0;
+        tb_size_t r = 0;
+        tb_hong_t t5 = tb_mclock();
+        for (r = 0; r < 1000; r++)
+        {
+            tb_size_t b = (tb_size_t)keys[tb_random_range(tb_null, 0, count)];
+            tb_size_t e = tb_tree_map_lower_bound(appended, (tb_cpointer_t)(b + 10000));
+            tb_size_t itor = tb_tree_map_lower_bound(appended, (tb_cpointer_t)b);
+            for (; itor != e; itor = tb_iterator_next(appended, itor)) n++;
+        }
+        t5 = tb_mclock() - t5;
+
+        // trace
+        tb_trace_i("perf: %lu keys, append: %lld ms, height: %lu, load: %lld ms, height: %lu, random insert: %lld ms, height: %lu", count, t1, tb_tree_map_height(appended), t2, tb_tree_map_height(loaded), t3, tb_tree_map_height(random));
+        tb_trace_i("perf: find: %lu/%lu, %lld ms, scan: 1000 ranges, %lu items, %lld ms", f, count, t4, n, t5);
+    }
+
+    // exit
+    if (keys) tb_free(keys);
+    if (random) tb_tree_map_exit(random);
+    if (loaded) tb_tree_map_exit(loaded);
+    if (appended) tb_tree_map_exit(appended);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_container_tree_map_main(tb_int_t argc, tb_char_t** argv)
+{
+    // dump the small map
+    tb_tree_map_ref_t tree_map = tb_tree_map_init(TB_TREE_MAP_NODE_SIZE_SMALL, tb_element_str(tb_true), tb_element_str(tb_true));
+    if (tree_map)
+    {
+        tb_size_t i = 0;
+        tb_char_t name[64];
+        for (i = 0; i < 20; i++)
+        {
+            tb_snprintf(name, sizeof(name), "key_%02lu", (i * 7) % 20);
+            tb_tree_map_insert(tree_map, name, name + 4);
+        }
+        tb_tree_map_remove(tree_map, "key_05");
+#ifdef __tb_debug__
+        tb_tree_map_dump(tree_map);
+#endif
+        tb_size_t itor = tb_tree_map_upper_bound(tree_map, "key_04");
+        tb_trace_i("upper_bound: key_04 => %s", itor? (tb_char_t const*)((tb_tree_map_item_ref_t)tb_iterator_item(tree_map, itor))->name : "none");
+        tb_tree_map_exit(tree_map);
+    }
+
+    // the tree set
+    tb_tree_set_ref_t tree_set = tb_tree_set_init(0, tb_element_str(tb_true));
+    if (tree_set)
+    {
+        tb_char_t const* names[] = {"apple", "banana", "cherry", "grape", "lemon", "mango", "orange", "peach"};
+        tb_tree_set_load(tree_set, (tb_cpointer_t const*)names, tb_arrayn(names));
+        tb_tree_set_insert(tree_set, "kiwi");
+        tb_tree_set_remove(tree_set, "cherry");
+
+        // walk the range: [c, m)
+        tb_size_t tail = tb_tree_set_lower_bound(tree_set, "m");
+        tb_size_t itor = tb_tree_set_lower_bound(tree_set, "c");
+        for (; itor != tail; itor = tb_iterator_next(tree_set, itor))
+            tb_trace_i("tree_set: [c, m): %s", (tb_char_t const*)tb_iterator_item(tree_set, itor));
+        tb_tree_set_exit(tree_set);
+    }
+
+    // check it
+    tb_demo_tree_map_test_check(TB_TREE_MAP_NODE_SIZE_SMALL);
+    tb_demo_tree_map_test_check(TB_TREE_MAP_NODE_SIZE_DEFAULT);
+
+    // perf
+    tb_demo_tree_map_test_perf(argv[1]? tb_atoi(argv[1]) : 1000000);
+    return 0;
+}
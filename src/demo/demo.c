@@ -37,6 +37,7 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(libc_wchar)
 ,   TB_DEMO_MAIN_ITEM(libc_string)
 ,   TB_DEMO_MAIN_ITEM(libc_stdlib)
+,   TB_DEMO_MAIN_ITEM(libc_stdio)
 ,   TB_DEMO_MAIN_ITEM(libc_wcstombs)
 ,   TB_DEMO_MAIN_ITEM(libc_mbstowcs)
 
@@ -44,6 +45,7 @@ static tb_demo_t g_demo[] =
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
 ,   TB_DEMO_MAIN_ITEM(libm_float)
 ,   TB_DEMO_MAIN_ITEM(libm_double)
+,   TB_DEMO_MAIN_ITEM(libm_vector)
 #endif
 ,   TB_DEMO_MAIN_ITEM(libm_integer)
 
@@ -57,6 +59,7 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(xml_reader)
 ,   TB_DEMO_MAIN_ITEM(xml_writer)
 ,   TB_DEMO_MAIN_ITEM(xml_document)
+,   TB_DEMO_MAIN_ITEM(xml_path)
 #endif
 
     // regex
@@ -73,6 +76,7 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(asio_aiopd)
 ,   TB_DEMO_MAIN_ITEM(asio_aicpc)
 ,   TB_DEMO_MAIN_ITEM(asio_aicpd)
+,   TB_DEMO_MAIN_ITEM(asio_co)
 #endif
 
     // math
@@ -95,6 +99,7 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(utils_base64)
 ,   TB_DEMO_MAIN_ITEM(utils_adler32)
 ,   TB_DEMO_MAIN_ITEM(utils_fnv32)
+,   TB_DEMO_MAIN_ITEM(utils_varint)
 
     // other
 ,   TB_DEMO_MAIN_ITEM(other_test)
@@ -111,6 +116,9 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(object_bplist)
 ,   TB_DEMO_MAIN_ITEM(object_xplist)
 ,   TB_DEMO_MAIN_ITEM(object_dump)
+,   TB_DEMO_MAIN_ITEM(object_dictionary)
+,   TB_DEMO_MAIN_ITEM(object_records)
+,   TB_DEMO_MAIN_ITEM(object_patch)
 #endif
 
     // stream
@@ -119,6 +127,7 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(stream_cache)
 ,   TB_DEMO_MAIN_ITEM(stream_charset)
 ,   TB_DEMO_MAIN_ITEM(stream_zip)
+,   TB_DEMO_MAIN_ITEM(stream_static_bits)
 #ifdef TB_CONFIG_MODULE_HAVE_ASIO
 ,   TB_DEMO_MAIN_ITEM(stream_transfer_pool)
 ,   TB_DEMO_MAIN_ITEM(stream_async_transfer)
@@ -132,6 +141,7 @@ static tb_demo_t g_demo[] =
     // string
 ,   TB_DEMO_MAIN_ITEM(string_string)
 ,   TB_DEMO_MAIN_ITEM(string_static_string)
+,   TB_DEMO_MAIN_ITEM(string_rope)
 
     // memory
 ,   TB_DEMO_MAIN_ITEM(memory_check)
@@ -158,6 +168,8 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(network_whois)
 ,   TB_DEMO_MAIN_ITEM(network_spider)
 ,   TB_DEMO_MAIN_ITEM(network_cookies)
+,   TB_DEMO_MAIN_ITEM(network_ktls)
+,   TB_DEMO_MAIN_ITEM(network_session)
 ,   TB_DEMO_MAIN_ITEM(network_impl_date)
 #endif
 
@@ -175,6 +187,7 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(platform_backtrace)
 ,   TB_DEMO_MAIN_ITEM(platform_directory)
 ,   TB_DEMO_MAIN_ITEM(platform_cache_time)
+,   TB_DEMO_MAIN_ITEM(platform_cycle)
 ,   TB_DEMO_MAIN_ITEM(platform_environment)
 #ifdef TB_CONFIG_MODULE_HAVE_THREAD
 ,   TB_DEMO_MAIN_ITEM(platform_lock)
@@ -200,6 +213,9 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(container_single_list)
 ,   TB_DEMO_MAIN_ITEM(container_single_list_entry)
 ,   TB_DEMO_MAIN_ITEM(container_bloom_filter)
+,   TB_DEMO_MAIN_ITEM(container_element_hash)
+,   TB_DEMO_MAIN_ITEM(container_radix_tree)
+,   TB_DEMO_MAIN_ITEM(container_tree_map)
 
     // algorithm
 ,   TB_DEMO_MAIN_ITEM(algorithm_find)
@@ -51,18 +51,21 @@ TB_DEMO_MAIN_DECL(regex);
 TB_DEMO_MAIN_DECL(xml_reader);
 TB_DEMO_MAIN_DECL(xml_writer);
 TB_DEMO_MAIN_DECL(xml_document);
+TB_DEMO_MAIN_DECL(xml_path);
 
 // libc
 TB_DEMO_MAIN_DECL(libc_time);
 TB_DEMO_MAIN_DECL(libc_wchar);
 TB_DEMO_MAIN_DECL(libc_string);
 TB_DEMO_MAIN_DECL(libc_stdlib);
+TB_DEMO_MAIN_DECL(libc_stdio);
 TB_DEMO_MAIN_DECL(libc_mbstowcs);
 TB_DEMO_MAIN_DECL(libc_wcstombs);
 
 // libm
 TB_DEMO_MAIN_DECL(libm_float);
 TB_DEMO_MAIN_DECL(libm_double);
+TB_DEMO_MAIN_DECL(libm_vector);
 TB_DEMO_MAIN_DECL(libm_integer);
 
 // asio
@@ -73,6 +76,7 @@ TB_DEMO_MAIN_DECL(asio_aiopc);
 TB_DEMO_MAIN_DECL(asio_aiopd);
 TB_DEMO_MAIN_DECL(asio_aicpc);
 TB_DEMO_MAIN_DECL(asio_aicpd);
+TB_DEMO_MAIN_DECL(asio_co);
 
 // math
 TB_DEMO_MAIN_DECL(math_fixed);
@@ -90,6 +94,7 @@ TB_DEMO_MAIN_DECL(utils_base32);
 TB_DEMO_MAIN_DECL(utils_base64);
 TB_DEMO_MAIN_DECL(utils_adler32);
 TB_DEMO_MAIN_DECL(utils_fnv32);
+TB_DEMO_MAIN_DECL(utils_varint);
 
 // other
 TB_DEMO_MAIN_DECL(other_test);
@@ -103,12 +108,16 @@ TB_DEMO_MAIN_DECL(object_xml);
 TB_DEMO_MAIN_DECL(object_xplist);
 TB_DEMO_MAIN_DECL(object_bplist);
 TB_DEMO_MAIN_DECL(object_dump);
+TB_DEMO_MAIN_DECL(object_dictionary);
+TB_DEMO_MAIN_DECL(object_records);
+TB_DEMO_MAIN_DECL(object_patch);
 
 // stream
 TB_DEMO_MAIN_DECL(stream_transfer_pool);
 TB_DEMO_MAIN_DECL(stream_async_transfer);
 TB_DEMO_MAIN_DECL(stream_async_stream);
 TB_DEMO_MAIN_DECL(stream);
+TB_DEMO_MAIN_DECL(stream_static_bits);
 TB_DEMO_MAIN_DECL(stream_zip);
 TB_DEMO_MAIN_DECL(stream_null);
 TB_DEMO_MAIN_DECL(stream_cache);
@@ -121,6 +130,7 @@ TB_DEMO_MAIN_DECL(stream_async_stream_charset);
 // string
 TB_DEMO_MAIN_DECL(string_string);
 TB_DEMO_MAIN_DECL(string_static_string);
+TB_DEMO_MAIN_DECL(string_rope);
 
 // memory
 TB_DEMO_MAIN_DECL(memory_check);
@@ -147,6 +157,8 @@ TB_DEMO_MAIN_DECL(network_http);
 TB_DEMO_MAIN_DECL(network_whois);
 TB_DEMO_MAIN_DECL(network_spider);
 TB_DEMO_MAIN_DECL(network_cookies);
+TB_DEMO_MAIN_DECL(network_ktls);
+TB_DEMO_MAIN_DECL(network_session);
 TB_DEMO_MAIN_DECL(network_impl_date);
 #endif
 
@@ -170,6 +182,7 @@ TB_DEMO_MAIN_DECL(platform_directory);
 TB_DEMO_MAIN_DECL(platform_exception);
 TB_DEMO_MAIN_DECL(platform_semaphore);
 TB_DEMO_MAIN_DECL(platform_cache_time);
+TB_DEMO_MAIN_DECL(platform_cycle);
 TB_DEMO_MAIN_DECL(platform_environment);
 TB_DEMO_MAIN_DECL(platform_thread_pool);
 TB_DEMO_MAIN_DECL(platform_thread_store);
@@ -187,6 +200,9 @@ TB_DEMO_MAIN_DECL(container_list_entry);
 TB_DEMO_MAIN_DECL(container_single_list);
 TB_DEMO_MAIN_DECL(container_single_list_entry);
 TB_DEMO_MAIN_DECL(container_bloom_filter);
+TB_DEMO_MAIN_DECL(container_element_hash);
+TB_DEMO_MAIN_DECL(container_radix_tree);
+TB_DEMO_MAIN_DECL(container_tree_map);
 
 // algorithm
 TB_DEMO_MAIN_DECL(algorithm_find);
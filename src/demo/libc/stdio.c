@@ -0,0 +1,105 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */ 
+static tb_long_t tb_test_printf_object_old(tb_cpointer_t object, tb_char_t* cstr, tb_size_t maxn)
+{
+    return tb_snprintf(cstr, maxn, "old: %ld", (tb_long_t)object);
+}
+static tb_long_t tb_test_printf_object_new(tb_cpointer_t object, tb_char_t* cstr, tb_size_t maxn)
+{
+    return tb_snprintf(cstr, maxn, "new: %ld", (tb_long_t)object);
+}
+static tb_void_t tb_test_printf_format()
+{
+    // init ipv4
+    tb_ipv4_t ipv4;
+    tb_ipv4_cstr_set(&ipv4, "127.0.0.1");
+
+    // the width and precision from the arguments
+    tb_char_t data[256];
+    tb_snprintf(data, sizeof(data), "|%-10s|%%|%10s|%*d|%.*s|", "hello", "world", 5, 10, 3, "abcdef");
+    tb_trace_i("format:   %s", data);
+    tb_snprintf(data, sizeof(data), "|%-10s|%%|%10s|%*d|%.*s|", "hi", "tbox", -5, 20, 2, "abcdef");
+    tb_trace_i("format:   %s", data);
+
+    // the cached format with the nested printf objects
+    tb_size_t i = 0;
+    for (i = 0; i < 2; i++)
+    {
+        tb_snprintf(data, sizeof(data), "addr: %{ipv4}:%lu, %{ipv4}", &ipv4, 8080 + i, &ipv4);
+        tb_trace_i("object:   %s", data);
+    }
+
+    // the format buffer will be changed at the same pointer
+    tb_char_t fmt[64];
+    tb_strlcpy(fmt, "%{ipv4} + %d", sizeof(fmt));
+    tb_snprintf(data, sizeof(data), fmt, &ipv4, 2);
+    tb_trace_i("changed:  %s", data);
+    tb_strlcpy(fmt, "%x - %{ipv4}", sizeof(fmt));
+    tb_snprintf(data, sizeof(data), fmt, 255, &ipv4);
+    tb_trace_i("changed:  %s", data);
+
+    // the cached format will be recompiled after re-registering the printf object
+    tb_char_t const* object = "object: %{demo}";
+    tb_printf_object_register("demo", tb_test_printf_object_old);
+    for (i = 0; i < 2; i++)
+    {
+        tb_snprintf(data, sizeof(data), object, (tb_cpointer_t)i);
+        tb_trace_i("register: %s", data);
+    }
+    tb_printf_object_register("demo", tb_test_printf_object_new);
+    tb_snprintf(data, sizeof(data), object, (tb_cpointer_t)2);
+    tb_trace_i("register: %s: %s", data, !tb_strcmp(data, "object: new: 2")? "ok" : "failed");
+
+    // the compiled format
+    tb_printf_format_ref_t format = tb_printf_format_compile("%s: %s\r\nContent-Length: %llu\r\n");
+    if (format)
+    {
+        tb_printf_format_snprintf(data, sizeof(data), format, "Host", "www.xxx.com", 1024ull);
+        tb_trace_i("compiled: %s", data);
+        tb_printf_format_exit(format);
+    }
+}
+static tb_void_t tb_test_printf_perf()
+{
+    // init ipv4
+    tb_ipv4_t ipv4;
+    tb_ipv4_cstr_set(&ipv4, "192.168.1.1");
+
+    // the cached format
+    tb_size_t   i = 0;
+    tb_size_t   n = 1000000;
+    tb_char_t   data[256];
+    tb_hong_t   t = tb_mclock();
+    for (i = 0; i < n; i++) tb_snprintf(data, sizeof(data), "GET %s HTTP/1.1\r\nHost: %{ipv4}:%u\r\nRange: bytes=%llu-\r\n", "/index.html", &ipv4, 80, (tb_hize_t)i);
+    t = tb_mclock() - t;
+
+    // the compiled format
+    tb_hong_t c = 0;
+    tb_printf_format_ref_t format = tb_printf_format_compile("GET %s HTTP/1.1\r\nHost: %{ipv4}:%u\r\nRange: bytes=%llu-\r\n");
+    if (format)
+    {
+        c = tb_mclock();
+        for (i = 0; i < n; i++) tb_printf_format_snprintf(data, sizeof(data), format, "/index.html", &ipv4, 80, (tb_hize_t)i);
+        c = tb_mclock() - c;
+        tb_printf_format_exit(format);
+    }
+
+    // trace
+    tb_trace_i("perf: snprintf: %lld ms, compiled: %lld ms", t, c);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */ 
+tb_int_t tb_demo_libc_stdio_main(tb_int_t argc, tb_char_t** argv)
+{
+    tb_test_printf_format();
+    tb_test_printf_perf();
+    return 0;
+}
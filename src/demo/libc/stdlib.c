@@ -19,6 +19,9 @@
 #define TB_TEST_STOI32          (1)
 #define TB_TEST_STOU32          (1)
 
+#define TB_TEST_U64TOS10        (1)
+#define TB_TEST_DTOS10          (1)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */ 
@@ -96,6 +99,79 @@ static tb_void_t tb_test_stoi32(tb_char_t const* s, tb_int32_t val)
 {
     tb_printf("stoi32(%s) = %d [?= %d]\n", s, tb_stoi32(s), val);
 }
+static tb_void_t tb_test_s64tos10(tb_sint64_t val)
+{
+    tb_char_t s[32];
+    tb_size_t n = tb_s64tos10(s, sizeof(s), val);
+    tb_printf("s64tos10(%lld) = %s, %lu\n", val, s, n);
+}
+static tb_void_t tb_test_u64tos10(tb_uint64_t val)
+{
+    tb_char_t s[32];
+    tb_size_t n = tb_u64tos10(s, sizeof(s), val);
+    tb_printf("u64tos10(%llu) = %s, %lu\n", val, s, n);
+}
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+static tb_void_t tb_test_dtos10(tb_double_t val)
+{
+    tb_char_t s[32];
+    tb_size_t n = tb_dtos10(s, sizeof(s), val);
+    tb_printf("dtos10(%.17lg) = %s, %lu => %.17lg\n", val, s, n, tb_s10tod(s));
+}
+static tb_void_t tb_test_s10tod(tb_char_t const* s)
+{
+    tb_char_t d[32];
+    tb_dtos10(d, sizeof(d), tb_s10tod(s));
+    tb_printf("s10tod(%s) = %s\n", s, d);
+}
+static tb_void_t tb_test_dtos10_random()
+{
+    // init data
+    tb_size_t       i = 0;
+    tb_size_t       n = 500000;
+    tb_size_t       failed = 0;
+    tb_double_t*    data = tb_nalloc_type(n, tb_double_t);
+    tb_char_t*      strs = tb_nalloc_cstr(n, 32);
+    if (data && strs)
+    {
+        // make the random doubles
+        for (i = 0; i < n; i++)
+        {
+            tb_ieee_double_t conv;
+            do
+            {
+                tb_uint64_t bits = tb_random_u64(tb_null);
+                conv.i.h = (tb_uint32_t)(bits >> 32);
+                conv.i.l = (tb_uint32_t)bits;
+
+            } while (tb_isnan(conv.d) || tb_isinf(conv.d));
+            data[i] = conv.d;
+        }
+
+        // the formatting
+        tb_hong_t t = tb_mclock();
+        for (i = 0; i < n; i++) tb_dtos10(strs + (i << 5), 32, data[i]);
+        t = tb_mclock() - t;
+
+        // the parsing and round-trip
+        tb_hong_t p = tb_mclock();
+        for (i = 0; i < n; i++) if (tb_s10tod(strs + (i << 5)) != data[i]) failed++;
+        p = tb_mclock() - p;
+
+        // the formatting with %.17lg
+        tb_hong_t g = tb_mclock();
+        for (i = 0; i < n; i++) tb_snprintf(strs + (i << 5), 32, "%.17lg", data[i]);
+        g = tb_mclock() - g;
+
+        // trace
+        tb_printf("dtos10: %lld ms, s10tod: %lld ms, %%.17lg: %lld ms, round-trip: %lu/%lu failed\n", t, p, g, failed, n);
+    }
+
+    // exit data
+    if (data) tb_free(data);
+    if (strs) tb_free(strs);
+}
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
@@ -203,6 +279,34 @@ tb_int_t tb_demo_libc_stdlib_main(tb_int_t argc, tb_char_t** argv)
     tb_test_stou32("0x1dcc666", 31415926);
 #endif
 
+#if TB_TEST_U64TOS10
+    tb_printf("===============================\n");
+    tb_test_u64tos10(0);
+    tb_test_u64tos10(9);
+    tb_test_u64tos10(10);
+    tb_test_u64tos10(31415926);
+    tb_test_u64tos10(TB_MAXU64);
+    tb_test_s64tos10(-31415926);
+    tb_test_s64tos10(TB_MINS64);
+#endif
+
+
+#if TB_TEST_DTOS10 && defined(TB_CONFIG_TYPE_HAVE_FLOAT)
+    tb_printf("===============================\n");
+    tb_test_dtos10(0.1);
+    tb_test_dtos10(1.);
+    tb_test_dtos10(-0.);
+    tb_test_dtos10(3.1415926);
+    tb_test_dtos10(1e16);
+    tb_test_dtos10(1.5e-5);
+    tb_test_dtos10(5e-324);
+    tb_test_dtos10(1.7976931348623157e308);
+    tb_test_s10tod("2.2250738585072011e-308");
+    tb_test_s10tod("9007199254740993");
+    tb_test_s10tod("1.00000000000000011102230246251565404236316680908203125");
+    tb_test_s10tod("1e400");
+    tb_test_dtos10_random();
+#endif
 
 #if TB_TEST_STOI32
     tb_printf("===============================\n");
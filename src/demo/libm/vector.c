@@ -0,0 +1,176 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */ 
+
+// the value count
+#define TB_DEMO_VECTOR_MAXN         (1 << 20)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */ 
+static tb_double_t tb_demo_vector_ulp(tb_float_t value, tb_double_t exact)
+{
+    // the ulp of the exact value
+    tb_ieee_float_t e;
+    e.f = (tb_float_t)tb_fabs(exact);
+    e.i++;
+    tb_double_t ulp = (tb_double_t)e.f - (tb_double_t)(tb_float_t)tb_fabs(exact);
+
+    // the error 
+    return ulp > 0? tb_fabs((tb_double_t)value - exact) / ulp : 0;
+}
+static tb_void_t tb_demo_vector_test(tb_char_t const* name, tb_float_t const* x, tb_float_t* y, tb_size_t n, tb_float_t (*scalar)(tb_float_t), tb_void_t (*batch)(tb_float_t const*, tb_float_t*, tb_size_t), tb_double_t (*exact)(tb_double_t))
+{
+    // the scalar time
+    tb_size_t i = 0;
+    tb_hong_t t0 = tb_mclock();
+    for (i = 0; i < n; i++) y[i] = scalar(x[i]);
+    t0 = tb_mclock() - t0;
+
+    // the max error of the scalar version
+    tb_double_t e0 = 0;
+    for (i = 0; i < n; i++) e0 = tb_max(e0, tb_demo_vector_ulp(y[i], exact(x[i])));
+
+    // the batch time
+    tb_hong_t t1 = tb_mclock();
+    batch(x, y, n);
+    t1 = tb_mclock() - t1;
+
+    // the max error of the batch version
+    tb_double_t e1 = 0;
+    tb_double_t a1 = 0; // the absolute error for |f(x)| <= 1, or the relative error
+    for (i = 0; i < n; i++) 
+    {
+        e1 = tb_max(e1, tb_demo_vector_ulp(y[i], exact(x[i])));
+        a1 = tb_max(a1, tb_fabs(y[i] - exact(x[i])) / tb_max(1.0, tb_fabs(exact(x[i]))));
+    }
+
+    // trace
+    tb_trace_i("%s: scalar: %lld ms, %.2f ulp, batch: %lld ms, %.2f ulp, abs: %.3f e-7", name, t0, e0, t1, e1, a1 * 1e7);
+}
+static tb_void_t tb_demo_vector_test_edge(tb_char_t const* name, tb_float_t const* x, tb_size_t n, tb_float_t (*scalar)(tb_float_t), tb_void_t (*batch)(tb_float_t const*, tb_float_t*, tb_size_t))
+{
+    // compute it
+    tb_float_t y[16];
+    tb_assert_and_check_return(n <= tb_arrayn(y));
+    batch(x, y, n);
+
+    // check it, the vector lanes and the tail values
+    tb_size_t i = 0;
+    tb_size_t e = 0;
+    for (i = 0; i < n; i++)
+    {
+        // the expected value
+        tb_float_t r = scalar(x[i]);
+        tb_bool_t  ok = tb_isnanf(r)? tb_isnanf(y[i]) : (y[i] == r || (tb_isfinf(r) && tb_fabs(y[i] - r) <= 1e-5 * tb_fabs(r)));
+        if (!ok)
+        {
+            tb_trace_i("%s(%f): %f != %f", name, x[i], y[i], r);
+            e++;
+        }
+    }
+
+    // trace
+    tb_trace_i("%s: edges: %lu, errors: %lu", name, n, e);
+}
+static tb_void_t tb_demo_vector_test_fixed16(tb_fixed16_t* x, tb_fixed16_t* y, tb_fixed16_t* z, tb_size_t n)
+{
+    // make values
+    tb_size_t i = 0;
+    for (i = 0; i < n; i++) 
+    {
+        x[i] = (tb_fixed16_t)tb_random_range(tb_null, -TB_FIXED16_ONE * 100, TB_FIXED16_ONE * 100);
+        y[i] = (tb_fixed16_t)tb_random_range(tb_null, -TB_FIXED16_ONE * 100, TB_FIXED16_ONE * 100);
+    }
+
+    // the scalar time
+    tb_hong_t t0 = tb_mclock();
+    for (i = 0; i < n; i++) z[i] = tb_fixed16_mul(x[i], y[i]);
+    t0 = tb_mclock() - t0;
+
+    // the batch time
+    tb_hong_t t1 = tb_mclock();
+    tb_fixed16_mul_n(x, y, z, n);
+    t1 = tb_mclock() - t1;
+
+    // check
+    tb_size_t e = 0;
+    for (i = 0; i < n; i++) if (z[i] != tb_fixed16_mul(x[i], y[i])) e++;
+
+    // trace
+    tb_trace_i("fixed16_mul: scalar: %lld ms, batch: %lld ms, errors: %lu", t0, t1, e);
+}
+static tb_double_t tb_demo_vector_exact_sqrt(tb_double_t x)
+{
+    return tb_sqrt(x);
+}
+static tb_double_t tb_demo_vector_exact_sin(tb_double_t x)
+{
+    return tb_sin(x);
+}
+static tb_double_t tb_demo_vector_exact_cos(tb_double_t x)
+{
+    return tb_cos(x);
+}
+static tb_double_t tb_demo_vector_exact_exp(tb_double_t x)
+{
+    return tb_exp(x);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */ 
+tb_int_t tb_demo_libm_vector_main(tb_int_t argc, tb_char_t** argv)
+{
+    // init values
+    tb_float_t* x = tb_nalloc_type(TB_DEMO_VECTOR_MAXN, tb_float_t);
+    tb_float_t* y = tb_nalloc_type(TB_DEMO_VECTOR_MAXN, tb_float_t);
+    tb_float_t* z = tb_nalloc_type(TB_DEMO_VECTOR_MAXN, tb_float_t);
+    if (x && y && z)
+    {
+        // sqrt: [0, 1e6)
+        tb_random_fill_float(tb_null, x, TB_DEMO_VECTOR_MAXN);
+        tb_size_t i = 0;
+        for (i = 0; i < TB_DEMO_VECTOR_MAXN; i++) x[i] *= 1e6f;
+        tb_demo_vector_test("sqrtf", x, y, TB_DEMO_VECTOR_MAXN, tb_sqrtf, tb_sqrtf_n, tb_demo_vector_exact_sqrt);
+
+        // sin and cos: [-8192, 8192)
+        tb_random_fill_float(tb_null, x, TB_DEMO_VECTOR_MAXN);
+        for (i = 0; i < TB_DEMO_VECTOR_MAXN; i++) x[i] = (x[i] - 0.5f) * 16384.0f;
+        tb_demo_vector_test("sinf[-8192, 8192]", x, y, TB_DEMO_VECTOR_MAXN, tb_sinf, tb_sinf_n, tb_demo_vector_exact_sin);
+        tb_demo_vector_test("cosf[-8192, 8192]", x, y, TB_DEMO_VECTOR_MAXN, tb_cosf, tb_cosf_n, tb_demo_vector_exact_cos);
+
+        // sin and cos: [-pi, pi)
+        for (i = 0; i < TB_DEMO_VECTOR_MAXN; i++) x[i] *= (tb_float_t)(TB_PI / 8192.0);
+        tb_demo_vector_test("sinf[-pi, pi]", x, y, TB_DEMO_VECTOR_MAXN, tb_sinf, tb_sinf_n, tb_demo_vector_exact_sin);
+        tb_demo_vector_test("cosf[-pi, pi]", x, y, TB_DEMO_VECTOR_MAXN, tb_cosf, tb_cosf_n, tb_demo_vector_exact_cos);
+
+        // sin and cos: out of range, inf and nan
+        tb_float_t const sincos_edges[] = {1e4f, -1e4f, TB_INF, -TB_INF, TB_NAN, 1.0f, 8192.0f, 8193.0f, 3e38f};
+        tb_demo_vector_test_edge("sinf", sincos_edges, tb_arrayn(sincos_edges), tb_sinf, tb_sinf_n);
+        tb_demo_vector_test_edge("cosf", sincos_edges, tb_arrayn(sincos_edges), tb_cosf, tb_cosf_n);
+
+        // exp: [-87.3, 88.3)
+        tb_random_fill_float(tb_null, x, TB_DEMO_VECTOR_MAXN);
+        for (i = 0; i < TB_DEMO_VECTOR_MAXN; i++) x[i] = x[i] * 175.6f - 87.3f;
+        tb_demo_vector_test("expf", x, y, TB_DEMO_VECTOR_MAXN, tb_expf, tb_expf_n, tb_demo_vector_exact_exp);
+
+        // exp: overflow, underflow, subnormal, inf and nan
+        tb_float_t const exp_edges[] = {TB_INF, 100.0f, 88.5f, 88.7f, 88.0f, 1.0f, -87.0f, -88.0f, -100.0f, -104.0f, -TB_INF, TB_NAN};
+        tb_demo_vector_test_edge("expf", exp_edges, tb_arrayn(exp_edges), tb_expf, tb_expf_n);
+
+        // fixed16
+        tb_demo_vector_test_fixed16((tb_fixed16_t*)x, (tb_fixed16_t*)y, (tb_fixed16_t*)z, TB_DEMO_VECTOR_MAXN);
+    }
+
+    // exit values
+    if (x) tb_free(x);
+    if (y) tb_free(y);
+    if (z) tb_free(z);
+    return 0;
+}
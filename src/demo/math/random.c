@@ -40,6 +40,58 @@ static tb_void_t tb_random_test_float(tb_float_t b, tb_float_t e)
     tb_trace_i("time: %lld, average: %f, range: %f - %f", t, rand / n, b, e);
 }
 #endif
+static tb_void_t tb_random_test_type(tb_char_t const* name, tb_size_t type)
+{
+    // init random
+    tb_random_ref_t random = tb_random_init(type, 2166136261ul);
+    if (random)
+    {
+        // init 
+        __tb_volatile__ tb_size_t   i = 0;
+        __tb_volatile__ tb_size_t   n = 10000000;
+        __tb_volatile__ tb_uint64_t rand = 0;
+
+        // the single value
+        tb_hong_t t = tb_mclock();
+        for (i = 0; i < n; i++) rand += tb_random_u64(random);
+        t = tb_mclock() - t;
+
+        // the bulk values
+        tb_uint64_t data[1024];
+        tb_hong_t   f = tb_mclock();
+        for (i = 0; i < n; i += tb_arrayn(data)) tb_random_fill_u64(random, data, tb_arrayn(data));
+        f = tb_mclock() - f;
+
+        // the distribution of the small range
+        tb_size_t count[6] = {0};
+        for (i = 0; i < 600000; i++) count[tb_random_range(random, 0, 6)]++;
+
+        // trace
+        tb_trace_i("%s: u64: %lld ms, fill: %lld ms, %lu M/s, dice: %lu %lu %lu %lu %lu %lu", name, t, f, f? (n / 1000) / (tb_size_t)f : 0, count[0], count[1], count[2], count[3], count[4], count[5]);
+
+        // exit random
+        tb_random_exit(random);
+    }
+}
+static tb_void_t tb_random_test_fill()
+{
+    // fill the uint32 values with the default random of the current thread
+    tb_size_t   i = 0;
+    tb_uint32_t data32[1001];
+    tb_uint64_t sum32 = 0;
+    tb_random_fill_u32(tb_null, data32, tb_arrayn(data32));
+    for (i = 0; i < tb_arrayn(data32); i++) sum32 += data32[i];
+    tb_trace_i("fill_u32: average: %llu ~= %u", sum32 / tb_arrayn(data32), TB_MAXU32 >> 1);
+
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+    // fill the float values
+    tb_float_t  dataf[1001];
+    tb_float_t  sumf = 0;
+    tb_random_fill_float(tb_null, dataf, tb_arrayn(dataf));
+    for (i = 0; i < tb_arrayn(dataf); i++) sumf += dataf[i];
+    tb_trace_i("fill_float: average: %f ~= 0.5", sumf / tb_arrayn(dataf));
+#endif
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
@@ -59,5 +111,9 @@ tb_int_t tb_demo_math_random_main(tb_int_t argc, tb_char_t** argv)
     tb_random_test_float(-200., 200.);
 #endif
 
+    tb_random_test_fill();
+    tb_random_test_type("linear", TB_RANDOM_TYPE_LINEAR);
+    tb_random_test_type("xoshiro", TB_RANDOM_TYPE_XOSHIRO);
+    tb_random_test_type("pcg", TB_RANDOM_TYPE_PCG);
     return 0;
 }
@@ -0,0 +1,256 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the timeout
+#define TB_DEMO_TIMEOUT         (10000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the server type
+typedef struct __tb_demo_server_t
+{
+    // the listening socket
+    tb_socket_ref_t     sock;
+
+    // the certificate file
+    tb_char_t const*    cert;
+
+    // the private key file
+    tb_char_t const*    key;
+
+    // the transfer size
+    tb_size_t           size;
+
+    // the offloaded mode
+    tb_size_t           ktls;
+
+    // is ok?
+    tb_bool_t           ok;
+
+}tb_demo_server_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+#ifdef TB_SSL_ENABLE
+static tb_bool_t tb_demo_ssl_bread(tb_ssl_ref_t ssl, tb_byte_t* data, tb_size_t size)
+{
+    // read it
+    tb_size_t read = 0;
+    while (read < size)
+    {
+        // read data
+        tb_long_t real = tb_ssl_read(ssl, data + read, size - read);
+        if (real > 0) read += real;
+        else if (!real)
+        {
+            // wait it
+            if (tb_ssl_wait(ssl, TB_AIOE_CODE_RECV, TB_DEMO_TIMEOUT) <= 0) break;
+        }
+        else break;
+    }
+
+    // ok?
+    return read == size;
+}
+static tb_bool_t tb_demo_ssl_bwrit(tb_ssl_ref_t ssl, tb_byte_t const* data, tb_size_t size)
+{
+    // writ it
+    tb_size_t writ = 0;
+    while (writ < size)
+    {
+        // writ data
+        tb_long_t real = tb_ssl_writ(ssl, data + writ, size - writ);
+        if (real > 0) writ += real;
+        else if (!real)
+        {
+            // wait it
+            if (tb_ssl_wait(ssl, TB_AIOE_CODE_SEND, TB_DEMO_TIMEOUT) <= 0) break;
+        }
+        else break;
+    }
+
+    // ok?
+    return writ == size;
+}
+static tb_pointer_t tb_demo_server_loop(tb_cpointer_t priv)
+{
+    // check
+    tb_demo_server_t* server = (tb_demo_server_t*)priv;
+    tb_assert_and_check_return_val(server && server->sock, tb_null);
+
+    // done
+    tb_socket_ref_t sock = tb_null;
+    tb_ssl_ref_t    ssl = tb_null;
+    tb_byte_t*      data = tb_null;
+    do
+    {
+        // accept it
+        while (!(sock = tb_socket_accept(server->sock, tb_null)))
+        {
+            if (tb_aioo_wait(server->sock, TB_AIOE_CODE_ACPT, TB_DEMO_TIMEOUT) <= 0) break;
+        }
+        tb_assert_and_check_break(sock);
+
+        // init ssl
+        ssl = tb_ssl_init(tb_true);
+        tb_assert_and_check_break(ssl);
+
+        // init the certificate and opt in the kernel tls
+        if (!tb_ssl_set_cert(ssl, server->cert, server->key)) break;
+        tb_ssl_set_ktls(ssl, tb_true);
+        tb_ssl_set_bio_sock(ssl, sock);
+        tb_ssl_set_timeout(ssl, TB_DEMO_TIMEOUT);
+
+        // open it
+        if (!tb_ssl_open(ssl)) break;
+
+        // offload it
+        server->ktls = tb_ssl_ktls_enable(ssl, sock);
+
+        // echo the data
+        data = tb_malloc_bytes(server->size);
+        tb_assert_and_check_break(data);
+        if (!tb_demo_ssl_bread(ssl, data, server->size)) break;
+        if (!tb_demo_ssl_bwrit(ssl, data, server->size)) break;
+
+        // wait the close notify of the client
+        tb_byte_t end[1];
+        if (tb_demo_ssl_bread(ssl, end, sizeof(end)) || tb_ssl_state(ssl) != TB_STATE_CLOSED) break;
+
+        // close it
+        server->ok = tb_ssl_clos(ssl);
+
+    } while (0);
+
+    // exit it
+    if (data) tb_free(data);
+    if (ssl) tb_ssl_exit(ssl);
+    if (sock) tb_socket_exit(sock);
+    return tb_null;
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_network_ktls_main(tb_int_t argc, tb_char_t** argv)
+{
+#ifdef TB_SSL_ENABLE
+    // check
+    tb_check_return_val(argc > 2, 0);
+
+    // init server
+    tb_demo_server_t server = {0};
+    server.cert = argv[1];
+    server.key  = argv[2];
+    server.size = argv[3]? tb_atoi(argv[3]) : 1024 * 1024;
+
+    // done
+    tb_socket_ref_t sock = tb_null;
+    tb_ssl_ref_t    ssl = tb_null;
+    tb_thread_ref_t loop = tb_null;
+    tb_byte_t*      send = tb_null;
+    tb_byte_t*      recv = tb_null;
+    tb_size_t       ktls = TB_SSL_KTLS_NONE;
+    tb_bool_t       ok = tb_false;
+    do
+    {
+        // listen on a loopback port
+        tb_ipaddr_t addr;
+        server.sock = tb_socket_init(TB_SOCKET_TYPE_TCP, TB_IPADDR_FAMILY_IPV4);
+        tb_assert_and_check_break(server.sock);
+        if (!tb_ipaddr_set(&addr, "127.0.0.1", 0, TB_IPADDR_FAMILY_IPV4)) break;
+        if (!tb_socket_bind(server.sock, &addr) || !tb_socket_local(server.sock, &addr)) break;
+        if (!tb_socket_listen(server.sock, 5)) break;
+
+        // init the server loop
+        loop = tb_thread_init(tb_null, tb_demo_server_loop, &server, 0);
+        tb_assert_and_check_break(loop);
+
+        // connect it
+        tb_long_t real = -1;
+        sock = tb_socket_init(TB_SOCKET_TYPE_TCP, TB_IPADDR_FAMILY_IPV4);
+        tb_assert_and_check_break(sock);
+        while (!(real = tb_socket_connect(sock, &addr)))
+        {
+            real = tb_aioo_wait(sock, TB_AIOE_CODE_CONN, TB_DEMO_TIMEOUT);
+            tb_check_break(real > 0);
+        }
+        tb_check_break(real > 0);
+
+        // open ssl with the kernel tls
+        ssl = tb_ssl_init(tb_false);
+        tb_assert_and_check_break(ssl);
+        tb_ssl_set_ktls(ssl, tb_true);
+        tb_ssl_set_bio_sock(ssl, sock);
+        tb_ssl_set_timeout(ssl, TB_DEMO_TIMEOUT);
+        if (!tb_ssl_open(ssl)) break;
+
+        // offload it
+        ktls = tb_ssl_ktls_enable(ssl, sock);
+
+        // trace
+        tb_trace_i("ktls: client: send: %s, recv: %s", (ktls & TB_SSL_KTLS_SEND)? "ok" : "no", (ktls & TB_SSL_KTLS_RECV)? "ok" : "no");
+
+        // the kernel tls is unavailable? verify the transfer by openssl
+        if (!ktls) tb_trace_i("ktls: unavailable, transfer by the user space tls");
+
+        // make data
+        tb_size_t i = 0;
+        send = tb_malloc_bytes(server.size);
+        recv = tb_malloc0_bytes(server.size);
+        tb_assert_and_check_break(send && recv);
+        for (i = 0; i < server.size; i++) send[i] = (tb_byte_t)(i * 31 + (i >> 8));
+
+        // transfer it
+        tb_hong_t time = tb_mclock();
+        if (!tb_demo_ssl_bwrit(ssl, send, server.size)) break;
+        if (!tb_demo_ssl_bread(ssl, recv, server.size)) break;
+        time = tb_mclock() - time;
+
+        // verify it
+        if (tb_memcmp(send, recv, server.size)) break;
+
+        // close it
+        if (!tb_ssl_clos(ssl)) break;
+
+        // trace
+        tb_trace_i("ktls: transfer: %lu bytes, %lld ms", server.size, time);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // wait the server loop
+    if (loop)
+    {
+        tb_thread_wait(loop, -1);
+        tb_thread_exit(loop);
+    }
+
+    // trace
+    tb_trace_i("ktls: server: send: %s, recv: %s", (server.ktls & TB_SSL_KTLS_SEND)? "ok" : "no", (server.ktls & TB_SSL_KTLS_RECV)? "ok" : "no");
+    tb_trace_i("ktls: %s", ok && server.ok? "ok" : "failed");
+
+    // exit it
+    if (send) tb_free(send);
+    if (recv) tb_free(recv);
+    if (ssl) tb_ssl_exit(ssl);
+    if (sock) tb_socket_exit(sock);
+    if (server.sock) tb_socket_exit(server.sock);
+#else
+    // trace
+    tb_trace_i("ktls: no ssl");
+#endif
+    return 0;
+}
@@ -0,0 +1,269 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the timeout
+#define TB_DEMO_TIMEOUT         (10000)
+
+// the connection count
+#define TB_DEMO_COUNT           (4)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the server type
+typedef struct __tb_demo_server_t
+{
+    // the listening socket
+    tb_socket_ref_t     sock;
+
+    // the certificate file
+    tb_char_t const*    cert;
+
+    // the private key file
+    tb_char_t const*    key;
+
+    // the resumed count
+    tb_size_t           resumed;
+
+    // the served count
+    tb_size_t           served;
+
+}tb_demo_server_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+#ifdef TB_SSL_ENABLE
+static tb_bool_t tb_demo_ssl_bread(tb_ssl_ref_t ssl, tb_byte_t* data, tb_size_t size)
+{
+    // read it
+    tb_size_t read = 0;
+    while (read < size)
+    {
+        // read data
+        tb_long_t real = tb_ssl_read(ssl, data + read, size - read);
+        if (real > 0) read += real;
+        else if (!real)
+        {
+            // wait it
+            if (tb_ssl_wait(ssl, TB_AIOE_CODE_RECV, TB_DEMO_TIMEOUT) <= 0) break;
+        }
+        else break;
+    }
+
+    // ok?
+    return read == size;
+}
+static tb_bool_t tb_demo_ssl_bwrit(tb_ssl_ref_t ssl, tb_byte_t const* data, tb_size_t size)
+{
+    // writ it
+    tb_size_t writ = 0;
+    while (writ < size)
+    {
+        // writ data
+        tb_long_t real = tb_ssl_writ(ssl, data + writ, size - writ);
+        if (real > 0) writ += real;
+        else if (!real)
+        {
+            // wait it
+            if (tb_ssl_wait(ssl, TB_AIOE_CODE_SEND, TB_DEMO_TIMEOUT) <= 0) break;
+        }
+        else break;
+    }
+
+    // ok?
+    return writ == size;
+}
+static tb_pointer_t tb_demo_server_loop(tb_cpointer_t priv)
+{
+    // check
+    tb_demo_server_t* server = (tb_demo_server_t*)priv;
+    tb_assert_and_check_return_val(server && server->sock, tb_null);
+
+    // serve the connections
+    tb_size_t i = 0;
+    for (i = 0; i < TB_DEMO_COUNT; i++)
+    {
+        // done
+        tb_socket_ref_t sock = tb_null;
+        tb_ssl_ref_t    ssl = tb_null;
+        tb_bool_t       ok = tb_false;
+        do
+        {
+            // accept it
+            while (!(sock = tb_socket_accept(server->sock, tb_null)))
+            {
+                if (tb_aioo_wait(server->sock, TB_AIOE_CODE_ACPT, TB_DEMO_TIMEOUT) <= 0) break;
+            }
+            tb_assert_and_check_break(sock);
+
+            // init ssl
+            ssl = tb_ssl_init(tb_true);
+            tb_assert_and_check_break(ssl);
+
+            // init it
+            if (!tb_ssl_set_cert(ssl, server->cert, server->key)) break;
+            tb_ssl_set_bio_sock(ssl, sock);
+            tb_ssl_set_timeout(ssl, TB_DEMO_TIMEOUT);
+
+            // open it
+            if (!tb_ssl_open(ssl)) break;
+
+            // resumed?
+            if (tb_ssl_resumed(ssl)) server->resumed++;
+
+            // echo the data
+            tb_byte_t data[16];
+            if (!tb_demo_ssl_bread(ssl, data, sizeof(data))) break;
+            if (!tb_demo_ssl_bwrit(ssl, data, sizeof(data))) break;
+
+            // wait the close notify of the client
+            if (tb_demo_ssl_bread(ssl, data, 1) || tb_ssl_state(ssl) != TB_STATE_CLOSED) break;
+
+            // close it
+            ok = tb_ssl_clos(ssl);
+
+        } while (0);
+
+        // exit it
+        if (ssl) tb_ssl_exit(ssl);
+        if (sock) tb_socket_exit(sock);
+
+        // failed?
+        tb_check_break(ok);
+
+        // served
+        server->served++;
+    }
+
+    // end
+    return tb_null;
+}
+static tb_bool_t tb_demo_client_done(tb_ipaddr_ref_t addr, tb_bool_t* presumed)
+{
+    // done
+    tb_socket_ref_t sock = tb_null;
+    tb_ssl_ref_t    ssl = tb_null;
+    tb_bool_t       ok = tb_false;
+    do
+    {
+        // connect it
+        tb_long_t real = -1;
+        sock = tb_socket_init(TB_SOCKET_TYPE_TCP, TB_IPADDR_FAMILY_IPV4);
+        tb_assert_and_check_break(sock);
+        while (!(real = tb_socket_connect(sock, addr)))
+        {
+            real = tb_aioo_wait(sock, TB_AIOE_CODE_CONN, TB_DEMO_TIMEOUT);
+            tb_check_break(real > 0);
+        }
+        tb_check_break(real > 0);
+
+        // init ssl and resume the last session of this peer
+        ssl = tb_ssl_init(tb_false);
+        tb_assert_and_check_break(ssl);
+        tb_ssl_set_peer(ssl, "127.0.0.1", tb_ipaddr_port(addr));
+        tb_ssl_set_bio_sock(ssl, sock);
+        tb_ssl_set_timeout(ssl, TB_DEMO_TIMEOUT);
+
+        // open it
+        if (!tb_ssl_open(ssl)) break;
+
+        // resumed?
+        *presumed = tb_ssl_resumed(ssl);
+
+        // transfer it, the tls 1.3 session tickets are received after the handshake
+        tb_byte_t send[16];
+        tb_byte_t recv[16];
+        tb_memset(send, 's', sizeof(send));
+        if (!tb_demo_ssl_bwrit(ssl, send, sizeof(send))) break;
+        if (!tb_demo_ssl_bread(ssl, recv, sizeof(recv))) break;
+        if (tb_memcmp(send, recv, sizeof(send))) break;
+
+        // close it
+        ok = tb_ssl_clos(ssl);
+
+    } while (0);
+
+    // exit it
+    if (ssl) tb_ssl_exit(ssl);
+    if (sock) tb_socket_exit(sock);
+    return ok;
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_network_session_main(tb_int_t argc, tb_char_t** argv)
+{
+#ifdef TB_SSL_ENABLE
+    // check
+    tb_check_return_val(argc > 2, 0);
+
+    // init server
+    tb_demo_server_t server = {0};
+    server.cert = argv[1];
+    server.key  = argv[2];
+
+    // done
+    tb_thread_ref_t loop = tb_null;
+    tb_size_t       resumed = 0;
+    tb_size_t       opened = 0;
+    do
+    {
+        // listen on a loopback port
+        tb_ipaddr_t addr;
+        server.sock = tb_socket_init(TB_SOCKET_TYPE_TCP, TB_IPADDR_FAMILY_IPV4);
+        tb_assert_and_check_break(server.sock);
+        if (!tb_ipaddr_set(&addr, "127.0.0.1", 0, TB_IPADDR_FAMILY_IPV4)) break;
+        if (!tb_socket_bind(server.sock, &addr) || !tb_socket_local(server.sock, &addr)) break;
+        if (!tb_socket_listen(server.sock, 5)) break;
+
+        // init the server loop
+        loop = tb_thread_init(tb_null, tb_demo_server_loop, &server, 0);
+        tb_assert_and_check_break(loop);
+
+        // connect to the same peer repeatedly
+        tb_size_t i = 0;
+        for (i = 0; i < TB_DEMO_COUNT; i++)
+        {
+            // done it
+            tb_bool_t bresumed = tb_false;
+            if (!tb_demo_client_done(&addr, &bresumed)) break;
+
+            // trace
+            tb_trace_i("session: client: %lu: %s", i, bresumed? "resumed" : "new");
+
+            // opened
+            opened++;
+            if (bresumed) resumed++;
+        }
+
+    } while (0);
+
+    // wait the server loop
+    if (loop)
+    {
+        tb_thread_wait(loop, -1);
+        tb_thread_exit(loop);
+    }
+
+    // trace, only the first connection makes a new session
+    tb_trace_i("session: client: resumed: %lu/%lu, server: resumed: %lu/%lu", resumed, opened, server.resumed, server.served);
+    tb_trace_i("session: %s", (opened == TB_DEMO_COUNT && resumed == TB_DEMO_COUNT - 1 && server.resumed == resumed)? "ok" : "failed");
+
+    // exit it
+    if (server.sock) tb_socket_exit(server.sock);
+#else
+    // trace
+    tb_trace_i("session: no ssl");
+#endif
+    return 0;
+}
@@ -3,11 +3,136 @@
  */ 
 #include "../demo.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the unique number count, more than the offsets maxn of the writer (65536)
+#define TB_DEMO_BPLIST_COUNT        (100000)
+
+// the duplicate string count
+#define TB_DEMO_BPLIST_DUPS         (16)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_void_t tb_demo_object_bplist_test_dup_make(tb_char_t* data, tb_size_t maxn, tb_size_t index)
+{
+    // make the long duplicate string
+    tb_snprintf(data, maxn, "the duplicate leaf string of the bplist writer: %02lu", index % TB_DEMO_BPLIST_DUPS);
+}
+static tb_bool_t tb_demo_object_bplist_test_check(tb_object_ref_t object)
+{
+    // check
+    tb_check_return_val(object && tb_object_type(object) == TB_OBJECT_TYPE_ARRAY, tb_false);
+    tb_check_return_val(tb_object_array_size(object) == (TB_DEMO_BPLIST_COUNT << 1) + 1, tb_false);
+
+    // check the unique numbers and the duplicate strings
+    tb_size_t i = 0;
+    tb_char_t dup[64];
+    for (i = 0; i < TB_DEMO_BPLIST_COUNT; i++)
+    {
+        // check number
+        tb_object_ref_t number = tb_object_array_item(object, i << 1);
+        tb_check_return_val(number && tb_object_type(number) == TB_OBJECT_TYPE_NUMBER, tb_false);
+        tb_check_return_val(tb_object_number_uint32(number) == i, tb_false);
+
+        // check string
+        tb_object_ref_t string = tb_object_array_item(object, (i << 1) + 1);
+        tb_check_return_val(string && tb_object_type(string) == TB_OBJECT_TYPE_STRING, tb_false);
+        tb_demo_object_bplist_test_dup_make(dup, sizeof(dup), i);
+        tb_check_return_val(!tb_strcmp(tb_object_string_cstr(string), dup), tb_false);
+    }
+
+    // check the dictionary with the duplicate keys
+    tb_object_ref_t dictionary = tb_object_array_item(object, TB_DEMO_BPLIST_COUNT << 1);
+    tb_check_return_val(dictionary && tb_object_type(dictionary) == TB_OBJECT_TYPE_DICTIONARY, tb_false);
+    tb_check_return_val(tb_object_dictionary_size(dictionary) == TB_DEMO_BPLIST_DUPS, tb_false);
+    for (i = 0; i < TB_DEMO_BPLIST_DUPS; i++)
+    {
+        tb_demo_object_bplist_test_dup_make(dup, sizeof(dup), i);
+        tb_object_ref_t number = tb_object_dictionary_value(dictionary, dup);
+        tb_check_return_val(number && tb_object_type(number) == TB_OBJECT_TYPE_NUMBER, tb_false);
+        tb_check_return_val(tb_object_number_uint32(number) == i, tb_false);
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_demo_object_bplist_test_leaves()
+{
+    // done
+    tb_object_ref_t array = tb_null;
+    tb_object_ref_t object = tb_null;
+    tb_byte_t*      data = tb_null;
+    tb_long_t       size = -1;
+    tb_bool_t       ok = tb_false;
+    do
+    {
+        // init array
+        array = tb_object_array_init(TB_DEMO_BPLIST_COUNT, tb_false);
+        tb_assert_and_check_break(array);
+
+        // append the unique numbers and the duplicate strings
+        tb_size_t i = 0;
+        tb_char_t dup[64];
+        for (i = 0; i < TB_DEMO_BPLIST_COUNT; i++)
+        {
+            tb_demo_object_bplist_test_dup_make(dup, sizeof(dup), i);
+            tb_object_array_append(array, tb_object_number_init_from_uint32((tb_uint32_t)i));
+            tb_object_array_append(array, tb_object_string_init_from_cstr(dup));
+        }
+
+        // append the dictionary with the duplicate keys and numbers
+        tb_object_ref_t dictionary = tb_object_dictionary_init(0, tb_false);
+        tb_assert_and_check_break(dictionary);
+        for (i = 0; i < TB_DEMO_BPLIST_DUPS; i++)
+        {
+            tb_demo_object_bplist_test_dup_make(dup, sizeof(dup), i);
+            tb_object_dictionary_insert(dictionary, dup, tb_object_number_init_from_uint32((tb_uint32_t)i));
+        }
+        tb_object_array_append(array, dictionary);
+
+        // writ it, the offsets of the unique objects are spilled to the temporary file
+        tb_size_t maxn = TB_DEMO_BPLIST_COUNT * 64;
+        data = tb_malloc_bytes(maxn);
+        tb_assert_and_check_break(data);
+        size = tb_object_writ_to_data(array, data, maxn, TB_OBJECT_FORMAT_BPLIST);
+        tb_check_break(size > 0);
+
+        // the duplicate strings are written once, so it is less than the strings only
+        tb_check_break(size < TB_DEMO_BPLIST_COUNT * (tb_long_t)tb_strlen(dup));
+
+        // read it
+        object = tb_object_read_from_data(data, size);
+        tb_check_break(object);
+
+        // check it
+        ok = tb_demo_object_bplist_test_check(object);
+
+    } while (0);
+
+    // trace
+    tb_trace_i("leaves: %s: size: %ld", ok? "ok" : "failed", size);
+
+    // exit it
+    if (data) tb_free(data);
+    if (object) tb_object_exit(object);
+    if (array) tb_object_exit(array);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */ 
 tb_int_t tb_demo_object_bplist_main(tb_int_t argc, tb_char_t** argv)
 {
+    // test the duplicate leaves and the spilled offsets
+    if (!argv[1])
+    {
+        tb_demo_object_bplist_test_leaves();
+        return 0;
+    }
+
     // read object
     tb_object_ref_t object = tb_object_read_from_url(argv[1]);
 
@@ -0,0 +1,163 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */ 
+static tb_void_t tb_demo_object_dictionary_test_small(tb_size_t keys)
+{
+    // make keys
+    tb_size_t i = 0;
+    tb_char_t names[16][16];
+    for (i = 0; i < tb_arrayn(names); i++) tb_snprintf(names[i], sizeof(names[i]), "key_%lu", i);
+
+    // done
+    __tb_volatile__ tb_size_t   n = 100000;
+    __tb_volatile__ tb_size_t   m = 0;
+    tb_hong_t                   t = tb_mclock();
+    for (i = 0; i < n; i++)
+    {
+        // init dictionary
+        tb_object_ref_t dictionary = tb_object_dictionary_init(0, tb_false);
+        if (dictionary)
+        {
+            // insert and find values
+            tb_size_t j = 0;
+            for (j = 0; j < keys; j++) tb_object_dictionary_insert(dictionary, names[j], tb_object_number_init_from_uint32((tb_uint32_t)j));
+            for (j = 0; j < keys; j++) if (tb_object_dictionary_value(dictionary, names[j])) m++;
+
+            // exit dictionary
+            tb_object_exit(dictionary);
+        }
+    }
+    t = tb_mclock() - t;
+
+    // trace
+    tb_trace_i("dictionary: keys: %lu, found: %lu/%lu, %lld ms", keys, m, n * keys, t);
+}
+static tb_void_t tb_demo_object_dictionary_test_upgrade()
+{
+    // init dictionary
+    tb_object_ref_t dictionary = tb_object_dictionary_init(0, tb_false);
+    if (dictionary)
+    {
+        // insert values and upgrade it to the hash map
+        tb_size_t i = 0;
+        tb_char_t name[32];
+        for (i = 0; i < 12; i++)
+        {
+            tb_snprintf(name, sizeof(name), "key_%lu", i);
+            tb_object_dictionary_insert(dictionary, name, tb_object_number_init_from_uint32((tb_uint32_t)i));
+        }
+
+        // replace and remove values
+        tb_object_dictionary_insert(dictionary, "key_0", tb_object_string_init_from_cstr("replaced"));
+        tb_object_dictionary_remove(dictionary, "key_1");
+
+        // copy it
+        tb_object_ref_t copy = tb_object_copy(dictionary);
+        if (copy)
+        {
+            tb_object_dump(copy, TB_OBJECT_FORMAT_JSON);
+            tb_object_exit(copy);
+        }
+
+        // exit dictionary
+        tb_object_exit(dictionary);
+    }
+}
+static tb_void_t tb_demo_object_dictionary_test_intern(tb_size_t keys)
+{
+    // init records
+    tb_object_ref_t records = tb_object_array_init(0, tb_false);
+    if (records)
+    {
+        // make keys
+        tb_size_t i = 0;
+        tb_char_t names[16][16];
+        for (i = 0; i < tb_arrayn(names); i++) tb_snprintf(names[i], sizeof(names[i]), "key_%lu", i);
+
+        // intern the keys
+        tb_object_dictionary_intern(tb_true);
+
+        // make records with the same keys
+        tb_size_t   n = 10000;
+        tb_hong_t   t = tb_mclock();
+        for (i = 0; i < n; i++)
+        {
+            tb_object_ref_t dictionary = tb_object_dictionary_init(0, tb_false);
+            if (dictionary)
+            {
+                tb_size_t j = 0;
+                for (j = 0; j < keys; j++) tb_object_dictionary_insert(dictionary, names[j], tb_object_number_init_from_uint32((tb_uint32_t)(i + j)));
+                tb_object_dictionary_remove(dictionary, names[0]);
+                tb_object_array_append(records, dictionary);
+            }
+        }
+        t = tb_mclock() - t;
+
+        // do not intern the keys of the new dictionaries
+        tb_object_dictionary_intern(tb_false);
+
+        // check the interned keys
+        tb_size_t m = 0;
+        tb_char_t const* shared = tb_null;
+        tb_for_all (tb_object_ref_t, record, tb_object_array_itor(records))
+        {
+            tb_for_all (tb_object_dictionary_item_t*, item, tb_object_dictionary_itor(record))
+            {
+                if (item && !tb_strcmp(item->key, names[1]))
+                {
+                    if (!shared) shared = item->key;
+                    if (item->key == shared) m++;
+                }
+            }
+        }
+
+        // trace
+        tb_trace_i("intern: keys: %lu, shared: %lu/%lu, %lld ms", keys, m, n, t);
+
+        // exit records
+        tb_object_exit(records);
+    }
+}
+static tb_void_t tb_demo_object_array_test()
+{
+    // init array
+    tb_object_ref_t array = tb_object_array_init(0, tb_false);
+    if (array)
+    {
+        // append, insert and replace items
+        tb_size_t i = 0;
+        for (i = 0; i < 6; i++) tb_object_array_append(array, tb_object_number_init_from_uint32((tb_uint32_t)i));
+        tb_object_array_insert(array, 0, tb_object_string_init_from_cstr("head"));
+        tb_object_array_replace(array, 1, tb_object_string_init_from_cstr("replaced"));
+        tb_object_array_remove(array, 2);
+        tb_object_dump(array, TB_OBJECT_FORMAT_JSON);
+
+        // upgrade it to the vector
+        for (i = 0; i < 6; i++) tb_object_array_append(array, tb_object_number_init_from_uint32((tb_uint32_t)(i + 100)));
+        tb_object_array_insert(array, 1, tb_object_string_init_from_cstr("second"));
+        tb_trace_i("array: size: %lu, item[1]: %s", tb_object_array_size(array), tb_object_string_cstr(tb_object_array_item(array, 1)));
+
+        // exit array
+        tb_object_exit(array);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */ 
+tb_int_t tb_demo_object_dictionary_main(tb_int_t argc, tb_char_t** argv)
+{
+    tb_demo_object_dictionary_test_upgrade();
+    tb_demo_object_array_test();
+    tb_demo_object_dictionary_test_intern(4);
+    tb_demo_object_dictionary_test_intern(16);
+    tb_demo_object_dictionary_test_small(4);
+    tb_demo_object_dictionary_test_small(8);
+    tb_demo_object_dictionary_test_small(16);
+    return 0;
+}
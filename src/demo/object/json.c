@@ -3,11 +3,72 @@
  */ 
 #include "../demo.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_void_t tb_demo_object_json_test_escape()
+{
+    // the escaped keys and values
+    static tb_char_t const* s_strs[] =
+    {
+        "q\"k"
+    ,   "back\\slash"
+    ,   "tab\tline\nfeed"
+    ,   "'single'"
+    ,   ""
+    };
+
+    // init dictionary
+    tb_object_ref_t dictionary = tb_object_dictionary_init(0, tb_false);
+    if (dictionary)
+    {
+        // insert the escaped keys and values
+        tb_size_t i = 0;
+        for (i = 0; i < tb_arrayn(s_strs); i++)
+            tb_object_dictionary_insert(dictionary, s_strs[i], tb_object_string_init_from_cstr(s_strs[(i + 1) % tb_arrayn(s_strs)]));
+
+        // writ and read it
+        tb_size_t           found = 0;
+        tb_byte_t           data[1024];
+        tb_long_t           size = tb_object_writ_to_data(dictionary, data, sizeof(data), TB_OBJECT_FORMAT_JSON);
+        tb_object_ref_t     object = size > 0? tb_object_read_from_data(data, size) : tb_null;
+        if (object)
+        {
+            // find the escaped keys and values
+            for (i = 0; i < tb_arrayn(s_strs); i++)
+            {
+                tb_object_ref_t value = tb_object_dictionary_value(object, s_strs[i]);
+                if (value && tb_object_type(value) == TB_OBJECT_TYPE_STRING)
+                {
+                    tb_char_t const* cstr = tb_object_string_cstr(value);
+                    if (!tb_strcmp(cstr? cstr : "", s_strs[(i + 1) % tb_arrayn(s_strs)])) found++;
+                }
+            }
+
+            // exit object
+            tb_object_exit(object);
+        }
+
+        // trace
+        tb_trace_i("escape: %s: found: %lu/%lu", found == tb_arrayn(s_strs)? "ok" : "failed", found, tb_arrayn(s_strs));
+
+        // exit dictionary
+        tb_object_exit(dictionary);
+    }
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */ 
 tb_int_t tb_demo_object_json_main(tb_int_t argc, tb_char_t** argv)
 {
+    // test the escaped strings
+    if (!argv[1])
+    {
+        tb_demo_object_json_test_escape();
+        return 0;
+    }
+
     // read object
     tb_object_ref_t object = tb_object_read_from_url(argv[1]);
 
@@ -0,0 +1,106 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */ 
+static tb_void_t tb_demo_object_patch_dump(tb_char_t const* name, tb_object_ref_t object)
+{
+    // writ the patch
+    tb_byte_t data[4096];
+    tb_long_t size = tb_object_writ_patch_to_data(object, data, sizeof(data) - 1);
+    if (size >= 0) data[size] = '\0';
+    tb_trace_i("%s: %ld bytes: %s", name, size, size >= 0? (tb_char_t const*)data : "failed");
+}
+static tb_void_t tb_demo_object_patch_test()
+{
+    // init the tree
+    tb_char_t const* json = "{\"name\":\"tbox\",\"version\":{\"major\":1,\"minor\":5},\"tags\":[\"c\",\"lib\"],\"a/b\":true,\"old\":null}";
+    tb_object_ref_t root = tb_object_read_from_data((tb_byte_t const*)json, tb_strlen(json));
+    if (root)
+    {
+        // track it
+        tb_object_track(root);
+        tb_demo_object_patch_dump("none", root);
+
+        // change the leaves
+        tb_object_number_uint32_set(tb_object_seek(root, ".version.minor", tb_false), 6);
+        tb_object_string_cstr_set(tb_object_seek(root, ".tags[1]", tb_false), "library");
+        tb_demo_object_patch_dump("leaves", root);
+
+        // change the keys
+        tb_object_dictionary_insert(root, "a/b", tb_object_boolean_init(tb_false));
+        tb_object_dictionary_insert(root, "new~", tb_object_string_init_from_cstr("added"));
+        tb_object_dictionary_remove(root, "old");
+        tb_demo_object_patch_dump("keys", root);
+
+        // insert and remove the same key, nothing to writ
+        tb_object_dictionary_insert(root, "temp", tb_object_null_init());
+        tb_object_dictionary_remove(root, "temp");
+        tb_demo_object_patch_dump("temp", root);
+
+        // change the array
+        tb_object_array_append(tb_object_seek(root, ".tags", tb_false), tb_object_string_init_from_cstr("xmake"));
+        tb_demo_object_patch_dump("array", root);
+
+        // exit it
+        tb_object_exit(root);
+    }
+}
+static tb_void_t tb_demo_object_patch_perf()
+{
+    // init the tree
+    tb_object_ref_t root = tb_object_dictionary_init(0, tb_false);
+    if (root)
+    {
+        // make it
+        tb_size_t i = 0;
+        tb_char_t key[64];
+        for (i = 0; i < 10000; i++)
+        {
+            tb_object_ref_t item = tb_object_dictionary_init(0, tb_false);
+            if (!item) break;
+            tb_object_dictionary_insert(item, "id", tb_object_number_init_from_uint32((tb_uint32_t)i));
+            tb_object_dictionary_insert(item, "name", tb_object_string_init_from_cstr("the item name"));
+            tb_snprintf(key, sizeof(key), "item_%lu", i);
+            tb_object_dictionary_insert(root, key, item);
+        }
+        tb_object_track(root);
+
+        // change one leaf
+        tb_object_number_uint32_set(tb_object_seek(root, ".item_5000.id", tb_false), 12345);
+
+        // writ the full tree
+        tb_size_t   maxn = 4 * 1024 * 1024;
+        tb_byte_t*  data = tb_malloc_bytes(maxn);
+        if (data)
+        {
+            tb_hong_t t = tb_mclock();
+            tb_long_t full = tb_object_writ_to_data(root, data, maxn, TB_OBJECT_FORMAT_JSON);
+            t = tb_mclock() - t;
+
+            tb_hong_t p = tb_mclock();
+            tb_long_t patch = tb_object_writ_patch_to_data(root, data, maxn);
+            p = tb_mclock() - p;
+
+            // trace
+            tb_trace_i("perf: full: %ld bytes %lld ms, patch: %ld bytes %lld ms", full, t, patch, p);
+            tb_free(data);
+        }
+
+        // exit it
+        tb_object_exit(root);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */ 
+tb_int_t tb_demo_object_patch_main(tb_int_t argc, tb_char_t** argv)
+{
+    tb_demo_object_patch_test();
+    tb_demo_object_patch_perf();
+    return 0;
+}
@@ -0,0 +1,130 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */ 
+
+// the records stats type
+typedef struct __tb_demo_records_stats_t
+{
+    // the records count
+    tb_atomic_t         count;
+
+    // the last record id
+    tb_atomic_t         last;
+
+    // the out of order records count
+    tb_atomic_t         unordered;
+
+}tb_demo_records_stats_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */ 
+static tb_bool_t tb_demo_object_records_func(tb_object_ref_t object, tb_cpointer_t priv)
+{
+    // the stats
+    tb_demo_records_stats_t* stats = (tb_demo_records_stats_t*)priv;
+    tb_assert_and_check_return_val(stats, tb_false);
+
+    // the record id
+    tb_object_ref_t id = tb_object_dictionary_value(object, "id");
+    tb_long_t       value = id? (tb_long_t)tb_object_number_uint32(id) : -1;
+
+    // check order
+    if (value != tb_atomic_get(&stats->last) + 1) tb_atomic_fetch_and_inc(&stats->unordered);
+    tb_atomic_set(&stats->last, value);
+    tb_atomic_fetch_and_inc(&stats->count);
+    return tb_true;
+}
+static tb_void_t tb_demo_object_records_test(tb_char_t const* name, tb_byte_t const* data, tb_size_t size, tb_size_t format, tb_bool_t ordered)
+{
+    // done
+    tb_demo_records_stats_t stats = {0};
+    stats.last = -1;
+    tb_hong_t t = tb_mclock();
+    tb_long_t n = tb_object_read_records_from_data(data, size, format, ordered, tb_demo_object_records_func, &stats);
+    t = tb_mclock() - t;
+
+    // trace
+    tb_trace_i("%s: %s: count: %ld, passed: %ld, unordered: %ld, %lld ms", name, ordered? "ordered" : "unordered", n, tb_atomic_get(&stats.count), tb_atomic_get(&stats.unordered), t);
+}
+static tb_void_t tb_demo_object_records_test_serial(tb_byte_t const* data, tb_size_t size)
+{
+    // read the json lines one by one
+    tb_size_t           n = 0;
+    tb_byte_t const*    p = data;
+    tb_byte_t const*    e = data + size;
+    tb_hong_t           t = tb_mclock();
+    while (p < e)
+    {
+        // the line
+        tb_byte_t const* q = p;
+        while (q < e && *q != '\n') q++;
+
+        // read object
+        tb_object_ref_t object = tb_object_read_from_data(p, q - p);
+        if (object)
+        {
+            n++;
+            tb_object_exit(object);
+        }
+        p = q + 1;
+    }
+    t = tb_mclock() - t;
+
+    // trace
+    tb_trace_i("json: serial: count: %lu, %lld ms", n, t);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */ 
+tb_int_t tb_demo_object_records_main(tb_int_t argc, tb_char_t** argv)
+{
+    // read the records from the given url
+    if (argc > 1)
+    {
+        tb_demo_records_stats_t stats = {0};
+        stats.last = -1;
+        tb_size_t format = (argc > 2 && !tb_strcmp(argv[2], "xml"))? TB_OBJECT_FORMAT_XML : TB_OBJECT_FORMAT_JSON;
+        tb_hong_t t = tb_mclock();
+        tb_long_t n = tb_object_read_records_from_url(argv[1], format, tb_true, tb_demo_object_records_func, &stats);
+        tb_trace_i("%s: count: %ld, unordered: %ld, %lld ms", argv[1], n, tb_atomic_get(&stats.unordered), tb_mclock() - t);
+        return 0;
+    }
+
+    // make the json and xml records
+    tb_size_t       i = 0;
+    tb_size_t       n = 100000;
+    tb_buffer_t     json;
+    tb_buffer_t     xml;
+    if (tb_buffer_init(&json) && tb_buffer_init(&xml))
+    {
+        tb_char_t line[256];
+        for (i = 0; i < n; i++)
+        {
+            tb_long_t size = tb_snprintf(line, sizeof(line), "{\"id\": %lu, \"name\": \"record_%lu\", \"tags\": [\"a\", \"b\"], \"value\": %lu.5}\n", i, i, i * 7);
+            if (size > 0) tb_buffer_memncat(&json, (tb_byte_t const*)line, size);
+
+            size = tb_snprintf(line, sizeof(line), "<dict><key>id</key><number>%lu</number><key>name</key><string>record_%lu</string></dict>\n", i, i);
+            if (size > 0) tb_buffer_memncat(&xml, (tb_byte_t const*)line, size);
+        }
+
+        // test them
+        tb_demo_object_records_test_serial(tb_buffer_data(&json), tb_buffer_size(&json));
+        tb_demo_object_records_test("json", tb_buffer_data(&json), tb_buffer_size(&json), TB_OBJECT_FORMAT_JSON, tb_true);
+        tb_demo_object_records_test("json", tb_buffer_data(&json), tb_buffer_size(&json), TB_OBJECT_FORMAT_JSON, tb_false);
+#ifdef TB_CONFIG_MODULE_HAVE_XML
+        tb_demo_object_records_test("xml", tb_buffer_data(&xml), tb_buffer_size(&xml), TB_OBJECT_FORMAT_XML, tb_true);
+#endif
+    }
+
+    // exit buffers
+    tb_buffer_exit(&json);
+    tb_buffer_exit(&xml);
+    return 0;
+}
@@ -0,0 +1,48 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */ 
+static tb_void_t tb_demo_cycle_test_clock(tb_char_t const* name, tb_hong_t (*clock)(tb_noarg_t))
+{
+    // init 
+    __tb_volatile__ tb_size_t   i = 0;
+    __tb_volatile__ tb_size_t   n = 10000000;
+    __tb_volatile__ tb_hong_t   v = 0;
+
+    // done
+    tb_uint64_t t = tb_cycle();
+    for (i = 0; i < n; i++) v += clock();
+    t = tb_cycle() - t;
+    tb_trace_i("%s: %lld ns/call", name, tb_cycle_to_nclock(t) / n);
+}
+static tb_hong_t tb_demo_cycle_clock(tb_noarg_t)
+{
+    return (tb_hong_t)tb_cycle();
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */ 
+tb_int_t tb_demo_platform_cycle_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the frequency
+    tb_trace_i("frequency: %llu", tb_cycle_frequency());
+
+    // the clocks
+    tb_trace_i("mclock: %lld, nclock: %lld, cycle_nclock: %lld", tb_mclock(), tb_nclock(), tb_cycle_nclock());
+    tb_msleep(100);
+    tb_trace_i("mclock: %lld, nclock: %lld, cycle_nclock: %lld", tb_mclock(), tb_nclock(), tb_cycle_nclock());
+
+    // the overhead
+    tb_demo_cycle_test_clock("cycle", tb_demo_cycle_clock);
+    tb_demo_cycle_test_clock("cycle_nclock", tb_cycle_nclock);
+    tb_demo_cycle_test_clock("nclock", tb_nclock);
+    tb_demo_cycle_test_clock("uclock", tb_uclock);
+    tb_demo_cycle_test_clock("mclock", tb_mclock);
+    tb_demo_cycle_test_clock("cache_time_spak", tb_cache_time_spak);
+    return 0;
+}
@@ -0,0 +1,155 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the fields count
+#define TB_DEMO_FIELD_MAXN      (100000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_size_t tb_demo_static_bits_nbits(tb_size_t i)
+{
+    return 1 + ((i * 7) % 32);
+}
+static tb_uint32_t tb_demo_static_bits_value(tb_size_t i)
+{
+    tb_uint32_t val = (tb_uint32_t)(i * 2654435761ul);
+    tb_size_t   n = tb_demo_static_bits_nbits(i);
+    return n < 32? val & ((1 << n) - 1) : val;
+}
+static tb_bool_t tb_demo_static_bits_test_check(tb_byte_t* data, tb_size_t size)
+{
+    // write fields
+    tb_size_t               i = 0;
+    tb_static_stream_t      stream;
+    tb_static_bits_writer_t writer;
+    tb_static_stream_init(&stream, data, size);
+    tb_static_stream_writ_ubits32(&stream, 5, 3);
+    if (!tb_static_bits_writer_init(&writer, &stream)) return tb_false;
+    for (i = 0; i < TB_DEMO_FIELD_MAXN; i++)
+    {
+        tb_static_bits_writer_writ_ubits32(&writer, tb_demo_static_bits_value(i), tb_demo_static_bits_nbits(i));
+        tb_static_bits_writer_writ_ue(&writer, (tb_uint32_t)i);
+        tb_static_bits_writer_writ_se(&writer, (i & 1)? -(tb_sint32_t)i : (tb_sint32_t)i);
+        tb_static_bits_writer_writ_uleb128(&writer, (tb_uint64_t)i << (i & 31));
+        tb_static_bits_writer_writ_sleb128(&writer, -(tb_sint64_t)i << (i & 15));
+        tb_static_bits_writer_writ_zigzag(&writer, (i & 1)? -(tb_sint64_t)i : (tb_sint64_t)i);
+    }
+    tb_static_bits_writer_writ_ubits32(&writer, 0x15, 5);
+    tb_static_bits_writer_writ_ubits64(&writer, 0x0123456789abcdefull, 64);
+    if (!tb_static_bits_writer_exit(&writer)) return tb_false;
+    tb_byte_t const*    pos = stream.p;
+    tb_size_t           bit = stream.b;
+
+    // read them with the bits reader
+    tb_static_bits_reader_t reader;
+    tb_static_stream_init(&stream, data, size);
+    if (tb_static_stream_read_ubits32(&stream, 3) != 5) return tb_false;
+    if (!tb_static_bits_reader_init(&reader, &stream)) return tb_false;
+    for (i = 0; i < TB_DEMO_FIELD_MAXN; i++)
+    {
+        if (tb_static_bits_reader_read_ubits32(&reader, tb_demo_static_bits_nbits(i)) != tb_demo_static_bits_value(i)) break;
+        if (tb_static_bits_reader_read_ue(&reader) != (tb_uint32_t)i) break;
+        if (tb_static_bits_reader_read_se(&reader) != ((i & 1)? -(tb_sint32_t)i : (tb_sint32_t)i)) break;
+        if (tb_static_bits_reader_read_uleb128(&reader) != (tb_uint64_t)i << (i & 31)) break;
+        if (tb_static_bits_reader_read_sleb128(&reader) != -(tb_sint64_t)i << (i & 15)) break;
+        if (tb_static_bits_reader_read_zigzag(&reader) != ((i & 1)? -(tb_sint64_t)i : (tb_sint64_t)i)) break;
+    }
+    if (i != TB_DEMO_FIELD_MAXN) 
+    {
+        tb_trace_e("check: failed at %lu", i);
+        return tb_false;
+    }
+    if (tb_static_bits_reader_read_ubits32(&reader, 5) != 0x15) return tb_false;
+    if (tb_static_bits_reader_read_ubits64(&reader, 64) != 0x0123456789abcdefull) return tb_false;
+    if (!tb_static_bits_reader_exit(&reader)) return tb_false;
+
+    // the stream position have been synced?
+    if (stream.p != pos || stream.b != bit) return tb_false;
+
+    // read overflow
+    if (!tb_static_bits_reader_init(&reader, &stream)) return tb_false;
+    tb_static_bits_reader_skip_bits(&reader, tb_static_bits_reader_left(&reader));
+    tb_static_bits_reader_read_ue(&reader);
+    if (!reader.error) return tb_false;
+
+    // ok
+    tb_trace_i("check: %lu fields, %lu bytes, %lu bits: ok", TB_DEMO_FIELD_MAXN * 6, pos - data, bit);
+    return tb_true;
+}
+static tb_void_t tb_demo_static_bits_test_perf(tb_byte_t* data, tb_size_t size)
+{
+    // init
+    tb_size_t                   i = 0;
+    tb_size_t                   j = 0;
+    tb_static_stream_t          stream;
+    tb_static_bits_reader_t     reader;
+    __tb_volatile__ tb_size_t   v = 0;
+
+    // read fields with the static stream
+    tb_hong_t t = tb_mclock();
+    for (j = 0; j < 10; j++)
+    {
+        tb_static_stream_init(&stream, data, size);
+        for (i = 0; i < TB_DEMO_FIELD_MAXN; i++) v += tb_static_stream_read_ubits32(&stream, tb_demo_static_bits_nbits(i));
+    }
+    t = tb_mclock() - t;
+
+    // read fields with the bits reader
+    tb_hong_t r = tb_mclock();
+    for (j = 0; j < 10; j++)
+    {
+        tb_static_stream_init(&stream, data, size);
+        tb_static_bits_reader_init(&reader, &stream);
+        for (i = 0; i < TB_DEMO_FIELD_MAXN; i++) v += tb_static_bits_reader_read_ubits32(&reader, tb_demo_static_bits_nbits(i));
+        tb_static_bits_reader_exit(&reader);
+    }
+    r = tb_mclock() - r;
+
+    // read exp-golomb codes
+    tb_static_bits_writer_t writer;
+    tb_static_stream_init(&stream, data, size);
+    tb_static_bits_writer_init(&writer, &stream);
+    for (i = 0; i < TB_DEMO_FIELD_MAXN; i++) tb_static_bits_writer_writ_ue(&writer, (tb_uint32_t)(i & 1023));
+    tb_static_bits_writer_exit(&writer);
+    tb_hong_t u = tb_mclock();
+    for (j = 0; j < 10; j++)
+    {
+        tb_static_stream_init(&stream, data, size);
+        tb_static_bits_reader_init(&reader, &stream);
+        for (i = 0; i < TB_DEMO_FIELD_MAXN; i++) v += tb_static_bits_reader_read_ue(&reader);
+        tb_static_bits_reader_exit(&reader);
+    }
+    u = tb_mclock() - u;
+
+    // trace
+    tb_trace_i("perf: %lu fields x 10, static_stream: %lld ms, bits_reader: %lld ms, ue: %lld ms", TB_DEMO_FIELD_MAXN, t, r, u);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_stream_static_bits_main(tb_int_t argc, tb_char_t** argv)
+{
+    // init data
+    tb_size_t   size = TB_DEMO_FIELD_MAXN * 48;
+    tb_byte_t*  data = tb_malloc0_bytes(size);
+    if (data)
+    {
+        // check
+        if (!tb_demo_static_bits_test_check(data, size)) tb_trace_e("check: failed");
+
+        // perf
+        tb_demo_static_bits_test_perf(data, size);
+
+        // exit data
+        tb_free(data);
+    }
+    return 0;
+}
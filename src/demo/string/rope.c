@@ -0,0 +1,147 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_bool_t tb_demo_rope_equal(tb_rope_ref_t rope, tb_char_t const* cstr)
+{
+    // flatten it
+    tb_bool_t   ok = tb_false;
+    tb_buffer_t buffer;
+    if (tb_buffer_init(&buffer))
+    {
+        tb_size_t           size = tb_strlen(cstr);
+        tb_byte_t const*    data = tb_rope_flatten(rope, &buffer);
+        ok = tb_rope_size(rope) == size && (!size || (data && !tb_memcmp(data, cstr, size)));
+        tb_buffer_exit(&buffer);
+    }
+    return ok;
+}
+static tb_void_t tb_demo_rope_test_edit()
+{
+    // init ropes
+    tb_rope_t rope;
+    tb_rope_t other;
+    tb_rope_t sub;
+    tb_rope_init(&rope);
+    tb_rope_init(&other);
+    tb_rope_init(&sub);
+
+    // append and prepend
+    tb_rope_cstrcat(&rope, "world");
+    tb_rope_cstrpre(&rope, "hello ");
+    tb_rope_chrcat(&rope, '!');
+    tb_rope_cstrfcat(&rope, " %d", 2015);
+    tb_trace_i("edit: %s, slices: %lu", tb_demo_rope_equal(&rope, "hello world! 2015")? "ok" : "failed", tb_rope_slices(&rope));
+
+    // concat ropes, the chunks are shared 
+    tb_rope_cstrcat(&other, "[");
+    tb_rope_ropecat(&other, &rope);
+    tb_rope_cstrcat(&other, "]");
+    tb_rope_ropepre(&other, &other);
+    tb_trace_i("concat: %s, slices: %lu", tb_demo_rope_equal(&other, "[hello world! 2015][hello world! 2015]")? "ok" : "failed", tb_rope_slices(&other));
+
+    // the shared chunk will not be modified
+    tb_rope_cstrcat(&rope, "?");
+    tb_trace_i("shared: %s", tb_demo_rope_equal(&other, "[hello world! 2015][hello world! 2015]") && tb_demo_rope_equal(&rope, "hello world! 2015?")? "ok" : "failed");
+
+    // sub-rope
+    tb_rope_subrope(&other, &sub, 7, 24);
+    tb_trace_i("subrope: %s, slices: %lu", tb_demo_rope_equal(&sub, "world! 2015][hello world")? "ok" : "failed", tb_rope_slices(&sub));
+
+    // exit the parent ropes, the sub-rope is still valid
+    tb_rope_exit(&rope);
+    tb_rope_exit(&other);
+    tb_trace_i("subrope: %s after exiting parents", tb_demo_rope_equal(&sub, "world! 2015][hello world")? "ok" : "failed");
+    tb_rope_exit(&sub);
+}
+static tb_void_t tb_demo_rope_test_perf(tb_size_t count)
+{
+    // init
+    tb_size_t   i = 0;
+    tb_rope_t   rope;
+    tb_string_t string;
+    tb_rope_init(&rope);
+    tb_string_init(&string);
+
+    // append the lines to rope
+    tb_hong_t t0 = tb_mclock();
+    for (i = 0; i < count; i++) tb_rope_cstrcat(&rope, "<item>the rope line for appending</item>\n");
+    t0 = tb_mclock() - t0;
+
+    // append the lines to string
+    tb_hong_t t1 = tb_mclock();
+    for (i = 0; i < count; i++) tb_string_cstrcat(&string, "<item>the rope line for appending</item>\n");
+    t1 = tb_mclock() - t1;
+
+    // prepend the lines to rope
+    tb_rope_t pre;
+    tb_rope_init(&pre);
+    tb_hong_t t2 = tb_mclock();
+    for (i = 0; i < count; i++) tb_rope_cstrpre(&pre, "<item>the rope line for prepending</item>\n");
+    t2 = tb_mclock() - t2;
+
+    // concat the ropes 
+    tb_hong_t t3 = tb_mclock();
+    for (i = 0; i < 16; i++) tb_rope_ropecat(&rope, &pre);
+    t3 = tb_mclock() - t3;
+
+    // trace
+    tb_trace_i("perf: %lu lines, rope: append: %lld ms, prepend: %lld ms, concat: %lld ms, size: %lu, slices: %lu, string: append: %lld ms, size: %lu"
+        , count, t0, t2, t3, tb_rope_size(&rope), tb_rope_slices(&rope), t1, tb_string_size(&string));
+
+    // exit
+    tb_rope_exit(&pre);
+    tb_rope_exit(&rope);
+    tb_string_exit(&string);
+}
+static tb_void_t tb_demo_rope_test_writv(tb_char_t const* path)
+{
+    // init rope
+    tb_rope_t rope;
+    tb_rope_init(&rope);
+    tb_size_t i = 0;
+    for (i = 0; i < 100000; i++) tb_rope_cstrfcat(&rope, "line: %lu\n", i);
+
+    // init file
+    tb_file_ref_t file = tb_file_init(path, TB_FILE_MODE_RW | TB_FILE_MODE_CREAT | TB_FILE_MODE_TRUNC | TB_FILE_MODE_BINARY);
+    if (file)
+    {
+        // writ the rope without flattening
+        tb_size_t   offset = 0;
+        tb_iovec_t  list[16];
+        tb_hong_t   t = tb_mclock();
+        while (offset < tb_rope_size(&rope))
+        {
+            tb_size_t count = tb_rope_iovec(&rope, offset, list, tb_arrayn(list));
+            tb_long_t real = tb_file_writv(file, list, count);
+            tb_check_break(real > 0);
+            offset += real;
+        }
+        t = tb_mclock() - t;
+
+        // trace
+        tb_trace_i("writv: %s, %lu bytes, %lu slices, %lld ms", offset == tb_rope_size(&rope) && tb_file_size(file) == offset? "ok" : "failed", offset, tb_rope_slices(&rope), t);
+
+        // exit file
+        tb_file_exit(file);
+    }
+
+    // exit rope
+    tb_rope_exit(&rope);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */ 
+tb_int_t tb_demo_string_rope_main(tb_int_t argc, tb_char_t** argv)
+{
+    tb_demo_rope_test_edit();
+    tb_demo_rope_test_perf(100000);
+    tb_demo_rope_test_perf(1000000);
+    tb_demo_rope_test_writv(argv[1]? argv[1] : "/tmp/rope.txt");
+    return 0;
+}
@@ -3,6 +3,120 @@
  */ 
 #include "../demo.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */ 
+static tb_void_t tb_demo_string_test_cow()
+{
+    // init strings
+    tb_string_t s1;
+    tb_string_t s2;
+    tb_string_init(&s1);
+    tb_string_init(&s2);
+
+    // make a long string
+    tb_size_t i = 0;
+    for (i = 0; i < 16; i++) tb_string_cstrfcat(&s1, "line %lu; ", i);
+
+    // share it
+    tb_string_strcpy(&s2, &s1);
+    tb_bool_t shared = tb_string_cstr(&s1) == tb_string_cstr(&s2);
+
+    // modify it, the data will be copied
+    tb_string_cstrcat(&s2, "tail");
+    tb_bool_t copied = tb_string_cstr(&s1) != tb_string_cstr(&s2) && !tb_string_cstrncmp(&s2, tb_string_cstr(&s1), tb_string_size(&s1)) && tb_string_size(&s2) == tb_string_size(&s1) + 4;
+
+    // share it again and clear it
+    tb_string_strcpy(&s2, &s1);
+    tb_string_clear(&s2);
+    tb_bool_t cleared = !tb_string_size(&s2) && tb_string_size(&s1) > 64;
+
+    // share a long string with the leading and trailing spaces and trim it, the data will be moved
+    tb_string_cstrcpy(&s1, "          ");
+    for (i = 0; i < 10; i++) tb_string_cstrcat(&s1, "0123456789");
+    tb_string_cstrcat(&s1, "  ");
+    tb_string_strcpy(&s2, &s1);
+    tb_string_ltrim(&s2);
+    tb_string_rtrim(&s2);
+    tb_bool_t trimmed = tb_string_size(&s2) == 100 && !tb_string_cstrncmp(&s2, tb_string_cstr(&s1) + 10, 100) && tb_string_size(&s1) == 112;
+
+    // share it again and remove the data in [5, 20) with the trailing null
+    tb_string_strcpy(&s2, &s1);
+    tb_buffer_memmovp(&s2, 5, 20);
+    tb_bool_t moved = tb_string_size(&s2) == 97 && !tb_string_cstrncmp(&s2, tb_string_cstr(&s1), 5) && !tb_strcmp(tb_string_cstr(&s2) + 5, tb_string_cstr(&s1) + 20) && tb_string_size(&s1) == 112;
+
+    // trace
+    tb_trace_i("cow: shared: %s, copied: %s, cleared: %s, trimmed: %s, moved: %s"
+        , shared? "ok" : "failed"
+        , copied? "ok" : "failed"
+        , cleared? "ok" : "failed"
+        , trimmed? "ok" : "failed"
+        , moved? "ok" : "failed");
+
+    // exit strings
+    tb_string_exit(&s1);
+    tb_string_exit(&s2);
+}
+static tb_void_t tb_demo_string_test_view()
+{
+    // init string
+    tb_string_t s;
+    tb_string_init(&s);
+
+    // copy the sub-view
+    tb_string_view_t view = tb_string_view_literal("Content-Type: text/html");
+    tb_string_viewcpy(&s, tb_string_view_sub(view, 0, 12));
+    tb_string_viewcat(&s, tb_string_view_literal(": "));
+    tb_string_viewcat(&s, tb_string_view_sub(view, 14, TB_MAXU32));
+
+    // trace
+    tb_trace_i("view: %s, cmp: %ld, icmp: %ld, chr: %ld, str: %ld"
+        , tb_string_cstr(&s)
+        , tb_string_viewcmp(&s, view)
+        , tb_string_viewicmp(&s, tb_string_view_cstr("content-type: TEXT/HTML"))
+        , tb_string_view_chr(view, 0, ':')
+        , tb_string_view_str(tb_string_view(&s), 0, tb_string_view_literal("html")));
+
+    // exit string
+    tb_string_exit(&s);
+}
+static tb_void_t tb_demo_string_test_perf()
+{
+    // init strings
+    tb_string_t s;
+    tb_string_t copy;
+    tb_string_init(&s);
+    tb_string_init(&copy);
+    tb_string_chrncat(&s, 'x', 1024);
+
+    // copy the long string 
+    __tb_volatile__ tb_size_t   i = 0;
+    __tb_volatile__ tb_size_t   n = 1000000;
+    tb_hong_t                   t = tb_mclock();
+    for (i = 0; i < n; i++) 
+    {
+        tb_string_strcpy(&copy, &s);
+        tb_string_clear(&copy);
+    }
+    t = tb_mclock() - t;
+
+    // copy the long c-string
+    tb_hong_t c = tb_mclock();
+    for (i = 0; i < n; i++) 
+    {
+        tb_string_cstrncpy(&copy, tb_string_cstr(&s), tb_string_size(&s));
+        tb_string_clear(&copy);
+    }
+    c = tb_mclock() - c;
+
+    // trace
+    tb_trace_i("perf: strcpy: %lld ms, cstrncpy: %lld ms", t, c);
+
+    // exit strings
+    tb_string_exit(&s);
+    tb_string_exit(&copy);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */ 
@@ -20,5 +134,8 @@ tb_int_t tb_demo_string_string_main(tb_int_t argc, tb_char_t** argv)
 
     tb_string_exit(&s);
 
+    tb_demo_string_test_cow();
+    tb_demo_string_test_view();
+    tb_demo_string_test_perf();
     return 0;
 }
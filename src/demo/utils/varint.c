@@ -0,0 +1,186 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the values count
+#define TB_DEMO_VARINT_COUNT        (1000000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_bool_t tb_demo_varint_check(tb_char_t const* name, tb_uint32_t const* values, tb_uint32_t const* result, tb_size_t count, tb_size_t size, tb_hong_t t)
+{
+    // check
+    tb_size_t i = 0;
+    for (i = 0; i < count && values[i] == result[i]; i++) ;
+
+    // trace
+    tb_size_t r = (size * 100) / count;
+    tb_trace_i("%s: %s, size: %lu, %lu.%02lu bytes/value, decode: %lld ms, %lld M/s", name, i == count? "ok" : "failed", size, r / 100, r % 100, t, t? (tb_hong_t)(count / 1000) / t : 0);
+    return i == count;
+}
+static tb_void_t tb_demo_varint_test_codecs(tb_uint32_t const* values, tb_uint32_t* result, tb_byte_t* data, tb_size_t maxn, tb_size_t count)
+{
+    // leb128
+    tb_size_t size = tb_varint_encode_u32_n(data, maxn, values, count);
+    tb_hong_t t = tb_mclock();
+    tb_varint_decode_u32_n(data, size, result, count);
+    t = tb_mclock() - t;
+    tb_demo_varint_check("leb128", values, result, count, size, t);
+
+    // stream-vbyte
+    size = tb_varint_svb_encode_u32(data, maxn, values, count);
+    t = tb_mclock();
+    tb_varint_svb_decode_u32(data, size, result, count);
+    t = tb_mclock() - t;
+    tb_demo_varint_check("stream-vbyte", values, result, count, size, t);
+
+    // the sorted values
+    tb_size_t       i = 0;
+    tb_uint32_t*    sorted = tb_nalloc_type(count, tb_uint32_t);
+    if (sorted)
+    {
+        // make the sorted values
+        for (i = 0; i < count; i++) sorted[i] = (i? sorted[i - 1] : 1000) + (values[i] & 0xff);
+
+        // delta + stream-vbyte
+        tb_memcpy(result, sorted, count * sizeof(tb_uint32_t));
+        tb_bitpack_delta_encode_u32(result, count, 0);
+        size = tb_varint_svb_encode_u32(data, maxn, result, count);
+        t = tb_mclock();
+        tb_varint_svb_decode_u32(data, size, result, count);
+        tb_bitpack_delta_decode_u32(result, count, 0);
+        t = tb_mclock() - t;
+        tb_demo_varint_check("delta + stream-vbyte", sorted, result, count, size, t);
+
+        // delta + bitpack
+        tb_memcpy(result, sorted, count * sizeof(tb_uint32_t));
+        tb_bitpack_delta_encode_u32(result, count, sorted[0]);
+        tb_size_t nbits = tb_bitpack_nbits_u32(result, count);
+        size = tb_bitpack_encode_u32(data, maxn, result, count, nbits);
+        t = tb_mclock();
+        tb_bitpack_decode_u32(data, size, result, count, nbits);
+        tb_bitpack_delta_decode_u32(result, count, sorted[0]);
+        t = tb_mclock() - t;
+        tb_demo_varint_check("delta + bitpack", sorted, result, count, size, t);
+
+        // exit the sorted values
+        tb_free(sorted);
+    }
+
+    // frame-of-reference for the block of 128 values
+    tb_size_t   block = 128;
+    tb_byte_t*  p = data;
+    tb_byte_t*  e = data + maxn;
+    for (i = 0; i + block <= count; i += block) p += tb_bitpack_for_encode_u32(p, e - p, values + i, block);
+    size = p - data;
+    t = tb_mclock();
+    for (i = 0, p = data; i + block <= count; i += block) p += tb_bitpack_for_decode_u32(p, data + size - p, result + i, block);
+    t = tb_mclock() - t;
+    tb_demo_varint_check("frame-of-reference", values, result, i, size, t);
+}
+static tb_void_t tb_demo_varint_test_stream(tb_byte_t* data, tb_size_t maxn)
+{
+    // writ values
+    tb_static_stream_t stream;
+    tb_static_stream_init(&stream, data, maxn);
+    tb_static_stream_writ_varint_u32(&stream, 300);
+    tb_static_stream_writ_varint_s32(&stream, -1);
+    tb_static_stream_writ_varint_u64(&stream, 0xffffffffffffffffULL);
+    tb_static_stream_writ_varint_s64(&stream, -1234567890123LL);
+
+    // read values
+    tb_size_t size = tb_static_stream_offset(&stream);
+    tb_static_stream_init(&stream, data, size);
+    tb_uint32_t u32 = tb_static_stream_read_varint_u32(&stream);
+    tb_sint32_t s32 = tb_static_stream_read_varint_s32(&stream);
+    tb_uint64_t u64 = tb_static_stream_read_varint_u64(&stream);
+    tb_sint64_t s64 = tb_static_stream_read_varint_s64(&stream);
+    tb_trace_i("stream: size: %lu, %u %d %llx %lld, left: %lu", size, u32, s32, u64, s64, tb_static_stream_left(&stream));
+
+    // the overflow varint
+    tb_uint32_t val = 0;
+    tb_byte_t   bad[] = {0xff, 0xff, 0xff, 0xff, 0x1f};
+    tb_trace_i("stream: overflow: %lu", tb_varint_decode_u32(bad, sizeof(bad), &val));
+}
+static tb_void_t tb_demo_varint_test_filter()
+{
+    // the values
+    tb_size_t   i = 0;
+    tb_sint64_t values[256];
+    for (i = 0; i < tb_arrayn(values); i++) values[i] = (i & 1)? -(tb_sint64_t)(i * i) : (tb_sint64_t)i;
+
+    // encode them
+    tb_byte_t               edata[4096];
+    tb_size_t               esize = 0;
+    tb_byte_t const*        odata = tb_null;
+    tb_stream_filter_ref_t  filter = tb_stream_filter_init_from_varint(8, tb_true, tb_false);
+    if (filter)
+    {
+        tb_stream_filter_open(filter);
+        tb_long_t osize = tb_stream_filter_spak(filter, (tb_byte_t const*)values, sizeof(values), &odata, 0, -1);
+        if (osize > 0 && osize <= sizeof(edata)) 
+        {
+            tb_memcpy(edata, odata, osize);
+            esize = osize;
+        }
+        tb_stream_filter_exit(filter);
+    }
+
+    // decode them
+    tb_bool_t ok = tb_false;
+    filter = tb_stream_filter_init_from_varint(8, tb_true, tb_true);
+    if (filter)
+    {
+        tb_stream_filter_open(filter);
+        tb_long_t osize = tb_stream_filter_spak(filter, edata, esize, &odata, 0, -1);
+        ok = osize == sizeof(values) && !tb_memcmp(odata, values, sizeof(values));
+        tb_stream_filter_exit(filter);
+    }
+
+    // trace
+    tb_trace_i("filter: %lu => %lu bytes: %s", sizeof(values), esize, ok? "ok" : "failed");
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_utils_varint_main(tb_int_t argc, tb_char_t** argv)
+{
+    // init data
+    tb_size_t       count = TB_DEMO_VARINT_COUNT;
+    tb_size_t       maxn = TB_VARINT_SVB_MAXN(count) + count * 2;
+    tb_uint32_t*    values = tb_nalloc_type(count, tb_uint32_t);
+    tb_uint32_t*    result = tb_nalloc_type(count, tb_uint32_t);
+    tb_byte_t*      data = tb_malloc_bytes(maxn);
+    if (values && result && data)
+    {
+        // make the small values, most of them are < 128
+        tb_size_t i = 0;
+        for (i = 0; i < count; i++) 
+        {
+            tb_uint32_t r = tb_random_u32(tb_null);
+            values[i] = (r & 7)? (r >> 8) & 0x7f : (r & 8)? (r >> 8) & 0xffff : r;
+        }
+
+        // test codecs
+        tb_demo_varint_test_codecs(values, result, data, maxn, count);
+
+        // test stream
+        tb_demo_varint_test_stream(data, maxn);
+
+        // test filter
+        tb_demo_varint_test_filter();
+    }
+
+    // exit data
+    if (values) tb_free(values);
+    if (result) tb_free(result);
+    if (data) tb_free(data);
+    return 0;
+}
@@ -41,12 +41,14 @@ target("demo")
     add_files("algorithm/*.c") 
     add_files("stream/stream.c") 
     add_files("stream/stream/*.c") 
+    add_files("stream/static_bits.c") 
 
     -- add the source files for the float type
     if is_option("float") then
         add_files("math/fixed.c")
         add_files("libm/float.c")
         add_files("libm/double.c")
+        add_files("libm/vector.c")
     end
 
     -- add the source files for the thread type
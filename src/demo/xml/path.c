@@ -0,0 +1,96 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */ 
+static tb_bool_t tb_demo_xml_path_func(tb_xml_reader_ref_t reader, tb_char_t const* path, tb_size_t event, tb_cpointer_t priv)
+{
+    // check
+    tb_size_t* count = (tb_size_t*)priv;
+    tb_assert_and_check_return_val(count, tb_false);
+
+    // trace
+    switch (event)
+    {
+    case TB_XML_READER_EVENT_ELEMENT_BEG: 
+    case TB_XML_READER_EVENT_ELEMENT_EMPTY: 
+        {
+            tb_xml_node_ref_t attr = tb_xml_reader_attributes(reader);
+            for (; attr; attr = attr->next)
+                tb_trace_i("%s: %s = %s", path, tb_string_cstr(&attr->name), tb_string_cstr(&attr->data));
+            (*count)++;
+        }
+        break;
+    case TB_XML_READER_EVENT_TEXT: 
+        tb_trace_i("%s: %s", path, tb_xml_reader_text(reader));
+        break;
+    case TB_XML_READER_EVENT_CDATA: 
+        tb_trace_i("%s: <![CDATA[%s]]>", path, tb_xml_reader_cdata(reader));
+        break;
+    default:
+        break;
+    }
+
+    // continue it
+    return tb_true;
+}
+static tb_hong_t tb_demo_xml_path_goto(tb_xml_reader_ref_t reader, tb_char_t** paths, tb_size_t count, tb_bool_t index)
+{
+    // enable index?
+    tb_xml_reader_index(reader, index);
+
+    // goto all paths
+    tb_size_t i = 0;
+    tb_size_t n = 0;
+    tb_hong_t t = tb_mclock();
+    for (i = 0; i < count; i++) 
+    {
+        if (tb_xml_reader_goto(reader, paths[i]) && tb_xml_reader_next(reader)) n++;
+    }
+    t = tb_mclock() - t;
+
+    // trace
+    tb_trace_i("goto: index: %s, found: %lu/%lu, %lld ms", index? "on" : "off", n, count, t);
+    return t;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */ 
+tb_int_t tb_demo_xml_path_main(tb_int_t argc, tb_char_t** argv)
+{
+    // check
+    tb_check_return_val(argc > 2, 0);
+
+    // init reader
+    tb_xml_reader_ref_t reader = tb_xml_reader_init();
+    if (reader)
+    {
+        // open reader
+        if (tb_xml_reader_open(reader, tb_stream_init_from_url(argv[1]), tb_true))
+        {
+            // add paths
+            tb_size_t i = 0;
+            tb_size_t count = 0;
+            for (i = 2; i < argc; i++) tb_xml_reader_path_add(reader, argv[i], tb_demo_xml_path_func, &count);
+
+            // extract all paths in one pass
+            tb_hong_t t = tb_mclock();
+            tb_xml_reader_path_done(reader);
+            t = tb_mclock() - t;
+            tb_trace_i("done: %lu nodes, %lld ms", count, t);
+
+            // goto all paths without and with the index
+            tb_demo_xml_path_goto(reader, argv + 2, argc - 2, tb_false);
+            tb_demo_xml_path_goto(reader, argv + 2, argc - 2, tb_true);
+            tb_demo_xml_path_goto(reader, argv + 2, argc - 2, tb_true);
+        }
+
+        // exit reader
+        tb_xml_reader_exit(reader);
+    }
+    return 0;
+}
@@ -72,7 +72,8 @@ tb_int_t tb_demo_xml_reader_main(tb_int_t argc, tb_char_t** argv)
                     {
                         tb_size_t t = tb_xml_reader_level(reader);
                         while (t--) tb_printf("\t");
-                        tb_printf("</%s>\n", tb_xml_reader_element(reader));
+                        tb_string_view_t name = tb_xml_reader_element_view(reader);
+                        tb_printf("</%.*s>\n", (tb_int_t)name.size, name.data);
                     }
                     break;
                 case TB_XML_READER_EVENT_TEXT: 
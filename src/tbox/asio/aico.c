@@ -58,6 +58,10 @@ tb_aico_ref_t tb_aico_init(tb_aicp_ref_t aicp)
         aico->type      = TB_AICO_TYPE_NONE;
         aico->handle    = tb_null;
         aico->state     = TB_STATE_CLOSED;
+        aico->pending   = 0;
+
+        // init lock
+        tb_spinlock_init(&aico->lock);
 
         // init timeout 
         tb_size_t i = 0;
@@ -281,6 +285,9 @@ tb_void_t tb_aico_exit(tb_aico_ref_t aico)
     // trace
     tb_trace_d("exit[%p]: type: %lu, handle: %p, state: %s: ok", aico, tb_aico_type(aico), impl->handle, tb_state_cstr(tb_atomic_get(&impl->state)));
     
+    // exit lock
+    tb_spinlock_exit(&impl->lock);
+
     // free it
     tb_fixed_pool_free(aicp_impl->pool, aico);
 
@@ -451,7 +458,10 @@ tb_bool_t tb_aico_recv_(tb_aico_ref_t aico, tb_byte_t* data, tb_size_t size, tb_
 {
     // check
     tb_aico_impl_t* impl = (tb_aico_impl_t*)aico;
-    tb_assert_and_check_return_val(impl && impl->aicp && data && size, tb_false);
+    tb_assert_and_check_return_val(impl && impl->aicp && (data? size : !size), tb_false);
+
+    // using the recv buffer pool if no data
+    tb_assert_and_check_return_val(data || ((tb_aicp_impl_t*)impl->aicp)->rpool, tb_false);
 
     // init
     tb_aice_t               aice = {0};
@@ -784,7 +794,10 @@ tb_bool_t tb_aico_recv_after_(tb_aico_ref_t aico, tb_size_t delay, tb_byte_t* da
 {
     // check
     tb_aico_impl_t* impl = (tb_aico_impl_t*)aico;
-    tb_assert_and_check_return_val(impl && impl->aicp && data && size, tb_false);
+    tb_assert_and_check_return_val(impl && impl->aicp && (data? size : !size), tb_false);
+
+    // using the recv buffer pool if no data
+    tb_assert_and_check_return_val(data || ((tb_aicp_impl_t*)impl->aicp)->rpool, tb_false);
 
     // init
     tb_aice_t               aice = {0};
@@ -265,10 +265,13 @@ tb_bool_t           tb_aico_acpt_(tb_aico_ref_t aico, tb_aico_func_t func, tb_cp
 tb_bool_t           tb_aico_conn_(tb_aico_ref_t aico, tb_ipaddr_ref_t addr, tb_aico_func_t func, tb_cpointer_t priv __tb_debug_decl__);
 
 /*! post the recv for sock
+ *
+ * the recv aice can be pending with the send aice at the same time,
+ * and their callbacks may be called concurrently from the different loop threads
  *
  * @param aico      the aico
- * @param data      the data
- * @param size      the size
+ * @param data      the data, using the recv buffer pool of the aicp if be null, see tb_aicp_rpool_init()
+ * @param size      the size, must be zero if the data is null
  * @param func      the callback func
  * @param priv      the callback data
  *
@@ -277,6 +280,9 @@ tb_bool_t           tb_aico_conn_(tb_aico_ref_t aico, tb_ipaddr_ref_t addr, tb_a
 tb_bool_t           tb_aico_recv_(tb_aico_ref_t aico, tb_byte_t* data, tb_size_t size, tb_aico_func_t func, tb_cpointer_t priv __tb_debug_decl__);
 
 /*! post the send for sock
+ *
+ * the send aice will be queued if the previous send aice is pending, 
+ * and the queued data will be sent using one sendv, the callback will be called after all data have been sent
  *
  * @param aico      the aico
  * @param data      the data
@@ -476,8 +482,8 @@ tb_bool_t           tb_aico_conn_after_(tb_aico_ref_t aico, tb_size_t delay, tb_
  *
  * @param aico      the aico
  * @param delay     the delay time, ms
- * @param data      the data
- * @param size      the size
+ * @param data      the data, using the recv buffer pool of the aicp if be null, see tb_aicp_rpool_init()
+ * @param size      the size, must be zero if the data is null
  * @param func      the callback func
  * @param priv      the callback data
  *
@@ -39,6 +39,17 @@
 #include "../memory/memory.h"
 #include "../platform/platform.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default recv buffer size of the recv buffer pool
+#ifdef __tb_small__
+#   define TB_AICP_RPOOL_SIZE               (4096)
+#else
+#   define TB_AICP_RPOOL_SIZE               (8192)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -271,6 +282,9 @@ tb_aicp_ref_t tb_aicp_init(tb_size_t maxn)
         // init lock
         if (!tb_spinlock_init(&impl->lock)) break;
 
+        // init the recv buffer pool lock
+        if (!tb_spinlock_init(&impl->rlock)) break;
+
         // init proactor
         impl->ptor = tb_aicp_ptor_impl_init(impl);
         tb_assert_and_check_break(impl->ptor && impl->ptor->step >= sizeof(tb_aico_impl_t));
@@ -340,7 +354,14 @@ tb_bool_t tb_aicp_exit(tb_aicp_ref_t aicp)
     impl->pool = tb_null;
     tb_spinlock_leave(&impl->lock);
 
+    // exit the recv buffer pool
+    tb_spinlock_enter(&impl->rlock);
+    if (impl->rpool) tb_fixed_pool_exit(impl->rpool);
+    impl->rpool = tb_null;
+    tb_spinlock_leave(&impl->rlock);
+
     // exit lock
+    tb_spinlock_exit(&impl->rlock);
     tb_spinlock_exit(&impl->lock);
 
     // free impl
@@ -358,6 +379,51 @@ tb_size_t tb_aicp_maxn(tb_aicp_ref_t aicp)
     // the maxn
     return impl->maxn;
 }
+tb_bool_t tb_aicp_rpool_init(tb_aicp_ref_t aicp, tb_size_t size)
+{
+    // check
+    tb_aicp_impl_t* impl = (tb_aicp_impl_t*)aicp;
+    tb_assert_and_check_return_val(impl && impl->ptor, tb_false);
+
+    // not supported?
+    if (!impl->ptor->rpool)
+    {
+        // trace
+        tb_trace_e("the recv buffer pool is not supported for this proactor!");
+        return tb_false;
+    }
+
+    // enter
+    tb_spinlock_enter(&impl->rlock);
+
+    // init the recv buffer pool
+    tb_bool_t ok = tb_false;
+    if (!impl->rpool)
+    {
+        impl->rsize = size? size : TB_AICP_RPOOL_SIZE;
+        impl->rpool = tb_fixed_pool_init(tb_null, 0, impl->rsize, tb_null, tb_null, tb_null);
+        ok = impl->rpool? tb_true : tb_false;
+    }
+    // using the same buffer size?
+    else ok = (!size || size == impl->rsize)? tb_true : tb_false;
+
+    // leave
+    tb_spinlock_leave(&impl->rlock);
+
+    // ok?
+    return ok;
+}
+tb_void_t tb_aicp_rpool_free(tb_aicp_ref_t aicp, tb_byte_t* data)
+{
+    // check
+    tb_aicp_impl_t* impl = (tb_aicp_impl_t*)aicp;
+    tb_assert_and_check_return(impl && data);
+
+    // free it
+    tb_spinlock_enter(&impl->rlock);
+    if (impl->rpool) tb_fixed_pool_free(impl->rpool, data);
+    tb_spinlock_leave(&impl->rlock);
+}
 tb_bool_t tb_aicp_post_(tb_aicp_ref_t aicp, tb_aice_ref_t aice __tb_debug_decl__)
 {
     // check
@@ -369,9 +435,25 @@ tb_bool_t tb_aicp_post_(tb_aicp_ref_t aicp, tb_aice_ref_t aice __tb_debug_decl__
     tb_aico_impl_t* aico = (tb_aico_impl_t*)aice->aico;
     tb_assert_and_check_return_val(aico, tb_false);
 
-    // opened or killed or closed? pending it
+    // enter
+    tb_spinlock_enter(&aico->lock);
+
+    /* opened or killed? pending it
+     *
+     * the recv and send aice of the duplex sock may be pending at the same time
+     * and the proactor will check the conflict of them
+     */
     tb_size_t state = tb_atomic_fetch_and_pset(&aico->state, TB_STATE_OPENED, TB_STATE_PENDING);
-    if (state == TB_STATE_OPENED || state == TB_STATE_KILLED)
+    tb_bool_t ok = (state == TB_STATE_OPENED || state == TB_STATE_KILLED || state == TB_STATE_PENDING)
+                && (    !aico->pending 
+                    ||  (impl->ptor->duplex && aico->type == TB_AICO_TYPE_SOCK && tb_aice_impl_is_duplex(aice->code)));
+    if (ok) aico->pending++;
+
+    // leave
+    tb_spinlock_leave(&aico->lock);
+
+    // ok?
+    if (ok)
     {
         // save debug info
 #ifdef __tb_debug__
@@ -381,7 +463,13 @@ tb_bool_t tb_aicp_post_(tb_aicp_ref_t aicp, tb_aice_ref_t aice __tb_debug_decl__
 #endif
 
         // post aice
-        return impl->ptor->post(impl->ptor, aice);
+        if (impl->ptor->post(impl->ptor, aice)) return tb_true;
+
+        // post failed, restore the pending state
+        tb_spinlock_enter(&aico->lock);
+        if (aico->pending && !--aico->pending) tb_atomic_pset(&aico->state, TB_STATE_PENDING, TB_STATE_OPENED);
+        tb_spinlock_leave(&aico->lock);
+        return tb_false;
     }
 
     // trace
@@ -476,9 +564,25 @@ tb_void_t tb_aicp_loop_util(tb_aicp_ref_t aicp, tb_bool_t (*stop)(tb_cpointer_t
         // trace
         tb_trace_d("loop[%p]: spak: code: %lu, aico: %p, state: %s: %ld", loop, resp.code, aico, aico? tb_state_cstr(tb_atomic_get(&aico->state)) : "null", ok);
 
-        // pending? clear state if be not accept or accept failed
+        // pending? clear state if be not accept or accept failed and it is the last pending aice
         tb_size_t state = TB_STATE_OPENED;
-        state = (resp.code != TB_AICE_CODE_ACPT || resp.state != TB_STATE_OK)? tb_atomic_fetch_and_pset(&aico->state, TB_STATE_PENDING, state) : tb_atomic_get(&aico->state);
+        tb_bool_t last = tb_true;
+        if (resp.code != TB_AICE_CODE_ACPT || resp.state != TB_STATE_OK)
+        {
+            // enter
+            tb_spinlock_enter(&aico->lock);
+
+            // the last pending aice?
+            if (aico->pending) aico->pending--;
+            last = !aico->pending;
+
+            // clear state
+            state = last? tb_atomic_fetch_and_pset(&aico->state, TB_STATE_PENDING, state) : tb_atomic_get(&aico->state);
+
+            // leave
+            tb_spinlock_leave(&aico->lock);
+        }
+        else state = tb_atomic_get(&aico->state);
 
         // killed or killing?
         if (state == TB_STATE_KILLED || state == TB_STATE_KILLING)
@@ -486,24 +590,32 @@ tb_void_t tb_aicp_loop_util(tb_aicp_ref_t aicp, tb_bool_t (*stop)(tb_cpointer_t
             // update the aice state 
             resp.state = TB_STATE_KILLED;
 
-            // killing? update to the killed state
-            tb_atomic_fetch_and_pset(&aico->state, TB_STATE_KILLING, TB_STATE_KILLED);
+            // killing? update to the killed state if no more pending aice
+            if (last) tb_atomic_fetch_and_pset(&aico->state, TB_STATE_KILLING, TB_STATE_KILLED);
         }
 
-        // done func, @note maybe the aico exit will be called
+#ifdef __tb_debug__
+        // save the debug info, the aico may be exited in the func
+        tb_size_t           line = aico->line;
+        tb_char_t const*    func = aico->func;
+        tb_char_t const*    file = aico->file;
+#endif
+
+        /* done func, @note maybe the aico exit will be called
+         *
+         * the aico cannot be accessed after calling the func, 
+         * the aice posted in the func will update the killed state when it is finished
+         */
         if (resp.func && !resp.func(&resp)) 
         {
             // trace
 #ifdef __tb_debug__
-            tb_trace_e("loop[%p]: done aice func failed with code: %lu at line: %lu, func: %s, file: %s!", loop, resp.code, aico->line, aico->func, aico->file);
+            tb_trace_e("loop[%p]: done aice func failed with code: %lu at line: %lu, func: %s, file: %s!", loop, resp.code, line, func, file);
 #else
             tb_trace_e("loop[%p]: done aice func failed with code: %lu!", loop, resp.code);
 #endif
         }
 
-        // killing? update to the killed state
-        tb_atomic_fetch_and_pset(&aico->state, TB_STATE_KILLING, TB_STATE_KILLED);
-
         // stop it?
         if (stop && stop(priv)) tb_aicp_kill(aicp);
     }
@@ -79,6 +79,28 @@ tb_bool_t           tb_aicp_exit(tb_aicp_ref_t aicp);
  */     
 tb_size_t           tb_aicp_maxn(tb_aicp_ref_t aicp);
 
+/*! init the shared recv buffer pool
+ *
+ * the recv aice can be posted without the buffer after calling it, e.g. tb_aico_recv(aico, tb_null, 0, func, priv),
+ * the buffer will be allocated from this pool only when the data is arrived, 
+ * so the idle connections need not hold the recv buffers.
+ *
+ * the callback need free the recv buffer using tb_aicp_rpool_free() if aice->u.recv.data is not null
+ *
+ * @param aicp      the aicp
+ * @param size      the buffer size, using the default size if be zero
+ *
+ * @return          tb_true or tb_false, not supported if the proactor cannot recv data after the event is arrived
+ */
+tb_bool_t           tb_aicp_rpool_init(tb_aicp_ref_t aicp, tb_size_t size);
+
+/*! free the recv buffer of the shared recv buffer pool
+ *
+ * @param aicp      the aicp
+ * @param data      the recv buffer
+ */
+tb_void_t           tb_aicp_rpool_free(tb_aicp_ref_t aicp, tb_byte_t* data);
+
 /*! post the aice 
  *
  * @param aicp      the aicp
@@ -34,6 +34,7 @@
 #include "aico.h"
 #include "aice.h"
 #include "aicp.h"
+#include "co.h"
 #include "http.h"
 #include "dns.h"
 #include "ssl.h"
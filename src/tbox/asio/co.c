@@ -0,0 +1,772 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        co.c
+ * @ingroup     asio
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "co"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "co.h"
+#include "../utils/utils.h"
+#include "../stream/async_stream.h"
+#include "../platform/platform.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the coroutine has been supported?
+#if defined(TB_CONTEXT_HAVE_ARCH) && defined(__tb_thread_local__)
+#   define TB_CO_HAVE_CONTEXT
+#endif
+
+// the default stack size
+#ifdef __tb_small__
+#   define TB_CO_STACK_SIZE                 (32 * 1024)
+#else
+#   define TB_CO_STACK_SIZE                 (64 * 1024)
+#endif
+
+// the cached coroutine maxn of the pool
+#ifdef __tb_small__
+#   define TB_CO_POOL_MAXN                  (16)
+#else
+#   define TB_CO_POOL_MAXN                  (256)
+#endif
+
+#ifdef TB_CO_HAVE_CONTEXT
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the coroutine impl type
+struct __tb_co_impl_t;
+
+// the coroutine wait func type, post the waited aice after the coroutine has been suspended
+typedef tb_bool_t (*tb_co_wait_func_t)(struct __tb_co_impl_t* co);
+
+/* the coroutine impl type
+ *
+ * the coroutine is placed at the top of its stack:
+ *
+ * |  guard  |            stack           | coroutine |
+ * |---------|----------------------------|-----------|
+ *           ^                            ^
+ *      stack data                     context
+ */
+typedef struct __tb_co_impl_t
+{
+    // the next coroutine in the pool
+    struct __tb_co_impl_t*  next;
+
+    // the context of the suspended coroutine
+    tb_context_ref_t        context;
+
+    // the context of the resumer
+    tb_context_ref_t        caller;
+
+    // the func
+    tb_co_func_t            func;
+
+    // the priv
+    tb_cpointer_t           priv;
+
+    // the aicp
+    tb_aicp_ref_t           aicp;
+
+    // the task aico for sleeping
+    tb_aico_ref_t           task;
+
+    // the wait func
+    tb_co_wait_func_t       wait;
+
+    // the waited aice
+    tb_aice_t               aice;
+
+    // the waited stream
+    tb_async_stream_ref_t   stream;
+
+    // the stack data
+    tb_byte_t*              stackdata;
+
+    // the stack size
+    tb_size_t               stacksize;
+
+    // cached in the pool?
+    tb_uint8_t              pooled  : 1;
+
+    // dead?
+    tb_uint8_t              dead    : 1;
+
+    // is closing the waited stream after syncing it?
+    tb_uint8_t              bclosing: 1;
+
+}tb_co_impl_t;
+
+// the coroutine pool type
+typedef struct __tb_co_pool_t
+{
+    // the lock
+    tb_spinlock_t           lock;
+
+    // the free coroutines
+    tb_co_impl_t*           free;
+
+    // the free count
+    tb_size_t               size;
+
+}tb_co_pool_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the current coroutine of this thread
+static __tb_thread_local__ tb_co_impl_t*    g_co_self = tb_null;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * pool implementation
+ */
+static tb_handle_t tb_co_pool_instance_init(tb_cpointer_t* ppriv)
+{
+    // make pool
+    tb_co_pool_t* pool = tb_malloc0_type(tb_co_pool_t);
+    tb_assert_and_check_return_val(pool, tb_null);
+
+    // init lock
+    tb_spinlock_init(&pool->lock);
+
+    // ok
+    return (tb_handle_t)pool;
+}
+static tb_void_t tb_co_pool_instance_exit(tb_handle_t handle, tb_cpointer_t priv)
+{
+    // check
+    tb_co_pool_t* pool = (tb_co_pool_t*)handle;
+    tb_assert_and_check_return(pool);
+
+    // exit the free coroutines
+    tb_spinlock_enter(&pool->lock);
+    while (pool->free)
+    {
+        tb_co_impl_t* co = pool->free;
+        pool->free = co->next;
+        tb_context_stack_exit(co->stackdata, co->stacksize);
+    }
+    pool->size = 0;
+    tb_spinlock_leave(&pool->lock);
+
+    // exit lock
+    tb_spinlock_exit(&pool->lock);
+
+    // exit pool
+    tb_free(pool);
+}
+static tb_co_pool_t* tb_co_pool(tb_noarg_t)
+{
+    return (tb_co_pool_t*)tb_singleton_instance(TB_SINGLETON_TYPE_CO_POOL, tb_co_pool_instance_init, tb_co_pool_instance_exit, tb_null, tb_null);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t tb_co_entry(tb_context_from_t from);
+static tb_co_impl_t* tb_co_init(tb_aicp_ref_t aicp, tb_co_func_t func, tb_cpointer_t priv, tb_size_t stacksize)
+{
+    // get a cached coroutine with the default stack size
+    tb_co_impl_t* co = tb_null;
+    tb_co_pool_t* pool = !stacksize? tb_co_pool() : tb_null;
+    if (pool)
+    {
+        tb_spinlock_enter(&pool->lock);
+        if (pool->free)
+        {
+            co = pool->free;
+            pool->free = co->next;
+            pool->size--;
+        }
+        tb_spinlock_leave(&pool->lock);
+    }
+
+    // make a new coroutine
+    if (!co)
+    {
+        // init stack
+        tb_size_t   size = stacksize? stacksize : TB_CO_STACK_SIZE;
+        tb_byte_t*  data = tb_context_stack_init(&size);
+        tb_assert_and_check_return_val(data && size > sizeof(tb_co_impl_t) + 1024, tb_null);
+
+        // place the coroutine at the top of the stack
+        co = (tb_co_impl_t*)(data + size - tb_align(sizeof(tb_co_impl_t), 16));
+        co->stackdata   = data;
+        co->stacksize   = size;
+        co->pooled      = !stacksize;
+    }
+
+    // init it
+    co->next    = tb_null;
+    co->caller  = tb_null;
+    co->func    = func;
+    co->priv    = priv;
+    co->aicp    = aicp;
+    co->task    = tb_null;
+    co->wait    = tb_null;
+    co->stream  = tb_null;
+    co->dead    = 0;
+    tb_memset(&co->aice, 0, sizeof(tb_aice_t));
+
+    // make context below the coroutine
+    co->context = tb_context_make(co->stackdata, (tb_byte_t*)co - co->stackdata, tb_co_entry);
+
+    // ok
+    return co;
+}
+static tb_void_t tb_co_exit(tb_co_impl_t* co)
+{
+    // check
+    tb_assert_and_check_return(co);
+
+    // cache it to the pool
+    if (co->pooled)
+    {
+        tb_co_pool_t* pool = tb_co_pool();
+        if (pool)
+        {
+            tb_bool_t cached = tb_false;
+            tb_spinlock_enter(&pool->lock);
+            if (pool->size < TB_CO_POOL_MAXN)
+            {
+                co->next = pool->free;
+                pool->free = co;
+                pool->size++;
+                cached = tb_true;
+            }
+            tb_spinlock_leave(&pool->lock);
+            tb_check_return(!cached);
+        }
+    }
+
+    // exit stack
+    tb_context_stack_exit(co->stackdata, co->stacksize);
+}
+static tb_void_t tb_co_resume(tb_co_impl_t* co)
+{
+    // the previous coroutine, maybe we are resuming it in the other coroutine
+    tb_co_impl_t* self = g_co_self;
+    while (1)
+    {
+        // jump to the coroutine
+        g_co_self = co;
+        tb_context_from_t from = tb_context_jump(co->context, co);
+        g_co_self = self;
+
+        // the coroutine has been suspended or dead
+        co = (tb_co_impl_t*)from.priv;
+        tb_assert_and_check_break(co);
+        co->context = from.context;
+
+        // dead? exit it
+        if (co->dead) 
+        {
+            tb_co_exit(co);
+            break;
+        }
+
+        // the wait func
+        tb_co_wait_func_t wait = co->wait;
+        co->wait = tb_null;
+        tb_assert_and_check_break(wait);
+
+        /* post the waited aice
+         *
+         * @note the coroutine may be resumed and exited in the other loop thread after posting it
+         */
+        if (wait(co)) break;
+
+        // post failed, resume it with the failed state
+        co->aice.state = TB_STATE_FAILED;
+    }
+}
+static tb_void_t tb_co_suspend(tb_co_impl_t* co, tb_co_wait_func_t wait)
+{
+    // jump to the resumer and it will call wait(co) 
+    co->wait = wait;
+    tb_context_from_t from = tb_context_jump(co->caller, co);
+
+    // resumed, update the resumer
+    co->caller = from.context;
+}
+static tb_void_t tb_co_entry(tb_context_from_t from)
+{
+    // the coroutine
+    tb_co_impl_t* co = (tb_co_impl_t*)from.priv;
+    tb_assert(co && co->func);
+
+    // save the resumer
+    co->caller = from.context;
+
+    // done func
+    co->func(co->priv);
+
+    /* exit the task aico
+     *
+     * we are resumed in its clos func here and the aicp loop will not access it after the func
+     */
+    if (co->task)
+    {
+        if (tb_co_clos(co->task)) tb_aico_exit(co->task);
+        co->task = tb_null;
+    }
+
+    // dead, the resumer will exit it
+    co->dead = 1;
+    tb_context_jump(co->caller, co);
+
+    // cannot be here
+    tb_assert(0);
+}
+static tb_co_impl_t* tb_co_self_impl(tb_noarg_t)
+{
+    return g_co_self;
+}
+static tb_bool_t tb_co_aice_func(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice, tb_false);
+
+    // the coroutine
+    tb_co_impl_t* co = (tb_co_impl_t*)aice->priv;
+    tb_assert_and_check_return_val(co, tb_false);
+
+    // save the done aice
+    co->aice = *aice;
+
+    // resume it
+    tb_co_resume(co);
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_co_wait_aice(tb_co_impl_t* co)
+{
+    // check
+    tb_aice_ref_t aice = &co->aice;
+    tb_assert_and_check_return_val(aice->aico, tb_false);
+
+    // post it
+    switch (aice->code)
+    {
+    case TB_AICE_CODE_CONN:
+        return tb_aico_conn(aice->aico, &aice->u.conn.addr, tb_co_aice_func, co);
+    case TB_AICE_CODE_RECV:
+        return tb_aico_recv(aice->aico, aice->u.recv.data, aice->u.recv.size, tb_co_aice_func, co);
+    case TB_AICE_CODE_SEND:
+        return tb_aico_send(aice->aico, aice->u.send.data, aice->u.send.size, tb_co_aice_func, co);
+    case TB_AICE_CODE_RUNTASK:
+        return tb_aico_task_run(aice->aico, aice->u.runtask.delay, tb_co_aice_func, co);
+    case TB_AICE_CODE_CLOS:
+        return tb_aico_clos(aice->aico, tb_co_aice_func, co);
+    default:
+        tb_trace_e("unknown aice code: %lu", (tb_size_t)aice->code);
+        break;
+    }
+
+    // failed
+    return tb_false;
+}
+static tb_bool_t tb_co_stream_open_func(tb_async_stream_ref_t stream, tb_size_t state, tb_cpointer_t priv)
+{
+    // the coroutine
+    tb_co_impl_t* co = (tb_co_impl_t*)priv;
+    tb_assert_and_check_return_val(co, tb_false);
+
+    // resume it
+    co->aice.state = state;
+    tb_co_resume(co);
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_co_stream_read_func(tb_async_stream_ref_t stream, tb_size_t state, tb_byte_t const* data, tb_size_t real, tb_size_t size, tb_cpointer_t priv)
+{
+    // the coroutine
+    tb_co_impl_t* co = (tb_co_impl_t*)priv;
+    tb_assert_and_check_return_val(co, tb_false);
+
+    // no data? continue to read it
+    if (state == TB_STATE_OK && !real) return tb_true;
+
+    // save data
+    if (state == TB_STATE_OK)
+    {
+        real = tb_min(real, co->aice.u.recv.size);
+        if (data) tb_memcpy(co->aice.u.recv.data, data, real);
+        co->aice.u.recv.real = real;
+    }
+
+    // resume it
+    co->aice.state = state;
+    tb_co_resume(co);
+
+    // break it and the coroutine will read the next data
+    return tb_false;
+}
+static tb_bool_t tb_co_stream_writ_func(tb_async_stream_ref_t stream, tb_size_t state, tb_byte_t const* data, tb_size_t real, tb_size_t size, tb_cpointer_t priv)
+{
+    // the coroutine
+    tb_co_impl_t* co = (tb_co_impl_t*)priv;
+    tb_assert_and_check_return_val(co, tb_false);
+
+    // continue to writ the left data
+    if (state == TB_STATE_OK && real < size) return tb_true;
+
+    // resume it
+    co->aice.state = state;
+    tb_co_resume(co);
+
+    // break it
+    return tb_false;
+}
+static tb_bool_t tb_co_stream_sync_func(tb_async_stream_ref_t stream, tb_size_t state, tb_bool_t bclosing, tb_cpointer_t priv)
+{
+    // the coroutine
+    tb_co_impl_t* co = (tb_co_impl_t*)priv;
+    tb_assert_and_check_return_val(co, tb_false);
+
+    // resume it
+    co->aice.state = state;
+    tb_co_resume(co);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_co_stream_clos_func(tb_async_stream_ref_t stream, tb_size_t state, tb_cpointer_t priv)
+{
+    // the coroutine
+    tb_co_impl_t* co = (tb_co_impl_t*)priv;
+    tb_assert_and_check_return(co);
+
+    // resume it
+    co->aice.state = state;
+    tb_co_resume(co);
+}
+static tb_bool_t tb_co_wait_stream_open(tb_co_impl_t* co)
+{
+    return tb_async_stream_open(co->stream, tb_co_stream_open_func, co);
+}
+static tb_bool_t tb_co_wait_stream_read(tb_co_impl_t* co)
+{
+    return tb_async_stream_read(co->stream, co->aice.u.recv.size, tb_co_stream_read_func, co);
+}
+static tb_bool_t tb_co_wait_stream_writ(tb_co_impl_t* co)
+{
+    return tb_async_stream_writ(co->stream, co->aice.u.send.data, co->aice.u.send.size, tb_co_stream_writ_func, co);
+}
+static tb_bool_t tb_co_wait_stream_sync(tb_co_impl_t* co)
+{
+    return tb_async_stream_sync(co->stream, co->bclosing, tb_co_stream_sync_func, co);
+}
+static tb_bool_t tb_co_wait_stream_clos(tb_co_impl_t* co)
+{
+    return tb_async_stream_clos(co->stream, tb_co_stream_clos_func, co);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t tb_co_start(tb_aicp_ref_t aicp, tb_co_func_t func, tb_cpointer_t priv, tb_size_t stacksize)
+{
+    // check
+    tb_assert_and_check_return_val(aicp && func, tb_false);
+
+    // init coroutine
+    tb_co_impl_t* co = tb_co_init(aicp, func, priv, stacksize);
+    tb_check_return_val(co, tb_false);
+
+    // run it until it waits for the first aice
+    tb_co_resume(co);
+
+    // ok
+    return tb_true;
+}
+tb_co_ref_t tb_co_self()
+{
+    return (tb_co_ref_t)tb_co_self_impl();
+}
+tb_size_t tb_co_state()
+{
+    // the coroutine
+    tb_co_impl_t* co = tb_co_self_impl();
+    tb_assert_and_check_return_val(co, TB_STATE_FAILED);
+
+    // the state
+    return co->aice.state;
+}
+tb_bool_t tb_co_conn(tb_aico_ref_t aico, tb_ipaddr_ref_t addr)
+{
+    // check
+    tb_co_impl_t* co = tb_co_self_impl();
+    tb_assert_and_check_return_val(co && aico && addr, tb_false);
+
+    // wait conn
+    co->aice.code = TB_AICE_CODE_CONN;
+    co->aice.aico = aico;
+    tb_ipaddr_copy(&co->aice.u.conn.addr, addr);
+    tb_co_suspend(co, tb_co_wait_aice);
+
+    // ok?
+    return co->aice.state == TB_STATE_OK;
+}
+tb_long_t tb_co_recv(tb_aico_ref_t aico, tb_byte_t* data, tb_size_t size)
+{
+    // check
+    tb_co_impl_t* co = tb_co_self_impl();
+    tb_assert_and_check_return_val(co && aico && data && size, -1);
+
+    // wait recv
+    co->aice.code           = TB_AICE_CODE_RECV;
+    co->aice.aico           = aico;
+    co->aice.u.recv.data    = data;
+    co->aice.u.recv.size    = (tb_iovec_size_t)size;
+    co->aice.u.recv.real    = 0;
+    tb_co_suspend(co, tb_co_wait_aice);
+
+    // ok?
+    return co->aice.state == TB_STATE_OK? (tb_long_t)co->aice.u.recv.real : -1;
+}
+tb_long_t tb_co_send(tb_aico_ref_t aico, tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_co_impl_t* co = tb_co_self_impl();
+    tb_assert_and_check_return_val(co && aico && data && size, -1);
+
+    // send all data
+    tb_size_t send = 0;
+    while (send < size)
+    {
+        // wait send
+        co->aice.code           = TB_AICE_CODE_SEND;
+        co->aice.aico           = aico;
+        co->aice.u.send.data    = data + send;
+        co->aice.u.send.size    = (tb_iovec_size_t)(size - send);
+        co->aice.u.send.real    = 0;
+        tb_co_suspend(co, tb_co_wait_aice);
+
+        // failed?
+        tb_check_return_val(co->aice.state == TB_STATE_OK && co->aice.u.send.real, -1);
+
+        // update size
+        send += co->aice.u.send.real;
+    }
+
+    // ok
+    return (tb_long_t)send;
+}
+tb_bool_t tb_co_clos(tb_aico_ref_t aico)
+{
+    // check
+    tb_co_impl_t* co = tb_co_self_impl();
+    tb_assert_and_check_return_val(co && aico, tb_false);
+
+    // closed?
+    tb_check_return_val(!tb_aico_clos_try(aico), tb_true);
+
+    // wait clos
+    co->aice.code = TB_AICE_CODE_CLOS;
+    co->aice.aico = aico;
+    tb_co_suspend(co, tb_co_wait_aice);
+
+    // ok?
+    return co->aice.state == TB_STATE_OK;
+}
+tb_bool_t tb_co_sleep(tb_size_t delay)
+{
+    // check
+    tb_co_impl_t* co = tb_co_self_impl();
+    tb_assert_and_check_return_val(co && co->aicp, tb_false);
+
+    // init the task aico
+    if (!co->task)
+    {
+        co->task = tb_aico_init(co->aicp);
+        tb_assert_and_check_return_val(co->task, tb_false);
+
+        // open it
+        if (!tb_aico_open_task(co->task, tb_false))
+        {
+            tb_aico_exit(co->task);
+            co->task = tb_null;
+            return tb_false;
+        }
+    }
+
+    // wait task
+    co->aice.code               = TB_AICE_CODE_RUNTASK;
+    co->aice.aico               = co->task;
+    co->aice.u.runtask.delay    = delay;
+    tb_co_suspend(co, tb_co_wait_aice);
+
+    // ok?
+    return co->aice.state == TB_STATE_OK;
+}
+tb_bool_t tb_co_stream_open(tb_async_stream_ref_t stream)
+{
+    // check
+    tb_co_impl_t* co = tb_co_self_impl();
+    tb_assert_and_check_return_val(co && stream, tb_false);
+
+    // opened?
+    tb_check_return_val(!tb_async_stream_is_opened(stream), tb_true);
+
+    // wait open
+    co->stream = stream;
+    tb_co_suspend(co, tb_co_wait_stream_open);
+
+    // ok?
+    return co->aice.state == TB_STATE_OK;
+}
+tb_long_t tb_co_stream_read(tb_async_stream_ref_t stream, tb_byte_t* data, tb_size_t size)
+{
+    // check
+    tb_co_impl_t* co = tb_co_self_impl();
+    tb_assert_and_check_return_val(co && stream && data && size, -1);
+
+    // wait read
+    co->stream              = stream;
+    co->aice.u.recv.data    = data;
+    co->aice.u.recv.size    = (tb_iovec_size_t)size;
+    co->aice.u.recv.real    = 0;
+    tb_co_suspend(co, tb_co_wait_stream_read);
+
+    // ok?
+    return co->aice.state == TB_STATE_OK? (tb_long_t)co->aice.u.recv.real : -1;
+}
+tb_bool_t tb_co_stream_writ(tb_async_stream_ref_t stream, tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_co_impl_t* co = tb_co_self_impl();
+    tb_assert_and_check_return_val(co && stream && data && size, tb_false);
+
+    // wait writ
+    co->stream              = stream;
+    co->aice.u.send.data    = data;
+    co->aice.u.send.size    = (tb_iovec_size_t)size;
+    tb_co_suspend(co, tb_co_wait_stream_writ);
+
+    // ok?
+    return co->aice.state == TB_STATE_OK;
+}
+tb_bool_t tb_co_stream_sync(tb_async_stream_ref_t stream, tb_bool_t bclosing)
+{
+    // check
+    tb_co_impl_t* co = tb_co_self_impl();
+    tb_assert_and_check_return_val(co && stream, tb_false);
+
+    // wait sync
+    co->stream      = stream;
+    co->bclosing    = bclosing;
+    tb_co_suspend(co, tb_co_wait_stream_sync);
+
+    // ok?
+    return co->aice.state == TB_STATE_OK;
+}
+tb_void_t tb_co_stream_clos(tb_async_stream_ref_t stream)
+{
+    // check
+    tb_co_impl_t* co = tb_co_self_impl();
+    tb_assert_and_check_return(co && stream);
+
+    // wait clos
+    co->stream = stream;
+    tb_co_suspend(co, tb_co_wait_stream_clos);
+}
+#else
+tb_bool_t tb_co_start(tb_aicp_ref_t aicp, tb_co_func_t func, tb_cpointer_t priv, tb_size_t stacksize)
+{
+    // trace
+    tb_trace_e("the coroutine is not supported on this arch!");
+    return tb_false;
+}
+tb_co_ref_t tb_co_self()
+{
+    return tb_null;
+}
+tb_size_t tb_co_state()
+{
+    return TB_STATE_NOT_SUPPORTED;
+}
+tb_bool_t tb_co_conn(tb_aico_ref_t aico, tb_ipaddr_ref_t addr)
+{
+    tb_trace_noimpl();
+    return tb_false;
+}
+tb_long_t tb_co_recv(tb_aico_ref_t aico, tb_byte_t* data, tb_size_t size)
+{
+    tb_trace_noimpl();
+    return -1;
+}
+tb_long_t tb_co_send(tb_aico_ref_t aico, tb_byte_t const* data, tb_size_t size)
+{
+    tb_trace_noimpl();
+    return -1;
+}
+tb_bool_t tb_co_clos(tb_aico_ref_t aico)
+{
+    tb_trace_noimpl();
+    return tb_false;
+}
+tb_bool_t tb_co_sleep(tb_size_t delay)
+{
+    tb_trace_noimpl();
+    return tb_false;
+}
+tb_bool_t tb_co_stream_open(tb_async_stream_ref_t stream)
+{
+    tb_trace_noimpl();
+    return tb_false;
+}
+tb_long_t tb_co_stream_read(tb_async_stream_ref_t stream, tb_byte_t* data, tb_size_t size)
+{
+    tb_trace_noimpl();
+    return -1;
+}
+tb_bool_t tb_co_stream_writ(tb_async_stream_ref_t stream, tb_byte_t const* data, tb_size_t size)
+{
+    tb_trace_noimpl();
+    return tb_false;
+}
+tb_bool_t tb_co_stream_sync(tb_async_stream_ref_t stream, tb_bool_t bclosing)
+{
+    tb_trace_noimpl();
+    return tb_false;
+}
+tb_void_t tb_co_stream_clos(tb_async_stream_ref_t stream)
+{
+    tb_trace_noimpl();
+}
+#endif
@@ -0,0 +1,202 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        co.h
+ * @ingroup     asio
+ *
+ */
+#ifndef TB_ASIO_CO_H
+#define TB_ASIO_CO_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "aicp.h"
+#include "aico.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the coroutine ref type
+typedef struct{}*   tb_co_ref_t;
+
+/// the coroutine func type
+typedef tb_void_t   (*tb_co_func_t)(tb_cpointer_t priv);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! start a coroutine
+ *
+ * the coroutine will run in the current thread until it waits for the first aice,
+ * and it will be resumed in the aicp loop thread after the aice is done.
+ *
+ * the blocking-style interfaces (tb_co_recv, tb_co_send, ...) can be called in it,
+ * and the coroutine will be exited automatically after the func returns.
+ *
+ * @note only the stack of the default size will be cached and reused,
+ * and each stack need two mappings with the guard page, 
+ * .e.g the vm.max_map_count of linux need be increased for more than 32k coroutines at the same time.
+ *
+ * @code
+ 
+    static tb_void_t tb_demo_co_echo(tb_cpointer_t priv)
+    {
+        tb_aico_ref_t   aico = (tb_aico_ref_t)priv;
+        tb_byte_t       data[4096];
+        tb_long_t       real = 0;
+        while ((real = tb_co_recv(aico, data, sizeof(data))) > 0)
+        {
+            if (tb_co_send(aico, data, real) < 0) break;
+        }
+        tb_co_clos(aico);
+        tb_aico_exit(aico);
+    }
+
+    tb_co_start(aicp, tb_demo_co_echo, aico, 0);
+
+ * @endcode
+ *
+ * @param aicp      the aicp
+ * @param func      the coroutine func
+ * @param priv      the func private data
+ * @param stacksize the stack size, using the default size if be zero
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_co_start(tb_aicp_ref_t aicp, tb_co_func_t func, tb_cpointer_t priv, tb_size_t stacksize);
+
+/*! the current coroutine
+ *
+ * @return          the coroutine, tb_null if not in the coroutine
+ */
+tb_co_ref_t         tb_co_self(tb_noarg_t);
+
+/*! the done state of the last waited aice of the current coroutine 
+ *
+ * @return          the state, .e.g TB_STATE_OK, TB_STATE_CLOSED, TB_STATE_TIMEOUT, TB_STATE_KILLED ...
+ */
+tb_size_t           tb_co_state(tb_noarg_t);
+
+/*! connect the sock aico and wait it
+ *
+ * @param aico      the sock aico
+ * @param addr      the address
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_co_conn(tb_aico_ref_t aico, tb_ipaddr_ref_t addr);
+
+/*! recv data from the sock aico and wait it
+ *
+ * @param aico      the sock aico
+ * @param data      the data
+ * @param size      the size
+ *
+ * @return          the real size, -1: failed, closed, killed or timeout, see tb_co_state()
+ */
+tb_long_t           tb_co_recv(tb_aico_ref_t aico, tb_byte_t* data, tb_size_t size);
+
+/*! send all data to the sock aico and wait it
+ *
+ * @param aico      the sock aico
+ * @param data      the data
+ * @param size      the size
+ *
+ * @return          the real size, -1: failed, closed, killed or timeout, see tb_co_state()
+ */
+tb_long_t           tb_co_send(tb_aico_ref_t aico, tb_byte_t const* data, tb_size_t size);
+
+/*! close the aico and wait it
+ *
+ * @param aico      the aico
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_co_clos(tb_aico_ref_t aico);
+
+/*! sleep the current coroutine 
+ *
+ * @param delay     the delay time, ms
+ *
+ * @return          tb_true or tb_false if be killed
+ */
+tb_bool_t           tb_co_sleep(tb_size_t delay);
+
+/*! open the async stream and wait it
+ *
+ * @param stream    the async stream
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_co_stream_open(tb_async_stream_ref_t stream);
+
+/*! read data from the async stream and wait it
+ *
+ * @param stream    the async stream
+ * @param data      the data
+ * @param size      the size
+ *
+ * @return          the real size, -1: failed, closed or killed, see tb_co_state()
+ */
+tb_long_t           tb_co_stream_read(tb_async_stream_ref_t stream, tb_byte_t* data, tb_size_t size);
+
+/*! writ all data to the async stream and wait it
+ *
+ * @param stream    the async stream
+ * @param data      the data
+ * @param size      the size
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_co_stream_writ(tb_async_stream_ref_t stream, tb_byte_t const* data, tb_size_t size);
+
+/*! sync the cached data of the async stream and wait it
+ *
+ * the written data may be cached in the async stream, 
+ * so it need be synced before closing the stream, otherwise the cached data will be discarded.
+ *
+ * @param stream    the async stream
+ * @param bclosing  sync it for closing the stream?
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_co_stream_sync(tb_async_stream_ref_t stream, tb_bool_t bclosing);
+
+/*! close the async stream and wait it
+ *
+ * @note the cached data will not be synced, see tb_co_stream_sync()
+ *
+ * @param stream    the async stream
+ */
+tb_void_t           tb_co_stream_clos(tb_async_stream_ref_t stream);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
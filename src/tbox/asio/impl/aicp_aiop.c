@@ -25,6 +25,17 @@
  */
 #include "prefix.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the queued send aice maxn of the send chain for each aico
+#ifdef __tb_small__
+#   define TB_AIOP_SEND_CHAIN_MAXN      (16)
+#else
+#   define TB_AIOP_SEND_CHAIN_MAXN      (64)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -44,6 +55,9 @@ typedef struct __tb_aiop_ptor_impl_t
      * index: 1: lower priority for io aice 
      */
     tb_queue_ref_t              spak[2];
+
+    // the done aice of the send chain, need not spak it again
+    tb_queue_ref_t              done;
     
     // the spak lock
     tb_spinlock_t               lock;
@@ -77,26 +91,20 @@ typedef struct __tb_aiop_ptor_impl_t
 
 }tb_aiop_ptor_impl_t;
 
-// the aiop aico type
-typedef struct __tb_aiop_aico_t
+// the aiop aico wait type
+typedef struct __tb_aiop_aico_wait_t
 {
-    // the base
-    tb_aico_impl_t              base;
-
-    // the impl
-    tb_aiop_ptor_impl_t*        impl;
-
-    // the aioo
-    tb_aioo_ref_t               aioo;
-
     // the aice
     tb_aice_t                   aice;
 
     // the task
     tb_handle_t                 task;
 
+    // the code of the posted aice, be none if this wait is idle
+    tb_uint8_t                  post;
+
     /* wait ok? avoid spak double aice when wait killed/timeout and ok at same time
-     * need lock it using impl->lock
+     * need lock it using aico->base.lock
      */
     tb_uint8_t                  wait_ok : 1;
 
@@ -106,6 +114,30 @@ typedef struct __tb_aiop_aico_t
     // is ltimer?
     tb_uint8_t                  bltimer : 1;
 
+}tb_aiop_aico_wait_t;
+
+// the aiop aico type
+typedef struct __tb_aiop_aico_t
+{
+    // the base
+    tb_aico_impl_t              base;
+
+    // the impl
+    tb_aiop_ptor_impl_t*        impl;
+
+    // the aioo
+    tb_aioo_ref_t               aioo;
+
+    /* the wait 
+     *
+     * index: 0: for acpt, conn, task and the recv aice
+     * index: 1: for the send aice
+     */
+    tb_aiop_aico_wait_t         wait[2];
+
+    // the queued send aices after the pending send aice
+    tb_queue_ref_t              chain;
+
 }tb_aiop_aico_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -173,10 +205,151 @@ static tb_void_t tb_aiop_spak_work(tb_aiop_ptor_impl_t* impl)
     // post wait
     if (value >= 0 && value < work) tb_semaphore_post(impl->wait, work - value);
 }
-static tb_bool_t tb_aiop_push_sock(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice)
+static __tb_inline__ tb_aiop_aico_wait_t* tb_aiop_aico_wait(tb_aiop_aico_t* aico, tb_aice_ref_t aice)
+{
+    // the send aice? using the send wait
+    return &aico->wait[tb_aiop_aioe_code(aice) == TB_AIOE_CODE_SEND? 1 : 0];
+}
+static tb_size_t tb_aiop_aico_wait_code(tb_aiop_aico_t* aico)
+{
+    // the aioe code of all waiting aice
+    tb_size_t i = 0;
+    tb_size_t code = TB_AIOE_CODE_NONE;
+    for (i = 0; i < tb_arrayn(aico->wait); i++)
+    {
+        // waiting and not spaked?
+        if (aico->wait[i].waiting && !aico->wait[i].wait_ok) 
+            code |= tb_aiop_aioe_code(&aico->wait[i].aice);
+    }
+
+    // the code
+    return code;
+}
+static tb_bool_t tb_aiop_aico_wait_arm(tb_aiop_ptor_impl_t* impl, tb_aiop_aico_t* aico, tb_size_t code)
+{
+    // check
+    tb_assert_and_check_return_val(impl && impl->aiop && aico && aico->base.handle && code, tb_false);
+
+    // wait once if not accept 
+    if (!(code & TB_AIOE_CODE_ACPT)) code |= TB_AIOE_CODE_ONESHOT;
+
+    // using the edge triggered mode
+    if (tb_aiop_have(impl->aiop, TB_AIOE_CODE_CLEAR))
+        code |= TB_AIOE_CODE_CLEAR;
+
+    // have aioo? sete wait
+    if (aico->aioo) return tb_aiop_sete(impl->aiop, aico->aioo, code, aico);
+
+    // addo wait
+    aico->aioo = tb_aiop_addo(impl->aiop, aico->base.handle, code, aico);
+
+    // ok?
+    return aico->aioo? tb_true : tb_false;
+}
+static tb_long_t tb_aiop_aico_post(tb_aiop_ptor_impl_t* impl, tb_aiop_aico_t* aico, tb_aice_ref_t aice)
+{
+    // the wait and the other wait
+    tb_aiop_aico_wait_t* wait = tb_aiop_aico_wait(aico, aice);
+    tb_aiop_aico_wait_t* other = &aico->wait[wait == aico->wait? 1 : 0];
+
+    // enter
+    tb_spinlock_enter(&aico->base.lock);
+
+    // done
+    tb_long_t ok = -1;
+    do
+    {
+        // the acpt, conn or task aice is pending? it need the idle aico
+        tb_check_break(!other->post || tb_aice_impl_is_duplex(other->post));
+
+        // this wait is idle? post it
+        if (!wait->post)
+        {
+            // the acpt, conn or task aice need the idle aico
+            tb_check_break(!other->post || tb_aice_impl_is_duplex(aice->code));
+
+            // post it
+            wait->post = aice->code;
+            ok = 1;
+        }
+        // the send aice is pending? queue it to the send chain
+        else if (aice->code == TB_AICE_CODE_SEND && wait->post == TB_AICE_CODE_SEND)
+        {
+            // init the send chain
+            if (!aico->chain) aico->chain = tb_queue_init(TB_AIOP_SEND_CHAIN_MAXN >> 2, tb_element_mem(sizeof(tb_aice_t), tb_null, tb_null));
+            tb_assert_and_check_break(aico->chain);
+
+            // full?
+            tb_check_break(tb_queue_size(aico->chain) < TB_AIOP_SEND_CHAIN_MAXN);
+
+            // queue it
+            tb_queue_put(aico->chain, aice);
+            ok = 0;
+        }
+
+    } while (0);
+
+    // leave
+    tb_spinlock_leave(&aico->base.lock);
+
+    // trace
+    tb_trace_d("post: aico: %p, code: %lu, wait: %u, other: %u: %ld", aico, aice->code, wait->post, other->post, ok);
+
+    // ok?
+    return ok;
+}
+static tb_void_t tb_aiop_aico_done(tb_aiop_ptor_impl_t* impl, tb_aiop_aico_t* aico, tb_aice_ref_t aice)
+{
+    // the wait
+    tb_aiop_aico_wait_t* wait = tb_aiop_aico_wait(aico, aice);
+
+    // enter
+    tb_spinlock_enter(&aico->base.lock);
+
+    // clear waiting state
+    wait->waiting = 0;
+    wait->aice.code = TB_AICE_CODE_NONE;
+
+    // spak the next queued send aice
+    tb_bool_t spak = tb_false;
+    if (aice->code == TB_AICE_CODE_SEND && aico->chain && !tb_queue_null(aico->chain))
+    {
+        // the next aice
+        tb_aice_ref_t next = (tb_aice_ref_t)tb_queue_get(aico->chain);
+        tb_assert(next && next->code == TB_AICE_CODE_SEND);
+
+        // this aico is killed? post to higher priority queue
+        tb_size_t priority = tb_aico_impl_is_killed(&aico->base)? 0 : tb_aice_impl_priority(next);
+
+        // enter 
+        tb_spinlock_enter(&impl->lock);
+
+        // push it to the spak queue
+        tb_queue_put(impl->spak[priority], next);
+
+        // leave 
+        tb_spinlock_leave(&impl->lock);
+
+        // pop it
+        tb_queue_pop(aico->chain);
+        spak = tb_true;
+    }
+    // idle now
+    else wait->post = TB_AICE_CODE_NONE;
+
+    // leave
+    tb_spinlock_leave(&aico->base.lock);
+
+    // work it
+    if (spak) tb_aiop_spak_work(impl);
+}
+static tb_bool_t tb_aiop_push_sock(tb_aiop_ptor_impl_t* impl, tb_aiop_aico_wait_t* wait)
 {
     // check 
-    tb_assert_and_check_return_val(impl && aice && aice->aico, tb_false);
+    tb_assert_and_check_return_val(impl && wait && wait->aice.aico, tb_false);
+
+    // the aice
+    tb_aice_ref_t aice = &wait->aice;
 
     // the priority
     tb_size_t priority = tb_aice_impl_priority(aice);
@@ -198,7 +371,7 @@ static tb_bool_t tb_aiop_push_sock(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice
         tb_queue_put(impl->spak[priority], aice);
 
         // wait ok if be not acpt aice
-        if (aice->code != TB_AICE_CODE_ACPT) ((tb_aiop_aico_t*)aice->aico)->wait_ok = 1;
+        if (aice->code != TB_AICE_CODE_ACPT) wait->wait_ok = 1;
     }
     else 
     {
@@ -369,27 +542,55 @@ static tb_pointer_t tb_aiop_spak_loop(tb_cpointer_t priv)
                 tb_aioe_ref_t aioe = &impl->list[i];
                 tb_assert_and_check_break_state(aioe, end, tb_true);
 
-                // the aice
-                tb_aice_ref_t aice = (tb_aice_ref_t)aioe->priv;
-                tb_assert_and_check_break_state(aice, end, tb_true);
-
-                // the aico
-                tb_aiop_aico_t* aico = (tb_aiop_aico_t*)aice->aico;
-                tb_assert_and_check_break_state(aico, end, tb_true);
-
-                // have wait?
-                tb_check_continue(aice->code);
-
-                // have been waited ok for the timer timeout/killed func? need not spak it repeatly
-                tb_check_continue(!aico->wait_ok);
+                // the aico, maybe null if the oneshot event has been cleared
+                tb_aiop_aico_t* aico = (tb_aiop_aico_t*)aioe->priv;
+                tb_check_continue(aico);
 
                 // sock?
                 if (aico->base.type == TB_AICO_TYPE_SOCK)
                 {
-                    // push the acpt aice
-                    if (aice->code == TB_AICE_CODE_ACPT) end = tb_aiop_push_acpt(impl, aice)? tb_false : tb_true;
-                    // push the sock aice
-                    else end = tb_aiop_push_sock(impl, aice)? tb_false : tb_true;
+                    // enter
+                    tb_spinlock_enter(&aico->base.lock);
+
+                    // push the ready aice of the recv and send wait
+                    tb_size_t j = 0;
+                    tb_size_t left = TB_AIOE_CODE_NONE;
+                    tb_bool_t once = tb_false;
+                    for (j = 0; j < tb_arrayn(aico->wait) && !end; j++)
+                    {
+                        // the wait
+                        tb_aiop_aico_wait_t* wait = &aico->wait[j];
+
+                        // have been waited ok for the timer timeout/killed func? need not spak it repeatly
+                        tb_check_continue(wait->waiting && !wait->wait_ok);
+
+                        // not ready? wait it continuously
+                        tb_size_t code = tb_aiop_aioe_code(&wait->aice);
+                        if (!(aioe->code & code))
+                        {
+                            left |= code;
+                            continue;
+                        }
+
+                        // push the acpt aice
+                        if (wait->aice.code == TB_AICE_CODE_ACPT) end = tb_aiop_push_acpt(impl, &wait->aice)? tb_false : tb_true;
+                        // push the sock aice
+                        else 
+                        {
+                            end = tb_aiop_push_sock(impl, wait)? tb_false : tb_true;
+                            once = tb_true;
+                        }
+                    }
+
+                    // the oneshot event has been cleared? wait the left aice again
+                    if (once && left && !tb_aiop_aico_wait_arm(impl, aico, left))
+                    {
+                        // trace
+                        tb_trace_e("loop: wait the left aice: %lu failed for aico: %p", left, aico);
+                    }
+
+                    // leave
+                    tb_spinlock_leave(&aico->base.lock);
                 }
                 else if (aico->base.type == TB_AICO_TYPE_FILE)
                 {
@@ -420,35 +621,31 @@ static tb_pointer_t tb_aiop_spak_loop(tb_cpointer_t priv)
 }
 static tb_void_t tb_aiop_spak_wait_timeout(tb_bool_t killed, tb_cpointer_t priv)
 {
+    // the wait
+    tb_aiop_aico_wait_t* wait = (tb_aiop_aico_wait_t*)priv;
+    tb_assert_and_check_return(wait && wait->waiting);
+
     // the aico
-    tb_aiop_aico_t* aico = (tb_aiop_aico_t*)priv;
-    tb_assert_and_check_return(aico && aico->waiting);
+    tb_aiop_aico_t* aico = (tb_aiop_aico_t*)wait->aice.aico;
+    tb_assert_and_check_return(aico);
 
     // the impl
     tb_aiop_ptor_impl_t* impl = aico->impl;
     tb_assert_and_check_return(impl && impl->aiop);
 
-    // for sock
-    if (aico->base.type == TB_AICO_TYPE_SOCK)
-    {
-        // check
-        tb_assert_and_check_return(aico->aioo);
+    // the priority
+    tb_size_t priority = tb_aice_impl_priority(&wait->aice);
+    tb_assert_and_check_return(priority < tb_arrayn(impl->spak) && impl->spak[priority]);
 
-        // delo aioo
-        tb_aiop_delo(impl->aiop, aico->aioo);
-        aico->aioo = tb_null;
-    }
+    // enter
+    tb_spinlock_enter(&aico->base.lock);
 
     // have been waited ok for the spak loop? need not spak it repeatly
     tb_bool_t ok = tb_false;
-    if (!aico->wait_ok)
+    if (!wait->wait_ok)
     {
-        // the priority
-        tb_size_t priority = tb_aice_impl_priority(&aico->aice);
-        tb_assert_and_check_return(priority < tb_arrayn(impl->spak) && impl->spak[priority]);
-
         // trace
-        tb_trace_d("wait: timeout: code: %lu, priority: %lu, time: %lld", aico->aice.code, priority, tb_cache_time_mclock());
+        tb_trace_d("wait: timeout: code: %lu, priority: %lu, time: %lld", wait->aice.code, priority, tb_cache_time_mclock());
 
         // enter 
         tb_spinlock_enter(&impl->lock);
@@ -457,14 +654,14 @@ static tb_void_t tb_aiop_spak_wait_timeout(tb_bool_t killed, tb_cpointer_t priv)
         if (!tb_queue_full(impl->spak[priority])) 
         {
             // save state
-            aico->aice.state = killed? TB_STATE_KILLED : TB_STATE_TIMEOUT;
+            wait->aice.state = killed? TB_STATE_KILLED : TB_STATE_TIMEOUT;
 
             // put it
-            tb_queue_put(impl->spak[priority], &aico->aice);
+            tb_queue_put(impl->spak[priority], &wait->aice);
 
             // ok
             ok = tb_true;
-            aico->wait_ok = 1;
+            wait->wait_ok = 1;
         }
         else tb_assert(0);
 
@@ -472,6 +669,22 @@ static tb_void_t tb_aiop_spak_wait_timeout(tb_bool_t killed, tb_cpointer_t priv)
         tb_spinlock_leave(&impl->lock);
     }
 
+    // for sock
+    if (aico->base.type == TB_AICO_TYPE_SOCK && aico->aioo)
+    {
+        // wait the other aice only
+        tb_size_t code = tb_aiop_aico_wait_code(aico);
+        if (!code || !tb_aiop_aico_wait_arm(impl, aico, code))
+        {
+            // delo aioo
+            tb_aiop_delo(impl->aiop, aico->aioo);
+            aico->aioo = tb_null;
+        }
+    }
+
+    // leave
+    tb_spinlock_leave(&aico->base.lock);
+
     // work it
     if (ok) tb_aiop_spak_work(impl);
 }
@@ -482,7 +695,11 @@ static tb_bool_t tb_aiop_spak_wait(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice
 
     // the aico
     tb_aiop_aico_t* aico = (tb_aiop_aico_t*)aice->aico;
-    tb_assert_and_check_return_val(aico && aico->base.handle && !aico->task, tb_false);
+    tb_assert_and_check_return_val(aico && aico->base.handle, tb_false);
+
+    // the wait
+    tb_aiop_aico_wait_t* wait = tb_aiop_aico_wait(aico, aice);
+    tb_assert_and_check_return_val(!wait->task, tb_false);
 
     // the aioe code
     tb_size_t code = tb_aiop_aioe_code(aice);
@@ -491,43 +708,30 @@ static tb_bool_t tb_aiop_spak_wait(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice
     // trace
     tb_trace_d("wait: aico: %p, code: %lu: time: %lld: ..", aico, aice->code, tb_cache_time_mclock());
 
+    // enter
+    tb_spinlock_enter(&aico->base.lock);
+
     // done
     tb_bool_t ok = tb_false;
-    tb_aice_t prev = aico->aice;
+    tb_aice_t prev = wait->aice;
     do
     {
         // wait it
-        aico->aice = *aice;
-        aico->waiting = 1;
-        aico->wait_ok = 0;
-
-        // wait once if not accept 
-        if (aice->code != TB_AICE_CODE_ACPT) code |= TB_AIOE_CODE_ONESHOT;
-
-        // using the edge triggered mode
-        if (tb_aiop_have(impl->aiop, TB_AIOE_CODE_CLEAR))
-            code |= TB_AIOE_CODE_CLEAR;
+        wait->aice = *aice;
+        wait->waiting = 1;
+        wait->wait_ok = 0;
 
-        // have aioo?
-        if (!aico->aioo) 
-        {
-            // addo wait
-            if (!(aico->aioo = tb_aiop_addo(impl->aiop, aico->base.handle, code, &aico->aice))) break;
-        }
-        else
-        {
-            // sete wait
-            if (!tb_aiop_sete(impl->aiop, aico->aioo, code, &aico->aice)) break;
-        }
+        // wait it with the other waiting aice
+        if (!tb_aiop_aico_wait_arm(impl, aico, tb_aiop_aico_wait_code(aico))) break;
 
         // add timeout task
         tb_long_t timeout = tb_aico_impl_timeout_from_code((tb_aico_impl_t*)aico, aice->code);
         if (timeout >= 0) 
         {
             // add it
-            aico->task = tb_ltimer_task_init(impl->ltimer, timeout, tb_false, tb_aiop_spak_wait_timeout, aico);
-            tb_assert_and_check_break(aico->task);
-            aico->bltimer = 1;
+            wait->task = tb_ltimer_task_init(impl->ltimer, timeout, tb_false, tb_aiop_spak_wait_timeout, wait);
+            tb_assert_and_check_break(wait->task);
+            wait->bltimer = 1;
         }
 
         // ok
@@ -542,10 +746,13 @@ static tb_bool_t tb_aiop_spak_wait(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice
         tb_trace_d("wait: aico: %p, code: %lu: failed", aico, aice->code);
 
         // restore it
-        aico->aice = prev;
-        aico->waiting = 0;
+        wait->aice = prev;
+        wait->waiting = 0;
     }
 
+    // leave
+    tb_spinlock_leave(&aico->base.lock);
+
     // ok?
     return ok;
 }
@@ -558,7 +765,7 @@ static tb_long_t tb_aiop_spak_acpt(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice
     // the aico
     tb_aiop_aico_t* aico = (tb_aiop_aico_t*)aice->aico;
     tb_assert_and_check_return_val(aico && aico->base.handle, -1);
-    tb_assert_and_check_return_val(!aico->waiting, -1);
+    tb_assert_and_check_return_val(!tb_aiop_aico_wait(aico, aice)->waiting, -1);
 
     // trace
     tb_trace_d("acpt[%p]: wait: ..", aico);
@@ -572,8 +779,7 @@ static tb_long_t tb_aiop_spak_acpt(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice
     tb_trace_d("acpt[%p]: wait: failed", aico);
 
     // reset wait
-    aico->waiting = 0;
-    aico->aice.code = TB_AICE_CODE_NONE;
+    tb_aiop_aico_done(impl, aico, aice);
 
     // ok
     return 1;
@@ -601,7 +807,7 @@ static tb_long_t tb_aiop_spak_conn(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice
     if (!ok) 
     {
         // wait it
-        if (!aico->waiting)
+        if (!tb_aiop_aico_wait(aico, aice)->waiting)
         {
             // wait ok?
             if (tb_aiop_spak_wait(impl, aice)) return 0;
@@ -616,8 +822,7 @@ static tb_long_t tb_aiop_spak_conn(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice
     aice->state = ok > 0? TB_STATE_OK : TB_STATE_FAILED;
     
     // reset wait
-    aico->waiting = 0;
-    aico->aice.code = TB_AICE_CODE_NONE;
+    tb_aiop_aico_done(impl, aico, aice);
 
     // ok
     return 1;
@@ -625,21 +830,37 @@ static tb_long_t tb_aiop_spak_conn(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice
 static tb_long_t tb_aiop_spak_recv(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice)
 {
     // check
-    tb_assert_and_check_return_val(impl && aice, -1);
+    tb_assert_and_check_return_val(impl && impl->base.aicp && aice, -1);
     tb_assert_and_check_return_val(aice->code == TB_AICE_CODE_RECV, -1);
-    tb_assert_and_check_return_val(aice->u.recv.data && aice->u.recv.size, -1);
+    tb_assert_and_check_return_val(aice->u.recv.data? aice->u.recv.size : !aice->u.recv.size, -1);
 
     // the aico
     tb_aiop_aico_t* aico = (tb_aiop_aico_t*)aice->aico;
     tb_assert_and_check_return_val(aico && aico->base.handle, -1);
 
+    // no data? using the buffer of the recv buffer pool 
+    tb_byte_t*  data = aice->u.recv.data;
+    tb_size_t   size = aice->u.recv.size;
+    if (!data && !(data = tb_aicp_impl_rpool_malloc(impl->base.aicp, &size)))
+    {
+        // trace
+        tb_trace_e("recv[%p]: no buffer in the recv buffer pool!", aico);
+
+        // failed
+        aice->state = TB_STATE_FAILED;
+
+        // reset wait
+        tb_aiop_aico_done(impl, aico, aice);
+        return 1;
+    }
+
     // try to recv it
     tb_size_t recv = 0;
     tb_long_t real = 0;
-    while (recv < aice->u.recv.size)
+    while (recv < size)
     {
         // recv it
-        real = tb_socket_recv(aico->base.handle, aice->u.recv.data + recv, aice->u.recv.size - recv);
+        real = tb_socket_recv(aico->base.handle, data + recv, size - recv);
 
         // save recv
         if (real > 0) recv += real;
@@ -652,8 +873,11 @@ static tb_long_t tb_aiop_spak_recv(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice
     // no recv? 
     if (!recv) 
     {
+        // free the buffer of the recv buffer pool, the idle aico need not hold it
+        if (!aice->u.recv.data) tb_aicp_rpool_free((tb_aicp_ref_t)impl->base.aicp, data);
+
         // wait it
-        if (!real && !aico->waiting)
+        if (!real && !tb_aiop_aico_wait(aico, aice)->waiting)
         {
             // wait ok?
             if (tb_aiop_spak_wait(impl, aice)) return 0;
@@ -668,13 +892,14 @@ static tb_long_t tb_aiop_spak_recv(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice
         // ok or closed?
         aice->state = TB_STATE_OK;
 
-        // save the recv size
+        // save the recv data and size
+        aice->u.recv.data = data;
+        aice->u.recv.size = (tb_iovec_size_t)size;
         aice->u.recv.real = recv;
     }
     
     // reset wait
-    aico->waiting = 0;
-    aico->aice.code = TB_AICE_CODE_NONE;
+    tb_aiop_aico_done(impl, aico, aice);
 
     // ok
     return 1;
@@ -684,54 +909,124 @@ static tb_long_t tb_aiop_spak_send(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice
     // check
     tb_assert_and_check_return_val(impl && aice, -1);
     tb_assert_and_check_return_val(aice->code == TB_AICE_CODE_SEND, -1);
-    tb_assert_and_check_return_val(aice->u.send.data && aice->u.send.size, -1);
+    tb_assert_and_check_return_val(aice->u.send.data && aice->u.send.size && aice->u.send.real < aice->u.send.size, -1);
 
     // the aico
     tb_aiop_aico_t* aico = (tb_aiop_aico_t*)aice->aico;
     tb_assert_and_check_return_val(aico && aico->base.handle, -1);
 
+    // init the left data of this aice
+    tb_iovec_t  list[TB_AIOP_SEND_CHAIN_MAXN + 1];
+    tb_size_t   size = 1;
+    tb_size_t   left = aice->u.send.size - aice->u.send.real;
+    list[0].data = (tb_byte_t*)aice->u.send.data + aice->u.send.real;
+    list[0].size = (tb_iovec_size_t)left;
+
+    // coalesce the left data of the queued send aices
+    tb_spinlock_enter(&aico->base.lock);
+    if (aico->chain)
+    {
+        tb_for_all_if (tb_aice_ref_t, item, aico->chain, item)
+        {
+            // full?
+            tb_check_break(size < tb_arrayn(list));
+
+            // append it
+            list[size].data = (tb_byte_t*)item->u.send.data + item->u.send.real;
+            list[size].size = (tb_iovec_size_t)(item->u.send.size - item->u.send.real);
+            size++;
+        }
+    }
+    tb_spinlock_leave(&aico->base.lock);
+
     // try to send it
+    tb_size_t indx = 0;
     tb_size_t send = 0;
     tb_long_t real = 0;
-    while (send < aice->u.send.size)
+    while (indx < size)
     {
         // send it
-        real = tb_socket_send(aico->base.handle, aice->u.send.data + send, aice->u.send.size - send);
-        
+        real = (size > 1)? tb_socket_sendv(aico->base.handle, list + indx, size - indx) : tb_socket_send(aico->base.handle, list[0].data, list[0].size);
+        tb_check_break(real > 0);
+
         // save send
-        if (real > 0) send += real;
-        else break;
+        send += real;
+
+        // skip the sent data
+        tb_size_t skip = (tb_size_t)real;
+        while (indx < size && skip >= list[indx].size) skip -= list[indx++].size;
+        if (skip)
+        {
+            list[indx].data += skip;
+            list[indx].size -= (tb_iovec_size_t)skip;
+        }
     }
 
     // trace
-    tb_trace_d("send[%p]: %lu", aico, send);
+    tb_trace_d("send[%p]: %lu, chain: %lu", aico, send, size - 1);
 
-    // no send? 
-    if (!send) 
+    // save the send size of this aice
+    tb_size_t done = tb_min(send, left);
+    aice->u.send.real += done;
+    send -= done;
+
+    // the queued send aices have been sent? spak them
+    if (send)
     {
-        // wait it
-        if (!real && !aico->waiting) 
+        // enter
+        tb_spinlock_enter(&aico->base.lock);
+
+        // done the queued send aices
+        while (send && !tb_queue_null(aico->chain))
         {
-            // wait ok?
-            if (tb_aiop_spak_wait(impl, aice)) return 0;
-            // wait failed
-            else aice->state = TB_STATE_FAILED;
+            // the queued send aice
+            tb_aice_ref_t item = (tb_aice_ref_t)tb_queue_get(aico->chain);
+            tb_assert_and_check_break(item);
+
+            // not finished? save the send size and send the left data later
+            left = item->u.send.size - item->u.send.real;
+            if (send < left)
+            {
+                item->u.send.real += send;
+                break;
+            }
+
+            // finished
+            item->u.send.real = item->u.send.size;
+            item->state = TB_STATE_OK;
+            send -= left;
+
+            // spak it
+            tb_spinlock_enter(&impl->lock);
+            tb_queue_put(impl->done, item);
+            tb_spinlock_leave(&impl->lock);
+
+            // pop it
+            tb_queue_pop(aico->chain);
         }
-        // closed
-        else aice->state = TB_STATE_CLOSED;
+
+        // leave
+        tb_spinlock_leave(&aico->base.lock);
+
+        // work it
+        tb_aiop_spak_work(impl);
     }
-    else
-    {
-        // ok or closed?
-        aice->state = TB_STATE_OK;
 
-        // save the send size
-        aice->u.send.real = send;
+    // finished?
+    if (aice->u.send.real == aice->u.send.size) aice->state = TB_STATE_OK;
+    // wait it if some data have been sent now or be not waiting
+    else if (!real && (done || !tb_aiop_aico_wait(aico, aice)->waiting)) 
+    {
+        // wait ok?
+        if (tb_aiop_spak_wait(impl, aice)) return 0;
+        // wait failed
+        else aice->state = TB_STATE_FAILED;
     }
+    // closed? ok if some data have been sent
+    else aice->state = aice->u.send.real? TB_STATE_OK : TB_STATE_CLOSED;
     
     // reset wait
-    aico->waiting = 0;
-    aico->aice.code = TB_AICE_CODE_NONE;
+    tb_aiop_aico_done(impl, aico, aice);
 
     // ok
     return 1;
@@ -764,7 +1059,7 @@ static tb_long_t tb_aiop_spak_urecv(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aic
     if (!recv) 
     {
         // wait it
-        if (!real && !aico->waiting)
+        if (!real && !tb_aiop_aico_wait(aico, aice)->waiting)
         {
             // wait ok?
             if (tb_aiop_spak_wait(impl, aice)) return 0;
@@ -787,8 +1082,7 @@ static tb_long_t tb_aiop_spak_urecv(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aic
     }
     
     // reset wait
-    aico->waiting = 0;
-    aico->aice.code = TB_AICE_CODE_NONE;
+    tb_aiop_aico_done(impl, aico, aice);
 
     // ok
     return 1;
@@ -824,7 +1118,7 @@ static tb_long_t tb_aiop_spak_usend(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aic
     if (!send) 
     {
         // wait it
-        if (!real && !aico->waiting)
+        if (!real && !tb_aiop_aico_wait(aico, aice)->waiting)
         {
             // wait ok?
             if (tb_aiop_spak_wait(impl, aice)) return 0;
@@ -844,8 +1138,7 @@ static tb_long_t tb_aiop_spak_usend(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aic
     }
     
     // reset wait
-    aico->waiting = 0;
-    aico->aice.code = TB_AICE_CODE_NONE;
+    tb_aiop_aico_done(impl, aico, aice);
 
     // ok
     return 1;
@@ -874,7 +1167,7 @@ static tb_long_t tb_aiop_spak_recvv(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aic
         aice->state = TB_STATE_OK;
     }
     // no recv?
-    else if (!real && !aico->waiting)
+    else if (!real && !tb_aiop_aico_wait(aico, aice)->waiting)
     {
         // wait ok?
         if (tb_aiop_spak_wait(impl, aice)) return 0;
@@ -885,8 +1178,7 @@ static tb_long_t tb_aiop_spak_recvv(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aic
     else aice->state = TB_STATE_CLOSED;
     
     // reset wait
-    aico->waiting = 0;
-    aico->aice.code = TB_AICE_CODE_NONE;
+    tb_aiop_aico_done(impl, aico, aice);
 
     // ok
     return 1;
@@ -915,7 +1207,7 @@ static tb_long_t tb_aiop_spak_sendv(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aic
         aice->state = TB_STATE_OK;
     }
     // no send?
-    else if (!real && !aico->waiting) 
+    else if (!real && !tb_aiop_aico_wait(aico, aice)->waiting) 
     {
         // wait ok?
         if (tb_aiop_spak_wait(impl, aice)) return 0;
@@ -926,8 +1218,7 @@ static tb_long_t tb_aiop_spak_sendv(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aic
     else aice->state = TB_STATE_CLOSED;
     
     // reset wait
-    aico->waiting = 0;
-    aico->aice.code = TB_AICE_CODE_NONE;
+    tb_aiop_aico_done(impl, aico, aice);
 
     // ok
     return 1;
@@ -956,7 +1247,7 @@ static tb_long_t tb_aiop_spak_urecvv(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t ai
         aice->state = TB_STATE_OK;
     }
     // no recv?
-    else if (!real && !aico->waiting)
+    else if (!real && !tb_aiop_aico_wait(aico, aice)->waiting)
     {
         // wait ok?
         if (tb_aiop_spak_wait(impl, aice)) return 0;
@@ -967,8 +1258,7 @@ static tb_long_t tb_aiop_spak_urecvv(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t ai
     else aice->state = TB_STATE_CLOSED;
     
     // reset wait
-    aico->waiting = 0;
-    aico->aice.code = TB_AICE_CODE_NONE;
+    tb_aiop_aico_done(impl, aico, aice);
 
     // ok
     return 1;
@@ -997,7 +1287,7 @@ static tb_long_t tb_aiop_spak_usendv(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t ai
         aice->state = TB_STATE_OK;
     }
     // no send?
-    else if (!real && !aico->waiting) 
+    else if (!real && !tb_aiop_aico_wait(aico, aice)->waiting) 
     {
         // wait ok?
         if (tb_aiop_spak_wait(impl, aice)) return 0;
@@ -1008,8 +1298,7 @@ static tb_long_t tb_aiop_spak_usendv(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t ai
     else aice->state = TB_STATE_CLOSED;
     
     // reset wait
-    aico->waiting = 0;
-    aico->aice.code = TB_AICE_CODE_NONE;
+    tb_aiop_aico_done(impl, aico, aice);
 
     // ok
     return 1;
@@ -1048,7 +1337,7 @@ static tb_long_t tb_aiop_spak_sendf(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aic
     if (!send) 
     {
         // wait it
-        if (!real && !aico->waiting) 
+        if (!real && !tb_aiop_aico_wait(aico, aice)->waiting) 
         {
             // wait ok?
             if (tb_aiop_spak_wait(impl, aice)) return 0;
@@ -1068,41 +1357,44 @@ static tb_long_t tb_aiop_spak_sendf(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aic
     }
     
     // reset wait
-    aico->waiting = 0;
-    aico->aice.code = TB_AICE_CODE_NONE;
+    tb_aiop_aico_done(impl, aico, aice);
 
     // ok
     return 1;
 }
 static tb_void_t tb_aiop_spak_runtask_timeout(tb_bool_t killed, tb_cpointer_t priv)
 {
+    // the wait
+    tb_aiop_aico_wait_t* wait = (tb_aiop_aico_wait_t*)priv;
+    tb_assert_and_check_return(wait && wait->waiting);
+
     // the aico
-    tb_aiop_aico_t* aico = (tb_aiop_aico_t*)priv;
-    tb_assert_and_check_return(aico && aico->waiting);
+    tb_aiop_aico_t* aico = (tb_aiop_aico_t*)wait->aice.aico;
+    tb_assert_and_check_return(aico);
 
     // the impl
     tb_aiop_ptor_impl_t* impl = aico->impl;
     tb_assert_and_check_return(impl);
 
     // the priority
-    tb_size_t priority = tb_aice_impl_priority(&aico->aice);
+    tb_size_t priority = tb_aice_impl_priority(&wait->aice);
     tb_assert_and_check_return(priority < tb_arrayn(impl->spak) && impl->spak[priority]);
 
     // enter 
     tb_spinlock_enter(&impl->lock);
 
     // trace
-    tb_trace_d("runtask: timeout: code: %lu, priority: %lu, size: %lu", aico->aice.code, priority, tb_queue_size(impl->spak[priority]));
+    tb_trace_d("runtask: timeout: code: %lu, priority: %lu, size: %lu", wait->aice.code, priority, tb_queue_size(impl->spak[priority]));
 
     // spak aice
     tb_bool_t ok = tb_false;
     if (!tb_queue_full(impl->spak[priority])) 
     {
         // save state
-        aico->aice.state = killed? TB_STATE_KILLED : TB_STATE_OK;
+        wait->aice.state = killed? TB_STATE_KILLED : TB_STATE_OK;
 
         // put it
-        tb_queue_put(impl->spak[priority], &aico->aice);
+        tb_queue_put(impl->spak[priority], &wait->aice);
 
         // ok
         ok = tb_true;
@@ -1124,7 +1416,11 @@ static tb_long_t tb_aiop_spak_runtask(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t a
 
     // the aico
     tb_aiop_aico_t* aico = (tb_aiop_aico_t*)aice->aico;
-    tb_assert_and_check_return_val(aico && !aico->task, -1);
+    tb_assert_and_check_return_val(aico, -1);
+
+    // the wait
+    tb_aiop_aico_wait_t* wait = &aico->wait[0];
+    tb_assert_and_check_return_val(!wait->task, -1);
 
     // now
     tb_hong_t now = tb_cache_time_mclock();
@@ -1145,30 +1441,39 @@ static tb_long_t tb_aiop_spak_runtask(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t a
         // trace
         tb_trace_d("runtask: when: %llu, now: %lld: ..", aice->u.runtask.when, now);
 
+        // enter
+        tb_spinlock_enter(&aico->base.lock);
+
         // wait it
-        aico->aice = *aice;
-        aico->waiting = 1;
+        wait->aice = *aice;
+        wait->waiting = 1;
 
         // add timeout task, is the higher precision timer?
+        tb_bool_t spak = tb_false;
         if (aico->base.handle)
         {
             // the top when
             tb_hize_t top = tb_timer_top(impl->timer);
 
             // add task
-            aico->task = tb_timer_task_init_at(impl->timer, aice->u.runtask.when, 0, tb_false, tb_aiop_spak_runtask_timeout, aico);
-            aico->bltimer = 0;
+            wait->task = tb_timer_task_init_at(impl->timer, aice->u.runtask.when, 0, tb_false, tb_aiop_spak_runtask_timeout, wait);
+            wait->bltimer = 0;
 
             // the top task is changed? spak aiop
-            if (aico->task && aice->u.runtask.when < top)
-                tb_aiop_spak(impl->aiop);
+            spak = (wait->task && aice->u.runtask.when < top)? tb_true : tb_false;
         }
         else
         {
-            aico->task = tb_ltimer_task_init_at(impl->ltimer, aice->u.runtask.when, 0, tb_false, tb_aiop_spak_runtask_timeout, aico);
-            aico->bltimer = 1;
+            wait->task = tb_ltimer_task_init_at(impl->ltimer, aice->u.runtask.when, 0, tb_false, tb_aiop_spak_runtask_timeout, wait);
+            wait->bltimer = 1;
         }
 
+        // leave
+        tb_spinlock_leave(&aico->base.lock);
+
+        // spak aiop
+        if (spak) tb_aiop_spak(impl->aiop);
+
         // wait
         ok = 0;
     }
@@ -1188,15 +1493,43 @@ static tb_long_t tb_aiop_spak_clos(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice
 
     // trace
     tb_trace_d("clos: aico: %p, code: %u: %s", aico, aice->code, tb_state_cstr(tb_atomic_get(&aico->base.state)));
+
+    // enter
+    tb_spinlock_enter(&aico->base.lock);
  
-    // exit the timer task
-    if (aico->task) 
+    // exit the timer task and clear waiting state
+    tb_size_t i = 0;
+    tb_size_t n = tb_arrayn(aico->wait);
+    for (i = 0; i < n; i++)
     {
-        if (aico->bltimer) tb_ltimer_task_exit(impl->ltimer, aico->task);
-        else tb_timer_task_exit(impl->timer, aico->task);
-        aico->bltimer = 0;
+        // the wait
+        tb_aiop_aico_wait_t* wait = &aico->wait[i];
+
+        // exit the timer task
+        if (wait->task) 
+        {
+            if (wait->bltimer) tb_ltimer_task_exit(impl->ltimer, wait->task);
+            else tb_timer_task_exit(impl->timer, wait->task);
+            wait->bltimer = 0;
+        }
+        wait->task = tb_null;
+
+        // clear waiting state
+        wait->waiting = 0;
+        wait->wait_ok = 0;
+        wait->post = TB_AICE_CODE_NONE;
+        wait->aice.code = TB_AICE_CODE_NONE;
     }
-    aico->task = tb_null;
+
+    // exit the send chain
+    if (aico->chain) tb_queue_exit(aico->chain);
+    aico->chain = tb_null;
+
+    // no pending aice now
+    aico->base.pending = 0;
+
+    // leave
+    tb_spinlock_leave(&aico->base.lock);
 
     // exit the sock 
     if (aico->base.type == TB_AICO_TYPE_SOCK)
@@ -1217,17 +1550,11 @@ static tb_long_t tb_aiop_spak_clos(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice
         aico->base.handle = tb_null;
     }
 
-    // clear waiting state
-    aico->waiting = 0;
-    aico->wait_ok = 0;
-    aico->aice.code = TB_AICE_CODE_NONE;
-
     // clear type
     aico->base.type = TB_AICO_TYPE_NONE;
 
     // clear timeout
-    tb_size_t i = 0;
-    tb_size_t n = tb_arrayn(aico->base.timeout);
+    n = tb_arrayn(aico->base.timeout);
     for (i = 0; i < n; i++) aico->base.timeout[i] = -1;
 
     // closed
@@ -1246,24 +1573,30 @@ static tb_long_t tb_aiop_spak_done(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice
     tb_aiop_aico_t* aico = (tb_aiop_aico_t*)aice->aico;
     tb_assert_and_check_return_val(aico, -1);
 
+    // the wait
+    tb_aiop_aico_wait_t* wait = tb_aiop_aico_wait(aico, aice);
+
     // remove task
-    if (aico->task) 
+    if (wait->task) 
     {
-        if (aico->bltimer) tb_ltimer_task_exit(impl->ltimer, aico->task);
-        else tb_timer_task_exit(impl->timer, aico->task);
-        aico->bltimer = 0;
+        // enter
+        tb_spinlock_enter(&aico->base.lock);
+
+        // exit task
+        if (wait->bltimer) tb_ltimer_task_exit(impl->ltimer, wait->task);
+        else tb_timer_task_exit(impl->timer, wait->task);
+        wait->bltimer = 0;
+        wait->task = tb_null;
+
+        // leave
+        tb_spinlock_leave(&aico->base.lock);
     }
-    aico->task = tb_null;
 
     // spak the killed aice if not closing
     if (tb_aico_impl_is_killed(&aico->base) && aice->code != TB_AICE_CODE_CLOS)
     {
         // clear waiting state if not accept
-        if (aice->code != TB_AICE_CODE_ACPT)
-        {
-            aico->waiting = 0;
-            aico->aice.code = TB_AICE_CODE_NONE;
-        }
+        if (aice->code != TB_AICE_CODE_ACPT) tb_aiop_aico_done(impl, aico, aice);
 
         // save state
         aice->state = TB_STATE_KILLED;
@@ -1279,11 +1612,7 @@ static tb_long_t tb_aiop_spak_done(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice
     if (aice->state != TB_STATE_PENDING)
     {
         // clear waiting state if not accept
-        if (aice->code != TB_AICE_CODE_ACPT)
-        {
-            aico->waiting = 0;
-            aico->aice.code = TB_AICE_CODE_NONE;
-        }
+        if (aice->code != TB_AICE_CODE_ACPT) tb_aiop_aico_done(impl, aico, aice);
 
         // ok
         return 1;
@@ -1340,20 +1669,34 @@ static tb_void_t tb_aiop_spak_klist(tb_aiop_ptor_impl_t* impl)
             // sock?
             if (aico->type == TB_AICO_TYPE_SOCK) 
             {
-                // add it first if do not exists timeout task
-                if (!aiop_aico->task) 
-                {
-                    aiop_aico->task = tb_ltimer_task_init(impl->ltimer, 10000, tb_false, tb_aiop_spak_wait_timeout, aico);
-                    aiop_aico->bltimer = 1;
-                }
+                // enter
+                tb_spinlock_enter(&aico->lock);
 
-                // kill the task
-                if (aiop_aico->task) 
+                // kill the recv and send wait
+                tb_size_t i = 0;
+                for (i = 0; i < tb_arrayn(aiop_aico->wait); i++)
                 {
-                    // kill task
-                    if (aiop_aico->bltimer) tb_ltimer_task_kill(impl->ltimer, aiop_aico->task);
-                    else tb_timer_task_kill(impl->timer, aiop_aico->task);
+                    // the wait
+                    tb_aiop_aico_wait_t* wait = &aiop_aico->wait[i];
+
+                    // add it first if do not exists timeout task
+                    if (!wait->task && wait->waiting) 
+                    {
+                        wait->task = tb_ltimer_task_init(impl->ltimer, 10000, tb_false, tb_aiop_spak_wait_timeout, wait);
+                        wait->bltimer = 1;
+                    }
+
+                    // kill the task
+                    if (wait->task) 
+                    {
+                        // kill task
+                        if (wait->bltimer) tb_ltimer_task_kill(impl->ltimer, wait->task);
+                        else tb_timer_task_kill(impl->timer, wait->task);
+                    }
                 }
+
+                // leave
+                tb_spinlock_leave(&aico->lock);
             }
             else if (aico->type == TB_AICO_TYPE_FILE)
             {
@@ -1477,6 +1820,18 @@ static tb_bool_t tb_aiop_ptor_post(tb_aicp_ptor_impl_t* ptor, tb_aice_ref_t aice
     case TB_AICO_TYPE_SOCK:
     case TB_AICO_TYPE_TASK:
         {
+            /* post it to the recv or send wait of the sock
+             *
+             * the send aice will be queued to the send chain if the previous send aice is pending
+             */
+            tb_long_t post = 1;
+            if (aico->type == TB_AICO_TYPE_SOCK && (post = tb_aiop_aico_post(impl, (tb_aiop_aico_t*)aico, aice)) <= 0)
+            {
+                // queued or failed?
+                ok = post? tb_false : tb_true;
+                break;
+            }
+
             // enter 
             tb_spinlock_enter(&impl->lock);
 
@@ -1500,6 +1855,9 @@ static tb_bool_t tb_aiop_ptor_post(tb_aicp_ptor_impl_t* ptor, tb_aice_ref_t aice
 
             // leave 
             tb_spinlock_leave(&impl->lock);
+
+            // failed? reset wait
+            if (!ok && aico->type == TB_AICO_TYPE_SOCK) tb_aiop_aico_done(impl, (tb_aiop_aico_t*)aico, aice);
         }
         break;
     case TB_AICO_TYPE_FILE:
@@ -1566,8 +1924,10 @@ static tb_void_t tb_aiop_ptor_exit(tb_aicp_ptor_impl_t* ptor)
     tb_spinlock_enter(&impl->lock);
     if (impl->spak[0]) tb_queue_exit(impl->spak[0]);
     if (impl->spak[1]) tb_queue_exit(impl->spak[1]);
+    if (impl->done) tb_queue_exit(impl->done);
     impl->spak[0] = tb_null;
     impl->spak[1] = tb_null;
+    impl->done = tb_null;
     tb_spinlock_leave(&impl->lock);
 
     // exit kill
@@ -1618,10 +1978,11 @@ static tb_long_t tb_aiop_ptor_spak(tb_aicp_ptor_impl_t* ptor, tb_handle_t loop,
     // done
     tb_long_t ok = -1;
     tb_bool_t null = tb_false;
+    tb_bool_t done = tb_false;
     do
     {
         // check
-        tb_assert_and_check_break(impl->spak[0] && impl->spak[1]);
+        tb_assert_and_check_break(impl->spak[0] && impl->spak[1] && impl->done);
 
         // clear ok
         ok = 0;
@@ -1647,6 +2008,28 @@ static tb_long_t tb_aiop_ptor_spak(tb_aicp_ptor_impl_t* ptor, tb_handle_t loop,
             }
         }
 
+        // no aice? spak the done aice of the send chain
+        if (!ok && !tb_queue_null(impl->done))
+        {
+            // get resp
+            tb_aice_ref_t aice = tb_queue_get(impl->done);
+            if (aice) 
+            {
+                // save resp
+                *resp = *aice;
+
+                // trace
+                tb_trace_d("spak[%u]: code: %lu, done, size: %lu", (tb_uint16_t)tb_thread_self(), aice->code, tb_queue_size(impl->done));
+
+                // pop it
+                tb_queue_pop(impl->done);
+
+                // ok, need not spak it again
+                ok = 1;
+                done = tb_true;
+            }
+        }
+
         // no aice? spak aice from the lower priority spak next
         if (!ok && !(null = tb_queue_null(impl->spak[1]))) 
         {
@@ -1674,7 +2057,7 @@ static tb_long_t tb_aiop_ptor_spak(tb_aicp_ptor_impl_t* ptor, tb_handle_t loop,
     tb_spinlock_leave(&impl->lock);
 
     // done it
-    if (ok) ok = tb_aiop_spak_done(impl, resp);
+    if (ok && !done) ok = tb_aiop_spak_done(impl, resp);
 
     // null? wait it
     tb_check_return_val(!ok && null, ok);
@@ -1717,6 +2100,8 @@ static tb_aicp_ptor_impl_t* tb_aiop_ptor_init(tb_aicp_impl_t* aicp)
         // init base
         impl->base.aicp         = aicp;
         impl->base.step         = sizeof(tb_aiop_aico_t);
+        impl->base.duplex       = tb_true;
+        impl->base.rpool        = tb_true;
         impl->base.kill         = tb_aiop_ptor_kill;
         impl->base.exit         = tb_aiop_ptor_exit;
         impl->base.addo         = tb_aiop_ptor_addo;
@@ -1743,6 +2128,10 @@ static tb_aicp_ptor_impl_t* tb_aiop_ptor_init(tb_aicp_impl_t* aicp)
         impl->spak[1] = tb_queue_init((aicp->maxn >> 4) + 16, tb_element_mem(sizeof(tb_aice_t), tb_null, tb_null));
         tb_assert_and_check_break(impl->spak[0] && impl->spak[1]);
 
+        // init done
+        impl->done = tb_queue_init((aicp->maxn >> 4) + 16, tb_element_mem(sizeof(tb_aice_t), tb_null, tb_null));
+        tb_assert_and_check_break(impl->done);
+
         // init file
         if (!tb_aicp_file_init(impl)) break;
 
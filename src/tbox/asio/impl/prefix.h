@@ -83,6 +83,12 @@ typedef struct __tb_aico_impl_t
     // the timeout for aice
     tb_atomic_t                 timeout[TB_AICO_TIMEOUT_MAXN];
 
+    // the pending aice count, the recv and send aice may be pending at the same time for the duplex sock
+    tb_size_t                   pending;
+
+    // the lock for the pending count and the waiting state of the proactor
+    tb_spinlock_t               lock;
+
 #ifdef __tb_debug__
     // the func
     tb_char_t const*            func;
@@ -106,6 +112,12 @@ typedef struct __tb_aicp_ptor_impl_t
     // the aico step
     tb_size_t                   step;
 
+    // the recv and send aice can be pending at the same time for the sock?
+    tb_bool_t                   duplex;
+
+    // the recv buffer can be allocated from the recv buffer pool after the data is arrived?
+    tb_bool_t                   rpool;
+
     // kill
     tb_void_t                   (*kill)(struct __tb_aicp_ptor_impl_t* ptor);
 
@@ -186,6 +198,15 @@ typedef struct __tb_aicp_impl_t
     // killall it?
     tb_atomic_t                 kill_all;
 
+    // the recv buffer pool
+    tb_fixed_pool_ref_t         rpool;
+
+    // the recv buffer size
+    tb_size_t                   rsize;
+
+    // the recv buffer pool lock
+    tb_spinlock_t               rlock;
+
 }tb_aicp_impl_t;
 
 // the aiop impl type 
@@ -242,6 +263,27 @@ static __tb_inline__ tb_bool_t tb_aico_impl_is_killed(tb_aico_impl_t* aico)
     // killing or exiting or killed?
     return (state == TB_STATE_KILLING) || (state == TB_STATE_KILLED);
 }
+static __tb_inline__ tb_byte_t* tb_aicp_impl_rpool_malloc(tb_aicp_impl_t* aicp, tb_size_t* psize)
+{
+    // check
+    tb_assert_and_check_return_val(aicp && aicp->rpool && psize, tb_null);
+
+    // make buffer
+    tb_spinlock_enter(&aicp->rlock);
+    tb_byte_t* data = (tb_byte_t*)tb_fixed_pool_malloc(aicp->rpool);
+    tb_spinlock_leave(&aicp->rlock);
+
+    // save size
+    *psize = data? aicp->rsize : 0;
+
+    // ok?
+    return data;
+}
+static __tb_inline__ tb_bool_t tb_aice_impl_is_duplex(tb_size_t code)
+{
+    // the recv and send aice for sock
+    return code >= TB_AICE_CODE_RECV && code <= TB_AICE_CODE_SENDF;
+}
 static __tb_inline__ tb_size_t tb_aice_impl_priority(tb_aice_ref_t aice)
 {
     // the priorities
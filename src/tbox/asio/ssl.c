@@ -188,6 +188,9 @@ typedef struct __tb_aicp_ssl_impl_t
     // the timeout
     tb_long_t                   timeout;
 
+    // enable the kernel tls offload?
+    tb_bool_t                   bktls;
+
     /* the state
      *
      * TB_STATE_CLOSED
@@ -374,6 +377,10 @@ static tb_bool_t tb_aicp_ssl_open_func(tb_aicp_ssl_impl_t* impl, tb_size_t state
     tb_bool_t ok = tb_true;
     if (state == TB_STATE_OK || !impl->aico) 
     {
+        // offload the record layer to the kernel tls if be enabled
+        if (state == TB_STATE_OK && impl->bktls && impl->aico && impl->ssl) 
+            tb_ssl_ktls_enable(impl->ssl, tb_aico_sock(impl->aico));
+
         // opened
         tb_atomic_set(&impl->state, TB_STATE_OPENED);
 
@@ -665,6 +672,42 @@ static tb_bool_t tb_aicp_ssl_writ_done(tb_aice_ref_t aice)
     // ok
     return tb_true;
 }
+static tb_bool_t tb_aicp_ssl_ktls_read_done(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_RECV, tb_false);
+
+    // the impl
+    tb_aicp_ssl_impl_t* impl = (tb_aicp_ssl_impl_t*)aice->priv;
+    tb_assert_and_check_return_val(impl && impl->func.read.func, tb_false);
+
+    // trace
+    tb_trace_d("[aico:%p]: read: ktls: done: real: %lu, state: %s", impl->aico, aice->u.recv.real, tb_state_cstr(aice->state));
+
+    // done func, the data has been decrypted by the kernel
+    impl->func.read.func((tb_aicp_ssl_ref_t)impl, aice->state, impl->func.read.data, aice->u.recv.real, impl->func.read.size, impl->func.read.priv);
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_aicp_ssl_ktls_writ_done(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_SEND, tb_false);
+
+    // the impl
+    tb_aicp_ssl_impl_t* impl = (tb_aicp_ssl_impl_t*)aice->priv;
+    tb_assert_and_check_return_val(impl && impl->func.writ.func, tb_false);
+
+    // trace
+    tb_trace_d("[aico:%p]: writ: ktls: done: real: %lu, state: %s", impl->aico, aice->u.send.real, tb_state_cstr(aice->state));
+
+    // done func, the data will be encrypted by the kernel
+    impl->func.writ.func((tb_aicp_ssl_ref_t)impl, aice->state, impl->func.writ.data, aice->u.send.real, impl->func.writ.size, impl->func.writ.priv);
+
+    // ok
+    return tb_true;
+}
 static tb_long_t tb_aicp_ssl_read_func(tb_cpointer_t priv, tb_byte_t* data, tb_size_t size)
 {
     // check
@@ -964,6 +1007,27 @@ tb_void_t tb_aicp_ssl_set_aico(tb_aicp_ssl_ref_t ssl, tb_aico_ref_t aico)
     // save aico
     impl->aico = aico;
 }
+tb_void_t tb_aicp_ssl_set_peer(tb_aicp_ssl_ref_t ssl, tb_char_t const* host, tb_uint16_t port)
+{
+    // check
+    tb_aicp_ssl_impl_t* impl = (tb_aicp_ssl_impl_t*)ssl;
+    tb_assert_and_check_return(impl && impl->ssl);
+
+    // set peer
+    tb_ssl_set_peer(impl->ssl, host, port);
+}
+tb_void_t tb_aicp_ssl_set_ktls(tb_aicp_ssl_ref_t ssl, tb_bool_t enable)
+{
+    // check
+    tb_aicp_ssl_impl_t* impl = (tb_aicp_ssl_impl_t*)ssl;
+    tb_assert_and_check_return(impl && impl->ssl);
+
+    // save it
+    impl->bktls = enable;
+
+    // limit the negotiated version for offloading
+    tb_ssl_set_ktls(impl->ssl, enable);
+}
 tb_void_t tb_aicp_ssl_set_timeout(tb_aicp_ssl_ref_t ssl, tb_long_t timeout)
 {
     // check
@@ -1170,6 +1234,21 @@ tb_bool_t tb_aicp_ssl_read_after(tb_aicp_ssl_ref_t ssl, tb_size_t delay, tb_byte
         impl->func.read.data     = data;
         impl->func.read.size     = size;
 
+        // the receiving has been offloaded? post the plain recv aice directly
+        if (tb_ssl_ktls(impl->ssl) & TB_SSL_KTLS_RECV)
+        {
+            // post it
+            if (!tb_aico_recv_after(impl->aico, delay, data, size, tb_aicp_ssl_ktls_read_done, impl))
+            {
+                // trace
+                tb_trace_e("[aico:%p]: read: ktls: post failed!", impl->aico);
+        
+                // done func
+                func(ssl, TB_STATE_SOCK_SSL_UNKNOWN_ERROR, data, 0, size, priv);
+            }
+            break;
+        }
+
         // init post
         impl->post.func  = tb_aicp_ssl_read_done;
         impl->post.delay = delay;
@@ -1247,6 +1326,21 @@ tb_bool_t tb_aicp_ssl_writ_after(tb_aicp_ssl_ref_t ssl, tb_size_t delay, tb_byte
         impl->func.writ.data     = data;
         impl->func.writ.size     = size;
 
+        // the sending has been offloaded? post the plain send aice directly
+        if (tb_ssl_ktls(impl->ssl) & TB_SSL_KTLS_SEND)
+        {
+            // post it
+            if (!tb_aico_send_after(impl->aico, delay, data, size, tb_aicp_ssl_ktls_writ_done, impl))
+            {
+                // trace
+                tb_trace_e("[aico:%p]: writ: ktls: post failed!", impl->aico);
+        
+                // done func
+                func(ssl, TB_STATE_SOCK_SSL_UNKNOWN_ERROR, data, 0, size, priv);
+            }
+            break;
+        }
+
         // init post
         impl->post.func  = tb_aicp_ssl_writ_done;
         impl->post.delay = delay;
@@ -1361,4 +1455,13 @@ tb_aicp_ref_t tb_aicp_ssl_aicp(tb_aicp_ssl_ref_t ssl)
     // the aicp
     return impl->aicp;
 }
+tb_size_t tb_aicp_ssl_ktls(tb_aicp_ssl_ref_t ssl)
+{
+    // check
+    tb_aicp_ssl_impl_t* impl = (tb_aicp_ssl_impl_t*)ssl;
+    tb_assert_and_check_return_val(impl && impl->ssl, TB_SSL_KTLS_NONE);
+
+    // the kernel tls mode
+    return tb_ssl_ktls(impl->ssl);
+}
 
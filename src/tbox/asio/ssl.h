@@ -131,6 +131,14 @@ tb_bool_t           tb_aicp_ssl_exit(tb_aicp_ssl_ref_t ssl);
  */
 tb_void_t           tb_aicp_ssl_set_aico(tb_aicp_ssl_ref_t ssl, tb_aico_ref_t aico);
 
+/*! set the ssl peer for resuming the last client session to it
+ * 
+ * @param ssl       the ssl
+ * @param host      the peer host
+ * @param port      the peer port
+ */
+tb_void_t           tb_aicp_ssl_set_peer(tb_aicp_ssl_ref_t ssl, tb_char_t const* host, tb_uint16_t port);
+
 /*! set the ssl timeout
  * 
  * @param ssl       the ssl
@@ -138,6 +146,19 @@ tb_void_t           tb_aicp_ssl_set_aico(tb_aicp_ssl_ref_t ssl, tb_aico_ref_t ai
  */
 tb_void_t           tb_aicp_ssl_set_timeout(tb_aicp_ssl_ref_t ssl, tb_long_t timeout);
 
+/*! enable the kernel tls offload after opening
+ *
+ * the negotiated keys will be installed into the socket if the kernel and cipher allow it, 
+ * and the offloaded directions will be read and written by the plain recv and send aice.
+ *
+ * the file can be sent by tb_aico_sendf directly with zero-copy if the sending has been offloaded,
+ * see tb_aicp_ssl_ktls()
+ * 
+ * @param ssl       the ssl
+ * @param enable    enable it?
+ */
+tb_void_t           tb_aicp_ssl_set_ktls(tb_aicp_ssl_ref_t ssl, tb_bool_t enable);
+
 /*! open the ssl 
  *
  * @param ssl       the ssl
@@ -259,6 +280,14 @@ tb_bool_t           tb_aicp_ssl_open_writ(tb_aicp_ssl_ref_t ssl, tb_byte_t const
  */
 tb_aicp_ref_t       tb_aicp_ssl_aicp(tb_aicp_ssl_ref_t ssl);
 
+/*! the kernel tls mode of the opened ssl
+ *
+ * @param ssl       the ssl
+ *
+ * @return          the offloaded mode, see tb_ssl_ktls_e
+ */
+tb_size_t           tb_aicp_ssl_ktls(tb_aicp_ssl_ref_t ssl);
+
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -32,6 +32,7 @@
  * includes
  */
 #include "bloom_filter.h"
+#include "element/hash.h"
 #include "../libc/libc.h"
 #include "../libm/libm.h"
 #include "../math/math.h"
@@ -94,6 +95,23 @@ typedef struct __tb_bloom_filter_impl_t
 
 }tb_bloom_filter_impl_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+
+/* compute the bit index of the given hash func index
+ *
+ * we only compute two hashes and derive others from them (double hashing):
+ *
+ * hash(i) = h0 + i * h1
+ */
+static __tb_inline__ tb_size_t tb_bloom_filter_index(tb_bloom_filter_impl_t* filter, tb_size_t h0, tb_size_t h1, tb_size_t i)
+{
+    tb_size_t index = (h0 + i * h1) & filter->mask;
+    if (index >= (filter->size << 3)) index %= (filter->size << 3);
+    return index;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -125,6 +143,7 @@ tb_bloom_filter_ref_t tb_bloom_filter_init(tb_size_t probability, tb_size_t hash
     
         // init filter
         filter->element     = element;
+        if (!filter->element.seed) filter->element.seed = tb_element_hash_seed();
         filter->maxn        = item_maxn;
         filter->hash_count  = hash_count;
         filter->probability = probability;
@@ -252,11 +271,12 @@ tb_bool_t tb_bloom_filter_set(tb_bloom_filter_ref_t handle, tb_cpointer_t data)
     tb_size_t i = 0;
     tb_size_t n = filter->hash_count;
     tb_bool_t ok = tb_false;
+    tb_size_t h0 = filter->element.hash(&filter->element, data, filter->mask, 0);
+    tb_size_t h1 = n > 1? (filter->element.hash(&filter->element, data, filter->mask, 1) | 1) : 0;
     for (i = 0; i < n; i++)
     {
         // compute the bit index
-        tb_size_t index = filter->element.hash(&filter->element, data, filter->mask, i);
-        if (index >= (filter->size << 3)) index %= (filter->size << 3);
+        tb_size_t index = tb_bloom_filter_index(filter, h0, h1, i);
 
         // not exists? 
         if (!tb_bloom_filter_bset(filter->data, index)) 
@@ -281,11 +301,12 @@ tb_bool_t tb_bloom_filter_get(tb_bloom_filter_ref_t handle, tb_cpointer_t data)
     // walk
     tb_size_t i = 0;
     tb_size_t n = filter->hash_count;
+    tb_size_t h0 = filter->element.hash(&filter->element, data, filter->mask, 0);
+    tb_size_t h1 = n > 1? (filter->element.hash(&filter->element, data, filter->mask, 1) | 1) : 0;
     for (i = 0; i < n; i++)
     {
         // compute the bit index
-        tb_size_t index = filter->element.hash(&filter->element, data, filter->mask, i);
-        if (index >= (filter->size << 3)) index %= (filter->size << 3);
+        tb_size_t index = tb_bloom_filter_index(filter, h0, h1, i);
 
         // not exists? break it
         if (!tb_bloom_filter_bset(filter->data, index)) break;
@@ -43,5 +43,8 @@
 #include "single_list.h"
 #include "single_list_entry.h"
 #include "bloom_filter.h"
+#include "radix_tree.h"
+#include "tree_set.h"
+#include "tree_map.h"
 
 #endif
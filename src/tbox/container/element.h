@@ -195,6 +195,9 @@ typedef struct __tb_element_t
     /// the priv data
     tb_cpointer_t               priv;
 
+    /// the hash seed, the hash container will make a random seed if it is zero
+    tb_size_t                   seed;
+
     /// the hash function
     tb_element_hash_func_t      hash;
 
@@ -316,6 +319,14 @@ tb_element_t        tb_element_obj(tb_noarg_t);
  */
 tb_element_t        tb_element_mem(tb_size_t size, tb_element_free_func_t free, tb_cpointer_t priv);
 
+/*! make a random hash seed for the element
+ *
+ * @note the hash container will set it automatically if the element seed is zero
+ *
+ * @return          the hash seed
+ */
+tb_size_t           tb_element_hash_seed(tb_noarg_t);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -26,251 +26,138 @@
 #include "hash.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
- * data hash implementation
+ * macros
  */
-static tb_size_t tb_element_hash_data_func_0(tb_byte_t const* data, tb_size_t size)
-{
-    // bkdr-hash
-    tb_size_t           v = 0;  
-    tb_byte_t const*    p = data;
-    tb_byte_t const*    e = data + size;
-    while (p < e) v = (v * 131313) + (*p++);  
-    return v;
-}
-static tb_size_t tb_element_hash_data_func_1(tb_byte_t const* data, tb_size_t size)
-{
-    // from stl string
-    tb_size_t           v = 2166136261ul;
-    tb_byte_t const*    p = data;
-    tb_byte_t const*    e = data + size;
-    while (p < e) v = 16777619 * v ^ (tb_size_t)(*p++);
-    return v;
-}
-#ifdef __tb_small__
-static tb_size_t tb_element_hash_data_func_2(tb_byte_t const* data, tb_size_t size)
-{
-    // fnv-1a-hash
-    tb_size_t           v = size; v ^= 2166136261ul;
-    tb_byte_t const*    p = data;
-    tb_byte_t const*    e = data + size;
-    while (p < e) 
-    {
-        v ^= *p++;
-        v *= 16777619;
-    }
-    return v;
-}
-#else
-static tb_size_t tb_element_hash_data_func_2(tb_byte_t const* data, tb_size_t size)
-{
-    // Blizzard One-Way Hash algorithm from MPQ
-    // make table
-    static tb_size_t s_make = 0;
-    static tb_size_t s_table[1280];
-    if (!s_make)
-    {
-        tb_size_t i = 0;  
-        tb_size_t index1 = 0;
-        tb_size_t index2 = 0;
-        tb_size_t seed = 0x00100001;
-        for (index1 = 0; index1 < 0x100; index1++)  
-        {   
-            for (index2 = index1, i = 0; i < 5; i++, index2 += 0x100)  
-            {   
-                seed = (seed * 125 + 3) % 0x2aaaab; tb_size_t temp1 = (seed & 0xffff) << 0x10;  
-                seed = (seed * 125 + 3) % 0x2aaaab; tb_size_t temp2 = (seed & 0xffff);
-                s_table[index2] = (temp1 | temp2);   
-            }   
-        }
 
-        // ok
-        s_make = 1;
-    }
+// the secrets of the data hash
+#define TB_ELEMENT_HASH_P0                  (0xa0761d6478bd642fULL)
+#define TB_ELEMENT_HASH_P1                  (0xe7037ed1a0b428dbULL)
+#define TB_ELEMENT_HASH_P2                  (0x8ebc6af09c88c6e3ULL)
+#define TB_ELEMENT_HASH_P3                  (0x589965cc75374cc3ULL)
 
-    // done
-    tb_size_t           b = 0;  
-    tb_byte_t const*    p = data;
-    tb_byte_t const*    e = data + size;
-    tb_size_t           seed1 = 0x7fed7fed;  
-    tb_size_t           seed2 = 0Xeeeeeeee;  
-    while (p < e)
-    {
-        b = *p++;  
+// the chunk size of the case-insensitive cstring hash
+#define TB_ELEMENT_HASH_CSTRI_CHUNK         (256)
 
-        // 0 << 8: hash type: 0
-        // 1 << 8: hash type: 1
-        // 2 << 8: hash type: 2
-        seed1 = s_table[(1 << 8) + b] ^ (seed1 + seed2);  
-        seed2 = b + seed1 + seed2 + (seed2 << 5) + 3;  
-    }
+// read the little-endian words
+#define tb_element_hash_r8(p)               ((tb_uint64_t)tb_bits_get_u64_le(p))
+#define tb_element_hash_r4(p)               ((tb_uint64_t)tb_bits_get_u32_le(p))
 
-    // ok
-    return seed1;  
-}
-static tb_size_t tb_element_hash_data_func_3(tb_byte_t const* data, tb_size_t size)
-{
-    // fnv-1a-hash
-    tb_size_t           v = size; v ^= 2166136261ul;
-    tb_byte_t const*    p = data;
-    tb_byte_t const*    e = data + size;
-    while (p < e) 
-    {
-        v ^= *p++;
-        v *= 16777619;
-    }
-    return v;
-}
-static tb_size_t tb_element_hash_data_func_4(tb_byte_t const* data, tb_size_t size)
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the seed count
+static tb_atomic_t  g_seed_count = 0;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * data hash implementation
+ */
+
+// the 64x64 => 128 bits multiplication, a: the low 64-bits, b: the high 64-bits
+static __tb_inline__ tb_void_t tb_element_hash_mum(tb_uint64_t* a, tb_uint64_t* b)
 {
-    // one-byte-at-a-time hash based on Murmur's mix
-    tb_size_t           v = size;
-    tb_byte_t const*    p = data;
-    tb_byte_t const*    e = data + size;
-    while (p < e) 
-    {
-        v ^= *p++;
-        v *= 0x5bd1e995;
-        v ^= v >> 15;
-    }
-    return v;
+#if defined(TB_COMPILER_IS_GCC) && defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t)*a * *b;
+    *a = (tb_uint64_t)r;
+    *b = (tb_uint64_t)(r >> 64);
+#else
+    tb_uint64_t ha = *a >> 32;
+    tb_uint64_t hb = *b >> 32;
+    tb_uint64_t la = (tb_uint32_t)*a;
+    tb_uint64_t lb = (tb_uint32_t)*b;
+    tb_uint64_t rh = ha * hb;
+    tb_uint64_t rm0 = ha * lb;
+    tb_uint64_t rm1 = hb * la;
+    tb_uint64_t rl = la * lb;
+    tb_uint64_t t = rl + (rm0 << 32);
+    tb_uint64_t c = t < rl;
+    tb_uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
 }
-static tb_size_t tb_element_hash_data_func_5(tb_byte_t const* data, tb_size_t size)
+static __tb_inline__ tb_uint64_t tb_element_hash_mix(tb_uint64_t a, tb_uint64_t b)
 {
-    return tb_crc_encode(TB_CRC_MODE_32_IEEE_LE, 0, data, size);
+    tb_element_hash_mum(&a, &b);
+    return a ^ b;
 }
-static tb_size_t tb_element_hash_data_func_6(tb_byte_t const* data, tb_size_t size)
+
+/* the word-at-a-time data hash (wyhash) 
+ *
+ * it makes one 128-bits result and we derive the hash of the given index from it:
+ *
+ * hash(index) = h1 + index * h2
+ */
+static tb_size_t tb_element_hash_data_func(tb_byte_t const* p, tb_size_t size, tb_uint64_t seed, tb_size_t index)
 {
-    // fnv-1-hash
-    tb_size_t           v = 0;  
-    tb_byte_t const*    p = data;
-    tb_byte_t const*    e = data + size;
-    while (p < e) 
+    // init seed
+    tb_uint64_t a;
+    tb_uint64_t b;
+    seed ^= tb_element_hash_mix(seed ^ TB_ELEMENT_HASH_P0, TB_ELEMENT_HASH_P1);
+
+    // the short data
+    if (size <= 16)
     {
-        v *= 0x811C9DC5;  
-        v ^= (*p++);  
-    }  
-    return v;  
-}
-static tb_size_t tb_element_hash_data_func_7(tb_byte_t const* data, tb_size_t size)
-{
-    // ap-hash
-    tb_size_t           v = 0xAAAAAAAA;  
-    tb_size_t           i = 0;
-    tb_byte_t const*    p = data;
-    for (i = 0; i < size; i++, p++) 
-    {  
-        v ^= (!(i & 1)) ? ((v << 7) ^ ((*p) * (v >> 3))) : (~(((v << 11) + (*p)) ^ (v >> 5)));  
+        if (size >= 4)
+        {
+            tb_size_t o = (size >> 3) << 2;
+            a = (tb_element_hash_r4(p) << 32) | tb_element_hash_r4(p + o);
+            b = (tb_element_hash_r4(p + size - 4) << 32) | tb_element_hash_r4(p + size - 4 - o);
+        }
+        else if (size)
+        {
+            a = ((tb_uint64_t)p[0] << 16) | ((tb_uint64_t)p[size >> 1] << 8) | p[size - 1];
+            b = 0;
+        }
+        else a = b = 0;
     }
-    return v;  
-}
-static tb_size_t tb_element_hash_data_func_8(tb_byte_t const* data, tb_size_t size)
-{
-    // MurmurHash2A, by Austin Appleby
-    tb_uint32_t const   m = 0x5bd1e995;
-    tb_uint32_t const   r = 24;
-    tb_uint32_t         l = size;
-    tb_size_t           v = 2166136261ul;
-
-#define mmix(v,k) { k *= m; k ^= k >> r; k *= m; v *= m; v ^= k; }
-    while (size >= 4)
+    // the long data
+    else
     {
-        tb_uint32_t k = tb_bits_get_u32_ne(data);
-        mmix(v, k);
+        tb_size_t i = size;
+        if (i > 48)
+        {
+            // three independent lanes
+            tb_uint64_t see1 = seed;
+            tb_uint64_t see2 = seed;
+            do
+            {
+                seed = tb_element_hash_mix(tb_element_hash_r8(p) ^ TB_ELEMENT_HASH_P1, tb_element_hash_r8(p + 8) ^ seed);
+                see1 = tb_element_hash_mix(tb_element_hash_r8(p + 16) ^ TB_ELEMENT_HASH_P2, tb_element_hash_r8(p + 24) ^ see1);
+                see2 = tb_element_hash_mix(tb_element_hash_r8(p + 32) ^ TB_ELEMENT_HASH_P3, tb_element_hash_r8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16)
+        {
+            seed = tb_element_hash_mix(tb_element_hash_r8(p) ^ TB_ELEMENT_HASH_P1, tb_element_hash_r8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
 
-        data += 4;
-        size -= 4;
+        // the last 16 bytes, may overlap with the previous block
+        a = tb_element_hash_r8(p + i - 16);
+        b = tb_element_hash_r8(p + i - 8);
     }
 
-    tb_uint32_t t = 0;
-    switch (size)
-    {
-    case 3: t ^= data[2] << 16;
-    case 2: t ^= data[1] << 8;
-    case 1: t ^= data[0];
-    };
-
-    mmix(v, t);
-    mmix(v, l);
+    // make the 128-bits result
+    a ^= TB_ELEMENT_HASH_P1;
+    b ^= seed;
+    tb_element_hash_mum(&a, &b);
+    a ^= TB_ELEMENT_HASH_P0 ^ (tb_uint64_t)size;
+    b ^= TB_ELEMENT_HASH_P1;
+    tb_element_hash_mum(&a, &b);
 
-    v ^= v >> 13;
-    v *= m;
-    v ^= v >> 15;
+    // h1
+    tb_uint64_t h = a ^ b;
+    tb_check_return_val(index, (tb_size_t)h);
 
-    return v;
-}
-static tb_size_t tb_element_hash_data_func_9(tb_byte_t const* data, tb_size_t size)
-{
-    // rs-hash
-    tb_size_t           v = 0;  
-    tb_size_t           b = 378551;  
-    tb_size_t           a = 63689;  
-    tb_byte_t const*    p = data;
-    tb_byte_t const*    e = data + size;
-    while (p < e)
-    {  
-        v = v * a + (*p++);  
-        a = a * b;  
-    }  
-    return v;
-}
-static tb_size_t tb_element_hash_data_func_10(tb_byte_t const* data, tb_size_t size)
-{
-    // sdbm-hash
-    tb_size_t           v = 0;  
-    tb_byte_t const*    p = data;
-    tb_byte_t const*    e = data + size;
-    while (p < e) v = (*p++) + (v << 6) + (v << 16) - v;  
-    return v;
-}
-static tb_size_t tb_element_hash_data_func_11(tb_byte_t const* data, tb_size_t size)
-{
-    // using md5, better but too slower
-    tb_byte_t b[16] = {0};
-    tb_md5_encode(data, size, b, 16);
-    return tb_bits_get_u32_ne(b);
-}
-static tb_size_t tb_element_hash_data_func_12(tb_byte_t const* data, tb_size_t size)
-{
-    // using sha, better but too slower
-    tb_byte_t b[32] = {0};
-    tb_sha_encode(TB_SHA_MODE_SHA1_160, data, size, b, 32);
-    return tb_bits_get_u32_ne(b);
-}
-static tb_size_t tb_element_hash_data_func_13(tb_byte_t const* data, tb_size_t size)
-{
-    tb_trace_noimpl();
-    return 0;
-}
-static tb_size_t tb_element_hash_data_func_14(tb_byte_t const* data, tb_size_t size)
-{
-    tb_trace_noimpl();
-    return 0;
-}
-static tb_size_t tb_element_hash_data_func_15(tb_byte_t const* data, tb_size_t size)
-{
-    tb_trace_noimpl();
-    return 0;
-}
-#endif
-
-/* //////////////////////////////////////////////////////////////////////////////////////
- * cstr hash implementation
- */
-static tb_size_t tb_element_hash_cstr_func_0(tb_char_t const* data)
-{
-    // bkdr-hash
-    tb_size_t           v = 0;  
-    tb_byte_t const*    p = (tb_byte_t const*)data;
-    while (*p) v = (v * 131313) + (*p++);  
-    return v;
-}
-static tb_size_t tb_element_hash_cstr_func_1(tb_char_t const* data)
-{
-    // from stl string
-    tb_size_t           v = 2166136261ul;
-    tb_byte_t const*    p = (tb_byte_t const*)data;
-    while (*p) v = 16777619 * v ^ (tb_size_t)(*p++);
-    return v;
+    // h1 + index * h2, h2 must be odd for the power of two mask
+    return (tb_size_t)(h + (tb_uint64_t)index * (tb_element_hash_mix(a ^ TB_ELEMENT_HASH_P2, b ^ TB_ELEMENT_HASH_P3) | 1));
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -403,7 +290,7 @@ tb_size_t tb_element_hash_uint32(tb_uint32_t value, tb_size_t mask, tb_size_t in
     }
 
     // done
-    return tb_element_hash_data((tb_byte_t const*)&value, sizeof(tb_uint32_t), mask, index - 3);
+    return tb_element_hash_data((tb_byte_t const*)&value, sizeof(tb_uint32_t), 0, mask, index - 3);
 }
 tb_size_t tb_element_hash_uint64(tb_uint64_t value, tb_size_t mask, tb_size_t index)
 {
@@ -426,58 +313,56 @@ tb_size_t tb_element_hash_uint64(tb_uint64_t value, tb_size_t mask, tb_size_t in
     tb_size_t hash1 = tb_element_hash_uint32((tb_uint32_t)(value >> 32), mask, index);
     return ((hash0 ^ hash1) & mask);
 }
-tb_size_t tb_element_hash_data(tb_byte_t const* data, tb_size_t size, tb_size_t mask, tb_size_t index)
+tb_size_t tb_element_hash_data(tb_byte_t const* data, tb_size_t size, tb_size_t seed, tb_size_t mask, tb_size_t index)
 {
     // check
     tb_assert_and_check_return_val(data && size && mask, 0);
 
-    // the func
-    static tb_size_t (*s_func[])(tb_byte_t const* , tb_size_t) = 
-    {
-        tb_element_hash_data_func_0
-    ,   tb_element_hash_data_func_1
-    ,   tb_element_hash_data_func_2
-#ifndef __tb_small__
-    ,   tb_element_hash_data_func_3
-    ,   tb_element_hash_data_func_4
-    ,   tb_element_hash_data_func_5
-    ,   tb_element_hash_data_func_6
-    ,   tb_element_hash_data_func_7
-    ,   tb_element_hash_data_func_8
-    ,   tb_element_hash_data_func_9
-    ,   tb_element_hash_data_func_10
-    ,   tb_element_hash_data_func_11
-    ,   tb_element_hash_data_func_12
-    ,   tb_element_hash_data_func_13
-    ,   tb_element_hash_data_func_14
-    ,   tb_element_hash_data_func_15
-#endif
-    };
-    tb_assert_and_check_return_val(index < tb_arrayn(s_func), 0);
+    // done
+    return tb_element_hash_data_func(data, size, seed, index) & mask;
+}
+tb_size_t tb_element_hash_cstr(tb_char_t const* cstr, tb_size_t seed, tb_size_t mask, tb_size_t index)
+{
+    // check
+    tb_assert_and_check_return_val(cstr && mask, 0);
 
     // done
-    return s_func[index](data, size) & mask;
+    return tb_element_hash_data_func((tb_byte_t const*)cstr, tb_strlen(cstr), seed, index) & mask;
 }
-tb_size_t tb_element_hash_cstr(tb_char_t const* cstr, tb_size_t mask, tb_size_t index)
+tb_size_t tb_element_hash_cstri(tb_char_t const* cstr, tb_size_t seed, tb_size_t mask, tb_size_t index)
 {
     // check
     tb_assert_and_check_return_val(cstr && mask, 0);
 
-    // for optimization
-    if (index < 2)
+    // hash the lower case chunks and chain them with the seed
+    tb_byte_t           data[TB_ELEMENT_HASH_CSTRI_CHUNK];
+    tb_uint64_t         hash = seed;
+    tb_byte_t const*    p = (tb_byte_t const*)cstr;
+    do
     {
-        // the func
-        static tb_size_t (*s_func[])(tb_char_t const*) = 
+        // make the lower case chunk
+        tb_size_t n = 0;
+        while (n < sizeof(data) && *p) 
         {
-            tb_element_hash_cstr_func_0
-        ,   tb_element_hash_cstr_func_1
-        };
-        tb_assert_and_check_return_val(index < tb_arrayn(s_func), 0);
+            data[n++] = (tb_byte_t)tb_tolower(*p);
+            p++;
+        }
 
-        // done
-        return s_func[index](cstr) & mask;
-    }
+        // hash it, only the last chunk uses the given index
+        hash = tb_element_hash_data_func(data, n, hash, *p? 0 : index);
+
+    } while (*p);
 
-    // using the data hash
-    return tb_element_hash_data((tb_byte_t const*)cstr, tb_strlen(cstr), mask, index);
+    // ok
+    return (tb_size_t)hash & mask;
+}
+tb_size_t tb_element_hash_seed()
+{
+    /* make a different seed for each hash table
+     *
+     * mix the cycle counter, the monotonic clock, the address space layout and the seed count
+     */
+    tb_uint64_t a = tb_cycle() ^ ((tb_uint64_t)(tb_size_t)&g_seed_count << 16);
+    tb_uint64_t b = (tb_uint64_t)tb_nclock() ^ ((tb_uint64_t)tb_atomic_fetch_and_inc(&g_seed_count) * TB_ELEMENT_HASH_P3);
+    return (tb_size_t)tb_element_hash_mix(a ^ TB_ELEMENT_HASH_P1, b ^ TB_ELEMENT_HASH_P2);
 }
@@ -76,21 +76,34 @@ tb_size_t           tb_element_hash_uint64(tb_uint64_t value, tb_size_t mask, tb
  *
  * @param data      the data
  * @param size      the size
+ * @param seed      the hash seed
  * @param mask      the mask
  * @param index     the hash func index
  *
  * @return          the hash value
  */
-tb_size_t           tb_element_hash_data(tb_byte_t const* data, tb_size_t size, tb_size_t mask, tb_size_t index);
+tb_size_t           tb_element_hash_data(tb_byte_t const* data, tb_size_t size, tb_size_t seed, tb_size_t mask, tb_size_t index);
 
 /* compute the cstring hash 
  *
  * @param cstr      the cstring
+ * @param seed      the hash seed
  * @param mask      the mask
  * @param index     the hash func index
  *
  * @return          the hash value
  */
-tb_size_t           tb_element_hash_cstr(tb_char_t const* cstr, tb_size_t mask, tb_size_t index);
+tb_size_t           tb_element_hash_cstr(tb_char_t const* cstr, tb_size_t seed, tb_size_t mask, tb_size_t index);
+
+/* compute the cstring hash and ignore case
+ *
+ * @param cstr      the cstring
+ * @param seed      the hash seed
+ * @param mask      the mask
+ * @param index     the hash func index
+ *
+ * @return          the hash value
+ */
+tb_size_t           tb_element_hash_cstri(tb_char_t const* cstr, tb_size_t seed, tb_size_t mask, tb_size_t index);
 
 #endif
@@ -33,7 +33,11 @@
  */
 static tb_size_t tb_element_mem_hash(tb_element_ref_t element, tb_cpointer_t data, tb_size_t mask, tb_size_t index)
 {   
-    return tb_element_hash_data((tb_byte_t const*)data, element->size, mask, index);
+    // check
+    tb_assert_and_check_return_val(element && data, 0);
+
+    // hash it
+    return tb_element_hash_data((tb_byte_t const*)data, element->size, element->seed, mask, index);
 }
 static tb_long_t tb_element_mem_comp(tb_element_ref_t element, tb_cpointer_t ldata, tb_cpointer_t rdata)
 {
@@ -33,7 +33,11 @@
  */
 static tb_size_t tb_element_str_hash(tb_element_ref_t element, tb_cpointer_t data, tb_size_t mask, tb_size_t index)
 {
-    return tb_element_hash_cstr((tb_char_t const*)data, mask, index);
+    // check
+    tb_assert_and_check_return_val(element && data, 0);
+
+    // hash it, the case-insensitive string must be hashed with lower case
+    return element->flag? tb_element_hash_cstr((tb_char_t const*)data, element->seed, mask, index) : tb_element_hash_cstri((tb_char_t const*)data, element->seed, mask, index);
 }
 static tb_long_t tb_element_str_comp(tb_element_ref_t element, tb_cpointer_t ldata, tb_cpointer_t rdata)
 {
@@ -32,6 +32,7 @@
  * includes
  */
 #include "hash_map.h"
+#include "element/hash.h"
 #include "../libc/libc.h"
 #include "../math/math.h"
 #include "../utils/utils.h"
@@ -499,6 +500,7 @@ tb_hash_map_ref_t tb_hash_map_init(tb_size_t bucket_size, tb_element_t element_n
 
         // init hash_map func
         impl->element_name = element_name;
+        if (!impl->element_name.seed) impl->element_name.seed = tb_element_hash_seed();
         impl->element_data = element_data;
 
         // init item itor
@@ -0,0 +1,1231 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        radix_tree.c
+ * @ingroup     container
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "radix_tree"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "radix_tree.h"
+#include "../libc/libc.h"
+#include "../utils/utils.h"
+#include "../memory/memory.h"
+#include "../algorithm/algorithm.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the leaf is tagged by the lowest bit of the child pointer
+#define tb_radix_tree_is_leaf(p)            ((tb_size_t)(p) & 1)
+#define tb_radix_tree_leaf(p)               ((tb_radix_tree_leaf_t*)((tb_size_t)(p) & ~(tb_size_t)1))
+#define tb_radix_tree_leaf_tag(l)           ((tb_pointer_t)((tb_size_t)(l) | 1))
+
+// the leaf data and name
+#define tb_radix_tree_leaf_data(l)          ((tb_byte_t*)((l) + 1))
+#define tb_radix_tree_leaf_name(impl, l)    (tb_radix_tree_leaf_data(l) + (impl)->element_data.size)
+
+// the node prefix, it follows the node body
+#define tb_radix_tree_node_prefix(n)        ((tb_byte_t*)(n) + g_radix_tree_node_size[(n)->type])
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the node type
+typedef enum __tb_radix_tree_node_type_e
+{
+    TB_RADIX_TREE_NODE_4    = 0
+,   TB_RADIX_TREE_NODE_16   = 1
+,   TB_RADIX_TREE_NODE_48   = 2
+,   TB_RADIX_TREE_NODE_256  = 3
+
+}tb_radix_tree_node_type_e;
+
+// the node type
+typedef struct __tb_radix_tree_node_t
+{
+    // the node type
+    tb_uint8_t                      type;
+
+    // the children count
+    tb_uint16_t                     count;
+
+    // the prefix size of the compressed path
+    tb_uint32_t                     plen;
+
+}tb_radix_tree_node_t;
+
+// the node4 type, the keys are sorted
+typedef struct __tb_radix_tree_node4_t
+{
+    // the base
+    tb_radix_tree_node_t            base;
+
+    // the keys
+    tb_byte_t                       keys[4];
+
+    // the children
+    tb_pointer_t                    childs[4];
+
+}tb_radix_tree_node4_t;
+
+// the node16 type, the keys are sorted
+typedef struct __tb_radix_tree_node16_t
+{
+    // the base
+    tb_radix_tree_node_t            base;
+
+    // the keys
+    tb_byte_t                       keys[16];
+
+    // the children
+    tb_pointer_t                    childs[16];
+
+}tb_radix_tree_node16_t;
+
+// the node48 type
+typedef struct __tb_radix_tree_node48_t
+{
+    // the base
+    tb_radix_tree_node_t            base;
+
+    // the child slot index + 1 of the key, 0: no child
+    tb_byte_t                       index[256];
+
+    // the children, the slots [0, count) are used
+    tb_pointer_t                    childs[48];
+
+}tb_radix_tree_node48_t;
+
+// the node256 type
+typedef struct __tb_radix_tree_node256_t
+{
+    // the base
+    tb_radix_tree_node_t            base;
+
+    // the children
+    tb_pointer_t                    childs[256];
+
+}tb_radix_tree_node256_t;
+
+// the leaf type, the data and the name ('\0' included) follow it
+typedef struct __tb_radix_tree_leaf_t
+{
+    // the prev leaf in order
+    struct __tb_radix_tree_leaf_t*  prev;
+
+    // the next leaf in order
+    struct __tb_radix_tree_leaf_t*  next;
+
+    // the name size with '\0'
+    tb_size_t                       size;
+
+}tb_radix_tree_leaf_t;
+
+// the radix tree impl type
+typedef struct __tb_radix_tree_impl_t
+{
+    // the item itor
+    tb_iterator_t                   itor;
+
+    // the root node or leaf
+    tb_pointer_t                    root;
+
+    // the head leaf
+    tb_radix_tree_leaf_t*           head;
+
+    // the last leaf
+    tb_radix_tree_leaf_t*           last;
+
+    // the items count
+    tb_size_t                       size;
+
+    // the current item for iterator
+    tb_radix_tree_item_t            item;
+
+    // the element for data
+    tb_element_t                    element_data;
+
+}tb_radix_tree_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the node body sizes
+static tb_size_t const g_radix_tree_node_size[] =
+{
+    sizeof(tb_radix_tree_node4_t)
+,   sizeof(tb_radix_tree_node16_t)
+,   sizeof(tb_radix_tree_node48_t)
+,   sizeof(tb_radix_tree_node256_t)
+};
+
+// the node children maxn
+static tb_size_t const g_radix_tree_node_maxn[] = {4, 16, 48, 256};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * node implementation
+ */
+static tb_radix_tree_node_t* tb_radix_tree_node_init(tb_size_t type, tb_byte_t const* prefix, tb_size_t plen)
+{
+    // make node
+    tb_radix_tree_node_t* node = (tb_radix_tree_node_t*)tb_malloc0(g_radix_tree_node_size[type] + plen);
+    tb_assert_and_check_return_val(node, tb_null);
+
+    // init node
+    node->type = (tb_uint8_t)type;
+    node->plen = (tb_uint32_t)plen;
+    if (plen) tb_memcpy(tb_radix_tree_node_prefix(node), prefix, plen);
+    return node;
+}
+static tb_pointer_t* tb_radix_tree_node_child(tb_radix_tree_node_t* node, tb_byte_t key)
+{
+    switch (node->type)
+    {
+    case TB_RADIX_TREE_NODE_4:
+        {
+            tb_radix_tree_node4_t* n = (tb_radix_tree_node4_t*)node;
+            tb_size_t i = 0;
+            for (i = 0; i < node->count; i++) if (n->keys[i] == key) return &n->childs[i];
+        }
+        break;
+    case TB_RADIX_TREE_NODE_16:
+        {
+            tb_radix_tree_node16_t* n = (tb_radix_tree_node16_t*)node;
+            tb_size_t i = 0;
+            for (i = 0; i < node->count && n->keys[i] <= key; i++) if (n->keys[i] == key) return &n->childs[i];
+        }
+        break;
+    case TB_RADIX_TREE_NODE_48:
+        {
+            tb_radix_tree_node48_t* n = (tb_radix_tree_node48_t*)node;
+            if (n->index[key]) return &n->childs[n->index[key] - 1];
+        }
+        break;
+    case TB_RADIX_TREE_NODE_256:
+        {
+            tb_radix_tree_node256_t* n = (tb_radix_tree_node256_t*)node;
+            if (n->childs[key]) return &n->childs[key];
+        }
+        break;
+    default:
+        tb_assert(0);
+        break;
+    }
+    return tb_null;
+}
+static tb_pointer_t tb_radix_tree_node_child_next(tb_radix_tree_node_t* node, tb_size_t key)
+{
+    // find the first child whose key is larger than the given key, the key may be -1 for the first child
+    switch (node->type)
+    {
+    case TB_RADIX_TREE_NODE_4:
+    case TB_RADIX_TREE_NODE_16:
+        {
+            // node4 and node16 have the same layout of the keys and children
+            tb_byte_t const*    keys = ((tb_radix_tree_node4_t*)node)->keys;
+            tb_pointer_t*       childs = node->type == TB_RADIX_TREE_NODE_4? ((tb_radix_tree_node4_t*)node)->childs : ((tb_radix_tree_node16_t*)node)->childs;
+            tb_size_t i = 0;
+            for (i = 0; i < node->count; i++) if ((tb_long_t)keys[i] > (tb_long_t)key) return childs[i];
+        }
+        break;
+    case TB_RADIX_TREE_NODE_48:
+        {
+            tb_radix_tree_node48_t* n = (tb_radix_tree_node48_t*)node;
+            tb_size_t i = key + 1;
+            for (; i < 256; i++) if (n->index[i]) return n->childs[n->index[i] - 1];
+        }
+        break;
+    case TB_RADIX_TREE_NODE_256:
+        {
+            tb_radix_tree_node256_t* n = (tb_radix_tree_node256_t*)node;
+            tb_size_t i = key + 1;
+            for (; i < 256; i++) if (n->childs[i]) return n->childs[i];
+        }
+        break;
+    default:
+        tb_assert(0);
+        break;
+    }
+    return tb_null;
+}
+static tb_pointer_t tb_radix_tree_node_child_last(tb_radix_tree_node_t* node)
+{
+    switch (node->type)
+    {
+    case TB_RADIX_TREE_NODE_4:
+        return ((tb_radix_tree_node4_t*)node)->childs[node->count - 1];
+    case TB_RADIX_TREE_NODE_16:
+        return ((tb_radix_tree_node16_t*)node)->childs[node->count - 1];
+    case TB_RADIX_TREE_NODE_48:
+        {
+            tb_radix_tree_node48_t* n = (tb_radix_tree_node48_t*)node;
+            tb_long_t i = 255;
+            for (; i >= 0; i--) if (n->index[i]) return n->childs[n->index[i] - 1];
+        }
+        break;
+    case TB_RADIX_TREE_NODE_256:
+        {
+            tb_radix_tree_node256_t* n = (tb_radix_tree_node256_t*)node;
+            tb_long_t i = 255;
+            for (; i >= 0; i--) if (n->childs[i]) return n->childs[i];
+        }
+        break;
+    default:
+        tb_assert(0);
+        break;
+    }
+    return tb_null;
+}
+static tb_radix_tree_leaf_t* tb_radix_tree_node_leaf_head(tb_pointer_t node)
+{
+    while (node && !tb_radix_tree_is_leaf(node)) node = tb_radix_tree_node_child_next((tb_radix_tree_node_t*)node, (tb_size_t)-1);
+    return node? tb_radix_tree_leaf(node) : tb_null;
+}
+static tb_radix_tree_leaf_t* tb_radix_tree_node_leaf_last(tb_pointer_t node)
+{
+    while (node && !tb_radix_tree_is_leaf(node)) node = tb_radix_tree_node_child_last((tb_radix_tree_node_t*)node);
+    return node? tb_radix_tree_leaf(node) : tb_null;
+}
+static tb_radix_tree_node_t* tb_radix_tree_node_grow(tb_radix_tree_node_t* node)
+{
+    // make the larger node with the same prefix
+    tb_radix_tree_node_t* grow = tb_radix_tree_node_init(node->type + 1, tb_radix_tree_node_prefix(node), node->plen);
+    tb_assert_and_check_return_val(grow, tb_null);
+
+    // copy children
+    tb_size_t i = 0;
+    tb_size_t n = node->count;
+    switch (node->type)
+    {
+    case TB_RADIX_TREE_NODE_4:
+        {
+            tb_radix_tree_node4_t*  o = (tb_radix_tree_node4_t*)node;
+            tb_radix_tree_node16_t* g = (tb_radix_tree_node16_t*)grow;
+            tb_memcpy(g->keys, o->keys, n);
+            tb_memcpy(g->childs, o->childs, n * sizeof(tb_pointer_t));
+        }
+        break;
+    case TB_RADIX_TREE_NODE_16:
+        {
+            tb_radix_tree_node16_t* o = (tb_radix_tree_node16_t*)node;
+            tb_radix_tree_node48_t* g = (tb_radix_tree_node48_t*)grow;
+            for (i = 0; i < n; i++) 
+            {
+                g->index[o->keys[i]] = (tb_byte_t)(i + 1);
+                g->childs[i] = o->childs[i];
+            }
+        }
+        break;
+    case TB_RADIX_TREE_NODE_48:
+        {
+            tb_radix_tree_node48_t*  o = (tb_radix_tree_node48_t*)node;
+            tb_radix_tree_node256_t* g = (tb_radix_tree_node256_t*)grow;
+            for (i = 0; i < 256; i++) if (o->index[i]) g->childs[i] = o->childs[o->index[i] - 1];
+        }
+        break;
+    default:
+        tb_assert(0);
+        break;
+    }
+    grow->count = node->count;
+
+    // free the old node
+    tb_free(node);
+    return grow;
+}
+static tb_radix_tree_node_t* tb_radix_tree_node_shrink(tb_radix_tree_node_t* node)
+{
+    // make the smaller node with the same prefix
+    tb_radix_tree_node_t* shrink = tb_radix_tree_node_init(node->type - 1, tb_radix_tree_node_prefix(node), node->plen);
+    tb_assert_and_check_return_val(shrink, node);
+
+    // copy children
+    tb_size_t i = 0;
+    tb_size_t n = 0;
+    switch (node->type)
+    {
+    case TB_RADIX_TREE_NODE_16:
+        {
+            tb_radix_tree_node16_t* o = (tb_radix_tree_node16_t*)node;
+            tb_radix_tree_node4_t*  s = (tb_radix_tree_node4_t*)shrink;
+            tb_memcpy(s->keys, o->keys, node->count);
+            tb_memcpy(s->childs, o->childs, node->count * sizeof(tb_pointer_t));
+        }
+        break;
+    case TB_RADIX_TREE_NODE_48:
+        {
+            tb_radix_tree_node48_t* o = (tb_radix_tree_node48_t*)node;
+            tb_radix_tree_node16_t* s = (tb_radix_tree_node16_t*)shrink;
+            for (i = 0; i < 256; i++) 
+            {
+                if (o->index[i])
+                {
+                    s->keys[n] = (tb_byte_t)i;
+                    s->childs[n++] = o->childs[o->index[i] - 1];
+                }
+            }
+        }
+        break;
+    case TB_RADIX_TREE_NODE_256:
+        {
+            tb_radix_tree_node256_t* o = (tb_radix_tree_node256_t*)node;
+            tb_radix_tree_node48_t*  s = (tb_radix_tree_node48_t*)shrink;
+            for (i = 0; i < 256; i++) 
+            {
+                if (o->childs[i])
+                {
+                    s->index[i] = (tb_byte_t)(n + 1);
+                    s->childs[n++] = o->childs[i];
+                }
+            }
+        }
+        break;
+    default:
+        tb_assert(0);
+        break;
+    }
+    shrink->count = node->count;
+
+    // free the old node
+    tb_free(node);
+    return shrink;
+}
+static tb_bool_t tb_radix_tree_node_insert(tb_pointer_t* pnode, tb_byte_t key, tb_pointer_t child)
+{
+    // grow it if full
+    tb_radix_tree_node_t* node = (tb_radix_tree_node_t*)*pnode;
+    if (node->count >= g_radix_tree_node_maxn[node->type])
+    {
+        node = tb_radix_tree_node_grow(node);
+        tb_assert_and_check_return_val(node, tb_false);
+        *pnode = node;
+    }
+
+    // insert child
+    switch (node->type)
+    {
+    case TB_RADIX_TREE_NODE_4:
+    case TB_RADIX_TREE_NODE_16:
+        {
+            // node4 and node16 have the same layout of the keys
+            tb_byte_t*      keys = ((tb_radix_tree_node4_t*)node)->keys;
+            tb_pointer_t*   childs = node->type == TB_RADIX_TREE_NODE_4? ((tb_radix_tree_node4_t*)node)->childs : ((tb_radix_tree_node16_t*)node)->childs;
+
+            // find the insert position
+            tb_size_t i = 0;
+            tb_size_t n = node->count;
+            while (i < n && keys[i] < key) i++;
+
+            // insert it
+            if (i < n)
+            {
+                tb_memmov(keys + i + 1, keys + i, n - i);
+                tb_memmov(childs + i + 1, childs + i, (n - i) * sizeof(tb_pointer_t));
+            }
+            keys[i]     = key;
+            childs[i]   = child;
+        }
+        break;
+    case TB_RADIX_TREE_NODE_48:
+        {
+            // the used slots are [0, count)
+            tb_radix_tree_node48_t* n = (tb_radix_tree_node48_t*)node;
+            n->childs[node->count] = child;
+            n->index[key] = (tb_byte_t)(node->count + 1);
+        }
+        break;
+    case TB_RADIX_TREE_NODE_256:
+        ((tb_radix_tree_node256_t*)node)->childs[key] = child;
+        break;
+    default:
+        tb_assert(0);
+        break;
+    }
+    node->count++;
+    return tb_true;
+}
+static tb_void_t tb_radix_tree_node_remove(tb_pointer_t* pnode, tb_byte_t key)
+{
+    // remove child
+    tb_radix_tree_node_t* node = (tb_radix_tree_node_t*)*pnode;
+    switch (node->type)
+    {
+    case TB_RADIX_TREE_NODE_4:
+    case TB_RADIX_TREE_NODE_16:
+        {
+            // node4 and node16 have the same layout of the keys
+            tb_byte_t*      keys = ((tb_radix_tree_node4_t*)node)->keys;
+            tb_pointer_t*   childs = node->type == TB_RADIX_TREE_NODE_4? ((tb_radix_tree_node4_t*)node)->childs : ((tb_radix_tree_node16_t*)node)->childs;
+
+            // find it
+            tb_size_t i = 0;
+            tb_size_t n = node->count;
+            while (i < n && keys[i] != key) i++;
+            tb_assert_and_check_return(i < n);
+
+            // remove it
+            if (i + 1 < n)
+            {
+                tb_memmov(keys + i, keys + i + 1, n - i - 1);
+                tb_memmov(childs + i, childs + i + 1, (n - i - 1) * sizeof(tb_pointer_t));
+            }
+        }
+        break;
+    case TB_RADIX_TREE_NODE_48:
+        {
+            // move the last slot to the removed slot
+            tb_radix_tree_node48_t* n = (tb_radix_tree_node48_t*)node;
+            tb_size_t slot = n->index[key];
+            tb_assert_and_check_return(slot);
+            if (slot != node->count)
+            {
+                tb_size_t i = 0;
+                for (i = 0; i < 256 && n->index[i] != node->count; i++) ;
+                tb_assert(i < 256);
+                n->childs[slot - 1] = n->childs[node->count - 1];
+                n->index[i] = (tb_byte_t)slot;
+            }
+            n->index[key] = 0;
+        }
+        break;
+    case TB_RADIX_TREE_NODE_256:
+        ((tb_radix_tree_node256_t*)node)->childs[key] = tb_null;
+        break;
+    default:
+        tb_assert(0);
+        break;
+    }
+    node->count--;
+
+    // shrink it with the hysteresis
+    switch (node->type)
+    {
+    case TB_RADIX_TREE_NODE_16:
+        if (node->count <= 3) *pnode = tb_radix_tree_node_shrink(node);
+        break;
+    case TB_RADIX_TREE_NODE_48:
+        if (node->count <= 12) *pnode = tb_radix_tree_node_shrink(node);
+        break;
+    case TB_RADIX_TREE_NODE_256:
+        if (node->count <= 37) *pnode = tb_radix_tree_node_shrink(node);
+        break;
+    case TB_RADIX_TREE_NODE_4:
+        {
+            // only one child? merge it to the parent path
+            tb_radix_tree_node4_t* n = (tb_radix_tree_node4_t*)node;
+            if (node->count == 1)
+            {
+                tb_pointer_t child = n->childs[0];
+                if (!tb_radix_tree_is_leaf(child))
+                {
+                    // make the new prefix: node prefix + key + child prefix
+                    tb_radix_tree_node_t*   c = (tb_radix_tree_node_t*)child;
+                    tb_size_t               plen = node->plen + 1 + c->plen;
+                    tb_radix_tree_node_t*   m = (tb_radix_tree_node_t*)tb_malloc(g_radix_tree_node_size[c->type] + plen);
+                    tb_assert_and_check_break(m);
+
+                    // copy the child body
+                    tb_memcpy(m, c, g_radix_tree_node_size[c->type]);
+                    m->plen = (tb_uint32_t)plen;
+
+                    // copy the prefix
+                    tb_byte_t* p = tb_radix_tree_node_prefix(m);
+                    tb_memcpy(p, tb_radix_tree_node_prefix(node), node->plen);
+                    p[node->plen] = n->keys[0];
+                    tb_memcpy(p + node->plen + 1, tb_radix_tree_node_prefix(c), c->plen);
+
+                    // free the child
+                    tb_free(c);
+                    child = m;
+                }
+
+                // the leaf contains the whole name, so replace the node with it directly
+                tb_free(node);
+                *pnode = child;
+            }
+        }
+        break;
+    default:
+        break;
+    }
+}
+static tb_void_t tb_radix_tree_node_exit(tb_pointer_t node)
+{
+    // check
+    tb_check_return(node && !tb_radix_tree_is_leaf(node));
+
+    // the children
+    tb_radix_tree_node_t*   n = (tb_radix_tree_node_t*)node;
+    tb_pointer_t*           childs = tb_null;
+    tb_size_t               count = n->count;
+    switch (n->type)
+    {
+    case TB_RADIX_TREE_NODE_4:
+        childs = ((tb_radix_tree_node4_t*)n)->childs;
+        break;
+    case TB_RADIX_TREE_NODE_16:
+        childs = ((tb_radix_tree_node16_t*)n)->childs;
+        break;
+    case TB_RADIX_TREE_NODE_48:
+        childs = ((tb_radix_tree_node48_t*)n)->childs;
+        break;
+    case TB_RADIX_TREE_NODE_256:
+        childs = ((tb_radix_tree_node256_t*)n)->childs;
+        count = 256;
+        break;
+    default:
+        tb_assert(0);
+        break;
+    }
+
+    // exit the child nodes, the leaves are freed by the leaf list
+    tb_size_t i = 0;
+    for (i = 0; childs && i < count; i++) tb_radix_tree_node_exit(childs[i]);
+
+    // free it
+    tb_free(node);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_long_t tb_radix_tree_leaf_comp(tb_radix_tree_impl_t* impl, tb_radix_tree_leaf_t* leaf, tb_byte_t const* name, tb_size_t size)
+{
+    // the names are different at the shorter '\0' at least
+    return tb_memcmp(tb_radix_tree_leaf_name(impl, leaf), name, tb_min(leaf->size, size));
+}
+static tb_void_t tb_radix_tree_leaf_exit(tb_radix_tree_impl_t* impl, tb_radix_tree_leaf_t* leaf)
+{
+    // free data
+    if (impl->element_data.free) impl->element_data.free(&impl->element_data, tb_radix_tree_leaf_data(leaf));
+
+    // free it
+    tb_free(leaf);
+}
+static tb_radix_tree_leaf_t* tb_radix_tree_leaf_find(tb_radix_tree_impl_t* impl, tb_byte_t const* name, tb_size_t size)
+{
+    // find the leaf
+    tb_pointer_t    node = impl->root;
+    tb_size_t       depth = 0;
+    while (node)
+    {
+        // leaf?
+        if (tb_radix_tree_is_leaf(node))
+        {
+            tb_radix_tree_leaf_t* leaf = tb_radix_tree_leaf(node);
+            return (leaf->size == size && !tb_radix_tree_leaf_comp(impl, leaf, name, size))? leaf : tb_null;
+        }
+
+        // match prefix
+        tb_radix_tree_node_t* n = (tb_radix_tree_node_t*)node;
+        if (n->plen)
+        {
+            if (size - depth <= n->plen || tb_memcmp(tb_radix_tree_node_prefix(n), name + depth, n->plen)) return tb_null;
+            depth += n->plen;
+        }
+
+        // the child
+        tb_pointer_t* pchild = tb_radix_tree_node_child(n, name[depth]);
+        node = pchild? *pchild : tb_null;
+        depth++;
+    }
+    return tb_null;
+}
+static tb_radix_tree_leaf_t* tb_radix_tree_leaf_lower(tb_radix_tree_impl_t* impl, tb_pointer_t node, tb_byte_t const* name, tb_size_t size, tb_size_t depth)
+{
+    // leaf?
+    tb_check_return_val(node, tb_null);
+    if (tb_radix_tree_is_leaf(node))
+    {
+        tb_radix_tree_leaf_t* leaf = tb_radix_tree_leaf(node);
+        return tb_radix_tree_leaf_comp(impl, leaf, name, size) >= 0? leaf : tb_null;
+    }
+
+    // compare prefix, the name is ended by '\0' which is less than all prefix bytes
+    tb_radix_tree_node_t* n = (tb_radix_tree_node_t*)node;
+    if (n->plen)
+    {
+        tb_long_t r = tb_memcmp(tb_radix_tree_node_prefix(n), name + depth, tb_min(n->plen, size - depth));
+        if (r > 0 || (!r && size - depth <= n->plen)) return tb_radix_tree_node_leaf_head(node);
+        else if (r < 0) return tb_null;
+        depth += n->plen;
+    }
+
+    // find it from the equal child
+    tb_byte_t       key = name[depth];
+    tb_pointer_t*   pchild = tb_radix_tree_node_child(n, key);
+    if (pchild)
+    {
+        tb_radix_tree_leaf_t* leaf = tb_radix_tree_leaf_lower(impl, *pchild, name, size, depth + 1);
+        if (leaf) return leaf;
+    }
+
+    // the first leaf of the next child
+    return tb_radix_tree_node_leaf_head(tb_radix_tree_node_child_next(n, key));
+}
+static tb_size_t tb_radix_tree_itor_size(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_radix_tree_impl_t* impl = (tb_radix_tree_impl_t*)iterator;
+    tb_assert(impl);
+
+    // the size
+    return impl->size;
+}
+static tb_size_t tb_radix_tree_itor_head(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_radix_tree_impl_t* impl = (tb_radix_tree_impl_t*)iterator;
+    tb_assert(impl);
+
+    // the head
+    return (tb_size_t)impl->head;
+}
+static tb_size_t tb_radix_tree_itor_last(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_radix_tree_impl_t* impl = (tb_radix_tree_impl_t*)iterator;
+    tb_assert(impl);
+
+    // the last
+    return (tb_size_t)impl->last;
+}
+static tb_size_t tb_radix_tree_itor_tail(tb_iterator_ref_t iterator)
+{
+    return 0;
+}
+static tb_size_t tb_radix_tree_itor_next(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_assert(itor);
+
+    // the next
+    return (tb_size_t)((tb_radix_tree_leaf_t*)itor)->next;
+}
+static tb_size_t tb_radix_tree_itor_prev(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_radix_tree_impl_t* impl = (tb_radix_tree_impl_t*)iterator;
+    tb_assert(impl);
+
+    // the prev, the prev of the tail is the last
+    return itor? (tb_size_t)((tb_radix_tree_leaf_t*)itor)->prev : (tb_size_t)impl->last;
+}
+static tb_pointer_t tb_radix_tree_itor_item(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_radix_tree_impl_t*   impl = (tb_radix_tree_impl_t*)iterator;
+    tb_radix_tree_leaf_t*   leaf = (tb_radix_tree_leaf_t*)itor;
+    tb_assert_and_check_return_val(impl && leaf, tb_null);
+
+    // the item
+    impl->item.name = (tb_char_t const*)tb_radix_tree_leaf_name(impl, leaf);
+    impl->item.data = impl->element_data.data(&impl->element_data, tb_radix_tree_leaf_data(leaf));
+    return &impl->item;
+}
+static tb_void_t tb_radix_tree_itor_copy(tb_iterator_ref_t iterator, tb_size_t itor, tb_cpointer_t item)
+{
+    // check
+    tb_radix_tree_impl_t*   impl = (tb_radix_tree_impl_t*)iterator;
+    tb_radix_tree_leaf_t*   leaf = (tb_radix_tree_leaf_t*)itor;
+    tb_assert_and_check_return(impl && leaf);
+
+    // note: copy data only, will destroy the tree if copy name
+    impl->element_data.copy(&impl->element_data, tb_radix_tree_leaf_data(leaf), item);
+}
+static tb_long_t tb_radix_tree_itor_comp(tb_iterator_ref_t iterator, tb_cpointer_t litem, tb_cpointer_t ritem)
+{
+    // check
+    tb_assert(litem && ritem);
+
+    // comp
+    return tb_strcmp(((tb_radix_tree_item_ref_t)litem)->name, ((tb_radix_tree_item_ref_t)ritem)->name);
+}
+static tb_void_t tb_radix_tree_itor_remove(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_radix_tree_impl_t*   impl = (tb_radix_tree_impl_t*)iterator;
+    tb_radix_tree_leaf_t*   leaf = (tb_radix_tree_leaf_t*)itor;
+    tb_assert_and_check_return(impl && leaf);
+
+    // remove it
+    tb_radix_tree_remove((tb_radix_tree_ref_t)impl, (tb_char_t const*)tb_radix_tree_leaf_name(impl, leaf));
+}
+static tb_void_t tb_radix_tree_itor_remove_range(tb_iterator_ref_t iterator, tb_size_t prev, tb_size_t next, tb_size_t size)
+{
+    // check
+    tb_radix_tree_impl_t* impl = (tb_radix_tree_impl_t*)iterator;
+    tb_assert_and_check_return(impl);
+
+    // remove items: (prev, next)
+    tb_size_t itor = prev? tb_radix_tree_itor_next(iterator, prev) : tb_radix_tree_itor_head(iterator);
+    while (itor && itor != next && size--)
+    {
+        tb_size_t save = tb_radix_tree_itor_next(iterator, itor);
+        tb_radix_tree_itor_remove(iterator, itor);
+        itor = save;
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_radix_tree_ref_t tb_radix_tree_init(tb_element_t element_data)
+{
+    // check
+    tb_assert_and_check_return_val(element_data.data && element_data.dupl && element_data.repl, tb_null);
+
+    // done
+    tb_bool_t               ok = tb_false;
+    tb_radix_tree_impl_t*   impl = tb_null;
+    do
+    {
+        // make tree
+        impl = tb_malloc0_type(tb_radix_tree_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init element
+        impl->element_data = element_data;
+
+        // init item itor
+        impl->itor.mode             = TB_ITERATOR_MODE_FORWARD | TB_ITERATOR_MODE_REVERSE;
+        impl->itor.priv             = tb_null;
+        impl->itor.step             = sizeof(tb_radix_tree_item_t);
+        impl->itor.size             = tb_radix_tree_itor_size;
+        impl->itor.head             = tb_radix_tree_itor_head;
+        impl->itor.last             = tb_radix_tree_itor_last;
+        impl->itor.tail             = tb_radix_tree_itor_tail;
+        impl->itor.prev             = tb_radix_tree_itor_prev;
+        impl->itor.next             = tb_radix_tree_itor_next;
+        impl->itor.item             = tb_radix_tree_itor_item;
+        impl->itor.copy             = tb_radix_tree_itor_copy;
+        impl->itor.comp             = tb_radix_tree_itor_comp;
+        impl->itor.remove           = tb_radix_tree_itor_remove;
+        impl->itor.remove_range     = tb_radix_tree_itor_remove_range;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) tb_radix_tree_exit((tb_radix_tree_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (tb_radix_tree_ref_t)impl;
+}
+tb_void_t tb_radix_tree_exit(tb_radix_tree_ref_t tree)
+{
+    // check
+    tb_radix_tree_impl_t* impl = (tb_radix_tree_impl_t*)tree;
+    tb_assert_and_check_return(impl);
+
+    // clear it
+    tb_radix_tree_clear(tree);
+
+    // free it
+    tb_free(impl);
+}
+tb_void_t tb_radix_tree_clear(tb_radix_tree_ref_t tree)
+{
+    // check
+    tb_radix_tree_impl_t* impl = (tb_radix_tree_impl_t*)tree;
+    tb_assert_and_check_return(impl);
+
+    // exit leaves
+    tb_radix_tree_leaf_t* leaf = impl->head;
+    while (leaf)
+    {
+        tb_radix_tree_leaf_t* next = leaf->next;
+        tb_radix_tree_leaf_exit(impl, leaf);
+        leaf = next;
+    }
+
+    // exit nodes
+    tb_radix_tree_node_exit(impl->root);
+
+    // clear it
+    impl->root = tb_null;
+    impl->head = tb_null;
+    impl->last = tb_null;
+    impl->size = 0;
+    tb_memset(&impl->item, 0, sizeof(tb_radix_tree_item_t));
+}
+tb_pointer_t tb_radix_tree_get(tb_radix_tree_ref_t tree, tb_char_t const* name)
+{
+    // find it
+    tb_size_t itor = tb_radix_tree_find(tree, name);
+    return itor? ((tb_radix_tree_item_ref_t)tb_radix_tree_itor_item(tree, itor))->data : tb_null;
+}
+tb_size_t tb_radix_tree_find(tb_radix_tree_ref_t tree, tb_char_t const* name)
+{
+    // check
+    tb_radix_tree_impl_t* impl = (tb_radix_tree_impl_t*)tree;
+    tb_assert_and_check_return_val(impl && name, 0);
+
+    // find it
+    return (tb_size_t)tb_radix_tree_leaf_find(impl, (tb_byte_t const*)name, tb_strlen(name) + 1);
+}
+tb_size_t tb_radix_tree_longest(tb_radix_tree_ref_t tree, tb_char_t const* name)
+{
+    // check
+    tb_radix_tree_impl_t* impl = (tb_radix_tree_impl_t*)tree;
+    tb_assert_and_check_return_val(impl && name, 0);
+
+    // done
+    tb_byte_t const*        p = (tb_byte_t const*)name;
+    tb_size_t               n = tb_strlen(name);
+    tb_size_t               depth = 0;
+    tb_pointer_t            node = impl->root;
+    tb_radix_tree_leaf_t*   best = tb_null;
+    while (node)
+    {
+        // the leaf is the last candidate
+        if (tb_radix_tree_is_leaf(node))
+        {
+            tb_radix_tree_leaf_t* leaf = tb_radix_tree_leaf(node);
+            if (leaf->size <= n + 1 && !tb_memcmp(tb_radix_tree_leaf_name(impl, leaf), p, leaf->size - 1)) best = leaf;
+            break;
+        }
+
+        // match prefix
+        tb_radix_tree_node_t* r = (tb_radix_tree_node_t*)node;
+        if (r->plen)
+        {
+            if (n - depth < r->plen || tb_memcmp(tb_radix_tree_node_prefix(r), p + depth, r->plen)) break;
+            depth += r->plen;
+        }
+
+        // the name [0, depth) exists? it is the child of '\0'
+        tb_pointer_t* pchild = tb_radix_tree_node_child(r, 0);
+        if (pchild) 
+        {
+            tb_assert(tb_radix_tree_is_leaf(*pchild));
+            best = tb_radix_tree_leaf(*pchild);
+        }
+
+        // end?
+        tb_check_break(depth < n);
+
+        // the next child
+        pchild = tb_radix_tree_node_child(r, p[depth]);
+        node = pchild? *pchild : tb_null;
+        depth++;
+    }
+
+    // ok?
+    return (tb_size_t)best;
+}
+tb_size_t tb_radix_tree_prefix(tb_radix_tree_ref_t tree, tb_char_t const* prefix, tb_size_t* ptail)
+{
+    // check
+    tb_radix_tree_impl_t* impl = (tb_radix_tree_impl_t*)tree;
+    tb_assert_and_check_return_val(impl && prefix, 0);
+
+    // find the subtree which contains all names with this prefix
+    tb_byte_t const*    p = (tb_byte_t const*)prefix;
+    tb_size_t           n = tb_strlen(prefix);
+    tb_size_t           depth = 0;
+    tb_pointer_t        node = impl->root;
+    while (node && depth < n && !tb_radix_tree_is_leaf(node))
+    {
+        // match prefix
+        tb_radix_tree_node_t* r = (tb_radix_tree_node_t*)node;
+        if (r->plen)
+        {
+            // the node prefix contains the left prefix?
+            tb_size_t m = tb_min(r->plen, n - depth);
+            if (tb_memcmp(tb_radix_tree_node_prefix(r), p + depth, m)) node = tb_null;
+            depth += m;
+            tb_check_break(depth < n);
+        }
+
+        // the next child
+        tb_check_break(node);
+        tb_pointer_t* pchild = tb_radix_tree_node_child(r, p[depth]);
+        node = pchild? *pchild : tb_null;
+        depth++;
+    }
+
+    // the leaf? check the whole name
+    if (node && tb_radix_tree_is_leaf(node))
+    {
+        tb_radix_tree_leaf_t* leaf = tb_radix_tree_leaf(node);
+        if (leaf->size <= n || tb_memcmp(tb_radix_tree_leaf_name(impl, leaf), p, n)) node = tb_null;
+    }
+
+    // no items?
+    if (!node)
+    {
+        if (ptail) *ptail = 0;
+        return 0;
+    }
+
+    // the items range
+    tb_radix_tree_leaf_t* last = tb_radix_tree_node_leaf_last(node);
+    if (ptail) *ptail = (tb_size_t)last->next;
+    return (tb_size_t)tb_radix_tree_node_leaf_head(node);
+}
+tb_size_t tb_radix_tree_lower_bound(tb_radix_tree_ref_t tree, tb_char_t const* name)
+{
+    // check
+    tb_radix_tree_impl_t* impl = (tb_radix_tree_impl_t*)tree;
+    tb_assert_and_check_return_val(impl && name, 0);
+
+    // find it
+    return (tb_size_t)tb_radix_tree_leaf_lower(impl, impl->root, (tb_byte_t const*)name, tb_strlen(name) + 1, 0);
+}
+tb_size_t tb_radix_tree_insert(tb_radix_tree_ref_t tree, tb_char_t const* name, tb_cpointer_t data)
+{
+    // check
+    tb_radix_tree_impl_t* impl = (tb_radix_tree_impl_t*)tree;
+    tb_assert_and_check_return_val(impl && name, 0);
+
+    // the name with '\0'
+    tb_byte_t const*    p = (tb_byte_t const*)name;
+    tb_size_t           n = tb_strlen(name) + 1;
+
+    // exists? replace data
+    tb_radix_tree_leaf_t* leaf = tb_radix_tree_leaf_find(impl, p, n);
+    if (leaf)
+    {
+        impl->element_data.repl(&impl->element_data, tb_radix_tree_leaf_data(leaf), data);
+        return (tb_size_t)leaf;
+    }
+
+    // the next leaf in order
+    tb_radix_tree_leaf_t* next = tb_radix_tree_leaf_lower(impl, impl->root, p, n, 0);
+
+    // make leaf
+    leaf = (tb_radix_tree_leaf_t*)tb_malloc(sizeof(tb_radix_tree_leaf_t) + impl->element_data.size + n);
+    tb_assert_and_check_return_val(leaf, 0);
+    leaf->size = n;
+    tb_memcpy(tb_radix_tree_leaf_name(impl, leaf), p, n);
+    
+    // insert it to the tree
+    tb_bool_t       ok = tb_false;
+    tb_size_t       depth = 0;
+    tb_pointer_t*   pnode = &impl->root;
+    while (1)
+    {
+        // empty? 
+        tb_pointer_t node = *pnode;
+        if (!node)
+        {
+            *pnode = tb_radix_tree_leaf_tag(leaf);
+            ok = tb_true;
+            break;
+        }
+
+        // leaf? split it with the common prefix
+        if (tb_radix_tree_is_leaf(node))
+        {
+            // the common prefix
+            tb_radix_tree_leaf_t*   l = tb_radix_tree_leaf(node);
+            tb_byte_t const*        q = tb_radix_tree_leaf_name(impl, l);
+            tb_size_t               i = depth;
+            while (q[i] == p[i]) i++;
+
+            // make node
+            tb_pointer_t split = tb_radix_tree_node_init(TB_RADIX_TREE_NODE_4, p + depth, i - depth);
+            tb_assert_and_check_break(split);
+
+            // insert leaves
+            tb_radix_tree_node_insert(&split, q[i], node);
+            tb_radix_tree_node_insert(&split, p[i], tb_radix_tree_leaf_tag(leaf));
+            *pnode = split;
+            ok = tb_true;
+            break;
+        }
+
+        // match prefix
+        tb_radix_tree_node_t* r = (tb_radix_tree_node_t*)node;
+        if (r->plen)
+        {
+            // the mismatched position, the '\0' of the name will be mismatched at least
+            tb_byte_t*  prefix = tb_radix_tree_node_prefix(r);
+            tb_size_t   i = 0;
+            while (i < r->plen && prefix[i] == p[depth + i]) i++;
+
+            // split the prefix
+            if (i < r->plen)
+            {
+                // make node with the common prefix
+                tb_pointer_t split = tb_radix_tree_node_init(TB_RADIX_TREE_NODE_4, prefix, i);
+                tb_assert_and_check_break(split);
+
+                // shorten the prefix of the old node
+                tb_byte_t key = prefix[i];
+                r->plen -= (tb_uint32_t)(i + 1);
+                if (r->plen) tb_memmov(prefix, prefix + i + 1, r->plen);
+
+                // insert children
+                tb_radix_tree_node_insert(&split, key, node);
+                tb_radix_tree_node_insert(&split, p[depth + i], tb_radix_tree_leaf_tag(leaf));
+                *pnode = split;
+                ok = tb_true;
+                break;
+            }
+            depth += r->plen;
+        }
+
+        // the next child
+        tb_pointer_t* pchild = tb_radix_tree_node_child(r, p[depth]);
+        if (!pchild)
+        {
+            ok = tb_radix_tree_node_insert(pnode, p[depth], tb_radix_tree_leaf_tag(leaf));
+            break;
+        }
+        pnode = pchild;
+        depth++;
+    }
+
+    // failed?
+    if (!ok)
+    {
+        tb_free(leaf);
+        return 0;
+    }
+
+    // dupl data
+    impl->element_data.dupl(&impl->element_data, tb_radix_tree_leaf_data(leaf), data);
+
+    // link it before the next leaf
+    leaf->next = next;
+    leaf->prev = next? next->prev : impl->last;
+    if (leaf->prev) leaf->prev->next = leaf;
+    else impl->head = leaf;
+    if (next) next->prev = leaf;
+    else impl->last = leaf;
+
+    // ok
+    impl->size++;
+    return (tb_size_t)leaf;
+}
+tb_void_t tb_radix_tree_remove(tb_radix_tree_ref_t tree, tb_char_t const* name)
+{
+    // check
+    tb_radix_tree_impl_t* impl = (tb_radix_tree_impl_t*)tree;
+    tb_assert_and_check_return(impl && name);
+
+    // the name with '\0'
+    tb_byte_t const*    p = (tb_byte_t const*)name;
+    tb_size_t           n = tb_strlen(name) + 1;
+
+    // find the leaf and the node ref of its parent
+    tb_size_t               depth = 0;
+    tb_pointer_t*           pnode = &impl->root;
+    tb_pointer_t*           pparent = tb_null;
+    tb_byte_t               key = 0;
+    tb_radix_tree_leaf_t*   leaf = tb_null;
+    while (*pnode)
+    {
+        // leaf?
+        tb_pointer_t node = *pnode;
+        if (tb_radix_tree_is_leaf(node))
+        {
+            tb_radix_tree_leaf_t* l = tb_radix_tree_leaf(node);
+            if (l->size == n && !tb_radix_tree_leaf_comp(impl, l, p, n)) leaf = l;
+            break;
+        }
+
+        // match prefix
+        tb_radix_tree_node_t* r = (tb_radix_tree_node_t*)node;
+        if (r->plen)
+        {
+            if (n - depth <= r->plen || tb_memcmp(tb_radix_tree_node_prefix(r), p + depth, r->plen)) break;
+            depth += r->plen;
+        }
+
+        // the next child
+        tb_pointer_t* pchild = tb_radix_tree_node_child(r, p[depth]);
+        tb_check_break(pchild);
+        key     = p[depth];
+        pparent = pnode;
+        pnode   = pchild;
+        depth++;
+    }
+    tb_check_return(leaf);
+
+    // remove it from the tree
+    if (pparent) tb_radix_tree_node_remove(pparent, key);
+    else impl->root = tb_null;
+
+    // unlink it
+    if (leaf->prev) leaf->prev->next = leaf->next;
+    else impl->head = leaf->next;
+    if (leaf->next) leaf->next->prev = leaf->prev;
+    else impl->last = leaf->prev;
+
+    // exit it
+    tb_radix_tree_leaf_exit(impl, leaf);
+    impl->size--;
+}
+tb_size_t tb_radix_tree_size(tb_radix_tree_ref_t tree)
+{
+    // check
+    tb_radix_tree_impl_t const* impl = (tb_radix_tree_impl_t const*)tree;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the size
+    return impl->size;
+}
+#ifdef __tb_debug__
+tb_void_t tb_radix_tree_dump(tb_radix_tree_ref_t tree)
+{
+    // check
+    tb_radix_tree_impl_t* impl = (tb_radix_tree_impl_t*)tree;
+    tb_assert_and_check_return(impl);
+
+    // trace
+    tb_trace_i("");
+    tb_trace_i("radix_tree: size: %lu", tb_radix_tree_size(tree));
+
+    // done
+    tb_char_t data[4096];
+    tb_for_all (tb_radix_tree_item_ref_t, item, tree)
+    {
+        if (impl->element_data.cstr) 
+        {
+            tb_trace_i("%s => %s", item->name, impl->element_data.cstr(&impl->element_data, item->data, data, sizeof(data)));
+        }
+        else
+        {
+            tb_trace_i("%s => %p", item->name, item->data);
+        }
+    }
+}
+#endif
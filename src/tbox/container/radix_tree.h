@@ -0,0 +1,210 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        radix_tree.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_RADIX_TREE_H
+#define TB_CONTAINER_RADIX_TREE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "element.h"
+#include "iterator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the radix tree item type
+typedef struct __tb_radix_tree_item_t
+{
+    /// the item name
+    tb_char_t const*    name;
+
+    /// the item data
+    tb_pointer_t        data;
+
+}tb_radix_tree_item_t, *tb_radix_tree_item_ref_t;
+
+/*! the radix tree ref type
+ *
+ * the adaptive radix tree with the path compression for the c-string names, 
+ * the inner nodes are resized by the fanout: node4 => node16 => node48 => node256
+ *
+ * <pre>
+ *                      [root: node4, prefix: "/api/"]
+ *                       |                    |
+ *                     'u'                   'v'
+ *                       |                    |
+ *          [node4, prefix: "ser"]      (leaf: "/api/version")
+ *            |               |
+ *          '\0'             '/'
+ *            |               |
+ * (leaf: "/api/user")  (leaf: "/api/user/")
+ * </pre>
+ *
+ * the iterator walks the items in the order of the names (unsigned bytes)
+ *
+ * @note the itor of the same item is immutable
+ */
+typedef tb_iterator_ref_t tb_radix_tree_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init radix tree
+ *
+ * @param element_data  the element for data
+ *
+ * @return              the radix tree
+ */
+tb_radix_tree_ref_t     tb_radix_tree_init(tb_element_t element_data);
+
+/*! exit radix tree
+ *
+ * @param tree          the radix tree
+ */
+tb_void_t               tb_radix_tree_exit(tb_radix_tree_ref_t tree);
+
+/*! clear radix tree
+ *
+ * @param tree          the radix tree
+ */
+tb_void_t               tb_radix_tree_clear(tb_radix_tree_ref_t tree);
+
+/*! get item data from name
+ *
+ * @param tree          the radix tree
+ * @param name          the item name
+ *
+ * @return              the item data
+ */
+tb_pointer_t            tb_radix_tree_get(tb_radix_tree_ref_t tree, tb_char_t const* name);
+
+/*! find item from name
+ *
+ * @param tree          the radix tree
+ * @param name          the item name
+ *
+ * @return              the item itor, not found: tb_iterator_tail(tree)
+ */
+tb_size_t               tb_radix_tree_find(tb_radix_tree_ref_t tree, tb_char_t const* name);
+
+/*! find the item with the longest name which is the prefix of the given name 
+ *
+ * @code
+ * 
+ * // the route rules: "/", "/api/", "/api/user/"
+ * tb_size_t itor = tb_radix_tree_longest(tree, "/api/user/1234");
+ * if (itor != tb_iterator_tail(tree))
+ * {
+ *      // the rule: "/api/user/"
+ *      tb_radix_tree_item_ref_t item = (tb_radix_tree_item_ref_t)tb_iterator_item(tree, itor);
+ * }
+ * @endcode
+ *
+ * @param tree          the radix tree
+ * @param name          the name
+ *
+ * @return              the item itor, not found: tb_iterator_tail(tree)
+ */
+tb_size_t               tb_radix_tree_longest(tb_radix_tree_ref_t tree, tb_char_t const* name);
+
+/*! find the items range with the given name prefix
+ *
+ * @code
+ *
+ * // walk all items with the prefix "/api/"
+ * tb_size_t tail = 0;
+ * tb_size_t itor = tb_radix_tree_prefix(tree, "/api/", &tail);
+ * for (; itor != tail; itor = tb_iterator_next(tree, itor))
+ * {
+ *      tb_radix_tree_item_ref_t item = (tb_radix_tree_item_ref_t)tb_iterator_item(tree, itor);
+ *      // ...
+ * }
+ * @endcode
+ *
+ * @param tree          the radix tree
+ * @param prefix        the name prefix
+ * @param ptail         the tail itor of the range
+ *
+ * @return              the head itor of the range
+ */
+tb_size_t               tb_radix_tree_prefix(tb_radix_tree_ref_t tree, tb_char_t const* prefix, tb_size_t* ptail);
+
+/*! find the first item whose name is not less than the given name
+ *
+ * @param tree          the radix tree
+ * @param name          the name
+ *
+ * @return              the item itor, not found: tb_iterator_tail(tree)
+ */
+tb_size_t               tb_radix_tree_lower_bound(tb_radix_tree_ref_t tree, tb_char_t const* name);
+
+/*! insert item data from name
+ *
+ * @note the pair (name => data) is unique
+ *
+ * @param tree          the radix tree
+ * @param name          the item name
+ * @param data          the item data
+ *
+ * @return              the item itor
+ */
+tb_size_t               tb_radix_tree_insert(tb_radix_tree_ref_t tree, tb_char_t const* name, tb_cpointer_t data);
+
+/*! remove item from name
+ *
+ * @param tree          the radix tree
+ * @param name          the item name
+ */
+tb_void_t               tb_radix_tree_remove(tb_radix_tree_ref_t tree, tb_char_t const* name);
+
+/*! the radix tree size
+ *
+ * @param tree          the radix tree
+ *
+ * @return              the items count
+ */
+tb_size_t               tb_radix_tree_size(tb_radix_tree_ref_t tree);
+
+#ifdef __tb_debug__
+/*! dump radix tree
+ *
+ * @param tree          the radix tree
+ */
+tb_void_t               tb_radix_tree_dump(tb_radix_tree_ref_t tree);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
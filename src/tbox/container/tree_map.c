@@ -0,0 +1,1066 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        tree_map.c
+ * @ingroup     container
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "tree_map"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "tree_map.h"
+#include "../libc/libc.h"
+#include "../utils/utils.h"
+#include "../memory/memory.h"
+#include "../algorithm/algorithm.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the leaf alignment, the item index is stored in the low bits of the leaf address for the itor
+#define TB_TREE_MAP_LEAF_ALIGN              (64)
+
+// the maximum depth of the inner nodes
+#define TB_TREE_MAP_DEPTH_MAXN              (64)
+
+// the itor: leaf | index
+#define tb_tree_map_itor_make(l, i)         ((tb_size_t)(l) | (i))
+#define tb_tree_map_itor_leaf(itor)         ((tb_tree_map_leaf_t*)((itor) & ~(tb_size_t)(TB_TREE_MAP_LEAF_ALIGN - 1)))
+#define tb_tree_map_itor_index(itor)        ((itor) & (TB_TREE_MAP_LEAF_ALIGN - 1))
+
+// the leaf item, the name and the data follow the leaf head
+#define tb_tree_map_leaf_item(impl, l, i)   ((tb_byte_t*)((l) + 1) + (i) * (impl)->step)
+
+// the node children and keys, the children and keys follow the node head
+#define tb_tree_map_node_childs(n)          ((tb_pointer_t*)((n) + 1))
+#define tb_tree_map_node_key(impl, n, i)    ((tb_byte_t*)(tb_tree_map_node_childs(n) + (impl)->node_maxn) + (i) * (impl)->element_name.size)
+
+// the name data of the item or key
+#define tb_tree_map_name(impl, b)           ((impl)->element_name.data(&(impl)->element_name, (b)))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the leaf type, the items follow it
+typedef struct __tb_tree_map_leaf_t
+{
+    // the prev leaf in order
+    struct __tb_tree_map_leaf_t*    prev;
+
+    // the next leaf in order
+    struct __tb_tree_map_leaf_t*    next;
+
+    // the items count
+    tb_size_t                       count;
+
+}tb_tree_map_leaf_t;
+
+/* the inner node type, the children and keys follow it
+ *
+ * key[i] separates child[i] and child[i + 1]: child[i] < key[i] <= child[i + 1]
+ */
+typedef struct __tb_tree_map_node_t
+{
+    // the children count
+    tb_size_t                       count;
+
+}tb_tree_map_node_t;
+
+// the tree map impl type
+typedef struct __tb_tree_map_impl_t
+{
+    // the item itor
+    tb_iterator_t                   itor;
+
+    // the root node, it is leaf if the height is zero
+    tb_pointer_t                    root;
+
+    // the levels count of the inner nodes
+    tb_size_t                       height;
+
+    // the head leaf
+    tb_tree_map_leaf_t*             head;
+
+    // the last leaf
+    tb_tree_map_leaf_t*             last;
+
+    // the items count
+    tb_size_t                       size;
+
+    // the item step
+    tb_size_t                       step;
+
+    // the items maxn of the leaf
+    tb_size_t                       leaf_maxn;
+
+    // the leaf size
+    tb_size_t                       leaf_size;
+
+    // the children maxn of the inner node
+    tb_size_t                       node_maxn;
+
+    // the inner node size
+    tb_size_t                       node_size;
+
+    // the separator key for splitting
+    tb_byte_t*                      sep;
+
+    // the temporary children and keys for splitting the inner node
+    tb_pointer_t*                   temp;
+
+    // the current item for iterator
+    tb_tree_map_item_t              item;
+
+    // the element for name
+    tb_element_t                    element_name;
+
+    // the element for data
+    tb_element_t                    element_data;
+
+}tb_tree_map_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * leaf implementation
+ */
+static tb_tree_map_leaf_t* tb_tree_map_leaf_init(tb_tree_map_impl_t* impl)
+{
+    // make leaf, it is aligned to the cache line
+    tb_tree_map_leaf_t* leaf = (tb_tree_map_leaf_t*)tb_align_malloc(impl->leaf_size, TB_TREE_MAP_LEAF_ALIGN);
+    tb_assert_and_check_return_val(leaf, tb_null);
+
+    // init leaf
+    leaf->prev  = tb_null;
+    leaf->next  = tb_null;
+    leaf->count = 0;
+
+    // ok
+    return leaf;
+}
+static tb_void_t tb_tree_map_leaf_exit(tb_tree_map_impl_t* impl, tb_tree_map_leaf_t* leaf)
+{
+    // free items
+    if (impl->element_name.free || impl->element_data.free)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < leaf->count; i++)
+        {
+            tb_byte_t* item = tb_tree_map_leaf_item(impl, leaf, i);
+            if (impl->element_name.free) impl->element_name.free(&impl->element_name, item);
+            if (impl->element_data.free) impl->element_data.free(&impl->element_data, item + impl->element_name.size);
+        }
+    }
+
+    // free it
+    tb_align_free(leaf);
+}
+static tb_size_t tb_tree_map_leaf_lower(tb_tree_map_impl_t* impl, tb_tree_map_leaf_t* leaf, tb_cpointer_t name, tb_bool_t* pequal)
+{
+    // find the first item which is not less than the name
+    tb_size_t l = 0;
+    tb_size_t r = leaf->count;
+    while (l < r)
+    {
+        tb_size_t m = (l + r) >> 1;
+        if (impl->element_name.comp(&impl->element_name, tb_tree_map_name(impl, tb_tree_map_leaf_item(impl, leaf, m)), name) < 0) l = m + 1;
+        else r = m;
+    }
+
+    // equal?
+    if (pequal) *pequal = (l < leaf->count && !impl->element_name.comp(&impl->element_name, tb_tree_map_name(impl, tb_tree_map_leaf_item(impl, leaf, l)), name));
+
+    // ok
+    return l;
+}
+static tb_size_t tb_tree_map_leaf_upper(tb_tree_map_impl_t* impl, tb_tree_map_leaf_t* leaf, tb_cpointer_t name)
+{
+    // find the first item which is greater than the name
+    tb_size_t l = 0;
+    tb_size_t r = leaf->count;
+    while (l < r)
+    {
+        tb_size_t m = (l + r) >> 1;
+        if (impl->element_name.comp(&impl->element_name, name, tb_tree_map_name(impl, tb_tree_map_leaf_item(impl, leaf, m))) < 0) r = m;
+        else l = m + 1;
+    }
+    return l;
+}
+static tb_void_t tb_tree_map_leaf_insert(tb_tree_map_impl_t* impl, tb_tree_map_leaf_t* leaf, tb_size_t index, tb_cpointer_t name, tb_cpointer_t data)
+{
+    // check
+    tb_assert(leaf->count < impl->leaf_maxn && index <= leaf->count);
+
+    // move the next items
+    tb_byte_t* item = tb_tree_map_leaf_item(impl, leaf, index);
+    if (index < leaf->count) tb_memmov(item + impl->step, item, (leaf->count - index) * impl->step);
+
+    // dupl item
+    impl->element_name.dupl(&impl->element_name, item, name);
+    impl->element_data.dupl(&impl->element_data, item + impl->element_name.size, data);
+
+    // update count
+    leaf->count++;
+    impl->size++;
+}
+static tb_void_t tb_tree_map_leaf_link(tb_tree_map_impl_t* impl, tb_tree_map_leaf_t* leaf, tb_tree_map_leaf_t* prev)
+{
+    // link the leaf after the prev leaf
+    leaf->prev = prev;
+    leaf->next = prev? prev->next : impl->head;
+    if (leaf->next) leaf->next->prev = leaf;
+    else impl->last = leaf;
+    if (prev) prev->next = leaf;
+    else impl->head = leaf;
+}
+static tb_void_t tb_tree_map_leaf_unlink(tb_tree_map_impl_t* impl, tb_tree_map_leaf_t* leaf)
+{
+    if (leaf->prev) leaf->prev->next = leaf->next;
+    else impl->head = leaf->next;
+    if (leaf->next) leaf->next->prev = leaf->prev;
+    else impl->last = leaf->prev;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * node implementation
+ */
+static tb_tree_map_node_t* tb_tree_map_node_init(tb_tree_map_impl_t* impl)
+{
+    // make node
+    tb_tree_map_node_t* node = (tb_tree_map_node_t*)tb_malloc(impl->node_size);
+    tb_assert_and_check_return_val(node, tb_null);
+
+    // init node
+    node->count = 0;
+
+    // ok
+    return node;
+}
+static tb_void_t tb_tree_map_node_exit(tb_tree_map_impl_t* impl, tb_tree_map_node_t* node, tb_size_t level)
+{
+    // exit the inner children, the leaves will be freed from the leaves list
+    tb_size_t i = 0;
+    tb_pointer_t* childs = tb_tree_map_node_childs(node);
+    if (level > 1)
+    {
+        for (i = 0; i < node->count; i++)
+            tb_tree_map_node_exit(impl, (tb_tree_map_node_t*)childs[i], level - 1);
+    }
+
+    // free keys
+    if (impl->element_name.free)
+    {
+        for (i = 1; i < node->count; i++)
+            impl->element_name.free(&impl->element_name, tb_tree_map_node_key(impl, node, i - 1));
+    }
+
+    // free it
+    tb_free(node);
+}
+static tb_tree_map_leaf_t* tb_tree_map_node_find(tb_tree_map_impl_t* impl, tb_cpointer_t name, tb_tree_map_node_t** nodes, tb_size_t* indices)
+{
+    // walk the inner nodes
+    tb_size_t       level = 0;
+    tb_pointer_t    child = impl->root;
+    for (level = 0; level < impl->height; level++)
+    {
+        // the node
+        tb_tree_map_node_t* node = (tb_tree_map_node_t*)child;
+        tb_assert(node->count);
+
+        // find the first key which is greater than the name
+        tb_size_t l = 0;
+        tb_size_t r = node->count - 1;
+        while (l < r)
+        {
+            tb_size_t m = (l + r) >> 1;
+            if (impl->element_name.comp(&impl->element_name, name, tb_tree_map_name(impl, tb_tree_map_node_key(impl, node, m))) < 0) r = m;
+            else l = m + 1;
+        }
+
+        // save path
+        if (nodes)
+        {
+            nodes[level]    = node;
+            indices[level]  = l;
+        }
+
+        // the child
+        child = tb_tree_map_node_childs(node)[l];
+    }
+
+    // the leaf
+    return (tb_tree_map_leaf_t*)child;
+}
+static tb_bool_t tb_tree_map_node_insert(tb_tree_map_impl_t* impl, tb_tree_map_node_t** nodes, tb_size_t* indices, tb_size_t level, tb_pointer_t child)
+{
+    // insert the separator key (impl->sep) and the new child after the split child
+    tb_size_t ksize = impl->element_name.size;
+    while (level--)
+    {
+        // the node
+        tb_tree_map_node_t* node    = nodes[level];
+        tb_size_t           index   = indices[level];
+        tb_size_t           count   = node->count;
+        tb_pointer_t*       childs  = tb_tree_map_node_childs(node);
+        tb_assert(index < count);
+
+        // insert it directly if the node is not full
+        if (count < impl->node_maxn)
+        {
+            tb_memmov(childs + index + 2, childs + index + 1, (count - index - 1) * sizeof(tb_pointer_t));
+            tb_memmov(tb_tree_map_node_key(impl, node, index + 1), tb_tree_map_node_key(impl, node, index), (count - index - 1) * ksize);
+            childs[index + 1] = child;
+            tb_memcpy(tb_tree_map_node_key(impl, node, index), impl->sep, ksize);
+            node->count++;
+            return tb_true;
+        }
+
+        // make the right node
+        tb_tree_map_node_t* right = tb_tree_map_node_init(impl);
+        tb_assert_and_check_return_val(right, tb_false);
+
+        // merge the children and keys to the temporary buffer
+        tb_pointer_t*   temp_childs = impl->temp;
+        tb_byte_t*      temp_keys = (tb_byte_t*)(temp_childs + count + 1);
+        tb_memcpy(temp_childs, childs, (index + 1) * sizeof(tb_pointer_t));
+        temp_childs[index + 1] = child;
+        tb_memcpy(temp_childs + index + 2, childs + index + 1, (count - index - 1) * sizeof(tb_pointer_t));
+        tb_memcpy(temp_keys, tb_tree_map_node_key(impl, node, 0), index * ksize);
+        tb_memcpy(temp_keys + index * ksize, impl->sep, ksize);
+        tb_memcpy(temp_keys + (index + 1) * ksize, tb_tree_map_node_key(impl, node, index), (count - index - 1) * ksize);
+
+        // split them: [left children] [the middle key] [right children]
+        tb_size_t lcount = (count + 1) >> 1;
+        tb_size_t rcount = count + 1 - lcount;
+        tb_memcpy(childs, temp_childs, lcount * sizeof(tb_pointer_t));
+        tb_memcpy(tb_tree_map_node_key(impl, node, 0), temp_keys, (lcount - 1) * ksize);
+        tb_memcpy(tb_tree_map_node_childs(right), temp_childs + lcount, rcount * sizeof(tb_pointer_t));
+        tb_memcpy(tb_tree_map_node_key(impl, right, 0), temp_keys + lcount * ksize, (rcount - 1) * ksize);
+        node->count  = lcount;
+        right->count = rcount;
+
+        // move the middle key up
+        tb_memcpy(impl->sep, temp_keys + (lcount - 1) * ksize, ksize);
+        child = right;
+    }
+
+    // split the root
+    tb_tree_map_node_t* root = tb_tree_map_node_init(impl);
+    tb_assert_and_check_return_val(root, tb_false);
+
+    // init the new root
+    tb_tree_map_node_childs(root)[0] = impl->root;
+    tb_tree_map_node_childs(root)[1] = child;
+    tb_memcpy(tb_tree_map_node_key(impl, root, 0), impl->sep, ksize);
+    root->count = 2;
+
+    // update root
+    impl->root = root;
+    impl->height++;
+
+    // ok
+    return tb_true;
+}
+static tb_size_t tb_tree_map_remove_at(tb_tree_map_impl_t* impl, tb_tree_map_leaf_t* leaf, tb_size_t index)
+{
+    // check
+    tb_assert(leaf && index < leaf->count);
+
+    // remove the leaf if it will be empty
+    if (leaf->count == 1)
+    {
+        // find the path of the leaf
+        tb_tree_map_node_t* nodes[TB_TREE_MAP_DEPTH_MAXN];
+        tb_size_t           indices[TB_TREE_MAP_DEPTH_MAXN];
+        tb_tree_map_leaf_t* found = tb_tree_map_node_find(impl, tb_tree_map_name(impl, tb_tree_map_leaf_item(impl, leaf, 0)), nodes, indices);
+        tb_assert_and_check_return_val(found == leaf, 0);
+
+        // exit the leaf
+        tb_tree_map_leaf_t* next = leaf->next;
+        tb_tree_map_leaf_unlink(impl, leaf);
+        tb_tree_map_leaf_exit(impl, leaf);
+        impl->size--;
+
+        // remove it from the parent nodes, the empty nodes will be freed
+        tb_size_t level = impl->height;
+        tb_bool_t empty = tb_true;
+        while (level--)
+        {
+            // the node
+            tb_tree_map_node_t* node    = nodes[level];
+            tb_size_t           i       = indices[level];
+            tb_size_t           count   = node->count;
+            if (count > 1)
+            {
+                // remove the child and the left separator key (or the right key for the first child)
+                tb_size_t       k = i? i - 1 : 0;
+                tb_pointer_t*   childs = tb_tree_map_node_childs(node);
+                if (impl->element_name.free) impl->element_name.free(&impl->element_name, tb_tree_map_node_key(impl, node, k));
+                tb_memmov(tb_tree_map_node_key(impl, node, k), tb_tree_map_node_key(impl, node, k + 1), (count - k - 2) * impl->element_name.size);
+                tb_memmov(childs + i, childs + i + 1, (count - i - 1) * sizeof(tb_pointer_t));
+                node->count--;
+                empty = tb_false;
+                break;
+            }
+
+            // free the empty node
+            tb_free(node);
+        }
+
+        // the tree is empty?
+        if (empty)
+        {
+            tb_assert(!impl->size && !impl->head);
+            impl->root   = tb_null;
+            impl->height = 0;
+        }
+
+        // shrink the root if it has only one child
+        while (impl->height && ((tb_tree_map_node_t*)impl->root)->count == 1)
+        {
+            tb_tree_map_node_t* root = (tb_tree_map_node_t*)impl->root;
+            impl->root = tb_tree_map_node_childs(root)[0];
+            impl->height--;
+            tb_free(root);
+        }
+
+        // the next itor
+        return next? tb_tree_map_itor_make(next, 0) : 0;
+    }
+
+    // free item
+    tb_byte_t* item = tb_tree_map_leaf_item(impl, leaf, index);
+    if (impl->element_name.free) impl->element_name.free(&impl->element_name, item);
+    if (impl->element_data.free) impl->element_data.free(&impl->element_data, item + impl->element_name.size);
+
+    // remove item from the leaf
+    if (index < leaf->count - 1) tb_memmov(item, item + impl->step, (leaf->count - index - 1) * impl->step);
+    leaf->count--;
+    impl->size--;
+
+    // the next itor
+    if (index < leaf->count) return tb_tree_map_itor_make(leaf, index);
+    return leaf->next? tb_tree_map_itor_make(leaf->next, 0) : 0;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * iterator implementation
+ */
+static tb_size_t tb_tree_map_itor_size(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_tree_map_impl_t* impl = (tb_tree_map_impl_t*)iterator;
+    tb_assert(impl);
+
+    // the size
+    return impl->size;
+}
+static tb_size_t tb_tree_map_itor_head(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_tree_map_impl_t* impl = (tb_tree_map_impl_t*)iterator;
+    tb_assert(impl);
+
+    // the head
+    return impl->head? tb_tree_map_itor_make(impl->head, 0) : 0;
+}
+static tb_size_t tb_tree_map_itor_last(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_tree_map_impl_t* impl = (tb_tree_map_impl_t*)iterator;
+    tb_assert(impl);
+
+    // the last
+    return impl->last? tb_tree_map_itor_make(impl->last, impl->last->count - 1) : 0;
+}
+static tb_size_t tb_tree_map_itor_tail(tb_iterator_ref_t iterator)
+{
+    return 0;
+}
+static tb_size_t tb_tree_map_itor_next(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_assert(itor);
+
+    // the next item in the same leaf?
+    tb_tree_map_leaf_t* leaf = tb_tree_map_itor_leaf(itor);
+    if (tb_tree_map_itor_index(itor) + 1 < leaf->count) return itor + 1;
+
+    // the head item of the next leaf
+    return leaf->next? tb_tree_map_itor_make(leaf->next, 0) : 0;
+}
+static tb_size_t tb_tree_map_itor_prev(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // the tail? 
+    if (!itor) return tb_tree_map_itor_last(iterator);
+
+    // the prev item in the same leaf?
+    if (tb_tree_map_itor_index(itor)) return itor - 1;
+
+    // the last item of the prev leaf
+    tb_tree_map_leaf_t* prev = tb_tree_map_itor_leaf(itor)->prev;
+    return prev? tb_tree_map_itor_make(prev, prev->count - 1) : 0;
+}
+static tb_pointer_t tb_tree_map_itor_item(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_tree_map_impl_t* impl = (tb_tree_map_impl_t*)iterator;
+    tb_assert(impl && itor);
+
+    // the item
+    tb_tree_map_leaf_t* leaf = tb_tree_map_itor_leaf(itor);
+    tb_byte_t const*    item = tb_tree_map_leaf_item(impl, leaf, tb_tree_map_itor_index(itor));
+    tb_assert_and_check_return_val(tb_tree_map_itor_index(itor) < leaf->count, tb_null);
+
+    // save item
+    impl->item.name = impl->element_name.data(&impl->element_name, item);
+    impl->item.data = impl->element_data.data(&impl->element_data, item + impl->element_name.size);
+    return &impl->item;
+}
+static tb_void_t tb_tree_map_itor_copy(tb_iterator_ref_t iterator, tb_size_t itor, tb_cpointer_t item)
+{
+    // check
+    tb_tree_map_impl_t* impl = (tb_tree_map_impl_t*)iterator;
+    tb_assert(impl && itor);
+
+    // the leaf
+    tb_tree_map_leaf_t* leaf = tb_tree_map_itor_leaf(itor);
+
+    // note: copy data only, will destroy the order if copy name
+    impl->element_data.copy(&impl->element_data, tb_tree_map_leaf_item(impl, leaf, tb_tree_map_itor_index(itor)) + impl->element_name.size, item);
+}
+static tb_long_t tb_tree_map_itor_comp(tb_iterator_ref_t iterator, tb_cpointer_t litem, tb_cpointer_t ritem)
+{
+    // check
+    tb_tree_map_impl_t* impl = (tb_tree_map_impl_t*)iterator;
+    tb_assert(impl && impl->element_name.comp && litem && ritem);
+
+    // done
+    return impl->element_name.comp(&impl->element_name, ((tb_tree_map_item_ref_t)litem)->name, ((tb_tree_map_item_ref_t)ritem)->name);
+}
+static tb_void_t tb_tree_map_itor_remove(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_tree_map_impl_t* impl = (tb_tree_map_impl_t*)iterator;
+    tb_assert(impl && itor);
+
+    // remove it
+    tb_tree_map_remove_at(impl, tb_tree_map_itor_leaf(itor), tb_tree_map_itor_index(itor));
+}
+static tb_void_t tb_tree_map_itor_remove_range(tb_iterator_ref_t iterator, tb_size_t prev, tb_size_t next, tb_size_t size)
+{
+    // check
+    tb_tree_map_impl_t* impl = (tb_tree_map_impl_t*)iterator;
+    tb_assert(impl);
+
+    /* the next item will be moved after removing items, so we compare the name of it
+     *
+     * @note the name data of the next item is not changed because it will not be removed
+     */
+    tb_pointer_t    name = next? tb_tree_map_name(impl, tb_tree_map_leaf_item(impl, tb_tree_map_itor_leaf(next), tb_tree_map_itor_index(next))) : tb_null;
+
+    // remove items, the items before the removed item will not be moved
+    tb_size_t itor = prev? tb_tree_map_itor_next(iterator, prev) : tb_tree_map_itor_head(iterator);
+    while (itor && size--)
+    {
+        // the leaf and index
+        tb_tree_map_leaf_t* leaf = tb_tree_map_itor_leaf(itor);
+        tb_size_t           index = tb_tree_map_itor_index(itor);
+
+        // end?
+        if (next && !impl->element_name.comp(&impl->element_name, tb_tree_map_name(impl, tb_tree_map_leaf_item(impl, leaf, index)), name)) break;
+
+        // remove it
+        itor = tb_tree_map_remove_at(impl, leaf, index);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_tree_map_ref_t tb_tree_map_init(tb_size_t node_size, tb_element_t element_name, tb_element_t element_data)
+{
+    // check
+    tb_assert_and_check_return_val(element_name.size && element_name.comp && element_name.data && element_name.dupl, tb_null);
+    tb_assert_and_check_return_val(element_data.data && element_data.dupl && element_data.repl, tb_null);
+
+    // check node size
+    if (!node_size) node_size = TB_TREE_MAP_NODE_SIZE_DEFAULT;
+    tb_assert_and_check_return_val(node_size <= TB_TREE_MAP_NODE_SIZE_LARGE, tb_null);
+
+    // done
+    tb_bool_t               ok = tb_false;
+    tb_tree_map_impl_t*     impl = tb_null;
+    do
+    {
+        // make tree map
+        impl = tb_malloc0_type(tb_tree_map_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init element
+        impl->element_name = element_name;
+        impl->element_data = element_data;
+        impl->step = element_name.size + element_data.size;
+
+        // init leaf, the items count is limited by the leaf alignment 
+        impl->leaf_maxn = node_size > sizeof(tb_tree_map_leaf_t)? (node_size - sizeof(tb_tree_map_leaf_t)) / impl->step : 0;
+        if (impl->leaf_maxn < 4) impl->leaf_maxn = 4;
+        if (impl->leaf_maxn > TB_TREE_MAP_LEAF_ALIGN) impl->leaf_maxn = TB_TREE_MAP_LEAF_ALIGN;
+        impl->leaf_size = sizeof(tb_tree_map_leaf_t) + impl->leaf_maxn * impl->step;
+
+        // init inner node
+        impl->node_maxn = node_size > sizeof(tb_tree_map_node_t)? (node_size - sizeof(tb_tree_map_node_t)) / (sizeof(tb_pointer_t) + element_name.size) : 0;
+        if (impl->node_maxn < 4) impl->node_maxn = 4;
+        impl->node_size = sizeof(tb_tree_map_node_t) + impl->node_maxn * (sizeof(tb_pointer_t) + element_name.size);
+
+        // init the separator key
+        impl->sep = tb_malloc_bytes(element_name.size);
+        tb_assert_and_check_break(impl->sep);
+
+        // init the temporary children and keys
+        impl->temp = (tb_pointer_t*)tb_malloc((impl->node_maxn + 1) * sizeof(tb_pointer_t) + impl->node_maxn * element_name.size);
+        tb_assert_and_check_break(impl->temp);
+
+        // init item itor
+        impl->itor.mode             = TB_ITERATOR_MODE_FORWARD | TB_ITERATOR_MODE_REVERSE | TB_ITERATOR_MODE_MUTABLE;
+        impl->itor.priv             = tb_null;
+        impl->itor.step             = sizeof(tb_tree_map_item_t);
+        impl->itor.size             = tb_tree_map_itor_size;
+        impl->itor.head             = tb_tree_map_itor_head;
+        impl->itor.last             = tb_tree_map_itor_last;
+        impl->itor.tail             = tb_tree_map_itor_tail;
+        impl->itor.prev             = tb_tree_map_itor_prev;
+        impl->itor.next             = tb_tree_map_itor_next;
+        impl->itor.item             = tb_tree_map_itor_item;
+        impl->itor.copy             = tb_tree_map_itor_copy;
+        impl->itor.comp             = tb_tree_map_itor_comp;
+        impl->itor.remove           = tb_tree_map_itor_remove;
+        impl->itor.remove_range     = tb_tree_map_itor_remove_range;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) tb_tree_map_exit((tb_tree_map_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (tb_tree_map_ref_t)impl;
+}
+tb_void_t tb_tree_map_exit(tb_tree_map_ref_t tree_map)
+{
+    // check
+    tb_tree_map_impl_t* impl = (tb_tree_map_impl_t*)tree_map;
+    tb_assert_and_check_return(impl);
+
+    // clear it
+    tb_tree_map_clear(tree_map);
+
+    // exit the separator key
+    if (impl->sep) tb_free(impl->sep);
+    impl->sep = tb_null;
+
+    // exit the temporary buffer
+    if (impl->temp) tb_free(impl->temp);
+    impl->temp = tb_null;
+
+    // free it
+    tb_free(impl);
+}
+tb_void_t tb_tree_map_clear(tb_tree_map_ref_t tree_map)
+{
+    // check
+    tb_tree_map_impl_t* impl = (tb_tree_map_impl_t*)tree_map;
+    tb_assert_and_check_return(impl);
+
+    // exit leaves
+    tb_tree_map_leaf_t* leaf = impl->head;
+    while (leaf)
+    {
+        tb_tree_map_leaf_t* next = leaf->next;
+        tb_tree_map_leaf_exit(impl, leaf);
+        leaf = next;
+    }
+
+    // exit inner nodes
+    if (impl->root && impl->height) tb_tree_map_node_exit(impl, (tb_tree_map_node_t*)impl->root, impl->height);
+
+    // clear it
+    impl->root      = tb_null;
+    impl->height    = 0;
+    impl->head      = tb_null;
+    impl->last      = tb_null;
+    impl->size      = 0;
+    tb_memset(&impl->item, 0, sizeof(tb_tree_map_item_t));
+}
+tb_pointer_t tb_tree_map_get(tb_tree_map_ref_t tree_map, tb_cpointer_t name)
+{
+    // find it
+    tb_size_t itor = tb_tree_map_find(tree_map, name);
+    return itor? ((tb_tree_map_item_ref_t)tb_tree_map_itor_item(tree_map, itor))->data : tb_null;
+}
+tb_size_t tb_tree_map_find(tb_tree_map_ref_t tree_map, tb_cpointer_t name)
+{
+    // check
+    tb_tree_map_impl_t* impl = (tb_tree_map_impl_t*)tree_map;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // empty?
+    tb_check_return_val(impl->root, 0);
+
+    // find it
+    tb_bool_t           equal = tb_false;
+    tb_tree_map_leaf_t* leaf = tb_tree_map_node_find(impl, name, tb_null, tb_null);
+    tb_size_t           index = tb_tree_map_leaf_lower(impl, leaf, name, &equal);
+    return equal? tb_tree_map_itor_make(leaf, index) : 0;
+}
+tb_size_t tb_tree_map_lower_bound(tb_tree_map_ref_t tree_map, tb_cpointer_t name)
+{
+    // check
+    tb_tree_map_impl_t* impl = (tb_tree_map_impl_t*)tree_map;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // empty?
+    tb_check_return_val(impl->root, 0);
+
+    // find it
+    tb_tree_map_leaf_t* leaf = tb_tree_map_node_find(impl, name, tb_null, tb_null);
+    tb_size_t           index = tb_tree_map_leaf_lower(impl, leaf, name, tb_null);
+    if (index < leaf->count) return tb_tree_map_itor_make(leaf, index);
+    return leaf->next? tb_tree_map_itor_make(leaf->next, 0) : 0;
+}
+tb_size_t tb_tree_map_upper_bound(tb_tree_map_ref_t tree_map, tb_cpointer_t name)
+{
+    // check
+    tb_tree_map_impl_t* impl = (tb_tree_map_impl_t*)tree_map;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // empty?
+    tb_check_return_val(impl->root, 0);
+
+    // find it
+    tb_tree_map_leaf_t* leaf = tb_tree_map_node_find(impl, name, tb_null, tb_null);
+    tb_size_t           index = tb_tree_map_leaf_upper(impl, leaf, name);
+    if (index < leaf->count) return tb_tree_map_itor_make(leaf, index);
+    return leaf->next? tb_tree_map_itor_make(leaf->next, 0) : 0;
+}
+tb_size_t tb_tree_map_insert(tb_tree_map_ref_t tree_map, tb_cpointer_t name, tb_cpointer_t data)
+{
+    // check
+    tb_tree_map_impl_t* impl = (tb_tree_map_impl_t*)tree_map;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // init the root leaf
+    if (!impl->root)
+    {
+        tb_tree_map_leaf_t* leaf = tb_tree_map_leaf_init(impl);
+        tb_assert_and_check_return_val(leaf, 0);
+        impl->root = leaf;
+        impl->head = leaf;
+        impl->last = leaf;
+    }
+
+    // find the leaf
+    tb_tree_map_node_t* nodes[TB_TREE_MAP_DEPTH_MAXN];
+    tb_size_t           indices[TB_TREE_MAP_DEPTH_MAXN];
+    tb_bool_t           equal = tb_false;
+    tb_tree_map_leaf_t* leaf = tb_tree_map_node_find(impl, name, nodes, indices);
+    tb_size_t           index = tb_tree_map_leaf_lower(impl, leaf, name, &equal);
+
+    // replace data if the name exists
+    if (equal)
+    {
+        impl->element_data.repl(&impl->element_data, tb_tree_map_leaf_item(impl, leaf, index) + impl->element_name.size, data);
+        return tb_tree_map_itor_make(leaf, index);
+    }
+
+    // insert it directly if the leaf is not full
+    if (leaf->count < impl->leaf_maxn)
+    {
+        tb_tree_map_leaf_insert(impl, leaf, index, name, data);
+        return tb_tree_map_itor_make(leaf, index);
+    }
+
+    // check depth
+    tb_assert_and_check_return_val(impl->height + 1 < TB_TREE_MAP_DEPTH_MAXN, 0);
+
+    // make the right leaf
+    tb_tree_map_leaf_t* right = tb_tree_map_leaf_init(impl);
+    tb_assert_and_check_return_val(right, 0);
+
+    /* split the leaf
+     *
+     * appending to the last leaf (.e.g time-series) keeps the full leaf and inserts the item to the new leaf,
+     * otherwise split it into two half leaves
+     */
+    tb_size_t count = leaf->count;
+    tb_size_t split = (leaf == impl->last && index == count)? count : ((count + 1) >> 1);
+    tb_memcpy(tb_tree_map_leaf_item(impl, right, 0), tb_tree_map_leaf_item(impl, leaf, split), (count - split) * impl->step);
+    right->count = count - split;
+    leaf->count = split;
+    tb_tree_map_leaf_link(impl, right, leaf);
+
+    // insert item
+    tb_size_t itor = 0;
+    if (split < count && index <= split)
+    {
+        tb_tree_map_leaf_insert(impl, leaf, index, name, data);
+        itor = tb_tree_map_itor_make(leaf, index);
+    }
+    else
+    {
+        tb_tree_map_leaf_insert(impl, right, index - split, name, data);
+        itor = tb_tree_map_itor_make(right, index - split);
+    }
+
+    // insert the separator key and the right leaf to the parent nodes
+    impl->element_name.dupl(&impl->element_name, impl->sep, tb_tree_map_name(impl, tb_tree_map_leaf_item(impl, right, 0)));
+    if (!tb_tree_map_node_insert(impl, nodes, indices, impl->height, right)) return 0;
+
+    // ok
+    return itor;
+}
+tb_bool_t tb_tree_map_load(tb_tree_map_ref_t tree_map, tb_cpointer_t const* names, tb_cpointer_t const* datas, tb_size_t size)
+{
+    // check
+    tb_tree_map_impl_t* impl = (tb_tree_map_impl_t*)tree_map;
+    tb_assert_and_check_return_val(impl && (names || !size), tb_false);
+
+    // clear it first
+    tb_tree_map_clear(tree_map);
+    tb_check_return_val(size, tb_true);
+
+    // the names must be sorted and unique
+    tb_size_t i = 0;
+    for (i = 1; i < size; i++)
+    {
+        if (impl->element_name.comp(&impl->element_name, names[i - 1], names[i]) >= 0) return tb_false;
+    }
+
+    // the default data if no datas, .e.g the tree set
+    tb_cpointer_t   data = impl->element_data.type == TB_ELEMENT_TYPE_TRUE? tb_b2p(tb_true) : tb_null;
+
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_size_t       count = (size + impl->leaf_maxn - 1) / impl->leaf_maxn;
+    tb_size_t       level = 0;
+    tb_pointer_t*   childs = tb_null;
+    tb_cpointer_t*  firsts = tb_null;
+    do
+    {
+        // make the children and their first names of the current level
+        childs = tb_nalloc_type(count, tb_pointer_t);
+        firsts = tb_nalloc_type(count, tb_cpointer_t);
+        tb_assert_and_check_break(childs && firsts);
+
+        // make leaves, the items are distributed evenly
+        tb_size_t j = 0;
+        tb_size_t base = 0;
+        for (i = 0; i < count; i++)
+        {
+            // make leaf
+            tb_tree_map_leaf_t* leaf = tb_tree_map_leaf_init(impl);
+            tb_assert_and_check_break(leaf);
+            tb_tree_map_leaf_link(impl, leaf, impl->last);
+
+            // dupl items
+            tb_size_t n = size / count + (i < size % count);
+            for (j = 0; j < n; j++)
+            {
+                tb_byte_t* item = tb_tree_map_leaf_item(impl, leaf, j);
+                impl->element_name.dupl(&impl->element_name, item, names[base + j]);
+                impl->element_data.dupl(&impl->element_data, item + impl->element_name.size, datas? datas[base + j] : data);
+            }
+            leaf->count = n;
+            impl->size += n;
+
+            // save it
+            childs[i] = leaf;
+            firsts[i] = names[base];
+            base += n;
+        }
+        tb_check_break(i == count);
+
+        // make inner nodes from the bottom up
+        while (count > 1)
+        {
+            // the nodes count of this level
+            tb_size_t ncount = (count + impl->node_maxn - 1) / impl->node_maxn;
+
+            // make nodes, the children are distributed evenly and they are saved in place
+            base = 0;
+            for (i = 0; i < ncount; i++)
+            {
+                // make node
+                tb_tree_map_node_t* node = tb_tree_map_node_init(impl);
+                tb_assert_and_check_break(node);
+
+                // init children and keys
+                tb_size_t n = count / ncount + (i < count % ncount);
+                for (j = 0; j < n; j++)
+                {
+                    tb_tree_map_node_childs(node)[j] = childs[base + j];
+                    if (j) impl->element_name.dupl(&impl->element_name, tb_tree_map_node_key(impl, node, j - 1), firsts[base + j]);
+                }
+                node->count = n;
+
+                // save it
+                childs[i] = node;
+                firsts[i] = firsts[base];
+                base += n;
+            }
+
+            // failed? exit the made nodes and the remaining children
+            if (i < ncount)
+            {
+                tb_size_t k = 0;
+                for (k = 0; k < i; k++) tb_tree_map_node_exit(impl, (tb_tree_map_node_t*)childs[k], level + 1);
+                if (level) for (k = base; k < count; k++) tb_tree_map_node_exit(impl, (tb_tree_map_node_t*)childs[k], level);
+                break;
+            }
+
+            // the next level
+            count = ncount;
+            level++;
+        }
+        tb_check_break(count == 1);
+
+        // update root
+        impl->root   = childs[0];
+        impl->height = level;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // exit the children
+    if (childs) tb_free(childs);
+    if (firsts) tb_free(firsts);
+
+    // failed? clear the leaves
+    if (!ok) tb_tree_map_clear(tree_map);
+
+    // ok?
+    return ok;
+}
+tb_void_t tb_tree_map_remove(tb_tree_map_ref_t tree_map, tb_cpointer_t name)
+{
+    // check
+    tb_tree_map_impl_t* impl = (tb_tree_map_impl_t*)tree_map;
+    tb_assert_and_check_return(impl);
+
+    // empty?
+    tb_check_return(impl->root);
+
+    // find it
+    tb_bool_t           equal = tb_false;
+    tb_tree_map_leaf_t* leaf = tb_tree_map_node_find(impl, name, tb_null, tb_null);
+    tb_size_t           index = tb_tree_map_leaf_lower(impl, leaf, name, &equal);
+
+    // remove it
+    if (equal) tb_tree_map_remove_at(impl, leaf, index);
+}
+tb_size_t tb_tree_map_size(tb_tree_map_ref_t tree_map)
+{
+    // check
+    tb_tree_map_impl_t* impl = (tb_tree_map_impl_t*)tree_map;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the size
+    return impl->size;
+}
+tb_size_t tb_tree_map_height(tb_tree_map_ref_t tree_map)
+{
+    // check
+    tb_tree_map_impl_t* impl = (tb_tree_map_impl_t*)tree_map;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the height
+    return impl->height;
+}
+#ifdef __tb_debug__
+tb_void_t tb_tree_map_dump(tb_tree_map_ref_t tree_map)
+{
+    // check
+    tb_tree_map_impl_t* impl = (tb_tree_map_impl_t*)tree_map;
+    tb_assert_and_check_return(impl);
+
+    // trace
+    tb_trace_i("");
+    tb_trace_i("tree_map: size: %lu, height: %lu, leaf: %lu, node: %lu", impl->size, impl->height, impl->leaf_maxn, impl->node_maxn);
+
+    // done
+    tb_size_t           n = 0;
+    tb_char_t           name[4096];
+    tb_char_t           data[4096];
+    tb_tree_map_leaf_t* leaf = impl->head;
+    for (; leaf; leaf = leaf->next, n++)
+    {
+        // trace
+        tb_trace_i("leaf[%lu]: count: %lu", n, leaf->count);
+
+        // done
+        tb_size_t i = 0;
+        for (i = 0; i < leaf->count; i++)
+        {
+            // the item
+            tb_byte_t const* item = tb_tree_map_leaf_item(impl, leaf, i);
+
+            // the item name
+            tb_pointer_t element_name = impl->element_name.data(&impl->element_name, item);
+
+            // the item data
+            tb_pointer_t element_data = impl->element_data.data(&impl->element_data, item + impl->element_name.size);
+
+            // trace
+            if (impl->element_name.cstr && impl->element_data.cstr)
+            {
+                tb_trace_i("    %s => %s", impl->element_name.cstr(&impl->element_name, element_name, name, sizeof(name)), impl->element_data.cstr(&impl->element_data, element_data, data, sizeof(data)));
+            }
+            else if (impl->element_name.cstr) 
+            {
+                tb_trace_i("    %s => %p", impl->element_name.cstr(&impl->element_name, element_name, name, sizeof(name)), element_data);
+            }
+            else if (impl->element_data.cstr) 
+            {
+                tb_trace_i("    %p => %s", element_name, impl->element_data.cstr(&impl->element_data, element_data, data, sizeof(data)));
+            }
+            else 
+            {
+                tb_trace_i("    %p => %p", element_name, element_data);
+            }
+        }
+    }
+}
+#endif
@@ -0,0 +1,226 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        tree_map.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_TREE_MAP_H
+#define TB_CONTAINER_TREE_MAP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "element.h"
+#include "iterator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the small node size, two cache lines
+#define TB_TREE_MAP_NODE_SIZE_SMALL             (128)
+
+/// the default node size, eight cache lines
+#define TB_TREE_MAP_NODE_SIZE_DEFAULT           (512)
+
+/// the large node size
+#define TB_TREE_MAP_NODE_SIZE_LARGE             (4096)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the tree map item type
+typedef struct __tb_tree_map_item_t
+{
+    /// the item name
+    tb_pointer_t        name;
+
+    /// the item data
+    tb_pointer_t        data;
+
+}tb_tree_map_item_t, *tb_tree_map_item_ref_t;
+
+/*! the tree map ref type
+ *
+ * the ordered map using the b+tree, the items are stored in the leaves 
+ * and all leaves are linked for walking the items in the order of the names
+ *
+ * <pre>
+ *                       [inner: 40 | 80]
+ *                      /        |       \
+ * [leaf: 10 20 30] <=> [leaf: 40 50 60 70] <=> [leaf: 80 90]
+ * </pre>
+ *
+ * the node size is the multiple of the cache line and the leaves are aligned to the cache line,
+ * so looking up one node only touches a few continuous cache lines.
+ *
+ * inserting the name which is greater than all names (.e.g time-series) will fill the last leaf fully 
+ * instead of splitting it into two half leaves.
+ *
+ * removing items will never move the other items across the leaves, the empty nodes will be freed.
+ *
+ * @note the itor of the same item is mutable
+ */
+typedef tb_iterator_ref_t tb_tree_map_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init tree map
+ *
+ * @param node_size     the node size in bytes, using the default size if be zero
+ * @param element_name  the element for name
+ * @param element_data  the element for data
+ *
+ * @return              the tree map
+ */
+tb_tree_map_ref_t       tb_tree_map_init(tb_size_t node_size, tb_element_t element_name, tb_element_t element_data);
+
+/*! exit tree map
+ *
+ * @param tree_map      the tree map
+ */
+tb_void_t               tb_tree_map_exit(tb_tree_map_ref_t tree_map);
+
+/*! clear tree map
+ *
+ * @param tree_map      the tree map
+ */
+tb_void_t               tb_tree_map_clear(tb_tree_map_ref_t tree_map);
+
+/*! get item data from name
+ *
+ * @param tree_map      the tree map
+ * @param name          the item name
+ *
+ * @return              the item data
+ */
+tb_pointer_t            tb_tree_map_get(tb_tree_map_ref_t tree_map, tb_cpointer_t name);
+
+/*! find item from name
+ *
+ * @param tree_map      the tree map
+ * @param name          the item name
+ *
+ * @return              the item itor, not found: tb_iterator_tail(tree_map)
+ */
+tb_size_t               tb_tree_map_find(tb_tree_map_ref_t tree_map, tb_cpointer_t name);
+
+/*! find the first item whose name is not less than the given name
+ *
+ * @code
+ *
+ * // walk all items in the range: [1000, 2000)
+ * tb_size_t tail = tb_tree_map_lower_bound(tree_map, (tb_cpointer_t)2000);
+ * tb_size_t itor = tb_tree_map_lower_bound(tree_map, (tb_cpointer_t)1000);
+ * for (; itor != tail; itor = tb_iterator_next(tree_map, itor))
+ * {
+ *      tb_tree_map_item_ref_t item = (tb_tree_map_item_ref_t)tb_iterator_item(tree_map, itor);
+ *      // ...
+ * }
+ * @endcode
+ *
+ * @param tree_map      the tree map
+ * @param name          the name
+ *
+ * @return              the item itor, not found: tb_iterator_tail(tree_map)
+ */
+tb_size_t               tb_tree_map_lower_bound(tb_tree_map_ref_t tree_map, tb_cpointer_t name);
+
+/*! find the first item whose name is greater than the given name
+ *
+ * @param tree_map      the tree map
+ * @param name          the name
+ *
+ * @return              the item itor, not found: tb_iterator_tail(tree_map)
+ */
+tb_size_t               tb_tree_map_upper_bound(tb_tree_map_ref_t tree_map, tb_cpointer_t name);
+
+/*! insert item data from name
+ *
+ * @note the pair (name => data) is unique
+ *
+ * @param tree_map      the tree map
+ * @param name          the item name
+ * @param data          the item data
+ *
+ * @return              the item itor, failed: tb_iterator_tail(tree_map)
+ */
+tb_size_t               tb_tree_map_insert(tb_tree_map_ref_t tree_map, tb_cpointer_t name, tb_cpointer_t data);
+
+/*! load the sorted items and build the tree from the bottom up
+ *
+ * the old items will be cleared and all leaves will be filled fully, 
+ * it is much faster than inserting items one by one
+ *
+ * @param tree_map      the tree map
+ * @param names         the item names, must be sorted in the ascending order and unique
+ * @param datas         the item datas, using the null data (or tb_true for the tree set) if be null
+ * @param size          the items count
+ *
+ * @return              tb_true or tb_false if the names are not sorted
+ */
+tb_bool_t               tb_tree_map_load(tb_tree_map_ref_t tree_map, tb_cpointer_t const* names, tb_cpointer_t const* datas, tb_size_t size);
+
+/*! remove item from name
+ *
+ * @param tree_map      the tree map
+ * @param name          the item name
+ */
+tb_void_t               tb_tree_map_remove(tb_tree_map_ref_t tree_map, tb_cpointer_t name);
+
+/*! the tree map size
+ *
+ * @param tree_map      the tree map
+ *
+ * @return              the items count
+ */
+tb_size_t               tb_tree_map_size(tb_tree_map_ref_t tree_map);
+
+/*! the tree map height
+ *
+ * @param tree_map      the tree map
+ *
+ * @return              the levels count of the inner nodes, zero if the root is leaf
+ */
+tb_size_t               tb_tree_map_height(tb_tree_map_ref_t tree_map);
+
+#ifdef __tb_debug__
+/*! dump tree map
+ *
+ * @param tree_map      the tree map
+ */
+tb_void_t               tb_tree_map_dump(tb_tree_map_ref_t tree_map);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -0,0 +1,125 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        tree_set.c
+ * @ingroup     container
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "tree_set"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "tree_set.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the tree map itor item func type
+typedef tb_pointer_t (*tb_tree_map_item_func_t)(tb_iterator_ref_t, tb_size_t);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_pointer_t tb_tree_set_itor_item(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_assert(iterator && iterator->priv);
+
+    // the item func for the tree map
+    tb_tree_map_item_func_t func = (tb_tree_map_item_func_t)iterator->priv;
+
+    // get the item of the tree map
+    tb_tree_map_item_ref_t item = (tb_tree_map_item_ref_t)func(iterator, itor);
+    
+    // get the item of the tree set
+    return item? item->name : tb_null;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_tree_set_ref_t tb_tree_set_init(tb_size_t node_size, tb_element_t element)
+{
+    // init tree set
+    tb_iterator_ref_t tree_set = (tb_iterator_ref_t)tb_tree_map_init(node_size, element, tb_element_true());
+    tb_assert_and_check_return_val(tree_set, tb_null);
+
+    // @note the private data of the tree map iterator cannot be used
+    tb_assert(!tree_set->priv);
+
+    // hacking tree_map and hook the item
+    tree_set->priv = (tb_pointer_t)tree_set->item;
+    tree_set->item = tb_tree_set_itor_item;
+
+    // ok?
+    return (tb_tree_set_ref_t)tree_set;
+}
+tb_void_t tb_tree_set_exit(tb_tree_set_ref_t tree_set)
+{
+    tb_tree_map_exit((tb_tree_map_ref_t)tree_set);
+}
+tb_void_t tb_tree_set_clear(tb_tree_set_ref_t tree_set)
+{
+    tb_tree_map_clear((tb_tree_map_ref_t)tree_set);
+}
+tb_bool_t tb_tree_set_get(tb_tree_set_ref_t tree_set, tb_cpointer_t data)
+{
+    return tb_tree_map_find((tb_tree_map_ref_t)tree_set, data) != 0;
+}
+tb_size_t tb_tree_set_find(tb_tree_set_ref_t tree_set, tb_cpointer_t data)
+{
+    return tb_tree_map_find((tb_tree_map_ref_t)tree_set, data);
+}
+tb_size_t tb_tree_set_lower_bound(tb_tree_set_ref_t tree_set, tb_cpointer_t data)
+{
+    return tb_tree_map_lower_bound((tb_tree_map_ref_t)tree_set, data);
+}
+tb_size_t tb_tree_set_upper_bound(tb_tree_set_ref_t tree_set, tb_cpointer_t data)
+{
+    return tb_tree_map_upper_bound((tb_tree_map_ref_t)tree_set, data);
+}
+tb_size_t tb_tree_set_insert(tb_tree_set_ref_t tree_set, tb_cpointer_t data)
+{
+    return tb_tree_map_insert((tb_tree_map_ref_t)tree_set, data, tb_b2p(tb_true));
+}
+tb_bool_t tb_tree_set_load(tb_tree_set_ref_t tree_set, tb_cpointer_t const* datas, tb_size_t size)
+{
+    return tb_tree_map_load((tb_tree_map_ref_t)tree_set, datas, tb_null, size);
+}
+tb_void_t tb_tree_set_remove(tb_tree_set_ref_t tree_set, tb_cpointer_t data)
+{
+    tb_tree_map_remove((tb_tree_map_ref_t)tree_set, data);
+}
+tb_size_t tb_tree_set_size(tb_tree_set_ref_t tree_set)
+{
+    return tb_tree_map_size((tb_tree_map_ref_t)tree_set);
+}
+#ifdef __tb_debug__
+tb_void_t tb_tree_set_dump(tb_tree_set_ref_t tree_set)
+{
+    tb_tree_map_dump((tb_tree_map_ref_t)tree_set);
+}
+#endif
@@ -0,0 +1,170 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        tree_set.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_TREE_SET_H
+#define TB_CONTAINER_TREE_SET_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "tree_map.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the small node size
+#define TB_TREE_SET_NODE_SIZE_SMALL             TB_TREE_MAP_NODE_SIZE_SMALL
+
+/// the default node size
+#define TB_TREE_SET_NODE_SIZE_DEFAULT           TB_TREE_MAP_NODE_SIZE_DEFAULT
+
+/// the large node size
+#define TB_TREE_SET_NODE_SIZE_LARGE             TB_TREE_MAP_NODE_SIZE_LARGE
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the tree set ref type, the ordered set using the b+tree
+ *
+ * @note the itor of the same item is mutable
+ */
+typedef tb_iterator_ref_t tb_tree_set_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init tree set
+ *
+ * @param node_size     the node size in bytes, using the default size if be zero
+ * @param element       the element
+ *
+ * @return              the tree set
+ */
+tb_tree_set_ref_t       tb_tree_set_init(tb_size_t node_size, tb_element_t element);
+
+/*! exit tree set
+ *
+ * @param tree_set      the tree set
+ */
+tb_void_t               tb_tree_set_exit(tb_tree_set_ref_t tree_set);
+
+/*! clear tree set
+ *
+ * @param tree_set      the tree set
+ */
+tb_void_t               tb_tree_set_clear(tb_tree_set_ref_t tree_set);
+
+/*! get item?
+ *
+ * @param tree_set      the tree set
+ * @param data          the item data
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_tree_set_get(tb_tree_set_ref_t tree_set, tb_cpointer_t data);
+
+/*! find item 
+ *
+ * @param tree_set      the tree set
+ * @param data          the item data
+ *
+ * @return              the item itor, not found: tb_iterator_tail(tree_set)
+ */
+tb_size_t               tb_tree_set_find(tb_tree_set_ref_t tree_set, tb_cpointer_t data);
+
+/*! find the first item which is not less than the given data
+ *
+ * @param tree_set      the tree set
+ * @param data          the item data
+ *
+ * @return              the item itor, not found: tb_iterator_tail(tree_set)
+ */
+tb_size_t               tb_tree_set_lower_bound(tb_tree_set_ref_t tree_set, tb_cpointer_t data);
+
+/*! find the first item which is greater than the given data
+ *
+ * @param tree_set      the tree set
+ * @param data          the item data
+ *
+ * @return              the item itor, not found: tb_iterator_tail(tree_set)
+ */
+tb_size_t               tb_tree_set_upper_bound(tb_tree_set_ref_t tree_set, tb_cpointer_t data);
+
+/*! insert item
+ *
+ * @note each item is unique
+ *
+ * @param tree_set      the tree set
+ * @param data          the item data
+ *
+ * @return              the item itor, failed: tb_iterator_tail(tree_set)
+ */
+tb_size_t               tb_tree_set_insert(tb_tree_set_ref_t tree_set, tb_cpointer_t data);
+
+/*! load the sorted items and build the tree from the bottom up
+ *
+ * @param tree_set      the tree set
+ * @param datas         the item datas, must be sorted in the ascending order and unique
+ * @param size          the items count
+ *
+ * @return              tb_true or tb_false if the datas are not sorted
+ */
+tb_bool_t               tb_tree_set_load(tb_tree_set_ref_t tree_set, tb_cpointer_t const* datas, tb_size_t size);
+
+/*! remove item
+ *
+ * @param tree_set      the tree set
+ * @param data          the item data
+ */
+tb_void_t               tb_tree_set_remove(tb_tree_set_ref_t tree_set, tb_cpointer_t data);
+
+/*! the tree set size
+ *
+ * @param tree_set      the tree set
+ *
+ * @return              the tree set size
+ */
+tb_size_t               tb_tree_set_size(tb_tree_set_ref_t tree_set);
+
+#ifdef __tb_debug__
+/*! dump tree set
+ *
+ * @param tree_set      the tree set
+ */
+tb_void_t               tb_tree_set_dump(tb_tree_set_ref_t tree_set);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -34,6 +34,7 @@
 #include "../string/string.h"
 #include "../../algorithm/algorithm.h"
 #include "../../container/container.h"
+#include "../../platform/atomic.h"
 #include "printf_object.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -64,6 +65,9 @@ static tb_size_t                    g_size = 0;
 // the entry maxn
 static tb_size_t                    g_maxn = 16;
 
+// the generation, it will be increased after registering the printf object func
+static tb_atomic_t                  g_generation = 0;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -121,6 +125,13 @@ tb_void_t tb_printf_object_register(tb_char_t const* name, tb_printf_object_func
         // update size
         g_size++;
     }
+
+    // the cached formats with the old funcs need be recompiled
+    tb_atomic_fetch_and_inc(&g_generation);
+}
+tb_size_t tb_printf_object_generation(tb_noarg_t)
+{
+    return (tb_size_t)tb_atomic_get(&g_generation);
 }
 tb_printf_object_func_t tb_printf_object_find(tb_char_t const* name)
 {
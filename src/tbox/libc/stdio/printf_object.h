@@ -105,6 +105,15 @@ tb_void_t               tb_printf_object_register(tb_char_t const* name, tb_prin
  */
 tb_printf_object_func_t tb_printf_object_find(tb_char_t const* name);
 
+/*! the generation of the printf object funcs
+ *
+ * it will be changed after calling tb_printf_object_register, 
+ * the cached formats need be recompiled if it is changed.
+ *
+ * @return              the generation
+ */
+tb_size_t               tb_printf_object_generation(tb_noarg_t);
+
 /*! exit the printf object
  */
 tb_void_t               tb_printf_object_exit(tb_noarg_t);
@@ -67,6 +67,13 @@ do \
  \
 } while (0) 
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the compiled printf format ref type
+typedef struct{}*   tb_printf_format_ref_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -225,6 +232,54 @@ tb_long_t           tb_snprintf(tb_char_t* s, tb_size_t n, tb_char_t const* form
  */
 tb_long_t           tb_vsnprintf(tb_char_t* s, tb_size_t n, tb_char_t const* format, tb_va_list_t args);
 
+/*! compile the format string for tb_printf_format_snprintf
+ *
+ * the format will be parsed only once and the printf objects will be found when compiling it,
+ * tb_vsnprintf also compiles and caches the recently used formats with the printf objects for the current thread.
+ * the cached formats will be recompiled after tb_printf_object_register, but the compiled format need be compiled again.
+ *
+ * @param format    the format string, it will be copied
+ *
+ * @return          the compiled format, tb_null if some printf objects are not registered
+ *
+ * @code
+ * tb_printf_format_ref_t format = tb_printf_format_compile("%s: %s\r\n");
+ * if (format)
+ * {
+ *     tb_printf_format_snprintf(data, sizeof(data), format, "Host", "www.xxx.com");
+ *     tb_printf_format_exit(format);
+ * }
+ * @endcode
+ */
+tb_printf_format_ref_t tb_printf_format_compile(tb_char_t const* format);
+
+/*! exit the compiled format
+ *
+ * @param self      the compiled format
+ */
+tb_void_t           tb_printf_format_exit(tb_printf_format_ref_t self);
+
+/*! snprintf with the compiled format
+ *
+ * @param s         the string data
+ * @param n         the string size
+ * @param self      the compiled format
+ * 
+ * @return          the real size
+ */
+tb_long_t           tb_printf_format_snprintf(tb_char_t* s, tb_size_t n, tb_printf_format_ref_t self, ...);
+
+/*! vsnprintf with the compiled format
+ *
+ * @param s         the string data
+ * @param n         the string size
+ * @param self      the compiled format
+ * @param args      the arguments
+ * 
+ * @return          the real size
+ */
+tb_long_t           tb_printf_format_vsnprintf(tb_char_t* s, tb_size_t n, tb_printf_format_ref_t self, tb_va_list_t args);
+
 /*! swprintf
  *
  * @param s         the string data
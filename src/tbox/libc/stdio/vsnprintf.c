@@ -32,6 +32,26 @@
 #include "../../utils/utils.h"
 #include "../string/string.h"
 #include "printf_object.h"
+#include "../stdlib/impl/dtoa.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the printf format cache maxn of each thread
+#define TB_PRINTF_CACHE_MAXN            (8)
+
+// the maximum format size of the cached format
+#define TB_PRINTF_CACHE_DATA_MAXN       (128)
+
+// the maximum op count of the cached format
+#define TB_PRINTF_CACHE_OPS_MAXN        (24)
+
+// the field width from the arguments
+#define TB_PRINTF_ARGS_WIDTH            (1)
+
+// the precision from the arguments
+#define TB_PRINTF_ARGS_PRECISION        (2)
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -62,6 +82,7 @@ typedef enum __tb_printf_extra_t
 ,   TB_PRINTF_EXTRA_UPPER           = 2     // upper case for %X %B
 ,   TB_PRINTF_EXTRA_PERCENT         = 4     // percent char: %
 ,   TB_PRINTF_EXTRA_EXP             = 8     // exponent form: [-]d.ddd e[+/-]ddd
+,   TB_PRINTF_EXTRA_GENERAL         = 16    // general form: %e or %f with the trailing zeros removed
 
 }tb_printf_extra_t;
 
@@ -114,11 +135,93 @@ typedef struct __tb_printf_entry_t
     // base: 2 8 10 16 
     tb_int_t            base;
 
-    // the object name
-    tb_char_t           object[TB_PRINTF_OBJECT_NAME_MAXN];
+    // the object func
+    tb_printf_object_func_t object;
 
 }tb_printf_entry_t;
 
+// the printf op
+typedef struct __tb_printf_op_t
+{
+    // the format entry
+    tb_printf_entry_t   e;
+
+    // the literal offset in the format string for the none type
+    tb_uint32_t         offset;
+
+    // the literal size in the format string for the none type
+    tb_uint32_t         size;
+
+    // the field width and precision from the arguments, e.g. %*.*d
+    tb_uint8_t          args;
+
+}tb_printf_op_t;
+
+// the printf format
+typedef struct __tb_printf_format_t
+{
+    // the format string
+    tb_char_t const*    fmt;
+
+    // the op count
+    tb_size_t           opn;
+
+    // the ops
+    tb_printf_op_t      ops[1];
+
+}tb_printf_format_t;
+
+#ifdef __tb_thread_local__
+// the printf format cache item
+typedef struct __tb_printf_cache_item_t
+{
+    // the reference count for the nested printf, e.g. the printf object
+    tb_uint16_t         refn;
+
+    // the op count, only the format pointer is cached if it cannot be compiled
+    tb_uint16_t         opn;
+
+    // the format string copy for checking whether the format at this pointer has been changed
+    tb_char_t           data[TB_PRINTF_CACHE_DATA_MAXN];
+
+    // the ops
+    tb_printf_op_t      ops[TB_PRINTF_CACHE_OPS_MAXN];
+
+}tb_printf_cache_item_t;
+
+// the printf format cache
+typedef struct __tb_printf_cache_t
+{
+    // the tick
+    tb_size_t               tick;
+
+    // the item count
+    tb_size_t               size;
+
+    // the generation of the printf object funcs for compiling the items
+    tb_size_t               generation;
+
+    // the format string pointers of the items
+    tb_char_t const*        fmts[TB_PRINTF_CACHE_MAXN];
+
+    // the last used ticks of the items
+    tb_size_t               ticks[TB_PRINTF_CACHE_MAXN];
+
+    // the items
+    tb_printf_cache_item_t  items[TB_PRINTF_CACHE_MAXN];
+
+}tb_printf_cache_t;
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+#ifdef __tb_thread_local__
+// the recently used formats of the current thread
+static __tb_thread_local__ tb_printf_cache_t    g_cache;
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -130,8 +233,8 @@ static tb_int_t tb_skip_atoi(tb_char_t const** s)
 }
 static tb_char_t* tb_printf_object(tb_char_t* pb, tb_char_t* pe, tb_printf_entry_t e, tb_cpointer_t object)
 {
-    // find the object func
-    tb_printf_object_func_t func = tb_printf_object_find(e.object);
+    // the object func has been found when parsing the format
+    tb_printf_object_func_t func = e.object;
     if (func)
     {
         // printf it
@@ -160,7 +263,7 @@ static tb_char_t* tb_printf_object(tb_char_t* pb, tb_char_t* pe, tb_printf_entry
 
     return pb;
 }
-static tb_char_t* tb_printf_string(tb_char_t* pb, tb_char_t* pe, tb_printf_entry_t e, tb_char_t const* s)
+static __tb_inline_force__ tb_char_t* tb_printf_string(tb_char_t* pb, tb_char_t* pe, tb_printf_entry_t e, tb_char_t const* s)
 {
     // done
     if (s)
@@ -195,7 +298,7 @@ static tb_char_t* tb_printf_string(tb_char_t* pb, tb_char_t* pe, tb_printf_entry
 
     return pb;
 }
-static tb_char_t* tb_printf_int64(tb_char_t* pb, tb_char_t* pe, tb_printf_entry_t e, tb_uint64_t num)
+static __tb_inline_force__ tb_char_t* tb_printf_int64(tb_char_t* pb, tb_char_t* pe, tb_printf_entry_t e, tb_uint64_t num)
 {
     // digits table
     static tb_char_t const* digits_table = "0123456789ABCDEF";
@@ -337,7 +440,7 @@ static tb_char_t* tb_printf_int64(tb_char_t* pb, tb_char_t* pe, tb_printf_entry_
 
     return pb;
 }
-static tb_char_t* tb_printf_int32(tb_char_t* pb, tb_char_t* pe, tb_printf_entry_t e, tb_uint32_t num)
+static __tb_inline_force__ tb_char_t* tb_printf_int32(tb_char_t* pb, tb_char_t* pe, tb_printf_entry_t e, tb_uint32_t num)
 {
     // digits table
     static tb_char_t const* digits_table = "0123456789ABCDEF";
@@ -479,15 +582,10 @@ static tb_char_t* tb_printf_int32(tb_char_t* pb, tb_char_t* pe, tb_printf_entry_
     return pb;
 }
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
-static tb_char_t* tb_printf_float(tb_char_t* pb, tb_char_t* pe, tb_printf_entry_t e, tb_float_t num)
+static tb_char_t* tb_printf_double(tb_char_t* pb, tb_char_t* pe, tb_printf_entry_t e, tb_double_t num)
 {
-    // digits
-    tb_char_t   ints[32] = {0};
-    tb_char_t   decs[32] = {0};
-    tb_int_t    ints_i = 0, decs_i = 0;
-
     // for inf nan
-    if (tb_isinff(num))
+    if (tb_isinf(num))
     {
         if (pb < pe && num < 0) *pb++ = '-';
         if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'I' : 'i';
@@ -495,7 +593,7 @@ static tb_char_t* tb_printf_float(tb_char_t* pb, tb_char_t* pe, tb_printf_entry_
         if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'F' : 'f';
         return pb;
     }
-    else if (tb_isnanf(num))
+    else if (tb_isnan(num))
     {
         if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'N' : 'n';
         if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'A' : 'a';
@@ -503,11 +601,12 @@ static tb_char_t* tb_printf_float(tb_char_t* pb, tb_char_t* pe, tb_printf_entry_
         return pb;
     }
 
-    // sign: + -
+    // sign: + -, -0.0 is negative too
+    tb_ieee_double_t conv; conv.d = num;
     tb_char_t sign = 0;
     if (e.extra & TB_PRINTF_EXTRA_SIGNED)
     {
-        if (num < 0) 
+        if (conv.i.h >> 31) 
         {
             sign = '-';
             --e.width;
@@ -519,56 +618,47 @@ static tb_char_t* tb_printf_float(tb_char_t* pb, tb_char_t* pe, tb_printf_entry_
         }
     }
 
-    // adjust sign
-    if (num < 0) num = -num;
-
     // default precision: 6
-    if (e.precision <= 0) e.precision = 6;
-
-    // round? i.dddddddd5 => i.ddddddde
-    tb_uint32_t p = 1;
-    tb_size_t   n = e.precision;
-    while (n--) p *= 10;
-    if (((tb_uint32_t)(num * p * 10) % 10) > 4) 
-        num += 1.0f / (tb_float_t)p;
-
-    // get integer & decimal
-    tb_int32_t integer = (tb_int32_t)num;
-    tb_float_t decimal = num - integer;
-
-    // convert integer => digits string in reverse order
-    if (integer == 0) ints[ints_i++] = '0';
-    else 
+    if (e.precision < 0) e.precision = 6;
+
+    /* make the exact decimal digits with the correct rounding
+     *
+     * the value is 0.d1d2...dn * 10^decpt, the omitted trailing digits are zeros
+     */
+    tb_char_t   digits[TB_DTOA_EXACT_MAXN];
+    tb_int_t    decpt = 1;
+    tb_int_t    ndigits = 0;
+    tb_int_t    precision = e.precision;
+    tb_bool_t   expform = (e.extra & TB_PRINTF_EXTRA_EXP)? tb_true : tb_false;
+    if (e.extra & TB_PRINTF_EXTRA_GENERAL)
     {
-        if (integer < 0) integer = -integer; 
-        do 
+        // %g: the p significant digits, it uses the exponent form if x < -4 or x >= p
+        tb_int_t p = precision? precision : 1;
+        ndigits = (tb_int_t)tb_dtoa_exact(num, TB_DTOA_MODE_EXP, p, digits, sizeof(digits), &decpt);
+        expform = (decpt - 1 < -4 || decpt - 1 >= p)? tb_true : tb_false;
+        precision = expform? p - 1 : p - decpt;
+
+        // remove the trailing zeros if no '#'
+        if (!(e.flags & TB_PRINTF_FLAG_PFIX))
         {
-            ints[ints_i++] = (integer % 10) + '0';
-            integer /= 10;
+            tb_int_t n = expform? ndigits - 1 : ndigits - decpt;
+            if (precision > n) precision = n > 0? n : 0;
         }
-        while (integer);
     }
+    else if (expform) ndigits = (tb_int_t)tb_dtoa_exact(num, TB_DTOA_MODE_EXP, precision + 1, digits, sizeof(digits), &decpt);
+    else ndigits = (tb_int_t)tb_dtoa_exact(num, TB_DTOA_MODE_FIXED, precision, digits, sizeof(digits), &decpt);
 
-    // convert decimal => digits string in positive order
-    if (decimal == 0) decs[decs_i++] = '0';
-    else 
-    {
-        tb_long_t d = (tb_long_t)(decimal * 10);
-        do 
-        {
-            decs[decs_i++] = (tb_char_t)(d + (tb_long_t)'0');
-            decimal = decimal * 10 - d;
-            d = (tb_long_t)(decimal * 10);
-        }
-        while (decs_i < e.precision);
-    }
+    // the exponent for the exponent form
+    tb_int_t x = decpt - 1;
+    tb_int_t xabs = x < 0? -x : x;
+    tb_int_t xlen = xabs < 100? 2 : (xabs < 1000? 3 : 4);
 
-    // adjust precision
-    if (decs_i > e.precision) 
-        decs_i = e.precision;
+    // the body size
+    tb_bool_t   point = (precision || (e.flags & TB_PRINTF_FLAG_PFIX))? tb_true : tb_false;
+    tb_int_t    size = (expform? 1 + 2 + xlen : (decpt > 0? decpt : 1)) + (point? 1 + precision : 0);
 
     // fill spaces at left side, e.g. "   0.31415926"
-    e.width -= (tb_int_t)(ints_i + 1 + e.precision);
+    e.width -= size;
     if (!(e.flags & (TB_PRINTF_FLAG_LEFT + TB_PRINTF_FLAG_ZERO)))
     {
         while (--e.width >= 0)
@@ -586,152 +676,39 @@ static tb_char_t* tb_printf_float(tb_char_t* pb, tb_char_t* pe, tb_printf_entry_
             if (pb < pe) *pb++ = c;
     }
 
-    // append integer
-    while (--ints_i >= 0) 
-        if (pb < pe) *pb++ = ints[ints_i];
-
-    // append .
-    if (pb < pe) *pb++ = '.';
-
-    // append decimal
-    tb_int_t decs_n = decs_i;
-    while (--decs_i >= 0) 
-        if (pb < pe) *pb++ = decs[decs_n - decs_i - 1];
-
-    // fill 0 if precision is larger, e.g. "0.3140000"
-    while (decs_n <= --e.precision) 
-        if (pb < pe) *pb++ = '0';
-
-    // trailing space padding for left-justified flags, e.g. "0.31415926   "
-    while (--e.width >= 0)
-        if (pb < pe) *pb++ = ' ';
-
-    return pb;
-}
-static tb_char_t* tb_printf_double(tb_char_t* pb, tb_char_t* pe, tb_printf_entry_t e, tb_double_t num)
-{
-    // digits
-    tb_char_t   ints[64] = {0};
-    tb_char_t   decs[64] = {0};
-    tb_int_t    ints_i = 0, decs_i = 0;
-
-    // for inf nan
-    if (tb_isinf(num))
-    {
-        if (pb < pe && num < 0) *pb++ = '-';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'I' : 'i';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'N' : 'n';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'F' : 'f';
-        return pb;
-    }
-    else if (tb_isnan(num))
-    {
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'N' : 'n';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'A' : 'a';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'N' : 'n';
-        return pb;
-    }
-
-
-    // sign: + -
-    tb_char_t sign = 0;
-    if (e.extra & TB_PRINTF_EXTRA_SIGNED)
-    {
-        if (num < 0) 
-        {
-            sign = '-';
-            --e.width;
-        }
-        else if (e.flags & TB_PRINTF_FLAG_PLUS)
-        {
-            sign = '+';
-            --e.width;
-        }
-    }
-
-    // adjust sign
-    if (num < 0) num = -num;
-
-    // default precision: 6
-    if (e.precision <= 0) e.precision = 6;
-
-    // round? i.dddddddd5 => i.ddddddde
-    tb_uint64_t p = 1;
-    tb_size_t   n = e.precision;
-    while (n--) p *= 10;
-    if (((tb_uint64_t)(num * p * 10) % 10) > 4) 
-        num += 1. / (tb_double_t)p;
-
-    // get integer & decimal
-    tb_int64_t integer = (tb_int64_t)num;
-    tb_double_t decimal = num - integer;
-
-    // convert integer => digits string in reverse order
-    if (integer == 0) ints[ints_i++] = '0';
-    else 
+    // append the digits
+    tb_int_t i = 0;
+    if (expform)
     {
-        if (integer < 0) integer = -integer; 
-        do 
+        // d.ddde+xx
+        if (pb < pe) *pb++ = ndigits? digits[0] : '0';
+        if (point && pb < pe) *pb++ = '.';
+        for (i = 1; i <= precision; i++)
+            if (pb < pe) *pb++ = i < ndigits? digits[i] : '0';
+        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'E' : 'e';
+        if (pb < pe) *pb++ = x < 0? '-' : '+';
+        for (i = xlen - 1; i >= 0; i--)
         {
-            ints[ints_i++] = (integer % 10) + '0';
-            integer /= 10;
+            tb_int_t d = xabs;
+            tb_int_t j = i;
+            while (j--) d /= 10;
+            if (pb < pe) *pb++ = (tb_char_t)('0' + d % 10);
         }
-        while (integer);
     }
-
-    // convert decimal => digits string in positive order
-    if (decimal == 0) decs[decs_i++] = '0';
-    else 
+    else
     {
-        tb_long_t d = (tb_long_t)(decimal * 10);
-        do 
+        // ddd.ddd
+        if (decpt > 0) 
         {
-            decs[decs_i++] = (tb_char_t)(d + (tb_long_t)'0');
-            decimal = decimal * 10 - d;
-            d = (tb_long_t)(decimal * 10);
+            for (i = 0; i < decpt; i++)
+                if (pb < pe) *pb++ = i < ndigits? digits[i] : '0';
         }
-        while (decs_i < e.precision);
-    }
-
-    // adjust precision
-    if (decs_i > e.precision) 
-        decs_i = e.precision;
-
-    // fill spaces at left side, e.g. "   0.31415926"
-    e.width -= (tb_int_t)(ints_i + 1 + e.precision);
-    if (!(e.flags & (TB_PRINTF_FLAG_LEFT + TB_PRINTF_FLAG_ZERO)))
-    {
-        while (--e.width >= 0)
-            if (pb < pe) *pb++ = ' ';
-    }
-
-    // append sign: + / -
-    if (sign && (pb < pe)) *pb++ = sign;
-
-    // fill 0 or spaces, e.g. "00003.1415926"
-    if (!(e.flags & TB_PRINTF_FLAG_LEFT))
-    {
-        tb_char_t c = (e.flags & TB_PRINTF_FLAG_ZERO)? '0' : ' ';
-        while (--e.width >= 0)
-            if (pb < pe) *pb++ = c;
+        else if (pb < pe) *pb++ = '0';
+        if (point && pb < pe) *pb++ = '.';
+        for (i = decpt; i < decpt + precision; i++)
+            if (pb < pe) *pb++ = (i >= 0 && i < ndigits)? digits[i] : '0';
     }
 
-    // append integer
-    while (--ints_i >= 0) 
-        if (pb < pe) *pb++ = ints[ints_i];
-
-    // append .
-    if (pb < pe) *pb++ = '.';
-
-    // append decimal
-    tb_int_t decs_n = decs_i;
-    while (--decs_i >= 0) 
-        if (pb < pe) *pb++ = decs[decs_n - decs_i - 1];
-
-    // fill 0 if precision is larger, e.g. "0.3140000"
-    while (decs_n <= --e.precision) 
-        if (pb < pe) *pb++ = '0';
-
     // trailing space padding for left-justified flags, e.g. "0.31415926   "
     while (--e.width >= 0)
         if (pb < pe) *pb++ = ' ';
@@ -739,8 +716,8 @@ static tb_char_t* tb_printf_double(tb_char_t* pb, tb_char_t* pe, tb_printf_entry
     return pb;
 }
 #endif
-// get a printf format entry
-static tb_int_t tb_printf_entry(tb_char_t const* fmt, tb_printf_entry_t* e)
+// get a printf format entry, force to inline it for parsing the uncached format in tb_printf_done
+static __tb_inline_force__ tb_int_t tb_printf_entry(tb_char_t const* fmt, tb_printf_entry_t* e)
 {
     tb_char_t const* p = fmt;
 
@@ -811,6 +788,7 @@ get_precision:
     if (*p == '.')
     {
         ++p;
+        e->precision = 0;
         if (tb_isdigit(*p)) 
         {
             e->precision = tb_skip_atoi(&p);
@@ -923,18 +901,27 @@ get_qualifier:
         e->extra |= TB_PRINTF_EXTRA_SIGNED;
         e->extra |= TB_PRINTF_EXTRA_EXP;
         break;
+    case 'G':
+        e->extra |= TB_PRINTF_EXTRA_UPPER;
+    case 'g':
+        e->type = TB_PRINTF_TYPE_FLOAT;
+        e->extra |= TB_PRINTF_EXTRA_SIGNED;
+        e->extra |= TB_PRINTF_EXTRA_GENERAL;
+        break;
 #endif
     case '{':
         {
             // get the object name
             ++p;
+            tb_char_t name[TB_PRINTF_OBJECT_NAME_MAXN];
             tb_size_t indx = 0;
-            tb_size_t maxn = tb_arrayn(e->object);
-            while (*p && *p != '}' && indx < maxn - 1) e->object[indx++] = *p++;
-            e->object[indx] = '\0';
+            tb_size_t maxn = tb_arrayn(name);
+            while (*p && *p != '}' && indx < maxn - 1) name[indx++] = *p++;
+            name[indx] = '\0';
 
-            // save the object type
+            // save the object type and find the object func
             e->type = *p == '}'? TB_PRINTF_TYPE_OBJECT : TB_PRINTF_TYPE_INVALID;
+            e->object = e->type == TB_PRINTF_TYPE_OBJECT? tb_printf_object_find(name) : tb_null;
         }
         break;
     default:
@@ -945,47 +932,115 @@ get_qualifier:
     return (tb_int_t)(++p - fmt);
 }
 
-/* //////////////////////////////////////////////////////////////////////////////////////
- * implementation
- */
-tb_long_t tb_vsnprintf(tb_char_t* s, tb_size_t n, tb_char_t const* fmt, tb_va_list_t args)
+// make a printf op from the format string at p
+static tb_size_t tb_printf_op_make(tb_char_t const* fmt, tb_char_t const* p, tb_printf_op_t* op)
 {
-    // check
-    if (!n || !s || !fmt) return 0;
+    // init op
+    tb_char_t const* b = p;
+    op->e.type      = TB_PRINTF_TYPE_NONE;
+    op->offset      = (tb_uint32_t)(p - fmt);
+    op->size        = 0;
+    op->args        = 0;
+
+    // get an entry
+    p += tb_printf_entry(p, &op->e);
+
+    // the field width or precision is the next argument? continue to get the remaining entry
+    while (op->e.type == TB_PRINTF_TYPE_WIDTH || op->e.type == TB_PRINTF_TYPE_PRECISION)
+    {
+        // mark it
+        if (op->e.type == TB_PRINTF_TYPE_WIDTH)
+        {
+            op->args |= TB_PRINTF_ARGS_WIDTH;
+            op->e.width = 0;
+        }
+        else
+        {
+            op->args |= TB_PRINTF_ARGS_PRECISION;
+            op->e.precision = 0;
+        }
 
-    tb_char_t* pb = s;
-    tb_char_t* pe = s + n;
+        // end? only eat the argument
+        if (!*p) 
+        {
+            op->e.type = TB_PRINTF_TYPE_NONE;
+            return (tb_size_t)(p - b);
+        }
 
-#if 0
-    // pe must be larger than pb
-    if (pe < pb) 
-    {
-        pe = ((tb_char_t*)-1);
-        n = (tb_size_t)(pe - pb);
+        // get the remaining entry
+        p += tb_printf_entry(p, &op->e);
     }
-#endif
 
-    // parse format
-    tb_printf_entry_t e = {0};
-    tb_int_t en = 0;
-    while (*fmt)
+    // save the literal size
+    if (op->e.type == TB_PRINTF_TYPE_NONE) op->size = (tb_uint32_t)(p - b);
+
+    // ok
+    return (tb_size_t)(p - b);
+}
+/* done the printf ops
+ *
+ * @param ops       the compiled ops
+ * @param compiled  done the compiled ops or parse and done the format string directly
+ * @param pobject   mark whether the parsed format contains the printf objects
+ *
+ * @note force to inline it for specializing the parsing and compiled loops
+ */
+static __tb_inline_force__ tb_long_t tb_printf_done(tb_char_t* s, tb_size_t n, tb_char_t const* fmt, tb_printf_op_t const* ops, tb_size_t opn, tb_bool_t compiled, tb_bool_t* pobject, tb_va_list_t args)
+{
+    tb_printf_entry_t       e = {0};
+    tb_printf_op_t const*   oe = compiled? ops + opn : tb_null;
+    tb_char_t const*        p = fmt;
+    tb_char_t const*        lit = tb_null;
+    tb_size_t               litn = 0;
+    tb_char_t*              pb = s;
+    tb_char_t*              pe = s + n;
+    while (1)
     {
-        tb_char_t const* ofmt = fmt;
+        // get the next compiled op
+        if (compiled)
+        {
+            if (ops == oe) break;
+            e       = ops->e;
+            lit     = fmt + ops->offset;
+            litn    = ops->size;
 
-        // get an entry
-        en = tb_printf_entry(fmt, &e);
-        fmt += en;
+            // get the field width and precision from the arguments
+            if (ops->args & TB_PRINTF_ARGS_WIDTH)
+            {
+                e.width = tb_va_arg(args, tb_int_t);
+                if (e.width < 0) 
+                {
+                    e.width = -e.width;
+                    e.flags |= TB_PRINTF_FLAG_LEFT;
+                }
+            }
+            if (ops->args & TB_PRINTF_ARGS_PRECISION)
+            {
+                e.precision = tb_va_arg(args, tb_int_t);
+                if (e.precision < 0) e.precision = 0;
+            }
+            ops++;
+        }
+        // get an entry from the format string
+        else
+        {
+            if (!*p) break;
+            lit     = p;
+            litn    = (tb_size_t)tb_printf_entry(p, &e);
+            p       += litn;
+        }
 
+        // done
         switch (e.type)
         {
             // copy it if none type
         case TB_PRINTF_TYPE_NONE:
             {
-                tb_int_t copy_n = en;
+                tb_size_t copy_n = litn;
                 if (pb < pe) 
                 {
-                    if (copy_n > pe - pb) copy_n = (tb_int_t)(pe - pb);
-                    tb_memcpy(pb, ofmt, copy_n);
+                    if (copy_n > (tb_size_t)(pe - pb)) copy_n = (tb_size_t)(pe - pb);
+                    tb_memcpy(pb, lit, copy_n);
                     pb += copy_n;
                 }
                 break;
@@ -1083,7 +1138,7 @@ tb_long_t tb_vsnprintf(tb_char_t* s, tb_size_t n, tb_char_t const* fmt, tb_va_li
                 else 
                 {
                     tb_float_t num = (tb_float_t)tb_va_arg(args, tb_double_t);
-                    pb = tb_printf_float(pb, pe, e, num);
+                    pb = tb_printf_double(pb, pe, e, num);
                 }
                 break;
             }
@@ -1092,6 +1147,7 @@ tb_long_t tb_vsnprintf(tb_char_t* s, tb_size_t n, tb_char_t const* fmt, tb_va_li
         case TB_PRINTF_TYPE_OBJECT:
             {
                 pb = tb_printf_object(pb, pe, e, tb_va_arg(args, tb_cpointer_t));
+                if (pobject) *pobject = tb_true;
                 break;
             }
         case TB_PRINTF_TYPE_INVALID:
@@ -1107,4 +1163,213 @@ tb_long_t tb_vsnprintf(tb_char_t* s, tb_size_t n, tb_char_t const* fmt, tb_va_li
     // the trailing null byte doesn't count towards the total
     return (pb - s);
 }
+// done the compiled ops
+static tb_long_t tb_printf_done_ops(tb_char_t* s, tb_size_t n, tb_char_t const* fmt, tb_printf_op_t const* ops, tb_size_t opn, tb_va_list_t args)
+{
+    return tb_printf_done(s, n, fmt, ops, opn, tb_true, tb_null, args);
+}
+/* compile the format string to the given ops
+ *
+ * @return the op count, -1 if the ops are not enough or some objects are not found
+ */
+static tb_long_t tb_printf_ops_make(tb_char_t const* fmt, tb_printf_op_t* ops, tb_size_t maxn)
+{
+    // compile it
+    tb_size_t        n = 0;
+    tb_char_t const* p = fmt;
+    while (*p)
+    {
+        // too many ops?
+        tb_check_return_val(n < maxn, -1);
+
+        // make op
+        p += tb_printf_op_make(fmt, p, &ops[n]);
 
+        // the object not found? it may be registered later, do not compile it
+        tb_check_return_val(ops[n].e.type != TB_PRINTF_TYPE_OBJECT || ops[n].e.object, -1);
+        n++;
+    }
+
+    // ok
+    return (tb_long_t)n;
+}
+#ifdef __tb_thread_local__
+// get the cached format
+static tb_printf_cache_item_t* tb_printf_cache_get(tb_char_t const* fmt)
+{
+    /* the printf object funcs have been re-registered? drop all cached formats
+     *
+     * the busy items are only unlinked from the formats, they are still used by the outer printf 
+     * and will not be replaced until they are free
+     */
+    tb_size_t i = 0;
+    tb_size_t n = g_cache.size;
+    tb_size_t generation = tb_printf_object_generation();
+    if (g_cache.generation != generation)
+    {
+        for (i = 0; i < n; i++)
+        {
+            g_cache.fmts[i]  = tb_null;
+            g_cache.ticks[i] = 0;
+        }
+        g_cache.generation = generation;
+        return tb_null;
+    }
+
+    // find it
+    for (i = 0; i < n && g_cache.fmts[i] != fmt; i++) ;
+    tb_check_return_val(i < n, tb_null);
+
+    /* the format at the same pointer may be changed, e.g. the format buffer on the stack
+     *
+     * we need not check it if it cannot be compiled, because it will be parsed directly
+     */
+    tb_printf_cache_item_t* item = &g_cache.items[i];
+    if (item->opn)
+    {
+        tb_char_t const* p = item->data;
+        tb_char_t const* q = fmt;
+        while (*p && *p == *q) p++, q++;
+        tb_check_return_val(*p == *q, tb_null);
+    }
+
+    // hit
+    g_cache.ticks[i] = ++g_cache.tick;
+    return item;
+}
+/* compile the format to the least recently used item
+ *
+ * checking the cached format is as slow as parsing the plain format,
+ * so we only cache the formats with the printf objects and find the object funcs once when compiling them
+ */
+static tb_void_t tb_printf_cache_put(tb_char_t const* fmt)
+{
+    // find the least recently used and not busy item, the item at the same pointer will be replaced
+    tb_size_t i = 0;
+    tb_size_t n = g_cache.size;
+    tb_size_t last = n < TB_PRINTF_CACHE_MAXN? n : TB_PRINTF_CACHE_MAXN;
+    for (i = 0; i < n; i++)
+    {
+        // skip the busy item
+        if (g_cache.items[i].refn) continue;
+
+        // the same pointer?
+        if (g_cache.fmts[i] == fmt) 
+        {
+            last = i;
+            break;
+        }
+
+        // the least recently used?
+        if (last == TB_PRINTF_CACHE_MAXN || g_cache.ticks[i] < g_cache.ticks[last]) last = i;
+    }
+    tb_check_return(last < TB_PRINTF_CACHE_MAXN);
+
+    // compile it if the format is not too long
+    tb_printf_cache_item_t* item = &g_cache.items[last];
+    tb_size_t               size = tb_strlen(fmt);
+    tb_long_t               opn = size < TB_PRINTF_CACHE_DATA_MAXN? tb_printf_ops_make(fmt, item->ops, TB_PRINTF_CACHE_OPS_MAXN) : -1;
+    if (opn > 0) tb_memcpy(item->data, fmt, size + 1);
+
+    // save it, only the format pointer is saved if it cannot be compiled
+    item->opn           = opn > 0? (tb_uint16_t)opn : 0;
+    g_cache.fmts[last]  = fmt;
+    g_cache.ticks[last] = ++g_cache.tick;
+    if (last == n) g_cache.size++;
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_long_t tb_vsnprintf(tb_char_t* s, tb_size_t n, tb_char_t const* fmt, tb_va_list_t args)
+{
+    // check
+    if (!n || !s || !fmt) return 0;
+
+#ifdef __tb_thread_local__
+    // done the cached format
+    tb_long_t               r = 0;
+    tb_printf_cache_item_t* item = tb_printf_cache_get(fmt);
+    if (item && item->opn)
+    {
+        // the nested printf cannot remove it
+        item->refn++;
+        r = tb_printf_done_ops(s, n, fmt, item->ops, item->opn, args);
+        item->refn--;
+        return r;
+    }
+
+    // parse and done format, cache it if it contains the printf objects
+    tb_bool_t has_object = tb_false;
+    r = tb_printf_done(s, n, fmt, tb_null, 0, tb_false, &has_object, args);
+    if (has_object && !item) tb_printf_cache_put(fmt);
+    return r;
+#else
+    // parse and done format
+    return tb_printf_done(s, n, fmt, tb_null, 0, tb_false, tb_null, args);
+#endif
+}
+tb_printf_format_ref_t tb_printf_format_compile(tb_char_t const* fmt)
+{
+    // check
+    tb_assert_and_check_return_val(fmt, tb_null);
+
+    // count the op upper bound, each op contains one '%' at least except for the literal ops between them
+    tb_size_t        maxn = 1;
+    tb_char_t const* p = fmt;
+    for (; *p; p++) if (*p == '%') maxn += 2;
+
+    // make format
+    tb_size_t           size = (tb_size_t)(p - fmt) + 1;
+    tb_printf_format_t* format = (tb_printf_format_t*)tb_malloc(sizeof(tb_printf_format_t) + (maxn - 1) * sizeof(tb_printf_op_t) + size);
+    tb_assert_and_check_return_val(format, tb_null);
+
+    // copy the format string
+    tb_char_t* data = (tb_char_t*)&format->ops[maxn];
+    tb_memcpy(data, fmt, size);
+    format->fmt = data;
+
+    // compile it
+    tb_long_t opn = tb_printf_ops_make(data, format->ops, maxn);
+    if (opn < 0)
+    {
+        tb_free(format);
+        return tb_null;
+    }
+    format->opn = (tb_size_t)opn;
+
+    // ok
+    return (tb_printf_format_ref_t)format;
+}
+tb_void_t tb_printf_format_exit(tb_printf_format_ref_t self)
+{
+    // exit it
+    if (self) tb_free(self);
+}
+tb_long_t tb_printf_format_vsnprintf(tb_char_t* s, tb_size_t n, tb_printf_format_ref_t self, tb_va_list_t args)
+{
+    // check
+    tb_printf_format_t* format = (tb_printf_format_t*)self;
+    if (!n || !s || !format) return 0;
+
+    // done
+    return tb_printf_done_ops(s, n, format->fmt, format->ops, format->opn, args);
+}
+tb_long_t tb_printf_format_snprintf(tb_char_t* s, tb_size_t n, tb_printf_format_ref_t self, ...)
+{
+    // check
+    tb_check_return_val(s && n, 0);
+
+    // format
+    tb_long_t       r = 0;
+    tb_va_list_t    args;
+    tb_va_start(args, self);
+    r = tb_printf_format_vsnprintf(s, n, self, args);
+    tb_va_end(args);
+
+    // end
+    if (r >= 0 && (tb_size_t)r < n) s[r] = '\0';
+    else s[n - 1] = '\0';
+    return r > 0? r : 0;
+}
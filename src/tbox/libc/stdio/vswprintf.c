@@ -32,6 +32,7 @@
 #include "../../utils/utils.h"
 #include "../string/string.h"
 #include "printf_object.h"
+#include "../stdlib/impl/dtoa.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -62,6 +63,7 @@ typedef enum __tb_printf_extra_t
 ,   TB_PRINTF_EXTRA_UPPER           = 2     // upper case for %X %B
 ,   TB_PRINTF_EXTRA_PERCENT         = 4     // percent char: %
 ,   TB_PRINTF_EXTRA_EXP             = 8     // exponent form: [-]d.ddd e[+/-]ddd
+,   TB_PRINTF_EXTRA_GENERAL         = 16    // general form: %e or %f with the trailing zeros removed
 
 }tb_printf_extra_t;
 
@@ -491,100 +493,87 @@ static tb_wchar_t* tb_printf_int32(tb_wchar_t* pb, tb_wchar_t* pe, tb_printf_ent
     return pb;
 }
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
-static tb_wchar_t* tb_printf_float(tb_wchar_t* pb, tb_wchar_t* pe, tb_printf_entry_t e, tb_float_t num)
+static tb_wchar_t* tb_printf_double(tb_wchar_t* pb, tb_wchar_t* pe, tb_printf_entry_t e, tb_double_t num)
 {
-    // digits
-    tb_wchar_t  ints[32] = {0};
-    tb_wchar_t  decs[32] = {0};
-    tb_int_t    ints_i = 0, decs_i = 0;
-
     // for inf nan
-    if (tb_isinff(num))
+    if (tb_isinf(num))
     {
-        if (pb < pe && num < 0) *pb++ = L'-';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? L'I' : L'i';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? L'N' : L'n';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? L'F' : L'f';
+        if (pb < pe && num < 0) *pb++ = '-';
+        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'I' : 'i';
+        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'N' : 'n';
+        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'F' : 'f';
         return pb;
     }
-    else if (tb_isnanf(num))
+    else if (tb_isnan(num))
     {
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? L'N' : L'n';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? L'A' : L'a';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? L'N' : L'n';
+        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'N' : 'n';
+        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'A' : 'a';
+        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'N' : 'n';
         return pb;
     }
 
-    // sign: + -
-    tb_wchar_t sign = 0;
+    // sign: + -, -0.0 is negative too
+    tb_ieee_double_t conv; conv.d = num;
+    tb_char_t sign = 0;
     if (e.extra & TB_PRINTF_EXTRA_SIGNED)
     {
-        if (num < 0) 
+        if (conv.i.h >> 31) 
         {
-            sign = L'-';
+            sign = '-';
             --e.width;
         }
         else if (e.flags & TB_PRINTF_FLAG_PLUS)
         {
-            sign = L'+';
+            sign = '+';
             --e.width;
         }
     }
 
-    // adjust sign
-    if (num < 0) num = -num;
-
     // default precision: 6
-    if (e.precision <= 0) e.precision = 6;
-
-    // round? i.dddddddd5 => i.ddddddde
-    tb_uint32_t p = 1;
-    tb_size_t   n = e.precision;
-    while (n--) p *= 10;
-    if (((tb_uint32_t)(num * p * 10) % 10) > 4) 
-        num += 1.0f / (tb_float_t)p;
-
-    // get integer & decimal
-    tb_int32_t integer = (tb_int32_t)num;
-    tb_float_t decimal = num - integer;
-
-    // convert integer => digits string in reverse order
-    if (integer == 0) ints[ints_i++] = L'0';
-    else 
-    {
-        if (integer < 0) integer = -integer; 
-        do 
+    if (e.precision < 0) e.precision = 6;
+
+    /* make the exact decimal digits with the correct rounding
+     *
+     * the value is 0.d1d2...dn * 10^decpt, the omitted trailing digits are zeros
+     */
+    tb_char_t   digits[TB_DTOA_EXACT_MAXN];
+    tb_int_t    decpt = 1;
+    tb_int_t    ndigits = 0;
+    tb_int_t    precision = e.precision;
+    tb_bool_t   expform = (e.extra & TB_PRINTF_EXTRA_EXP)? tb_true : tb_false;
+    if (e.extra & TB_PRINTF_EXTRA_GENERAL)
+    {
+        // %g: the p significant digits, it uses the exponent form if x < -4 or x >= p
+        tb_int_t p = precision? precision : 1;
+        ndigits = (tb_int_t)tb_dtoa_exact(num, TB_DTOA_MODE_EXP, p, digits, sizeof(digits), &decpt);
+        expform = (decpt - 1 < -4 || decpt - 1 >= p)? tb_true : tb_false;
+        precision = expform? p - 1 : p - decpt;
+
+        // remove the trailing zeros if no '#'
+        if (!(e.flags & TB_PRINTF_FLAG_PFIX))
         {
-            ints[ints_i++] = (integer % 10) + L'0';
-            integer /= 10;
+            tb_int_t n = expform? ndigits - 1 : ndigits - decpt;
+            if (precision > n) precision = n > 0? n : 0;
         }
-        while (integer);
     }
+    else if (expform) ndigits = (tb_int_t)tb_dtoa_exact(num, TB_DTOA_MODE_EXP, precision + 1, digits, sizeof(digits), &decpt);
+    else ndigits = (tb_int_t)tb_dtoa_exact(num, TB_DTOA_MODE_FIXED, precision, digits, sizeof(digits), &decpt);
 
-    // convert decimal => digits string in positive order
-    if (decimal == 0) decs[decs_i++] = L'0';
-    else 
-    {
-        tb_long_t d = (tb_long_t)(decimal * 10);
-        do 
-        {
-            decs[decs_i++] = (tb_wchar_t)(d + (tb_long_t)L'0');
-            decimal = decimal * 10 - d;
-            d = (tb_long_t)(decimal * 10);
-        }
-        while (decs_i < e.precision);
-    }
+    // the exponent for the exponent form
+    tb_int_t x = decpt - 1;
+    tb_int_t xabs = x < 0? -x : x;
+    tb_int_t xlen = xabs < 100? 2 : (xabs < 1000? 3 : 4);
 
-    // adjust precision
-    if (decs_i > e.precision) 
-        decs_i = e.precision;
+    // the body size
+    tb_bool_t   point = (precision || (e.flags & TB_PRINTF_FLAG_PFIX))? tb_true : tb_false;
+    tb_int_t    size = (expform? 1 + 2 + xlen : (decpt > 0? decpt : 1)) + (point? 1 + precision : 0);
 
     // fill spaces at left side, e.g. "   0.31415926"
-    e.width -= ints_i + 1 + e.precision;
+    e.width -= size;
     if (!(e.flags & (TB_PRINTF_FLAG_LEFT + TB_PRINTF_FLAG_ZERO)))
     {
         while (--e.width >= 0)
-            if (pb < pe) *pb++ = L' ';
+            if (pb < pe) *pb++ = ' ';
     }
 
     // append sign: + / -
@@ -593,160 +582,47 @@ static tb_wchar_t* tb_printf_float(tb_wchar_t* pb, tb_wchar_t* pe, tb_printf_ent
     // fill 0 or spaces, e.g. "00003.1415926"
     if (!(e.flags & TB_PRINTF_FLAG_LEFT))
     {
-        tb_wchar_t c = (e.flags & TB_PRINTF_FLAG_ZERO)? L'0' : L' ';
+        tb_char_t c = (e.flags & TB_PRINTF_FLAG_ZERO)? '0' : ' ';
         while (--e.width >= 0)
             if (pb < pe) *pb++ = c;
     }
 
-    // append integer
-    while (--ints_i >= 0) 
-        if (pb < pe) *pb++ = ints[ints_i];
-
-    // append .
-    if (pb < pe) *pb++ = L'.';
-
-    // append decimal
-    tb_int_t decs_n = decs_i;
-    while (--decs_i >= 0) 
-        if (pb < pe) *pb++ = decs[decs_n - decs_i - 1];
-
-    // fill 0 if precision is larger, e.g. "0.3140000"
-    while (decs_n <= --e.precision) 
-        if (pb < pe) *pb++ = L'0';
-
-    // trailing space padding for left-justified flags, e.g. "0.31415926   "
-    while (--e.width >= 0)
-        if (pb < pe) *pb++ = L' ';
-
-    return pb;
-}
-static tb_wchar_t* tb_printf_double(tb_wchar_t* pb, tb_wchar_t* pe, tb_printf_entry_t e, tb_double_t num)
-{
-    // digits
-    tb_wchar_t  ints[64] = {0};
-    tb_wchar_t  decs[64] = {0};
-    tb_int_t    ints_i = 0, decs_i = 0;
-
-    // for inf nan
-    if (tb_isinf(num))
-    {
-        if (pb < pe && num < 0) *pb++ = L'-';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? L'I' : L'i';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? L'N' : L'n';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? L'F' : L'f';
-        return pb;
-    }
-    else if (tb_isnan(num))
-    {
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? L'N' : L'n';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? L'A' : L'a';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? L'N' : L'n';
-        return pb;
-    }
-
-
-    // sign: + -
-    tb_wchar_t sign = 0;
-    if (e.extra & TB_PRINTF_EXTRA_SIGNED)
-    {
-        if (num < 0) 
-        {
-            sign = L'-';
-            --e.width;
-        }
-        else if (e.flags & TB_PRINTF_FLAG_PLUS)
-        {
-            sign = L'+';
-            --e.width;
-        }
-    }
-
-    // adjust sign
-    if (num < 0) num = -num;
-
-    // default precision: 6
-    if (e.precision <= 0) e.precision = 6;
-
-    // round? i.dddddddd5 => i.ddddddde
-    tb_uint64_t p = 1;
-    tb_size_t   n = e.precision;
-    while (n--) p *= 10;
-    if (((tb_uint64_t)(num * p * 10) % 10) > 4) 
-        num += 1. / (tb_double_t)p;
-
-    // get integer & decimal
-    tb_int64_t integer = (tb_int64_t)num;
-    tb_double_t decimal = num - integer;
-
-    // convert integer => digits string in reverse order
-    if (integer == 0) ints[ints_i++] = L'0';
-    else 
-    {
-        if (integer < 0) integer = -integer; 
-        do 
+    // append the digits
+    tb_int_t i = 0;
+    if (expform)
+    {
+        // d.ddde+xx
+        if (pb < pe) *pb++ = ndigits? digits[0] : '0';
+        if (point && pb < pe) *pb++ = '.';
+        for (i = 1; i <= precision; i++)
+            if (pb < pe) *pb++ = i < ndigits? digits[i] : '0';
+        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'E' : 'e';
+        if (pb < pe) *pb++ = x < 0? '-' : '+';
+        for (i = xlen - 1; i >= 0; i--)
         {
-            ints[ints_i++] = (integer % 10) + L'0';
-            integer /= 10;
+            tb_int_t d = xabs;
+            tb_int_t j = i;
+            while (j--) d /= 10;
+            if (pb < pe) *pb++ = (tb_char_t)('0' + d % 10);
         }
-        while (integer);
     }
-
-    // convert decimal => digits string in positive order
-    if (decimal == 0) decs[decs_i++] = L'0';
-    else 
+    else
     {
-        tb_long_t d = (tb_long_t)(decimal * 10);
-        do 
+        // ddd.ddd
+        if (decpt > 0) 
         {
-            decs[decs_i++] = (tb_wchar_t)(d + (tb_long_t)L'0');
-            decimal = decimal * 10 - d;
-            d = (tb_long_t)(decimal * 10);
+            for (i = 0; i < decpt; i++)
+                if (pb < pe) *pb++ = i < ndigits? digits[i] : '0';
         }
-        while (decs_i < e.precision);
+        else if (pb < pe) *pb++ = '0';
+        if (point && pb < pe) *pb++ = '.';
+        for (i = decpt; i < decpt + precision; i++)
+            if (pb < pe) *pb++ = (i >= 0 && i < ndigits)? digits[i] : '0';
     }
 
-    // adjust precision
-    if (decs_i > e.precision) 
-        decs_i = e.precision;
-
-    // fill spaces at left side, e.g. "   0.31415926"
-    e.width -= ints_i + 1 + e.precision;
-    if (!(e.flags & (TB_PRINTF_FLAG_LEFT + TB_PRINTF_FLAG_ZERO)))
-    {
-        while (--e.width >= 0)
-            if (pb < pe) *pb++ = L' ';
-    }
-
-    // append sign: + / -
-    if (sign && (pb < pe)) *pb++ = sign;
-
-    // fill 0 or spaces, e.g. "00003.1415926"
-    if (!(e.flags & TB_PRINTF_FLAG_LEFT))
-    {
-        tb_wchar_t c = (e.flags & TB_PRINTF_FLAG_ZERO)? L'0' : L' ';
-        while (--e.width >= 0)
-            if (pb < pe) *pb++ = c;
-    }
-
-    // append integer
-    while (--ints_i >= 0) 
-        if (pb < pe) *pb++ = ints[ints_i];
-
-    // append .
-    if (pb < pe) *pb++ = L'.';
-
-    // append decimal
-    tb_int_t decs_n = decs_i;
-    while (--decs_i >= 0) 
-        if (pb < pe) *pb++ = decs[decs_n - decs_i - 1];
-
-    // fill 0 if precision is larger, e.g. "0.3140000"
-    while (decs_n <= --e.precision) 
-        if (pb < pe) *pb++ = L'0';
-
     // trailing space padding for left-justified flags, e.g. "0.31415926   "
     while (--e.width >= 0)
-        if (pb < pe) *pb++ = L' ';
+        if (pb < pe) *pb++ = ' ';
 
     return pb;
 }
@@ -825,6 +701,7 @@ get_precision:
     if (*p == '.')
     {
         ++p;
+        e->precision = 0;
         if (tb_isdigit(*p)) 
         {
             e->precision = tb_skip_atoi(&p);
@@ -937,6 +814,13 @@ get_qualifier:
         e->extra |= TB_PRINTF_EXTRA_SIGNED;
         e->extra |= TB_PRINTF_EXTRA_EXP;
         break;
+    case 'G':
+        e->extra |= TB_PRINTF_EXTRA_UPPER;
+    case 'g':
+        e->type = TB_PRINTF_TYPE_FLOAT;
+        e->extra |= TB_PRINTF_EXTRA_SIGNED;
+        e->extra |= TB_PRINTF_EXTRA_GENERAL;
+        break;
 #endif
     case L'{':
         {
@@ -1096,7 +980,7 @@ tb_long_t tb_vswprintf(tb_wchar_t* s, tb_size_t n, tb_wchar_t const* fmt, tb_va_
                 else 
                 {
                     tb_float_t num = (tb_float_t)tb_va_arg(args, tb_double_t);
-                    pb = tb_printf_float(pb, pe, e, num);
+                    pb = tb_printf_double(pb, pe, e, num);
                 }
                 break;
             }
@@ -0,0 +1,160 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        bignum.h
+ *
+ */
+#ifndef TB_LIBC_STDLIB_IMPL_BIGNUM_H
+#define TB_LIBC_STDLIB_IMPL_BIGNUM_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* the maximum limbs count, 4096 bits
+ *
+ * it is enough for the exact comparison of the 800 decimal digits and 5^1150 in strtod
+ */
+#define TB_BIGNUM_MAXN          (128)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the unsigned big number for the exact float conversion
+typedef struct __tb_bignum_t
+{
+    // the limbs count
+    tb_size_t           size;
+
+    // the 32-bits limbs, little-endian
+    tb_uint32_t         data[TB_BIGNUM_MAXN];
+
+}tb_bignum_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+static __tb_inline__ tb_void_t tb_bignum_init(tb_bignum_t* bn, tb_uint64_t val)
+{
+    bn->size = 0;
+    while (val)
+    {
+        bn->data[bn->size++] = (tb_uint32_t)val;
+        val >>= 32;
+    }
+}
+static __tb_inline__ tb_bool_t tb_bignum_muladd(tb_bignum_t* bn, tb_uint32_t mul, tb_uint32_t add)
+{
+    // bn = bn * mul + add
+    tb_size_t   i = 0;
+    tb_uint64_t c = add;
+    for (i = 0; i < bn->size; i++)
+    {
+        c += (tb_uint64_t)bn->data[i] * mul;
+        bn->data[i] = (tb_uint32_t)c;
+        c >>= 32;
+    }
+
+    // append the carry
+    if (c)
+    {
+        tb_assert_and_check_return_val(bn->size < TB_BIGNUM_MAXN, tb_false);
+        bn->data[bn->size++] = (tb_uint32_t)c;
+    }
+    return tb_true;
+}
+static __tb_inline__ tb_bool_t tb_bignum_mul_pow5(tb_bignum_t* bn, tb_size_t n)
+{
+    // 5^13 is the largest power of five in the 32-bits
+    static tb_uint32_t const s_pow5[14] = 
+    {
+        1, 5, 25, 125, 625, 3125, 15625, 78125, 390625, 1953125
+    ,   9765625, 48828125, 244140625, 1220703125
+    };
+    for (; n >= 13; n -= 13) 
+        if (!tb_bignum_muladd(bn, s_pow5[13], 0)) return tb_false;
+    return n? tb_bignum_muladd(bn, s_pow5[n], 0) : tb_true;
+}
+static __tb_inline__ tb_bool_t tb_bignum_shl(tb_bignum_t* bn, tb_size_t bits)
+{
+    // empty?
+    tb_check_return_val(bn->size, tb_true);
+
+    // the limbs and bits
+    tb_size_t limbs = bits >> 5;
+    tb_size_t shift = bits & 31;
+    tb_size_t size = bn->size + limbs + (shift? 1 : 0);
+    tb_assert_and_check_return_val(size <= TB_BIGNUM_MAXN, tb_false);
+
+    // shift it
+    tb_long_t i = 0;
+    if (shift)
+    {
+        bn->data[bn->size + limbs] = 0;
+        for (i = (tb_long_t)bn->size - 1; i >= 0; i--)
+        {
+            bn->data[i + limbs + 1] |= bn->data[i] >> (32 - shift);
+            bn->data[i + limbs] = bn->data[i] << shift;
+        }
+    }
+    else
+    {
+        for (i = (tb_long_t)bn->size - 1; i >= 0; i--)
+            bn->data[i + limbs] = bn->data[i];
+    }
+    for (i = 0; i < (tb_long_t)limbs; i++) bn->data[i] = 0;
+
+    // update size
+    bn->size = size;
+    while (bn->size && !bn->data[bn->size - 1]) bn->size--;
+    return tb_true;
+}
+static __tb_inline__ tb_uint32_t tb_bignum_divmod(tb_bignum_t* bn, tb_uint32_t div)
+{
+    // bn = bn / div, return bn % div
+    tb_long_t   i = 0;
+    tb_uint64_t r = 0;
+    for (i = (tb_long_t)bn->size - 1; i >= 0; i--)
+    {
+        r = (r << 32) | bn->data[i];
+        bn->data[i] = (tb_uint32_t)(r / div);
+        r %= div;
+    }
+    while (bn->size && !bn->data[bn->size - 1]) bn->size--;
+    return (tb_uint32_t)r;
+}
+static __tb_inline__ tb_long_t tb_bignum_comp(tb_bignum_t const* lhs, tb_bignum_t const* rhs)
+{
+    if (lhs->size != rhs->size) return lhs->size > rhs->size? 1 : -1;
+
+    tb_long_t i = 0;
+    for (i = (tb_long_t)lhs->size - 1; i >= 0; i--)
+    {
+        if (lhs->data[i] != rhs->data[i]) return lhs->data[i] > rhs->data[i]? 1 : -1;
+    }
+    return 0;
+}
+
+#endif
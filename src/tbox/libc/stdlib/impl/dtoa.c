@@ -0,0 +1,426 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        dtoa.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "dtoa.h"
+#include "dtoa_pow5.h"
+#include "bignum.h"
+#include "../../../libm/prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the bits count of the powers of five table
+#define TB_DTOA_POW5_BITCOUNT               (125)
+#define TB_DTOA_POW5_INV_BITCOUNT           (125)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_uint64_t tb_dtoa_bits(tb_double_t val)
+{
+    tb_ieee_double_t conv;
+    conv.d = val;
+    return ((tb_uint64_t)conv.i.h << 32) | conv.i.l;
+}
+
+// ceil(log2(5^e)), e in [0, 3528]
+static __tb_inline__ tb_int_t tb_dtoa_pow5_bits(tb_int_t e)
+{
+    return (tb_int_t)(((tb_uint32_t)e * 1217359) >> 19) + 1;
+}
+
+// floor(log10(2^e)), e in [0, 1650]
+static __tb_inline__ tb_int_t tb_dtoa_log10_pow2(tb_int_t e)
+{
+    return (tb_int_t)(((tb_uint32_t)e * 78913) >> 18);
+}
+
+// floor(log10(5^e)), e in [0, 2620]
+static __tb_inline__ tb_int_t tb_dtoa_log10_pow5(tb_int_t e)
+{
+    return (tb_int_t)(((tb_uint32_t)e * 732923) >> 20);
+}
+static __tb_inline__ tb_bool_t tb_dtoa_is_pow5_multiple(tb_uint64_t val, tb_int_t p)
+{
+    tb_int_t n = 0;
+    for (; val && !(val % 5); val /= 5) n++;
+    return n >= p;
+}
+static __tb_inline__ tb_bool_t tb_dtoa_is_pow2_multiple(tb_uint64_t val, tb_int_t p)
+{
+    return !(val & (((tb_uint64_t)1 << p) - 1));
+}
+
+// (m * mul) >> j, mul is the 128-bits {low, high} and j is in [64, 128)
+static __tb_inline__ tb_uint64_t tb_dtoa_mulshift(tb_uint64_t m, tb_uint64_t const* mul, tb_int_t j)
+{
+    tb_uint64_t h0 = 0;
+    tb_uint64_t h1 = 0;
+    tb_stdlib_umul128(m, mul[0], &h0);
+    tb_uint64_t l1 = tb_stdlib_umul128(m, mul[1], &h1);
+    tb_uint64_t lo = l1 + h0;
+    tb_uint64_t hi = h1 + (lo < l1);
+    j -= 64;
+    return j? (hi << (64 - j)) | (lo >> j) : lo;
+}
+
+// make the integer digits, return the digits count
+static __tb_inline__ tb_size_t tb_dtoa_u64(tb_char_t* digits, tb_uint64_t val)
+{
+    tb_char_t   data[24];
+    tb_size_t   n = 0;
+    tb_size_t   i = 0;
+    do
+    {
+        data[n++] = (tb_char_t)('0' + val % 10);
+        val /= 10;
+
+    } while (val);
+    for (i = 0; i < n; i++) digits[i] = data[n - 1 - i];
+    return n;
+}
+
+/* compute the shortest digits in the rounding interval of m2 * 2^e2 (ryu)
+ *
+ * the interval is [4 * m2 - 1 - mmshift, 4 * m2 + 2] * 2^(e2 - 2), the bounds are included if accept_bounds
+ *
+ * the tables are made for the 53-bits mantissa, so the float can be computed with the same tables
+ */
+static tb_uint64_t tb_dtoa_ryu(tb_uint64_t m2, tb_int_t e2, tb_uint32_t mmshift, tb_bool_t accept_bounds, tb_int_t* pexp)
+{
+    // the middle value and bounds, we shift them by two bits
+    tb_uint64_t mv = m2 << 2;
+    tb_uint64_t vr = 0;
+    tb_uint64_t vp = 0;
+    tb_uint64_t vm = 0;
+    tb_int_t    e10 = 0;
+    tb_bool_t   vm_trailing_zeros = tb_false;
+    tb_bool_t   vr_trailing_zeros = tb_false;
+    e2 -= 2;
+    if (e2 >= 0)
+    {
+        // q = max(0, log10(2^e2) - 1), we keep one more digit for rounding
+        tb_int_t q = tb_dtoa_log10_pow2(e2) - (e2 > 3);
+        tb_int_t k = TB_DTOA_POW5_INV_BITCOUNT + tb_dtoa_pow5_bits(q) - 1;
+        tb_int_t i = -e2 + q + k;
+        tb_assert(q < (tb_int_t)tb_arrayn(g_dtoa_pow5_inv_split));
+        e10 = q;
+        vr = tb_dtoa_mulshift(mv, g_dtoa_pow5_inv_split[q], i);
+        vp = tb_dtoa_mulshift(mv + 2, g_dtoa_pow5_inv_split[q], i);
+        vm = tb_dtoa_mulshift(mv - 1 - mmshift, g_dtoa_pow5_inv_split[q], i);
+        if (q <= 21)
+        {
+            // only one of mp, mv and mm can be a multiple of 5
+            if (!(mv % 5)) vr_trailing_zeros = tb_dtoa_is_pow5_multiple(mv, q);
+            else if (accept_bounds) vm_trailing_zeros = tb_dtoa_is_pow5_multiple(mv - 1 - mmshift, q);
+            else vp -= tb_dtoa_is_pow5_multiple(mv + 2, q);
+        }
+    }
+    else
+    {
+        // q = max(0, log10(5^-e2) - 1)
+        tb_int_t q = tb_dtoa_log10_pow5(-e2) - (-e2 > 1);
+        tb_int_t i = -e2 - q;
+        tb_int_t k = tb_dtoa_pow5_bits(i) - TB_DTOA_POW5_BITCOUNT;
+        tb_int_t j = q - k;
+        tb_assert(i < (tb_int_t)tb_arrayn(g_dtoa_pow5_split));
+        e10 = q + e2;
+        vr = tb_dtoa_mulshift(mv, g_dtoa_pow5_split[i], j);
+        vp = tb_dtoa_mulshift(mv + 2, g_dtoa_pow5_split[i], j);
+        vm = tb_dtoa_mulshift(mv - 1 - mmshift, g_dtoa_pow5_split[i], j);
+        if (q <= 1)
+        {
+            // mv has at least two trailing zero bits
+            vr_trailing_zeros = tb_true;
+            if (accept_bounds) vm_trailing_zeros = mmshift == 1;
+            else --vp;
+        }
+        else if (q < 63) vr_trailing_zeros = tb_dtoa_is_pow2_multiple(mv, q);
+    }
+
+    // remove the digits while the interval has the shorter representation
+    tb_int_t    removed = 0;
+    tb_uint32_t last_digit = 0;
+    tb_uint64_t output = 0;
+    if (vm_trailing_zeros || vr_trailing_zeros)
+    {
+        // the rare case, we need to track the trailing zeros
+        while (vp / 10 > vm / 10)
+        {
+            vm_trailing_zeros &= !(vm % 10);
+            vr_trailing_zeros &= !last_digit;
+            last_digit = (tb_uint32_t)(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        if (vm_trailing_zeros)
+        {
+            while (!(vm % 10))
+            {
+                vr_trailing_zeros &= !last_digit;
+                last_digit = (tb_uint32_t)(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+        }
+
+        // round to even if it is exactly halfway
+        if (vr_trailing_zeros && last_digit == 5 && !(vr & 1)) last_digit = 4;
+        output = vr + ((vr == vm && (!accept_bounds || !vm_trailing_zeros)) || last_digit >= 5);
+    }
+    else
+    {
+        // the common case
+        tb_bool_t round_up = tb_false;
+        if (vp / 100 > vm / 100)
+        {
+            round_up = (vr % 100) >= 50;
+            vr /= 100;
+            vp /= 100;
+            vm /= 100;
+            removed += 2;
+        }
+        while (vp / 10 > vm / 10)
+        {
+            round_up = (vr % 10) >= 5;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        output = vr + (vr == vm || round_up);
+    }
+
+    // save exponent
+    *pexp = e10 + removed;
+    return output;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_uint64_t tb_dtoa_shortest(tb_double_t val, tb_int_t* pexp)
+{
+    // check
+    tb_assert_and_check_return_val(pexp, 0);
+
+    // the mantissa and exponent
+    tb_uint64_t bits = tb_dtoa_bits(val);
+    tb_uint64_t mantissa = bits & ((1ULL << 52) - 1);
+    tb_uint32_t exponent = (tb_uint32_t)(bits >> 52) & 0x7ff;
+    tb_assert_and_check_return_val(exponent != 0x7ff && (exponent || mantissa), 0);
+
+    // m2 * 2^e2
+    tb_uint64_t m2 = exponent? (mantissa | (1ULL << 52)) : mantissa;
+    tb_int_t    e2 = (tb_int_t)(exponent? exponent : 1) - 1023 - 52;
+
+    // the lower bound is closer if it is a power of two
+    return tb_dtoa_ryu(m2, e2, mantissa || exponent <= 1, !(m2 & 1), pexp);
+}
+tb_uint64_t tb_dtoa_shortest_float(tb_float_t val, tb_int_t* pexp)
+{
+    // check
+    tb_assert_and_check_return_val(pexp, 0);
+
+    // the mantissa and exponent
+    tb_ieee_float_t conv;
+    conv.f = val;
+    tb_uint32_t mantissa = conv.i & ((1UL << 23) - 1);
+    tb_uint32_t exponent = (conv.i >> 23) & 0xff;
+    tb_assert_and_check_return_val(exponent != 0xff && (exponent || mantissa), 0);
+
+    // m2 * 2^e2
+    tb_uint64_t m2 = exponent? (mantissa | (1UL << 23)) : mantissa;
+    tb_int_t    e2 = (tb_int_t)(exponent? exponent : 1) - 127 - 23;
+    return tb_dtoa_ryu(m2, e2, mantissa || exponent <= 1, !(m2 & 1), pexp);
+}
+tb_size_t tb_dtoa_exact(tb_double_t val, tb_size_t mode, tb_int_t ndigits, tb_char_t* digits, tb_size_t maxn, tb_int_t* pdecpt)
+{
+    // check
+    tb_assert_and_check_return_val(digits && maxn >= 32 && pdecpt && ndigits >= 0, 0);
+    tb_assert_and_check_return_val(mode == TB_DTOA_MODE_FIXED || ndigits > 0, 0);
+
+    // the mantissa and exponent, val = m * 2^e
+    tb_uint64_t bits = tb_dtoa_bits(val);
+    tb_uint64_t m = bits & ((1ULL << 52) - 1);
+    tb_uint32_t exponent = (tb_uint32_t)(bits >> 52) & 0x7ff;
+    tb_int_t    e = exponent? (tb_int_t)exponent - 1075 : -1074;
+    tb_assert_and_check_return_val(exponent != 0x7ff, 0);
+    if (exponent) m |= 1ULL << 52;
+
+    // zero?
+    *pdecpt = 1;
+    tb_check_return_val(m, 0);
+
+    // the fraction bits: f / 2^k, the fraction is stored in the limbs for k > 60
+    tb_size_t   n = 0;
+    tb_int_t    k = e < 0? -e : 0;
+    tb_uint64_t f = 0;
+    tb_bignum_t fb;
+    fb.size = 0;
+
+    // make the integer digits
+    if (e >= 0)
+    {
+        if (e <= 11) n = tb_dtoa_u64(digits, m << e);
+        else
+        {
+            // the 9-digits chunks in reverse order
+            tb_uint32_t chunks[40];
+            tb_size_t   count = 0;
+            tb_bignum_init(&fb, m);
+            tb_bignum_shl(&fb, e);
+            while (fb.size && count < tb_arrayn(chunks)) chunks[count++] = tb_bignum_divmod(&fb, 1000000000);
+
+            // make digits
+            n = tb_dtoa_u64(digits, chunks[--count]);
+            while (count-- && n + 9 < maxn)
+            {
+                tb_uint32_t chunk = chunks[count];
+                tb_int_t    i = 0;
+                for (i = 8; i >= 0; i--, chunk /= 10) digits[n + i] = (tb_char_t)('0' + chunk % 10);
+                n += 9;
+            }
+        }
+    }
+    else if (k < 64)
+    {
+        n = (m >> k)? tb_dtoa_u64(digits, m >> k) : 0;
+        m &= ((tb_uint64_t)1 << k) - 1;
+    }
+    *pdecpt = (tb_int_t)n;
+
+    // init the fraction
+    if (k && m)
+    {
+        if (k <= 60) f = m;
+        else
+        {
+            // align the binary point to the limbs, f = fb / 2^(32 * fb.size)
+            tb_size_t limbs = (k + 31) >> 5;
+            tb_bignum_init(&fb, m);
+            tb_bignum_shl(&fb, (limbs << 5) - k);
+            while (fb.size < limbs) fb.data[fb.size++] = 0;
+        }
+    }
+
+    // the wanted digits
+    tb_long_t want = mode == TB_DTOA_MODE_FIXED? (tb_long_t)*pdecpt + ndigits : ndigits;
+
+    // make the fraction digits until we have the rounding digit
+    static tb_uint32_t const s_pow10[10] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+    tb_uint32_t chunk = 0;
+    tb_size_t   chunk_n = 0;
+    tb_size_t   lower = 0;
+    while ((tb_long_t)n <= want && n < maxn)
+    {
+        // the next digit
+        tb_uint32_t d = 0;
+        if (f)
+        {
+            // f * 10 < 2^64 for k <= 60
+            f *= 10;
+            d = (tb_uint32_t)(f >> k);
+            f &= ((tb_uint64_t)1 << k) - 1;
+        }
+        else if (chunk_n)
+        {
+            d = chunk / s_pow10[--chunk_n];
+            chunk %= s_pow10[chunk_n];
+        }
+        else
+        {
+            // no more digits?
+            while (lower < fb.size && !fb.data[lower]) lower++;
+            if (lower >= fb.size) break;
+
+            // the next 9 digits: the carry of fb * 10^9
+            tb_size_t   i = 0;
+            tb_uint64_t c = 0;
+            for (i = lower; i < fb.size; i++)
+            {
+                c += (tb_uint64_t)fb.data[i] * 1000000000;
+                fb.data[i] = (tb_uint32_t)c;
+                c >>= 32;
+            }
+            chunk = (tb_uint32_t)c;
+            chunk_n = 9;
+            continue ;
+        }
+
+        // skip the leading zeros
+        if (!n && !d)
+        {
+            (*pdecpt)--;
+
+            // it will be rounded to zero for the fixed mode
+            if (mode == TB_DTOA_MODE_FIXED && --want < 0) 
+            {
+                *pdecpt = 1;
+                return 0;
+            }
+            continue ;
+        }
+        digits[n++] = (tb_char_t)('0' + d);
+    }
+
+    // round it
+    if ((tb_long_t)n > want)
+    {
+        // the rounding digit and the sticky bit
+        tb_size_t   i = 0;
+        tb_char_t   r = digits[want];
+        tb_bool_t   sticky = chunk || f;
+        for (i = lower; i < fb.size && !sticky; i++) sticky = fb.data[i] != 0;
+        for (i = want + 1; i < n && !sticky; i++) sticky = digits[i] != '0';
+        n = (tb_size_t)want;
+
+        // round half to even
+        if (r > '5' || (r == '5' && (sticky || (n && ((digits[n - 1] - '0') & 1)))))
+        {
+            tb_long_t j = (tb_long_t)n - 1;
+            while (j >= 0 && digits[j] == '9') digits[j--] = '0';
+            if (j >= 0) digits[j]++;
+            else
+            {
+                // 99.9 => 100
+                digits[0] = '1';
+                n = 1;
+                (*pdecpt)++;
+            }
+        }
+    }
+
+    // remove the trailing zeros
+    while (n && digits[n - 1] == '0') n--;
+    if (!n) *pdecpt = 1;
+    return n;
+}
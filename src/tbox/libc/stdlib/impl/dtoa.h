@@ -0,0 +1,100 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        dtoa.h
+ *
+ */
+#ifndef TB_LIBC_STDLIB_IMPL_DTOA_H
+#define TB_LIBC_STDLIB_IMPL_DTOA_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the digits maxn of tb_dtoa_exact(), the exact decimal expansion of a double has 767 significant digits at most
+#define TB_DTOA_EXACT_MAXN          (800)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the exact digits mode
+typedef enum __tb_dtoa_mode_e
+{
+    TB_DTOA_MODE_FIXED              = 0     //!< the given digits after the decimal point, e.g. %.Nf
+,   TB_DTOA_MODE_EXP                = 1     //!< the given significant digits, e.g. %.Ne
+
+}tb_dtoa_mode_e;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! get the shortest decimal digits which round-trip to the given double (ryu)
+ *
+ * the value is digits * 10^exp, the sign is ignored
+ *
+ * @param val       the finite non-zero double
+ * @param pexp      the decimal exponent
+ *
+ * @return          the decimal digits, 17 digits at most
+ */
+tb_uint64_t         tb_dtoa_shortest(tb_double_t val, tb_int_t* pexp);
+
+/*! get the shortest decimal digits which round-trip to the given float
+ *
+ * @param val       the finite non-zero float
+ * @param pexp      the decimal exponent
+ *
+ * @return          the decimal digits, 9 digits at most
+ */
+tb_uint64_t         tb_dtoa_shortest_float(tb_float_t val, tb_int_t* pexp);
+
+/*! get the correctly rounded decimal digits of the exact binary value, rounding half to even
+ *
+ * the value is 0.d1d2...dn * 10^decpt, the sign is ignored and the trailing zeros are omitted,
+ * the zero value returns no digits and decpt is 1
+ *
+ * @param val       the finite double
+ * @param mode      the digits mode
+ * @param ndigits   the digits after the decimal point for TB_DTOA_MODE_FIXED or the significant digits for TB_DTOA_MODE_EXP
+ * @param digits    the digits buffer, TB_DTOA_EXACT_MAXN is enough
+ * @param maxn      the digits maxn
+ * @param pdecpt    the decimal point position
+ *
+ * @return          the digits count
+ */
+tb_size_t           tb_dtoa_exact(tb_double_t val, tb_size_t mode, tb_int_t ndigits, tb_char_t* digits, tb_size_t maxn, tb_int_t* pdecpt);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -0,0 +1,60 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        prefix.h
+ *
+ */
+#ifndef TB_LIBC_STDLIB_IMPL_PREFIX_H
+#define TB_LIBC_STDLIB_IMPL_PREFIX_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+
+// the 64x64 => 128 bits multiplication, return the low 64-bits and save the high 64-bits
+static __tb_inline__ tb_uint64_t tb_stdlib_umul128(tb_uint64_t a, tb_uint64_t b, tb_uint64_t* hi)
+{
+#if defined(TB_COMPILER_IS_GCC) && defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t)a * b;
+    *hi = (tb_uint64_t)(r >> 64);
+    return (tb_uint64_t)r;
+#else
+    tb_uint64_t ha = a >> 32;
+    tb_uint64_t hb = b >> 32;
+    tb_uint64_t la = (tb_uint32_t)a;
+    tb_uint64_t lb = (tb_uint32_t)b;
+    tb_uint64_t rh = ha * hb;
+    tb_uint64_t rm0 = ha * lb;
+    tb_uint64_t rm1 = hb * la;
+    tb_uint64_t rl = la * lb;
+    tb_uint64_t t = rl + (rm0 << 32);
+    tb_uint64_t c = t < rl;
+    tb_uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    return lo;
+#endif
+}
+
+#endif
@@ -0,0 +1,352 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        strtod.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "strtod.h"
+#include "strtod_pow5.h"
+#include "bignum.h"
+#include "../../string/string.h"
+#include "../../../libm/libm.h"
+#include "../../../utils/bits.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the maximum digits of the mantissa
+#define TB_STRTOD_MANTISSA_DIGITS           (19)
+
+/* the maximum digits for the big number comparison
+ *
+ * the exact halfway point has 768 significant digits at most, 
+ * so the truncated digits after it only need a sticky digit
+ */
+#define TB_STRTOD_BIGNUM_DIGITS             (780)
+
+// the fast path (clinger) needs the strict double arithmetic, e.g. not x87
+#if defined(__FLT_EVAL_METHOD__) && (__FLT_EVAL_METHOD__ != 0)
+#   define TB_STRTOD_FAST_PATH              (0)
+#else
+#   define TB_STRTOD_FAST_PATH              (1)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_double_t tb_strtod_make(tb_uint64_t bits, tb_bool_t sign)
+{
+    tb_ieee_double_t conv;
+    bits |= (tb_uint64_t)sign << 63;
+    conv.i.h = (tb_uint32_t)(bits >> 32);
+    conv.i.l = (tb_uint32_t)bits;
+    return conv.d;
+}
+
+/* compute the correctly rounded bits of w * 10^q (eisel-lemire)
+ *
+ * the 128-bits product is always sufficient for the exact w (Mushtak and Lemire, 2023)
+ */
+static tb_uint64_t tb_strtod_eisel_lemire(tb_uint64_t w, tb_long_t q)
+{
+    // zero or infinity?
+    if (!w || q < -342) return 0;
+    if (q > 308) return 0x7ffULL << 52;
+
+    // normalize w
+    tb_size_t lz = tb_bits_cl0_u64_be(w);
+    w <<= lz;
+
+    // compute the product with the 128-bits 5^q and we only need the 55 high bits
+    tb_uint64_t const*  pow5 = g_strtod_pow5_128[q + 342];
+    tb_uint64_t         hi = 0;
+    tb_uint64_t         lo = tb_stdlib_umul128(w, pow5[0], &hi);
+    if ((hi & 0x1ff) == 0x1ff)
+    {
+        tb_uint64_t hi2 = 0;
+        tb_stdlib_umul128(w, pow5[1], &hi2);
+        lo += hi2;
+        if (hi2 > lo) hi++;
+    }
+
+    // the mantissa with one more bit for rounding and the biased exponent
+    tb_int_t    upperbit = (tb_int_t)(hi >> 63);
+    tb_int_t    shift = upperbit + 64 - 52 - 3;
+    tb_uint64_t mantissa = hi >> shift;
+    tb_long_t   power2 = ((((152170 + 65536) * q) >> 16) + 63) + upperbit - (tb_long_t)lz + 1023;
+
+    // subnormal?
+    if (power2 <= 0)
+    {
+        if (-power2 + 1 >= 64) return 0;
+        mantissa >>= -power2 + 1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+
+        // it may be rounded up to the smallest normal number
+        power2 = mantissa < (1ULL << 52)? 0 : 1;
+        return (mantissa & ((1ULL << 52) - 1)) | ((tb_uint64_t)power2 << 52);
+    }
+
+    // exactly halfway? we need round to even instead of rounding up
+    if (lo <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << shift) == hi)
+        mantissa &= ~1ULL;
+
+    // round up
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >= (2ULL << 52))
+    {
+        mantissa = 1ULL << 52;
+        power2++;
+    }
+
+    // overflow?
+    if (power2 >= 0x7ff) return 0x7ffULL << 52;
+    return (mantissa & ((1ULL << 52) - 1)) | ((tb_uint64_t)power2 << 52);
+}
+
+// compare d * 10^q with the halfway point between the given bits and the next bits
+static tb_long_t tb_strtod_bignum_comp(tb_bignum_t const* d, tb_long_t q, tb_uint64_t bits)
+{
+    // the bits value: m * 2^e
+    tb_uint64_t m = bits & ((1ULL << 52) - 1);
+    tb_uint32_t exponent = (tb_uint32_t)(bits >> 52);
+    tb_long_t   e = exponent? (tb_long_t)exponent - 1075 : -1074;
+    if (exponent) m |= 1ULL << 52;
+
+    // the halfway point: (2m + 1) * 2^(e - 1)
+    tb_bignum_t lhs = *d;
+    tb_bignum_t rhs;
+    tb_bignum_init(&rhs, (m << 1) + 1);
+
+    // d * 5^q * 2^q <=> (2m + 1) * 2^(e - 1)
+    if (q >= 0) tb_bignum_mul_pow5(&lhs, q);
+    else tb_bignum_mul_pow5(&rhs, -q);
+    if (q > e - 1) tb_bignum_shl(&lhs, q - e + 1);
+    else tb_bignum_shl(&rhs, e - 1 - q);
+    return tb_bignum_comp(&lhs, &rhs);
+}
+
+// correct the approximate bits by the big number comparison of all digits
+static tb_uint64_t tb_strtod_bignum(tb_char_t const* p, tb_long_t q, tb_size_t ndigits, tb_uint64_t bits)
+{
+    // make the big number of the significant digits
+    tb_bignum_t d;
+    tb_size_t   n = 0;
+    tb_uint32_t chunk = 0;
+    tb_size_t   chunk_n = 0;
+    tb_bool_t   sticky = tb_false;
+    static tb_uint32_t const s_pow10[10] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+    tb_bignum_init(&d, 0);
+    for (; *p; p++)
+    {
+        // skip the decimal point
+        if (*p == '.') continue;
+        if (!tb_isdigit10(*p)) break;
+
+        // the truncated digit
+        if (n >= TB_STRTOD_BIGNUM_DIGITS)
+        {
+            if (*p != '0') sticky = tb_true;
+            continue ;
+        }
+
+        // append it
+        chunk = chunk * 10 + (*p - '0');
+        if (++chunk_n == 9)
+        {
+            tb_bignum_muladd(&d, s_pow10[9], chunk);
+            chunk = 0;
+            chunk_n = 0;
+        }
+        n++;
+    }
+
+    // append the sticky digit, it will never be equal to the halfway point
+    if (sticky)
+    {
+        chunk = chunk * 10 + 1;
+        chunk_n++;
+        n++;
+    }
+    if (chunk_n) tb_bignum_muladd(&d, s_pow10[chunk_n], chunk);
+
+    // the exponent of the last digit, q is the exponent of the last mantissa digit
+    q -= (tb_long_t)n - (tb_long_t)ndigits;
+
+    // correct it, it will be moved by one step at most
+    while (1)
+    {
+        tb_long_t r;
+        if (bits < (0x7ffULL << 52) && ((r = tb_strtod_bignum_comp(&d, q, bits)) > 0 || (!r && (bits & 1)))) bits++;
+        else if (bits && ((r = tb_strtod_bignum_comp(&d, q, bits - 1)) < 0 || (!r && (bits & 1)))) bits--;
+        else break;
+    }
+    return bits;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_double_t tb_strtod_parse(tb_char_t const* s, tb_char_t const** pend)
+{
+    // check
+    tb_assert_and_check_return_val(s, 0);
+
+    // init end
+    if (pend) *pend = s;
+
+    // skip spaces
+    tb_char_t const* p = s;
+    while (tb_isspace(*p)) p++;
+
+    // has sign?
+    tb_bool_t sign = tb_false;
+    if (*p == '-' || *p == '+') sign = *p++ == '-';
+
+    // nan?
+    if (tb_tolower(p[0]) == 'n' && tb_tolower(p[1]) == 'a' && tb_tolower(p[2]) == 'n')
+    {
+        if (pend) *pend = p + 3;
+        return TB_NAN;
+    }
+
+    // inf or infinity?
+    if (tb_tolower(p[0]) == 'i' && tb_tolower(p[1]) == 'n' && tb_tolower(p[2]) == 'f')
+    {
+        if (pend) *pend = !tb_strnicmp(p, "infinity", 8)? p + 8 : p + 3;
+        return sign? -TB_INF : TB_INF;
+    }
+
+    // skip the leading zeros
+    tb_bool_t any = tb_false;
+    while (*p == '0') 
+    {
+        any = tb_true;
+        p++;
+    }
+
+    /* parse the mantissa: w * 10^q
+     *
+     * we keep 19 significant digits at most and the truncated digits will make it be inexact
+     */
+    tb_uint64_t         w = 0;
+    tb_long_t           q = 0;
+    tb_size_t           n = 0;
+    tb_bool_t           truncated = tb_false;
+    tb_char_t const*    head = tb_null;
+    for (; tb_isdigit10(*p); p++)
+    {
+        if (!head) head = p;
+        if (n < TB_STRTOD_MANTISSA_DIGITS)
+        {
+            w = w * 10 + (*p - '0');
+            n++;
+        }
+        else
+        {
+            if (*p != '0') truncated = tb_true;
+            q++;
+        }
+        any = tb_true;
+    }
+    if (*p == '.')
+    {
+        p++;
+        if (!head) 
+        {
+            while (*p == '0') 
+            {
+                any = tb_true;
+                q--;
+                p++;
+            }
+        }
+        for (; tb_isdigit10(*p); p++)
+        {
+            if (!head) head = p;
+            if (n < TB_STRTOD_MANTISSA_DIGITS)
+            {
+                w = w * 10 + (*p - '0');
+                q--;
+                n++;
+            }
+            else if (*p != '0') truncated = tb_true;
+            any = tb_true;
+        }
+    }
+
+    // no digits?
+    tb_check_return_val(any, 0);
+
+    // parse the exponent
+    if (*p == 'e' || *p == 'E')
+    {
+        tb_char_t const*    e = p + 1;
+        tb_bool_t           esign = tb_false;
+        if (*e == '-' || *e == '+') esign = *e++ == '-';
+        if (tb_isdigit10(*e))
+        {
+            tb_long_t exp10 = 0;
+            for (; tb_isdigit10(*e); e++)
+            {
+                if (exp10 < 100000) exp10 = exp10 * 10 + (*e - '0');
+            }
+            q += esign? -exp10 : exp10;
+            p = e;
+        }
+    }
+
+    // save end
+    if (pend) *pend = p;
+
+    // zero?
+    if (!w) return sign? -0. : 0.;
+
+#if TB_STRTOD_FAST_PATH
+    // the fast path: w and 10^q are exact doubles, so the result is correctly rounded
+    if (!truncated && w <= (1ULL << 53) && q >= -22 && q <= 22)
+    {
+        static tb_double_t const s_pow10[23] =
+        {
+            1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11
+        ,   1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        tb_double_t val = (tb_double_t)w;
+        val = q < 0? val / s_pow10[-q] : val * s_pow10[q];
+        return sign? -val : val;
+    }
+#endif
+
+    // eisel-lemire
+    tb_uint64_t bits = tb_strtod_eisel_lemire(w, q);
+
+    // the truncated value is in [w, w + 1) * 10^q, we need compare all digits if they are rounded to different values
+    if (truncated && bits != tb_strtod_eisel_lemire(w + 1, q))
+        bits = tb_strtod_bignum(head, q, n, bits);
+
+    // make double
+    return tb_strtod_make(bits, sign);
+}
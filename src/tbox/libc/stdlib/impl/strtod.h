@@ -0,0 +1,62 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        strtod.h
+ *
+ */
+#ifndef TB_LIBC_STDLIB_IMPL_STRTOD_H
+#define TB_LIBC_STDLIB_IMPL_STRTOD_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! parse the decimal string to the correctly rounded double
+ *
+ * <pre>
+ * [spaces][+|-](digits[.digits] | .digits)[(e|E)[+|-]digits]
+ * [spaces][+|-](nan | inf | infinity)
+ * </pre>
+ *
+ * the fast path (clinger) and eisel-lemire are used for the most inputs,
+ * and the big number comparison is used only for the ambiguous inputs with more than 19 digits
+ *
+ * @param s         the string
+ * @param pend      the end of the parsed string, optional
+ *
+ * @return          the double value, 0 if no number
+ */
+tb_double_t         tb_strtod_parse(tb_char_t const* s, tb_char_t const** pend);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
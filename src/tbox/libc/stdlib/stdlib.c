@@ -26,7 +26,80 @@
  * includes
  */
 #include "stdlib.h"
+#include "../string/string.h"
 #include "../../libm/libm.h"
+#include "impl/dtoa.h"
+#include "impl/strtod.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+static tb_size_t tb_dtos10_format(tb_char_t* s, tb_size_t n, tb_bool_t sign, tb_uint64_t digits, tb_int_t exp)
+{
+    // make digits in reverse order
+    tb_char_t   data[24];
+    tb_size_t   size = 0;
+    do
+    {
+        data[size++] = (tb_char_t)('0' + digits % 10);
+        digits /= 10;
+
+    } while (digits);
+
+    // the scientific exponent: d.ddd * 10^x
+    tb_int_t    x = exp + (tb_int_t)size - 1;
+    tb_int_t    i = 0;
+    tb_char_t   buff[48];
+    tb_char_t*  p = buff;
+    if (sign) *p++ = '-';
+    if (x >= -4 && x < 16)
+    {
+        if (x >= 0)
+        {
+            // 123.45 or 12300.0
+            for (i = 0; i <= x; i++) *p++ = i < (tb_int_t)size? data[size - 1 - i] : '0';
+            *p++ = '.';
+            if (x + 1 < (tb_int_t)size)
+            {
+                for (; i < (tb_int_t)size; i++) *p++ = data[size - 1 - i];
+            }
+            else *p++ = '0';
+        }
+        else
+        {
+            // 0.00123
+            *p++ = '0';
+            *p++ = '.';
+            for (i = x + 1; i < 0; i++) *p++ = '0';
+            for (i = (tb_int_t)size - 1; i >= 0; i--) *p++ = data[i];
+        }
+    }
+    else
+    {
+        // 1.2345e+16 or 5e-324
+        *p++ = data[size - 1];
+        if (size > 1)
+        {
+            *p++ = '.';
+            for (i = (tb_int_t)size - 2; i >= 0; i--) *p++ = data[i];
+        }
+        *p++ = 'e';
+        *p++ = x < 0? '-' : '+';
+        if (x < 0) x = -x;
+        if (x >= 100) *p++ = (tb_char_t)('0' + x / 100);
+        *p++ = (tb_char_t)('0' + (x / 10) % 10);
+        *p++ = (tb_char_t)('0' + x % 10);
+    }
+
+    // copy it
+    size = p - buff;
+    tb_check_return_val(size < n, 0);
+    for (i = 0; i < (tb_int_t)size; i++) s[i] = buff[i];
+    s[size] = '\0';
+    return size;
+}
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -245,6 +318,64 @@ tb_uint64_t tb_sbtou64(tb_char_t const* s, tb_int_t base)
     // convect it
     return s_conv[base](s);
 }
+tb_size_t tb_u64tos10(tb_char_t* s, tb_size_t n, tb_uint64_t val)
+{
+    // check
+    tb_assert_and_check_return_val(s && n, 0);
+
+    // the two digits table
+    static tb_char_t const s_digits[] = 
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+    // convert two digits at once from the tail
+    tb_char_t   data[24];
+    tb_char_t*  e = data + sizeof(data);
+    tb_char_t*  p = e;
+    while (val >= 100)
+    {
+        tb_size_t i = (tb_size_t)(val % 100) << 1;
+        val /= 100;
+        *--p = s_digits[i + 1];
+        *--p = s_digits[i];
+    }
+    if (val >= 10)
+    {
+        tb_size_t i = (tb_size_t)val << 1;
+        *--p = s_digits[i + 1];
+        *--p = s_digits[i];
+    }
+    else *--p = (tb_char_t)('0' + val);
+
+    // copy it
+    tb_size_t size = e - p;
+    tb_check_return_val(size < n, 0);
+    tb_memcpy(s, p, size);
+    s[size] = '\0';
+    return size;
+}
+tb_size_t tb_s64tos10(tb_char_t* s, tb_size_t n, tb_sint64_t val)
+{
+    // check
+    tb_assert_and_check_return_val(s && n, 0);
+
+    // positive?
+    if (val >= 0) return tb_u64tos10(s, n, (tb_uint64_t)val);
+
+    // negative
+    tb_check_return_val(n > 2, 0);
+    s[0] = '-';
+    tb_size_t size = tb_u64tos10(s + 1, n - 1, (tb_uint64_t)0 - (tb_uint64_t)val);
+    return size? size + 1 : 0;
+}
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
 tb_double_t tb_s2tod(tb_char_t const* s)
 {
@@ -422,90 +553,7 @@ tb_double_t tb_s8tod(tb_char_t const* s)
 }
 tb_double_t tb_s10tod(tb_char_t const* s)
 {
-    // check
-    tb_assert_and_check_return_val(s, 0);
-
-    // skip space
-    while (tb_isspace(*s)) s++;
-
-    // has sign?
-    tb_int_t sign = 0;
-    if (*s == '-') 
-    {
-        sign = 1;
-        s++;
-    }
-
-    // nan?
-    if (s[0] == 'n' && s[1] == 'a' && s[2] == 'n')
-        return TB_NAN;
-
-    // inf or -inf?
-    if (s[0] == 'i' && s[1] == 'n' && s[2] == 'f')
-        return sign? -TB_INF : TB_INF;
-
-    // skip '0'
-    while ((*s) == '0') s++;
-
-    // compute double: lhs.rhs
-    tb_int_t    dec = 0;
-    tb_uint64_t lhs = 0;
-    tb_double_t rhs = 0.;
-    tb_int_t    zeros = 0;
-    tb_int8_t   decimals[256];
-    tb_int8_t*  d = decimals;
-    tb_int8_t*  e = decimals + 256;
-    while (*s)
-    {
-        tb_char_t ch = *s;
-
-        // is the part of decimal?
-        if (ch == '.')
-        {
-            if (!dec) 
-            {
-                dec = 1;
-                s++;
-                continue ;
-            }
-            else break;
-        }
-
-        // parse integer & decimal
-        if (tb_isdigit10(ch))
-        {
-            // save decimals
-            if (dec) 
-            {
-                if (d < e)
-                {
-                    if (ch != '0')
-                    {
-                        // fill '0'
-                        while (zeros--) *d++ = 0;
-                        zeros = 0;
-
-                        // save decimal
-                        *d++ = ch - '0';
-                    }
-                    else zeros++;
-                }
-            }
-            else lhs = lhs * 10 + (ch - '0');
-        }
-        else break;
-    
-        s++;
-    }
-
-    // check
-    tb_assert_and_check_return_val(d <= decimals + 256, 0);
-
-    // compute decimal
-    while (d-- > decimals) rhs = (rhs + *d) / 10;
-
-    // merge 
-    return (sign? ((tb_double_t)lhs + rhs) * -1. : ((tb_double_t)lhs + rhs));
+    return tb_strtod_parse(s, tb_null);
 }
 tb_double_t tb_s16tod(tb_char_t const* s)
 {
@@ -691,5 +739,41 @@ tb_double_t tb_sbtod(tb_char_t const* s, tb_int_t base)
     // convect it
     return s_conv[base](s);
 }
+tb_size_t tb_dtos10(tb_char_t* s, tb_size_t n, tb_double_t val)
+{
+    // check
+    tb_assert_and_check_return_val(s && n, 0);
+
+    // nan, inf or zero?
+    tb_ieee_double_t    conv; conv.d = val;
+    tb_char_t const*    special = tb_null;
+    if (tb_isnan(val)) special = "nan";
+    else if (tb_isinf(val)) special = val < 0? "-inf" : "inf";
+    else if (val == 0) special = (conv.i.h >> 31)? "-0.0" : "0.0";
+    if (special) return tb_strlen(special) < n? tb_strlcpy(s, special, n) : 0;
+
+    // make the shortest digits
+    tb_int_t    exp = 0;
+    tb_uint64_t digits = tb_dtoa_shortest(val, &exp);
+    return tb_dtos10_format(s, n, val < 0, digits, exp);
+}
+tb_size_t tb_ftos10(tb_char_t* s, tb_size_t n, tb_float_t val)
+{
+    // check
+    tb_assert_and_check_return_val(s && n, 0);
+
+    // nan, inf or zero?
+    tb_ieee_float_t     conv; conv.f = val;
+    tb_char_t const*    special = tb_null;
+    if (tb_isnanf(val)) special = "nan";
+    else if (tb_isinff(val)) special = val < 0? "-inf" : "inf";
+    else if (val == 0) special = (conv.i >> 31)? "-0.0" : "0.0";
+    if (special) return tb_strlen(special) < n? tb_strlcpy(s, special, n) : 0;
+
+    // make the shortest digits
+    tb_int_t    exp = 0;
+    tb_uint64_t digits = tb_dtoa_shortest_float(val, &exp);
+    return tb_dtos10_format(s, n, val < 0, digits, exp);
+}
 #endif
 
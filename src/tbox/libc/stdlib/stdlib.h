@@ -182,6 +182,30 @@ tb_uint64_t         tb_stou64(tb_char_t const* s);
  */
 tb_uint64_t         tb_sbtou64(tb_char_t const* s, tb_int_t base);
 
+/*! convert uint64 to the decimal string
+ *
+ * .e.g 9 => "9"
+ *
+ * @param s         the string data, 21 bytes is enough for all values
+ * @param n         the string maxn
+ * @param val       the uint64 value
+ *
+ * @return          the string size, not including '\0', 0: the string maxn is too small
+ */
+tb_size_t           tb_u64tos10(tb_char_t* s, tb_size_t n, tb_uint64_t val);
+
+/*! convert sint64 to the decimal string
+ *
+ * .e.g -9 => "-9"
+ *
+ * @param s         the string data, 21 bytes is enough for all values
+ * @param n         the string maxn
+ * @param val       the sint64 value
+ *
+ * @return          the string size, not including '\0', 0: the string maxn is too small
+ */
+tb_size_t           tb_s64tos10(tb_char_t* s, tb_size_t n, tb_sint64_t val);
+
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
 
 /*! convert the binary string to double
@@ -214,9 +238,9 @@ tb_double_t         tb_s2tod(tb_char_t const* s);
  */
 tb_double_t         tb_s8tod(tb_char_t const* s);
 
-/*! convert the decimal string to double
+/*! convert the decimal string to the correctly rounded double
  *
- * .e.g "9" => 9
+ * .e.g "9" => 9, "1.5e-3" => 0.0015
  *
  * @param s         the string
  *
@@ -264,6 +288,37 @@ tb_double_t         tb_stod(tb_char_t const* s);
  */
 tb_double_t         tb_sbtod(tb_char_t const* s, tb_int_t base);
 
+/*! convert double to the shortest decimal string which is parsed back to the same double
+ *
+ * <pre>
+ * .e.g 
+ *
+ * 0.1      => "0.1"
+ * 1        => "1.0"
+ * 1e16     => "1e+16"
+ * 5e-324   => "5e-324"
+ * </pre>
+ *
+ * @param s         the string data, 32 bytes is enough for all values
+ * @param n         the string maxn
+ * @param val       the double value
+ *
+ * @return          the string size, not including '\0', 0: the string maxn is too small
+ */
+tb_size_t           tb_dtos10(tb_char_t* s, tb_size_t n, tb_double_t val);
+
+/*! convert float to the shortest decimal string which is parsed back to the same float
+ *
+ * .e.g 0.1f => "0.1"
+ *
+ * @param s         the string data, 32 bytes is enough for all values
+ * @param n         the string maxn
+ * @param val       the float value
+ *
+ * @return          the string size, not including '\0', 0: the string maxn is too small
+ */
+tb_size_t           tb_ftos10(tb_char_t* s, tb_size_t n, tb_float_t val);
+
 #endif
 
 /*! mbstowcs, convert string to wstring
@@ -0,0 +1,45 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        cosf_n.c
+ * @ingroup     libm
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "math.h"
+#include "impl/vector.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t tb_cosf_n(tb_float_t const* x, tb_float_t* y, tb_size_t n)
+{
+    // check
+    tb_assert_and_check_return(x && y);
+
+    // done
+    tb_size_t i = 0;
+#ifdef TB_LIBM_VECTOR_HAVE_SINCOSF4
+    for (; i + 4 <= n; i += 4) tb_libm_vector_sincosf4(x + i, tb_null, y + i);
+#endif
+    for (; i < n; i++) tb_libm_vector_sincosf1(x[i], tb_null, y + i);
+}
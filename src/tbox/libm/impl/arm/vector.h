@@ -0,0 +1,147 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        vector.h
+ * @ingroup     libm
+ *
+ */
+#ifndef TB_LIBM_IMPL_ARM_VECTOR_H
+#define TB_LIBM_IMPL_ARM_VECTOR_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../prefix.h"
+#include <arm_neon.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+#ifdef TB_ARCH_ARM64
+#   define TB_LIBM_VECTOR_HAVE_SQRTF4
+#endif
+#define TB_LIBM_VECTOR_HAVE_SINCOSF4
+#define TB_LIBM_VECTOR_HAVE_EXPF4
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+
+// all lanes are true?
+static __tb_inline__ tb_bool_t tb_libm_vector_all_u32x4(uint32x4_t m)
+{
+    uint32x2_t r = vand_u32(vget_low_u32(m), vget_high_u32(m));
+    return (vget_lane_u32(r, 0) & vget_lane_u32(r, 1)) == 0xffffffff;
+}
+#ifdef TB_ARCH_ARM64
+static __tb_inline__ tb_void_t tb_libm_vector_sqrtf4(tb_float_t const* x, tb_float_t* y)
+{
+    vst1q_f32(y, vsqrtq_f32(vld1q_f32(x)));
+}
+#endif
+static __tb_inline__ tb_void_t tb_libm_vector_sincosf4(tb_float_t const* px, tb_float_t* ps, tb_float_t* pc)
+{
+    // load x
+    float32x4_t x = vld1q_f32(px);
+
+    // the sign bit of sin(x)
+    uint32x4_t  sign_s = vandq_u32(vreinterpretq_u32_f32(x), vdupq_n_u32(0x80000000));
+    x = vabsq_f32(x);
+
+    // out of range, inf or nan? using the scalar version
+    if (!tb_libm_vector_all_u32x4(vcleq_f32(x, vdupq_n_f32(TB_LIBM_VECTOR_SINCOSF_MAXN))))
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < 4; i++) tb_libm_vector_sincosf1(px[i], ps? ps + i : tb_null, pc? pc + i : tb_null);
+        return ;
+    }
+
+    // the octant: j = (j + 1) & ~1
+    int32x4_t   j = vcvtq_s32_f32(vmulq_f32(x, vdupq_n_f32(TB_LIBM_VECTOR_FOPI)));
+    j = vandq_s32(vaddq_s32(j, vdupq_n_s32(1)), vdupq_n_s32(~1));
+    float32x4_t y = vcvtq_f32_s32(j);
+
+    // the sign bit of sin(x) and cos(x) for the octant
+    uint32x4_t  uj = vreinterpretq_u32_s32(j);
+    uint32x4_t  sign_c = vshlq_n_u32(vbicq_u32(vdupq_n_u32(4), vsubq_u32(uj, vdupq_n_u32(2))), 29);
+    sign_s = veorq_u32(sign_s, vshlq_n_u32(vandq_u32(uj, vdupq_n_u32(4)), 29));
+
+    // the polynomial mask for the octant
+    uint32x4_t  poly = vceqq_u32(vandq_u32(uj, vdupq_n_u32(2)), vdupq_n_u32(0));
+
+    // reduce it to [-pi/4, pi/4]
+    x = vmlsq_f32(x, y, vdupq_n_f32(TB_LIBM_VECTOR_DP1));
+    x = vmlsq_f32(x, y, vdupq_n_f32(TB_LIBM_VECTOR_DP2));
+    x = vmlsq_f32(x, y, vdupq_n_f32(TB_LIBM_VECTOR_DP3));
+
+    // the cos polynomial
+    float32x4_t z = vmulq_f32(x, x);
+    float32x4_t c = vmlaq_f32(vdupq_n_f32(TB_LIBM_VECTOR_COS_P1), z, vdupq_n_f32(TB_LIBM_VECTOR_COS_P0));
+    c = vmlaq_f32(vdupq_n_f32(TB_LIBM_VECTOR_COS_P2), c, z);
+    c = vmulq_f32(vmulq_f32(c, z), z);
+    c = vmlsq_f32(c, z, vdupq_n_f32(0.5f));
+    c = vaddq_f32(c, vdupq_n_f32(1.0f));
+
+    // the sin polynomial
+    float32x4_t s = vmlaq_f32(vdupq_n_f32(TB_LIBM_VECTOR_SIN_P1), z, vdupq_n_f32(TB_LIBM_VECTOR_SIN_P0));
+    s = vmlaq_f32(vdupq_n_f32(TB_LIBM_VECTOR_SIN_P2), s, z);
+    s = vmlaq_f32(x, vmulq_f32(s, z), x);
+
+    // select and sign them
+    if (ps) vst1q_f32(ps, vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vbslq_f32(poly, s, c)), sign_s)));
+    if (pc) vst1q_f32(pc, vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vbslq_f32(poly, c, s)), sign_c)));
+}
+static __tb_inline__ tb_void_t tb_libm_vector_expf4(tb_float_t const* px, tb_float_t* py)
+{
+    // load x
+    float32x4_t x = vld1q_f32(px);
+
+    // out of range, inf or nan? using the scalar version
+    if (!tb_libm_vector_all_u32x4(vandq_u32(vcgeq_f32(x, vdupq_n_f32(TB_LIBM_VECTOR_EXP_LO)), vcleq_f32(x, vdupq_n_f32(TB_LIBM_VECTOR_EXP_HI)))))
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < 4; i++) py[i] = tb_libm_vector_expf1(px[i]);
+        return ;
+    }
+
+    // n = floor(x * log2(e) + 0.5)
+    float32x4_t n = vmlaq_f32(vdupq_n_f32(0.5f), x, vdupq_n_f32(TB_LIBM_VECTOR_LOG2EF));
+    float32x4_t t = vcvtq_f32_s32(vcvtq_s32_f32(n));
+    n = vsubq_f32(t, vreinterpretq_f32_u32(vandq_u32(vcgtq_f32(t, n), vreinterpretq_u32_f32(vdupq_n_f32(1.0f)))));
+
+    // r = x - n * ln(2)
+    x = vmlsq_f32(x, n, vdupq_n_f32(TB_LIBM_VECTOR_EXP_C1));
+    x = vmlsq_f32(x, n, vdupq_n_f32(TB_LIBM_VECTOR_EXP_C2));
+
+    // the polynomial
+    float32x4_t z = vmulq_f32(x, x);
+    float32x4_t y = vdupq_n_f32(TB_LIBM_VECTOR_EXP_P0);
+    y = vmlaq_f32(vdupq_n_f32(TB_LIBM_VECTOR_EXP_P1), y, x);
+    y = vmlaq_f32(vdupq_n_f32(TB_LIBM_VECTOR_EXP_P2), y, x);
+    y = vmlaq_f32(vdupq_n_f32(TB_LIBM_VECTOR_EXP_P3), y, x);
+    y = vmlaq_f32(vdupq_n_f32(TB_LIBM_VECTOR_EXP_P4), y, x);
+    y = vmlaq_f32(vdupq_n_f32(TB_LIBM_VECTOR_EXP_P5), y, x);
+    y = vaddq_f32(vmlaq_f32(x, y, z), vdupq_n_f32(1.0f));
+
+    // 2^n
+    int32x4_t   e = vshlq_n_s32(vaddq_s32(vcvtq_s32_f32(n), vdupq_n_s32(127)), 23);
+    vst1q_f32(py, vmulq_f32(y, vreinterpretq_f32_s32(e)));
+}
+
+#endif
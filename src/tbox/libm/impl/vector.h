@@ -0,0 +1,178 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        vector.h
+ * @ingroup     libm
+ *
+ */
+#ifndef TB_LIBM_IMPL_VECTOR_H
+#define TB_LIBM_IMPL_VECTOR_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the max argument of the vector sincosf, the larger arguments will use tb_sincosf
+#define TB_LIBM_VECTOR_SINCOSF_MAXN         (8192.0f)
+
+// the 4/pi
+#define TB_LIBM_VECTOR_FOPI                 (1.27323954473516f)
+
+// the pi/4 with the extra precision (cody-waite)
+#define TB_LIBM_VECTOR_DP1                  (0.78515625f)
+#define TB_LIBM_VECTOR_DP2                  (2.4187564849853515625e-4f)
+#define TB_LIBM_VECTOR_DP3                  (3.77489497744594108e-8f)
+
+// the coefficients of sin(x) and cos(x) in [-pi/4, pi/4]
+#define TB_LIBM_VECTOR_SIN_P0               (-1.9515295891e-4f)
+#define TB_LIBM_VECTOR_SIN_P1               (8.3321608736e-3f)
+#define TB_LIBM_VECTOR_SIN_P2               (-1.6666654611e-1f)
+#define TB_LIBM_VECTOR_COS_P0               (2.443315711809948e-5f)
+#define TB_LIBM_VECTOR_COS_P1               (-1.388731625493765e-3f)
+#define TB_LIBM_VECTOR_COS_P2               (4.166664568298827e-2f)
+
+/* the argument range of the vector expf, 2^n and exp(x) are the normal floats in it,
+ * the overflow, underflow and subnormal results out of it are computed by tb_expf
+ */
+#define TB_LIBM_VECTOR_EXP_HI               (88.0f)
+#define TB_LIBM_VECTOR_EXP_LO               (-87.0f)
+
+// the log2(e) and ln(2) with the extra precision
+#define TB_LIBM_VECTOR_LOG2EF               (1.44269504088896341f)
+#define TB_LIBM_VECTOR_EXP_C1               (0.693359375f)
+#define TB_LIBM_VECTOR_EXP_C2               (-2.12194440e-4f)
+
+// the coefficients of exp(x) in [-ln(2)/2, ln(2)/2]
+#define TB_LIBM_VECTOR_EXP_P0               (1.9875691500e-4f)
+#define TB_LIBM_VECTOR_EXP_P1               (1.3981999507e-3f)
+#define TB_LIBM_VECTOR_EXP_P2               (8.3334519073e-3f)
+#define TB_LIBM_VECTOR_EXP_P3               (4.1665795894e-2f)
+#define TB_LIBM_VECTOR_EXP_P4               (1.6666665459e-1f)
+#define TB_LIBM_VECTOR_EXP_P5               (5.0000001201e-1f)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+
+/* compute sin(x) and cos(x) 
+ *
+ * the same algorithm as the 4-lanes vector version (cephes), 
+ * so the tail values have the same results as the vector values
+ */
+static __tb_inline__ tb_void_t tb_libm_vector_sincosf1(tb_float_t x, tb_float_t* ps, tb_float_t* pc)
+{
+    // out of range, inf or nan? using the scalar version
+    if (!(tb_fabs(x) <= TB_LIBM_VECTOR_SINCOSF_MAXN))
+    {
+        // the scalar version writes both outputs, so use the temporaries for the unwanted one
+        tb_float_t s;
+        tb_float_t c;
+        tb_sincosf(x, &s, &c);
+        if (ps) *ps = s;
+        if (pc) *pc = c;
+        return ;
+    }
+
+    // the sign bit of sin(x)
+    tb_ieee_float_t v;
+    v.f = x;
+    tb_uint32_t sign_s = v.i & 0x80000000;
+    v.i &= 0x7fffffff;
+
+    // the octant: j = (j + 1) & ~1
+    tb_int32_t  j = (tb_int32_t)(v.f * TB_LIBM_VECTOR_FOPI);
+    j = (j + 1) & ~1;
+    tb_float_t  y = (tb_float_t)j;
+
+    // reduce it to [-pi/4, pi/4]
+    x = ((v.f - y * TB_LIBM_VECTOR_DP1) - y * TB_LIBM_VECTOR_DP2) - y * TB_LIBM_VECTOR_DP3;
+
+    // the polynomials
+    tb_float_t z = x * x;
+    tb_float_t c = ((TB_LIBM_VECTOR_COS_P0 * z + TB_LIBM_VECTOR_COS_P1) * z + TB_LIBM_VECTOR_COS_P2) * z * z - 0.5f * z + 1.0f;
+    tb_float_t s = ((TB_LIBM_VECTOR_SIN_P0 * z + TB_LIBM_VECTOR_SIN_P1) * z + TB_LIBM_VECTOR_SIN_P2) * z * x + x;
+
+    // swap and sign them for the octant
+    tb_uint32_t sign_c = ((tb_uint32_t)(~(j - 2)) & 4) << 29;
+    sign_s ^= ((tb_uint32_t)j & 4) << 29;
+    if (j & 2)
+    {
+        tb_float_t t = s;
+        s = c;
+        c = t;
+    }
+    if (ps) 
+    {
+        v.f = s;
+        v.i ^= sign_s;
+        *ps = v.f;
+    }
+    if (pc)
+    {
+        v.f = c;
+        v.i ^= sign_c;
+        *pc = v.f;
+    }
+}
+static __tb_inline__ tb_float_t tb_libm_vector_expf1(tb_float_t x)
+{
+    // out of range, inf or nan? using the scalar version
+    if (!(x >= TB_LIBM_VECTOR_EXP_LO && x <= TB_LIBM_VECTOR_EXP_HI)) return tb_expf(x);
+
+    // exp(x) = 2^n * exp(r), n = floor(x * log2(e) + 0.5)
+    tb_float_t n = x * TB_LIBM_VECTOR_LOG2EF + 0.5f;
+    tb_float_t t = (tb_float_t)(tb_int32_t)n;
+    if (t > n) t -= 1.0f;
+    n = t;
+
+    // r = x - n * ln(2)
+    x -= n * TB_LIBM_VECTOR_EXP_C1;
+    x -= n * TB_LIBM_VECTOR_EXP_C2;
+
+    // the polynomial
+    tb_float_t z = x * x;
+    tb_float_t y = TB_LIBM_VECTOR_EXP_P0;
+    y = y * x + TB_LIBM_VECTOR_EXP_P1;
+    y = y * x + TB_LIBM_VECTOR_EXP_P2;
+    y = y * x + TB_LIBM_VECTOR_EXP_P3;
+    y = y * x + TB_LIBM_VECTOR_EXP_P4;
+    y = y * x + TB_LIBM_VECTOR_EXP_P5;
+    y = y * z + x + 1.0f;
+
+    // 2^n
+    tb_ieee_float_t e;
+    e.i = (tb_uint32_t)((tb_int32_t)n + 127) << 23;
+    return y * e.f;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#if defined(TB_ARCH_SSE2)
+#   include "x86/vector.h"
+#elif defined(TB_ARCH_ARM_NEON)
+#   include "arm/vector.h"
+#endif
+
+#endif
@@ -0,0 +1,138 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        vector.h
+ * @ingroup     libm
+ *
+ */
+#ifndef TB_LIBM_IMPL_x86_VECTOR_H
+#define TB_LIBM_IMPL_x86_VECTOR_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../prefix.h"
+#include <emmintrin.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+#define TB_LIBM_VECTOR_HAVE_SQRTF4
+#define TB_LIBM_VECTOR_HAVE_SINCOSF4
+#define TB_LIBM_VECTOR_HAVE_EXPF4
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static __tb_inline__ tb_void_t tb_libm_vector_sqrtf4(tb_float_t const* x, tb_float_t* y)
+{
+    _mm_storeu_ps(y, _mm_sqrt_ps(_mm_loadu_ps(x)));
+}
+static __tb_inline__ tb_void_t tb_libm_vector_sincosf4(tb_float_t const* px, tb_float_t* ps, tb_float_t* pc)
+{
+    // load x
+    __m128 x = _mm_loadu_ps(px);
+
+    // the sign bit of sin(x)
+    __m128 sign_mask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+    __m128 sign_s = _mm_and_ps(x, sign_mask);
+    x = _mm_andnot_ps(sign_mask, x);
+
+    // out of range, inf or nan? using the scalar version
+    if (_mm_movemask_ps(_mm_cmpnle_ps(x, _mm_set1_ps(TB_LIBM_VECTOR_SINCOSF_MAXN))))
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < 4; i++) tb_libm_vector_sincosf1(px[i], ps? ps + i : tb_null, pc? pc + i : tb_null);
+        return ;
+    }
+
+    // the octant: j = (j + 1) & ~1
+    __m128i j = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(TB_LIBM_VECTOR_FOPI)));
+    j = _mm_add_epi32(j, _mm_set1_epi32(1));
+    j = _mm_and_si128(j, _mm_set1_epi32(~1));
+    __m128 y = _mm_cvtepi32_ps(j);
+
+    // the sign bit of sin(x) and cos(x) for the octant
+    __m128 swap = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, _mm_set1_epi32(4)), 29));
+    __m128 sign_c = _mm_castsi128_ps(_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(j, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+    sign_s = _mm_xor_ps(sign_s, swap);
+
+    // the polynomial mask for the octant
+    __m128 poly = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, _mm_set1_epi32(2)), _mm_setzero_si128()));
+
+    // reduce it to [-pi/4, pi/4]
+    x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(TB_LIBM_VECTOR_DP1)));
+    x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(TB_LIBM_VECTOR_DP2)));
+    x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(TB_LIBM_VECTOR_DP3)));
+
+    // the cos polynomial
+    __m128 z = _mm_mul_ps(x, x);
+    __m128 c = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(TB_LIBM_VECTOR_COS_P0), z), _mm_set1_ps(TB_LIBM_VECTOR_COS_P1));
+    c = _mm_add_ps(_mm_mul_ps(c, z), _mm_set1_ps(TB_LIBM_VECTOR_COS_P2));
+    c = _mm_mul_ps(_mm_mul_ps(c, z), z);
+    c = _mm_sub_ps(c, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+    c = _mm_add_ps(c, _mm_set1_ps(1.0f));
+
+    // the sin polynomial
+    __m128 s = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(TB_LIBM_VECTOR_SIN_P0), z), _mm_set1_ps(TB_LIBM_VECTOR_SIN_P1));
+    s = _mm_add_ps(_mm_mul_ps(s, z), _mm_set1_ps(TB_LIBM_VECTOR_SIN_P2));
+    s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, z), x), x);
+
+    // select and sign them
+    if (ps) _mm_storeu_ps(ps, _mm_xor_ps(_mm_or_ps(_mm_and_ps(poly, s), _mm_andnot_ps(poly, c)), sign_s));
+    if (pc) _mm_storeu_ps(pc, _mm_xor_ps(_mm_or_ps(_mm_and_ps(poly, c), _mm_andnot_ps(poly, s)), sign_c));
+}
+static __tb_inline__ tb_void_t tb_libm_vector_expf4(tb_float_t const* px, tb_float_t* py)
+{
+    // load x
+    __m128 x = _mm_loadu_ps(px);
+
+    // out of range, inf or nan? using the scalar version
+    if (_mm_movemask_ps(_mm_or_ps(_mm_cmpnge_ps(x, _mm_set1_ps(TB_LIBM_VECTOR_EXP_LO)), _mm_cmpnle_ps(x, _mm_set1_ps(TB_LIBM_VECTOR_EXP_HI)))))
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < 4; i++) py[i] = tb_libm_vector_expf1(px[i]);
+        return ;
+    }
+
+    // n = floor(x * log2(e) + 0.5)
+    __m128 n = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(TB_LIBM_VECTOR_LOG2EF)), _mm_set1_ps(0.5f));
+    __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(n));
+    n = _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, n), _mm_set1_ps(1.0f)));
+
+    // r = x - n * ln(2)
+    x = _mm_sub_ps(x, _mm_mul_ps(n, _mm_set1_ps(TB_LIBM_VECTOR_EXP_C1)));
+    x = _mm_sub_ps(x, _mm_mul_ps(n, _mm_set1_ps(TB_LIBM_VECTOR_EXP_C2)));
+
+    // the polynomial
+    __m128 z = _mm_mul_ps(x, x);
+    __m128 y = _mm_set1_ps(TB_LIBM_VECTOR_EXP_P0);
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(TB_LIBM_VECTOR_EXP_P1));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(TB_LIBM_VECTOR_EXP_P2));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(TB_LIBM_VECTOR_EXP_P3));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(TB_LIBM_VECTOR_EXP_P4));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(TB_LIBM_VECTOR_EXP_P5));
+    y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(y, z), x), _mm_set1_ps(1.0f));
+
+    // 2^n
+    __m128i e = _mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(n), _mm_set1_epi32(127)), 23);
+    _mm_storeu_ps(py, _mm_mul_ps(y, _mm_castsi128_ps(e)));
+}
+
+#endif
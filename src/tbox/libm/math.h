@@ -122,6 +122,21 @@ tb_float_t      tb_powf(tb_float_t x, tb_float_t y);
 // fmod
 tb_double_t     tb_fmod(tb_double_t x, tb_double_t y);
 tb_float_t      tb_fmodf(tb_float_t x, tb_float_t y);
+
+/* the batch versions: y[i] = f(x[i]) using sse2 or neon, x and y may be the same array
+ *
+ * the max error:
+ *
+ * tb_sqrtf_n:                  correctly rounded
+ * tb_sinf_n/cosf_n/sincosf_n:  1.5 ulp for |x| <= pi, and the absolute error is less than 1e-7 for |x| <= 8192,
+ *                              the larger arguments, inf and nan will use tb_sincosf
+ * tb_expf_n:                   1 ulp for x in [-87.3, 88.3], it will be zero if x < -88.3 and be inf if x > 88.3
+ */
+tb_void_t       tb_sqrtf_n(tb_float_t const* x, tb_float_t* y, tb_size_t n);
+tb_void_t       tb_sinf_n(tb_float_t const* x, tb_float_t* y, tb_size_t n);
+tb_void_t       tb_cosf_n(tb_float_t const* x, tb_float_t* y, tb_size_t n);
+tb_void_t       tb_sincosf_n(tb_float_t const* x, tb_float_t* s, tb_float_t* c, tb_size_t n);
+tb_void_t       tb_expf_n(tb_float_t const* x, tb_float_t* y, tb_size_t n);
 #endif
 
 // ilog2i
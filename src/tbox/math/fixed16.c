@@ -27,6 +27,9 @@
 #include "fixed30.h"
 #include "int32.h"
 #include "../utils/utils.h"
+#if defined(TB_ARCH_ARM_NEON) && !defined(__tb_debug__)
+#   include <arm_neon.h>
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals
@@ -355,3 +358,36 @@ tb_fixed16_t tb_fixed16_exp_int32(tb_fixed16_t x)
     tb_trace_noimpl();
     return 0;
 }
+tb_void_t tb_fixed16_mul_n(tb_fixed16_t const* x, tb_fixed16_t const* y, tb_fixed16_t* z, tb_size_t n)
+{
+    // check
+    tb_assert_and_check_return(x && y && z);
+
+    // done
+    tb_size_t i = 0;
+#if defined(TB_ARCH_ARM_NEON) && !defined(__tb_debug__)
+    for (; i + 4 <= n; i += 4)
+    {
+        // load x and y
+        int32x4_t a = vld1q_s32(x + i);
+        int32x4_t b = vld1q_s32(y + i);
+
+        // (x * y) >> 16
+        int32x2_t l = vshrn_n_s64(vmull_s32(vget_low_s32(a), vget_low_s32(b)), 16);
+        int32x2_t h = vshrn_n_s64(vmull_s32(vget_high_s32(a), vget_high_s32(b)), 16);
+        vst1q_s32(z + i, vcombine_s32(l, h));
+    }
+#endif
+
+    // the compiler will vectorize it if possible
+    for (; i < n; i++) z[i] = tb_fixed16_mul(x[i], y[i]);
+}
+tb_void_t tb_fixed16_sincos_n(tb_fixed16_t const* x, tb_fixed16_t* s, tb_fixed16_t* c, tb_size_t n)
+{
+    // check
+    tb_assert_and_check_return(x && s && c);
+
+    // done
+    tb_size_t i = 0;
+    for (i = 0; i < n; i++) tb_fixed16_sincos(x[i], s + i, c + i);
+}
@@ -328,6 +328,24 @@ tb_fixed16_t    tb_fixed16_atan_int32(tb_fixed16_t x);
  */
 tb_fixed16_t    tb_fixed16_exp_int32(tb_fixed16_t x);
 
+/*! compute the products of the fixed-point arrays: z[i] = x[i] * y[i]
+ *
+ * @param x     the fixed-point x-values
+ * @param y     the fixed-point y-values
+ * @param z     the results, it may be the same array as x or y
+ * @param n     the value count
+ */
+tb_void_t       tb_fixed16_mul_n(tb_fixed16_t const* x, tb_fixed16_t const* y, tb_fixed16_t* z, tb_size_t n);
+
+/*! compute the sin and cos values of the fixed-point array
+ *
+ * @param x     the fixed-point x-values
+ * @param s     the sin fixed-point values
+ * @param c     the cos fixed-point values
+ * @param n     the value count
+ */
+tb_void_t       tb_fixed16_sincos_n(tb_fixed16_t const* x, tb_fixed16_t* s, tb_fixed16_t* c, tb_size_t n);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * inlines
  */
@@ -27,6 +27,7 @@
  * includes
  */
 #include "prefix.h"
+#include "../random.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -37,14 +38,6 @@ __tb_extern_c_enter__
  * types
  */
 
-// the random type enum
-typedef enum __tb_random_type_e
-{
-    TB_RANDOM_TYPE_NONE       = 0
-,   TB_RANDOM_TYPE_LINEAR     = 1
-
-}tb_random_type_e;
-
 // the random impl type
 typedef struct __tb_random_impl_t
 {
@@ -60,11 +53,28 @@ typedef struct __tb_random_impl_t
     // clear
     tb_void_t           (*clear)(struct __tb_random_impl_t* random);
 
-    // range
-    tb_long_t           (*range)(struct __tb_random_impl_t* random, tb_long_t beg, tb_long_t end);
+    // the next uint64 value
+    tb_uint64_t         (*next)(struct __tb_random_impl_t* random);
+
+    // fill the uint64 values, optional
+    tb_void_t           (*fill)(struct __tb_random_impl_t* random, tb_uint64_t* data, tb_size_t size);
 
 }tb_random_impl_t;
 
+// the xoshiro random type
+typedef struct __tb_random_xoshiro_t
+{
+    // the base
+    tb_random_impl_t        base;
+
+    // the seed
+    tb_size_t               seed;
+
+    // the state
+    tb_uint64_t             state[4];
+
+}tb_random_xoshiro_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * declaration
  */
@@ -77,6 +87,45 @@ typedef struct __tb_random_impl_t
  */
 tb_random_impl_t*       tb_random_linear_init(tb_size_t seed);
 
+/* init the xoshiro256** random
+ *
+ * @param seed          the seed
+ *
+ * @return              the random
+ */
+tb_random_impl_t*       tb_random_xoshiro_init(tb_size_t seed);
+
+/* init the xoshiro256** random using the given space, it need not be exited
+ *
+ * @param random        the random space
+ * @param seed          the seed
+ *
+ * @return              the random
+ */
+tb_random_impl_t*       tb_random_xoshiro_init_static(tb_random_xoshiro_t* random, tb_size_t seed);
+
+/* init the pcg32 random
+ *
+ * @param seed          the seed
+ *
+ * @return              the random
+ */
+tb_random_impl_t*       tb_random_pcg_init(tb_size_t seed);
+
+/* the splitmix64 generator for expanding the seed to the random state
+ *
+ * @param state         the state
+ *
+ * @return              the next value
+ */
+static __tb_inline__ tb_uint64_t tb_random_splitmix64(tb_uint64_t* state)
+{
+    tb_uint64_t z = (*state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -85,17 +85,21 @@ static tb_void_t tb_random_linear_clear(tb_random_impl_t* random)
     // clear
     lrandom->value = lrandom->seed;
 }
-static tb_long_t tb_random_linear_range(tb_random_impl_t* random, tb_long_t beg, tb_long_t end)
+static tb_uint64_t tb_random_linear_next(tb_random_impl_t* random)
 {
     // check
     tb_random_linear_t* lrandom = tb_random_linear_cast(random);
-    tb_assert_and_check_return_val(lrandom && beg < end, beg);
+    tb_assert_and_check_return_val(lrandom, 0);
 
-    // generate the next value
-    lrandom->value = (lrandom->value * 10807 + 1) & 0xffffffff;
-
-    // make the value with range
-    return (beg + (tb_long_t)(lrandom->value % (end - beg)));
+    // generate the next four values, only the high 16-bits of them have good enough quality
+    tb_uint64_t value = 0;
+    tb_size_t   i = 0;
+    for (i = 0; i < 4; i++)
+    {
+        lrandom->value = (lrandom->value * 10807 + 1) & 0xffffffff;
+        value = (value << 16) | (lrandom->value >> 16);
+    }
+    return value;
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -117,7 +121,7 @@ tb_random_impl_t* tb_random_linear_init(tb_size_t seed)
         random->base.exit   = tb_random_linear_exit;
         random->base.seed   = tb_random_linear_seed;
         random->base.clear  = tb_random_linear_clear;
-        random->base.range  = tb_random_linear_range;
+        random->base.next   = tb_random_linear_next;
         random->seed        = seed;
         random->value       = seed;
 
@@ -0,0 +1,138 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        random_pcg.c
+ * @ingroup     math
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "random_pcg"
+#define TB_TRACE_MODULE_DEBUG           (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "random.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the multiplier and increment of the lcg
+#define TB_RANDOM_PCG_MULT              (6364136223846793005ULL)
+#define TB_RANDOM_PCG_INCR              (1442695040888963407ULL)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the pcg random type
+typedef struct __tb_random_pcg_t
+{
+    // the base
+    tb_random_impl_t        base;
+
+    // the seed
+    tb_size_t               seed;
+
+    // the state
+    tb_uint64_t             state;
+
+}tb_random_pcg_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static __tb_inline__ tb_random_pcg_t* tb_random_pcg_cast(tb_random_impl_t* random)
+{
+    // check
+    tb_assert_and_check_return_val(random && random->type == TB_RANDOM_TYPE_PCG, tb_null);
+
+    // the random
+    return (tb_random_pcg_t*)random;
+}
+static __tb_inline__ tb_uint32_t tb_random_pcg_step(tb_random_pcg_t* random)
+{
+    // pcg32: xsh rr 64/32
+    tb_uint64_t s = random->state;
+    random->state = s * TB_RANDOM_PCG_MULT + TB_RANDOM_PCG_INCR;
+
+    // the output permutation
+    tb_uint32_t x = (tb_uint32_t)(((s >> 18) ^ s) >> 27);
+    tb_uint32_t r = (tb_uint32_t)(s >> 59);
+    return (x >> r) | (x << ((32 - r) & 31));
+}
+static tb_void_t tb_random_pcg_exit(tb_random_impl_t* random)
+{
+    // exit it
+    if (random) tb_free((tb_pointer_t)random);
+}
+static tb_void_t tb_random_pcg_seed(tb_random_impl_t* random, tb_size_t seed)
+{
+    // check
+    tb_random_pcg_t* prandom = tb_random_pcg_cast(random);
+    tb_assert_and_check_return(prandom);
+
+    // update seed
+    tb_uint64_t s = (tb_uint64_t)seed;
+    prandom->seed   = seed;
+    prandom->state  = tb_random_splitmix64(&s);
+}
+static tb_void_t tb_random_pcg_clear(tb_random_impl_t* random)
+{
+    // check
+    tb_random_pcg_t* prandom = tb_random_pcg_cast(random);
+    tb_assert_and_check_return(prandom);
+
+    // reset to the initial state
+    tb_random_pcg_seed(random, prandom->seed);
+}
+static tb_uint64_t tb_random_pcg_next(tb_random_impl_t* random)
+{
+    // check
+    tb_random_pcg_t* prandom = tb_random_pcg_cast(random);
+    tb_assert_and_check_return_val(prandom, 0);
+
+    // generate the next two values
+    tb_uint64_t hi = tb_random_pcg_step(prandom);
+    return (hi << 32) | tb_random_pcg_step(prandom);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+tb_random_impl_t* tb_random_pcg_init(tb_size_t seed)
+{
+    // make random
+    tb_random_pcg_t* random = tb_malloc0_type(tb_random_pcg_t);
+    tb_assert_and_check_return_val(random, tb_null);
+
+    // init random
+    random->base.type   = TB_RANDOM_TYPE_PCG;
+    random->base.exit   = tb_random_pcg_exit;
+    random->base.seed   = tb_random_pcg_seed;
+    random->base.clear  = tb_random_pcg_clear;
+    random->base.next   = tb_random_pcg_next;
+    tb_random_pcg_seed((tb_random_impl_t*)random, seed);
+
+    // ok
+    return (tb_random_impl_t*)random;
+}
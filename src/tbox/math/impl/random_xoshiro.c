@@ -0,0 +1,170 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        random_xoshiro.c
+ * @ingroup     math
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "random_xoshiro"
+#define TB_TRACE_MODULE_DEBUG           (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "random.h"
+#include "../../libc/libc.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// rotate left
+#define tb_random_xoshiro_rotl(x, k)    (((x) << (k)) | ((x) >> (64 - (k))))
+
+/* the next value of xoshiro256**
+ *
+ * we use the local state variables for keeping them in the registers
+ */
+#define tb_random_xoshiro_step(r, s0, s1, s2, s3) \
+    do \
+    { \
+        tb_uint64_t __t = (s1) << 17; \
+        (r) = tb_random_xoshiro_rotl((s1) * 5, 7) * 9; \
+        (s2) ^= (s0); \
+        (s3) ^= (s1); \
+        (s1) ^= (s2); \
+        (s0) ^= (s3); \
+        (s2) ^= __t; \
+        (s3) = tb_random_xoshiro_rotl((s3), 45); \
+    \
+    } while (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static __tb_inline__ tb_random_xoshiro_t* tb_random_xoshiro_cast(tb_random_impl_t* random)
+{
+    // check
+    tb_assert_and_check_return_val(random && random->type == TB_RANDOM_TYPE_XOSHIRO, tb_null);
+
+    // the random
+    return (tb_random_xoshiro_t*)random;
+}
+static tb_void_t tb_random_xoshiro_exit(tb_random_impl_t* random)
+{
+    // exit it
+    if (random) tb_free((tb_pointer_t)random);
+}
+static tb_void_t tb_random_xoshiro_seed(tb_random_impl_t* random, tb_size_t seed)
+{
+    // check
+    tb_random_xoshiro_t* xrandom = tb_random_xoshiro_cast(random);
+    tb_assert_and_check_return(xrandom);
+
+    // expand the seed to the state, it will never be all zero
+    tb_uint64_t s = (tb_uint64_t)seed;
+    xrandom->seed       = seed;
+    xrandom->state[0]   = tb_random_splitmix64(&s);
+    xrandom->state[1]   = tb_random_splitmix64(&s);
+    xrandom->state[2]   = tb_random_splitmix64(&s);
+    xrandom->state[3]   = tb_random_splitmix64(&s);
+}
+static tb_void_t tb_random_xoshiro_clear(tb_random_impl_t* random)
+{
+    // check
+    tb_random_xoshiro_t* xrandom = tb_random_xoshiro_cast(random);
+    tb_assert_and_check_return(xrandom);
+
+    // reset to the initial state
+    tb_random_xoshiro_seed(random, xrandom->seed);
+}
+static tb_uint64_t tb_random_xoshiro_next(tb_random_impl_t* random)
+{
+    // check
+    tb_random_xoshiro_t* xrandom = tb_random_xoshiro_cast(random);
+    tb_assert_and_check_return_val(xrandom, 0);
+
+    // next
+    tb_uint64_t r;
+    tb_random_xoshiro_step(r, xrandom->state[0], xrandom->state[1], xrandom->state[2], xrandom->state[3]);
+    return r;
+}
+static tb_void_t tb_random_xoshiro_fill(tb_random_impl_t* random, tb_uint64_t* data, tb_size_t size)
+{
+    // check
+    tb_random_xoshiro_t* xrandom = tb_random_xoshiro_cast(random);
+    tb_assert_and_check_return(xrandom && data);
+
+    // load state
+    tb_uint64_t s0 = xrandom->state[0];
+    tb_uint64_t s1 = xrandom->state[1];
+    tb_uint64_t s2 = xrandom->state[2];
+    tb_uint64_t s3 = xrandom->state[3];
+
+    // fill it
+    tb_uint64_t const* e = data + size;
+    while (data < e)
+    {
+        tb_random_xoshiro_step(*data, s0, s1, s2, s3);
+        data++;
+    }
+
+    // save state
+    xrandom->state[0] = s0;
+    xrandom->state[1] = s1;
+    xrandom->state[2] = s2;
+    xrandom->state[3] = s3;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+tb_random_impl_t* tb_random_xoshiro_init_static(tb_random_xoshiro_t* random, tb_size_t seed)
+{
+    // check
+    tb_assert_and_check_return_val(random, tb_null);
+
+    // init random
+    tb_memset(random, 0, sizeof(tb_random_xoshiro_t));
+    random->base.type   = TB_RANDOM_TYPE_XOSHIRO;
+    random->base.seed   = tb_random_xoshiro_seed;
+    random->base.clear  = tb_random_xoshiro_clear;
+    random->base.next   = tb_random_xoshiro_next;
+    random->base.fill   = tb_random_xoshiro_fill;
+    tb_random_xoshiro_seed((tb_random_impl_t*)random, seed);
+
+    // ok
+    return (tb_random_impl_t*)random;
+}
+tb_random_impl_t* tb_random_xoshiro_init(tb_size_t seed)
+{
+    // make random
+    tb_random_xoshiro_t* random = tb_malloc0_type(tb_random_xoshiro_t);
+    tb_assert_and_check_return_val(random, tb_null);
+
+    // init random
+    tb_random_xoshiro_init_static(random, seed);
+    random->base.exit = tb_random_xoshiro_exit;
+
+    // ok
+    return (tb_random_impl_t*)random;
+}
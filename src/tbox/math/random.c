@@ -27,29 +27,122 @@
 #include "random.h"
 #include "impl/random.h"
 #include "../utils/utils.h"
+#include "../platform/platform.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the chunk size for filling the uint32 and float randoms
+#define TB_RANDOM_FILL_CHUNK        (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+#ifdef __tb_thread_local__
+// the default random for the current thread
+static __tb_thread_local__ tb_random_xoshiro_t  g_random;
+#else
+// the lock of the default random
+static tb_spinlock_t                            g_lock = TB_SPINLOCK_INIT;
+#endif
+
+// the seed count
+static tb_atomic_t                              g_seed_count = 0;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * instance implementation
  */
+static tb_size_t tb_random_instance_seed(tb_cpointer_t addr)
+{
+    // mix the cycle counter, the monotonic clock, the thread local address and the seed count
+    tb_uint64_t s = tb_cycle() ^ ((tb_uint64_t)tb_nclock() << 20) ^ ((tb_uint64_t)(tb_size_t)addr << 8);
+    s ^= (tb_uint64_t)tb_atomic_fetch_and_inc(&g_seed_count) << 48;
+    return (tb_size_t)tb_random_splitmix64(&s);
+}
+#ifndef __tb_thread_local__
 static tb_handle_t tb_random_instance_init(tb_cpointer_t* ppriv)
 {
     // init it
-    return (tb_handle_t)tb_random_init(TB_RANDOM_TYPE_LINEAR, 2166136261ul);
+    tb_random_ref_t random = (tb_random_ref_t)tb_random_xoshiro_init(0);
+    if (random) tb_random_seed(random, tb_random_instance_seed(random));
+    return (tb_handle_t)random;
 }
 static tb_void_t tb_random_instance_exit(tb_handle_t handle, tb_cpointer_t priv)
 {
     // exit it
     tb_random_exit((tb_random_ref_t)handle);
 }
+#endif
 static tb_random_impl_t* tb_random_instance(tb_noarg_t)
 {
+#ifdef __tb_thread_local__
+    // init the default random of the current thread if not exists
+    if (__tb_unlikely__(!g_random.base.type)) 
+        tb_random_xoshiro_init_static(&g_random, tb_random_instance_seed(&g_random));
+
+    // ok
+    return (tb_random_impl_t*)&g_random;
+#else
     return (tb_random_impl_t*)tb_singleton_instance(TB_SINGLETON_TYPE_RANDOM, tb_random_instance_init, tb_random_instance_exit, tb_null, tb_null);
+#endif
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
- * implementation
+ * private implementation
  */
+#ifdef __tb_thread_local__
+#   define tb_random_enter(random)      tb_random_impl_t* impl = random? (tb_random_impl_t*)random : tb_random_instance()
+#   define tb_random_leave(random)      
+#else
+#   define tb_random_enter(random)      tb_random_impl_t* impl = random? (tb_random_impl_t*)random : tb_random_instance(); \
+                                        if (!random) tb_spinlock_enter(&g_lock)
+#   define tb_random_leave(random)      if (!random) tb_spinlock_leave(&g_lock)
+#endif
+static tb_void_t tb_random_fill_impl(tb_random_impl_t* impl, tb_uint64_t* data, tb_size_t size)
+{
+    // fill it
+    if (impl->fill) impl->fill(impl, data, size);
+    else
+    {
+        tb_uint64_t const* e = data + size;
+        while (data < e) *data++ = impl->next(impl);
+    }
+}
+static tb_uint64_t tb_random_bound_impl(tb_random_impl_t* impl, tb_uint64_t bound)
+{
+    // the 32-bits bound? 
+    if (bound <= TB_MAXU32)
+    {
+        /* the multiply-shift method without the modulo bias
+         *
+         * Daniel Lemire, Fast Random Integer Generation in an Interval
+         */
+        tb_uint32_t b = (tb_uint32_t)bound;
+        tb_uint64_t m = (impl->next(impl) >> 32) * b;
+        if ((tb_uint32_t)m < b)
+        {
+            tb_uint32_t t = (tb_uint32_t)(-b) % b;
+            while ((tb_uint32_t)m < t) m = (impl->next(impl) >> 32) * b;
+        }
+        return m >> 32;
+    }
 
+    // reject the biased values 
+    tb_uint64_t t = (0 - bound) % bound;
+    tb_uint64_t x;
+    do
+    {
+        x = impl->next(impl);
+
+    } while (x < t);
+    return x % bound;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
 tb_random_ref_t tb_random_init(tb_size_t type, tb_size_t seed)
 {
     // the init func
@@ -57,6 +150,8 @@ tb_random_ref_t tb_random_init(tb_size_t type, tb_size_t seed)
     {
         tb_null
     ,   tb_random_linear_init
+    ,   tb_random_xoshiro_init
+    ,   tb_random_pcg_init
     };
     tb_assert_and_check_return_val(type < tb_arrayn(s_init) && s_init[type], tb_null);
 
@@ -75,29 +170,45 @@ tb_void_t tb_random_exit(tb_random_ref_t random)
 tb_void_t tb_random_seed(tb_random_ref_t random, tb_size_t seed)
 {
     // check
-    tb_random_impl_t* impl = random? (tb_random_impl_t*)random : tb_random_instance();
-    tb_assert_and_check_return(impl && impl->seed);
+    tb_random_enter(random);
+    tb_assert(impl && impl->seed);
 
     // seed it
-    impl->seed(impl, seed);
+    if (impl && impl->seed) impl->seed(impl, seed);
+
+    // leave
+    tb_random_leave(random);
 }
 tb_void_t tb_random_clear(tb_random_ref_t random)
 {
     // check
-    tb_random_impl_t* impl = random? (tb_random_impl_t*)random : tb_random_instance();
-    tb_assert_and_check_return(impl && impl->clear);
+    tb_random_enter(random);
+    tb_assert(impl && impl->clear);
 
     // clear it
-    impl->clear(impl);
+    if (impl && impl->clear) impl->clear(impl);
+
+    // leave
+    tb_random_leave(random);
 }
 tb_long_t tb_random_range(tb_random_ref_t random, tb_long_t beg, tb_long_t end)
 {
     // check
-    tb_random_impl_t* impl = random? (tb_random_impl_t*)random : tb_random_instance();
-    tb_assert_and_check_return_val(impl && impl->range && beg < end, beg);
+    tb_assert_and_check_return_val(beg < end, beg);
+
+    // enter
+    tb_random_enter(random);
+    tb_assert(impl && impl->next);
 
     // range it
-    return impl->range(impl, beg, end);
+    tb_long_t value = beg;
+    if (impl && impl->next) value = (tb_long_t)((tb_size_t)beg + (tb_size_t)tb_random_bound_impl(impl, (tb_uint64_t)((tb_size_t)end - (tb_size_t)beg)));
+
+    // leave
+    tb_random_leave(random);
+
+    // ok
+    return value;
 }
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
 tb_float_t tb_random_rangef(tb_random_ref_t random, tb_float_t beg, tb_float_t end)
@@ -105,11 +216,12 @@ tb_float_t tb_random_rangef(tb_random_ref_t random, tb_float_t beg, tb_float_t e
     // check
     tb_assert_and_check_return_val(beg < end, beg);
 
-    // the factor
-    tb_double_t factor = (tb_double_t)tb_random_range(random, 0, TB_MAXS32) / (tb_double_t)TB_MAXS32;
+    // the factor: [0, 1)
+    tb_double_t factor = (tb_double_t)(tb_random_u64(random) >> 11) * (1.0 / 9007199254740992.0);
 
     // the value
-    return (tb_float_t)((end - beg) * factor);
+    tb_float_t value = (tb_float_t)(beg + (end - beg) * factor);
+    return value < end? value : beg;
 }
 #endif
 tb_long_t tb_random_value(tb_random_ref_t random)
@@ -120,4 +232,105 @@ tb_long_t tb_random_value(tb_random_ref_t random)
     return tb_random_range(random, 0, TB_MAXS32);
 #endif
 }
+tb_uint32_t tb_random_u32(tb_random_ref_t random)
+{
+    return (tb_uint32_t)(tb_random_u64(random) >> 32);
+}
+tb_uint64_t tb_random_u64(tb_random_ref_t random)
+{
+    // enter
+    tb_random_enter(random);
+    tb_assert(impl && impl->next);
+
+    // next
+    tb_uint64_t value = (impl && impl->next)? impl->next(impl) : 0;
+
+    // leave
+    tb_random_leave(random);
+
+    // ok
+    return value;
+}
+tb_void_t tb_random_fill_u64(tb_random_ref_t random, tb_uint64_t* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return(data);
+
+    // enter
+    tb_random_enter(random);
+    tb_assert(impl && impl->next);
+
+    // fill it
+    if (impl && impl->next) tb_random_fill_impl(impl, data, size);
+
+    // leave
+    tb_random_leave(random);
+}
+tb_void_t tb_random_fill_u32(tb_random_ref_t random, tb_uint32_t* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return(data);
+
+    // enter
+    tb_random_enter(random);
+    tb_assert(impl && impl->next);
+
+    // fill it
+    if (impl && impl->next)
+    {
+        // fill the chunks
+        tb_uint64_t chunk[TB_RANDOM_FILL_CHUNK];
+        while (size)
+        {
+            // the count of the uint64 values
+            tb_size_t n = tb_min((size + 1) >> 1, TB_RANDOM_FILL_CHUNK);
+            tb_random_fill_impl(impl, chunk, n);
 
+            // split them to the uint32 values
+            tb_size_t i = 0;
+            for (i = 0; i < n && size; i++)
+            {
+                *data++ = (tb_uint32_t)(chunk[i] >> 32); size--;
+                if (size) { *data++ = (tb_uint32_t)chunk[i]; size--; }
+            }
+        }
+    }
+
+    // leave
+    tb_random_leave(random);
+}
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+tb_void_t tb_random_fill_float(tb_random_ref_t random, tb_float_t* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return(data);
+
+    // enter
+    tb_random_enter(random);
+    tb_assert(impl && impl->next);
+
+    // fill it
+    if (impl && impl->next)
+    {
+        // fill the chunks
+        tb_uint64_t chunk[TB_RANDOM_FILL_CHUNK];
+        while (size)
+        {
+            // the count of the uint64 values
+            tb_size_t n = tb_min((size + 1) >> 1, TB_RANDOM_FILL_CHUNK);
+            tb_random_fill_impl(impl, chunk, n);
+
+            // make two floats with the 24-bits mantissa from each value: [0, 1)
+            tb_size_t i = 0;
+            for (i = 0; i < n && size; i++)
+            {
+                *data++ = (tb_float_t)(chunk[i] >> 40) * (1.0f / 16777216.0f); size--;
+                if (size) { *data++ = (tb_float_t)((chunk[i] >> 8) & 0xffffff) * (1.0f / 16777216.0f); size--; }
+            }
+        }
+    }
+
+    // leave
+    tb_random_leave(random);
+}
+#endif
@@ -38,6 +38,16 @@ __tb_extern_c_enter__
  * types
  */
 
+/// the random type enum
+typedef enum __tb_random_type_e
+{
+    TB_RANDOM_TYPE_NONE       = 0
+,   TB_RANDOM_TYPE_LINEAR     = 1   //!< the linear congruential generator, only for the compatibility
+,   TB_RANDOM_TYPE_XOSHIRO    = 2   //!< the xoshiro256** generator, fast and good quality
+,   TB_RANDOM_TYPE_PCG        = 3   //!< the pcg32 generator, small state and good quality
+
+}tb_random_type_e;
+
 /// the random ref type
 typedef struct{}*   tb_random_ref_t;
 
@@ -46,6 +56,8 @@ typedef struct{}*   tb_random_ref_t;
  */
 
 /*! init random
+ *
+ * @note the random is not thread-safe, but the default random (null) is a lock-free per-thread generator
  * 
  * @param type      the random type
  * @param seed      the random seed
@@ -73,7 +85,7 @@ tb_void_t           tb_random_seed(tb_random_ref_t random, tb_size_t seed);
  */
 tb_void_t           tb_random_clear(tb_random_ref_t random);
 
-/*! generate the random with range: [beg, end)
+/*! generate the random with range: [beg, end) and without the modulo bias
  *
  * @param random    the random, using the default random if be null
  * @param beg       the begin value
@@ -103,6 +115,48 @@ tb_float_t          tb_random_rangef(tb_random_ref_t random, tb_float_t beg, tb_
  */
 tb_long_t           tb_random_value(tb_random_ref_t random);
 
+/*! generate the uint32 random 
+ *
+ * @param random    the random, using the default random if be null
+ *
+ * @return          the random value
+ */
+tb_uint32_t         tb_random_u32(tb_random_ref_t random);
+
+/*! generate the uint64 random 
+ *
+ * @param random    the random, using the default random if be null
+ *
+ * @return          the random value
+ */
+tb_uint64_t         tb_random_u64(tb_random_ref_t random);
+
+/*! fill the uint32 randoms
+ *
+ * @param random    the random, using the default random if be null
+ * @param data      the data
+ * @param size      the item count
+ */
+tb_void_t           tb_random_fill_u32(tb_random_ref_t random, tb_uint32_t* data, tb_size_t size);
+
+/*! fill the uint64 randoms
+ *
+ * @param random    the random, using the default random if be null
+ * @param data      the data
+ * @param size      the item count
+ */
+tb_void_t           tb_random_fill_u64(tb_random_ref_t random, tb_uint64_t* data, tb_size_t size);
+
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+/*! fill the float randoms with range: [0, 1)
+ *
+ * @param random    the random, using the default random if be null
+ * @param data      the data
+ * @param size      the item count
+ */
+tb_void_t           tb_random_fill_float(tb_random_ref_t random, tb_float_t* data, tb_size_t size);
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -28,6 +28,7 @@
 #include "memory.h"
 #include "../libc/libc.h"
 #include "../utils/utils.h"
+#include "../platform/atomic.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -39,6 +40,77 @@
 #   define TB_BUFFER_GROW_SIZE       (256)
 #endif
 
+/* the head size of the heap data
+ *
+ * <pre>
+ * [refn][data ...]
+ *       |
+ *  buffer->data
+ * </pre>
+ *
+ * the heap data may be shared by some buffers and will be copied before modifying it
+ */
+#define TB_BUFFER_HEAD_SIZE         (8)
+
+// the reference count of the heap data
+#define tb_buffer_data_refn(data)   ((tb_atomic_t*)((tb_byte_t*)(data) - TB_BUFFER_HEAD_SIZE))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_byte_t* tb_buffer_data_init(tb_size_t maxn)
+{
+    // make data
+    tb_byte_t* head = tb_malloc_bytes(TB_BUFFER_HEAD_SIZE + maxn);
+    tb_assert_and_check_return_val(head, tb_null);
+
+    // init the reference count
+    *((tb_atomic_t*)head) = 1;
+    return head + TB_BUFFER_HEAD_SIZE;
+}
+static tb_byte_t* tb_buffer_data_ralloc(tb_byte_t* data, tb_size_t maxn)
+{
+    // ralloc data, we must be the only owner
+    tb_byte_t* head = (tb_byte_t*)tb_ralloc(data - TB_BUFFER_HEAD_SIZE, TB_BUFFER_HEAD_SIZE + maxn);
+    return head? head + TB_BUFFER_HEAD_SIZE : tb_null;
+}
+static tb_void_t tb_buffer_data_exit(tb_byte_t* data)
+{
+    // free data if it is not shared
+    if (tb_atomic_fetch_and_dec(tb_buffer_data_refn(data)) == 1) tb_free(data - TB_BUFFER_HEAD_SIZE);
+}
+static __tb_inline__ tb_bool_t tb_buffer_data_shared(tb_buffer_ref_t buffer)
+{
+    return buffer->data != buffer->buff && tb_atomic_get(tb_buffer_data_refn(buffer->data)) > 1;
+}
+static tb_bool_t tb_buffer_data_unshare(tb_buffer_ref_t buffer, tb_size_t size)
+{
+    /* make the own data for the given size, using the static buffer if possible
+     *
+     * @note only the data in [0, size) will be copied, 
+     * the caller need unshare it with buffer->size first if it will read the data out of the new size
+     */
+    tb_byte_t*  data = buffer->buff;
+    tb_size_t   maxn = sizeof(buffer->buff);
+    if (size > maxn)
+    {
+        maxn = tb_align8(size + TB_BUFFER_GROW_SIZE);
+        data = tb_buffer_data_init(maxn);
+        tb_assert_and_check_return_val(data, tb_false);
+    }
+
+    // copy the used data
+    tb_memcpy(data, buffer->data, tb_min(buffer->size, size));
+
+    // leave the shared data
+    tb_buffer_data_exit(buffer->data);
+
+    // update the buffer
+    buffer->data = data;
+    buffer->maxn = maxn;
+    return tb_true;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -64,7 +136,7 @@ tb_void_t tb_buffer_exit(tb_buffer_ref_t buffer)
     tb_buffer_clear(buffer);
 
     // exit data
-    if (buffer->data && buffer->data != buffer->buff) tb_free(buffer->data);
+    if (buffer->data && buffer->data != buffer->buff) tb_buffer_data_exit(buffer->data);
     buffer->data = buffer->buff;
 
     // exit size
@@ -76,6 +148,17 @@ tb_byte_t* tb_buffer_data(tb_buffer_ref_t buffer)
     // check
     tb_assert_and_check_return_val(buffer, tb_null);
 
+    // the data may be modified, copy it if be shared
+    if (tb_buffer_data_shared(buffer) && !tb_buffer_data_unshare(buffer, buffer->size)) return tb_null;
+
+    // the buffer data
+    return buffer->data;
+}
+tb_byte_t const* tb_buffer_cdata(tb_buffer_ref_t buffer)
+{
+    // check
+    tb_assert_and_check_return_val(buffer, tb_null);
+
     // the buffer data
     return buffer->data;
 }
@@ -100,6 +183,14 @@ tb_void_t tb_buffer_clear(tb_buffer_ref_t buffer)
     // check
     tb_assert_and_check_return(buffer);
 
+    // leave the shared data
+    if (tb_buffer_data_shared(buffer))
+    {
+        tb_buffer_data_exit(buffer->data);
+        buffer->data = buffer->buff;
+        buffer->maxn = sizeof(buffer->buff);
+    }
+
     // clear it
     buffer->size = 0;
 }
@@ -108,6 +199,9 @@ tb_byte_t* tb_buffer_resize(tb_buffer_ref_t buffer, tb_size_t size)
     // check
     tb_assert_and_check_return_val(buffer && size, tb_null);
 
+    // copy the shared data before modifying it
+    if (tb_buffer_data_shared(buffer) && !tb_buffer_data_unshare(buffer, size)) return tb_null;
+
     // done
     tb_bool_t   ok = tb_false;
     tb_byte_t*  buff_data = buffer->data;
@@ -129,7 +223,7 @@ tb_byte_t* tb_buffer_resize(tb_buffer_ref_t buffer, tb_size_t size)
                 tb_assert_and_check_break(size <= buff_maxn);
 
                 // grow data
-                buff_data = tb_malloc_bytes(buff_maxn);
+                buff_data = tb_buffer_data_init(buff_maxn);
                 tb_assert_and_check_break(buff_data);
 
                 // copy data
@@ -149,7 +243,7 @@ tb_byte_t* tb_buffer_resize(tb_buffer_ref_t buffer, tb_size_t size)
                 tb_assert_and_check_break(size <= buff_maxn);
 
                 // grow data
-                buff_data = (tb_byte_t*)tb_ralloc(buff_data, buff_maxn);
+                buff_data = tb_buffer_data_ralloc(buff_data, buff_maxn);
                 tb_assert_and_check_break(buff_data);
             }
 #if 0
@@ -163,7 +257,7 @@ tb_byte_t* tb_buffer_resize(tb_buffer_ref_t buffer, tb_size_t size)
                 tb_memcpy(buffer->buff, buff_data, size);
 
                 // free data
-                tb_free(buff_data);
+                tb_buffer_data_exit(buff_data);
 
                 // using the static buffer
                 buff_data = buffer->buff;
@@ -222,11 +316,11 @@ tb_byte_t* tb_buffer_memnsetp(tb_buffer_ref_t buffer, tb_size_t p, tb_byte_t b,
 }
 tb_byte_t* tb_buffer_memcpy(tb_buffer_ref_t buffer, tb_buffer_ref_t b)
 {
-    return tb_buffer_memncpyp(buffer, 0, tb_buffer_data(b), tb_buffer_size(b));
+    return tb_buffer_memncpyp(buffer, 0, tb_buffer_cdata(b), tb_buffer_size(b));
 }
 tb_byte_t* tb_buffer_memcpyp(tb_buffer_ref_t buffer, tb_size_t p, tb_buffer_ref_t b)
 {
-    return tb_buffer_memncpyp(buffer, p, tb_buffer_data(b), tb_buffer_size(b));
+    return tb_buffer_memncpyp(buffer, p, tb_buffer_cdata(b), tb_buffer_size(b));
 }
 tb_byte_t* tb_buffer_memncpy(tb_buffer_ref_t buffer, tb_byte_t const* b, tb_size_t n)
 {
@@ -240,6 +334,9 @@ tb_byte_t* tb_buffer_memncpyp(tb_buffer_ref_t buffer, tb_size_t p, tb_byte_t con
     // check
     tb_check_return_val(n, tb_buffer_data(buffer));
 
+    // the old shared data will be overwritten, leave it directly without copying
+    if (!p && tb_buffer_data_shared(buffer)) tb_buffer_clear(buffer);
+
     // resize
     tb_byte_t* d = tb_buffer_resize(buffer, p + n);
     tb_assert_and_check_return_val(d, tb_null);
@@ -281,6 +378,12 @@ tb_byte_t* tb_buffer_memnmovp(tb_buffer_ref_t buffer, tb_size_t p, tb_size_t b,
     // check
     tb_check_return_val(p != b && n, tb_buffer_data(buffer));
 
+    /* copy all the shared data before resizing it
+     *
+     * the moved data [b, b + n) may be out of the new size and resizing it will only copy the new size
+     */
+    if (tb_buffer_data_shared(buffer) && !tb_buffer_data_unshare(buffer, buffer->size)) return tb_null;
+
     // resize
     tb_byte_t* d = tb_buffer_resize(buffer, p + n);
     tb_assert_and_check_return_val(d, tb_null);
@@ -291,7 +394,7 @@ tb_byte_t* tb_buffer_memnmovp(tb_buffer_ref_t buffer, tb_size_t p, tb_size_t b,
 }
 tb_byte_t* tb_buffer_memcat(tb_buffer_ref_t buffer, tb_buffer_ref_t b)
 {
-    return tb_buffer_memncat(buffer, tb_buffer_data(b), tb_buffer_size(b));
+    return tb_buffer_memncat(buffer, tb_buffer_cdata(b), tb_buffer_size(b));
 }
 tb_byte_t* tb_buffer_memncat(tb_buffer_ref_t buffer, tb_byte_t const* b, tb_size_t n)
 {   
@@ -316,3 +419,33 @@ tb_byte_t* tb_buffer_memncat(tb_buffer_ref_t buffer, tb_byte_t const* b, tb_size
     return d;
 }
 
+tb_bool_t tb_buffer_share(tb_buffer_ref_t buffer, tb_buffer_ref_t b)
+{
+    // check
+    tb_assert_and_check_return_val(buffer && b, tb_false);
+
+    // the same buffer?
+    tb_check_return_val(buffer != b, tb_true);
+
+    // empty?
+    if (!b->size)
+    {
+        tb_buffer_clear(buffer);
+        return tb_true;
+    }
+
+    // copy the static data directly, it is cheaper than sharing it
+    if (b->data == b->buff) return tb_buffer_memncpy(buffer, b->data, b->size)? tb_true : tb_false;
+
+    // refer the heap data of b
+    tb_atomic_fetch_and_inc(tb_buffer_data_refn(b->data));
+
+    // leave the old data
+    if (buffer->data && buffer->data != buffer->buff) tb_buffer_data_exit(buffer->data);
+
+    // share it
+    buffer->data = b->data;
+    buffer->size = b->size;
+    buffer->maxn = b->maxn;
+    return tb_true;
+}
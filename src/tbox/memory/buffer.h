@@ -50,7 +50,7 @@ typedef struct __tb_buffer_t
     /// the buffer maxn
     tb_size_t       maxn;
 
-    /// the static buffer
+    /// the static buffer for the small data, the heap data is refcounted and may be shared
 #ifdef __tb_small__
     tb_byte_t       buff[32];
 #else
@@ -78,6 +78,8 @@ tb_bool_t           tb_buffer_init(tb_buffer_ref_t buffer);
 tb_void_t           tb_buffer_exit(tb_buffer_ref_t buffer);
 
 /*! the buffer data
+ *
+ * @note the shared data will be copied first, because the returned data may be modified
  *
  * @param buffer    the buffer
  *
@@ -85,6 +87,14 @@ tb_void_t           tb_buffer_exit(tb_buffer_ref_t buffer);
  */
 tb_byte_t*          tb_buffer_data(tb_buffer_ref_t buffer);
 
+/*! the const buffer data only for reading, the shared data will not be copied
+ *
+ * @param buffer    the buffer
+ *
+ * @return          the buffer data address
+ */
+tb_byte_t const*    tb_buffer_cdata(tb_buffer_ref_t buffer);
+
 /*! the buffer data size
  *
  * @param buffer    the buffer
@@ -255,6 +265,20 @@ tb_byte_t*          tb_buffer_memcat(tb_buffer_ref_t buffer, tb_buffer_ref_t b);
  */
 tb_byte_t*          tb_buffer_memncat(tb_buffer_ref_t buffer, tb_byte_t const* b, tb_size_t n);
 
+/*! share the data of b with copy-on-write
+ *
+ * the heap data of b will be shared by the reference count and be copied 
+ * only when one of the buffers is modified, the static data will be copied directly.
+ *
+ * @note the data address got by tb_buffer_data() before sharing must not be written after sharing
+ *
+ * @param buffer    the buffer
+ * @param b         the shared buffer
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_buffer_share(tb_buffer_ref_t buffer, tb_buffer_ref_t b);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
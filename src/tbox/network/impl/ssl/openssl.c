@@ -32,25 +32,80 @@
 #include "../../../asio/asio.h"
 #include "../../../utils/utils.h"
 #include "../../../platform/platform.h"
+#include "../../../container/container.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the bio and ssl structures are opaque since openssl 1.1
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+#   define TB_SSL_OPENSSL_OPAQUE
+#endif
+
+// the client sessions maxn
+#ifdef __tb_small__
+#   define TB_SSL_SESSIONS_MAXN         (64)
+#else
+#   define TB_SSL_SESSIONS_MAXN         (256)
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
+
+// the ssl shared context type
+typedef struct __tb_ssl_context_t
+{
+    // the lock
+    tb_spinlock_t       lock;
+
+    // the shared ssl contexts without certificate, client: 0, server: 1
+    SSL_CTX*            ctx[2];
+
+    // the shared ssl contexts with certificate, "client or server|cert|key" => SSL_CTX*, the certificate is loaded only once
+    tb_hash_map_ref_t   certs;
+
+    // the client sessions, "host:port" => SSL_SESSION*, saved by the new session callback of the client ctx
+    tb_hash_map_ref_t   sessions;
+
+#ifdef TB_SSL_OPENSSL_OPAQUE
+    // the bio method
+    BIO_METHOD*         bio_method;
+#endif
+
+}tb_ssl_context_t;
+
 // the ssl impl type
 typedef struct __tb_ssl_impl_t
 {
     // the ssl session
     SSL*                ssl;
 
-    // the ssl context
-    SSL_CTX*            ctx;
+    // the shared ssl context
+    tb_ssl_context_t*   context;
 
     // the ssl bio
     BIO*                bio;
 
+    // is server?
+    tb_bool_t           bserver;
+
     // is opened?
     tb_bool_t           bopened;
 
+    // the kernel tls mode
+    tb_size_t           ktls;
+
+    // the offloaded socket
+    tb_socket_ref_t     ktls_sock;
+
+    // has the application data been read or written? the record sequences are unknown for openssl 1.1 then
+    tb_bool_t           bappdata;
+
+    // the peer, "host:port"
+    tb_char_t           peer[TB_SSL_PEER_MAXN];
+
     // the state
     tb_size_t           state;
 
@@ -84,10 +139,12 @@ static tb_int_t         tb_ssl_bio_method_writ(BIO* bio, tb_char_t const* data,
 static tb_long_t        tb_ssl_bio_method_ctrl(BIO* bio, tb_int_t cmd, tb_long_t num, tb_pointer_t ptr);
 static tb_int_t         tb_ssl_bio_method_puts(BIO* bio, tb_char_t const* data);
 static tb_int_t         tb_ssl_bio_method_gets(BIO* bio, tb_char_t* data, tb_int_t size);
+static tb_int_t         tb_ssl_context_session_new(SSL* ssl, SSL_SESSION* session);
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals
  */
+#ifndef TB_SSL_OPENSSL_OPAQUE
 static BIO_METHOD g_ssl_bio_method =
 {
     BIO_TYPE_SOURCE_SINK | 100
@@ -101,24 +158,114 @@ static BIO_METHOD g_ssl_bio_method =
 ,   tb_ssl_bio_method_exit
 ,   tb_null
 };
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * library implementation
  */
+static tb_void_t tb_ssl_session_free(tb_element_ref_t element, tb_pointer_t buff)
+{
+    // check
+    tb_assert_and_check_return(buff);
+
+    // exit session
+    SSL_SESSION* session = *((SSL_SESSION**)buff);
+    if (session) SSL_SESSION_free(session);
+
+    // clear it
+    *((SSL_SESSION**)buff) = tb_null;
+}
+static tb_void_t tb_ssl_ctx_free(tb_element_ref_t element, tb_pointer_t buff)
+{
+    // check
+    tb_assert_and_check_return(buff);
+
+    // exit ctx, the opened ssl still holds its reference
+    SSL_CTX* ctx = *((SSL_CTX**)buff);
+    if (ctx) SSL_CTX_free(ctx);
+
+    // clear it
+    *((SSL_CTX**)buff) = tb_null;
+}
 static tb_handle_t tb_ssl_library_init(tb_cpointer_t* ppriv)
 {
     // init it
     SSL_library_init();
 
+    // make the shared context
+    tb_ssl_context_t* context = tb_malloc0_type(tb_ssl_context_t);
+    tb_assert_and_check_return_val(context, tb_null);
+
+    // init lock
+    tb_spinlock_init(&context->lock);
+
+    // init the client sessions
+    context->sessions = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, tb_element_str(tb_true), tb_element_ptr(tb_ssl_session_free, tb_null));
+
+    // init the shared contexts with certificate
+    context->certs = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, tb_element_str(tb_true), tb_element_ptr(tb_ssl_ctx_free, tb_null));
+    if (!context->sessions || !context->certs)
+    {
+        if (context->sessions) tb_hash_map_exit(context->sessions);
+        if (context->certs) tb_hash_map_exit(context->certs);
+        tb_spinlock_exit(&context->lock);
+        tb_free(context);
+        return tb_null;
+    }
+
+#ifdef TB_SSL_OPENSSL_OPAQUE
+    // init the bio method
+    context->bio_method = BIO_meth_new(BIO_get_new_index() | BIO_TYPE_SOURCE_SINK, "ssl_bio");
+    if (context->bio_method)
+    {
+        BIO_meth_set_write(context->bio_method, tb_ssl_bio_method_writ);
+        BIO_meth_set_read(context->bio_method, tb_ssl_bio_method_read);
+        BIO_meth_set_puts(context->bio_method, tb_ssl_bio_method_puts);
+        BIO_meth_set_gets(context->bio_method, tb_ssl_bio_method_gets);
+        BIO_meth_set_ctrl(context->bio_method, tb_ssl_bio_method_ctrl);
+        BIO_meth_set_create(context->bio_method, tb_ssl_bio_method_init);
+        BIO_meth_set_destroy(context->bio_method, tb_ssl_bio_method_exit);
+    }
+#endif
+
     // ok
-    return ppriv;
+    return (tb_handle_t)context;
 }
-static tb_void_t tb_ssl_library_exit(tb_handle_t ssl, tb_cpointer_t priv)
+static tb_void_t tb_ssl_library_exit(tb_handle_t handle, tb_cpointer_t priv)
 {
+    // check
+    tb_ssl_context_t* context = (tb_ssl_context_t*)handle;
+    tb_assert_and_check_return(context);
+
+    // exit the client sessions
+    if (context->sessions) tb_hash_map_exit(context->sessions);
+    context->sessions = tb_null;
+
+    // exit the shared contexts with certificate
+    if (context->certs) tb_hash_map_exit(context->certs);
+    context->certs = tb_null;
+
+    // exit the shared contexts, the opened ssl still holds its reference
+    if (context->ctx[0]) SSL_CTX_free(context->ctx[0]);
+    if (context->ctx[1]) SSL_CTX_free(context->ctx[1]);
+    context->ctx[0] = tb_null;
+    context->ctx[1] = tb_null;
+
+#ifdef TB_SSL_OPENSSL_OPAQUE
+    // exit the bio method
+    if (context->bio_method) BIO_meth_free(context->bio_method);
+    context->bio_method = tb_null;
+#endif
+
+    // exit lock
+    tb_spinlock_exit(&context->lock);
+
+    // exit it
+    tb_free(context);
 }
-static tb_handle_t tb_ssl_library_load()
+static tb_ssl_context_t* tb_ssl_library_load()
 {
-    return tb_singleton_instance(TB_SINGLETON_TYPE_LIBRARY_OPENSSL, tb_ssl_library_init, tb_ssl_library_exit, tb_null, tb_null);
+    return (tb_ssl_context_t*)tb_singleton_instance(TB_SINGLETON_TYPE_LIBRARY_OPENSSL, tb_ssl_library_init, tb_ssl_library_exit, tb_null, tb_null);
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -128,6 +275,14 @@ static tb_int_t tb_ssl_verify(tb_int_t ok, X509_STORE_CTX* ctx)
 {
     return 1;
 }
+static __tb_inline__ tb_ssl_impl_t* tb_ssl_bio_impl(BIO* bio)
+{
+#ifdef TB_SSL_OPENSSL_OPAQUE
+    return (tb_ssl_impl_t*)BIO_get_data(bio);
+#else
+    return (tb_ssl_impl_t*)bio->ptr;
+#endif
+}
 #ifdef __tb_debug__
 static tb_char_t const* tb_ssl_error(tb_long_t error)
 {
@@ -158,6 +313,298 @@ static tb_char_t const* tb_ssl_error(tb_long_t error)
     return "";
 }
 #endif
+static SSL_CTX* tb_ssl_context_ctx_make(tb_bool_t bserver)
+{
+    // make it, negotiate the highest tls version
+    SSL_CTX* ctx = SSL_CTX_new(SSLv23_method());
+    tb_assert_and_check_return_val(ctx, tb_null);
+
+    // disable the insecure protocols
+    SSL_CTX_set_options(ctx, SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3);
+
+    /* the server caches sessions and issues session tickets with the keys of the shared context without certificate,
+     * the client sessions are cached by the peer in context->sessions from the new session callback,
+     * the tls 1.3 tickets arrive after the handshake, so SSL_get1_session() is too early for them
+     */
+    if (bserver)
+    {
+        SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_SERVER);
+        SSL_CTX_set_session_id_context(ctx, (tb_byte_t const*)"tbox", 4);
+    }
+    else
+    {
+        SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        SSL_CTX_sess_set_new_cb(ctx, tb_ssl_context_session_new);
+    }
+
+    // ok
+    return ctx;
+}
+static SSL_CTX* tb_ssl_context_ctx(tb_ssl_context_t* context, tb_bool_t bserver)
+{
+    // check
+    tb_assert_and_check_return_val(context, tb_null);
+
+    // enter
+    tb_spinlock_enter(&context->lock);
+
+    // the shared ctx, make it only once for all connections
+    SSL_CTX* ctx = context->ctx[bserver? 1 : 0];
+    if (!ctx) ctx = context->ctx[bserver? 1 : 0] = tb_ssl_context_ctx_make(bserver);
+
+    // leave
+    tb_spinlock_leave(&context->lock);
+
+    // ok?
+    return ctx;
+}
+static SSL_CTX* tb_ssl_context_ctx_cert(tb_ssl_context_t* context, tb_bool_t bserver, tb_char_t const* cert, tb_char_t const* key)
+{
+    // check
+    tb_assert_and_check_return_val(context && context->certs && cert && key, tb_null);
+
+    // the name, "client or server|cert|key"
+    tb_char_t name[TB_PATH_MAXN];
+    tb_long_t size = tb_snprintf(name, sizeof(name) - 1, "%s|%s|%s", bserver? "server" : "client", cert, key);
+    tb_assert_and_check_return_val(size > 0 && size < sizeof(name) - 1, tb_null);
+    name[size] = '\0';
+
+    // the loaded ctx
+    tb_spinlock_enter(&context->lock);
+    SSL_CTX* ctx = (SSL_CTX*)tb_hash_map_get(context->certs, name);
+    tb_spinlock_leave(&context->lock);
+    tb_check_return_val(!ctx, ctx);
+
+    // make it
+    ctx = tb_ssl_context_ctx_make(bserver);
+    tb_assert_and_check_return_val(ctx, tb_null);
+
+    // load the certificate and the private key only once for all connections
+    if (    SSL_CTX_use_certificate_file(ctx, cert, SSL_FILETYPE_PEM) != 1
+        ||  SSL_CTX_use_PrivateKey_file(ctx, key, SSL_FILETYPE_PEM) != 1
+        ||  SSL_CTX_check_private_key(ctx) != 1)
+    {
+        // trace
+        tb_trace_e("load cert: %s, %s: failed", cert, key);
+
+        // exit it
+        SSL_CTX_free(ctx);
+        return tb_null;
+    }
+
+    // enter
+    tb_spinlock_enter(&context->lock);
+
+    // save it if it has not been loaded by other connections
+    SSL_CTX* loaded = (SSL_CTX*)tb_hash_map_get(context->certs, name);
+    if (!loaded) tb_hash_map_insert(context->certs, name, ctx);
+
+    // leave
+    tb_spinlock_leave(&context->lock);
+
+    // exit the duplicate ctx
+    if (loaded)
+    {
+        SSL_CTX_free(ctx);
+        ctx = loaded;
+    }
+
+    // ok
+    return ctx;
+}
+static tb_void_t tb_ssl_context_session_load(tb_ssl_context_t* context, SSL* ssl, tb_char_t const* peer)
+{
+    // check
+    tb_assert_and_check_return(context && context->sessions && ssl && peer);
+
+    // enter
+    tb_spinlock_enter(&context->lock);
+
+    // resume the last session of this peer
+    SSL_SESSION* session = (SSL_SESSION*)tb_hash_map_get(context->sessions, peer);
+    if (session) SSL_set_session(ssl, session);
+
+    // leave
+    tb_spinlock_leave(&context->lock);
+}
+static tb_void_t tb_ssl_context_session_save(tb_ssl_context_t* context, SSL_SESSION* session, tb_char_t const* peer)
+{
+    // check
+    tb_assert_and_check_return(context && context->sessions && session && peer);
+
+    // enter
+    tb_spinlock_enter(&context->lock);
+
+    // too many peers? clear the old sessions
+    if (tb_hash_map_size(context->sessions) >= TB_SSL_SESSIONS_MAXN && !tb_hash_map_get(context->sessions, peer))
+        tb_hash_map_clear(context->sessions);
+
+    // save it, the old session of this peer will be freed
+    tb_hash_map_insert(context->sessions, peer, session);
+
+    // leave
+    tb_spinlock_leave(&context->lock);
+}
+static tb_int_t tb_ssl_context_session_new(SSL* ssl, SSL_SESSION* session)
+{
+    // the ssl impl
+    tb_ssl_impl_t* impl = (tb_ssl_impl_t*)SSL_get_app_data(ssl);
+    tb_check_return_val(impl && impl->context && impl->peer[0] && session, 0);
+
+    // trace
+    tb_trace_d("session: new: %s", impl->peer);
+
+    // save the client session for resuming the next connection to this peer, we hold the reference of it now
+    tb_ssl_context_session_save(impl->context, session, impl->peer);
+    return 1;
+}
+static tb_void_t tb_ssl_ktls_prf(EVP_MD const* md, tb_byte_t const* secret, tb_size_t secret_size, tb_byte_t const* seed, tb_size_t seed_size, tb_byte_t* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return(md && secret && seed && seed_size <= 128 && data);
+
+    /* the tls 1.2 prf: P_hash(secret, seed)
+     *
+     * A(0) = seed
+     * A(i) = HMAC(secret, A(i - 1))
+     * data = HMAC(secret, A(1) + seed) + HMAC(secret, A(2) + seed) + ...
+     */
+    tb_byte_t       buff[EVP_MAX_MD_SIZE + 128];
+    tb_byte_t       hash[EVP_MAX_MD_SIZE];
+    tb_uint_t       a_size = 0;
+    tb_uint_t       h_size = 0;
+    HMAC(md, secret, (tb_int_t)secret_size, seed, seed_size, buff, &a_size);
+    while (size)
+    {
+        // HMAC(secret, A(i) + seed)
+        tb_memcpy(buff + a_size, seed, seed_size);
+        HMAC(md, secret, (tb_int_t)secret_size, buff, a_size + seed_size, hash, &h_size);
+
+        // save it
+        tb_size_t n = tb_min(size, h_size);
+        tb_memcpy(data, hash, n);
+        data += n;
+        size -= n;
+
+        // A(i + 1)
+        HMAC(md, secret, (tb_int_t)secret_size, buff, a_size, hash, &a_size);
+        tb_memcpy(buff, hash, a_size);
+    }
+
+    // clear the secrets on the stack
+    OPENSSL_cleanse(buff, sizeof(buff));
+    OPENSSL_cleanse(hash, sizeof(hash));
+}
+static tb_bool_t tb_ssl_ktls_load(tb_ssl_impl_t* impl, tb_socket_ktls_t* send, tb_socket_ktls_t* recv)
+{
+    // check
+    SSL* ssl = impl->ssl;
+    SSL_SESSION* session = ssl? SSL_get_session(ssl) : tb_null;
+    tb_assert_and_check_return_val(ssl && session && send && recv, tb_false);
+
+    // only for tls 1.2
+    tb_check_return_val(SSL_version(ssl) == TLS1_2_VERSION, tb_false);
+
+    // the cipher, the master key, the randoms and the next record sequences
+    tb_int_t        nid = NID_undef;
+    tb_byte_t       master_key[SSL_MAX_MASTER_KEY_LENGTH];
+    tb_size_t       master_key_size = 0;
+    tb_byte_t       client_random[SSL3_RANDOM_SIZE];
+    tb_byte_t       server_random[SSL3_RANDOM_SIZE];
+    tb_byte_t       write_sequence[8];
+    tb_byte_t       read_sequence[8];
+#ifdef TB_SSL_OPENSSL_OPAQUE
+    /* the record sequences are not exported since openssl 1.1
+     *
+     * the finished message is the only record encrypted with the new keys before the application data, 
+     * so the next sequences are both 1 if no application data has been read or written
+     */
+    tb_check_return_val(!impl->bappdata, tb_false);
+    SSL_CIPHER const* ssl_cipher = SSL_get_current_cipher(ssl);
+    tb_check_return_val(ssl_cipher, tb_false);
+    nid             = SSL_CIPHER_get_cipher_nid(ssl_cipher);
+    master_key_size = SSL_SESSION_get_master_key(session, master_key, sizeof(master_key));
+    tb_check_return_val(    SSL_get_client_random(ssl, client_random, sizeof(client_random)) == sizeof(client_random)
+                        &&  SSL_get_server_random(ssl, server_random, sizeof(server_random)) == sizeof(server_random), tb_false);
+    tb_memset(write_sequence, 0, sizeof(write_sequence)); write_sequence[7] = 1;
+    tb_memset(read_sequence, 0, sizeof(read_sequence)); read_sequence[7] = 1;
+#else
+    tb_assert_and_check_return_val(ssl->s3 && ssl->enc_write_ctx, tb_false);
+    nid             = EVP_CIPHER_CTX_nid(ssl->enc_write_ctx);
+    master_key_size = tb_min((tb_size_t)session->master_key_length, sizeof(master_key));
+    tb_memcpy(master_key, session->master_key, master_key_size);
+    tb_memcpy(client_random, ssl->s3->client_random, SSL3_RANDOM_SIZE);
+    tb_memcpy(server_random, ssl->s3->server_random, SSL3_RANDOM_SIZE);
+    tb_memcpy(write_sequence, ssl->s3->write_sequence, 8);
+    tb_memcpy(read_sequence, ssl->s3->read_sequence, 8);
+#endif
+
+    // only for aes-gcm, the prf hash of these cipher suites is sha256 for aes-128 and sha384 for aes-256
+    tb_size_t       cipher = TB_SOCKET_KTLS_CIPHER_NONE;
+    tb_size_t       key_size = 0;
+    EVP_MD const*   md = tb_null;
+    switch (nid)
+    {
+    case NID_aes_128_gcm:
+        cipher      = TB_SOCKET_KTLS_CIPHER_AES_128_GCM;
+        key_size    = 16;
+        md          = EVP_sha256();
+        break;
+    case NID_aes_256_gcm:
+        cipher      = TB_SOCKET_KTLS_CIPHER_AES_256_GCM;
+        key_size    = 32;
+        md          = EVP_sha384();
+        break;
+    default:
+        break;
+    }
+    if (cipher == TB_SOCKET_KTLS_CIPHER_NONE || !master_key_size)
+    {
+        OPENSSL_cleanse(master_key, sizeof(master_key));
+        return tb_false;
+    }
+
+    // the seed: "key expansion" + server_random + client_random
+    tb_byte_t seed[13 + SSL3_RANDOM_SIZE + SSL3_RANDOM_SIZE];
+    tb_memcpy(seed, "key expansion", 13);
+    tb_memcpy(seed + 13, server_random, SSL3_RANDOM_SIZE);
+    tb_memcpy(seed + 13 + SSL3_RANDOM_SIZE, client_random, SSL3_RANDOM_SIZE);
+
+    // the key block: client_key + server_key + client_salt + server_salt, no mac keys for aead
+    tb_byte_t block[32 + 32 + 4 + 4];
+    tb_ssl_ktls_prf(md, master_key, master_key_size, seed, sizeof(seed), block, key_size + key_size + 4 + 4);
+
+    // the client writes with the client keys and the server writes with the server keys
+    tb_byte_t const* client_key     = block;
+    tb_byte_t const* server_key     = block + key_size;
+    tb_byte_t const* client_salt    = block + key_size + key_size;
+    tb_byte_t const* server_salt    = block + key_size + key_size + 4;
+
+    // init send
+    send->version   = TLS1_2_VERSION;
+    send->cipher    = (tb_uint16_t)cipher;
+    tb_memcpy(send->key, impl->bserver? server_key : client_key, key_size);
+    tb_memcpy(send->salt, impl->bserver? server_salt : client_salt, 4);
+    tb_memcpy(send->seq, write_sequence, 8);
+
+    // the explicit iv only need be unique for the key, the next sequence number is enough
+    tb_memcpy(send->iv, write_sequence, 8);
+
+    // init recv, the explicit iv is carried by the received records
+    recv->version   = TLS1_2_VERSION;
+    recv->cipher    = (tb_uint16_t)cipher;
+    tb_memcpy(recv->key, impl->bserver? client_key : server_key, key_size);
+    tb_memcpy(recv->salt, impl->bserver? client_salt : server_salt, 4);
+    tb_memcpy(recv->seq, read_sequence, 8);
+    tb_memcpy(recv->iv, read_sequence, 8);
+
+    // clear the secrets
+    OPENSSL_cleanse(block, sizeof(block));
+    OPENSSL_cleanse(master_key, sizeof(master_key));
+
+    // ok
+    return tb_true;
+}
 static tb_long_t tb_ssl_sock_read(tb_cpointer_t priv, tb_byte_t* data, tb_size_t size)
 {
     // check
@@ -191,11 +638,17 @@ static tb_int_t tb_ssl_bio_method_init(BIO* bio)
     tb_trace_d("bio: init");
 
     // init 
+#ifdef TB_SSL_OPENSSL_OPAQUE
+    BIO_set_init(bio, 1);
+    BIO_set_data(bio, tb_null);
+    BIO_set_shutdown(bio, 1);
+#else
     bio->init       = 1;
     bio->num        = 0;
     bio->ptr        = tb_null;
     bio->flags      = 0;
     bio->shutdown   = 1;
+#endif
 
     // ok
     return 1;
@@ -209,10 +662,15 @@ static tb_int_t tb_ssl_bio_method_exit(BIO* bio)
     tb_trace_d("bio: exit");
 
     // exit 
+#ifdef TB_SSL_OPENSSL_OPAQUE
+    BIO_set_init(bio, 0);
+    BIO_set_data(bio, tb_null);
+#else
     bio->init       = 0;
     bio->num        = 0;
     bio->ptr        = tb_null;
     bio->flags      = 0;
+#endif
 
     // ok
     return 1;
@@ -223,7 +681,7 @@ static tb_int_t tb_ssl_bio_method_read(BIO* bio, tb_char_t* data, tb_int_t size)
     tb_assert_and_check_return_val(bio && data && size >= 0, -1);
 
     // the ssl
-    tb_ssl_impl_t* impl = (tb_ssl_impl_t*)bio->ptr;
+    tb_ssl_impl_t* impl = tb_ssl_bio_impl(bio);
     tb_assert_and_check_return_val(impl && impl->read, -1);
 
     // writ 
@@ -263,7 +721,7 @@ static tb_int_t tb_ssl_bio_method_writ(BIO* bio, tb_char_t const* data, tb_int_t
     tb_assert_and_check_return_val(bio && data && size >= 0, -1);
 
     // the ssl
-    tb_ssl_impl_t* impl = (tb_ssl_impl_t*)bio->ptr;
+    tb_ssl_impl_t* impl = tb_ssl_bio_impl(bio);
     tb_assert_and_check_return_val(impl && impl->writ, -1);
 
     // writ 
@@ -303,7 +761,7 @@ static tb_long_t tb_ssl_bio_method_ctrl(BIO* bio, tb_int_t cmd, tb_long_t num, t
     tb_assert_and_check_return_val(bio, -1);
 
     // the ssl
-    tb_ssl_impl_t* impl = (tb_ssl_impl_t*)bio->ptr;
+    tb_ssl_impl_t* impl = tb_ssl_bio_impl(bio);
     tb_assert_and_check_return_val(impl, -1);
 
     // done
@@ -363,7 +821,8 @@ tb_ssl_ref_t tb_ssl_init(tb_bool_t bserver)
     do
     {
         // load openssl library
-        if (!tb_ssl_library_load()) break;
+        tb_ssl_context_t* context = tb_ssl_library_load();
+        if (!context) break;
 
         // make ssl
         impl = tb_malloc0_type(tb_ssl_impl_t);
@@ -372,14 +831,21 @@ tb_ssl_ref_t tb_ssl_init(tb_bool_t bserver)
         // init timeout, 30s
         impl->timeout = 30000;
 
-        // init ctx
-        impl->ctx = SSL_CTX_new(SSLv3_method());
-        tb_assert_and_check_break(impl->ctx);
-        
-        // make ssl
-        impl->ssl = SSL_new(impl->ctx);
+        // init context
+        impl->context = context;
+        impl->bserver = bserver;
+
+        // the shared ctx
+        SSL_CTX* ctx = tb_ssl_context_ctx(context, bserver);
+        tb_assert_and_check_break(ctx);
+
+        // make ssl, it holds a reference of the shared ctx
+        impl->ssl = SSL_new(ctx);
         tb_assert_and_check_break(impl->ssl);
 
+        // attach impl for the callbacks
+        SSL_set_app_data(impl->ssl, impl);
+
         // init endpoint 
         if (bserver) SSL_set_accept_state(impl->ssl);
         else SSL_set_connect_state(impl->ssl);
@@ -388,11 +854,17 @@ tb_ssl_ref_t tb_ssl_init(tb_bool_t bserver)
         SSL_set_verify(impl->ssl, 0, tb_ssl_verify);
 
         // init bio
+#ifdef TB_SSL_OPENSSL_OPAQUE
+        impl->bio = context->bio_method? BIO_new(context->bio_method) : tb_null;
+        tb_assert_and_check_break(impl->bio);
+        BIO_set_data(impl->bio, impl);
+#else
         impl->bio = BIO_new(&g_ssl_bio_method);
         tb_assert_and_check_break(impl->bio);
+        impl->bio->ptr = impl;
+#endif
 
         // set bio to ssl
-        impl->bio->ptr = impl;
         SSL_set_bio(impl->ssl, impl->bio, impl->bio);
 
         // init state
@@ -426,10 +898,6 @@ tb_void_t tb_ssl_exit(tb_ssl_ref_t ssl)
     if (impl->ssl) SSL_free(impl->ssl);
     impl->ssl = tb_null;
 
-    // exit ctx
-    if (impl->ctx) SSL_CTX_free(impl->ctx);
-    impl->ctx = tb_null;
-
     // exit it
     tb_free(impl);
 }
@@ -454,6 +922,57 @@ tb_void_t tb_ssl_set_bio_func(tb_ssl_ref_t ssl, tb_ssl_func_read_t read, tb_ssl_
     impl->wait = wait;
     impl->priv = priv;
 }
+tb_void_t tb_ssl_set_peer(tb_ssl_ref_t ssl, tb_char_t const* host, tb_uint16_t port)
+{
+    // the ssl
+    tb_ssl_impl_t* impl = (tb_ssl_impl_t*)ssl;
+    tb_assert_and_check_return(impl && impl->ssl && host && !impl->bopened);
+
+    // only for client
+    tb_check_return(!impl->bserver);
+
+    // save peer
+    tb_long_t size = tb_snprintf(impl->peer, sizeof(impl->peer) - 1, "%s:%u", host, port);
+    impl->peer[size >= 0? size : 0] = '\0';
+
+    // resume the last session of this peer
+    if (size > 0) tb_ssl_context_session_load(impl->context, impl->ssl, impl->peer);
+}
+tb_bool_t tb_ssl_set_cert(tb_ssl_ref_t ssl, tb_char_t const* cert, tb_char_t const* key)
+{
+    // the ssl
+    tb_ssl_impl_t* impl = (tb_ssl_impl_t*)ssl;
+    tb_assert_and_check_return_val(impl && impl->ssl && cert && key && !impl->bopened, tb_false);
+
+    // the shared ctx of this certificate and private key
+    SSL_CTX* ctx = tb_ssl_context_ctx_cert(impl->context, impl->bserver, cert, key);
+    tb_check_return_val(ctx, tb_false);
+
+    // switch to it, the ssl holds a reference of it and the session cache of the shared ctx is still used
+    if (SSL_set_SSL_CTX(impl->ssl, ctx) != ctx)
+    {
+        // trace
+        tb_trace_e("set cert: %s, %s: failed", cert, key);
+        return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+tb_void_t tb_ssl_set_ktls(tb_ssl_ref_t ssl, tb_bool_t enable)
+{
+    // the ssl
+    tb_ssl_impl_t* impl = (tb_ssl_impl_t*)ssl;
+    tb_assert_and_check_return(impl && impl->ssl && !impl->bopened);
+
+#ifdef TB_SSL_OPENSSL_OPAQUE
+    // only tls 1.2 can be offloaded
+    SSL_set_max_proto_version(impl->ssl, enable? TLS1_2_VERSION : 0);
+#else
+    // tls 1.2 is the highest version of openssl 1.0
+    tb_used(enable);
+#endif
+}
 tb_void_t tb_ssl_set_timeout(tb_ssl_ref_t ssl, tb_long_t timeout)
 {
     // the ssl
@@ -544,8 +1063,12 @@ tb_long_t tb_ssl_open_try(tb_ssl_ref_t ssl)
     // ok?
     if (ok > 0)
     {
+        // trace
+        tb_trace_d("open: session: %s", SSL_session_reused(impl->ssl)? "resumed" : "new");
+
         // opened
-        impl->bopened = tb_true;
+        impl->bopened   = tb_true;
+        impl->bappdata  = tb_false;
     }
     // failed?
     else if (ok < 0)
@@ -561,6 +1084,74 @@ tb_long_t tb_ssl_open_try(tb_ssl_ref_t ssl)
     // ok?
     return ok;
 }
+tb_size_t tb_ssl_ktls_enable(tb_ssl_ref_t ssl, tb_socket_ref_t sock)
+{
+    // the ssl
+    tb_ssl_impl_t* impl = (tb_ssl_impl_t*)ssl;
+    tb_assert_and_check_return_val(impl && impl->ssl && sock, TB_SSL_KTLS_NONE);
+
+    // not opened or offloaded already?
+    tb_check_return_val(impl->bopened && !impl->ktls, impl->ktls);
+
+    // done
+    tb_socket_ktls_t send;
+    tb_socket_ktls_t recv;
+    do
+    {
+        // load the current keys
+        if (!tb_ssl_ktls_load(impl, &send, &recv)) break;
+
+#ifdef TB_SSL_OPENSSL_OPAQUE
+        // the handshake has flushed all records and SSL_has_pending() also counts the data read ahead
+        tb_bool_t wpending = tb_false;
+        tb_bool_t rpending = SSL_has_pending(impl->ssl)? tb_true : tb_false;
+#else
+        tb_bool_t wpending = impl->ssl->s3->wbuf.left? tb_true : tb_false;
+        tb_bool_t rpending = (SSL_pending(impl->ssl) || impl->ssl->s3->rbuf.left)? tb_true : tb_false;
+#endif
+
+        // offload the sending if no record is pending to be written
+        if (!wpending && tb_socket_ctrl(sock, TB_SOCKET_CTRL_SET_KTLS_SEND, &send))
+        {
+            impl->ktls |= TB_SSL_KTLS_SEND;
+            impl->ktls_sock = sock;
+        }
+
+        // offload the receiving if no data has been read ahead
+        if (    (impl->ktls & TB_SSL_KTLS_SEND) && !rpending
+            &&  tb_socket_ctrl(sock, TB_SOCKET_CTRL_SET_KTLS_RECV, &recv))
+            impl->ktls |= TB_SSL_KTLS_RECV;
+
+    } while (0);
+
+    // clear the keys
+    OPENSSL_cleanse(&send, sizeof(send));
+    OPENSSL_cleanse(&recv, sizeof(recv));
+
+    // trace
+    tb_trace_d("ktls: send: %s, recv: %s", (impl->ktls & TB_SSL_KTLS_SEND)? "ok" : "no", (impl->ktls & TB_SSL_KTLS_RECV)? "ok" : "no");
+
+    // ok?
+    return impl->ktls;
+}
+tb_size_t tb_ssl_ktls(tb_ssl_ref_t ssl)
+{
+    // the ssl
+    tb_ssl_impl_t* impl = (tb_ssl_impl_t*)ssl;
+    tb_assert_and_check_return_val(impl, TB_SSL_KTLS_NONE);
+
+    // the kernel tls mode
+    return impl->ktls;
+}
+tb_bool_t tb_ssl_resumed(tb_ssl_ref_t ssl)
+{
+    // the ssl
+    tb_ssl_impl_t* impl = (tb_ssl_impl_t*)ssl;
+    tb_assert_and_check_return_val(impl && impl->ssl, tb_false);
+
+    // the session has been resumed?
+    return impl->bopened && SSL_session_reused(impl->ssl)? tb_true : tb_false;
+}
 tb_bool_t tb_ssl_clos(tb_ssl_ref_t ssl)
 {
     // the ssl
@@ -599,6 +1190,22 @@ tb_long_t tb_ssl_clos_try(tb_ssl_ref_t ssl)
             break;
         }
 
+        /* the sending has been offloaded? the records of openssl are out of sequence, 
+         * so send the close notify alert as a kernel tls record instead of SSL_shutdown()
+         */
+        if (impl->ktls & TB_SSL_KTLS_SEND)
+        {
+            // the close notify alert: warning, close_notify
+            static tb_byte_t const alert[2] = {1, 0};
+            if (!tb_socket_ctrl(impl->ktls_sock, TB_SOCKET_CTRL_SEND_KTLS_ALERT, alert))
+            {
+                // trace
+                tb_trace_d("clos: send close notify failed");
+            }
+            ok = 1;
+            break;
+        }
+
         // do shutdown
         tb_long_t r = SSL_shutdown(impl->ssl);
     
@@ -643,7 +1250,10 @@ tb_long_t tb_ssl_clos_try(tb_ssl_ref_t ssl)
     if (ok > 0)
     {
         // closed
-        impl->bopened = tb_false;
+        impl->bopened   = tb_false;
+        impl->bappdata  = tb_false;
+        impl->ktls      = TB_SSL_KTLS_NONE;
+        impl->ktls_sock = tb_null;
 
         // clear ssl
         if (impl->ssl) SSL_clear(impl->ssl);
@@ -668,6 +1278,21 @@ tb_long_t tb_ssl_read(tb_ssl_ref_t ssl, tb_byte_t* data, tb_size_t size)
     tb_ssl_impl_t* impl = (tb_ssl_impl_t*)ssl;
     tb_assert_and_check_return_val(impl && impl->ssl && impl->bopened && data, -1);
 
+    // the receiving has been offloaded? read the plain data from the bio directly
+    if (impl->ktls & TB_SSL_KTLS_RECV)
+    {
+        // read it
+        tb_long_t real = impl->read(impl->priv, data, size);
+
+        // save state
+        if (!real) impl->state = TB_STATE_SOCK_SSL_WANT_READ;
+        else if (real < 0) impl->state = TB_STATE_CLOSED;
+        return real;
+    }
+
+    // the record sequences will be changed
+    impl->bappdata = tb_true;
+
     // read it
     tb_long_t real = SSL_read(impl->ssl, data, size);
 
@@ -731,6 +1356,21 @@ tb_long_t tb_ssl_writ(tb_ssl_ref_t ssl, tb_byte_t const* data, tb_size_t size)
     tb_ssl_impl_t* impl = (tb_ssl_impl_t*)ssl;
     tb_assert_and_check_return_val(impl && impl->ssl && impl->bopened && data, -1);
 
+    // the sending has been offloaded? writ the plain data to the bio directly
+    if (impl->ktls & TB_SSL_KTLS_SEND)
+    {
+        // writ it
+        tb_long_t real = impl->writ(impl->priv, data, size);
+
+        // save state
+        if (!real) impl->state = TB_STATE_SOCK_SSL_WANT_WRIT;
+        else if (real < 0) impl->state = TB_STATE_SOCK_SSL_FAILED;
+        return real;
+    }
+
+    // the record sequences will be changed
+    impl->bappdata = tb_true;
+
     // writ it
     tb_long_t real = SSL_write(impl->ssl, data, size);
 
@@ -29,19 +29,44 @@
  */
 #include "prefix.h"
 #include "polarssl/polarssl.h"
+#include "polarssl/ssl_cache.h"
 #include "../../../asio/asio.h"
 #include "../../../libc/libc.h"
 #include "../../../platform/platform.h"
+#include "../../../utils/utils.h"
+#include "../../../container/container.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the client sessions maxn
+#ifdef __tb_small__
+#   define TB_SSL_SESSIONS_MAXN         (64)
+#else
+#   define TB_SSL_SESSIONS_MAXN         (256)
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
-// the ssl impl type
-typedef struct __tb_ssl_impl_t
+// the own certificate type of the server
+typedef struct __tb_ssl_cert_t
 {
-    // the ssl context
-    ssl_context         ssl;
+    // the certificate
+    x509_crt            crt;
+
+    // the private key
+    pk_context          key;
+
+}tb_ssl_cert_t;
+
+// the ssl shared context type
+typedef struct __tb_ssl_context_t
+{
+    // the lock
+    tb_spinlock_t       lock;
 
     // the ssl entropy context
     entropy_context     entropy;
@@ -52,9 +77,40 @@ typedef struct __tb_ssl_impl_t
     // the ssl x509 crt
     x509_crt            x509_crt;
 
+#ifdef POLARSSL_SSL_CACHE_C
+    // the server session cache
+    ssl_cache_context   cache;
+#endif
+
+    // the client sessions, "host:port" => ssl_session*
+    tb_hash_map_ref_t   sessions;
+
+    // the own certificates, "cert|key" => tb_ssl_cert_t*, they are parsed only once for all connections
+    tb_hash_map_ref_t   certs;
+
+}tb_ssl_context_t;
+
+// the ssl impl type
+typedef struct __tb_ssl_impl_t
+{
+    // the ssl context
+    ssl_context         ssl;
+
+    // the shared context
+    tb_ssl_context_t*   context;
+
+    // is server?
+    tb_bool_t           bserver;
+
     // is opened?
     tb_bool_t           bopened;
 
+    // has the session been resumed?
+    tb_bool_t           bresumed;
+
+    // the peer, "host:port"
+    tb_char_t           peer[TB_SSL_PEER_MAXN];
+
     // the state
     tb_size_t           state;
 
@@ -98,6 +154,304 @@ static tb_void_t tb_ssl_trace_info(tb_pointer_t priv, tb_int_t level, tb_char_t
     if (level < 1) tb_printf("%s", info);
 }
 #endif
+static tb_void_t tb_ssl_session_free(tb_element_ref_t element, tb_pointer_t buff)
+{
+    // check
+    tb_assert_and_check_return(buff);
+
+    // exit session
+    ssl_session* session = *((ssl_session**)buff);
+    if (session)
+    {
+        ssl_session_free(session);
+        tb_free(session);
+    }
+
+    // clear it
+    *((ssl_session**)buff) = tb_null;
+}
+static tb_void_t tb_ssl_cert_free(tb_element_ref_t element, tb_pointer_t buff)
+{
+    // check
+    tb_assert_and_check_return(buff);
+
+    // exit cert
+    tb_ssl_cert_t* cert = *((tb_ssl_cert_t**)buff);
+    if (cert)
+    {
+        x509_crt_free(&cert->crt);
+        pk_free(&cert->key);
+        tb_free(cert);
+    }
+
+    // clear it
+    *((tb_ssl_cert_t**)buff) = tb_null;
+}
+static tb_int_t tb_ssl_context_random(tb_pointer_t priv, tb_byte_t* data, size_t size)
+{
+    // check
+    tb_ssl_context_t* context = (tb_ssl_context_t*)priv;
+    tb_assert_and_check_return_val(context, -1);
+
+    // the ctr_drbg is shared by all connections
+    tb_spinlock_enter(&context->lock);
+    tb_int_t r = ctr_drbg_random(&context->ctr_drbg, data, size);
+    tb_spinlock_leave(&context->lock);
+
+    // ok?
+    return r;
+}
+#ifdef POLARSSL_SSL_CACHE_C
+static tb_int_t tb_ssl_context_cache_get(tb_pointer_t priv, ssl_session* session)
+{
+    // check
+    tb_ssl_context_t* context = (tb_ssl_context_t*)priv;
+    tb_assert_and_check_return_val(context, 1);
+
+    // get the server session
+    tb_spinlock_enter(&context->lock);
+    tb_int_t r = ssl_cache_get(&context->cache, session);
+    tb_spinlock_leave(&context->lock);
+
+    // ok?
+    return r;
+}
+static tb_int_t tb_ssl_context_cache_set(tb_pointer_t priv, ssl_session const* session)
+{
+    // check
+    tb_ssl_context_t* context = (tb_ssl_context_t*)priv;
+    tb_assert_and_check_return_val(context, 1);
+
+    // set the server session
+    tb_spinlock_enter(&context->lock);
+    tb_int_t r = ssl_cache_set(&context->cache, session);
+    tb_spinlock_leave(&context->lock);
+
+    // ok?
+    return r;
+}
+#endif
+static tb_void_t tb_ssl_context_exit(tb_handle_t handle, tb_cpointer_t priv)
+{
+    // check
+    tb_ssl_context_t* context = (tb_ssl_context_t*)handle;
+    tb_assert_and_check_return(context);
+
+    // exit the client sessions
+    if (context->sessions) tb_hash_map_exit(context->sessions);
+    context->sessions = tb_null;
+
+    // exit the own certificates
+    if (context->certs) tb_hash_map_exit(context->certs);
+    context->certs = tb_null;
+
+#ifdef POLARSSL_SSL_CACHE_C
+    // exit the server session cache
+    ssl_cache_free(&context->cache);
+#endif
+
+    // exit ssl x509_crt
+    x509_crt_free(&context->x509_crt);
+
+    // exit ssl entropy
+    entropy_free(&context->entropy);
+
+    // exit lock
+    tb_spinlock_exit(&context->lock);
+
+    // exit it
+    tb_free(context);
+}
+static tb_handle_t tb_ssl_context_init(tb_cpointer_t* ppriv)
+{
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_ssl_context_t*   context = tb_null;
+    do
+    {
+        // make context
+        context = tb_malloc0_type(tb_ssl_context_t);
+        tb_assert_and_check_break(context);
+
+        // init lock
+        tb_spinlock_init(&context->lock);
+
+        // init ssl x509_crt
+        x509_crt_init(&context->x509_crt);
+
+        // init ssl entropy context
+        entropy_init(&context->entropy);
+
+#ifdef POLARSSL_SSL_CACHE_C
+        // init the server session cache
+        ssl_cache_init(&context->cache);
+#endif
+
+        // init the client sessions
+        context->sessions = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, tb_element_str(tb_true), tb_element_ptr(tb_ssl_session_free, tb_null));
+        tb_assert_and_check_break(context->sessions);
+
+        // init the own certificates
+        context->certs = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, tb_element_str(tb_true), tb_element_ptr(tb_ssl_cert_free, tb_null));
+        tb_assert_and_check_break(context->certs);
+
+        // init ssl ctr_drbg context, only seed it once
+        tb_long_t r = 0;
+        if ((r = ctr_drbg_init(&context->ctr_drbg, entropy_func, &context->entropy, tb_null, 0)))
+        {
+            tb_ssl_error("init ctr_drbg failed", r);
+            break;
+        }
+
+#ifdef POLARSSL_CERTS_C
+        // parse the ca list only once
+        if ((r = x509_crt_parse(&context->x509_crt, (tb_byte_t const*)test_ca_list, tb_strlen(test_ca_list))))
+        {
+            tb_ssl_error("parse x509_crt failed", r);
+            break;
+        }
+#endif
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok && context)
+    {
+        tb_ssl_context_exit((tb_handle_t)context, tb_null);
+        context = tb_null;
+    }
+
+    // ok?
+    return (tb_handle_t)context;
+}
+static tb_ssl_context_t* tb_ssl_context_load()
+{
+    return (tb_ssl_context_t*)tb_singleton_instance(TB_SINGLETON_TYPE_LIBRARY_POLARSSL, tb_ssl_context_init, tb_ssl_context_exit, tb_null, tb_null);
+}
+static tb_void_t tb_ssl_context_session_load(tb_ssl_context_t* context, ssl_context* ssl, tb_char_t const* peer)
+{
+    // check
+    tb_assert_and_check_return(context && context->sessions && ssl && peer);
+
+    // enter
+    tb_spinlock_enter(&context->lock);
+
+    // resume the last session of this peer, it will be copied
+    ssl_session* session = (ssl_session*)tb_hash_map_get(context->sessions, peer);
+    if (session) ssl_set_session(ssl, session);
+
+    // leave
+    tb_spinlock_leave(&context->lock);
+}
+static tb_void_t tb_ssl_context_session_save(tb_ssl_context_t* context, ssl_context* ssl, tb_char_t const* peer)
+{
+    // check
+    tb_assert_and_check_return(context && context->sessions && ssl && peer);
+
+    // make session
+    ssl_session* session = tb_malloc0_type(ssl_session);
+    tb_assert_and_check_return(session);
+
+    // copy the current session, the zeroed session has been initialized
+    if (ssl_get_session(ssl, session))
+    {
+        ssl_session_free(session);
+        tb_free(session);
+        return ;
+    }
+
+    // enter
+    tb_spinlock_enter(&context->lock);
+
+    // too many peers? clear the old sessions
+    if (tb_hash_map_size(context->sessions) >= TB_SSL_SESSIONS_MAXN && !tb_hash_map_get(context->sessions, peer))
+        tb_hash_map_clear(context->sessions);
+
+    // save it, the old session of this peer will be freed
+    tb_hash_map_insert(context->sessions, peer, session);
+
+    // leave
+    tb_spinlock_leave(&context->lock);
+}
+static tb_ssl_cert_t* tb_ssl_context_cert(tb_ssl_context_t* context, tb_char_t const* cert, tb_char_t const* key)
+{
+    // check
+    tb_assert_and_check_return_val(context && context->certs && cert && key, tb_null);
+
+    // the name, "cert|key"
+    tb_char_t name[TB_PATH_MAXN];
+    tb_long_t size = tb_snprintf(name, sizeof(name) - 1, "%s|%s", cert, key);
+    tb_assert_and_check_return_val(size > 0 && size < sizeof(name) - 1, tb_null);
+    name[size] = '\0';
+
+    // the loaded certificate
+    tb_spinlock_enter(&context->lock);
+    tb_ssl_cert_t* own = (tb_ssl_cert_t*)tb_hash_map_get(context->certs, name);
+    tb_spinlock_leave(&context->lock);
+    tb_check_return_val(!own, own);
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // make it
+        own = tb_malloc0_type(tb_ssl_cert_t);
+        tb_assert_and_check_break(own);
+
+        // init it
+        x509_crt_init(&own->crt);
+        pk_init(&own->key);
+
+        // load the certificate
+        tb_long_t r = 0;
+        if ((r = x509_crt_parse_file(&own->crt, cert)))
+        {
+            tb_ssl_error("parse the certificate failed", r);
+            break;
+        }
+
+        // load the private key
+        if ((r = pk_parse_keyfile(&own->key, key, tb_null)))
+        {
+            tb_ssl_error("parse the private key failed", r);
+            break;
+        }
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        tb_ssl_cert_free(tb_null, &own);
+        return tb_null;
+    }
+
+    // enter
+    tb_spinlock_enter(&context->lock);
+
+    // save it if it has not been loaded by other connections
+    tb_ssl_cert_t* loaded = (tb_ssl_cert_t*)tb_hash_map_get(context->certs, name);
+    if (!loaded) tb_hash_map_insert(context->certs, name, own);
+
+    // leave
+    tb_spinlock_leave(&context->lock);
+
+    // exit the duplicate certificate
+    if (loaded)
+    {
+        tb_ssl_cert_free(tb_null, &own);
+        own = loaded;
+    }
+
+    // ok
+    return own;
+}
 static tb_long_t tb_ssl_sock_read(tb_cpointer_t priv, tb_byte_t* data, tb_size_t size)
 {
     // check
@@ -188,29 +542,13 @@ tb_ssl_ref_t tb_ssl_init(tb_bool_t bserver)
         // init timeout, 30s
         impl->timeout = 30000;
 
-        // init ssl x509_crt
-        x509_crt_init(&impl->x509_crt);
-
-        // init ssl entropy context
-        entropy_init(&impl->entropy);
-
-        // init ssl ctr_drbg context
-        tb_long_t r = 0;
-        if ((r = ctr_drbg_init(&impl->ctr_drbg, entropy_func, &impl->entropy, tb_null, 0)))
-        {
-            tb_ssl_error("init ctr_drbg failed", r);
-            break;
-        }
-
-#ifdef POLARSSL_CERTS_C
-        if ((r = x509_crt_parse(&impl->x509_crt, (tb_byte_t const*)test_ca_list, tb_strlen(test_ca_list))))
-        {
-            tb_ssl_error("parse x509_crt failed", r);
-            break;
-        }
-#endif
+        // init the shared context
+        impl->context = tb_ssl_context_load();
+        impl->bserver = bserver;
+        tb_assert_and_check_break(impl->context);
 
         // init ssl context
+        tb_long_t r = 0;
         if ((r = ssl_init(&impl->ssl)))
         {
             tb_ssl_error("init impl failed", r);
@@ -224,10 +562,15 @@ tb_ssl_ref_t tb_ssl_init(tb_bool_t bserver)
         ssl_set_authmode(&impl->ssl, SSL_VERIFY_OPTIONAL);
 
         // init ssl ca chain
-        ssl_set_ca_chain(&impl->ssl, &impl->x509_crt, tb_null, tb_null);
+        ssl_set_ca_chain(&impl->ssl, &impl->context->x509_crt, tb_null, tb_null);
 
         // init ssl random generator
-        ssl_set_rng(&impl->ssl, ctr_drbg_random, &impl->ctr_drbg);
+        ssl_set_rng(&impl->ssl, tb_ssl_context_random, impl->context);
+
+#ifdef POLARSSL_SSL_CACHE_C
+        // init the server session cache
+        if (bserver) ssl_set_session_cache(&impl->ssl, tb_ssl_context_cache_get, impl->context, tb_ssl_context_cache_set, impl->context);
+#endif
 
         // enable ssl debug?
 #if TB_TRACE_MODULE_DEBUG && defined(__tb_debug__)
@@ -261,15 +604,9 @@ tb_void_t tb_ssl_exit(tb_ssl_ref_t ssl)
     // close it first
     tb_ssl_clos(ssl);
 
-    // exit ssl x509_crt
-    x509_crt_free(&impl->x509_crt);
-
     // exit ssl
     ssl_free(&impl->ssl);
 
-    // exit ssl entropy
-    entropy_free(&impl->entropy);
-
     // exit it
     tb_free(impl);
 }
@@ -297,6 +634,52 @@ tb_void_t tb_ssl_set_bio_func(tb_ssl_ref_t ssl, tb_ssl_func_read_t read, tb_ssl_
     // set bio: func
     ssl_set_bio(&impl->ssl, tb_ssl_func_read, impl, tb_ssl_func_writ, impl);
 }
+tb_void_t tb_ssl_set_peer(tb_ssl_ref_t ssl, tb_char_t const* host, tb_uint16_t port)
+{
+    // check
+    tb_ssl_impl_t* impl = (tb_ssl_impl_t*)ssl;
+    tb_assert_and_check_return(impl && impl->context && host && !impl->bopened);
+
+    // only for client
+    tb_check_return(!impl->bserver);
+
+    // save peer
+    tb_long_t size = tb_snprintf(impl->peer, sizeof(impl->peer) - 1, "%s:%u", host, port);
+    impl->peer[size >= 0? size : 0] = '\0';
+
+    // resume the last session of this peer
+    if (size > 0) tb_ssl_context_session_load(impl->context, &impl->ssl, impl->peer);
+}
+tb_bool_t tb_ssl_set_cert(tb_ssl_ref_t ssl, tb_char_t const* cert, tb_char_t const* key)
+{
+    // check
+    tb_ssl_impl_t* impl = (tb_ssl_impl_t*)ssl;
+    tb_assert_and_check_return_val(impl && impl->context && cert && key && !impl->bopened, tb_false);
+
+    // load the certificate and the private key, they are shared by all connections
+    tb_ssl_cert_t* own = tb_ssl_context_cert(impl->context, cert, key);
+    tb_check_return_val(own, tb_false);
+
+    // set them
+    tb_long_t r = 0;
+    if ((r = ssl_set_own_cert(&impl->ssl, &own->crt, &own->key)))
+    {
+        tb_ssl_error("set the own certificate failed", r);
+        return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+tb_void_t tb_ssl_set_ktls(tb_ssl_ref_t ssl, tb_bool_t enable)
+{
+    // check
+    tb_ssl_impl_t* impl = (tb_ssl_impl_t*)ssl;
+    tb_assert_and_check_return(impl);
+
+    // the kernel tls is not supported, see tb_ssl_ktls_enable()
+    tb_used(enable);
+}
 tb_void_t tb_ssl_set_timeout(tb_ssl_ref_t ssl, tb_long_t timeout)
 {
     // check
@@ -344,8 +727,13 @@ tb_long_t tb_ssl_open_try(tb_ssl_ref_t ssl)
             break;
         }
 
-        // done handshake
-        tb_long_t r = ssl_handshake(&impl->ssl);
+        // done handshake step by step, the resume indicator will be freed with the handshake params at the last step
+        tb_long_t r = 0;
+        while (!r && impl->ssl.state != SSL_HANDSHAKE_OVER)
+        {
+            if (impl->ssl.handshake) impl->bresumed = impl->ssl.handshake->resume? tb_true : tb_false;
+            r = ssl_handshake_step(&impl->ssl);
+        }
         
         // trace
         tb_trace_d("open: handshake: %ld", r);
@@ -398,6 +786,9 @@ tb_long_t tb_ssl_open_try(tb_ssl_ref_t ssl)
         }
 #endif
 
+        // save the client session for resuming the next connection to this peer
+        if (!impl->bserver && impl->peer[0]) tb_ssl_context_session_save(impl->context, &impl->ssl, impl->peer);
+
         // opened
         impl->bopened = tb_true;
     }
@@ -415,6 +806,34 @@ tb_long_t tb_ssl_open_try(tb_ssl_ref_t ssl)
     // ok?
     return ok;
 }
+tb_size_t tb_ssl_ktls_enable(tb_ssl_ref_t ssl, tb_socket_ref_t sock)
+{
+    // the ssl
+    tb_ssl_impl_t* impl = (tb_ssl_impl_t*)ssl;
+    tb_assert_and_check_return_val(impl && sock, TB_SSL_KTLS_NONE);
+
+    // the traffic keys are not exported by polarssl, the record layer cannot be offloaded
+    tb_trace_d("ktls: not supported");
+    return TB_SSL_KTLS_NONE;
+}
+tb_size_t tb_ssl_ktls(tb_ssl_ref_t ssl)
+{
+    // the ssl
+    tb_ssl_impl_t* impl = (tb_ssl_impl_t*)ssl;
+    tb_assert_and_check_return_val(impl, TB_SSL_KTLS_NONE);
+
+    // not offloaded
+    return TB_SSL_KTLS_NONE;
+}
+tb_bool_t tb_ssl_resumed(tb_ssl_ref_t ssl)
+{
+    // the ssl
+    tb_ssl_impl_t* impl = (tb_ssl_impl_t*)ssl;
+    tb_assert_and_check_return_val(impl, tb_false);
+
+    // the session has been resumed?
+    return impl->bopened && impl->bresumed;
+}
 tb_bool_t tb_ssl_clos(tb_ssl_ref_t ssl)
 {
     // check
@@ -29,4 +29,11 @@
 #include "../prefix.h"
 #include "../../ssl.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the peer maxn, "host:port"
+#define TB_SSL_PEER_MAXN                (256 + 8)
+
 #endif
@@ -80,6 +80,16 @@ typedef tb_long_t   (*tb_ssl_func_writ_t)(tb_cpointer_t priv, tb_byte_t const* d
  */
 typedef tb_long_t   (*tb_ssl_func_wait_t)(tb_cpointer_t priv, tb_size_t code, tb_long_t timeout);
 
+/// the ssl kernel tls mode enum
+typedef enum __tb_ssl_ktls_e
+{
+    TB_SSL_KTLS_NONE    = 0     //!< not offloaded
+,   TB_SSL_KTLS_SEND    = 1     //!< the sending is encrypted by the kernel
+,   TB_SSL_KTLS_RECV    = 2     //!< the receiving is decrypted by the kernel
+,   TB_SSL_KTLS_BOTH    = 3     //!< both directions are offloaded
+
+}tb_ssl_ktls_e;
+
 /// the ssl ref type
 typedef struct{}*   tb_ssl_ref_t;
 
@@ -118,6 +128,39 @@ tb_void_t           tb_ssl_set_bio_sock(tb_ssl_ref_t ssl, tb_socket_ref_t sock);
  */
 tb_void_t           tb_ssl_set_bio_func(tb_ssl_ref_t ssl, tb_ssl_func_read_t read, tb_ssl_func_writ_t writ, tb_ssl_func_wait_t wait, tb_cpointer_t priv);
 
+/*! set the ssl peer for the client session resumption
+ *
+ * the client caches the last session of every peer in the process, 
+ * the next connection to the same peer resumes it with an abbreviated handshake.
+ *
+ * @param ssl       the ssl handle
+ * @param host      the peer host
+ * @param port      the peer port
+ */
+tb_void_t           tb_ssl_set_peer(tb_ssl_ref_t ssl, tb_char_t const* host, tb_uint16_t port);
+
+/*! set the certificate and the private key of the server endpoint
+ *
+ * the files are loaded only once, and all connections with the same certificate share it.
+ *
+ * @param ssl       the ssl handle
+ * @param cert      the pem certificate file path
+ * @param key       the pem private key file path
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_ssl_set_cert(tb_ssl_ref_t ssl, tb_char_t const* cert, tb_char_t const* key);
+
+/*! opt in the kernel tls before opening ssl
+ *
+ * the negotiated version will be limited to tls 1.2 which can be offloaded, 
+ * and tb_ssl_ktls_enable() need be called before reading and writing the application data.
+ *
+ * @param ssl       the ssl handle
+ * @param enable    enable it?
+ */
+tb_void_t           tb_ssl_set_ktls(tb_ssl_ref_t ssl, tb_bool_t enable);
+
 /*! set ssl timeout for opening
  *
  * @param ssl       the ssl handle
@@ -156,6 +199,41 @@ tb_bool_t           tb_ssl_open(tb_ssl_ref_t ssl);
  */
 tb_long_t           tb_ssl_open_try(tb_ssl_ref_t ssl);
 
+/*! offload the record layer of the opened ssl to the kernel tls of the given socket
+ *
+ * only tls 1.2 with aes-gcm on linux can be offloaded now, 
+ * the receiving is offloaded only if no decrypted data is pending in the user space.
+ * for openssl 1.1 and later, it need be called before reading and writing the application data, see tb_ssl_set_ktls().
+ *
+ * after offloading, tb_ssl_read and tb_ssl_writ will read and write the plain data through the bio funcs directly,
+ * and the socket can be sent by tb_socket_send or tb_socket_sendf (zero-copy) for the offloaded sending.
+ * the close notify of the offloaded sending will be sent as a kernel tls alert record by tb_ssl_clos().
+ *
+ * @param ssl       the ssl handle
+ * @param sock      the socket of this ssl 
+ *
+ * @return          the offloaded mode, see tb_ssl_ktls_e
+ */
+tb_size_t           tb_ssl_ktls_enable(tb_ssl_ref_t ssl, tb_socket_ref_t sock);
+
+/*! the kernel tls mode
+ *
+ * @param ssl       the ssl handle
+ *
+ * @return          the offloaded mode, see tb_ssl_ktls_e
+ */
+tb_size_t           tb_ssl_ktls(tb_ssl_ref_t ssl);
+
+/*! has the session of the opened ssl been resumed? 
+ *
+ * the client session is cached by the peer, see tb_ssl_set_peer()
+ *
+ * @param ssl       the ssl handle
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_ssl_resumed(tb_ssl_ref_t ssl);
+
 /*! clos ssl 
  *
  * @param ssl       the ssl handle
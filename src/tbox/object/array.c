@@ -34,6 +34,13 @@
 #include "object.h"
 #include "../algorithm/algorithm.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the inline items maxn, the array will be upgraded to the vector if exceeded
+#define TB_OBJECT_ARRAY_INLINE_MAXN         (8)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -44,12 +51,24 @@ typedef struct __tb_object_array_t
     // the object base
     tb_object_t         base;
 
-    // the vector
+    // the vector, only for the upgraded array
     tb_vector_ref_t     vector;
 
+    // the vector grow
+    tb_size_t           grow;
+
     // is increase refn?
     tb_bool_t           incr;
 
+    // the inline items count
+    tb_size_t           count;
+
+    // the inline items
+    tb_object_ref_t     items[TB_OBJECT_ARRAY_INLINE_MAXN];
+
+    // the inline items iterator
+    tb_array_iterator_t itor;
+
 }tb_object_array_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -63,24 +82,61 @@ static __tb_inline__ tb_object_array_t* tb_object_array_cast(tb_object_ref_t obj
     // cast
     return (tb_object_array_t*)object;
 }
+static tb_void_t tb_object_array_inline_clear(tb_object_array_t* array)
+{
+    // exit items
+    tb_size_t i = 0;
+    for (i = 0; i < array->count; i++) tb_object_exit(array->items[i]);
+    array->count = 0;
+}
+static tb_bool_t tb_object_array_upgrade(tb_object_array_t* array)
+{
+    // check
+    tb_assert_and_check_return_val(!array->vector, tb_false);
+
+    // init vector
+    array->vector = tb_vector_init(array->grow, tb_element_obj());
+    tb_assert_and_check_return_val(array->vector, tb_false);
+
+    // move the inline items to the vector
+    tb_size_t i = 0;
+    for (i = 0; i < array->count; i++) tb_vector_insert_tail(array->vector, array->items[i]);
+
+    // exit the inline items
+    tb_object_array_inline_clear(array);
+    return tb_true;
+}
 static tb_object_ref_t tb_object_array_copy(tb_object_ref_t object)
 {
     // check
     tb_object_array_t* array = tb_object_array_cast(object);
-    tb_assert_and_check_return_val(array && array->vector, tb_null);
+    tb_assert_and_check_return_val(array, tb_null);
 
     // init copy
-    tb_object_array_t* copy = (tb_object_array_t*)tb_object_array_init(tb_vector_grow(array->vector), array->incr);
-    tb_assert_and_check_return_val(copy && copy->vector, tb_null);
+    tb_object_array_t* copy = (tb_object_array_t*)tb_object_array_init(array->grow, array->incr);
+    tb_assert_and_check_return_val(copy, tb_null);
 
     // refn++
-    tb_for_all (tb_object_ref_t, item, array->vector)
+    tb_for_all (tb_object_ref_t, item, tb_object_array_itor(object))
     {
         if (item) tb_object_retain(item);
     }
 
     // copy
-    tb_vector_copy(copy->vector, array->vector);
+    if (array->vector)
+    {
+        if (!tb_object_array_upgrade(copy))
+        {
+            tb_object_exit((tb_object_ref_t)copy);
+            return tb_null;
+        }
+        tb_vector_copy(copy->vector, array->vector);
+    }
+    else 
+    {
+        tb_memcpy(copy->items, array->items, array->count * sizeof(tb_object_ref_t));
+        copy->count = array->count;
+    }
 
     // ok
     return (tb_object_ref_t)copy;
@@ -91,6 +147,9 @@ static tb_void_t tb_object_array_exit(tb_object_ref_t object)
     tb_object_array_t* array = tb_object_array_cast(object);
     tb_assert_and_check_return(array);
 
+    // exit items
+    tb_object_array_inline_clear(array);
+
     // exit vector
     if (array->vector) tb_vector_exit(array->vector);
     array->vector = tb_null;
@@ -101,10 +160,16 @@ static tb_void_t tb_object_array_exit(tb_object_ref_t object)
 static tb_void_t tb_object_array_clear(tb_object_ref_t object)
 {
     tb_object_array_t* array = tb_object_array_cast(object);
-    tb_assert_and_check_return(array && array->vector);
+    tb_assert_and_check_return(array);
+
+    // changed
+    object->flag |= TB_OBJECT_FLAG_DIRTY;
+
+    // clear items
+    tb_object_array_inline_clear(array);
 
     // clear vector
-    tb_vector_clear(array->vector);
+    if (array->vector) tb_vector_clear(array->vector);
 }
 static tb_object_array_t* tb_object_array_init_base()
 {
@@ -156,12 +221,8 @@ tb_object_ref_t tb_object_array_init(tb_size_t grow, tb_bool_t incr)
         array = tb_object_array_init_base();
         tb_assert_and_check_break(array);
 
-        // init element
-        tb_element_t element = tb_element_obj();
-
-        // init vector
-        array->vector = tb_vector_init(grow, element);
-        tb_assert_and_check_break(array->vector);
+        // init grow, the vector will be inited when the inline items are full
+        array->grow = grow;
 
         // init incr
         array->incr = incr;
@@ -186,19 +247,23 @@ tb_size_t tb_object_array_size(tb_object_ref_t object)
 {
     // check
     tb_object_array_t* array = tb_object_array_cast(object);
-    tb_assert_and_check_return_val(array && array->vector, 0);
+    tb_assert_and_check_return_val(array, 0);
 
     // size
-    return tb_vector_size(array->vector);
+    return array->vector? tb_vector_size(array->vector) : array->count;
 }
 tb_object_ref_t tb_object_array_item(tb_object_ref_t object, tb_size_t index)
 {
     // check
     tb_object_array_t* array = tb_object_array_cast(object);
-    tb_assert_and_check_return_val(array && array->vector, tb_null);
+    tb_assert_and_check_return_val(array, tb_null);
 
-    // item
-    return (tb_object_ref_t)tb_iterator_item(array->vector, index);
+    // the vector item
+    if (array->vector) return (tb_object_ref_t)tb_iterator_item(array->vector, index);
+
+    // the inline item
+    tb_assert_and_check_return_val(index < array->count, tb_null);
+    return array->items[index];
 }
 tb_iterator_ref_t tb_object_array_itor(tb_object_ref_t object)
 {
@@ -207,25 +272,49 @@ tb_iterator_ref_t tb_object_array_itor(tb_object_ref_t object)
     tb_assert_and_check_return_val(array, tb_null);
 
     // iterator
-    return (tb_iterator_ref_t)array->vector;
+    if (array->vector) return (tb_iterator_ref_t)array->vector;
+    return tb_iterator_make_for_ptr(&array->itor, (tb_pointer_t*)array->items, array->count);
 }
 tb_void_t tb_object_array_remove(tb_object_ref_t object, tb_size_t index)
 {
     // check
     tb_object_array_t* array = tb_object_array_cast(object);
-    tb_assert_and_check_return(array && array->vector);
+    tb_assert_and_check_return(array);
+
+    // changed
+    object->flag |= TB_OBJECT_FLAG_DIRTY;
 
-    // remove
-    tb_vector_remove(array->vector, index);
+    // remove the vector item
+    if (array->vector)
+    {
+        tb_vector_remove(array->vector, index);
+        return ;
+    }
+
+    // remove the inline item
+    tb_assert_and_check_return(index < array->count);
+    tb_object_exit(array->items[index]);
+    if (index + 1 < array->count) tb_memmov(array->items + index, array->items + index + 1, (array->count - index - 1) * sizeof(tb_object_ref_t));
+    array->count--;
 }
 tb_void_t tb_object_array_append(tb_object_ref_t object, tb_object_ref_t item)
 {
     // check
     tb_object_array_t* array = tb_object_array_cast(object);
-    tb_assert_and_check_return(array && array->vector && item);
+    tb_assert_and_check_return(array && item);
+
+    // changed
+    object->flag |= TB_OBJECT_FLAG_DIRTY;
 
     // insert
-    tb_vector_insert_tail(array->vector, item);
+    if (array->vector || (array->count == TB_OBJECT_ARRAY_INLINE_MAXN && tb_object_array_upgrade(array)))
+        tb_vector_insert_tail(array->vector, item);
+    else if (array->count < TB_OBJECT_ARRAY_INLINE_MAXN)
+    {
+        tb_object_retain(item);
+        array->items[array->count++] = item;
+    }
+    else return ;
 
     // refn--
     if (!array->incr) tb_object_exit(item);
@@ -234,10 +323,23 @@ tb_void_t tb_object_array_insert(tb_object_ref_t object, tb_size_t index, tb_obj
 {
     // check
     tb_object_array_t* array = tb_object_array_cast(object);
-    tb_assert_and_check_return(array && array->vector && item);
+    tb_assert_and_check_return(array && item);
+
+    // changed
+    object->flag |= TB_OBJECT_FLAG_DIRTY;
 
     // insert
-    tb_vector_insert_prev(array->vector, index, item);
+    if (array->vector || (array->count == TB_OBJECT_ARRAY_INLINE_MAXN && tb_object_array_upgrade(array)))
+        tb_vector_insert_prev(array->vector, index, item);
+    else if (array->count < TB_OBJECT_ARRAY_INLINE_MAXN)
+    {
+        tb_assert_and_check_return(index <= array->count);
+        if (index < array->count) tb_memmov(array->items + index + 1, array->items + index, (array->count - index) * sizeof(tb_object_ref_t));
+        tb_object_retain(item);
+        array->items[index] = item;
+        array->count++;
+    }
+    else return ;
 
     // refn--
     if (!array->incr) tb_object_exit(item);
@@ -246,10 +348,20 @@ tb_void_t tb_object_array_replace(tb_object_ref_t object, tb_size_t index, tb_ob
 {
     // check
     tb_object_array_t* array = tb_object_array_cast(object);
-    tb_assert_and_check_return(array && array->vector && item);
+    tb_assert_and_check_return(array && item);
+
+    // changed
+    object->flag |= TB_OBJECT_FLAG_DIRTY;
 
     // replace
-    tb_vector_replace(array->vector, index, item);
+    if (array->vector) tb_vector_replace(array->vector, index, item);
+    else
+    {
+        tb_assert_and_check_return(index < array->count);
+        tb_object_retain(item);
+        tb_object_exit(array->items[index]);
+        array->items[index] = item;
+    }
 
     // refn--
     if (!array->incr) tb_object_exit(item);
@@ -205,6 +205,9 @@ tb_bool_t tb_object_data_setp(tb_object_ref_t object, tb_pointer_t addr, tb_size
     // data
     tb_buffer_memncpy(&data->buffer, (tb_byte_t const*)addr, size);
 
+    // changed
+    object->flag |= TB_OBJECT_FLAG_DIRTY;
+
     // ok
     return tb_true;
 }
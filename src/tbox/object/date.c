@@ -153,6 +153,9 @@ tb_bool_t tb_object_date_time_set(tb_object_ref_t object, tb_time_t time)
     // set time
     date->time = time;
 
+    // changed
+    object->flag |= TB_OBJECT_FLAG_DIRTY;
+
     // ok
     return tb_true;
 }
@@ -165,6 +168,9 @@ tb_bool_t tb_object_date_time_set_now(tb_object_ref_t object)
     // set time
     date->time = tb_time();
 
+    // changed
+    object->flag |= TB_OBJECT_FLAG_DIRTY;
+
     // ok
     return tb_true;
 }
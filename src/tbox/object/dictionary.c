@@ -34,6 +34,9 @@
 #include "object.h"
 #include "../string/string.h"
 #include "../algorithm/algorithm.h"
+#include "../memory/string_pool.h"
+#include "../platform/spinlock.h"
+#include "../platform/atomic.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -44,6 +47,9 @@
 #   define TB_OBJECT_DICTIONARY_SIZE_DEFAULT           TB_OBJECT_DICTIONARY_SIZE_SMALL
 #endif
 
+// the inline items maxn, the dictionary will be upgraded to the hash map if exceeded
+#define TB_OBJECT_DICTIONARY_INLINE_MAXN                (8)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -57,14 +63,45 @@ typedef struct __tb_object_dictionary_t
     // the capacity size
     tb_size_t           size;
 
-    // the object hash
+    // the object hash, only for the upgraded dictionary
     tb_hash_map_ref_t   hash;
 
     // increase refn?
     tb_bool_t           incr;
 
+    // are the keys interned?
+    tb_bool_t           intern;
+
+    // track the changed keys?
+    tb_bool_t           tracked;
+
+    // the changed keys since tracked, key => existed before changing?
+    tb_hash_map_ref_t   changes;
+
+    // the inline items count
+    tb_size_t           count;
+
+    // the inline items
+    tb_object_dictionary_item_t items[TB_OBJECT_DICTIONARY_INLINE_MAXN];
+
+    // the inline items iterator
+    tb_array_iterator_t itor;
+
 }tb_object_dictionary_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the interned keys
+static tb_string_pool_ref_t     g_keys = tb_null;
+
+// the interned keys lock
+static tb_spinlock_t            g_keys_lock = TB_SPINLOCK_INIT;
+
+// intern the keys of the new dictionaries?
+static tb_atomic_t              g_keys_intern = 0;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -76,6 +113,131 @@ static __tb_inline__ tb_object_dictionary_t* tb_object_dictionary_cast(tb_object
     // cast
     return (tb_object_dictionary_t*)object;
 }
+static tb_char_t const* tb_object_dictionary_key_dupl(tb_bool_t intern, tb_char_t const* key)
+{
+    // no interned? duplicate it
+    if (!intern) return tb_strdup(key);
+
+    // enter
+    tb_spinlock_enter(&g_keys_lock);
+
+    // init keys
+    if (!g_keys) g_keys = tb_string_pool_init(tb_true);
+
+    // intern it
+    tb_char_t const* cstr = g_keys? tb_string_pool_insert(g_keys, key) : tb_null;
+
+    // leave
+    tb_spinlock_leave(&g_keys_lock);
+    return cstr;
+}
+static tb_void_t tb_object_dictionary_key_free(tb_bool_t intern, tb_char_t const* key)
+{
+    // no interned? free it
+    if (!intern) 
+    {
+        tb_free((tb_pointer_t)key);
+        return ;
+    }
+
+    // remove it from the interned keys
+    tb_spinlock_enter(&g_keys_lock);
+    if (g_keys) tb_string_pool_remove(g_keys, key);
+    tb_spinlock_leave(&g_keys_lock);
+}
+static tb_void_t tb_object_dictionary_key_element_free(tb_element_ref_t element, tb_pointer_t buff)
+{
+    // check
+    tb_assert_and_check_return(buff);
+
+    // free it
+    tb_char_t const* key = *((tb_char_t const**)buff);
+    if (key) tb_object_dictionary_key_free(tb_true, key);
+    *((tb_char_t const**)buff) = tb_null;
+}
+static tb_void_t tb_object_dictionary_key_element_dupl(tb_element_ref_t element, tb_pointer_t buff, tb_cpointer_t data)
+{
+    // check
+    tb_assert_and_check_return(buff);
+
+    // intern it
+    *((tb_char_t const**)buff) = data? tb_object_dictionary_key_dupl(tb_true, (tb_char_t const*)data) : tb_null;
+}
+static tb_void_t tb_object_dictionary_key_element_repl(tb_element_ref_t element, tb_pointer_t buff, tb_cpointer_t data)
+{
+    tb_object_dictionary_key_element_free(element, buff);
+    tb_object_dictionary_key_element_dupl(element, buff, data);
+}
+static tb_void_t tb_object_dictionary_change(tb_object_dictionary_t* dictionary, tb_char_t const* key)
+{
+    // not tracked? the whole dictionary has been changed
+    if (!dictionary->tracked)
+    {
+        dictionary->base.flag |= TB_OBJECT_FLAG_DIRTY;
+        return ;
+    }
+
+    // init changes
+    if (!dictionary->changes) dictionary->changes = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, tb_element_str(tb_true), tb_element_size());
+    tb_assert_and_check_return(dictionary->changes);
+
+    // save the first change of this key and whether it existed before
+    if (tb_hash_map_find(dictionary->changes, key) == tb_iterator_tail(dictionary->changes))
+    {
+        tb_bool_t existed = tb_object_dictionary_value((tb_object_ref_t)dictionary, key)? tb_true : tb_false;
+        tb_hash_map_insert(dictionary->changes, key, (tb_cpointer_t)(tb_size_t)existed);
+    }
+}
+static __tb_inline__ tb_size_t tb_object_dictionary_inline_find(tb_object_dictionary_t* dictionary, tb_char_t const* key)
+{
+    // find it, the same key pointer is the fast path
+    tb_size_t                       i = 0;
+    tb_size_t                       n = dictionary->count;
+    tb_object_dictionary_item_t*    items = dictionary->items;
+    for (i = 0; i < n; i++)
+    {
+        if (items[i].key == key || (items[i].key[0] == key[0] && !tb_strcmp(items[i].key, key))) break;
+    }
+    return i;
+}
+static tb_void_t tb_object_dictionary_inline_clear(tb_object_dictionary_t* dictionary)
+{
+    // exit items
+    tb_size_t i = 0;
+    for (i = 0; i < dictionary->count; i++)
+    {
+        tb_object_dictionary_key_free(dictionary->intern, dictionary->items[i].key);
+        tb_object_exit(dictionary->items[i].val);
+    }
+    dictionary->count = 0;
+}
+static tb_bool_t tb_object_dictionary_upgrade(tb_object_dictionary_t* dictionary)
+{
+    // check
+    tb_assert_and_check_return_val(!dictionary->hash, tb_false);
+
+    // init the key element
+    tb_element_t element = tb_element_str(tb_true);
+    if (dictionary->intern)
+    {
+        element.free = tb_object_dictionary_key_element_free;
+        element.dupl = tb_object_dictionary_key_element_dupl;
+        element.repl = tb_object_dictionary_key_element_repl;
+    }
+
+    // init hash
+    dictionary->hash = tb_hash_map_init(dictionary->size, element, tb_element_obj());
+    tb_assert_and_check_return_val(dictionary->hash, tb_false);
+
+    // move the inline items to the hash
+    tb_size_t i = 0;
+    for (i = 0; i < dictionary->count; i++)
+        tb_hash_map_insert(dictionary->hash, dictionary->items[i].key, dictionary->items[i].val);
+
+    // exit the inline items
+    tb_object_dictionary_inline_clear(dictionary);
+    return tb_true;
+}
 static tb_object_ref_t tb_object_dictionary_copy(tb_object_ref_t object)
 {
     // check
@@ -86,6 +248,9 @@ static tb_object_ref_t tb_object_dictionary_copy(tb_object_ref_t object)
     tb_object_dictionary_t* copy = (tb_object_dictionary_t*)tb_object_dictionary_init(dictionary->size, dictionary->incr);
     tb_assert_and_check_return_val(copy, tb_null);
 
+    // the copied keys are interned if the source keys are interned
+    copy->intern = dictionary->intern;
+
     // walk copy
     tb_for_all (tb_object_dictionary_item_t*, item, tb_object_dictionary_itor((tb_object_ref_t)dictionary))
     {
@@ -108,10 +273,17 @@ static tb_void_t tb_object_dictionary_exit(tb_object_ref_t object)
     tb_object_dictionary_t* dictionary = tb_object_dictionary_cast(object);
     tb_assert_and_check_return(dictionary);
 
+    // exit items
+    tb_object_dictionary_inline_clear(dictionary);
+
     // exit hash
     if (dictionary->hash) tb_hash_map_exit(dictionary->hash);
     dictionary->hash = tb_null;
 
+    // exit changes
+    if (dictionary->changes) tb_hash_map_exit(dictionary->changes);
+    dictionary->changes = tb_null;
+
     // exit it
     tb_free(dictionary);
 }
@@ -120,7 +292,11 @@ static tb_void_t tb_object_dictionary_clear(tb_object_ref_t object)
     tb_object_dictionary_t* dictionary = tb_object_dictionary_cast(object);
     tb_assert_and_check_return(dictionary);
 
+    // changed
+    object->flag |= TB_OBJECT_FLAG_DIRTY;
+
     // clear
+    tb_object_dictionary_inline_clear(dictionary);
     if (dictionary->hash) tb_hash_map_clear(dictionary->hash);
 }
 static tb_object_dictionary_t* tb_object_dictionary_init_base()
@@ -179,10 +355,10 @@ tb_object_ref_t tb_object_dictionary_init(tb_size_t size, tb_bool_t incr)
         // init
         dictionary->size = size;
         dictionary->incr = incr;
+        dictionary->intern = (tb_bool_t)tb_atomic_get(&g_keys_intern);
 
-        // init hash
-        dictionary->hash = tb_hash_map_init(size, tb_element_str(tb_true), tb_element_obj());
-        tb_assert_and_check_break(dictionary->hash);
+        // the hash will be inited when the inline items are full
+        dictionary->hash = tb_null;
 
         // ok
         ok = tb_true;
@@ -204,10 +380,10 @@ tb_size_t tb_object_dictionary_size(tb_object_ref_t object)
 {
     // check
     tb_object_dictionary_t* dictionary = tb_object_dictionary_cast(object);
-    tb_assert_and_check_return_val(dictionary && dictionary->hash, 0);
+    tb_assert_and_check_return_val(dictionary, 0);
 
     // size
-    return tb_hash_map_size(dictionary->hash);
+    return dictionary->hash? tb_hash_map_size(dictionary->hash) : dictionary->count;
 }
 tb_iterator_ref_t tb_object_dictionary_itor(tb_object_ref_t object)
 {
@@ -215,34 +391,83 @@ tb_iterator_ref_t tb_object_dictionary_itor(tb_object_ref_t object)
     tb_assert_and_check_return_val(dictionary, tb_null);
 
     // iterator
-    return (tb_iterator_ref_t)dictionary->hash;
+    if (dictionary->hash) return (tb_iterator_ref_t)dictionary->hash;
+    return tb_iterator_make_for_mem(&dictionary->itor, dictionary->items, dictionary->count, sizeof(tb_object_dictionary_item_t));
 }
 tb_object_ref_t tb_object_dictionary_value(tb_object_ref_t object, tb_char_t const* key)
 {
     // check
     tb_object_dictionary_t* dictionary = tb_object_dictionary_cast(object);
-    tb_assert_and_check_return_val(dictionary && dictionary->hash && key, tb_null);
+    tb_assert_and_check_return_val(dictionary && key, tb_null);
+
+    // the hash value
+    if (dictionary->hash) return (tb_object_ref_t)tb_hash_map_get(dictionary->hash, key);
 
-    // value
-    return (tb_object_ref_t)tb_hash_map_get(dictionary->hash, key);
+    // the inline value
+    tb_size_t i = tb_object_dictionary_inline_find(dictionary, key);
+    return i < dictionary->count? dictionary->items[i].val : tb_null;
 }
 tb_void_t tb_object_dictionary_remove(tb_object_ref_t object, tb_char_t const* key)
 {
     // check
     tb_object_dictionary_t* dictionary = tb_object_dictionary_cast(object);
-    tb_assert_and_check_return(dictionary && dictionary->hash && key);
+    tb_assert_and_check_return(dictionary && key);
+
+    // changed
+    tb_object_dictionary_change(dictionary, key);
 
-    // del
-    return tb_hash_map_remove(dictionary->hash, key);
+    // remove the hash item
+    if (dictionary->hash) 
+    {
+        tb_hash_map_remove(dictionary->hash, key);
+        return ;
+    }
+
+    // find the inline item
+    tb_size_t i = tb_object_dictionary_inline_find(dictionary, key);
+    tb_check_return(i < dictionary->count);
+
+    // remove it and keep the insertion order
+    tb_object_dictionary_key_free(dictionary->intern, dictionary->items[i].key);
+    tb_object_exit(dictionary->items[i].val);
+    if (i + 1 < dictionary->count) tb_memmov(dictionary->items + i, dictionary->items + i + 1, (dictionary->count - i - 1) * sizeof(tb_object_dictionary_item_t));
+    dictionary->count--;
 }
 tb_void_t tb_object_dictionary_insert(tb_object_ref_t object, tb_char_t const* key, tb_object_ref_t val)
 {
     // check
     tb_object_dictionary_t* dictionary = tb_object_dictionary_cast(object);
-    tb_assert_and_check_return(dictionary && dictionary->hash && key && val);
+    tb_assert_and_check_return(dictionary && key && val);
+
+    // changed
+    tb_object_dictionary_change(dictionary, key);
 
-    // add
-    tb_hash_map_insert(dictionary->hash, key, val);
+    // insert the inline item
+    if (!dictionary->hash)
+    {
+        tb_size_t i = tb_object_dictionary_inline_find(dictionary, key);
+        if (i < dictionary->count)
+        {
+            // replace it
+            tb_object_retain(val);
+            tb_object_exit(dictionary->items[i].val);
+            dictionary->items[i].val = val;
+        }
+        else if (i < TB_OBJECT_DICTIONARY_INLINE_MAXN)
+        {
+            // append it
+            dictionary->items[i].key = tb_object_dictionary_key_dupl(dictionary->intern, key);
+            tb_assert_and_check_return(dictionary->items[i].key);
+            tb_object_retain(val);
+            dictionary->items[i].val = val;
+            dictionary->count++;
+        }
+        // upgrade to the hash map
+        else if (!tb_object_dictionary_upgrade(dictionary)) return ;
+    }
+
+    // insert the hash item
+    if (dictionary->hash) tb_hash_map_insert(dictionary->hash, key, val);
 
     // refn--
     if (!dictionary->incr) tb_object_exit(val);
@@ -255,3 +480,35 @@ tb_void_t tb_object_dictionary_incr(tb_object_ref_t object, tb_bool_t incr)
 
     dictionary->incr = incr;
 }
+tb_void_t tb_object_dictionary_track(tb_object_ref_t object, tb_bool_t track)
+{
+    // check
+    tb_object_dictionary_t* dictionary = tb_object_dictionary_cast(object);
+    tb_assert_and_check_return(dictionary);
+
+    // reset changes
+    if (dictionary->changes) tb_hash_map_exit(dictionary->changes);
+    dictionary->changes = tb_null;
+    dictionary->tracked = track;
+}
+tb_iterator_ref_t tb_object_dictionary_changes(tb_object_ref_t object)
+{
+    // check
+    tb_object_dictionary_t* dictionary = tb_object_dictionary_cast(object);
+    tb_assert_and_check_return_val(dictionary, tb_null);
+
+    // the changes
+    return (tb_iterator_ref_t)dictionary->changes;
+}
+tb_void_t tb_object_dictionary_intern(tb_bool_t intern)
+{
+    tb_atomic_set(&g_keys_intern, intern? 1 : 0);
+}
+tb_void_t tb_object_dictionary_intern_exit()
+{
+    // exit the interned keys
+    tb_spinlock_enter(&g_keys_lock);
+    if (g_keys) tb_string_pool_exit(g_keys);
+    g_keys = tb_null;
+    tb_spinlock_leave(&g_keys_lock);
+}
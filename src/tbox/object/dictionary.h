@@ -107,6 +107,49 @@ tb_size_t               tb_object_dictionary_size(tb_object_ref_t dictionary);
  */
 tb_void_t               tb_object_dictionary_incr(tb_object_ref_t dictionary, tb_bool_t incr);
 
+/*! track the changed keys of the dictionary and clear the previous changes
+ *
+ * @param dictionary    the dictionary object
+ * @param track         is tracked?
+ */
+tb_void_t               tb_object_dictionary_track(tb_object_ref_t dictionary, tb_bool_t track);
+
+/*! the changed keys iterator since tracked
+ *
+ * @param dictionary    the dictionary object
+ *
+ * @return              the iterator of the hash map items (name: the key, data: existed before changing?), tb_null if no changes
+ *
+ * @code
+    tb_iterator_ref_t changes = tb_object_dictionary_changes(dictionary);
+    if (changes)
+    {
+        tb_for_all (tb_hash_map_item_ref_t, item, changes)
+        {
+            tb_char_t const*    key = (tb_char_t const*)item->name;
+            tb_bool_t           existed = (tb_bool_t)(tb_size_t)item->data;
+            tb_object_ref_t     val = tb_object_dictionary_value(dictionary, key);
+
+            // ...
+        }
+    }
+ * @endcode
+ */
+tb_iterator_ref_t       tb_object_dictionary_changes(tb_object_ref_t dictionary);
+
+/*! intern the keys of the new dictionaries
+ *
+ * the keys are shared in the global key pool instead of being copied for each dictionary,
+ * it decreases the memory of the documents with many records and the same keys
+ *
+ * @param intern        is interned?
+ */
+tb_void_t               tb_object_dictionary_intern(tb_bool_t intern);
+
+/*! exit the interned keys, called by tb_object_context_exit()
+ */
+tb_void_t               tb_object_dictionary_intern_exit(tb_noarg_t);
+
 /*! the dictionary iterator
  *
  * @param dictionary    the dictionary object
@@ -29,5 +29,7 @@
  */
 #include "reader/reader.h"
 #include "writer/writer.h"
+#include "records.h"
+#include "patch.h"
 
 #endif
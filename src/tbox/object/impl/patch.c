@@ -0,0 +1,265 @@
+/*!The Treasure Box Library
+ *
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox;
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ *
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        patch.c
+ * @ingroup     object
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME        "object_patch"
+#define TB_TRACE_MODULE_DEBUG       (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "patch.h"
+#include "writer/json.h"
+#include "../../string/string.h"
+#include "../../algorithm/algorithm.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the patch writer type
+typedef struct __tb_object_patch_writer_t
+{
+    // the json writer
+    tb_object_json_writer_t     json;
+
+    // the current path
+    tb_string_t                 path;
+
+    // the path string object
+    tb_object_ref_t             string;
+
+    // the operations count
+    tb_size_t                   count;
+
+}tb_object_patch_writer_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_void_t tb_object_patch_path_key(tb_object_patch_writer_t* writer, tb_char_t const* key)
+{
+    // append the json pointer token, escape '~' and '/'
+    tb_string_chrcat(&writer->path, '/');
+    for (; *key; key++)
+    {
+        if (*key == '~') tb_string_cstrncat(&writer->path, "~0", 2);
+        else if (*key == '/') tb_string_cstrncat(&writer->path, "~1", 2);
+        else tb_string_chrcat(&writer->path, *key);
+    }
+}
+static tb_bool_t tb_object_patch_writ_value(tb_object_patch_writer_t* writer, tb_object_ref_t object)
+{
+    // the func
+    tb_object_json_writer_func_t func = tb_object_json_writer_func(object->type);
+    tb_assert_and_check_return_val(func, tb_false);
+
+    // writ it
+    return func(&writer->json, object, 0);
+}
+static tb_bool_t tb_object_patch_writ_op(tb_object_patch_writer_t* writer, tb_char_t const* op, tb_object_ref_t value)
+{
+    // the stream
+    tb_stream_ref_t stream = writer->json.stream;
+
+    // writ the separator
+    if (!tb_stream_bwrit(stream, (tb_byte_t const*)(writer->count? ",\n" : "\n"), writer->count? 2 : 1)) return tb_false;
+    writer->count++;
+
+    // writ the operation
+    if (!tb_object_writer_cstr(stream, "{\"op\":\"")) return tb_false;
+    if (!tb_stream_bwrit(stream, (tb_byte_t const*)op, tb_strlen(op))) return tb_false;
+    if (!tb_object_writer_cstr(stream, "\",\"path\":")) return tb_false;
+
+    // writ the path, the root path is empty
+    tb_char_t const* path = tb_string_cstr(&writer->path);
+    if (path)
+    {
+        tb_object_string_cstr_set(writer->string, path);
+        if (!tb_object_patch_writ_value(writer, writer->string)) return tb_false;
+    }
+    else if (!tb_object_writer_cstr(stream, "\"\"")) return tb_false;
+
+    // writ the value
+    if (value)
+    {
+        if (!tb_object_writer_cstr(stream, ",\"value\":")) return tb_false;
+        if (!tb_object_patch_writ_value(writer, value)) return tb_false;
+    }
+
+    // ok
+    return tb_object_writer_cstr(stream, "}");
+}
+static tb_bool_t tb_object_patch_walk(tb_object_patch_writer_t* writer, tb_object_ref_t object, tb_char_t const* op)
+{
+    // the whole object has been changed? replace it
+    if (object->flag & TB_OBJECT_FLAG_DIRTY)
+    {
+        if (!tb_object_patch_writ_op(writer, op, object)) return tb_false;
+        tb_object_patch_track(object);
+        return tb_true;
+    }
+
+    // the path size
+    tb_size_t size = tb_string_size(&writer->path);
+
+    // walk the dictionary
+    if (object->type == TB_OBJECT_TYPE_DICTIONARY)
+    {
+        // writ the changed keys
+        tb_iterator_ref_t changes = tb_object_dictionary_changes(object);
+        if (changes)
+        {
+            tb_for_all (tb_hash_map_item_ref_t, item, changes)
+            {
+                // the value
+                tb_char_t const*    key = (tb_char_t const*)item->name;
+                tb_bool_t           existed = (tb_bool_t)(tb_size_t)item->data;
+                tb_object_ref_t     value = tb_object_dictionary_value(object, key);
+
+                // writ it
+                tb_object_patch_path_key(writer, key);
+                if (value)
+                {
+                    if (!tb_object_patch_writ_op(writer, existed? "replace" : "add", value)) return tb_false;
+                    tb_object_patch_track(value);
+                }
+                else if (existed && !tb_object_patch_writ_op(writer, "remove", tb_null)) return tb_false;
+                tb_string_strip(&writer->path, size);
+            }
+        }
+
+        // walk the unchanged keys
+        tb_for_all (tb_object_dictionary_item_t*, item, tb_object_dictionary_itor(object))
+        {
+            // changed? skip it
+            if (!item || !item->val || (changes && tb_hash_map_find((tb_hash_map_ref_t)changes, item->key) != tb_iterator_tail(changes))) continue;
+
+            // walk it
+            tb_object_patch_path_key(writer, item->key);
+            if (!tb_object_patch_walk(writer, item->val, "replace")) return tb_false;
+            tb_string_strip(&writer->path, size);
+        }
+
+        // track it again
+        tb_object_dictionary_track(object, tb_true);
+    }
+    // walk the array
+    else if (object->type == TB_OBJECT_TYPE_ARRAY)
+    {
+        tb_size_t index = 0;
+        tb_for_all (tb_object_ref_t, item, tb_object_array_itor(object))
+        {
+            // walk it
+            if (item)
+            {
+                tb_string_cstrfcat(&writer->path, "/%lu", index);
+                if (!tb_object_patch_walk(writer, item, "replace")) return tb_false;
+                tb_string_strip(&writer->path, size);
+            }
+            index++;
+        }
+    }
+
+    // ok
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+tb_void_t tb_object_patch_track(tb_object_ref_t object)
+{
+    // check
+    tb_assert_and_check_return(object);
+
+    // clean it, the readonly singletons are never changed
+    if (object->flag & TB_OBJECT_FLAG_DIRTY) object->flag &= ~TB_OBJECT_FLAG_DIRTY;
+
+    // track the dictionary
+    if (object->type == TB_OBJECT_TYPE_DICTIONARY)
+    {
+        tb_object_dictionary_track(object, tb_true);
+        tb_for_all (tb_object_dictionary_item_t*, item, tb_object_dictionary_itor(object))
+        {
+            if (item && item->val) tb_object_patch_track(item->val);
+        }
+    }
+    // track the array
+    else if (object->type == TB_OBJECT_TYPE_ARRAY)
+    {
+        tb_for_all (tb_object_ref_t, item, tb_object_array_itor(object))
+        {
+            if (item) tb_object_patch_track(item);
+        }
+    }
+}
+tb_long_t tb_object_patch_done(tb_object_ref_t object, tb_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(object && stream, -1);
+
+    // init writer
+    tb_object_patch_writer_t writer;
+    tb_memset(&writer, 0, sizeof(writer));
+    writer.json.stream  = stream;
+    writer.json.deflate = tb_true;
+    if (!tb_string_init(&writer.path)) return -1;
+
+    // the begin offset
+    tb_hize_t bof = tb_stream_offset(stream);
+
+    // writ the patch
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // init the path string object
+        writer.string = tb_object_string_init_from_cstr(tb_null);
+        tb_assert_and_check_break(writer.string);
+
+        // writ the operations
+        if (!tb_object_writer_cstr(stream, "[")) break;
+        if (!tb_object_patch_walk(&writer, object, "replace")) break;
+        if (!tb_object_writer_cstr(stream, "\n]\n")) break;
+
+        // sync
+        if (!tb_stream_sync(stream, tb_true)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // exit writer
+    if (writer.string) tb_object_exit(writer.string);
+    tb_string_exit(&writer.path);
+
+    // the end offset
+    tb_hize_t eof = tb_stream_offset(stream);
+
+    // ok?
+    return (ok && eof >= bof)? (tb_long_t)(eof - bof) : -1;
+}
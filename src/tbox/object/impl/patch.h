@@ -0,0 +1,61 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        patch.h
+ * @ingroup     object
+ *
+ */
+#ifndef TB_OBJECT_IMPL_PATCH_H
+#define TB_OBJECT_IMPL_PATCH_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! track the changes of the object tree
+ *
+ * @param object    the root object
+ */
+tb_void_t           tb_object_patch_track(tb_object_ref_t object);
+
+/*! write the changes of the tracked object tree as the json patch and track it again
+ *
+ * @param object    the root object
+ * @param stream    the stream
+ *
+ * @return          the writed size, -1 if failed
+ */
+tb_long_t           tb_object_patch_done(tb_object_ref_t object, tb_stream_ref_t stream);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -418,6 +418,9 @@ static tb_object_ref_t tb_object_bplist_reader_func_boolean(tb_object_bplist_rea
     // read 
     switch (size)
     {
+    case TB_OBJECT_BPLIST_TYPE_NONE:
+        object = tb_object_null_init();
+        break;
     case TB_OBJECT_BPLIST_TYPE_TRUE:
         object = tb_object_boolean_init(tb_true);
         break;
@@ -658,14 +661,10 @@ static tb_object_ref_t tb_object_bplist_reader_done(tb_stream_ref_t stream)
                                         tb_assert(tb_object_type(object_hash[key]) == TB_OBJECT_TYPE_STRING);
                                         if (tb_object_type(object_hash[key]) == TB_OBJECT_TYPE_STRING)
                                         {
-                                            // set key => val
+                                            // set key => val, the empty key has no cstr
                                             tb_char_t const* skey = tb_object_string_cstr(object_hash[key]);
-                                            if (skey) 
-                                            {
-                                                tb_object_retain(object_hash[val]);
-                                                tb_object_dictionary_insert(object, skey, object_hash[val]);
-                                            }
-                                            tb_assert(skey);
+                                            tb_object_retain(object_hash[val]);
+                                            tb_object_dictionary_insert(object, skey? skey : "", object_hash[val]);
                                         }
                                     }
                                 }
@@ -154,14 +154,10 @@ static tb_object_ref_t tb_object_json_reader_func_array(tb_object_json_reader_t*
     // ok?
     return array;
 }
-static tb_object_ref_t tb_object_json_reader_func_string(tb_object_json_reader_t* reader, tb_char_t type)
+static tb_void_t tb_object_json_reader_read_string(tb_object_json_reader_t* reader, tb_char_t type, tb_string_ref_t data)
 {
     // check
-    tb_assert_and_check_return_val(reader && reader->stream && (type == '\"' || type == '\''), tb_null);
-
-    // init data
-    tb_string_t data;
-    if (!tb_string_init(&data)) return tb_null;
+    tb_assert_and_check_return(reader && reader->stream && data);
 
     // walk
     tb_char_t ch;
@@ -171,7 +167,7 @@ static tb_object_ref_t tb_object_json_reader_func_string(tb_object_json_reader_t
         if (!tb_stream_bread_s8(reader->stream, (tb_sint8_t*)&ch)) break;
 
         // end?
-        if (ch == '\"' || ch == '\'') break;
+        if (ch == type) break;
         // the escaped character?
         else if (ch == '\\')
         {
@@ -201,21 +197,45 @@ static tb_object_ref_t tb_object_json_reader_func_string(tb_object_json_reader_t
 
                 // unicode to utf8
                 tb_long_t utf8_size = tb_charset_conv_bst(TB_CHARSET_TYPE_UCS2 | TB_CHARSET_TYPE_NE, TB_CHARSET_TYPE_UTF8, &unicode_stream, &utf8_stream);
-                if (utf8_size > 0) tb_string_cstrncat(&data, utf8_data, utf8_size);
+                if (utf8_size > 0) tb_string_cstrncat(data, utf8_data, utf8_size);
 #else
                 // trace
                 tb_trace1_e("unicode type is not supported, please enable charset module config if you want to use it!");
 
                 // only append it
-                tb_string_chrcat(&data, ch);
+                tb_string_chrcat(data, ch);
 #endif
             }
             // append escaped character
-            else tb_string_chrcat(&data, ch);
+            else
+            {
+                switch (ch)
+                {
+                case 'b': ch = '\b'; break;
+                case 'f': ch = '\f'; break;
+                case 'n': ch = '\n'; break;
+                case 'r': ch = '\r'; break;
+                case 't': ch = '\t'; break;
+                default: break;
+                }
+                tb_string_chrcat(data, ch);
+            }
         }
         // append character
-        else tb_string_chrcat(&data, ch);
+        else tb_string_chrcat(data, ch);
     }
+}
+static tb_object_ref_t tb_object_json_reader_func_string(tb_object_json_reader_t* reader, tb_char_t type)
+{
+    // check
+    tb_assert_and_check_return_val(reader && reader->stream && (type == '\"' || type == '\''), tb_null);
+
+    // init data
+    tb_string_t data;
+    if (!tb_string_init(&data)) return tb_null;
+
+    // read and decode the string
+    tb_object_json_reader_read_string(reader, type, &data);
 
     // init string
     tb_object_ref_t string = tb_object_string_init_from_cstr(tb_string_cstr(&data));
@@ -270,6 +290,7 @@ static tb_object_ref_t tb_object_json_reader_func_number(tb_object_json_reader_t
                 failed = tb_true;
                 break;
             }
+            else if (ch == 'e' || ch == 'E') bf = tb_true;
 
             // append character
             if (tb_isdigit10(ch) || ch == '.' || ch == 'e' || ch == 'E' || ch == '-' || ch == '+') 
@@ -291,7 +312,7 @@ static tb_object_ref_t tb_object_json_reader_func_number(tb_object_json_reader_t
 
         // init number 
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
-        if (bf) number = tb_object_number_init_from_float(tb_stof(tb_static_string_cstr(&data)));
+        if (bf) number = tb_object_number_init_from_double(tb_s10tod(tb_static_string_cstr(&data)));
 #else
         if (bf) tb_trace_noimpl();
 #endif
@@ -399,9 +420,8 @@ static tb_object_ref_t tb_object_json_reader_func_dictionary(tb_object_json_read
     tb_assert_and_check_return_val(reader && reader->stream && type == '{', tb_null);
 
     // init key name
-    tb_static_string_t  kname;
-    tb_char_t           kdata[8192];
-    if (!tb_static_string_init(&kname, kdata, 8192)) return tb_null;
+    tb_string_t kname;
+    if (!tb_string_init(&kname)) return tb_null;
 
     // init dictionary
     tb_object_ref_t dictionary = tb_object_dictionary_init(0, tb_false);
@@ -411,7 +431,6 @@ static tb_object_ref_t tb_object_json_reader_func_dictionary(tb_object_json_read
     tb_char_t ch;
     tb_bool_t ok = tb_true;
     tb_bool_t bkey = tb_false;
-    tb_size_t bstr = 0;
     while (ok && tb_stream_left(reader->stream)) 
     {
         // read one character
@@ -425,18 +444,20 @@ static tb_object_ref_t tb_object_json_reader_func_dictionary(tb_object_json_read
             // no key?
             if (!bkey)
             {
-                // is str?
-                if (ch == '\"' || ch == '\'') bstr = !bstr;
+                // read and decode the key string
+                if (ch == '\"' || ch == '\'')
+                {
+                    tb_string_clear(&kname);
+                    tb_object_json_reader_read_string(reader, ch, &kname);
+                }
                 // is key end?
-                else if (!bstr && ch == ':') bkey = tb_true;
-                // append key
-                else if (bstr) tb_static_string_chrcat(&kname, ch);
+                else if (ch == ':') bkey = tb_true;
             }
             // key ok? read val
             else
             {
                 // trace
-                tb_trace_d("key: %s", tb_static_string_cstr(&kname));
+                tb_trace_d("key: %s", tb_string_size(&kname)? tb_string_cstr(&kname) : "");
 
                 // the func
                 tb_object_json_reader_func_t func = tb_object_json_reader_func(ch);
@@ -446,13 +467,13 @@ static tb_object_ref_t tb_object_json_reader_func_dictionary(tb_object_json_read
                 tb_object_ref_t val = func(reader, ch);
                 tb_assert_and_check_break_state(val, ok, tb_false);
 
-                // set key => val
-                tb_object_dictionary_insert(dictionary, tb_static_string_cstr(&kname), val);
+                // set key => val, the empty key is null for tb_string_cstr()
+                tb_char_t const* key = tb_string_cstr(&kname);
+                tb_object_dictionary_insert(dictionary, key? key : "", val);
 
                 // reset key
-                bstr = 0;
                 bkey = tb_false;
-                tb_static_string_clear(&kname);
+                tb_string_clear(&kname);
             }
         }
     }
@@ -466,7 +487,7 @@ static tb_object_ref_t tb_object_json_reader_func_dictionary(tb_object_json_read
     }
 
     // exit key name
-    tb_static_string_exit(&kname);
+    tb_string_exit(&kname);
 
     // ok?
     return dictionary;
@@ -387,7 +387,7 @@ static tb_object_ref_t tb_object_xml_reader_func_number(tb_object_xml_reader_t*
                 for (; *p; p++)
                 {
                     if (!s && *p == '-') s = 1;
-                    if (!f && *p == '.') f = 1;
+                    if (!f && (*p == '.' || *p == 'e' || *p == 'E')) f = 1;
                     if (s && f) break;
                 }
                 
@@ -0,0 +1,568 @@
+/*!The Treasure Box Library
+ *
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox;
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ *
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        records.c
+ * @ingroup     object
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME        "object_records"
+#define TB_TRACE_MODULE_DEBUG       (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "records.h"
+#include "reader/reader.h"
+#include "../../stream/stream.h"
+#include "../../platform/platform.h"
+#include "../../algorithm/algorithm.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the chunk size
+#ifdef __tb_small__
+#   define TB_OBJECT_RECORDS_CHUNK_SIZE         (256 * 1024)
+#else
+#   define TB_OBJECT_RECORDS_CHUNK_SIZE         (1024 * 1024)
+#endif
+
+// the chunks maxn in flight
+#define TB_OBJECT_RECORDS_CHUNK_MAXN            (16)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the chunk state enum
+typedef enum __tb_object_records_chunk_state_e
+{
+    TB_OBJECT_RECORDS_CHUNK_STATE_IDLE      = 0
+,   TB_OBJECT_RECORDS_CHUNK_STATE_POSTED    = 1
+,   TB_OBJECT_RECORDS_CHUNK_STATE_FINISHED  = 2
+
+}tb_object_records_chunk_state_e;
+
+// the records type
+struct __tb_object_records_t;
+
+// the records chunk type
+typedef struct __tb_object_records_chunk_t
+{
+    // the chunk data
+    tb_byte_t const*                data;
+
+    // the chunk size
+    tb_size_t                       size;
+
+    // the chunk buffer for reading the stream
+    tb_byte_t*                      buff;
+
+    // the chunk buffer maxn
+    tb_size_t                       maxn;
+
+    // the parsed objects for the ordered records
+    tb_object_ref_t                 objects;
+
+    // the records count, -1 if failed
+    tb_long_t                       count;
+
+    // the chunk state
+    tb_atomic_t                     state;
+
+    // the records
+    struct __tb_object_records_t*   records;
+
+}tb_object_records_chunk_t;
+
+// the records type
+typedef struct __tb_object_records_t
+{
+    // the format
+    tb_size_t                       format;
+
+    // the reader
+    tb_object_reader_t*             reader;
+
+    // pass the records in order?
+    tb_bool_t                       ordered;
+
+    // the record func
+    tb_object_record_func_t         func;
+
+    // the user private data
+    tb_cpointer_t                   priv;
+
+    // stop it?
+    tb_atomic_t                     stop;
+
+    // the finished semaphore
+    tb_semaphore_ref_t              semaphore;
+
+    // the posted tasks count
+    tb_size_t                       posted;
+
+    // the waited tasks count
+    tb_size_t                       waited;
+
+    // the incomplete record data left by the previous chunk of the stream
+    tb_byte_t*                      carry;
+
+    // the carry size
+    tb_size_t                       carry_size;
+
+    // the carry maxn
+    tb_size_t                       carry_maxn;
+
+    // the chunks
+    tb_object_records_chunk_t       chunks[TB_OBJECT_RECORDS_CHUNK_MAXN];
+
+}tb_object_records_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_byte_t const* tb_object_records_find(tb_byte_t const* p, tb_byte_t const* e, tb_char_t const* s, tb_size_t n)
+{
+    // find it and return the end of the found string
+    tb_byte_t const* q = p < e? (tb_byte_t const*)tb_memmem(p, e - p, s, n) : tb_null;
+    return q? q + n : tb_null;
+}
+static tb_byte_t const* tb_object_records_next_xml(tb_byte_t const* p, tb_byte_t const* e)
+{
+    // walk the tags and return the end of the first top-level element
+    tb_long_t depth = 0;
+    while (p < e)
+    {
+        // the next tag
+        p = (tb_byte_t const*)tb_memmem(p, e - p, "<", 1);
+        tb_check_return_val(p && p + 1 < e, tb_null);
+
+        // comment, cdata, doctype or instruction?
+        if (p[1] == '!' || p[1] == '?')
+        {
+            if (p[1] == '?') p = tb_object_records_find(p + 2, e, "?>", 2);
+            else if (e - p >= 4 && !tb_strncmp((tb_char_t const*)p, "<!--", 4)) p = tb_object_records_find(p + 4, e, "-->", 3);
+            else if (e - p >= 9 && !tb_strncmp((tb_char_t const*)p, "<![CDATA[", 9)) p = tb_object_records_find(p + 9, e, "]]>", 3);
+            else p = tb_object_records_find(p + 2, e, ">", 1);
+            tb_check_return_val(p, tb_null);
+            continue;
+        }
+
+        // end tag?
+        if (p[1] == '/')
+        {
+            p = tb_object_records_find(p + 2, e, ">", 1);
+            tb_check_return_val(p, tb_null);
+
+            // the top-level element end?
+            if (--depth <= 0) return p;
+            continue;
+        }
+
+        // find the end of the start tag, the quoted attribute values may contain '>'
+        tb_byte_t quote = 0;
+        for (p++; p < e && (quote || *p != '>'); p++)
+        {
+            if (quote) { if (*p == quote) quote = 0; }
+            else if (*p == '\"' || *p == '\'') quote = *p;
+        }
+        tb_check_return_val(p < e, tb_null);
+
+        // empty element?
+        if (p[-1] == '/')
+        {
+            if (!depth) return p + 1;
+        }
+        else depth++;
+        p++;
+    }
+    return tb_null;
+}
+static tb_byte_t const* tb_object_records_next(tb_size_t format, tb_byte_t const* p, tb_byte_t const* e)
+{
+    // the newline-delimited json record
+    if (format == TB_OBJECT_FORMAT_JSON) return tb_object_records_find(p, e, "\n", 1);
+
+    // the top-level xml record
+    return tb_object_records_next_xml(p, e);
+}
+static tb_size_t tb_object_records_split(tb_size_t format, tb_byte_t const* data, tb_size_t size, tb_size_t target)
+{
+    // check
+    tb_assert(target && target <= size);
+
+    // find the last newline before the target for json
+    tb_byte_t const* e = data + size;
+    if (format == TB_OBJECT_FORMAT_JSON)
+    {
+        tb_byte_t const* p = data + target;
+        while (p > data && p[-1] != '\n') p--;
+        if (p > data) return p - data;
+
+        // find the first newline after the target
+        p = tb_object_records_find(data + target, e, "\n", 1);
+        return p? p - data : 0;
+    }
+
+    // walk the xml records until the target
+    tb_byte_t const* p = data;
+    tb_byte_t const* q = tb_null;
+    while ((q = tb_object_records_next_xml(p, e)))
+    {
+        // the first record after the target?
+        if (q - data > target) return p > data? p - data : q - data;
+
+        // the next record
+        p = q;
+        if (p - data == target) break;
+    }
+    return p - data;
+}
+static tb_void_t tb_object_records_chunk_done(tb_object_records_chunk_t* chunk)
+{
+    // check
+    tb_object_records_t* records = chunk->records;
+    tb_assert(records && records->reader && records->reader->read);
+
+    // init stream
+    tb_long_t       count = 0;
+    tb_stream_ref_t stream = tb_stream_init_from_data(chunk->data, chunk->size);
+    if (!stream) count = -1;
+
+    // parse records
+    tb_byte_t const*    p = chunk->data;
+    tb_byte_t const*    e = chunk->data + chunk->size;
+    while (stream && p < e && !tb_atomic_get(&records->stop))
+    {
+        // the record
+        tb_byte_t const* q = tb_object_records_next(records->format, p, e);
+        if (!q) q = e;
+
+        // skip spaces and empty records
+        while (p < q && tb_isspace(*p)) p++;
+        if (p == q) continue;
+
+        // read object from the record
+        tb_object_ref_t object = tb_null;
+        if (tb_stream_is_opened(stream)) tb_stream_clos(stream);
+        if (tb_stream_ctrl(stream, TB_STREAM_CTRL_DATA_SET_DATA, p, (tb_size_t)(q - p)) && tb_stream_open(stream))
+            object = records->reader->read(stream);
+
+        // failed?
+        if (!object)
+        {
+            // trace
+            tb_trace_d("read record failed at chunk: %p, offset: %lu", chunk->data, p - chunk->data);
+
+            // stop all chunks
+            tb_atomic_set(&records->stop, 1);
+            count = -1;
+            break;
+        }
+
+        // pass it in order later
+        if (records->ordered) tb_object_array_append(chunk->objects, object);
+        // pass it now
+        else
+        {
+            if (!records->func(object, records->priv)) tb_atomic_set(&records->stop, 1);
+            tb_object_exit(object);
+        }
+        count++;
+
+        // the next record
+        p = q;
+    }
+
+    // exit stream
+    if (stream) tb_stream_exit(stream);
+
+    // save count
+    chunk->count = count;
+}
+#ifdef TB_CONFIG_MODULE_HAVE_THREAD
+static tb_void_t tb_object_records_chunk_task(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // the chunk
+    tb_object_records_chunk_t* chunk = (tb_object_records_chunk_t*)priv;
+    tb_assert_and_check_return(chunk && chunk->records);
+
+    // the semaphore
+    tb_semaphore_ref_t semaphore = chunk->records->semaphore;
+
+    // done it
+    tb_object_records_chunk_done(chunk);
+
+    // finished
+    tb_atomic_set(&chunk->state, TB_OBJECT_RECORDS_CHUNK_STATE_FINISHED);
+    tb_semaphore_post(semaphore, 1);
+}
+#endif
+static tb_void_t tb_object_records_chunk_post(tb_object_records_chunk_t* chunk)
+{
+    // check
+    tb_object_records_t* records = chunk->records;
+    tb_assert(records);
+
+    // post it to the thread pool
+    tb_atomic_set(&chunk->state, TB_OBJECT_RECORDS_CHUNK_STATE_POSTED);
+#ifdef TB_CONFIG_MODULE_HAVE_THREAD
+    tb_thread_pool_ref_t pool = records->semaphore? tb_thread_pool() : tb_null;
+    if (pool && tb_thread_pool_task_post(pool, "object_records", tb_object_records_chunk_task, tb_null, chunk, tb_false))
+    {
+        records->posted++;
+        return ;
+    }
+#endif
+
+    // done it directly
+    tb_object_records_chunk_done(chunk);
+    tb_atomic_set(&chunk->state, TB_OBJECT_RECORDS_CHUNK_STATE_FINISHED);
+}
+static tb_long_t tb_object_records_chunk_wait(tb_object_records_chunk_t* chunk)
+{
+    // check
+    tb_object_records_t* records = chunk->records;
+    tb_assert(records);
+
+    // wait it
+    while (tb_atomic_get(&chunk->state) == TB_OBJECT_RECORDS_CHUNK_STATE_POSTED)
+    {
+        if (!records->semaphore || tb_semaphore_wait(records->semaphore, -1) < 0) break;
+        records->waited++;
+    }
+    tb_assert_and_check_return_val(tb_atomic_get(&chunk->state) == TB_OBJECT_RECORDS_CHUNK_STATE_FINISHED, -1);
+
+    // pass the ordered records
+    tb_long_t count = chunk->count;
+    if (records->ordered && chunk->objects)
+    {
+        tb_for_all (tb_object_ref_t, object, tb_object_array_itor(chunk->objects))
+        {
+            if (tb_atomic_get(&records->stop)) break;
+            if (object && !records->func(object, records->priv)) tb_atomic_set(&records->stop, 1);
+        }
+        tb_object_clear(chunk->objects);
+    }
+
+    // idle now
+    tb_atomic_set(&chunk->state, TB_OBJECT_RECORDS_CHUNK_STATE_IDLE);
+    return count;
+}
+static tb_long_t tb_object_records_read(tb_stream_ref_t stream, tb_byte_t* data, tb_size_t size)
+{
+    // read data until the end of stream
+    tb_size_t read = 0;
+    while (read < size)
+    {
+        // read data
+        tb_long_t real = tb_stream_read(stream, data + read, size - read);
+        if (real > 0) read += real;
+        else if (!real)
+        {
+            // wait
+            real = tb_stream_wait(stream, TB_STREAM_WAIT_READ, tb_stream_timeout(stream));
+            tb_check_break(real > 0);
+        }
+        else break;
+    }
+    return read;
+}
+static tb_bool_t tb_object_records_fill_stream(tb_object_records_t* records, tb_object_records_chunk_t* chunk, tb_stream_ref_t stream)
+{
+    // init buffer
+    if (chunk->maxn < TB_OBJECT_RECORDS_CHUNK_SIZE || chunk->maxn < records->carry_size)
+    {
+        chunk->maxn = tb_max(TB_OBJECT_RECORDS_CHUNK_SIZE, records->carry_size << 1);
+        chunk->buff = (tb_byte_t*)tb_ralloc(chunk->buff, chunk->maxn);
+        tb_assert_and_check_return_val(chunk->buff, tb_false);
+    }
+
+    // fill the carry data first
+    tb_size_t size = records->carry_size;
+    if (size) tb_memcpy(chunk->buff, records->carry, size);
+    records->carry_size = 0;
+
+    // fill the chunk until one record at least
+    tb_size_t end = 0;
+    while (1)
+    {
+        // read data
+        tb_size_t read = tb_object_records_read(stream, chunk->buff + size, chunk->maxn - size);
+        size += read;
+
+        // end of stream? pass all data
+        if (size < chunk->maxn)
+        {
+            end = size;
+            break;
+        }
+
+        // split it at the last record
+        end = tb_object_records_split(records->format, chunk->buff, size, size);
+        tb_check_break(!end);
+
+        // too large record? grow the buffer
+        chunk->maxn <<= 1;
+        chunk->buff = (tb_byte_t*)tb_ralloc(chunk->buff, chunk->maxn);
+        tb_assert_and_check_return_val(chunk->buff, tb_false);
+    }
+
+    // save the carry data
+    if (end < size)
+    {
+        if (records->carry_maxn < size - end)
+        {
+            records->carry_maxn = tb_max(size - end, TB_OBJECT_RECORDS_CHUNK_SIZE);
+            records->carry = (tb_byte_t*)tb_ralloc(records->carry, records->carry_maxn);
+            tb_assert_and_check_return_val(records->carry, tb_false);
+        }
+        tb_memcpy(records->carry, chunk->buff + end, size - end);
+        records->carry_size = size - end;
+    }
+
+    // save chunk
+    chunk->data = chunk->buff;
+    chunk->size = end;
+    return end? tb_true : tb_false;
+}
+static tb_bool_t tb_object_records_fill_data(tb_object_records_t* records, tb_object_records_chunk_t* chunk, tb_byte_t const** pdata, tb_byte_t const* tail)
+{
+    // no data?
+    tb_byte_t const* data = *pdata;
+    tb_check_return_val(data < tail, tb_false);
+
+    // split it at the record near the chunk size
+    tb_size_t left = tail - data;
+    tb_size_t size = left <= TB_OBJECT_RECORDS_CHUNK_SIZE? left : tb_object_records_split(records->format, data, left, TB_OBJECT_RECORDS_CHUNK_SIZE);
+    if (!size) size = left;
+
+    // save chunk
+    chunk->data = data;
+    chunk->size = size;
+    *pdata = data + size;
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+tb_long_t tb_object_records_done(tb_stream_ref_t stream, tb_byte_t const* data, tb_size_t size, tb_size_t format, tb_bool_t ordered, tb_object_record_func_t func, tb_cpointer_t priv)
+{
+    // check
+    format &= 0x00ff;
+    tb_assert_and_check_return_val((stream || data) && func, -1);
+    tb_assert_and_check_return_val(format == TB_OBJECT_FORMAT_JSON || format == TB_OBJECT_FORMAT_XML || format == TB_OBJECT_FORMAT_XPLIST, -1);
+
+    // the reader
+    tb_object_reader_t* reader = tb_object_reader_get(format);
+    tb_assert_and_check_return_val(reader && reader->read, -1);
+
+    // init records
+    tb_object_records_t* records = tb_malloc0_type(tb_object_records_t);
+    tb_assert_and_check_return_val(records, -1);
+    records->format     = format;
+    records->reader     = reader;
+    records->ordered    = ordered;
+    records->func       = func;
+    records->priv       = priv;
+
+    // init semaphore for the thread pool, the chunks will be done directly if failed
+#ifdef TB_CONFIG_MODULE_HAVE_THREAD
+    records->semaphore  = tb_semaphore_init(0);
+#endif
+
+    // done
+    tb_bool_t           failed = tb_false;
+    tb_long_t           count = 0;
+    tb_size_t           head = 0;
+    tb_size_t           busy = 0;
+    tb_byte_t const*    tail = data + size;
+    while (!failed)
+    {
+        // the chunk
+        tb_object_records_chunk_t* chunk = &records->chunks[(head + busy) % TB_OBJECT_RECORDS_CHUNK_MAXN];
+
+        // all chunks are busy? wait the oldest chunk
+        if (busy == TB_OBJECT_RECORDS_CHUNK_MAXN || tb_atomic_get(&records->stop))
+        {
+            tb_check_break(busy);
+            tb_long_t real = tb_object_records_chunk_wait(&records->chunks[head]);
+            if (real >= 0) count += real;
+            else failed = tb_true;
+            head = (head + 1) % TB_OBJECT_RECORDS_CHUNK_MAXN;
+            busy--;
+            continue;
+        }
+
+        // init chunk
+        chunk->records = records;
+        if (ordered && !chunk->objects)
+        {
+            chunk->objects = tb_object_array_init(0, tb_false);
+            tb_assert_and_check_break_state(chunk->objects, failed, tb_true);
+        }
+
+        // fill chunk
+        if (stream)
+        {
+            if (!tb_object_records_fill_stream(records, chunk, stream)) break;
+        }
+        else if (!tb_object_records_fill_data(records, chunk, &data, tail)) break;
+
+        // post chunk
+        tb_object_records_chunk_post(chunk);
+        busy++;
+    }
+
+    // wait the left chunks
+    while (busy)
+    {
+        tb_long_t real = tb_object_records_chunk_wait(&records->chunks[head]);
+        if (real >= 0) count += real;
+        else failed = tb_true;
+        head = (head + 1) % TB_OBJECT_RECORDS_CHUNK_MAXN;
+        busy--;
+    }
+
+    // wait the left semaphore posts before exiting it
+    while (records->semaphore && records->waited < records->posted && tb_semaphore_wait(records->semaphore, -1) >= 0) records->waited++;
+
+    // exit chunks
+    tb_size_t i = 0;
+    for (i = 0; i < TB_OBJECT_RECORDS_CHUNK_MAXN; i++)
+    {
+        if (records->chunks[i].objects) tb_object_exit(records->chunks[i].objects);
+        if (records->chunks[i].buff) tb_free(records->chunks[i].buff);
+    }
+
+    // exit records
+    if (records->carry) tb_free(records->carry);
+    if (records->semaphore) tb_semaphore_exit(records->semaphore);
+    tb_free(records);
+
+    // ok?
+    return failed? -1 : count;
+}
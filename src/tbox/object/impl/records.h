@@ -0,0 +1,62 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        records.h
+ * @ingroup     object
+ *
+ */
+#ifndef TB_OBJECT_IMPL_RECORDS_H
+#define TB_OBJECT_IMPL_RECORDS_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! done the records reader
+ *
+ * read the records from the stream if the stream is not null, otherwise read them from the data
+ *
+ * @param stream    the stream
+ * @param data      the data
+ * @param size      the data size
+ * @param format    the records format
+ * @param ordered   pass the records in order?
+ * @param func      the record func
+ * @param priv      the user private data
+ *
+ * @return          the records count, -1 if failed
+ */
+tb_long_t           tb_object_records_done(tb_stream_ref_t stream, tb_byte_t const* data, tb_size_t size, tb_size_t format, tb_bool_t ordered, tb_object_record_func_t func, tb_cpointer_t priv);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -34,6 +34,7 @@
 #include "bplist.h"
 #include "writer.h"
 #include "../../../algorithm/algorithm.h"
+#include "../../../container/element/hash.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -65,6 +66,13 @@ do { \
 #   define TB_OBJECT_BPLIST_LIST_GROW           (256)
 #endif
 
+// the offsets maxn in memory, spill the others to the temporary file
+#ifdef __tb_small__
+#   define TB_OBJECT_BPLIST_OFFSETS_MAXN        (8192)
+#else
+#   define TB_OBJECT_BPLIST_OFFSETS_MAXN        (65536)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -89,6 +97,75 @@ typedef enum __tb_object_bplist_type_e
 
 }tb_object_bplist_type_e;
 
+// the bplist leaf type, the equal leaves are only written once
+typedef struct __tb_object_bplist_leaf_t
+{
+    // the object type, number: the number type << 8
+    tb_size_t                   type;
+
+    // the data size
+    tb_size_t                   size;
+
+    // the data, string and data
+    tb_cpointer_t               data;
+
+    // the value, number, date and boolean
+    tb_uint64_t                 value;
+
+}tb_object_bplist_leaf_t;
+
+// the bplist entry type
+typedef struct __tb_object_bplist_entry_t
+{
+    // the object
+    tb_object_ref_t             object;
+
+    // the dictionary key, writ the key string if be not null
+    tb_char_t const*            key;
+
+}tb_object_bplist_entry_t;
+
+// the bplist builder type
+typedef struct __tb_object_bplist_builder_t
+{
+    // the leaves, leaf => index + 1
+    tb_hash_map_ref_t           leaves;
+
+    // the shared objects, object => index + 1
+    tb_hash_map_ref_t           shared;
+
+    // the objects queue
+    tb_queue_ref_t              queue;
+
+    // the object count
+    tb_size_t                   count;
+
+    // the index tables of the current container
+    tb_buffer_t                 refs;
+
+    // the key object
+    tb_object_ref_t             key;
+
+    // the offsets
+    tb_uint64_t*                offsets;
+
+    // the offsets size
+    tb_size_t                   offsets_size;
+
+    // the offsets maxn
+    tb_size_t                   offsets_maxn;
+
+    // the spill file
+    tb_file_ref_t               spill;
+
+    // the spilled offsets size
+    tb_size_t                   spill_size;
+
+    // the spill file path
+    tb_char_t                   spill_path[TB_PATH_MAXN];
+
+}tb_object_bplist_builder_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * declaration
  */
@@ -175,11 +252,11 @@ static tb_bool_t tb_object_bplist_writer_func_array(tb_object_bplist_writer_t* w
     tb_assert_and_check_return_val(writer && writer->stream && object, tb_false);
 
     // index tables
-    tb_byte_t* index_tables = (tb_byte_t*)tb_object_getp(object);
+    tb_byte_t const* index_tables = writer->refs;
 
     // size
-    tb_size_t size = tb_object_array_size(object);
-    tb_assert_and_check_return_val(!size == !index_tables, tb_false);
+    tb_size_t size = writer->refn;
+    tb_assert_and_check_return_val(!size || index_tables, tb_false);
 
     // writ flag
     tb_uint8_t flag = TB_OBJECT_BPLIST_TYPE_ARRAY | (size < 15 ? (tb_uint8_t)size : 0xf);
@@ -204,7 +281,7 @@ static tb_bool_t tb_object_bplist_writer_func_array(tb_object_bplist_writer_t* w
     }
 
     // writ index tables
-    if (index_tables)
+    if (size)
     {
         if (!tb_stream_bwrit(writer->stream, index_tables, size * item_size)) return tb_false;
     }
@@ -333,6 +410,14 @@ static tb_bool_t tb_object_bplist_writer_func_number(tb_object_bplist_writer_t*
     // ok
     return tb_true;
 }
+static tb_bool_t tb_object_bplist_writer_func_null(tb_object_bplist_writer_t* writer, tb_object_ref_t object, tb_size_t item_size)
+{
+    // check
+    tb_assert_and_check_return_val(writer && writer->stream && object, tb_false);
+
+    // writ it
+    return tb_stream_bwrit_u8(writer->stream, TB_OBJECT_BPLIST_TYPE_NONE);
+}
 static tb_bool_t tb_object_bplist_writer_func_boolean(tb_object_bplist_writer_t* writer, tb_object_ref_t object, tb_size_t item_size)
 {
     // check
@@ -347,11 +432,11 @@ static tb_bool_t tb_object_bplist_writer_func_dictionary(tb_object_bplist_writer
     tb_assert_and_check_return_val(writer && writer->stream && object, tb_false);
 
     // index tables
-    tb_byte_t* index_tables = (tb_byte_t*)tb_object_getp(object);
+    tb_byte_t const* index_tables = writer->refs;
 
     // size
-    tb_size_t size = tb_object_dictionary_size(object);
-    tb_assert_and_check_return_val(!size == !index_tables, tb_false);
+    tb_size_t size = writer->refn;
+    tb_assert_and_check_return_val(!size || index_tables, tb_false);
 
     // writ flag
     tb_uint8_t flag = TB_OBJECT_BPLIST_TYPE_DICT | (size < 15 ? (tb_uint8_t)size : 0xf);
@@ -376,7 +461,7 @@ static tb_bool_t tb_object_bplist_writer_func_dictionary(tb_object_bplist_writer
     }
 
     // writ index tables
-    if (index_tables)
+    if (size)
     {
         if (!tb_stream_bwrit(writer->stream, index_tables, (size << 1) * item_size)) return tb_false;
     }
@@ -384,13 +469,96 @@ static tb_bool_t tb_object_bplist_writer_func_dictionary(tb_object_bplist_writer
     // ok
     return tb_true;
 }
-static tb_uint64_t tb_object_bplist_writer_builder_maxn(tb_object_ref_t object)
+static tb_size_t tb_object_bplist_writer_leaf_hash(tb_element_ref_t element, tb_cpointer_t data, tb_size_t mask, tb_size_t index)
+{
+    // check
+    tb_object_bplist_leaf_t const* leaf = (tb_object_bplist_leaf_t const*)data;
+    tb_assert_and_check_return_val(element && leaf, 0);
+
+    // hash the data or value with the leaf type
+    return leaf->size? tb_element_hash_data((tb_byte_t const*)leaf->data, leaf->size, element->seed ^ leaf->type, mask, index)
+                     : tb_element_hash_data((tb_byte_t const*)&leaf->value, sizeof(leaf->value), element->seed ^ leaf->type, mask, index);
+}
+static tb_long_t tb_object_bplist_writer_leaf_comp(tb_element_ref_t element, tb_cpointer_t ldata, tb_cpointer_t rdata)
+{
+    // check
+    tb_object_bplist_leaf_t const* lleaf = (tb_object_bplist_leaf_t const*)ldata;
+    tb_object_bplist_leaf_t const* rleaf = (tb_object_bplist_leaf_t const*)rdata;
+    tb_assert_and_check_return_val(lleaf && rleaf, 0);
+
+    // comp type and size
+    if (lleaf->type != rleaf->type) return lleaf->type > rleaf->type? 1 : -1;
+    if (lleaf->size != rleaf->size) return lleaf->size > rleaf->size? 1 : -1;
+
+    // comp data or value
+    if (lleaf->size) return tb_memcmp(lleaf->data, rleaf->data, lleaf->size);
+    return lleaf->value == rleaf->value? 0 : (lleaf->value > rleaf->value? 1 : -1);
+}
+static tb_bool_t tb_object_bplist_writer_leaf_init(tb_object_bplist_leaf_t* leaf, tb_object_ref_t object, tb_char_t const* key)
+{
+    // init leaf
+    tb_memset(leaf, 0, sizeof(tb_object_bplist_leaf_t));
+
+    // the dictionary key?
+    if (key)
+    {
+        leaf->type = TB_OBJECT_TYPE_STRING;
+        leaf->data = key;
+        leaf->size = tb_strlen(key);
+        return tb_true;
+    }
+
+    // the leaf value
+    leaf->type = tb_object_type(object);
+    switch (leaf->type)
+    {
+    case TB_OBJECT_TYPE_STRING:
+        leaf->data = tb_object_string_cstr(object);
+        leaf->size = leaf->data? tb_object_string_size(object) : 0;
+        break;
+    case TB_OBJECT_TYPE_DATA:
+        leaf->data = tb_object_data_getp(object);
+        leaf->size = leaf->data? tb_object_data_size(object) : 0;
+        break;
+    case TB_OBJECT_TYPE_NUMBER:
+        {
+            // the number type is written too, 1 and 1.0 are different
+            tb_size_t type = tb_object_number_type(object);
+            leaf->type |= type << 8;
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+            if (type == TB_NUMBER_TYPE_FLOAT || type == TB_NUMBER_TYPE_DOUBLE)
+            {
+                tb_double_t value = tb_object_number_double(object);
+                tb_memcpy(&leaf->value, &value, sizeof(value));
+            }
+            else
+#endif
+            leaf->value = tb_object_number_uint64(object);
+        }
+        break;
+    case TB_OBJECT_TYPE_DATE:
+        leaf->value = (tb_uint64_t)tb_object_date_time(object);
+        break;
+    case TB_OBJECT_TYPE_BOOLEAN:
+        leaf->value = tb_object_boolean_bool(object);
+        break;
+    case TB_OBJECT_TYPE_NULL:
+        break;
+    default:
+        // not a leaf
+        return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_size_t tb_object_bplist_writer_maxn(tb_object_ref_t object)
 {
     // check
     tb_assert_and_check_return_val(object, 0);
 
     // walk
-    tb_uint64_t size = 0;
+    tb_size_t size = 0;
     switch (tb_object_type(object))
     {
     case TB_OBJECT_TYPE_ARRAY:
@@ -398,7 +566,7 @@ static tb_uint64_t tb_object_bplist_writer_builder_maxn(tb_object_ref_t object)
             // walk
             tb_for_all (tb_object_ref_t, item, tb_object_array_itor(object))
             {
-                if (item) size += tb_object_bplist_writer_builder_maxn(item);
+                if (item) size += tb_object_bplist_writer_maxn(item);
             }
         }
         break;
@@ -409,7 +577,7 @@ static tb_uint64_t tb_object_bplist_writer_builder_maxn(tb_object_ref_t object)
             {
                 // item
                 if (item && item->key && item->val)
-                    size += 1 + tb_object_bplist_writer_builder_maxn(item->val);
+                    size += 1 + tb_object_bplist_writer_maxn(item->val);
             }
         }
         break;
@@ -419,234 +587,408 @@ static tb_uint64_t tb_object_bplist_writer_builder_maxn(tb_object_ref_t object)
 
     return size + 1;
 }
-static tb_size_t tb_object_bplist_writer_builder_addo(tb_object_ref_t object, tb_object_ref_t list, tb_hash_map_ref_t hash)
+static tb_bool_t tb_object_bplist_writer_builder_init(tb_object_bplist_builder_t* builder, tb_size_t maxn)
 {
-    // check
-    tb_assert_and_check_return_val(object && list && hash, 0);
+    // init builder
+    tb_memset(builder, 0, sizeof(tb_object_bplist_builder_t));
 
-    // the object index
-    tb_size_t index = (tb_size_t)tb_hash_map_get(hash, object);
+    // the bucket size for the leaves, about eight objects per bucket
+    tb_size_t bucket_size = tb_align_pow2((maxn >> 3) + 1);
+    if (bucket_size < TB_HASH_MAP_BUCKET_SIZE_MICRO) bucket_size = TB_HASH_MAP_BUCKET_SIZE_MICRO;
+    if (bucket_size > TB_HASH_MAP_BUCKET_SIZE_LARGE) bucket_size = TB_HASH_MAP_BUCKET_SIZE_LARGE;
 
-    // new object?
-    if (!index) 
+    // init leaves, equal leaves are only written once
+    tb_element_t element = tb_element_mem(sizeof(tb_object_bplist_leaf_t), tb_null, tb_null);
+    element.hash = tb_object_bplist_writer_leaf_hash;
+    element.comp = tb_object_bplist_writer_leaf_comp;
+    builder->leaves = tb_hash_map_init(bucket_size, element, tb_element_size());
+    tb_assert_and_check_return_val(builder->leaves, tb_false);
+
+    // init shared objects, only for the retained objects
+    builder->shared = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, tb_element_ptr(tb_null, tb_null), tb_element_size());
+    tb_assert_and_check_return_val(builder->shared, tb_false);
+
+    // init queue
+    builder->queue = tb_queue_init(TB_OBJECT_BPLIST_LIST_GROW, tb_element_mem(sizeof(tb_object_bplist_entry_t), tb_null, tb_null));
+    tb_assert_and_check_return_val(builder->queue, tb_false);
+
+    // init refs
+    if (!tb_buffer_init(&builder->refs)) return tb_false;
+
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_object_bplist_writer_builder_exit(tb_object_bplist_builder_t* builder)
+{
+    // exit spill file
+    if (builder->spill)
     {
-        // append object
-        tb_object_array_append(list, object);
+        tb_file_exit(builder->spill);
+        tb_file_remove(builder->spill_path);
+        builder->spill = tb_null;
+    }
+
+    // exit offsets
+    if (builder->offsets) tb_free(builder->offsets);
+    builder->offsets = tb_null;
+
+    // exit key
+    if (builder->key) tb_object_exit(builder->key);
+    builder->key = tb_null;
+
+    // exit refs
+    tb_buffer_exit(&builder->refs);
 
-        // index
-        index = tb_object_array_size(list);
+    // exit queue
+    if (builder->queue) tb_queue_exit(builder->queue);
+    builder->queue = tb_null;
 
-        // set index
-        tb_hash_map_insert(hash, object, (tb_pointer_t)index);
-        tb_object_retain(object);
+    // exit shared
+    if (builder->shared) tb_hash_map_exit(builder->shared);
+    builder->shared = tb_null;
 
-        // check
-        tb_assert(!tb_object_getp(object));
+    // exit leaves
+    if (builder->leaves) tb_hash_map_exit(builder->leaves);
+    builder->leaves = tb_null;
+}
+static tb_size_t tb_object_bplist_writer_builder_index(tb_object_bplist_builder_t* builder, tb_object_ref_t object, tb_char_t const* key, tb_bool_t* is_new)
+{
+    // the saved index + 1
+    tb_size_t               index = 0;
+    tb_object_bplist_leaf_t leaf;
+    if (tb_object_bplist_writer_leaf_init(&leaf, object, key))
+    {
+        // find the equal leaf
+        index = (tb_size_t)tb_hash_map_get(builder->leaves, &leaf);
+        if (!index)
+        {
+            index = builder->count + 1;
+            tb_hash_map_insert(builder->leaves, &leaf, (tb_pointer_t)index);
+        }
+    }
+    // the shared object? only the retained object may be referenced twice
+    else if (tb_object_refn(object) > 1)
+    {
+        index = (tb_size_t)tb_hash_map_get(builder->shared, object);
+        if (!index)
+        {
+            index = builder->count + 1;
+            tb_hash_map_insert(builder->shared, object, (tb_pointer_t)index);
+        }
     }
 
-    // ok?
+    // the new object? the index is the next one
+    index = index? index - 1 : builder->count;
+    *is_new = (index == builder->count);
+    if (*is_new) builder->count++;
+
+    // ok
     return index;
 }
-static tb_void_t tb_object_bplist_writer_builder_init(tb_object_ref_t object, tb_object_ref_t list, tb_hash_map_ref_t hash, tb_size_t item_size)
+static tb_bool_t tb_object_bplist_writer_builder_spill(tb_object_bplist_builder_t* builder)
 {
-    // check
-    tb_assert_and_check_return(object && list && hash);
+    // no offsets?
+    tb_check_return_val(builder->offsets_size, tb_true);
 
-    // build items
-    switch (tb_object_type(object))
+    // init the spill file
+    if (!builder->spill)
     {
-    case TB_OBJECT_TYPE_ARRAY:
-        {
-            // make index tables
-            tb_byte_t*  index_tables = tb_null;
-            tb_size_t   size = tb_object_array_size(object);
-            if (size) 
-            {
-                index_tables = (tb_byte_t*)tb_object_getp(object);
-                if (!index_tables)
-                {
-                    // make it
-                    index_tables = tb_malloc0_bytes(size * item_size);
+        // make the temporary path
+        tb_size_t size = tb_directory_temporary(builder->spill_path, sizeof(builder->spill_path));
+        tb_assert_and_check_return_val(size && size < sizeof(builder->spill_path), tb_false);
+        tb_snprintf(builder->spill_path + size, sizeof(builder->spill_path) - size, "/_tbox_bplist_%p_%llx.offsets", builder, tb_uclock());
+
+        // open it
+        builder->spill = tb_file_init(builder->spill_path, TB_FILE_MODE_RW | TB_FILE_MODE_CREAT | TB_FILE_MODE_TRUNC | TB_FILE_MODE_BINARY);
+        tb_assert_and_check_return_val(builder->spill, tb_false);
+    }
 
-                    // FIXME: not using the user private data
-                    tb_object_setp(object, index_tables);
-                }
-            }
+    // writ the offsets
+    tb_byte_t const*    data = (tb_byte_t const*)builder->offsets;
+    tb_size_t           size = builder->offsets_size * sizeof(tb_uint64_t);
+    tb_size_t           writ = 0;
+    while (writ < size)
+    {
+        tb_long_t real = tb_file_pwrit(builder->spill, data + writ, size - writ, builder->spill_size * sizeof(tb_uint64_t) + writ);
+        tb_check_return_val(real > 0, tb_false);
+        writ += real;
+    }
 
-            // walk
-            tb_size_t i = 0;
-            tb_for_all (tb_object_ref_t, item, tb_object_array_itor(object))
-            {
-                // build item
-                if (item) 
-                {
-                    // add item to builder
-                    tb_size_t index = tb_object_bplist_writer_builder_addo(item, list, hash);
+    // update size
+    builder->spill_size  += builder->offsets_size;
+    builder->offsets_size = 0;
 
-                    // add index to tables
-                    if (index && index_tables) tb_object_bplist_writer_bits_set(index_tables + i++ * item_size, index - 1, item_size);
-//                  tb_trace_d("item: %p[%lu]", index_tables, index - 1);
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_object_bplist_writer_builder_offset(tb_object_bplist_builder_t* builder, tb_uint64_t offset)
+{
+    // full? spill them to the temporary file
+    if (builder->offsets_size >= builder->offsets_maxn && !tb_object_bplist_writer_builder_spill(builder)) return tb_false;
 
-                    // init next
-                    tb_object_bplist_writer_builder_init(item, list, hash, item_size);
-                }
-            }
+    // save offset
+    builder->offsets[builder->offsets_size++] = offset;
+    return tb_true;
+}
+static tb_bool_t tb_object_bplist_writer_offsets_writ(tb_stream_ref_t stream, tb_uint64_t const* offsets, tb_size_t count, tb_size_t offset_size)
+{
+    // writ offset table
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++)
+    {
+        switch (offset_size)
+        {
+        case 1:
+            if (!tb_stream_bwrit_u8(stream, (tb_uint8_t)offsets[i])) return tb_false;
+            break;
+        case 2:
+            if (!tb_stream_bwrit_u16_be(stream, (tb_uint16_t)offsets[i])) return tb_false;
+            break;
+        case 4:
+            if (!tb_stream_bwrit_u32_be(stream, (tb_uint32_t)offsets[i])) return tb_false;
+            break;
+        case 8:
+            if (!tb_stream_bwrit_u64_be(stream, (tb_uint64_t)offsets[i])) return tb_false;
+            break;
+        default:
+            tb_assert_and_check_return_val(0, tb_false);
+            break;
         }
-        break;
-    case TB_OBJECT_TYPE_DICTIONARY:
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_object_bplist_writer_builder_offsets(tb_object_bplist_builder_t* builder, tb_stream_ref_t stream, tb_size_t offset_size)
+{
+    // all offsets are in memory?
+    if (!builder->spill) return tb_object_bplist_writer_offsets_writ(stream, builder->offsets, builder->offsets_size, offset_size);
+
+    // spill the left offsets
+    if (!tb_object_bplist_writer_builder_spill(builder)) return tb_false;
+
+    // read and writ them again
+    tb_size_t read = 0;
+    while (read < builder->spill_size)
+    {
+        // read offsets
+        tb_size_t   count = tb_min(builder->spill_size - read, builder->offsets_maxn);
+        tb_byte_t*  data = (tb_byte_t*)builder->offsets;
+        tb_size_t   size = count * sizeof(tb_uint64_t);
+        tb_size_t   done = 0;
+        while (done < size)
+        {
+            tb_long_t real = tb_file_pread(builder->spill, data + done, size - done, read * sizeof(tb_uint64_t) + done);
+            tb_check_return_val(real > 0, tb_false);
+            done += real;
+        }
+
+        // writ them
+        if (!tb_object_bplist_writer_offsets_writ(stream, builder->offsets, count, offset_size)) return tb_false;
+        read += count;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_object_bplist_writer_builder_writ(tb_object_bplist_builder_t* builder, tb_object_bplist_writer_t* writer, tb_object_bplist_entry_t const* entry, tb_size_t item_size)
+{
+    // the dictionary key?
+    if (entry->key)
+    {
+        // writ empty
+        if (!*entry->key) return tb_object_bplist_writer_func_rdata(writer, TB_OBJECT_BPLIST_TYPE_STRING, tb_null, 0, item_size);
+
+        // init the key object
+        if (!builder->key) builder->key = tb_object_string_init_from_cstr(tb_null);
+        tb_assert_and_check_return_val(builder->key, tb_false);
+
+        // writ it
+        tb_object_string_cstr_set(builder->key, entry->key);
+        tb_object_bplist_writer_func_t func = tb_object_bplist_writer_func(TB_OBJECT_TYPE_STRING);
+        tb_assert_and_check_return_val(func, tb_false);
+        return func(writer, builder->key, item_size);
+    }
+
+    // the func
+    tb_object_bplist_writer_func_t func = tb_object_bplist_writer_func(tb_object_type(entry->object));
+    tb_assert_and_check_return_val(func, tb_false);
+
+    // writ object
+    return func(writer, entry->object, item_size);
+}
+/* walk the object tree by the breadth-first order
+ *
+ * the object indices are assigned when they are found at first time,
+ * so the objects are also written by the index order and the offsets can be saved sequentially.
+ *
+ * the first pass (writer: null) only counts the objects, so the item size can be decided by the final count.
+ * the second pass finds the objects by the same order and reuses the indices saved in the leaves and shared maps.
+ */
+static tb_bool_t tb_object_bplist_writer_builder_walk(tb_object_bplist_builder_t* builder, tb_object_bplist_writer_t* writer, tb_object_ref_t object, tb_size_t item_size)
+{
+    // add the root object
+    tb_bool_t                   is_new = tb_false;
+    tb_object_bplist_entry_t    entry = {object, tb_null};
+    builder->count = 0;
+    tb_object_bplist_writer_builder_index(builder, object, tb_null, &is_new);
+    tb_queue_put(builder->queue, &entry);
+
+    // walk it
+    while (!tb_queue_null(builder->queue))
+    {
+        // get the object
+        entry = *((tb_object_bplist_entry_t*)tb_queue_get(builder->queue));
+        tb_queue_pop(builder->queue);
+
+        // save offset
+        if (writer && !tb_object_bplist_writer_builder_offset(builder, tb_stream_offset(writer->stream))) return tb_false;
+
+        // the container type
+        tb_size_t type = entry.key? TB_OBJECT_TYPE_STRING : tb_object_type(entry.object);
+        if (type == TB_OBJECT_TYPE_ARRAY || type == TB_OBJECT_TYPE_DICTIONARY)
         {
             // make index tables
+            tb_size_t   n = 0;
             tb_byte_t*  index_tables = tb_null;
-            tb_size_t   size = tb_object_dictionary_size(object);
-            if (size) 
+            tb_size_t   size = type == TB_OBJECT_TYPE_ARRAY? tb_object_array_size(entry.object) : (tb_object_dictionary_size(entry.object) << 1);
+            if (writer && size)
             {
-                index_tables = (tb_byte_t*)tb_object_getp(object);
-                if (!index_tables)
-                {
-                    // make it
-                    index_tables = tb_malloc0_bytes((size << 1) * item_size);
-
-                    // FIXME: not using the user private data
-                    tb_object_setp(object, index_tables);
-                }
+                index_tables = tb_buffer_resize(&builder->refs, size * item_size);
+                tb_assert_and_check_return_val(index_tables, tb_false);
             }
 
-            // walk keys
+            // walk items
+            if (type == TB_OBJECT_TYPE_ARRAY)
             {
-                tb_size_t i = 0;
-                tb_for_all (tb_object_dictionary_item_t*, item, tb_object_dictionary_itor(object))
+                tb_for_all (tb_object_ref_t, item, tb_object_array_itor(entry.object))
                 {
-                    // item
-                    if (item && item->key && item->val)
+                    // add item
+                    if (item)
                     {
-                        // make key object
-                        tb_object_ref_t key = tb_object_string_init_from_cstr(item->key);
-                        if (key)
+                        // the item index
+                        tb_size_t index = tb_object_bplist_writer_builder_index(builder, item, tb_null, &is_new);
+                        if (index_tables) tb_object_bplist_writer_bits_set(index_tables + n * item_size, index, item_size);
+                        n++;
+
+                        // the new object? writ it later, only the containers are walked at the first pass
+                        tb_size_t itype = tb_object_type(item);
+                        if (is_new && (writer || itype == TB_OBJECT_TYPE_ARRAY || itype == TB_OBJECT_TYPE_DICTIONARY))
                         {
-                            // add key to builder
-                            tb_size_t index = tb_object_bplist_writer_builder_addo(key, list, hash);
-
-                            // add index to tables
-                            if (index && index_tables) tb_object_bplist_writer_bits_set(index_tables + i++ * item_size, index - 1, item_size);
-//                          tb_trace_d("keys: %p[%lu]", index_tables, index - 1);
-
-                            // build key
-                            tb_object_bplist_writer_builder_init(key, list, hash, item_size);
-                            tb_object_exit(key);
-
+                            tb_object_bplist_entry_t next = {item, tb_null};
+                            tb_queue_put(builder->queue, &next);
                         }
                     }
                 }
             }
-
-            // walk vals
+            else
             {
-                tb_size_t       i = 0;
-                tb_for_all (tb_object_dictionary_item_t*, item, tb_object_dictionary_itor(object))
+                // walk keys
                 {
-                    // item
-                    if (item && item->key && item->val)
+                    tb_for_all (tb_object_dictionary_item_t*, item, tb_object_dictionary_itor(entry.object))
                     {
-                        // add val to builder
-                        tb_size_t index = tb_object_bplist_writer_builder_addo(item->val, list, hash);
-
-                        // add index to tables
-                        if (index && index_tables) tb_object_bplist_writer_bits_set(index_tables + (size + i++) * item_size, index - 1, item_size);
-//                      tb_trace_d("vals: %p[%lu]", index_tables, index - 1);
-
-                        // build val
-                        tb_object_bplist_writer_builder_init(item->val, list, hash, item_size);
+                        // add key
+                        if (item && item->key && item->val)
+                        {
+                            // the key index
+                            tb_size_t index = tb_object_bplist_writer_builder_index(builder, item->val, item->key, &is_new);
+                            if (index_tables) tb_object_bplist_writer_bits_set(index_tables + n * item_size, index, item_size);
+                            n++;
+
+                            // the new key? writ it later
+                            if (is_new && writer)
+                            {
+                                tb_object_bplist_entry_t next = {item->val, item->key};
+                                tb_queue_put(builder->queue, &next);
+                            }
+                        }
                     }
                 }
-            }
-        }
-        break;
-    default:
-        break;
-    }
-}
-static tb_void_t tb_object_bplist_writer_builder_exit(tb_object_ref_t list, tb_hash_map_ref_t hash)
-{
-    // exit hash
-    if (hash)
-    {
-        // walk
-        tb_for_all (tb_hash_map_item_ref_t, item, hash)
-        {
-            // exit item
-            if (item && item->name)
-            {
-                tb_byte_t* priv = (tb_byte_t*)tb_object_getp((tb_object_ref_t)item->name);
-                if (priv)
+
+                // walk vals
                 {
-                    tb_free(priv);
-                    tb_object_setp((tb_object_ref_t)item->name, tb_null);
+                    tb_size_t i = 0;
+                    tb_for_all (tb_object_dictionary_item_t*, item, tb_object_dictionary_itor(entry.object))
+                    {
+                        // add val
+                        if (item && item->key && item->val)
+                        {
+                            // the val index
+                            tb_size_t index = tb_object_bplist_writer_builder_index(builder, item->val, tb_null, &is_new);
+                            if (index_tables) tb_object_bplist_writer_bits_set(index_tables + (n + i) * item_size, index, item_size);
+                            i++;
+
+                            // the new object? writ it later
+                            tb_size_t itype = tb_object_type(item->val);
+                            if (is_new && (writer || itype == TB_OBJECT_TYPE_ARRAY || itype == TB_OBJECT_TYPE_DICTIONARY))
+                            {
+                                tb_object_bplist_entry_t next = {item->val, tb_null};
+                                tb_queue_put(builder->queue, &next);
+                            }
+                        }
+                    }
+
+                    // check
+                    tb_assert_and_check_return_val(i == n, tb_false);
                 }
+            }
 
-                tb_object_exit((tb_object_ref_t)item->name);
+            // writ it
+            if (writer)
+            {
+                writer->refs = index_tables;
+                writer->refn = n;
+                tb_bool_t ok = tb_object_bplist_writer_builder_writ(builder, writer, &entry, item_size);
+                writer->refs = tb_null;
+                writer->refn = 0;
+                if (!ok) return tb_false;
             }
         }
-
-        // exit it
-        tb_hash_map_exit(hash);
+        // writ it
+        else if (writer && !tb_object_bplist_writer_builder_writ(builder, writer, &entry, item_size)) return tb_false;
     }
 
-    // exit list
-    if (list) tb_object_exit(list);
+    // ok
+    return tb_true;
 }
 static tb_long_t tb_object_bplist_writer_done(tb_stream_ref_t stream, tb_object_ref_t object, tb_bool_t deflate)
 {
     // check
     tb_assert_and_check_return_val(object && stream, -1);
 
-    // done 
-    tb_bool_t           ok                  = tb_false;
-    tb_size_t           i                   = 0;
-    tb_byte_t           pad[6]              = {0};
-    tb_object_ref_t     list                = tb_null;
-    tb_hash_map_ref_t       hash                = tb_null;
-    tb_size_t           object_count        = 0;
-    tb_uint64_t         object_maxn         = 0;
-    tb_uint64_t         root_object         = 0;
-    tb_uint64_t         offset_table_index  = 0;
-    tb_size_t           offset_size         = 0;
-    tb_size_t           item_size           = 0;
-    tb_uint64_t*        offsets             = tb_null;
-    tb_hize_t           bof                 = 0;
-    tb_hize_t           eof                 = 0;
+    // done
+    tb_bool_t                   ok                  = tb_false;
+    tb_byte_t                   pad[6]              = {0};
+    tb_size_t                   object_count        = 0;
+    tb_uint64_t                 root_object         = 0;
+    tb_uint64_t                 offset_table_index  = 0;
+    tb_size_t                   offset_size         = 0;
+    tb_size_t                   item_size           = 0;
+    tb_hize_t                   bof                 = 0;
+    tb_hize_t                   eof                 = 0;
+    tb_object_bplist_builder_t  builder;
     do
     {
         // init writer
         tb_object_bplist_writer_t writer = {0};
         writer.stream = stream;
-        
-        // init list
-        list = tb_object_array_init(TB_OBJECT_BPLIST_LIST_GROW, tb_true);
-        tb_assert_and_check_break(list);
-
-        // init hash
-        hash = tb_hash_map_init(0, tb_element_ptr(tb_null, tb_null), tb_element_uint32());
-        tb_assert_and_check_break(hash);
-
-        // object maxn
-        object_maxn = tb_object_bplist_writer_builder_maxn(object);
-        item_size   = tb_object_need_bytes(object_maxn);
-        tb_trace_d("object_maxn: %llu", object_maxn);
-        tb_trace_d("item_size: %lu", item_size);
 
-        // add root object to builder
-        tb_object_bplist_writer_builder_addo(object, list, hash);
+        // init builder
+        if (!tb_object_bplist_writer_builder_init(&builder, tb_object_bplist_writer_maxn(object))) break;
 
-        // init object builder
-        tb_object_bplist_writer_builder_init(object, list, hash, item_size);
+        // count the objects, the equal leaves are counted only once
+        if (!tb_object_bplist_writer_builder_walk(&builder, tb_null, object, 0)) break;
 
         // init object count
-        object_count = tb_object_array_size(list);
+        object_count = builder.count;
+        item_size    = tb_object_need_bytes(object_count);
         tb_trace_d("object_count: %lu", object_count);
+        tb_trace_d("item_size: %lu", item_size);
 
-        // init offsets
-        offsets = (tb_uint64_t*)tb_malloc0(object_count * sizeof(tb_uint64_t));
-        tb_assert_and_check_break(offsets);
+        // init offsets, spill them to the temporary file if too many
+        builder.offsets_maxn = tb_min(object_count, TB_OBJECT_BPLIST_OFFSETS_MAXN);
+        builder.offsets = (tb_uint64_t*)tb_malloc0(tb_max(builder.offsets_maxn, 1) * sizeof(tb_uint64_t));
+        tb_assert_and_check_break(builder.offsets);
 
         // the begin offset
         bof = tb_stream_offset(stream);
@@ -655,33 +997,8 @@ static tb_long_t tb_object_bplist_writer_done(tb_stream_ref_t stream, tb_object_
         if (!tb_stream_bwrit(stream, (tb_byte_t const*)"bplist00", 8)) break;
 
         // writ objects
-        if (object_count)
-        {
-            i = 0;
-            tb_bool_t failed = tb_false;
-            tb_for_all_if (tb_object_ref_t, item, tb_object_array_itor(list), item && !failed)
-            {
-                // check
-                tb_assert_and_check_break_state(i < object_count, failed, tb_true);
-
-                // save offset
-                offsets[i++] = tb_stream_offset(stream);
-
-                // the func
-                tb_object_bplist_writer_func_t func = tb_object_bplist_writer_func(tb_object_type(item));
-                tb_assert_and_check_continue(func);
-
-                // writ object
-                if (!func(&writer, item, item_size)) 
-                {
-                    failed = tb_true;
-                    break;
-                }
-            }
-
-            // failed?
-            tb_check_break(!failed);
-        }
+        if (!tb_object_bplist_writer_builder_walk(&builder, &writer, object, item_size)) break;
+        tb_assert_and_check_break(builder.count == object_count);
 
         // offset table index
         offset_table_index = tb_stream_offset(stream);
@@ -690,35 +1007,11 @@ static tb_long_t tb_object_bplist_writer_done(tb_stream_ref_t stream, tb_object_
         tb_trace_d("offset_size: %lu", offset_size);
 
         // writ offset table
-        tb_bool_t failed = tb_false;
-        for (i = 0; !failed && i < object_count; i++)
-        {
-            switch (offset_size)
-            {
-            case 1:
-                if (!tb_stream_bwrit_u8(stream, (tb_uint8_t)offsets[i])) failed = tb_true;
-                break;
-            case 2:
-                if (!tb_stream_bwrit_u16_be(stream, (tb_uint16_t)offsets[i])) failed = tb_true;
-                break;
-            case 4:
-                if (!tb_stream_bwrit_u32_be(stream, (tb_uint32_t)offsets[i])) failed = tb_true;
-                break;
-            case 8:
-                if (!tb_stream_bwrit_u64_be(stream, (tb_uint64_t)offsets[i])) failed = tb_true;
-                break;
-            default:
-                tb_assert_and_check_break_state(0, failed, tb_true);
-                break;
-            }
-        }
-
-        // failed?
-        tb_check_break(!failed);
+        if (!tb_object_bplist_writer_builder_offsets(&builder, stream, offset_size)) break;
 
         // writ pad, like apple?
         if (!tb_stream_bwrit(stream, pad, 6)) break;
-        
+
         // writ tail
         if (!tb_stream_bwrit_u8(stream, (tb_uint8_t)offset_size)) break;
         if (!tb_stream_bwrit_u8(stream, (tb_uint8_t)item_size)) break;
@@ -737,14 +1030,8 @@ static tb_long_t tb_object_bplist_writer_done(tb_stream_ref_t stream, tb_object_
 
     } while (0);
 
-    // exit offsets
-    if (offsets) tb_free(offsets);
-    offsets = tb_null;
-
-    // exit object builder
-    tb_object_bplist_writer_builder_exit(list, hash);
-    list = tb_null;
-    hash = tb_null;
+    // exit builder
+    tb_object_bplist_writer_builder_exit(&builder);
 
     // ok?
     return (ok && (eof >= bof))? (tb_long_t)(eof - bof) : -1;
@@ -766,6 +1053,7 @@ tb_object_writer_t* tb_object_bplist_writer()
     tb_assert_and_check_return_val(s_writer.hooker, tb_null);
 
     // hook writer 
+    tb_hash_map_insert(s_writer.hooker, (tb_pointer_t)TB_OBJECT_TYPE_NULL, tb_object_bplist_writer_func_null);
     tb_hash_map_insert(s_writer.hooker, (tb_pointer_t)TB_OBJECT_TYPE_DATE, tb_object_bplist_writer_func_date);
     tb_hash_map_insert(s_writer.hooker, (tb_pointer_t)TB_OBJECT_TYPE_DATA, tb_object_bplist_writer_func_data);
     tb_hash_map_insert(s_writer.hooker, (tb_pointer_t)TB_OBJECT_TYPE_ARRAY, tb_object_bplist_writer_func_array);
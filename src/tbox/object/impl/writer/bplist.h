@@ -44,6 +44,12 @@ typedef struct __tb_object_bplist_writer_t
     /// the stream
     tb_stream_ref_t              stream;
 
+    /// the reference indices of the current array or dictionary, dictionary: keys + vals
+    tb_byte_t const*             refs;
+
+    /// the reference count of the current array or dictionary, dictionary: the pair count
+    tb_size_t                    refn;
+
 }tb_object_bplist_writer_t;
 
 /// the bplist writer func type
@@ -0,0 +1,59 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        escape_arm.h
+ * @ingroup     object
+ *
+ */
+#ifndef TB_OBJECT_IMPL_WRITER_ESCAPE_ARM_H
+#define TB_OBJECT_IMPL_WRITER_ESCAPE_ARM_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include <arm_neon.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+
+// find the first json charactor need be escaped: '"', '\\' or < 0x20 with neon, the scanned position will be saved if not found
+static __tb_inline__ tb_byte_t const* tb_object_json_writer_escape_simd(tb_byte_t const** pdata, tb_byte_t const* e)
+{
+    // done, compare 16 bytes at once
+    tb_byte_t const*    p = *pdata;
+    uint8x16_t          vq = vdupq_n_u8('\"');
+    uint8x16_t          vb = vdupq_n_u8('\\');
+    uint8x16_t          vc = vdupq_n_u8(0x20);
+    for (; p + 16 <= e; p += 16)
+    {
+        // narrow the compared mask to 4 bits per byte
+        uint8x16_t  d = vld1q_u8(p);
+        uint8x16_t  c = vorrq_u8(vorrq_u8(vceqq_u8(d, vq), vceqq_u8(d, vb)), vcltq_u8(d, vc));
+        tb_uint64_t m = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(c), 4)), 0);
+        if (m) return p + (tb_bits_fb1_u64_le(m) >> 2);
+    }
+
+    // save the scanned position
+    *pdata = p;
+    return tb_null;
+}
+
+#endif
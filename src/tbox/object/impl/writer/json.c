@@ -34,17 +34,93 @@
 #include "json.h"
 #include "writer.h"
 #include "../../../algorithm/algorithm.h"
+#if defined(TB_ARCH_SSE2)
+#   include "escape_x86.h"
+#elif defined(TB_ARCH_ARM64) && defined(TB_ARCH_ARM_NEON)
+#   include "escape_arm.h"
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// enable the simd escape scanner?
+#if defined(TB_ARCH_SSE2) || (defined(TB_ARCH_ARM64) && defined(TB_ARCH_ARM_NEON))
+#   define TB_OBJECT_JSON_WRITER_SIMD_ENABLE
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
+static tb_bool_t tb_object_json_writer_escape(tb_stream_ref_t stream, tb_char_t const* data, tb_size_t size)
+{
+    // the hex digits
+    static tb_char_t const s_hex[] = "0123456789abcdef";
+
+    // writ '"'
+    if (!tb_object_writer_cstr(stream, "\"")) return tb_false;
+
+    // done
+    tb_byte_t const* b = (tb_byte_t const*)data;
+    tb_byte_t const* p = b;
+    tb_byte_t const* e = b + size;
+    while (p < e)
+    {
+        // find the next charactor need be escaped
+#ifdef TB_OBJECT_JSON_WRITER_SIMD_ENABLE
+        tb_byte_t const* q = tb_object_json_writer_escape_simd(&p, e);
+        if (q) p = q;
+        else
+#endif
+        {
+            while (p < e && *p != '\"' && *p != '\\' && *p >= 0x20) p++;
+            if (p == e) break;
+        }
+
+        // writ the normal charactors
+        if (p > b && !tb_stream_bwrit(stream, b, p - b)) return tb_false;
+
+        // writ the escaped charactor
+        tb_char_t   esc[8];
+        tb_size_t   n = 2;
+        esc[0] = '\\';
+        switch (*p)
+        {
+        case '\"':  esc[1] = '\"'; break;
+        case '\\': esc[1] = '\\'; break;
+        case '\b': esc[1] = 'b'; break;
+        case '\f': esc[1] = 'f'; break;
+        case '\n': esc[1] = 'n'; break;
+        case '\r': esc[1] = 'r'; break;
+        case '\t': esc[1] = 't'; break;
+        default:
+            esc[1] = 'u';
+            esc[2] = '0';
+            esc[3] = '0';
+            esc[4] = s_hex[*p >> 4];
+            esc[5] = s_hex[*p & 0xf];
+            n = 6;
+            break;
+        }
+        if (!tb_stream_bwrit(stream, (tb_byte_t const*)esc, n)) return tb_false;
+
+        // next
+        b = ++p;
+    }
+
+    // writ the left charactors
+    if (e > b && !tb_stream_bwrit(stream, b, e - b)) return tb_false;
+
+    // writ '"'
+    return tb_object_writer_cstr(stream, "\"");
+}
 static tb_bool_t tb_object_json_writer_func_null(tb_object_json_writer_t* writer, tb_object_ref_t object, tb_size_t level)
 {
     // check
     tb_assert_and_check_return_val(writer && writer->stream, tb_false);
 
     // writ
-    if (tb_stream_printf(writer->stream, "null") < 0) return tb_false;
+    if (!tb_object_writer_cstr(writer->stream, "null")) return tb_false;
     if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
 
     // ok
@@ -59,7 +135,7 @@ static tb_bool_t tb_object_json_writer_func_array(tb_object_json_writer_t* write
     if (tb_object_array_size(object))
     {
         // writ beg
-        if (tb_stream_printf(writer->stream, "[") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "[")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
 
         // walk
@@ -76,7 +152,7 @@ static tb_bool_t tb_object_json_writer_func_array(tb_object_json_writer_t* write
                 if (item_itor != item_head)
                 {
                     if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-                    if (tb_stream_printf(writer->stream, ",") < 0) return tb_false;
+                    if (!tb_object_writer_cstr(writer->stream, ",")) return tb_false;
                     if (!tb_object_writer_tab(writer->stream, writer->deflate, 1)) return tb_false;
                 }
                 else if (!tb_object_writer_tab(writer->stream, writer->deflate, level + 1)) return tb_false;
@@ -88,12 +164,12 @@ static tb_bool_t tb_object_json_writer_func_array(tb_object_json_writer_t* write
 
         // writ end
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "]") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "]")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
     }
     else 
     {
-        if (tb_stream_printf(writer->stream, "[]") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "[]")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
     }
 
@@ -106,11 +182,7 @@ static tb_bool_t tb_object_json_writer_func_string(tb_object_json_writer_t* writ
     tb_assert_and_check_return_val(writer && writer->stream, tb_false);
 
     // writ
-    if (tb_object_string_size(object))
-    {
-        if (tb_stream_printf(writer->stream, "\"%s\"", tb_object_string_cstr(object)) < 0) return tb_false;
-    }
-    else if (tb_stream_printf(writer->stream, "\"\"") < 0) return tb_false;
+    if (!tb_object_json_writer_escape(writer->stream, tb_object_string_cstr(object), tb_object_string_size(object))) return tb_false;
     if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
 
     // ok
@@ -125,44 +197,26 @@ static tb_bool_t tb_object_json_writer_func_number(tb_object_json_writer_t* writ
     switch (tb_object_number_type(object))
     {
     case TB_NUMBER_TYPE_UINT64:
-        if (tb_stream_printf(writer->stream, "%llu", tb_object_number_uint64(object)) < 0) return tb_false;
-        if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
-        break;
-    case TB_NUMBER_TYPE_SINT64:
-        if (tb_stream_printf(writer->stream, "%lld", tb_object_number_sint64(object)) < 0) return tb_false;
-        if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
-        break;
     case TB_NUMBER_TYPE_UINT32:
-        if (tb_stream_printf(writer->stream, "%u", tb_object_number_uint32(object)) < 0) return tb_false;
-        if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
-        break;
-    case TB_NUMBER_TYPE_SINT32:
-        if (tb_stream_printf(writer->stream, "%d", tb_object_number_sint32(object)) < 0) return tb_false;
-        if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
-        break;
     case TB_NUMBER_TYPE_UINT16:
-        if (tb_stream_printf(writer->stream, "%u", tb_object_number_uint16(object)) < 0) return tb_false;
-        if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
-        break;
-    case TB_NUMBER_TYPE_SINT16:
-        if (tb_stream_printf(writer->stream, "%d", tb_object_number_sint16(object)) < 0) return tb_false;
-        if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
-        break;
     case TB_NUMBER_TYPE_UINT8:
-        if (tb_stream_printf(writer->stream, "%u", tb_object_number_uint8(object)) < 0) return tb_false;
+        if (!tb_object_writer_uint64(writer->stream, tb_object_number_uint64(object))) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
+    case TB_NUMBER_TYPE_SINT64:
+    case TB_NUMBER_TYPE_SINT32:
+    case TB_NUMBER_TYPE_SINT16:
     case TB_NUMBER_TYPE_SINT8:
-        if (tb_stream_printf(writer->stream, "%d", tb_object_number_sint8(object)) < 0) return tb_false;
+        if (!tb_object_writer_sint64(writer->stream, tb_object_number_sint64(object))) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
     case TB_NUMBER_TYPE_FLOAT:
-        if (tb_stream_printf(writer->stream, "%f", tb_object_number_float(object)) < 0) return tb_false;
+        if (!tb_object_writer_float(writer->stream, tb_object_number_float(object))) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
     case TB_NUMBER_TYPE_DOUBLE:
-        if (tb_stream_printf(writer->stream, "%lf", tb_object_number_double(object)) < 0) return tb_false;
+        if (!tb_object_writer_double(writer->stream, tb_object_number_double(object))) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
 #endif
@@ -179,7 +233,11 @@ static tb_bool_t tb_object_json_writer_func_boolean(tb_object_json_writer_t* wri
     tb_assert_and_check_return_val(writer && writer->stream, tb_false);
 
     // writ
-    if (tb_stream_printf(writer->stream, "%s", tb_object_boolean_bool(object)? "true" : "false") < 0) return tb_false;
+    if (tb_object_boolean_bool(object))
+    {
+        if (!tb_object_writer_cstr(writer->stream, "true")) return tb_false;
+    }
+    else if (!tb_object_writer_cstr(writer->stream, "false")) return tb_false;
     if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
 
     // ok
@@ -194,7 +252,7 @@ static tb_bool_t tb_object_json_writer_func_dictionary(tb_object_json_writer_t*
     if (tb_object_dictionary_size(object))
     {
         // writ beg
-        if (tb_stream_printf(writer->stream, "{") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "{")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
 
         // walk
@@ -211,16 +269,17 @@ static tb_bool_t tb_object_json_writer_func_dictionary(tb_object_json_writer_t*
                 if (item_itor != item_head)
                 {
                     if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-                    if (tb_stream_printf(writer->stream, ",") < 0) return tb_false;
+                    if (!tb_object_writer_cstr(writer->stream, ",")) return tb_false;
                     if (!tb_object_writer_tab(writer->stream, writer->deflate, 1)) return tb_false;
                 }
                 else if (!tb_object_writer_tab(writer->stream, writer->deflate, level + 1)) return tb_false;
 
                 // writ key
-                if (tb_stream_printf(writer->stream, "\"%s\":", item->key) < 0) return tb_false;
+                if (!tb_object_json_writer_escape(writer->stream, item->key, tb_strlen(item->key))) return tb_false;
+                if (!tb_object_writer_cstr(writer->stream, ":")) return tb_false;
 
                 // writ spaces
-                if (!writer->deflate) if (tb_stream_printf(writer->stream, " ") < 0) return tb_false;
+                if (!writer->deflate) if (!tb_object_writer_cstr(writer->stream, " ")) return tb_false;
                 if (item->val->type == TB_OBJECT_TYPE_DICTIONARY || item->val->type == TB_OBJECT_TYPE_ARRAY)
                 {
                     if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
@@ -234,12 +293,12 @@ static tb_bool_t tb_object_json_writer_func_dictionary(tb_object_json_writer_t*
 
         // writ end
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "}") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "}")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
     }
     else 
     {
-        if (tb_stream_printf(writer->stream, "{}") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "{}")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
     }
 
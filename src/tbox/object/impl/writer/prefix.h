@@ -29,15 +29,30 @@
  */
 #include "../prefix.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// writ the constant string without formating it
+#define tb_object_writer_cstr(stream, s)        tb_stream_bwrit(stream, (tb_byte_t const*)(s), sizeof(s) - 1)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * inlines
  */
 static __tb_inline__ tb_bool_t tb_object_writer_tab(tb_stream_ref_t stream, tb_bool_t deflate, tb_size_t tab)
 {
-    // writ tab
+    // the tabs
+    static tb_char_t const s_tabs[] = "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t";
+
+    // writ tabs
     if (!deflate) 
     {
-        while (tab--) if (tb_stream_printf(stream, "\t") < 0) return tb_false;
+        while (tab)
+        {
+            tb_size_t n = tb_min(tab, sizeof(s_tabs) - 1);
+            if (!tb_stream_bwrit(stream, (tb_byte_t const*)s_tabs, n)) return tb_false;
+            tab -= n;
+        }
     }
 
     // ok
@@ -46,11 +61,46 @@ static __tb_inline__ tb_bool_t tb_object_writer_tab(tb_stream_ref_t stream, tb_b
 static __tb_inline__ tb_bool_t tb_object_writer_newline(tb_stream_ref_t stream, tb_bool_t deflate)
 {
     // writ newline
-    if (!deflate && tb_stream_printf(stream, __tb_newline__) < 0) return tb_false;
+    if (!deflate && !tb_object_writer_cstr(stream, __tb_newline__)) return tb_false;
 
     // ok
     return tb_true;
 }
+static __tb_inline__ tb_bool_t tb_object_writer_string(tb_stream_ref_t stream, tb_char_t const* data, tb_size_t size)
+{
+    // writ string
+    return size? tb_stream_bwrit(stream, (tb_byte_t const*)data, size) : tb_true;
+}
+static __tb_inline__ tb_bool_t tb_object_writer_uint64(tb_stream_ref_t stream, tb_uint64_t value)
+{
+    // writ the decimal digits
+    tb_char_t data[32];
+    tb_size_t size = tb_u64tos10(data, sizeof(data), value);
+    return tb_stream_bwrit(stream, (tb_byte_t const*)data, size);
+}
+static __tb_inline__ tb_bool_t tb_object_writer_sint64(tb_stream_ref_t stream, tb_sint64_t value)
+{
+    // writ the decimal digits
+    tb_char_t data[32];
+    tb_size_t size = tb_s64tos10(data, sizeof(data), value);
+    return tb_stream_bwrit(stream, (tb_byte_t const*)data, size);
+}
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+static __tb_inline__ tb_bool_t tb_object_writer_float(tb_stream_ref_t stream, tb_float_t value)
+{
+    // writ the shortest round-trip digits
+    tb_char_t data[32];
+    tb_size_t size = tb_ftos10(data, sizeof(data), value);
+    return tb_stream_bwrit(stream, (tb_byte_t const*)data, size);
+}
+static __tb_inline__ tb_bool_t tb_object_writer_double(tb_stream_ref_t stream, tb_double_t value)
+{
+    // writ the shortest round-trip digits
+    tb_char_t data[32];
+    tb_size_t size = tb_dtos10(data, sizeof(data), value);
+    return tb_stream_bwrit(stream, (tb_byte_t const*)data, size);
+}
+#endif
 static __tb_inline__ tb_bool_t tb_object_writer_bin_type_size(tb_stream_ref_t stream, tb_size_t type, tb_uint64_t size)
 {
     // check
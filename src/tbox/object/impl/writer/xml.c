@@ -45,7 +45,7 @@ static tb_bool_t tb_object_xml_writer_func_null(tb_object_xml_writer_t* writer,
 
     // writ
     if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-    if (tb_stream_printf(writer->stream, "<null/>") < 0) return tb_false;
+    if (!tb_object_writer_cstr(writer->stream, "<null/>")) return tb_false;
     if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
 
     // ok
@@ -62,7 +62,7 @@ static tb_bool_t tb_object_xml_writer_func_date(tb_object_xml_writer_t* writer,
     {
         // writ beg
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<date>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<date>")) return tb_false;
 
         // writ date
         tb_tm_t date = {0};
@@ -78,14 +78,14 @@ static tb_bool_t tb_object_xml_writer_func_date(tb_object_xml_writer_t* writer,
         }
                     
         // writ end
-        if (tb_stream_printf(writer->stream, "</date>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</date>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
     }
     else 
     {
         // writ
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<date/>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<date/>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
     }
 
@@ -102,7 +102,7 @@ static tb_bool_t tb_object_xml_writer_func_data(tb_object_xml_writer_t* writer,
     {
         // writ beg
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<data>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<data>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
 
         // decode base64 data
@@ -118,14 +118,13 @@ static tb_bool_t tb_object_xml_writer_func_data(tb_object_xml_writer_t* writer,
         tb_char_t const*    p = ob;
         tb_char_t const*    e = ob + on;
         tb_size_t           n = 0;
-        for (; p < e && *p; p++, n++)
+        for (; p < e; p += n)
         {
-            if (!(n & 63))
-            {
-                if (n) if (!tb_object_writer_newline(writer->stream, writer->deflate)) break;
-                if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) break;
-            }
-            if (tb_stream_printf(writer->stream, "%c", *p) < 0) break;
+            // writ one line with 64 charactors
+            n = tb_min((tb_size_t)(e - p), 64);
+            if (p != ob) if (!tb_object_writer_newline(writer->stream, writer->deflate)) break;
+            if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) break;
+            if (!tb_object_writer_string(writer->stream, p, n)) break;
         }
 
         // free the data
@@ -139,14 +138,14 @@ static tb_bool_t tb_object_xml_writer_func_data(tb_object_xml_writer_t* writer,
      
         // writ end
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "</data>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</data>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
     }
     else 
     {
         // writ
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<data/>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<data/>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
     }
 
@@ -163,7 +162,7 @@ static tb_bool_t tb_object_xml_writer_func_array(tb_object_xml_writer_t* writer,
     {
         // writ beg
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<array>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<array>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
 
         // walk
@@ -183,13 +182,13 @@ static tb_bool_t tb_object_xml_writer_func_array(tb_object_xml_writer_t* writer,
 
         // writ end
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "</array>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</array>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
     }
     else 
     {
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<array/>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<array/>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
     }
 
@@ -205,9 +204,11 @@ static tb_bool_t tb_object_xml_writer_func_string(tb_object_xml_writer_t* writer
     if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
     if (tb_object_string_size(object))
     {
-        if (tb_stream_printf(writer->stream, "<string>%s</string>", tb_object_string_cstr(object)) < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<string>")) return tb_false;
+        if (!tb_object_writer_string(writer->stream, tb_object_string_cstr(object), tb_object_string_size(object))) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</string>")) return tb_false;
     }
-    else if (tb_stream_printf(writer->stream, "<string/>") < 0) return tb_false;
+    else if (!tb_object_writer_cstr(writer->stream, "<string/>")) return tb_false;
     if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
 
     // ok
@@ -223,53 +224,73 @@ static tb_bool_t tb_object_xml_writer_func_number(tb_object_xml_writer_t* writer
     {
     case TB_NUMBER_TYPE_UINT64:
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<number>%llu</number>", tb_object_number_uint64(object)) < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<number>")) return tb_false;
+        if (!tb_object_writer_uint64(writer->stream, tb_object_number_uint64(object))) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</number>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
     case TB_NUMBER_TYPE_SINT64:
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<number>%lld</number>", tb_object_number_sint64(object)) < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<number>")) return tb_false;
+        if (!tb_object_writer_sint64(writer->stream, tb_object_number_sint64(object))) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</number>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
     case TB_NUMBER_TYPE_UINT32:
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<number>%u</number>", tb_object_number_uint32(object)) < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<number>")) return tb_false;
+        if (!tb_object_writer_uint64(writer->stream, tb_object_number_uint32(object))) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</number>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
     case TB_NUMBER_TYPE_SINT32:
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<number>%d</number>", tb_object_number_sint32(object)) < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<number>")) return tb_false;
+        if (!tb_object_writer_sint64(writer->stream, tb_object_number_sint32(object))) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</number>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
     case TB_NUMBER_TYPE_UINT16:
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<number>%u</number>", tb_object_number_uint16(object)) < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<number>")) return tb_false;
+        if (!tb_object_writer_uint64(writer->stream, tb_object_number_uint16(object))) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</number>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
     case TB_NUMBER_TYPE_SINT16:
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<number>%d</number>", tb_object_number_sint16(object)) < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<number>")) return tb_false;
+        if (!tb_object_writer_sint64(writer->stream, tb_object_number_sint16(object))) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</number>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
     case TB_NUMBER_TYPE_UINT8:
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<number>%u</number>", tb_object_number_uint8(object)) < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<number>")) return tb_false;
+        if (!tb_object_writer_uint64(writer->stream, tb_object_number_uint8(object))) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</number>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
     case TB_NUMBER_TYPE_SINT8:
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<number>%d</number>", tb_object_number_sint8(object)) < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<number>")) return tb_false;
+        if (!tb_object_writer_sint64(writer->stream, tb_object_number_sint8(object))) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</number>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
     case TB_NUMBER_TYPE_FLOAT:
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<number>%f</number>", tb_object_number_float(object)) < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<number>")) return tb_false;
+        if (!tb_object_writer_float(writer->stream, tb_object_number_float(object))) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</number>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
     case TB_NUMBER_TYPE_DOUBLE:
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<number>%lf</number>", tb_object_number_double(object)) < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<number>")) return tb_false;
+        if (!tb_object_writer_double(writer->stream, tb_object_number_double(object))) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</number>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
 #endif
@@ -287,7 +308,11 @@ static tb_bool_t tb_object_xml_writer_func_boolean(tb_object_xml_writer_t* write
 
     // writ
     if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-    if (tb_stream_printf(writer->stream, "<%s/>", tb_object_boolean_bool(object)? "true" : "false") < 0) return tb_false;
+    if (tb_object_boolean_bool(object))
+    {
+        if (!tb_object_writer_cstr(writer->stream, "<true/>")) return tb_false;
+    }
+    else if (!tb_object_writer_cstr(writer->stream, "<false/>")) return tb_false;
     if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
 
     // ok
@@ -303,7 +328,7 @@ static tb_bool_t tb_object_xml_writer_func_dictionary(tb_object_xml_writer_t* wr
     {
         // writ beg
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<dict>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<dict>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
 
         // walk
@@ -318,7 +343,9 @@ static tb_bool_t tb_object_xml_writer_func_dictionary(tb_object_xml_writer_t* wr
 
                 // writ key
                 if (!tb_object_writer_tab(writer->stream, writer->deflate, level + 1)) return tb_false;
-                if (tb_stream_printf(writer->stream, "<key>%s</key>", item->key) < 0) return tb_false;
+                if (!tb_object_writer_cstr(writer->stream, "<key>")) return tb_false;
+                if (!tb_object_writer_string(writer->stream, item->key, tb_strlen(item->key))) return tb_false;
+                if (!tb_object_writer_cstr(writer->stream, "</key>")) return tb_false;
                 if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
 
                 // writ val
@@ -328,13 +355,13 @@ static tb_bool_t tb_object_xml_writer_func_dictionary(tb_object_xml_writer_t* wr
 
         // writ end
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "</dict>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</dict>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
     }
     else 
     {
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<dict/>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<dict/>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
     }
 
@@ -359,7 +386,7 @@ static tb_long_t tb_object_xml_writer_done(tb_stream_ref_t stream, tb_object_ref
     tb_hize_t bof = tb_stream_offset(stream);
 
     // writ xml header
-    if (tb_stream_printf(stream, "<?xml version=\"2.0\" encoding=\"utf-8\"?>") < 0) return -1;
+    if (!tb_object_writer_cstr(stream, "<?xml version=\"2.0\" encoding=\"utf-8\"?>")) return -1;
     if (!tb_object_writer_newline(stream, deflate)) return -1;
 
     // writ
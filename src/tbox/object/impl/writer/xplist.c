@@ -49,7 +49,7 @@ static tb_bool_t tb_object_xplist_writer_func_date(tb_object_xplist_writer_t* wr
     {
         // writ beg
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<date>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<date>")) return tb_false;
 
         // writ date
         tb_tm_t date = {0};
@@ -65,14 +65,14 @@ static tb_bool_t tb_object_xplist_writer_func_date(tb_object_xplist_writer_t* wr
         }
                     
         // writ end
-        if (tb_stream_printf(writer->stream, "</date>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</date>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
     }
     else 
     {
         // writ
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<date/>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<date/>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
     }
 
@@ -89,7 +89,7 @@ static tb_bool_t tb_object_xplist_writer_func_data(tb_object_xplist_writer_t* wr
     {
         // writ beg
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<data>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<data>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
 
         // decode base64 data
@@ -105,34 +105,38 @@ static tb_bool_t tb_object_xplist_writer_func_data(tb_object_xplist_writer_t* wr
         tb_char_t const*    p = ob;
         tb_char_t const*    e = ob + on;
         tb_size_t           n = 0;
-        for (; p < e && *p; p++, n++)
+        for (; p < e; p += n)
         {
-            if (!(n % 68))
-            {
-                if (n) if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
-                if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-            }
-            if (tb_stream_printf(writer->stream, "%c", *p) < 0) return tb_false;
+            // writ one line with 68 charactors
+            n = tb_min((tb_size_t)(e - p), 68);
+            if (p != ob) if (!tb_object_writer_newline(writer->stream, writer->deflate)) break;
+            if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) break;
+            if (!tb_object_writer_string(writer->stream, p, n)) break;
         }
-        if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
 
         // free it
         tb_free(ob);
+
+        // check
+        tb_check_return_val(p == e, tb_false);
+
+        // writ newline
+        if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
                     
         // writ end
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "</data>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</data>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
     }
     else 
     {
         // writ
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<data>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<data>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
 
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "</data>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</data>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
     }
 
@@ -149,7 +153,7 @@ static tb_bool_t tb_object_xplist_writer_func_array(tb_object_xplist_writer_t* w
     {
         // writ beg
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<array>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<array>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
 
         // walk
@@ -169,13 +173,13 @@ static tb_bool_t tb_object_xplist_writer_func_array(tb_object_xplist_writer_t* w
 
         // writ end
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "</array>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</array>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
     }
     else 
     {
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<array/>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<array/>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
     }
 
@@ -191,9 +195,11 @@ static tb_bool_t tb_object_xplist_writer_func_string(tb_object_xplist_writer_t*
     if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
     if (tb_object_string_size(object))
     {
-        if (tb_stream_printf(writer->stream, "<string>%s</string>", tb_object_string_cstr(object)) < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<string>")) return tb_false;
+        if (!tb_object_writer_string(writer->stream, tb_object_string_cstr(object), tb_object_string_size(object))) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</string>")) return tb_false;
     }
-    else if (tb_stream_printf(writer->stream, "<string/>") < 0) return tb_false;
+    else if (!tb_object_writer_cstr(writer->stream, "<string/>")) return tb_false;
     if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
 
     // ok
@@ -209,53 +215,73 @@ static tb_bool_t tb_object_xplist_writer_func_number(tb_object_xplist_writer_t*
     {
     case TB_NUMBER_TYPE_UINT64:
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<integer>%llu</integer>", tb_object_number_uint64(object)) < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<integer>")) return tb_false;
+        if (!tb_object_writer_uint64(writer->stream, tb_object_number_uint64(object))) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</integer>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
     case TB_NUMBER_TYPE_SINT64:
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<integer>%lld</integer>", tb_object_number_sint64(object)) < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<integer>")) return tb_false;
+        if (!tb_object_writer_sint64(writer->stream, tb_object_number_sint64(object))) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</integer>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
     case TB_NUMBER_TYPE_UINT32:
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<integer>%u</integer>", tb_object_number_uint32(object)) < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<integer>")) return tb_false;
+        if (!tb_object_writer_uint64(writer->stream, tb_object_number_uint32(object))) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</integer>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
     case TB_NUMBER_TYPE_SINT32:
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<integer>%d</integer>", tb_object_number_sint32(object)) < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<integer>")) return tb_false;
+        if (!tb_object_writer_sint64(writer->stream, tb_object_number_sint32(object))) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</integer>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
     case TB_NUMBER_TYPE_UINT16:
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<integer>%u</integer>", tb_object_number_uint16(object)) < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<integer>")) return tb_false;
+        if (!tb_object_writer_uint64(writer->stream, tb_object_number_uint16(object))) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</integer>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
     case TB_NUMBER_TYPE_SINT16:
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<integer>%d</integer>", tb_object_number_sint16(object)) < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<integer>")) return tb_false;
+        if (!tb_object_writer_sint64(writer->stream, tb_object_number_sint16(object))) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</integer>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
     case TB_NUMBER_TYPE_UINT8:
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<integer>%u</integer>", tb_object_number_uint8(object)) < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<integer>")) return tb_false;
+        if (!tb_object_writer_uint64(writer->stream, tb_object_number_uint8(object))) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</integer>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
     case TB_NUMBER_TYPE_SINT8:
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<integer>%d</integer>", tb_object_number_sint8(object)) < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<integer>")) return tb_false;
+        if (!tb_object_writer_sint64(writer->stream, tb_object_number_sint8(object))) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</integer>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
     case TB_NUMBER_TYPE_FLOAT:
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<real>%f</real>", tb_object_number_float(object)) < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<real>")) return tb_false;
+        if (!tb_object_writer_float(writer->stream, tb_object_number_float(object))) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</real>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
     case TB_NUMBER_TYPE_DOUBLE:
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<real>%lf</real>", tb_object_number_double(object)) < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<real>")) return tb_false;
+        if (!tb_object_writer_double(writer->stream, tb_object_number_double(object))) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</real>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
 #endif
@@ -273,7 +299,11 @@ static tb_bool_t tb_object_xplist_writer_func_boolean(tb_object_xplist_writer_t*
 
     // writ
     if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-    if (tb_stream_printf(writer->stream, "<%s/>", tb_object_boolean_bool(object)? "true" : "false") < 0) return tb_false;
+    if (tb_object_boolean_bool(object))
+    {
+        if (!tb_object_writer_cstr(writer->stream, "<true/>")) return tb_false;
+    }
+    else if (!tb_object_writer_cstr(writer->stream, "<false/>")) return tb_false;
     if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
 
     // ok
@@ -289,7 +319,7 @@ static tb_bool_t tb_object_xplist_writer_func_dictionary(tb_object_xplist_writer
     {
         // writ beg
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<dict>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<dict>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
 
         // walk
@@ -304,7 +334,9 @@ static tb_bool_t tb_object_xplist_writer_func_dictionary(tb_object_xplist_writer
 
                 // writ key
                 tb_object_writer_tab(writer->stream, writer->deflate, level + 1);
-                if (tb_stream_printf(writer->stream, "<key>%s</key>", item->key) < 0) return tb_false;
+                if (!tb_object_writer_cstr(writer->stream, "<key>")) return tb_false;
+                if (!tb_object_writer_string(writer->stream, item->key, tb_strlen(item->key))) return tb_false;
+                if (!tb_object_writer_cstr(writer->stream, "</key>")) return tb_false;
                 if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
 
                 // writ val
@@ -314,13 +346,13 @@ static tb_bool_t tb_object_xplist_writer_func_dictionary(tb_object_xplist_writer
 
         // writ end
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "</dict>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "</dict>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
     }
     else 
     {
         if (!tb_object_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<dict/>") < 0) return tb_false;
+        if (!tb_object_writer_cstr(writer->stream, "<dict/>")) return tb_false;
         if (!tb_object_writer_newline(writer->stream, writer->deflate)) return tb_false;
     }
 
@@ -345,18 +377,18 @@ static tb_long_t tb_object_xplist_writer_done(tb_stream_ref_t stream, tb_object_
     tb_hize_t bof = tb_stream_offset(stream);
 
     // writ xplist header
-    if (tb_stream_printf(stream, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>") < 0) return -1;
+    if (!tb_object_writer_cstr(stream, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>")) return -1;
     if (!tb_object_writer_newline(stream, deflate)) return -1;
-    if (tb_stream_printf(stream, "<!DOCTYPE plist PUBLIC \"-//Apple//DTD PLIST 1.0//EN\" \"http://www.apple.com/DTDs/PropertyList-1.0.dtd\">") < 0) return -1;
+    if (!tb_object_writer_cstr(stream, "<!DOCTYPE plist PUBLIC \"-//Apple//DTD PLIST 1.0//EN\" \"http://www.apple.com/DTDs/PropertyList-1.0.dtd\">")) return -1;
     if (!tb_object_writer_newline(stream, deflate)) return -1;
-    if (tb_stream_printf(stream, "<plist version=\"1.0\">") < 0) return -1;
+    if (!tb_object_writer_cstr(stream, "<plist version=\"1.0\">")) return -1;
     if (!tb_object_writer_newline(stream, deflate)) return -1;
 
     // writ
     if (!func(&writer, object, 0)) return -1;
 
     // writ xplist end
-    if (tb_stream_printf(stream, "</plist>") < 0) return -1;
+    if (!tb_object_writer_cstr(stream, "</plist>")) return -1;
     if (!tb_object_writer_newline(stream, deflate)) return -1;
 
     // sync
@@ -557,6 +557,9 @@ tb_bool_t tb_object_number_uint8_set(tb_object_ref_t object, tb_uint8_t value)
     number->type = TB_NUMBER_TYPE_UINT8;
     number->v.u8 = value;
 
+    // changed
+    object->flag |= TB_OBJECT_FLAG_DIRTY;
+
     // ok
     return tb_true;
 }
@@ -570,6 +573,9 @@ tb_bool_t tb_object_number_sint8_set(tb_object_ref_t object, tb_sint8_t value)
     number->type = TB_NUMBER_TYPE_SINT8;
     number->v.s8 = value;
 
+    // changed
+    object->flag |= TB_OBJECT_FLAG_DIRTY;
+
     // ok
     return tb_true;
 }
@@ -583,6 +589,9 @@ tb_bool_t tb_object_number_uint16_set(tb_object_ref_t object, tb_uint16_t value)
     number->type = TB_NUMBER_TYPE_UINT16;
     number->v.u16 = value;
 
+    // changed
+    object->flag |= TB_OBJECT_FLAG_DIRTY;
+
     // ok
     return tb_true;
 }
@@ -596,6 +605,9 @@ tb_bool_t tb_object_number_sint16_set(tb_object_ref_t object, tb_sint16_t value)
     number->type = TB_NUMBER_TYPE_SINT16;
     number->v.s16 = value;
 
+    // changed
+    object->flag |= TB_OBJECT_FLAG_DIRTY;
+
     // ok
     return tb_true;
 }
@@ -609,6 +621,9 @@ tb_bool_t tb_object_number_uint32_set(tb_object_ref_t object, tb_uint32_t value)
     number->type = TB_NUMBER_TYPE_UINT32;
     number->v.u32 = value;
 
+    // changed
+    object->flag |= TB_OBJECT_FLAG_DIRTY;
+
     // ok
     return tb_true;
 }
@@ -622,6 +637,9 @@ tb_bool_t tb_object_number_sint32_set(tb_object_ref_t object, tb_sint32_t value)
     number->type = TB_NUMBER_TYPE_SINT32;
     number->v.s32 = value;
 
+    // changed
+    object->flag |= TB_OBJECT_FLAG_DIRTY;
+
     // ok
     return tb_true;
 }
@@ -635,6 +653,9 @@ tb_bool_t tb_object_number_uint64_set(tb_object_ref_t object, tb_uint64_t value)
     number->type = TB_NUMBER_TYPE_UINT64;
     number->v.u64 = value;
 
+    // changed
+    object->flag |= TB_OBJECT_FLAG_DIRTY;
+
     // ok
     return tb_true;
 }
@@ -648,6 +669,9 @@ tb_bool_t tb_object_number_sint64_set(tb_object_ref_t object, tb_sint64_t value)
     number->type = TB_NUMBER_TYPE_SINT64;
     number->v.s64 = value;
 
+    // changed
+    object->flag |= TB_OBJECT_FLAG_DIRTY;
+
     // ok
     return tb_true;
 }
@@ -662,6 +686,9 @@ tb_bool_t tb_object_number_float_set(tb_object_ref_t object, tb_float_t value)
     number->type = TB_NUMBER_TYPE_FLOAT;
     number->v.f = value;
 
+    // changed
+    object->flag |= TB_OBJECT_FLAG_DIRTY;
+
     // ok
     return tb_true;
 }
@@ -675,6 +702,9 @@ tb_bool_t tb_object_number_double_set(tb_object_ref_t object, tb_double_t value)
     number->type = TB_NUMBER_TYPE_DOUBLE;
     number->v.d = value;
 
+    // changed
+    object->flag |= TB_OBJECT_FLAG_DIRTY;
+
     // ok
     return tb_true;
 }
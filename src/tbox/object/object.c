@@ -79,6 +79,9 @@ tb_void_t tb_object_context_exit()
     tb_object_reader_remove(TB_OBJECT_FORMAT_XPLIST);
     tb_object_writer_remove(TB_OBJECT_FORMAT_XPLIST);
 #endif
+
+    // exit the interned keys
+    tb_object_dictionary_intern_exit();
 }
 tb_bool_t tb_object_init(tb_object_ref_t object, tb_size_t flag, tb_size_t type)
 {
@@ -386,6 +389,41 @@ tb_object_ref_t tb_object_read_from_data(tb_byte_t const* data, tb_size_t size)
     // ok?
     return object;
 }
+tb_long_t tb_object_read_records(tb_stream_ref_t stream, tb_size_t format, tb_bool_t ordered, tb_object_record_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return_val(stream && func, -1);
+
+    // done records
+    return tb_object_records_done(stream, tb_null, 0, format, ordered, func, priv);
+}
+tb_long_t tb_object_read_records_from_url(tb_char_t const* url, tb_size_t format, tb_bool_t ordered, tb_object_record_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return_val(url && func, -1);
+
+    // make stream
+    tb_stream_ref_t stream = tb_stream_init_from_url(url);
+    tb_assert_and_check_return_val(stream, -1);
+
+    // read records
+    tb_long_t count = -1;
+    if (tb_stream_open(stream)) count = tb_object_read_records(stream, format, ordered, func, priv);
+
+    // exit stream
+    tb_stream_exit(stream);
+
+    // ok?
+    return count;
+}
+tb_long_t tb_object_read_records_from_data(tb_byte_t const* data, tb_size_t size, tb_size_t format, tb_bool_t ordered, tb_object_record_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return_val(data && size && func, -1);
+
+    // done records
+    return tb_object_records_done(tb_null, data, size, format, ordered, func, priv);
+}
 tb_long_t tb_object_writ(tb_object_ref_t object, tb_stream_ref_t stream, tb_size_t format)
 {
     // check
@@ -443,4 +481,40 @@ tb_long_t tb_object_writ_to_data(tb_object_ref_t object, tb_byte_t* data, tb_siz
     // ok?
     return writ;
 }
+tb_void_t tb_object_track(tb_object_ref_t object)
+{
+    // check
+    tb_assert_and_check_return(object);
+
+    // track it
+    tb_object_patch_track(object);
+}
+tb_long_t tb_object_writ_patch(tb_object_ref_t object, tb_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(object && stream, -1);
+
+    // writ it
+    return tb_object_patch_done(object, stream);
+}
+tb_long_t tb_object_writ_patch_to_data(tb_object_ref_t object, tb_byte_t* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(object && data && size, -1);
+
+    // make stream
+    tb_long_t           writ = -1;
+    tb_stream_ref_t     stream = tb_stream_init_from_data(data, size);
+    if (stream)
+    {
+        // open and writ stream
+        if (tb_stream_open(stream)) writ = tb_object_writ_patch(object, stream);
+
+        // exit stream
+        tb_stream_exit(stream);
+    }
+
+    // ok?
+    return writ;
+}
 
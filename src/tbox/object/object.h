@@ -42,6 +42,13 @@
  */
 __tb_extern_c_enter__
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the object record func type, return tb_false if want to stop reading
+typedef tb_bool_t   (*tb_object_record_func_t)(tb_object_ref_t object, tb_cpointer_t priv);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -120,6 +127,48 @@ tb_object_ref_t     tb_object_read_from_url(tb_char_t const* url);
  */
 tb_object_ref_t     tb_object_read_from_data(tb_byte_t const* data, tb_size_t size);
 
+/*! read the newline-delimited json records or the top-level xml records in parallel
+ *
+ * the stream is split into chunks at the record boundaries and the chunks are parsed on the thread pool. 
+ * the ordered records are passed to the func on the current thread, 
+ * otherwise they are passed on the worker threads as soon as they are parsed and the func must be thread-safe.
+ * the object will be exited after the func returns, please retain it if want to keep it.
+ *
+ * @param stream    the stream
+ * @param format    the records format, TB_OBJECT_FORMAT_JSON, TB_OBJECT_FORMAT_XML or TB_OBJECT_FORMAT_XPLIST
+ * @param ordered   pass the records in order?
+ * @param func      the record func
+ * @param priv      the user private data
+ *
+ * @return          the records count, -1 if failed
+ */
+tb_long_t           tb_object_read_records(tb_stream_ref_t stream, tb_size_t format, tb_bool_t ordered, tb_object_record_func_t func, tb_cpointer_t priv);
+
+/*! read the records from url in parallel
+ *
+ * @param url       the url
+ * @param format    the records format
+ * @param ordered   pass the records in order?
+ * @param func      the record func
+ * @param priv      the user private data
+ *
+ * @return          the records count, -1 if failed
+ */
+tb_long_t           tb_object_read_records_from_url(tb_char_t const* url, tb_size_t format, tb_bool_t ordered, tb_object_record_func_t func, tb_cpointer_t priv);
+
+/*! read the records from data in parallel, the chunks refer to the data without copying
+ *
+ * @param data      the data, e.g. the mapped file data
+ * @param size      the size
+ * @param format    the records format
+ * @param ordered   pass the records in order?
+ * @param func      the record func
+ * @param priv      the user private data
+ *
+ * @return          the records count, -1 if failed
+ */
+tb_long_t           tb_object_read_records_from_data(tb_byte_t const* data, tb_size_t size, tb_size_t format, tb_bool_t ordered, tb_object_record_func_t func, tb_cpointer_t priv);
+
 /*! writ object
  *
  * @param object    the object
@@ -151,6 +200,34 @@ tb_long_t           tb_object_writ_to_url(tb_object_ref_t object, tb_char_t cons
  */
 tb_long_t           tb_object_writ_to_data(tb_object_ref_t object, tb_byte_t* data, tb_size_t size, tb_size_t format);
 
+/*! track the changes of the object tree
+ *
+ * clear the changed state of the whole tree, the next tb_object_writ_patch() 
+ * will only writ the changes after it
+ *
+ * @param object    the root object
+ */
+tb_void_t           tb_object_track(tb_object_ref_t object);
+
+/*! writ the changes of the object tree as the json patch (rfc 6902)
+ *
+ * @param object    the root object
+ * @param stream    the stream
+ *
+ * @return          the writed size, failed: -1
+ */
+tb_long_t           tb_object_writ_patch(tb_object_ref_t object, tb_stream_ref_t stream);
+
+/*! writ the changes of the object tree to data
+ *
+ * @param object    the root object
+ * @param data      the data
+ * @param size      the size
+ *
+ * @return          the writed size, failed: -1
+ */
+tb_long_t           tb_object_writ_patch_to_data(tb_object_ref_t object, tb_byte_t* data, tb_size_t size);
+
 /*! copy object
  *
  * @param object    the object
@@ -146,7 +146,7 @@ tb_object_ref_t tb_object_string_init_from_cstr(tb_char_t const* cstr)
         if (!tb_string_init(&string->str)) break;
 
         // copy string
-        if (cstr) tb_string_cstrcpy(&string->str, cstr);
+        if (cstr && *cstr) tb_string_cstrcpy(&string->str, cstr);
 
         // ok
         ok = tb_true;
@@ -215,6 +215,9 @@ tb_size_t tb_object_string_cstr_set(tb_object_ref_t object, tb_char_t const* cst
     // copy string
     tb_string_cstrcpy(&string->str, cstr);
  
+    // changed
+    object->flag |= TB_OBJECT_FLAG_DIRTY;
+
     // ok?
     return tb_string_size(&string->str);
 }
@@ -0,0 +1,70 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        cycle.h
+ *
+ */
+#ifndef TB_PLATFORM_ARCH_ARM_CYCLE_H
+#define TB_PLATFORM_ARCH_ARM_CYCLE_H
+
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+#if defined(TB_ASSEMBLER_IS_GAS) && defined(TB_ARCH_ARM64)
+
+#ifndef tb_cycle_arch
+#   define tb_cycle_arch()                  tb_cycle_arch_arm64()
+#endif
+
+// the generic timer always runs at a constant rate
+#ifndef tb_cycle_arch_invariant
+#   define tb_cycle_arch_invariant()        (tb_true)
+#endif
+
+#ifndef tb_cycle_arch_frequency
+#   define tb_cycle_arch_frequency()        tb_cycle_arch_frequency_arm64()
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+static __tb_inline__ tb_uint64_t tb_cycle_arch_arm64()
+{
+    // the virtual count of the generic timer
+    tb_uint64_t cycle;
+    __tb_asm__ __tb_volatile__ ("mrs %0, cntvct_el0" : "=r" (cycle));
+    return cycle;
+}
+static __tb_inline__ tb_uint64_t tb_cycle_arch_frequency_arm64()
+{
+    tb_uint64_t freq;
+    __tb_asm__ __tb_volatile__ ("mrs %0, cntfrq_el0" : "=r" (freq));
+    return freq;
+}
+
+#endif
+
+
+#endif
@@ -0,0 +1,38 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        cycle.h
+ *
+ */
+#ifndef TB_PLATFORM_ARCH_CYCLE_H
+#define TB_PLATFORM_ARCH_CYCLE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#if defined(TB_ARCH_x86)
+#   include "x86/cycle.h"
+#elif defined(TB_ARCH_x64)
+#   include "x64/cycle.h"
+#elif defined(TB_ARCH_ARM)
+#   include "arm/cycle.h"
+#endif
+
+#endif
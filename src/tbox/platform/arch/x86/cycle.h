@@ -0,0 +1,94 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        cycle.h
+ *
+ */
+#ifndef TB_PLATFORM_ARCH_x86_CYCLE_H
+#define TB_PLATFORM_ARCH_x86_CYCLE_H
+
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+#ifdef TB_ASSEMBLER_IS_GAS
+
+#ifndef tb_cycle_arch
+#   define tb_cycle_arch()                  tb_cycle_arch_x86()
+#endif
+
+#ifndef tb_cycle_arch_invariant
+#   define tb_cycle_arch_invariant()        tb_cycle_arch_invariant_x86()
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+static __tb_inline__ tb_uint64_t tb_cycle_arch_x86()
+{
+    // rdtsc: edx:eax = tsc
+    tb_uint32_t lo;
+    tb_uint32_t hi;
+    __tb_asm__ __tb_volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
+    return ((tb_uint64_t)hi << 32) | lo;
+}
+static __tb_inline__ tb_void_t tb_cycle_arch_cpuid_x86(tb_uint32_t leaf, tb_uint32_t regs[4])
+{
+    // save ebx/rbx for the pic code
+    tb_size_t b;
+    __tb_asm__ __tb_volatile__ 
+    (
+#if TB_CPU_BITSIZE == 64
+        "xchgq %%rbx, %1    \n"
+        "cpuid              \n"
+        "xchgq %%rbx, %1    \n"
+#else
+        "xchgl %%ebx, %1    \n"
+        "cpuid              \n"
+        "xchgl %%ebx, %1    \n"
+#endif
+        : "=a" (regs[0]), "=&r" (b), "=c" (regs[2]), "=d" (regs[3]) 
+        : "0" (leaf), "2" (0)
+    );
+    regs[1] = (tb_uint32_t)b;
+}
+static __tb_inline__ tb_bool_t tb_cycle_arch_invariant_x86()
+{
+    // get the maximum extended leaf
+    tb_uint32_t regs[4] = {0};
+    tb_cycle_arch_cpuid_x86(0x80000000, regs);
+    tb_check_return_val(regs[0] >= 0x80000007, tb_false);
+
+    /* the invariant tsc: cpuid(0x80000007).edx[8]
+     *
+     * the tsc will run at a constant rate in all acpi p-, c- and t-states
+     */
+    tb_cycle_arch_cpuid_x86(0x80000007, regs);
+    return (regs[3] & (1 << 8))? tb_true : tb_false;
+}
+
+#endif
+
+
+#endif
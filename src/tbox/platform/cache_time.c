@@ -34,37 +34,55 @@
  * globals
  */
 
-// the cached time
+// the cached monotonic ms-clock
+static tb_atomic64_t    g_mclock = 0;
+
+// the cached real time, s
 static tb_atomic64_t    g_time = 0;
 
+// the ms-clock of the last real time update
+static tb_atomic64_t    g_time_spak = 0;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
 tb_hong_t tb_cache_time_spak()
 {
-    // get the time
-    tb_timeval_t tv = {0};
-    if (!tb_gettimeofday(&tv, tb_null)) return -1;
-
-    // the time value
-    tb_hong_t val = ((tb_hong_t)tv.tv_sec * 1000 + tv.tv_usec / 1000);
+    // get the monotonic clock
+    tb_hong_t val = tb_mclock();
+    tb_check_return_val(val >= 0, -1);
 
     // save it
-    tb_atomic64_set(&g_time, val);
+    tb_atomic64_set(&g_mclock, val);
+
+    /* update the real time only once per second
+     *
+     * the real time may jump if the system time is changed, 
+     * so it is only used for tb_cache_time() and not for timeout
+     */
+    tb_hong_t spak = (tb_hong_t)tb_atomic64_get(&g_time_spak);
+    if (!spak || val - spak >= 1000 || val < spak)
+    {
+        tb_time_t now = tb_time();
+        if (now != (tb_time_t)-1) 
+        {
+            tb_atomic64_set(&g_time, (tb_hong_t)now);
+            tb_atomic64_set(&g_time_spak, val);
+        }
+    }
 
     // ok
     return val;
 }
 tb_hong_t tb_cache_time_mclock()
 {
-    return (tb_hong_t)tb_atomic64_get(&g_time);
+    return (tb_hong_t)tb_atomic64_get(&g_mclock);
 }
 tb_hong_t tb_cache_time_sclock()
 {
-    return (tb_hong_t)tb_atomic64_get(&g_time) / 1000;
+    return (tb_hong_t)tb_atomic64_get(&g_mclock) / 1000;
 }
 tb_time_t tb_cache_time()
 {
-    return (tb_time_t)tb_atomic64_get(&g_time) / 1000;
+    return (tb_time_t)tb_atomic64_get(&g_time);
 }
-
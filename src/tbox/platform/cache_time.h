@@ -50,13 +50,13 @@ tb_time_t           tb_cache_time(tb_noarg_t);
  *
  * update the cached time for the external loop thread
  *
- * @return          the now ms-clock
+ * @return          the now monotonic ms-clock
  */
 tb_hong_t           tb_cache_time_spak(tb_noarg_t);
 
 /*! the cached ms-clock
  *
- * lower accuracy and faster
+ * lower accuracy and faster, it's monotonic like tb_mclock
  *
  * @return          the now ms-clock
  */
@@ -68,7 +68,7 @@ tb_hong_t           tb_cache_time_mclock(tb_noarg_t);
  *
  * @return          the now s-clock
  */
-tb_hong_t           tb_cache_time_clock(tb_noarg_t);
+tb_hong_t           tb_cache_time_sclock(tb_noarg_t);
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -0,0 +1,58 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        context.c
+ * @ingroup     platform
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "context"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+#include "context.h"
+#ifdef TB_CONFIG_OS_WINDOWS
+#   include "windows/context.c"
+#elif defined(TB_CONFIG_POSIX_HAVE_MMAP) && defined(TB_CONFIG_POSIX_HAVE_MPROTECT)
+#   include "posix/context.c"
+#else
+#include "page.h"
+tb_byte_t* tb_context_stack_init(tb_size_t* psize)
+{
+    // check
+    tb_assert_and_check_return_val(psize && *psize, tb_null);
+
+    // align the stack size, no guard page
+    tb_size_t pagesize = tb_page_size();
+    *psize = tb_align(*psize, pagesize);
+
+    // make stack
+    return tb_malloc_bytes(*psize);
+}
+tb_void_t tb_context_stack_exit(tb_byte_t* stackdata, tb_size_t stacksize)
+{
+    // exit stack
+    if (stackdata) tb_free(stackdata);
+}
+#endif
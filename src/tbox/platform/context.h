@@ -0,0 +1,147 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        context.h
+ * @ingroup     platform
+ *
+ */
+#ifndef TB_PLATFORM_CONTEXT_H
+#define TB_PLATFORM_CONTEXT_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the context switch has been implemented by the arch asm? (see arch/x64/context.S and arch/arm/context.S)
+#if (defined(TB_ARCH_x64) && !defined(TB_CONFIG_OS_WINDOWS)) \
+    || (defined(TB_ARCH_ARM64) && defined(TB_ASSEMBLER_IS_GAS))
+#   define TB_CONTEXT_HAVE_ARCH
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the context ref type, it is the stack top of the suspended context
+typedef struct{}*       tb_context_ref_t;
+
+/// the context from type
+typedef struct __tb_context_from_t
+{
+    /// the context of the jumper, jump to it to resume the jumper
+    tb_context_ref_t    context;
+
+    /// the priv data passed by the jumper
+    tb_cpointer_t       priv;
+
+}tb_context_from_t;
+
+/*! the context func type
+ *
+ * @param from          the context and priv data of the first jumper
+ *
+ * @note the context func cannot return, it need jump to other context at the end
+ */
+typedef tb_void_t       (*tb_context_func_t)(tb_context_from_t from);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+#ifdef TB_CONTEXT_HAVE_ARCH
+
+/*! make a new context on the given stack
+ *
+ * only the callee-saved registers will be saved and restored, 
+ * so it is much cheaper than ucontext and need not any syscall.
+ *
+ * @code
+ 
+    static tb_void_t func(tb_context_from_t from)
+    {
+        // the priv: "hello"
+        tb_trace_i("%s", from.priv);
+
+        // jump back and pass "world"
+        from = tb_context_jump(from.context, "world");
+
+        // ...
+    }
+
+    tb_context_ref_t  context = tb_context_make(stack, sizeof(stack), func);
+    tb_context_from_t from = tb_context_jump(context, "hello");
+
+    // the priv: "world"
+    tb_trace_i("%s", from.priv);
+
+ * @endcode
+ *
+ * @param stackdata     the stack data
+ * @param stacksize     the stack size
+ * @param func          the context func
+ *
+ * @return              the context
+ */
+tb_context_ref_t        tb_context_make(tb_byte_t* stackdata, tb_size_t stacksize, tb_context_func_t func);
+
+/*! jump to the given context and suspend the current context
+ *
+ * @param context       the context, it will be invalid after jumping
+ * @param priv          the priv data passed to the given context
+ *
+ * @return              the context and priv data of the jumper when the current context is resumed
+ */
+tb_context_from_t       tb_context_jump(tb_context_ref_t context, tb_cpointer_t priv);
+
+#endif
+
+/*! init the stack for the context 
+ *
+ * the stack will be mapped from the system pages directly 
+ * and the page below it will be protected to catch the stack overflow
+ *
+ * @param psize         the stack size pointer, it will be aligned by the page size
+ *
+ * @return              the stack data
+ */
+tb_byte_t*              tb_context_stack_init(tb_size_t* psize);
+
+/*! exit the stack
+ *
+ * @param stackdata     the stack data
+ * @param stacksize     the aligned stack size
+ */
+tb_void_t               tb_context_stack_exit(tb_byte_t* stackdata, tb_size_t stacksize);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -0,0 +1,286 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        cycle.c
+ * @ingroup     platform
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "cycle"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "cycle.h"
+#include "time.h"
+#include "barrier.h"
+#include "spinlock.h"
+#include "arch/cycle.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the minimum calibration time, ns
+#define TB_CYCLE_CALIBRATE_MIN          (10000000)
+
+// the anchor period, ns, the cycle nclock will be re-anchored to the monotonic clock after it
+#define TB_CYCLE_ANCHOR_PERIOD          (100000000)
+
+/* the anchor count, it must be the power of 2
+ *
+ * the anchors are read without lock, so the old anchors are kept for the preempted readers
+ */
+#define TB_CYCLE_ANCHOR_MAXN            (16)
+
+// the fixed-point shift of the multiplier, ns = (cycles * mult) >> shift
+#define TB_CYCLE_MULT_SHIFT             (32)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the cycle anchor type
+typedef struct __tb_cycle_anchor_t
+{
+    // the anchor cycle
+    tb_uint64_t             cycle;
+
+    // the anchor nclock
+    tb_hong_t               nclock;
+
+    // the period cycles, the next anchor will be made after it
+    tb_uint64_t             period;
+
+    // the multiplier of the nanoseconds per cycle
+    tb_uint64_t             mult;
+
+    // the calibrated frequency
+    tb_uint64_t             freq;
+
+}tb_cycle_anchor_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// using the cpu counter?
+static tb_bool_t            g_cycle_arch = tb_false;
+
+// the base cycle for calibration
+static tb_uint64_t          g_cycle_base = 0;
+
+// the base nclock for calibration
+static tb_hong_t            g_cycle_nbase = 0;
+
+#ifdef tb_cycle_arch
+// the anchors
+static tb_cycle_anchor_t    g_cycle_anchors[TB_CYCLE_ANCHOR_MAXN];
+
+// the current anchor index, it is published after the anchor has been written
+static tb_size_t volatile   g_cycle_anchor = 0;
+
+// the lock for making anchor
+static tb_spinlock_t        g_cycle_lock = TB_SPINLOCK_INIT;
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#ifdef tb_cycle_arch
+static __tb_inline__ tb_cycle_anchor_t const* tb_cycle_anchor()
+{
+    return &g_cycle_anchors[g_cycle_anchor & (TB_CYCLE_ANCHOR_MAXN - 1)];
+}
+#   ifndef tb_cycle_arch_frequency
+static tb_uint64_t tb_cycle_calibrate(tb_uint64_t cycle, tb_hong_t nclock)
+{
+    // the elapsed cycles and nanoseconds since init, the longer window is more accurate
+    tb_uint64_t dc = cycle - g_cycle_base;
+    tb_uint64_t dn = (tb_uint64_t)(nclock - g_cycle_nbase);
+    tb_check_return_val(dn >= TB_CYCLE_CALIBRATE_MIN, 0);
+
+    // scale them down to avoid overflow for dn << shift
+    while (dn > 0xffffffffULL)
+    {
+        dc >>= 1;
+        dn >>= 1;
+    }
+    tb_assert_and_check_return_val(dc, 0);
+
+    // the multiplier
+    return (dn << TB_CYCLE_MULT_SHIFT) / dc;
+}
+#   endif
+static tb_hong_t tb_cycle_anchor_make(tb_noarg_t)
+{
+    // another thread is making it? using the current anchor or the monotonic clock
+    if (!tb_spinlock_enter_try_without_profiler(&g_cycle_lock))
+    {
+        tb_cycle_anchor_t const* anchor = tb_cycle_anchor();
+        tb_uint64_t dc = tb_cycle_arch() - anchor->cycle;
+        return dc < (anchor->period << 1)? anchor->nclock + (tb_hong_t)((dc * anchor->mult) >> TB_CYCLE_MULT_SHIFT) : tb_nclock();
+    }
+
+    // sample the nclock between two cycle reads to reduce the error
+    tb_uint64_t c0 = tb_cycle_arch();
+    tb_hong_t   n  = tb_nclock();
+    tb_uint64_t c1 = tb_cycle_arch();
+    tb_uint64_t c  = c0 + ((c1 - c0) >> 1);
+
+    // the multiplier
+#   ifdef tb_cycle_arch_frequency
+    tb_uint64_t freq = tb_cycle_arch_frequency();
+    tb_uint64_t mult = freq? ((tb_uint64_t)1000000000 << TB_CYCLE_MULT_SHIFT) / freq : 0;
+#   else
+    tb_uint64_t mult = tb_cycle_calibrate(c, n);
+#   endif
+    if (mult)
+    {
+        // the previous and next anchor
+        tb_size_t                   index = g_cycle_anchor;
+        tb_cycle_anchor_t const*    prev = &g_cycle_anchors[index & (TB_CYCLE_ANCHOR_MAXN - 1)];
+        tb_cycle_anchor_t*          next = &g_cycle_anchors[(index + 1) & (TB_CYCLE_ANCHOR_MAXN - 1)];
+
+        // init the next anchor
+        next->cycle     = c;
+        next->nclock    = n;
+        next->freq      = ((tb_uint64_t)1000000000 << TB_CYCLE_MULT_SHIFT) / mult;
+        next->period    = (next->freq * TB_CYCLE_ANCHOR_PERIOD) / 1000000000;
+        next->mult      = mult;
+
+        /* the previous anchor has returned the nclock before its end at most,
+         * so we start from it if the cycle counter is faster than the monotonic clock,
+         * and slew to the monotonic clock in the next period to keep it continuous and monotonic
+         */
+        if (prev->mult)
+        {
+            tb_hong_t last = prev->nclock + (tb_hong_t)((prev->period * prev->mult) >> TB_CYCLE_MULT_SHIFT);
+            if (last > n)
+            {
+                tb_hong_t error = tb_min(last - n, TB_CYCLE_ANCHOR_PERIOD >> 3);
+                next->nclock    = last;
+                next->mult      = mult - (tb_uint64_t)(((tb_hong_t)mult * error) / TB_CYCLE_ANCHOR_PERIOD);
+            }
+        }
+
+        // publish it after it has been written
+        tb_barrier();
+        g_cycle_anchor = index + 1;
+
+        // the anchor nclock
+        n = next->nclock;
+
+        // trace
+        tb_trace_d("anchor: %lu: frequency: %llu, nclock: %lld", index + 1, next->freq, n);
+    }
+
+    // leave
+    tb_spinlock_leave(&g_cycle_lock);
+
+    // ok
+    return n;
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t tb_cycle_init()
+{
+#ifdef tb_cycle_arch
+    // the cpu counter is invariant?
+    g_cycle_arch = tb_cycle_arch_invariant();
+#endif
+
+    // init the base cycle and nclock for calibration
+    g_cycle_nbase   = tb_nclock();
+    g_cycle_base    = tb_cycle();
+
+    // trace
+    tb_trace_d("init: arch: %s", g_cycle_arch? "ok" : "no");
+
+    // ok
+    return tb_true;
+}
+tb_uint64_t tb_cycle()
+{
+#ifdef tb_cycle_arch
+    // using the cpu counter
+    if (g_cycle_arch) return tb_cycle_arch();
+#endif
+
+    // using the monotonic clock
+    return (tb_uint64_t)tb_nclock();
+}
+tb_uint64_t tb_cycle_frequency()
+{
+    // the frequency
+    tb_uint64_t freq = 0;
+#ifdef tb_cycle_arch
+    if (g_cycle_arch)
+    {
+#   ifdef tb_cycle_arch_frequency
+        freq = tb_cycle_arch_frequency();
+#   else
+        // not anchored? wait the minimum calibration time since init and anchor it
+        while (!(freq = tb_cycle_anchor()->freq))
+        {
+            tb_hong_t dn = tb_nclock() - g_cycle_nbase;
+            if (dn < TB_CYCLE_CALIBRATE_MIN) tb_usleep((tb_size_t)((TB_CYCLE_CALIBRATE_MIN - dn) / 1000));
+            tb_cycle_anchor_make();
+        }
+#   endif
+    }
+#endif
+
+    // the monotonic clock
+    return freq? freq : 1000000000;
+}
+tb_hong_t tb_cycle_to_nclock(tb_uint64_t cycle)
+{
+    // the frequency
+    tb_uint64_t freq = tb_cycle_frequency();
+    tb_assert_and_check_return_val(freq, 0);
+
+    // split it to avoid overflow
+    return (tb_hong_t)((cycle / freq) * 1000000000 + ((cycle % freq) * 1000000000) / freq);
+}
+tb_hong_t tb_cycle_nclock()
+{
+#ifdef tb_cycle_arch
+    if (g_cycle_arch)
+    {
+        // in the current anchor period? 
+        tb_cycle_anchor_t const* anchor = tb_cycle_anchor();
+        tb_uint64_t dc = tb_cycle_arch() - anchor->cycle;
+        if (dc < anchor->period) return anchor->nclock + (tb_hong_t)((dc * anchor->mult) >> TB_CYCLE_MULT_SHIFT);
+
+        // re-anchor it to the monotonic clock, it will not wait the calibration
+        return tb_cycle_anchor_make();
+    }
+#endif
+
+    // using the monotonic clock
+    return tb_nclock();
+}
@@ -0,0 +1,86 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        cycle.h
+ * @ingroup     platform
+ *
+ */
+#ifndef TB_PLATFORM_CYCLE_H
+#define TB_PLATFORM_CYCLE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! the cycle counter
+ *
+ * read the invariant tsc on x86/x64 and the generic timer on arm64,
+ * it is very cheap and suitable for the sub-microsecond timestamps.
+ *
+ * it will fall back to tb_nclock() if the cpu counter is not invariant or not supported.
+ *
+ * @return      the monotonic cycle count
+ */
+tb_uint64_t     tb_cycle(tb_noarg_t);
+
+/*! the cycle frequency
+ *
+ * the tsc frequency is calibrated with the monotonic clock over the time since init and refined periodically,
+ * the first call will wait until at least 10ms have passed since init.
+ *
+ * @return      the cycle count per second
+ */
+tb_uint64_t     tb_cycle_frequency(tb_noarg_t);
+
+/*! convert the cycle count to nanoseconds
+ *
+ * @param cycle the cycle count, .e.g the difference of two tb_cycle()
+ *
+ * @return      the nanoseconds
+ */
+tb_hong_t       tb_cycle_to_nclock(tb_uint64_t cycle);
+
+/*! the monotonic nclock based on the cycle counter
+ *
+ * it is anchored to tb_nclock() and re-anchored every 100ms, 
+ * the error is slewed in the next period, so it tracks tb_nclock() within the microseconds and never goes back.
+ *
+ * it is usually cheaper than tb_nclock() if the cpu counter is invariant, otherwise it is tb_nclock().
+ * it does not wait for the calibration, and it returns tb_nclock() in the first 10ms since init.
+ *
+ * @return      the nclock, ns
+ */
+tb_hong_t       tb_cycle_nclock(tb_noarg_t);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -139,12 +139,12 @@ typedef struct __tb_ltimer_impl_t
  */
 static __tb_inline__ tb_hong_t tb_ltimer_now(tb_ltimer_t* timer)
 {
-    // using the real time?
+    // using the monotonic clock?
     if (!timer->ctime)
     {
         // get the time
-        tb_timeval_t tv = {0};
-        if (tb_gettimeofday(&tv, tb_null)) return ((tb_hong_t)tv.tv_sec * 1000 + tv.tv_usec / 1000);
+        tb_hong_t now = tb_mclock();
+        if (now >= 0) return now;
     }
 
     // using cached time
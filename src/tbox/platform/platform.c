@@ -36,6 +36,9 @@
  */
 __tb_extern_c_enter__
 
+// init cycle
+tb_bool_t   tb_cycle_init(tb_noarg_t);
+
 // init socket context
 tb_bool_t   tb_socket_context_init(tb_noarg_t);
 
@@ -60,6 +63,9 @@ tb_bool_t tb_platform_init(tb_handle_t priv)
     if (!tb_thread_store_init()) return tb_false;
 #endif
 
+    // init cycle
+    if (!tb_cycle_init()) return tb_false;
+
 #ifdef TB_CONFIG_MODULE_HAVE_NETWORK
     // init socket context
     if (!tb_socket_context_init()) return tb_false;
@@ -34,6 +34,8 @@
 #include "file.h"
 #include "time.h"
 #include "mutex.h"
+#include "cycle.h"
+#include "context.h"
 #include "event.h"
 #include "timer.h"
 #include "print.h"
@@ -0,0 +1,78 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        context.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../page.h"
+#include <sys/mman.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the anonymous mapping flag
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#   define MAP_ANONYMOUS        MAP_ANON
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_byte_t* tb_context_stack_init(tb_size_t* psize)
+{
+    // check
+    tb_assert_and_check_return_val(psize && *psize, tb_null);
+
+    // the page size
+    tb_size_t pagesize = tb_page_size();
+    tb_assert_and_check_return_val(pagesize, tb_null);
+
+    // align the stack size
+    tb_size_t size = tb_align(*psize, pagesize);
+
+    // map the stack and the guard page, the pages will be committed lazily after touching them
+    tb_byte_t* data = (tb_byte_t*)mmap(tb_null, size + pagesize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    tb_check_return_val(data != (tb_byte_t*)MAP_FAILED, tb_null);
+
+    // protect the guard page at the stack bottom
+    if (mprotect(data, pagesize, PROT_NONE))
+    {
+        munmap(data, size + pagesize);
+        return tb_null;
+    }
+
+    // ok
+    *psize = size;
+    return data + pagesize;
+}
+tb_void_t tb_context_stack_exit(tb_byte_t* stackdata, tb_size_t stacksize)
+{
+    // check
+    tb_size_t pagesize = tb_page_size();
+    tb_assert_and_check_return(stackdata && pagesize);
+
+    // unmap the stack and the guard page
+    munmap(stackdata - pagesize, stacksize + pagesize);
+}
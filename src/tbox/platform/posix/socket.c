@@ -44,6 +44,154 @@
 #   include <sys/sendfile.h>
 #endif
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the kernel tls abi, see linux/tls.h
+#ifdef TB_CONFIG_OS_LINUX
+#   define TB_SOCKET_KTLS_ENABLE
+#   define TB_SOCKET_KTLS_TCP_ULP           (31)
+#   define TB_SOCKET_KTLS_SOL_TLS           (282)
+#   define TB_SOCKET_KTLS_TX                (1)
+#   define TB_SOCKET_KTLS_RX                (2)
+#   define TB_SOCKET_KTLS_VERSION_1_2       (0x0303)
+#   define TB_SOCKET_KTLS_AES_GCM_128       (51)
+#   define TB_SOCKET_KTLS_AES_GCM_256       (52)
+#   define TB_SOCKET_KTLS_SET_RECORD_TYPE   (1)
+#   define TB_SOCKET_KTLS_RECORD_ALERT      (21)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+#ifdef TB_SOCKET_KTLS_ENABLE
+
+// the kernel tls crypto info type for aes-gcm-128, see struct tls12_crypto_info_aes_gcm_128
+typedef struct __tb_socket_ktls_aes_gcm_128_t
+{
+    tb_uint16_t     version;
+    tb_uint16_t     cipher_type;
+    tb_byte_t       iv[8];
+    tb_byte_t       key[16];
+    tb_byte_t       salt[4];
+    tb_byte_t       rec_seq[8];
+
+}tb_socket_ktls_aes_gcm_128_t;
+
+// the kernel tls crypto info type for aes-gcm-256, see struct tls12_crypto_info_aes_gcm_256
+typedef struct __tb_socket_ktls_aes_gcm_256_t
+{
+    tb_uint16_t     version;
+    tb_uint16_t     cipher_type;
+    tb_byte_t       iv[8];
+    tb_byte_t       key[32];
+    tb_byte_t       salt[4];
+    tb_byte_t       rec_seq[8];
+
+}tb_socket_ktls_aes_gcm_256_t;
+
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#ifdef TB_SOCKET_KTLS_ENABLE
+static tb_bool_t tb_socket_ktls_set(tb_int_t fd, tb_int_t direction, tb_socket_ktls_t const* ktls)
+{
+    // check
+    tb_assert_and_check_return_val(fd >= 0 && ktls, tb_false);
+
+    // only for tls 1.2
+    tb_check_return_val(ktls->version == TB_SOCKET_KTLS_VERSION_1_2, tb_false);
+
+    // attach the tls upper layer protocol, it has been attached if the other direction was installed
+    if (setsockopt(fd, IPPROTO_TCP, TB_SOCKET_KTLS_TCP_ULP, "tls", sizeof("tls")) < 0 && errno != EEXIST) 
+    {
+        // trace
+        tb_trace_d("ktls: attach ulp failed: %d", errno);
+        return tb_false;
+    }
+
+    // install keys
+    tb_int_t r = -1;
+    switch (ktls->cipher)
+    {
+    case TB_SOCKET_KTLS_CIPHER_AES_128_GCM:
+        {
+            tb_socket_ktls_aes_gcm_128_t info;
+            info.version        = ktls->version;
+            info.cipher_type    = TB_SOCKET_KTLS_AES_GCM_128;
+            tb_memcpy(info.iv, ktls->iv, sizeof(info.iv));
+            tb_memcpy(info.key, ktls->key, sizeof(info.key));
+            tb_memcpy(info.salt, ktls->salt, sizeof(info.salt));
+            tb_memcpy(info.rec_seq, ktls->seq, sizeof(info.rec_seq));
+            r = setsockopt(fd, TB_SOCKET_KTLS_SOL_TLS, direction, &info, sizeof(info));
+            tb_memset(&info, 0, sizeof(info));
+        }
+        break;
+    case TB_SOCKET_KTLS_CIPHER_AES_256_GCM:
+        {
+            tb_socket_ktls_aes_gcm_256_t info;
+            info.version        = ktls->version;
+            info.cipher_type    = TB_SOCKET_KTLS_AES_GCM_256;
+            tb_memcpy(info.iv, ktls->iv, sizeof(info.iv));
+            tb_memcpy(info.key, ktls->key, sizeof(info.key));
+            tb_memcpy(info.salt, ktls->salt, sizeof(info.salt));
+            tb_memcpy(info.rec_seq, ktls->seq, sizeof(info.rec_seq));
+            r = setsockopt(fd, TB_SOCKET_KTLS_SOL_TLS, direction, &info, sizeof(info));
+            tb_memset(&info, 0, sizeof(info));
+        }
+        break;
+    default:
+        break;
+    }
+
+    // trace
+    tb_trace_d("ktls: %s: %s", direction == TB_SOCKET_KTLS_TX? "send" : "recv", !r? "ok" : "no");
+
+    // ok?
+    return !r;
+}
+static tb_bool_t tb_socket_ktls_send_alert(tb_int_t fd, tb_byte_t const* alert)
+{
+    // check
+    tb_assert_and_check_return_val(fd >= 0 && alert, tb_false);
+
+    // the alert data: level + description
+    struct iovec iov;
+    iov.iov_base    = (tb_pointer_t)alert;
+    iov.iov_len     = 2;
+
+    // the record type of the kernel tls
+    tb_byte_t       control[CMSG_SPACE(sizeof(tb_byte_t))];
+    struct msghdr   msg;
+    tb_memset(control, 0, sizeof(control));
+    tb_memset(&msg, 0, sizeof(msg));
+    msg.msg_iov         = &iov;
+    msg.msg_iovlen      = 1;
+    msg.msg_control     = control;
+    msg.msg_controllen  = sizeof(control);
+
+    // set the alert record type
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    tb_assert_and_check_return_val(cmsg, tb_false);
+    cmsg->cmsg_level    = TB_SOCKET_KTLS_SOL_TLS;
+    cmsg->cmsg_type     = TB_SOCKET_KTLS_SET_RECORD_TYPE;
+    cmsg->cmsg_len      = CMSG_LEN(sizeof(tb_byte_t));
+    *((tb_byte_t*)CMSG_DATA(cmsg)) = TB_SOCKET_KTLS_RECORD_ALERT;
+
+    // send it
+    tb_long_t real = sendmsg(fd, &msg, 0);
+
+    // trace
+    tb_trace_d("ktls: alert: %u %u: %ld", alert[0], alert[1], real);
+
+    // ok?
+    return real == 2;
+}
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -282,6 +430,31 @@ tb_bool_t tb_socket_ctrl(tb_socket_ref_t sock, tb_size_t ctrl, ...)
             else *pbuff_size = 0;
         }
         break;
+    case TB_SOCKET_CTRL_SET_KTLS_SEND:
+    case TB_SOCKET_CTRL_SET_KTLS_RECV:
+        {
+            // the ktls
+            tb_socket_ktls_t const* ktls = (tb_socket_ktls_t const*)tb_va_arg(args, tb_socket_ktls_t const*);
+            tb_assert_and_check_break(ktls);
+
+#ifdef TB_SOCKET_KTLS_ENABLE
+            // install it
+            ok = tb_socket_ktls_set(fd, ctrl == TB_SOCKET_CTRL_SET_KTLS_SEND? TB_SOCKET_KTLS_TX : TB_SOCKET_KTLS_RX, ktls);
+#endif
+        }
+        break;
+    case TB_SOCKET_CTRL_SEND_KTLS_ALERT:
+        {
+            // the alert
+            tb_byte_t const* alert = (tb_byte_t const*)tb_va_arg(args, tb_byte_t const*);
+            tb_assert_and_check_break(alert);
+
+#ifdef TB_SOCKET_KTLS_ENABLE
+            // send it
+            ok = tb_socket_ktls_send_alert(fd, alert);
+#endif
+        }
+        break;
     default:
         {
             // trace
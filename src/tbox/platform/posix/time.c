@@ -31,6 +31,47 @@
 #include <stdio.h>
 #include <sys/time.h>
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the monotonic clock id
+#if defined(TB_CONFIG_POSIX_HAVE_CLOCK_GETTIME) && defined(CLOCK_MONOTONIC)
+#   define TB_CLOCK_MONOTONIC           CLOCK_MONOTONIC
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+#if defined(TB_CLOCK_MONOTONIC) && defined(CLOCK_MONOTONIC_COARSE)
+/* the clock id for tb_mclock
+ *
+ * 0: not checked
+ * 1: CLOCK_MONOTONIC_COARSE, it's enough for the ms-clock and cheaper
+ * 2: TB_CLOCK_MONOTONIC
+ */
+static tb_size_t    g_mclock_type = 0;
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#ifdef TB_CLOCK_MONOTONIC
+static __tb_inline__ tb_bool_t tb_clock_gettime(clockid_t id, struct timespec* ts)
+{
+    // get the clock time
+    if (!clock_gettime(id, ts)) return tb_true;
+
+    // failed? using the real time
+    tb_timeval_t tv = {0};
+    if (!tb_gettimeofday(&tv, tb_null)) return tb_false;
+    ts->tv_sec  = (time_t)tv.tv_sec;
+    ts->tv_nsec = (long)tv.tv_usec * 1000;
+    return tb_true;
+}
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -52,24 +93,64 @@ tb_void_t tb_sleep(tb_size_t s)
 
 tb_hong_t tb_mclock()
 {
+#if defined(TB_CLOCK_MONOTONIC) && defined(CLOCK_MONOTONIC_COARSE)
+    // check the coarse clock resolution only once
+    tb_size_t type = g_mclock_type;
+    if (!type)
+    {
+        // the coarse clock is only used if its resolution is not larger than 1ms
+        struct timespec res = {0};
+        type = (!clock_getres(CLOCK_MONOTONIC_COARSE, &res) && !res.tv_sec && res.tv_nsec <= 1000000)? 1 : 2;
+        g_mclock_type = type;
+    }
+
+    // get the clock time
+    struct timespec ts = {0};
+    if (!tb_clock_gettime(type == 1? CLOCK_MONOTONIC_COARSE : TB_CLOCK_MONOTONIC, &ts)) return -1;
+    return ((tb_hong_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+#elif defined(TB_CLOCK_MONOTONIC)
+    struct timespec ts = {0};
+    if (!tb_clock_gettime(TB_CLOCK_MONOTONIC, &ts)) return -1;
+    return ((tb_hong_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+#else
     tb_timeval_t tv = {0};
     if (!tb_gettimeofday(&tv, tb_null)) return -1;
     return ((tb_hong_t)tv.tv_sec * 1000 + tv.tv_usec / 1000);
+#endif
 }
 
 tb_hong_t tb_uclock()
 {
+#ifdef TB_CLOCK_MONOTONIC
+    struct timespec ts = {0};
+    if (!tb_clock_gettime(TB_CLOCK_MONOTONIC, &ts)) return -1;
+    return ((tb_hong_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+#else
     tb_timeval_t tv = {0};
     if (!tb_gettimeofday(&tv, tb_null)) return -1;
     return ((tb_hong_t)tv.tv_sec * 1000000 + tv.tv_usec);
+#endif
+}
+
+tb_hong_t tb_nclock()
+{
+#ifdef TB_CLOCK_MONOTONIC
+    struct timespec ts = {0};
+    if (!tb_clock_gettime(TB_CLOCK_MONOTONIC, &ts)) return -1;
+    return ((tb_hong_t)ts.tv_sec * 1000000000 + ts.tv_nsec);
+#else
+    tb_timeval_t tv = {0};
+    if (!tb_gettimeofday(&tv, tb_null)) return -1;
+    return ((tb_hong_t)tv.tv_sec * 1000000000 + (tb_hong_t)tv.tv_usec * 1000);
+#endif
 }
 
 tb_bool_t tb_gettimeofday(tb_timeval_t* tv, tb_timezone_t* tz)
 {
-    // gettimeofday
+    // gettimeofday, only get the timezone if be needed
     struct timeval ttv = {0};
     struct timezone ttz = {0};
-    if (gettimeofday(&ttv, &ttz)) return tb_false;
+    if (gettimeofday(&ttv, tz? &ttz : tb_null)) return tb_false;
 
     // tv
     if (tv) 
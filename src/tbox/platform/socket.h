@@ -68,9 +68,44 @@ typedef enum __tb_socket_ctrl_e
 ,   TB_SOCKET_CTRL_GET_SEND_BUFF_SIZE   = 5
 ,   TB_SOCKET_CTRL_SET_TCP_NODELAY      = 6
 ,   TB_SOCKET_CTRL_GET_TCP_NODELAY      = 7
+,   TB_SOCKET_CTRL_SET_KTLS_SEND        = 8     //!< install the kernel tls keys for sending, arg: tb_socket_ktls_t const*
+,   TB_SOCKET_CTRL_SET_KTLS_RECV        = 9     //!< install the kernel tls keys for receiving, arg: tb_socket_ktls_t const*
+,   TB_SOCKET_CTRL_SEND_KTLS_ALERT      = 10    //!< send an alert record by the kernel tls, arg: tb_byte_t const* (level, description)
 
 }tb_socket_ctrl_e;
 
+/// the socket kernel tls cipher enum
+typedef enum __tb_socket_ktls_cipher_e
+{
+    TB_SOCKET_KTLS_CIPHER_NONE          = 0
+,   TB_SOCKET_KTLS_CIPHER_AES_128_GCM   = 1
+,   TB_SOCKET_KTLS_CIPHER_AES_256_GCM   = 2
+
+}tb_socket_ktls_cipher_e;
+
+/// the socket kernel tls type, the negotiated keys of one direction
+typedef struct __tb_socket_ktls_t
+{
+    /// the tls version, .e.g 0x0303 for tls 1.2
+    tb_uint16_t                         version;
+
+    /// the cipher
+    tb_uint16_t                         cipher;
+
+    /// the key, 16 bytes for aes-128-gcm and 32 bytes for aes-256-gcm
+    tb_byte_t                           key[32];
+
+    /// the implicit iv (salt)
+    tb_byte_t                           salt[4];
+
+    /// the explicit iv of the next record
+    tb_byte_t                           iv[8];
+
+    /// the sequence number of the next record, big-endian
+    tb_byte_t                           seq[8];
+
+}tb_socket_ktls_t, *tb_socket_ktls_ref_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -56,6 +56,11 @@ tb_hong_t tb_uclock()
     tb_trace_noimpl();
     return 0;
 }
+tb_hong_t tb_nclock()
+{
+    tb_trace_noimpl();
+    return 0;
+}
 tb_bool_t tb_gettimeofday(tb_timeval_t* tv, tb_timezone_t* tz)
 {
     tb_trace_noimpl();
@@ -57,17 +57,29 @@ tb_void_t       tb_msleep(tb_size_t ms);
 tb_void_t       tb_sleep(tb_size_t s);
 
 /*! clock, ms
+ *
+ * the monotonic clock, it will not jump if the system time is changed
  *
  * @return      the mclock
  */
 tb_hong_t       tb_mclock(tb_noarg_t);
 
 /*! uclock, us
+ *
+ * the monotonic clock, it will not jump if the system time is changed
  *
  * @return      the uclock
  */
 tb_hong_t       tb_uclock(tb_noarg_t);
 
+/*! nclock, ns
+ *
+ * the monotonic clock, it will not jump if the system time is changed
+ *
+ * @return      the nclock
+ */
+tb_hong_t       tb_nclock(tb_noarg_t);
+
 /*! get the time from 1970-01-01 00:00:00:000
  *
  * @param tv    the timeval
@@ -0,0 +1,69 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        context.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../page.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_byte_t* tb_context_stack_init(tb_size_t* psize)
+{
+    // check
+    tb_assert_and_check_return_val(psize && *psize, tb_null);
+
+    // the page size
+    tb_size_t pagesize = tb_page_size();
+    tb_assert_and_check_return_val(pagesize, tb_null);
+
+    // align the stack size
+    tb_size_t size = tb_align(*psize, pagesize);
+
+    // reserve and commit the stack and the guard page
+    tb_byte_t* data = (tb_byte_t*)VirtualAlloc(tb_null, size + pagesize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    tb_check_return_val(data, tb_null);
+
+    // protect the guard page at the stack bottom
+    DWORD protect = 0;
+    if (!VirtualProtect(data, pagesize, PAGE_NOACCESS, &protect))
+    {
+        VirtualFree(data, 0, MEM_RELEASE);
+        return tb_null;
+    }
+
+    // ok
+    *psize = size;
+    return data + pagesize;
+}
+tb_void_t tb_context_stack_exit(tb_byte_t* stackdata, tb_size_t stacksize)
+{
+    // check
+    tb_size_t pagesize = tb_page_size();
+    tb_assert_and_check_return(stackdata && pagesize);
+
+    // free the stack and the guard page
+    VirtualFree(stackdata - pagesize, 0, MEM_RELEASE);
+}
@@ -59,6 +59,19 @@ tb_hong_t tb_uclock()
     
     return (t.QuadPart * 1000000) / f.QuadPart;
 }
+tb_hong_t tb_nclock()
+{
+    LARGE_INTEGER f = {{0}};
+    if (!QueryPerformanceFrequency(&f)) return 0;
+    tb_assert_and_check_return_val(f.QuadPart, 0);
+
+    LARGE_INTEGER t = {{0}};
+    if (!QueryPerformanceCounter(&t)) return 0;
+    tb_assert_and_check_return_val(t.QuadPart, 0);
+    
+    // split it to avoid overflow
+    return (t.QuadPart / f.QuadPart) * 1000000000 + ((t.QuadPart % f.QuadPart) * 1000000000) / f.QuadPart;
+}
 tb_bool_t tb_gettimeofday(tb_timeval_t* tv, tb_timezone_t* tz)
 {
     union 
@@ -142,7 +142,7 @@
 #       define TB_ARCH_ARM_THUMB
 #       define TB_ARCH_STRING_2             "_thumb"
 #   endif
-#   if defined(__ARM_NEON__)
+#   if defined(__ARM_NEON__) || defined(__ARM_NEON)
 #       define TB_ARCH_ARM_NEON
 #       define TB_ARCH_STRING_3             "_neon"
 #   endif 
@@ -175,6 +175,11 @@
 #       undef TB_ARCH_STRING_2
 #       define TB_ARCH_STRING_2             "_sse3"
 #   endif
+#   if defined(__SSSE3__)
+#       define TB_ARCH_SSSE3
+#       undef TB_ARCH_STRING_2
+#       define TB_ARCH_STRING_2             "_ssse3"
+#   endif
 #endif
 
 // vfp
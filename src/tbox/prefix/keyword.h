@@ -121,6 +121,16 @@
 #   define __tb_unlikely__(x)                   (x)
 #endif
 
+/*! @def __tb_thread_local__
+ *
+ * the thread local storage keyword, it will be not defined if the compiler does not support it
+ */
+#if defined(TB_COMPILER_IS_MSVC)
+#   define __tb_thread_local__                  __declspec(thread)
+#elif defined(TB_COMPILER_IS_GCC)
+#   define __tb_thread_local__                  __thread
+#endif
+
 // debug
 #ifdef __tb_debug__
 #   define __tb_debug_decl__                    , tb_char_t const* func_, tb_size_t line_, tb_char_t const* file_
@@ -412,6 +412,17 @@ tb_async_stream_ref_t   tb_async_stream_init_filter_from_charset(tb_async_stream
  */
 tb_async_stream_ref_t   tb_async_stream_init_filter_from_chunked(tb_async_stream_ref_t stream, tb_bool_t dechunked);
 
+/*! init filter stream from varint
+ *
+ * @param stream        the stream
+ * @param width         the integer width, 4 or 8 bytes
+ * @param zigzag        the signed integers with the zigzag encoding?
+ * @param decode        decode the varint data?
+ *
+ * @return              the stream
+ */
+tb_async_stream_ref_t   tb_async_stream_init_filter_from_varint(tb_async_stream_ref_t stream, tb_size_t width, tb_bool_t zigzag, tb_bool_t decode);
+
 /*! the stream url
  *
  * @param stream        the stream
@@ -53,6 +53,7 @@ typedef enum __tb_stream_filter_type_e
 ,   TB_STREAM_FILTER_TYPE_CACHE     = 2
 ,   TB_STREAM_FILTER_TYPE_CHARSET   = 3
 ,   TB_STREAM_FILTER_TYPE_CHUNKED   = 4
+,   TB_STREAM_FILTER_TYPE_VARINT    = 5
 
 }tb_stream_filter_type_e;
 
@@ -106,6 +107,18 @@ tb_stream_filter_ref_t  tb_stream_filter_init_from_charset(tb_size_t fr, tb_size
  */
 tb_stream_filter_ref_t  tb_stream_filter_init_from_chunked(tb_bool_t dechunked);
 
+/*! init filter from varint
+ *
+ * encode the little-endian uint32/uint64 integers to the leb128 varints or decode them
+ *
+ * @param width         the integer width, 4 or 8 bytes
+ * @param zigzag        the signed integers with the zigzag encoding?
+ * @param decode        decode the varint data?
+ *
+ * @return              the filter
+ */
+tb_stream_filter_ref_t  tb_stream_filter_init_from_varint(tb_size_t width, tb_bool_t zigzag, tb_bool_t decode);
+
 /*! init filter from cache
  *
  * @param size          the initial cache size, using the default size if be zero
@@ -282,6 +282,10 @@ static tb_size_t tb_async_stream_sock_impl_open_ssl(tb_async_stream_sock_impl_t*
     // init ssl aico
     tb_aicp_ssl_set_aico(impl->hssl, impl->aico);
 
+    // init ssl peer for resuming the last session
+    tb_url_ref_t url = tb_async_stream_url((tb_async_stream_ref_t)impl);
+    if (url && tb_url_host(url)) tb_aicp_ssl_set_peer(impl->hssl, tb_url_host(url), tb_url_port(url));
+
     // init ssl timeout
     tb_aicp_ssl_set_timeout(impl->hssl, tb_async_stream_timeout((tb_async_stream_ref_t)impl));
 
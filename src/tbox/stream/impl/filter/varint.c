@@ -0,0 +1,195 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        varint.c
+ *
+ */
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "varint"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../../../utils/varint.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the varint filter type
+typedef struct __tb_stream_filter_varint_t
+{
+    // the filter base
+    tb_stream_filter_impl_t     base;
+
+    // the integer width, 4 or 8 bytes
+    tb_size_t                   width;
+
+    // using the zigzag encoding for the signed integer?
+    tb_bool_t                   zigzag;
+
+    // decode the varint data?
+    tb_bool_t                   decode;
+
+}tb_stream_filter_varint_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static __tb_inline__ tb_stream_filter_varint_t* tb_stream_filter_varint_cast(tb_stream_filter_impl_t* filter)
+{
+    // check
+    tb_assert_and_check_return_val(filter && filter->type == TB_STREAM_FILTER_TYPE_VARINT, tb_null);
+    return (tb_stream_filter_varint_t*)filter;
+}
+/* the varint data
+ *
+ * encode: [u32/u64 little-endian][u32/u64 little-endian]... => [leb128 varint][leb128 varint]...
+ * decode: [leb128 varint][leb128 varint]... => [u32/u64 little-endian][u32/u64 little-endian]...
+ */
+static tb_long_t tb_stream_filter_varint_spak(tb_stream_filter_impl_t* filter, tb_static_stream_ref_t istream, tb_static_stream_ref_t ostream, tb_long_t sync)
+{
+    // check
+    tb_stream_filter_varint_t* vfilter = tb_stream_filter_varint_cast(filter);
+    tb_assert_and_check_return_val(vfilter && istream && ostream, -1);
+    tb_assert_and_check_return_val(tb_static_stream_valid(ostream), -1);
+
+    // the idata, @note istream maybe null for sync the end data
+    tb_byte_t const*    ip = istream->p;
+    tb_byte_t const*    ie = istream->e;
+    if (!ip) ie = ip;
+
+    // the odata
+    tb_byte_t*          op = (tb_byte_t*)tb_static_stream_pos(ostream);
+    tb_byte_t*          oe = (tb_byte_t*)tb_static_stream_end(ostream);
+    tb_byte_t*          ob = op;
+
+    // the width
+    tb_size_t           width = vfilter->width;
+
+    // decode
+    tb_bool_t           failed = tb_false;
+    if (vfilter->decode)
+    {
+        while (ip < ie && op + width <= oe)
+        {
+            // decode the next varint
+            tb_uint64_t val = 0;
+            tb_size_t   n = tb_varint_decode_u64(ip, ie - ip, &val);
+            if (!n) 
+            {
+                // invalid varint? or wait the more data
+                failed = (ie - ip >= TB_VARINT_MAXN_U64) || sync < 0;
+                break;
+            }
+
+            // the signed value?
+            if (vfilter->zigzag) val = (tb_uint64_t)tb_zigzag_decode_u64(val);
+
+            // save it
+            if (width == 8) tb_bits_set_u64_le(op, val);
+            else tb_bits_set_u32_le(op, (tb_uint32_t)val);
+            ip += n;
+            op += width;
+        }
+    }
+    // encode
+    else
+    {
+        while (ip + width <= ie && op + TB_VARINT_MAXN_U64 <= oe)
+        {
+            // the value
+            tb_uint64_t val;
+            if (width == 8) val = vfilter->zigzag? tb_zigzag_encode_s64(tb_bits_get_s64_le(ip)) : tb_bits_get_u64_le(ip);
+            else val = vfilter->zigzag? tb_zigzag_encode_s32(tb_bits_get_s32_le(ip)) : tb_bits_get_u32_le(ip);
+
+            // encode it
+            op += tb_varint_encode_u64(op, val);
+            ip += width;
+        }
+
+        // the truncated value at the end?
+        if (sync < 0 && ip < ie && ip + width > ie) failed = tb_true;
+    }
+
+    // update stream
+    if (istream->p) tb_static_stream_goto(istream, (tb_byte_t*)ip);
+    tb_static_stream_goto(ostream, op);
+
+    // trace
+    tb_trace_d("[%p]: spak: %lu, failed: %d, ileft: %lu", vfilter, op - ob, failed, ie - ip);
+
+    // failed and no output? end
+    if (failed && op == ob) 
+    {
+        // drop the invalid data
+        if (istream->p) tb_static_stream_goto(istream, (tb_byte_t*)ie);
+        return -1;
+    }
+
+    // ok
+    return (op - ob);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+tb_stream_filter_ref_t tb_stream_filter_init_from_varint(tb_size_t width, tb_bool_t zigzag, tb_bool_t decode)
+{
+    // check
+    tb_assert_and_check_return_val(width == 4 || width == 8, tb_null);
+
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_stream_filter_varint_t*  filter = tb_null;
+    do
+    {
+        // make filter
+        filter = tb_malloc0_type(tb_stream_filter_varint_t);
+        tb_assert_and_check_break(filter);
+
+        // init filter 
+        if (!tb_stream_filter_impl_init((tb_stream_filter_impl_t*)filter, TB_STREAM_FILTER_TYPE_VARINT)) break;
+        filter->base.spak = tb_stream_filter_varint_spak;
+
+        // init the varint type
+        filter->width   = width;
+        filter->zigzag  = zigzag;
+        filter->decode  = decode;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit filter
+        tb_stream_filter_exit((tb_stream_filter_ref_t)filter);
+        filter = tb_null;
+    }
+
+    // ok?
+    return (tb_stream_filter_ref_t)filter;
+}
@@ -578,3 +578,41 @@ tb_stream_ref_t tb_stream_init_filter_from_chunked(tb_stream_ref_t stream, tb_bo
     return impl;
 }
 #endif
+tb_stream_ref_t tb_stream_init_filter_from_varint(tb_stream_ref_t stream, tb_size_t width, tb_bool_t zigzag, tb_bool_t decode)
+{
+    // check
+    tb_assert_and_check_return_val(stream, tb_null);
+
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_stream_ref_t     impl = tb_null;
+    do
+    {
+        // init stream
+        impl = tb_stream_init_filter();
+        tb_assert_and_check_break(impl);
+
+        // set stream
+        if (!tb_stream_ctrl(impl, TB_STREAM_CTRL_FLTR_SET_STREAM, stream)) break;
+
+        // set filter
+        ((tb_stream_filter_impl_t*)impl)->bref = tb_false;
+        ((tb_stream_filter_impl_t*)impl)->filter = tb_stream_filter_init_from_varint(width, zigzag, decode);
+        tb_assert_and_check_break(((tb_stream_filter_impl_t*)impl)->filter);
+ 
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) tb_stream_exit(impl);
+        impl = tb_null;
+    }
+
+    // ok
+    return impl;
+}
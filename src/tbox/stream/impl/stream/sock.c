@@ -212,6 +212,9 @@ static tb_bool_t tb_stream_sock_impl_open(tb_stream_ref_t stream)
                         // init bio
                         tb_ssl_set_bio_sock(impl->hssl, impl->sock);
 
+                        // init peer for resuming the last session
+                        if (tb_url_host(url)) tb_ssl_set_peer(impl->hssl, tb_url_host(url), tb_url_port(url));
+
                         // init timeout
                         tb_ssl_set_timeout(impl->hssl, tb_stream_timeout(stream));
 
@@ -0,0 +1,409 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        static_bits.c
+ * @ingroup     stream
+ *
+ */
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "static_bits.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t tb_static_bits_reader_init(tb_static_bits_reader_ref_t reader, tb_static_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(reader && stream && stream->p && stream->p <= stream->e, tb_false);
+
+    // init
+    reader->stream  = stream;
+    reader->p       = stream->p;
+    reader->e       = stream->e;
+    reader->cache   = 0;
+    reader->count   = 0;
+    reader->error   = tb_false;
+
+    // skip the bit offset of the stream
+    return stream->b? tb_static_bits_reader_skip(reader, stream->b) : tb_true;
+}
+tb_bool_t tb_static_bits_reader_exit(tb_static_bits_reader_ref_t reader)
+{
+    // check
+    tb_assert_and_check_return_val(reader && reader->stream, tb_false);
+
+    // sync the stream position to the next unread bit
+    tb_static_stream_ref_t stream = reader->stream;
+    stream->p = (tb_byte_t*)reader->p - ((reader->count + 7) >> 3);
+    stream->b = (8 - (reader->count & 7)) & 7;
+
+    // ok?
+    return !reader->error;
+}
+tb_size_t tb_static_bits_reader_left(tb_static_bits_reader_ref_t reader)
+{
+    // check
+    tb_assert_and_check_return_val(reader, 0);
+
+    // the left bits
+    return reader->count + ((reader->e - reader->p) << 3);
+}
+tb_void_t tb_static_bits_reader_fill_tail(tb_static_bits_reader_ref_t reader)
+{
+    // check
+    tb_assert_and_check_return(reader);
+
+    // load the left bytes one by one
+    tb_byte_t const*    p = reader->p;
+    tb_byte_t const*    e = reader->e;
+    tb_uint64_t         c = reader->cache;
+    tb_size_t           n = reader->count;
+    while (n < 56 && p < e) 
+    {
+        c |= (tb_uint64_t)*p++ << (56 - n);
+        n += 8;
+    }
+
+    // update the cache
+    reader->p       = p;
+    reader->cache   = c;
+    reader->count   = n;
+}
+tb_bool_t tb_static_bits_reader_skip_bits(tb_static_bits_reader_ref_t reader, tb_size_t nbits)
+{
+    // check
+    tb_assert_and_check_return_val(reader, tb_false);
+
+    // skip the cached bits directly
+    if (nbits <= 32) return tb_static_bits_reader_skip(reader, nbits);
+
+    // overflow?
+    if (nbits > tb_static_bits_reader_left(reader))
+    {
+        reader->error = tb_true;
+        return tb_false;
+    }
+
+    // drop the cache and skip the whole bytes
+    tb_size_t left = nbits - reader->count;
+    reader->p      += left >> 3;
+    reader->cache   = 0;
+    reader->count   = 0;
+
+    // skip the left bits
+    return tb_static_bits_reader_skip(reader, left & 7);
+}
+tb_void_t tb_static_bits_reader_align(tb_static_bits_reader_ref_t reader)
+{
+    // check
+    tb_assert_and_check_return(reader);
+
+    // the read bits of the cache are always the whole bytes, so we only need to drop the left bits of the current byte
+    tb_size_t n = reader->count & 7;
+    reader->cache <<= n;
+    reader->count -= n;
+}
+tb_uint64_t tb_static_bits_reader_read_ubits64(tb_static_bits_reader_ref_t reader, tb_size_t nbits)
+{
+    // check
+    tb_assert_and_check_return_val(reader && nbits <= 64, 0);
+
+    // read the high and low bits
+    if (nbits > 32)
+    {
+        tb_uint64_t h = tb_static_bits_reader_read_ubits32(reader, nbits - 32);
+        return (h << 32) | tb_static_bits_reader_read_ubits32(reader, 32);
+    }
+    return tb_static_bits_reader_read_ubits32(reader, nbits);
+}
+tb_sint32_t tb_static_bits_reader_read_sbits32(tb_static_bits_reader_ref_t reader, tb_size_t nbits)
+{
+    // check
+    tb_assert_and_check_return_val(reader && nbits <= 32, 0);
+
+    // no nbits?
+    tb_check_return_val(nbits, 0);
+
+    // read it and extend the sign bit
+    tb_uint32_t val = tb_static_bits_reader_read_ubits32(reader, nbits);
+    return nbits < 32? (tb_sint32_t)(val << (32 - nbits)) >> (32 - nbits) : (tb_sint32_t)val;
+}
+tb_uint32_t tb_static_bits_reader_read_ue_slow(tb_static_bits_reader_ref_t reader)
+{
+    // check
+    tb_assert_and_check_return_val(reader, 0);
+
+    // count the leading zero bits
+    tb_size_t n = 0;
+    while (!tb_static_bits_reader_peek_ubits32(reader, 1))
+    {
+        // invalid code or overflow?
+        if (n >= 31 || !tb_static_bits_reader_skip(reader, 1))
+        {
+            reader->error = tb_true;
+            return 0;
+        }
+        n++;
+    }
+
+    // read the info bits with the leading bit 1
+    tb_uint32_t val = tb_static_bits_reader_read_ubits32(reader, n + 1);
+    return val? val - 1 : 0;
+}
+tb_sint32_t tb_static_bits_reader_read_se(tb_static_bits_reader_ref_t reader)
+{
+    // read the unsigned code
+    tb_uint32_t val = tb_static_bits_reader_read_ue(reader);
+
+    // 1 => 1, 2 => -1, 3 => 2, 4 => -2, ...
+    return (val & 1)? (tb_sint32_t)((val >> 1) + 1) : -(tb_sint32_t)(val >> 1);
+}
+tb_uint64_t tb_static_bits_reader_read_uleb128(tb_static_bits_reader_ref_t reader)
+{
+    // check
+    tb_assert_and_check_return_val(reader, 0);
+
+    // fill cache
+    if (reader->count < 56) tb_static_bits_reader_fill(reader);
+
+    // decode the first byte directly
+    tb_uint64_t val = 0;
+    tb_size_t   byte = (tb_size_t)(reader->cache >> 56);
+    if (__tb_likely__(!(byte & 0x80) && reader->count >= 8))
+    {
+        reader->cache <<= 8;
+        reader->count -= 8;
+        return byte;
+    }
+
+    // decode the left bytes, the ten bytes at most
+    tb_size_t shift = 0;
+    for (shift = 0; shift < 64; shift += 7)
+    {
+        // read the next byte
+        if (reader->count < 8) tb_static_bits_reader_fill(reader);
+        if (reader->count < 8) break;
+        byte = (tb_size_t)(reader->cache >> 56);
+        reader->cache <<= 8;
+        reader->count -= 8;
+
+        // append it
+        val |= (tb_uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return val;
+    }
+
+    // truncated or too long
+    reader->error = tb_true;
+    return 0;
+}
+tb_sint64_t tb_static_bits_reader_read_sleb128(tb_static_bits_reader_ref_t reader)
+{
+    // check
+    tb_assert_and_check_return_val(reader, 0);
+
+    // decode bytes, the ten bytes at most
+    tb_size_t   byte = 0;
+    tb_size_t   shift = 0;
+    tb_uint64_t val = 0;
+    do
+    {
+        // truncated or too long?
+        if (shift >= 64 || (reader->count < 8 && (tb_static_bits_reader_fill(reader), reader->count < 8)))
+        {
+            reader->error = tb_true;
+            return 0;
+        }
+
+        // read the next byte
+        byte = (tb_size_t)(reader->cache >> 56);
+        reader->cache <<= 8;
+        reader->count -= 8;
+
+        // append it
+        val |= (tb_uint64_t)(byte & 0x7f) << shift;
+        shift += 7;
+
+    } while (byte & 0x80);
+
+    // extend the sign bit
+    if (shift < 64 && (byte & 0x40)) val |= ~(tb_uint64_t)0 << shift;
+    return (tb_sint64_t)val;
+}
+tb_sint64_t tb_static_bits_reader_read_zigzag(tb_static_bits_reader_ref_t reader)
+{
+    // read the unsigned varint
+    tb_uint64_t val = tb_static_bits_reader_read_uleb128(reader);
+
+    // decode it
+    return (tb_sint64_t)(val >> 1) ^ -(tb_sint64_t)(val & 1);
+}
+tb_bool_t tb_static_bits_writer_init(tb_static_bits_writer_ref_t writer, tb_static_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(writer && stream && stream->p && stream->p <= stream->e, tb_false);
+
+    // init
+    writer->stream  = stream;
+    writer->p       = stream->p;
+    writer->e       = stream->e;
+    writer->cache   = 0;
+    writer->count   = 0;
+    writer->error   = tb_false;
+
+    // keep the written high bits of the current byte
+    if (stream->b)
+    {
+        // check
+        tb_assert_and_check_return_val(stream->p < stream->e, tb_false);
+
+        // load them
+        writer->cache = (tb_uint64_t)(*stream->p & (0xff << (8 - stream->b))) << 56;
+        writer->count = stream->b;
+    }
+
+    // ok
+    return tb_true;
+}
+tb_bool_t tb_static_bits_writer_exit(tb_static_bits_writer_ref_t writer)
+{
+    // check
+    tb_assert_and_check_return_val(writer && writer->stream && writer->count < 32, tb_false);
+
+    // flush the whole bytes
+    tb_byte_t*  p = writer->p;
+    tb_byte_t*  e = writer->e;
+    tb_size_t   n = writer->count;
+    tb_uint64_t c = writer->cache;
+    for (; n >= 8 && p < e; n -= 8, c <<= 8) *p++ = (tb_byte_t)(c >> 56);
+
+    // flush the last partial byte and keep the unwritten low bits
+    if (n >= 8 || (n && p >= e)) writer->error = tb_true;
+    else if (n) *p = (tb_byte_t)((*p & (0xff >> n)) | (c >> 56));
+
+    // sync the stream position
+    if (!writer->error)
+    {
+        writer->stream->p = p;
+        writer->stream->b = n;
+    }
+
+    // reset the cache
+    writer->p       = p;
+    writer->cache   = c;
+    writer->count   = n;
+
+    // ok?
+    return !writer->error;
+}
+tb_void_t tb_static_bits_writer_flush(tb_static_bits_writer_ref_t writer)
+{
+    // check
+    tb_assert_and_check_return(writer && writer->count >= 32);
+
+    // overflow?
+    if (__tb_unlikely__(writer->p + 4 > writer->e)) 
+    {
+        // discard it
+        writer->error = tb_true;
+        writer->cache <<= 32;
+        writer->count -= 32;
+        return ;
+    }
+
+    // flush the high 32-bits word
+    tb_bits_set_u32_be(writer->p, (tb_uint32_t)(writer->cache >> 32));
+    writer->p       += 4;
+    writer->cache  <<= 32;
+    writer->count   -= 32;
+}
+tb_void_t tb_static_bits_writer_writ_ubits64(tb_static_bits_writer_ref_t writer, tb_uint64_t val, tb_size_t nbits)
+{
+    // check
+    tb_assert_and_check_return(writer && nbits <= 64);
+
+    // writ the high and low bits
+    if (nbits > 32)
+    {
+        tb_static_bits_writer_writ_ubits32(writer, (tb_uint32_t)(val >> 32), nbits - 32);
+        tb_static_bits_writer_writ_ubits32(writer, (tb_uint32_t)val, 32);
+    }
+    else tb_static_bits_writer_writ_ubits32(writer, (tb_uint32_t)val, nbits);
+}
+tb_void_t tb_static_bits_writer_align(tb_static_bits_writer_ref_t writer)
+{
+    // check
+    tb_assert_and_check_return(writer);
+
+    // pad the zero bits
+    tb_size_t n = (8 - (writer->count & 7)) & 7;
+    if (n) tb_static_bits_writer_writ_ubits32(writer, 0, n);
+}
+tb_void_t tb_static_bits_writer_writ_ue(tb_static_bits_writer_ref_t writer, tb_uint32_t val)
+{
+    // check
+    tb_assert_and_check_return(writer && val < 0xffffffff);
+
+    // the code: [n zero bits][val + 1 with n + 1 bits]
+    tb_uint32_t v = val + 1;
+    tb_size_t   n = 31 - tb_bits_cl0_u32_be(v);
+    tb_static_bits_writer_writ_ubits64(writer, v, (n << 1) + 1);
+}
+tb_void_t tb_static_bits_writer_writ_se(tb_static_bits_writer_ref_t writer, tb_sint32_t val)
+{
+    // 1 => 1, -1 => 2, 2 => 3, -2 => 4, ...
+    tb_static_bits_writer_writ_ue(writer, val > 0? ((tb_uint32_t)val << 1) - 1 : (tb_uint32_t)(-(tb_sint64_t)val) << 1);
+}
+tb_void_t tb_static_bits_writer_writ_uleb128(tb_static_bits_writer_ref_t writer, tb_uint64_t val)
+{
+    // check
+    tb_assert_and_check_return(writer);
+
+    // writ the low 7 bits with the continuation bit
+    while (val >= 0x80)
+    {
+        tb_static_bits_writer_writ_ubits32(writer, (tb_uint32_t)(val & 0x7f) | 0x80, 8);
+        val >>= 7;
+    }
+    tb_static_bits_writer_writ_ubits32(writer, (tb_uint32_t)val, 8);
+}
+tb_void_t tb_static_bits_writer_writ_sleb128(tb_static_bits_writer_ref_t writer, tb_sint64_t val)
+{
+    // check
+    tb_assert_and_check_return(writer);
+
+    // writ the low 7 bits until the left bits are the sign bits
+    while (1)
+    {
+        tb_uint32_t byte = (tb_uint32_t)(val & 0x7f);
+        val >>= 7;
+        if ((!val && !(byte & 0x40)) || (val == -1 && (byte & 0x40)))
+        {
+            tb_static_bits_writer_writ_ubits32(writer, byte, 8);
+            break;
+        }
+        tb_static_bits_writer_writ_ubits32(writer, byte | 0x80, 8);
+    }
+}
+tb_void_t tb_static_bits_writer_writ_zigzag(tb_static_bits_writer_ref_t writer, tb_sint64_t val)
+{
+    // encode it
+    tb_static_bits_writer_writ_uleb128(writer, ((tb_uint64_t)val << 1) ^ (tb_uint64_t)(val >> 63));
+}
@@ -0,0 +1,457 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        static_bits.h
+ * @ingroup     stream
+ *
+ */
+#ifndef TB_STREAM_STATIC_BITS_H
+#define TB_STREAM_STATIC_BITS_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "static_stream.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the static bits reader type
+ *
+ * the buffered bits reader of the static stream, 
+ * the unread bits are cached in a 64-bits accumulator which is refilled by the unaligned big-endian loads
+ *
+ * <pre>
+ * tb_static_bits_reader_t reader;
+ * if (tb_static_bits_reader_init(&reader, stream))
+ * {
+ *     tb_uint32_t type = tb_static_bits_reader_read_ubits32(&reader, 5);
+ *     tb_uint32_t size = tb_static_bits_reader_read_ue(&reader);
+ *
+ *     // sync the stream position
+ *     tb_static_bits_reader_exit(&reader);
+ * }
+ * </pre>
+ */
+typedef struct __tb_static_bits_reader_t
+{
+    /// the stream
+    tb_static_stream_ref_t  stream;
+
+    /// the pointer to the next byte which will be loaded into the cache
+    tb_byte_t const*        p;
+
+    /// the pointer to the end
+    tb_byte_t const*        e;
+
+    /// the bits cache, the unread bits are aligned to the highest bit
+    tb_uint64_t             cache;
+
+    /// the unread bits count of the cache
+    tb_size_t               count;
+
+    /// have been failed? read the overflow data or invalid code
+    tb_bool_t               error;
+
+}tb_static_bits_reader_t;
+
+/*! the static bits writer type
+ *
+ * the buffered bits writer of the static stream, 
+ * the written bits are cached in a 64-bits accumulator and flushed as the big-endian 32-bits words
+ */
+typedef struct __tb_static_bits_writer_t
+{
+    /// the stream
+    tb_static_stream_ref_t  stream;
+
+    /// the pointer to the next byte which will be flushed from the cache
+    tb_byte_t*              p;
+
+    /// the pointer to the end
+    tb_byte_t*              e;
+
+    /// the bits cache, the pending bits are aligned to the highest bit
+    tb_uint64_t             cache;
+
+    /// the pending bits count of the cache, < 32
+    tb_size_t               count;
+
+    /// have been failed? write the overflow data
+    tb_bool_t               error;
+
+}tb_static_bits_writer_t;
+
+/// the static bits reader ref type
+typedef tb_static_bits_reader_t*    tb_static_bits_reader_ref_t;
+
+/// the static bits writer ref type
+typedef tb_static_bits_writer_t*    tb_static_bits_writer_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the bits reader from the current position of the stream
+ *
+ * @note the stream position will be not updated until tb_static_bits_reader_exit() is called
+ *
+ * @param reader    the reader
+ * @param stream    the stream
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_static_bits_reader_init(tb_static_bits_reader_ref_t reader, tb_static_stream_ref_t stream);
+
+/*! exit the bits reader and sync the stream position to the next unread bit
+ *
+ * @param reader    the reader
+ *
+ * @return          tb_true or tb_false if the reader have been failed
+ */
+tb_bool_t           tb_static_bits_reader_exit(tb_static_bits_reader_ref_t reader);
+
+/*! the left bits count of the reader
+ *
+ * @param reader    the reader
+ *
+ * @return          the left bits count
+ */
+tb_size_t           tb_static_bits_reader_left(tb_static_bits_reader_ref_t reader);
+
+/*! refill the bits cache slowly near the end of the data
+ *
+ * @param reader    the reader
+ */
+tb_void_t           tb_static_bits_reader_fill_tail(tb_static_bits_reader_ref_t reader);
+
+/*! skip the given bits 
+ *
+ * @param reader    the reader
+ * @param nbits     the bits count
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_static_bits_reader_skip_bits(tb_static_bits_reader_ref_t reader, tb_size_t nbits);
+
+/*! align the reader to the next byte boundary
+ *
+ * @param reader    the reader
+ */
+tb_void_t           tb_static_bits_reader_align(tb_static_bits_reader_ref_t reader);
+
+/*! read the ubits for uint64
+ *
+ * @param reader    the reader
+ * @param nbits     the bits count, <= 64
+ *
+ * @return          the value
+ */
+tb_uint64_t         tb_static_bits_reader_read_ubits64(tb_static_bits_reader_ref_t reader, tb_size_t nbits);
+
+/*! read the sbits for sint32
+ *
+ * @param reader    the reader
+ * @param nbits     the bits count, <= 32
+ *
+ * @return          the value
+ */
+tb_sint32_t         tb_static_bits_reader_read_sbits32(tb_static_bits_reader_ref_t reader, tb_size_t nbits);
+
+/*! read the unsigned exp-golomb code slowly, only for the long code or near the end of the data
+ *
+ * @param reader    the reader
+ *
+ * @return          the value
+ */
+tb_uint32_t         tb_static_bits_reader_read_ue_slow(tb_static_bits_reader_ref_t reader);
+
+/*! read the signed exp-golomb code, se(v)
+ *
+ * @param reader    the reader
+ *
+ * @return          the value
+ */
+tb_sint32_t         tb_static_bits_reader_read_se(tb_static_bits_reader_ref_t reader);
+
+/*! read the unsigned leb128 varint
+ *
+ * @param reader    the reader
+ *
+ * @return          the value, the reader will be failed if the varint is truncated or too long
+ */
+tb_uint64_t         tb_static_bits_reader_read_uleb128(tb_static_bits_reader_ref_t reader);
+
+/*! read the signed leb128 varint
+ *
+ * @param reader    the reader
+ *
+ * @return          the value
+ */
+tb_sint64_t         tb_static_bits_reader_read_sleb128(tb_static_bits_reader_ref_t reader);
+
+/*! read the zigzag varint, the unsigned leb128 varint of the zigzag encoded value
+ *
+ * @param reader    the reader
+ *
+ * @return          the value
+ */
+tb_sint64_t         tb_static_bits_reader_read_zigzag(tb_static_bits_reader_ref_t reader);
+
+/*! init the bits writer from the current position of the stream
+ *
+ * @note the stream position will be not updated until tb_static_bits_writer_exit() is called
+ *
+ * @param writer    the writer
+ * @param stream    the stream
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_static_bits_writer_init(tb_static_bits_writer_ref_t writer, tb_static_stream_ref_t stream);
+
+/*! exit the bits writer, flush the pending bits and sync the stream position 
+ *
+ * @note the unwritten low bits of the last partial byte will be kept
+ *
+ * @param writer    the writer
+ *
+ * @return          tb_true or tb_false if the writer have been failed
+ */
+tb_bool_t           tb_static_bits_writer_exit(tb_static_bits_writer_ref_t writer);
+
+/*! flush the full 32-bits word of the cache
+ *
+ * @param writer    the writer
+ */
+tb_void_t           tb_static_bits_writer_flush(tb_static_bits_writer_ref_t writer);
+
+/*! writ the ubits for uint64
+ *
+ * @param writer    the writer
+ * @param val       the value
+ * @param nbits     the bits count, <= 64
+ */
+tb_void_t           tb_static_bits_writer_writ_ubits64(tb_static_bits_writer_ref_t writer, tb_uint64_t val, tb_size_t nbits);
+
+/*! align the writer to the next byte boundary with the zero bits
+ *
+ * @param writer    the writer
+ */
+tb_void_t           tb_static_bits_writer_align(tb_static_bits_writer_ref_t writer);
+
+/*! writ the unsigned exp-golomb code, ue(v)
+ *
+ * @param writer    the writer
+ * @param val       the value, < 0xffffffff
+ */
+tb_void_t           tb_static_bits_writer_writ_ue(tb_static_bits_writer_ref_t writer, tb_uint32_t val);
+
+/*! writ the signed exp-golomb code, se(v)
+ *
+ * @param writer    the writer
+ * @param val       the value, >= TB_MINS32
+ */
+tb_void_t           tb_static_bits_writer_writ_se(tb_static_bits_writer_ref_t writer, tb_sint32_t val);
+
+/*! writ the unsigned leb128 varint
+ *
+ * @param writer    the writer
+ * @param val       the value
+ */
+tb_void_t           tb_static_bits_writer_writ_uleb128(tb_static_bits_writer_ref_t writer, tb_uint64_t val);
+
+/*! writ the signed leb128 varint
+ *
+ * @param writer    the writer
+ * @param val       the value
+ */
+tb_void_t           tb_static_bits_writer_writ_sleb128(tb_static_bits_writer_ref_t writer, tb_sint64_t val);
+
+/*! writ the zigzag varint
+ *
+ * @param writer    the writer
+ * @param val       the value
+ */
+tb_void_t           tb_static_bits_writer_writ_zigzag(tb_static_bits_writer_ref_t writer, tb_sint64_t val);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inline implementation
+ */
+
+/*! refill the bits cache, the cache will have at least 56 bits if the data is enough
+ *
+ * @param reader    the reader
+ */
+static __tb_inline__ tb_void_t tb_static_bits_reader_fill(tb_static_bits_reader_ref_t reader)
+{
+    // load the next 8 bytes and keep the whole bytes only
+    if (reader->p + 8 <= reader->e)
+    {
+        reader->cache |= tb_bits_get_u64_be(reader->p) >> reader->count;
+        reader->p     += (63 - reader->count) >> 3;
+        reader->count |= 56;
+    }
+    else tb_static_bits_reader_fill_tail(reader);
+}
+
+/*! peek the ubits for uint32
+ *
+ * @note the bits after the end of the data will be zero
+ *
+ * @param reader    the reader
+ * @param nbits     the bits count, <= 32
+ *
+ * @return          the value
+ */
+static __tb_inline__ tb_uint32_t tb_static_bits_reader_peek_ubits32(tb_static_bits_reader_ref_t reader, tb_size_t nbits)
+{
+    // check
+    tb_assert(reader && nbits <= 32);
+
+    // no nbits?
+    tb_check_return_val(nbits, 0);
+
+    // fill cache
+    if (reader->count < nbits) tb_static_bits_reader_fill(reader);
+
+    // peek it
+    return (tb_uint32_t)(reader->cache >> (64 - nbits));
+}
+
+/*! skip the bits which have been peeked
+ *
+ * @param reader    the reader
+ * @param nbits     the bits count, <= 32
+ *
+ * @return          tb_true or tb_false
+ */
+static __tb_inline__ tb_bool_t tb_static_bits_reader_skip(tb_static_bits_reader_ref_t reader, tb_size_t nbits)
+{
+    // check
+    tb_assert(reader && nbits <= 32);
+
+    // fill cache
+    if (reader->count < nbits) tb_static_bits_reader_fill(reader);
+
+    // overflow?
+    if (__tb_unlikely__(reader->count < nbits))
+    {
+        reader->error = tb_true;
+        return tb_false;
+    }
+
+    // skip it
+    reader->cache <<= nbits;
+    reader->count -= nbits;
+    return tb_true;
+}
+
+/*! read the ubits for uint32
+ *
+ * @param reader    the reader
+ * @param nbits     the bits count, <= 32
+ *
+ * @return          the value, zero if overflow
+ */
+static __tb_inline__ tb_uint32_t tb_static_bits_reader_read_ubits32(tb_static_bits_reader_ref_t reader, tb_size_t nbits)
+{
+    // peek it
+    tb_uint32_t val = tb_static_bits_reader_peek_ubits32(reader, nbits);
+
+    // skip it
+    return tb_static_bits_reader_skip(reader, nbits)? val : 0;
+}
+
+/*! read the unsigned exp-golomb code, ue(v)
+ *
+ * @param reader    the reader
+ *
+ * @return          the value
+ */
+static __tb_inline__ tb_uint32_t tb_static_bits_reader_read_ue(tb_static_bits_reader_ref_t reader)
+{
+    // check
+    tb_assert(reader);
+
+    // fill cache
+    if (reader->count < 32) tb_static_bits_reader_fill(reader);
+
+    // the leading zero bits count
+    tb_size_t n = tb_bits_cl0_u64_be(reader->cache);
+
+    // the whole code is in the cache? read it directly
+    tb_size_t b = (n << 1) + 1;
+    if (__tb_likely__(n < 28 && b <= reader->count))
+    {
+        tb_uint32_t val = (tb_uint32_t)(reader->cache >> (64 - b)) - 1;
+        reader->cache <<= b;
+        reader->count -= b;
+        return val;
+    }
+
+    // read it slowly
+    return tb_static_bits_reader_read_ue_slow(reader);
+}
+
+/*! writ the ubits for uint32
+ *
+ * @param writer    the writer
+ * @param val       the value
+ * @param nbits     the bits count, <= 32
+ */
+static __tb_inline__ tb_void_t tb_static_bits_writer_writ_ubits32(tb_static_bits_writer_ref_t writer, tb_uint32_t val, tb_size_t nbits)
+{
+    // check
+    tb_assert(writer && nbits <= 32 && writer->count < 32);
+
+    // no nbits?
+    tb_check_return(nbits);
+
+    // append it to the cache
+    writer->cache |= ((tb_uint64_t)val << (64 - nbits)) >> writer->count;
+    writer->count += nbits;
+
+    // flush the full word
+    if (writer->count >= 32) tb_static_bits_writer_flush(writer);
+}
+
+/*! writ the sbits for sint32
+ *
+ * @param writer    the writer
+ * @param val       the value
+ * @param nbits     the bits count, <= 32
+ */
+static __tb_inline__ tb_void_t tb_static_bits_writer_writ_sbits32(tb_static_bits_writer_ref_t writer, tb_sint32_t val, tb_size_t nbits)
+{
+    tb_static_bits_writer_writ_ubits32(writer, (tb_uint32_t)val, nbits);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -249,8 +249,11 @@ tb_uint32_t tb_static_stream_read_ubits32(tb_static_stream_ref_t stream, tb_size
     // check
     tb_assert_and_check_return_val(stream && stream->p && stream->p < stream->e && nbits, 0);
 
-    // read value
-    tb_uint32_t val = tb_bits_get_ubits32(stream->p, stream->b, nbits);
+    // read value from the unaligned big-endian word directly if the data is enough, b + nbits <= 7 + 32 < 64
+    tb_uint32_t val;
+    if (nbits <= 32 && stream->p + 8 <= stream->e)
+        val = (tb_uint32_t)((tb_bits_get_u64_be(stream->p) << stream->b) >> (64 - nbits));
+    else val = tb_bits_get_ubits32(stream->p, stream->b, nbits);
 
     // skip bits
     if (!tb_static_stream_skip_bits(stream, nbits)) return 0;
@@ -857,6 +860,122 @@ tb_bool_t tb_static_stream_writ_s64_le(tb_static_stream_ref_t stream, tb_sint64_
     return tb_true;
 }
 
+tb_uint32_t tb_static_stream_read_varint_u32(tb_static_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(stream && stream->p && stream->p < stream->e && !stream->b, 0);
+
+    // read it
+    tb_uint32_t val = 0;
+    tb_size_t   n = tb_varint_decode_u32(stream->p, stream->e - stream->p, &val);
+    tb_assert_and_check_return_val(n, 0);
+    stream->p += n;
+
+    // ok?
+    return val;
+}
+tb_sint32_t tb_static_stream_read_varint_s32(tb_static_stream_ref_t stream)
+{
+    tb_uint32_t val = tb_static_stream_read_varint_u32(stream);
+    return tb_zigzag_decode_u32(val);
+}
+tb_uint64_t tb_static_stream_read_varint_u64(tb_static_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(stream && stream->p && stream->p < stream->e && !stream->b, 0);
+
+    // read it
+    tb_uint64_t val = 0;
+    tb_size_t   n = tb_varint_decode_u64(stream->p, stream->e - stream->p, &val);
+    tb_assert_and_check_return_val(n, 0);
+    stream->p += n;
+
+    // ok?
+    return val;
+}
+tb_sint64_t tb_static_stream_read_varint_s64(tb_static_stream_ref_t stream)
+{
+    tb_uint64_t val = tb_static_stream_read_varint_u64(stream);
+    return tb_zigzag_decode_u64(val);
+}
+tb_bool_t tb_static_stream_read_varint_u32_n(tb_static_stream_ref_t stream, tb_uint32_t* values, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(stream && stream->p && stream->p <= stream->e && !stream->b && values, tb_false);
+
+    // read them
+    tb_size_t n = tb_varint_decode_u32_n(stream->p, stream->e - stream->p, values, count);
+    tb_check_return_val(n || !count, tb_false);
+    stream->p += n;
+
+    // ok
+    return tb_true;
+}
+tb_bool_t tb_static_stream_read_varint_svb_u32_n(tb_static_stream_ref_t stream, tb_uint32_t* values, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(stream && stream->p && stream->p <= stream->e && !stream->b && values, tb_false);
+
+    // read them
+    tb_size_t n = tb_varint_svb_decode_u32(stream->p, stream->e - stream->p, values, count);
+    tb_check_return_val(n || !count, tb_false);
+    stream->p += n;
+
+    // ok
+    return tb_true;
+}
+tb_bool_t tb_static_stream_writ_varint_u32(tb_static_stream_ref_t stream, tb_uint32_t val)
+{
+    return tb_static_stream_writ_varint_u32_n(stream, &val, 1);
+}
+tb_bool_t tb_static_stream_writ_varint_s32(tb_static_stream_ref_t stream, tb_sint32_t val)
+{
+    return tb_static_stream_writ_varint_u32(stream, tb_zigzag_encode_s32(val));
+}
+tb_bool_t tb_static_stream_writ_varint_u64(tb_static_stream_ref_t stream, tb_uint64_t val)
+{
+    // check
+    tb_assert_and_check_return_val(stream && stream->p && stream->p <= stream->e && !stream->b, tb_false);
+
+    // writ it
+    tb_size_t n = tb_varint_encode_u64_n(stream->p, stream->e - stream->p, &val, 1);
+    tb_check_return_val(n, tb_false);
+    stream->p += n;
+
+    // ok
+    return tb_true;
+}
+tb_bool_t tb_static_stream_writ_varint_s64(tb_static_stream_ref_t stream, tb_sint64_t val)
+{
+    return tb_static_stream_writ_varint_u64(stream, tb_zigzag_encode_s64(val));
+}
+tb_bool_t tb_static_stream_writ_varint_u32_n(tb_static_stream_ref_t stream, tb_uint32_t const* values, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(stream && stream->p && stream->p <= stream->e && !stream->b && values, tb_false);
+
+    // writ them
+    tb_size_t n = tb_varint_encode_u32_n(stream->p, stream->e - stream->p, values, count);
+    tb_check_return_val(n || !count, tb_false);
+    stream->p += n;
+
+    // ok
+    return tb_true;
+}
+tb_bool_t tb_static_stream_writ_varint_svb_u32_n(tb_static_stream_ref_t stream, tb_uint32_t const* values, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(stream && stream->p && stream->p <= stream->e && !stream->b && values, tb_false);
+
+    // writ them
+    tb_size_t n = tb_varint_svb_encode_u32(stream->p, stream->e - stream->p, values, count);
+    tb_check_return_val(n || !count, tb_false);
+    stream->p += n;
+
+    // ok
+    return tb_true;
+}
+
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
 tb_float_t tb_static_stream_read_float_le(tb_static_stream_ref_t stream)
 {
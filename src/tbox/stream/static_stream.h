@@ -697,6 +697,114 @@ tb_bool_t           tb_static_stream_writ_u64_le(tb_static_stream_ref_t stream,
  */
 tb_bool_t           tb_static_stream_writ_s64_le(tb_static_stream_ref_t stream, tb_sint64_t val);
 
+/*! read uint32 leb128 varint
+ *
+ * @param stream    the stream
+ *
+ * @return          the value
+ */
+tb_uint32_t         tb_static_stream_read_varint_u32(tb_static_stream_ref_t stream);
+
+/*! read sint32 zigzag varint
+ *
+ * @param stream    the stream
+ *
+ * @return          the value
+ */
+tb_sint32_t         tb_static_stream_read_varint_s32(tb_static_stream_ref_t stream);
+
+/*! read uint64 leb128 varint
+ *
+ * @param stream    the stream
+ *
+ * @return          the value
+ */
+tb_uint64_t         tb_static_stream_read_varint_u64(tb_static_stream_ref_t stream);
+
+/*! read sint64 zigzag varint
+ *
+ * @param stream    the stream
+ *
+ * @return          the value
+ */
+tb_sint64_t         tb_static_stream_read_varint_s64(tb_static_stream_ref_t stream);
+
+/*! read uint32 leb128 varints
+ *
+ * @param stream    the stream
+ * @param values    the values
+ * @param count     the values count
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_static_stream_read_varint_u32_n(tb_static_stream_ref_t stream, tb_uint32_t* values, tb_size_t count);
+
+/*! read uint32 values with the stream-vbyte format
+ *
+ * @param stream    the stream
+ * @param values    the values
+ * @param count     the values count
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_static_stream_read_varint_svb_u32_n(tb_static_stream_ref_t stream, tb_uint32_t* values, tb_size_t count);
+
+/*! writ uint32 leb128 varint
+ *
+ * @param stream    the stream
+ * @param val       the value
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_static_stream_writ_varint_u32(tb_static_stream_ref_t stream, tb_uint32_t val);
+
+/*! writ sint32 zigzag varint
+ *
+ * @param stream    the stream
+ * @param val       the value
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_static_stream_writ_varint_s32(tb_static_stream_ref_t stream, tb_sint32_t val);
+
+/*! writ uint64 leb128 varint
+ *
+ * @param stream    the stream
+ * @param val       the value
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_static_stream_writ_varint_u64(tb_static_stream_ref_t stream, tb_uint64_t val);
+
+/*! writ sint64 zigzag varint
+ *
+ * @param stream    the stream
+ * @param val       the value
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_static_stream_writ_varint_s64(tb_static_stream_ref_t stream, tb_sint64_t val);
+
+/*! writ uint32 leb128 varints
+ *
+ * @param stream    the stream
+ * @param values    the values
+ * @param count     the values count
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_static_stream_writ_varint_u32_n(tb_static_stream_ref_t stream, tb_uint32_t const* values, tb_size_t count);
+
+/*! writ uint32 values with the stream-vbyte format
+ *
+ * @param stream    the stream
+ * @param values    the values
+ * @param count     the values count
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_static_stream_writ_varint_svb_u32_n(tb_static_stream_ref_t stream, tb_uint32_t const* values, tb_size_t count);
+
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
 
 /*! read float-le number
@@ -751,6 +751,71 @@ tb_bool_t tb_stream_need(tb_stream_ref_t stream, tb_byte_t** data, tb_size_t siz
     // ok
     return tb_true;
 }
+tb_size_t tb_stream_peek(tb_stream_ref_t stream, tb_byte_t** data)
+{
+    // check 
+    tb_stream_impl_t* impl = tb_stream_impl(stream);
+    tb_assert_and_check_return_val(data, 0);
+
+    // check stream
+    tb_assert_and_check_return_val(impl && tb_stream_is_opened(stream) && impl->read && impl->wait, 0);
+
+    // stoped?
+    tb_check_return_val(TB_STATE_OPENED == tb_atomic_get(&impl->istate), 0);
+
+    // have writed cache? sync first
+    if (impl->bwrited && !tb_queue_buffer_null(&impl->cache) && !tb_stream_sync(stream, tb_false)) return 0;
+
+    // switch to the read cache mode
+    if (impl->bwrited && tb_queue_buffer_null(&impl->cache)) impl->bwrited = 0;
+
+    // check the cache mode, must be read cache
+    tb_assert_and_check_return_val(!impl->bwrited, 0);
+
+    // no cache? make it
+    if (!tb_queue_buffer_maxn(&impl->cache)) tb_queue_buffer_resize(&impl->cache, TB_STREAM_BLOCK_MAXN);
+    tb_assert_and_check_return_val(tb_queue_buffer_maxn(&impl->cache), 0);
+
+    // fill cache if it is empty
+    while (tb_queue_buffer_null(&impl->cache) && (TB_STATE_OPENED == tb_atomic_get(&impl->istate)))
+    {
+        // enter cache for push
+        tb_size_t   push = 0;
+        tb_byte_t*  tail = tb_queue_buffer_push_init(&impl->cache, &push);
+        tb_assert_and_check_return_val(tail && push, 0);
+
+        // read data
+        tb_long_t real = impl->read(stream, tail, push);
+
+        // leave cache for push
+        tb_queue_buffer_push_exit(&impl->cache, real > 0? real : 0);
+
+        // no data? wait it
+        if (!real)
+        {
+            real = impl->wait(stream, TB_STREAM_WAIT_READ, tb_stream_timeout(stream));
+            tb_check_break(real > 0);
+        }
+        // ok or end?
+        else break;
+    }
+
+    // no data?
+    tb_size_t size = tb_queue_buffer_size(&impl->cache);
+    if (!size)
+    {
+        // killed? save state
+        if (!impl->state && (TB_STATE_KILLING == tb_atomic_get(&impl->istate)))
+            impl->state = TB_STATE_KILLED;
+        return 0;
+    }
+
+    // save data
+    *data = tb_queue_buffer_head(&impl->cache);
+
+    // ok
+    return size;
+}
 tb_long_t tb_stream_read(tb_stream_ref_t stream, tb_byte_t* data, tb_size_t size)
 {
     // check 
@@ -970,6 +1035,21 @@ tb_bool_t tb_stream_bwrit(tb_stream_ref_t stream, tb_byte_t const* data, tb_size
     // ok?
     return (writ == size? tb_true : tb_false);
 }
+tb_bool_t tb_stream_bwritv(tb_stream_ref_t stream, tb_iovec_t const* list, tb_size_t size)
+{
+    // check 
+    tb_assert_and_check_return_val(stream && list, tb_false);
+
+    // writ the iovec list to cache
+    tb_size_t i = 0;
+    for (i = 0; i < size; i++)
+    {
+        if (!tb_stream_bwrit(stream, list[i].data, list[i].size)) return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
 tb_bool_t tb_stream_sync(tb_stream_ref_t stream, tb_bool_t bclosing)
 {
     // check 
@@ -1080,7 +1160,7 @@ tb_bool_t tb_stream_seek(tb_stream_ref_t stream, tb_hize_t offset)
         {
             tb_size_t   size = 0;
             tb_byte_t*  data = tb_queue_buffer_pull_init(&impl->cache, &size);
-            if (data && size && offset > curt && offset < curt + size)
+            if (data && size && offset > curt && offset <= curt + size)
             {
                 // seek it at the cache
                 tb_queue_buffer_pull_exit(&impl->cache, (tb_size_t)(offset - curt));
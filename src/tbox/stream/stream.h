@@ -30,6 +30,7 @@
 #include "prefix.h"
 #include "async_stream.h"
 #include "static_stream.h"
+#include "static_bits.h"
 #include "transfer.h"
 #include "transfer_pool.h"
 #include "filter.h"
@@ -426,6 +427,17 @@ tb_stream_ref_t         tb_stream_init_filter_from_charset(tb_stream_ref_t strea
  */
 tb_stream_ref_t         tb_stream_init_filter_from_chunked(tb_stream_ref_t stream, tb_bool_t dechunked);
 
+/*! init filter stream from varint
+ *
+ * @param stream        the stream
+ * @param width         the integer width, 4 or 8 bytes
+ * @param zigzag        the signed integers with the zigzag encoding?
+ * @param decode        decode the varint data?
+ *
+ * @return              the stream
+ */
+tb_stream_ref_t         tb_stream_init_filter_from_varint(tb_stream_ref_t stream, tb_size_t width, tb_bool_t zigzag, tb_bool_t decode);
+
 /*! wait stream 
  *
  * blocking wait the single event object, so need not aiop 
@@ -669,6 +681,16 @@ tb_bool_t               tb_stream_bread(tb_stream_ref_t stream, tb_byte_t* data,
  */
 tb_bool_t               tb_stream_bwrit(tb_stream_ref_t stream, tb_byte_t const* data, tb_size_t size);
 
+/*! block writ the iovec list
+ *
+ * @param stream        the stream
+ * @param list          the iovec list
+ * @param size          the iovec list size
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_stream_bwritv(tb_stream_ref_t stream, tb_iovec_t const* list, tb_size_t size);
+
 /*! sync stream
  *
  * @param stream        the stream
@@ -699,6 +721,33 @@ tb_bool_t               tb_stream_sync(tb_stream_ref_t stream, tb_bool_t bclosin
  */
 tb_bool_t               tb_stream_need(tb_stream_ref_t stream, tb_byte_t** data, tb_size_t size);
 
+/*! peek the cached data without moving the offset
+ *
+ * it will read some data to the cache only if the cache is empty, 
+ * and the data will be valid until the next reading
+ *
+ * @code
+ 
+    // scan the cached data
+    tb_byte_t*  data = tb_null;
+    tb_size_t   size = 0;
+    while ((size = tb_stream_peek(stream, &data)))
+    {
+        // ..
+
+        // skip the scanned data
+        if (!tb_stream_skip(stream, size)) break;
+    }
+
+ * @endcode
+ *
+ * @param stream        the stream
+ * @param data          the data
+ *
+ * @return              the cached data size, end or failed: 0
+ */
+tb_size_t               tb_stream_peek(tb_stream_ref_t stream, tb_byte_t** data);
+
 /*! seek stream
  *
  * @param stream        the stream
@@ -0,0 +1,501 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        rope.c
+ * @ingroup     string
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "rope"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "rope.h"
+#include "../libc/libc.h"
+#include "../utils/utils.h"
+#include "../platform/platform.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the chunk grow min
+#define TB_ROPE_CHUNK_GROW_MIN              (256)
+
+// the chunk grow max
+#define TB_ROPE_CHUNK_GROW_MAX              (65536)
+
+// the slices grow min
+#define TB_ROPE_SLICES_GROW_MIN             (16)
+
+// the format data size
+#ifdef __tb_small__
+#   define TB_ROPE_FMTD_SIZE                (4096)
+#else
+#   define TB_ROPE_FMTD_SIZE                (8192)
+#endif
+
+// the chunk data
+#define tb_rope_chunk_data(chunk)           ((tb_byte_t*)((chunk) + 1))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/* the rope chunk type
+ *
+ * <pre>
+ * chunk: [refn|head|tail|maxn][.......head.............tail........]
+ *                                     |<-  the used data ->|
+ * </pre>
+ *
+ * the chunk is only writable at head or tail for the unique slice which covers head or tail
+ */
+typedef struct __tb_rope_chunk_t
+{
+    // the reference count
+    tb_atomic_t                 refn;
+
+    // the head offset of the used data
+    tb_size_t                   head;
+
+    // the tail offset of the used data
+    tb_size_t                   tail;
+
+    // the data maxn
+    tb_size_t                   maxn;
+
+}tb_rope_chunk_t;
+
+// the rope slice type
+typedef struct __tb_rope_slice_t
+{
+    // the chunk
+    tb_rope_chunk_t*            chunk;
+
+    // the data offset in chunk
+    tb_size_t                   offset;
+
+    // the data size
+    tb_size_t                   size;
+
+}tb_rope_slice_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_rope_chunk_t* tb_rope_chunk_init(tb_size_t maxn, tb_bool_t front)
+{
+    // make chunk
+    tb_rope_chunk_t* chunk = (tb_rope_chunk_t*)tb_malloc(sizeof(tb_rope_chunk_t) + maxn);
+    tb_assert_and_check_return_val(chunk, tb_null);
+
+    // init chunk, the data of the front chunk is written from tail to head
+    chunk->refn = 1;
+    chunk->head = front? maxn : 0;
+    chunk->tail = chunk->head;
+    chunk->maxn = maxn;
+    return chunk;
+}
+static __tb_inline__ tb_void_t tb_rope_chunk_exit(tb_rope_chunk_t* chunk)
+{
+    if (tb_atomic_fetch_and_dec(&chunk->refn) == 1) tb_free(chunk);
+}
+static __tb_inline__ tb_bool_t tb_rope_chunk_unique(tb_rope_chunk_t* chunk)
+{
+    return tb_atomic_get(&chunk->refn) == 1;
+}
+static __tb_inline__ tb_size_t tb_rope_chunk_grow(tb_rope_ref_t rope, tb_size_t size)
+{
+    // grow the chunk with the rope size, so the slices count is only O(log(n)) for a large rope
+    tb_size_t grow = tb_min(tb_max(rope->size >> 3, TB_ROPE_CHUNK_GROW_MIN), TB_ROPE_CHUNK_GROW_MAX);
+    return tb_max(grow, size);
+}
+static tb_bool_t tb_rope_slices_grow(tb_rope_ref_t rope, tb_size_t front, tb_size_t back)
+{
+    // enough?
+    if (rope->head >= front && rope->tail + back <= rope->maxn) return tb_true;
+
+    // the new maxn
+    tb_size_t count = rope->tail - rope->head;
+    tb_size_t need  = count + front + back;
+    tb_size_t maxn  = tb_max(tb_max(rope->maxn << 1, need), TB_ROPE_SLICES_GROW_MIN);
+
+    /* the new head
+     *
+     * we keep the spare space at the back only for the appended rope, 
+     * and split the spare space for the prepended rope
+     */
+    tb_size_t head  = front + (front? ((maxn - need) >> 1) : 0);
+
+    // make the new slices
+    tb_rope_slice_t* slices = tb_nalloc_type(maxn, tb_rope_slice_t);
+    tb_assert_and_check_return_val(slices, tb_false);
+
+    // move the old slices
+    if (rope->slices)
+    {
+        if (count) tb_memcpy(slices + head, rope->slices + rope->head, count * sizeof(tb_rope_slice_t));
+        tb_free(rope->slices);
+    }
+
+    // update the slices
+    rope->slices    = slices;
+    rope->head      = head;
+    rope->tail      = head + count;
+    rope->maxn      = maxn;
+    return tb_true;
+}
+static tb_size_t tb_rope_slices_find(tb_rope_ref_t rope, tb_size_t* offset)
+{
+    // find the slice which contains the given offset
+    tb_size_t i = rope->head;
+    tb_size_t o = *offset;
+    for (; i < rope->tail && o >= rope->slices[i].size; i++) o -= rope->slices[i].size;
+
+    // save the offset in this slice
+    *offset = o;
+    return i;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t tb_rope_init(tb_rope_ref_t rope)
+{
+    // check
+    tb_assert_and_check_return_val(rope, tb_false);
+
+    // init, the slices will be allocated lazily
+    tb_memset(rope, 0, sizeof(tb_rope_t));
+    return tb_true;
+}
+tb_void_t tb_rope_exit(tb_rope_ref_t rope)
+{
+    // check
+    tb_assert_and_check_return(rope);
+
+    // clear it
+    tb_rope_clear(rope);
+
+    // exit the slices
+    if (rope->slices) tb_free(rope->slices);
+    tb_memset(rope, 0, sizeof(tb_rope_t));
+}
+tb_void_t tb_rope_clear(tb_rope_ref_t rope)
+{
+    // check
+    tb_assert_and_check_return(rope);
+
+    // exit the chunks
+    tb_size_t i = rope->head;
+    for (; i < rope->tail; i++) tb_rope_chunk_exit(rope->slices[i].chunk);
+
+    // clear it
+    rope->head = 0;
+    rope->tail = 0;
+    rope->size = 0;
+}
+tb_size_t tb_rope_size(tb_rope_ref_t rope)
+{
+    // check
+    tb_assert_and_check_return_val(rope, 0);
+    return rope->size;
+}
+tb_size_t tb_rope_slices(tb_rope_ref_t rope)
+{
+    // check
+    tb_assert_and_check_return_val(rope, 0);
+    return rope->tail - rope->head;
+}
+tb_bool_t tb_rope_memncat(tb_rope_ref_t rope, tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(rope && data, tb_false);
+
+    // done
+    while (size)
+    {
+        // append data to the tail of the last chunk if we own this chunk 
+        if (rope->tail > rope->head)
+        {
+            tb_rope_slice_t* slice = &rope->slices[rope->tail - 1];
+            tb_rope_chunk_t* chunk = slice->chunk;
+            if (chunk->tail < chunk->maxn && slice->offset + slice->size == chunk->tail && tb_rope_chunk_unique(chunk))
+            {
+                // copy data
+                tb_size_t n = tb_min(size, chunk->maxn - chunk->tail);
+                tb_memcpy(tb_rope_chunk_data(chunk) + chunk->tail, data, n);
+
+                // update size
+                chunk->tail += n;
+                slice->size += n;
+                rope->size  += n;
+                data        += n;
+                size        -= n;
+                continue ;
+            }
+        }
+
+        // grow slices
+        if (!tb_rope_slices_grow(rope, 0, 1)) return tb_false;
+
+        // append a new chunk
+        tb_rope_chunk_t* chunk = tb_rope_chunk_init(tb_rope_chunk_grow(rope, size), tb_false);
+        tb_assert_and_check_return_val(chunk, tb_false);
+
+        // append a new slice
+        tb_rope_slice_t* slice = &rope->slices[rope->tail++];
+        slice->chunk    = chunk;
+        slice->offset   = 0;
+        slice->size     = 0;
+    }
+
+    // ok
+    return tb_true;
+}
+tb_bool_t tb_rope_cstrcat(tb_rope_ref_t rope, tb_char_t const* s)
+{
+    // check
+    tb_assert_and_check_return_val(s, tb_false);
+    return tb_rope_memncat(rope, (tb_byte_t const*)s, tb_strlen(s));
+}
+tb_bool_t tb_rope_cstrncat(tb_rope_ref_t rope, tb_char_t const* s, tb_size_t n)
+{
+    // check
+    tb_assert_and_check_return_val(s, tb_false);
+    return tb_rope_memncat(rope, (tb_byte_t const*)s, tb_strnlen(s, n));
+}
+tb_bool_t tb_rope_cstrfcat(tb_rope_ref_t rope, tb_char_t const* fmt, ...)
+{
+    // check
+    tb_assert_and_check_return_val(rope && fmt, tb_false);
+
+    // format data
+    tb_char_t p[TB_ROPE_FMTD_SIZE] = {0};
+    tb_long_t n = 0;
+    tb_vsnprintf_format(p, TB_ROPE_FMTD_SIZE, fmt, &n);
+    tb_assert_and_check_return_val(n >= 0, tb_false);
+    
+    // done
+    return tb_rope_memncat(rope, (tb_byte_t const*)p, n);
+}
+tb_bool_t tb_rope_chrcat(tb_rope_ref_t rope, tb_char_t c)
+{
+    return tb_rope_memncat(rope, (tb_byte_t const*)&c, 1);
+}
+tb_bool_t tb_rope_memnpre(tb_rope_ref_t rope, tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(rope && data, tb_false);
+
+    // done, prepend data from the data tail
+    while (size)
+    {
+        // prepend data to the head of the first chunk if we own this chunk 
+        if (rope->tail > rope->head)
+        {
+            tb_rope_slice_t* slice = &rope->slices[rope->head];
+            tb_rope_chunk_t* chunk = slice->chunk;
+            if (chunk->head && slice->offset == chunk->head && tb_rope_chunk_unique(chunk))
+            {
+                // copy data
+                tb_size_t n = tb_min(size, chunk->head);
+                chunk->head -= n;
+                tb_memcpy(tb_rope_chunk_data(chunk) + chunk->head, data + size - n, n);
+
+                // update size
+                slice->offset   -= n;
+                slice->size     += n;
+                rope->size      += n;
+                size            -= n;
+                continue ;
+            }
+        }
+
+        // grow slices
+        if (!tb_rope_slices_grow(rope, 1, 0)) return tb_false;
+
+        // prepend a new chunk
+        tb_rope_chunk_t* chunk = tb_rope_chunk_init(tb_rope_chunk_grow(rope, size), tb_true);
+        tb_assert_and_check_return_val(chunk, tb_false);
+
+        // prepend a new slice
+        tb_rope_slice_t* slice = &rope->slices[--rope->head];
+        slice->chunk    = chunk;
+        slice->offset   = chunk->head;
+        slice->size     = 0;
+    }
+
+    // ok
+    return tb_true;
+}
+tb_bool_t tb_rope_cstrpre(tb_rope_ref_t rope, tb_char_t const* s)
+{
+    // check
+    tb_assert_and_check_return_val(s, tb_false);
+    return tb_rope_memnpre(rope, (tb_byte_t const*)s, tb_strlen(s));
+}
+tb_bool_t tb_rope_ropecat(tb_rope_ref_t rope, tb_rope_ref_t other)
+{
+    // check
+    tb_assert_and_check_return_val(rope && other, tb_false);
+
+    // empty?
+    tb_size_t count = other->tail - other->head;
+    tb_size_t size  = other->size;
+    tb_check_return_val(count, tb_true);
+
+    // grow slices, the other slices may be moved if other is the rope self
+    if (!tb_rope_slices_grow(rope, 0, count)) return tb_false;
+
+    // share the other slices
+    tb_size_t i = 0;
+    tb_size_t head = other->head;
+    for (i = 0; i < count; i++)
+    {
+        tb_rope_slice_t const* slice = &other->slices[head + i];
+        tb_atomic_fetch_and_inc(&slice->chunk->refn);
+        rope->slices[rope->tail++] = *slice;
+    }
+
+    // update size
+    rope->size += size;
+    return tb_true;
+}
+tb_bool_t tb_rope_ropepre(tb_rope_ref_t rope, tb_rope_ref_t other)
+{
+    // check
+    tb_assert_and_check_return_val(rope && other, tb_false);
+
+    // empty?
+    tb_size_t count = other->tail - other->head;
+    tb_size_t size  = other->size;
+    tb_check_return_val(count, tb_true);
+
+    // grow slices, the other slices may be moved if other is the rope self
+    if (!tb_rope_slices_grow(rope, count, 0)) return tb_false;
+
+    // share the other slices
+    tb_size_t i = count;
+    tb_size_t head = other->head;
+    while (i--)
+    {
+        tb_rope_slice_t const* slice = &other->slices[head + i];
+        tb_atomic_fetch_and_inc(&slice->chunk->refn);
+        rope->slices[--rope->head] = *slice;
+    }
+
+    // update size
+    rope->size += size;
+    return tb_true;
+}
+tb_bool_t tb_rope_subrope(tb_rope_ref_t rope, tb_rope_ref_t sub, tb_size_t offset, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(rope && sub && rope != sub, tb_false);
+    tb_assert_and_check_return_val(offset <= rope->size && size <= rope->size - offset, tb_false);
+
+    // clear the sub-rope
+    tb_rope_clear(sub);
+
+    // share the slices in range
+    tb_size_t i = tb_rope_slices_find(rope, &offset);
+    for (; i < rope->tail && size; i++)
+    {
+        // grow slices
+        if (!tb_rope_slices_grow(sub, 0, 1)) return tb_false;
+
+        // share this slice
+        tb_rope_slice_t* slice = &sub->slices[sub->tail++];
+        *slice = rope->slices[i];
+        tb_atomic_fetch_and_inc(&slice->chunk->refn);
+
+        // trim it
+        slice->offset   += offset;
+        slice->size     -= offset;
+        if (slice->size > size) slice->size = size;
+
+        // next
+        sub->size       += slice->size;
+        size            -= slice->size;
+        offset          = 0;
+    }
+
+    // ok
+    return tb_true;
+}
+tb_size_t tb_rope_iovec(tb_rope_ref_t rope, tb_size_t offset, tb_iovec_t* list, tb_size_t maxn)
+{
+    // check
+    tb_assert_and_check_return_val(rope && list, 0);
+
+    // fill the iovec list
+    tb_size_t n = 0;
+    tb_size_t i = tb_rope_slices_find(rope, &offset);
+    for (; i < rope->tail && n < maxn; i++, n++)
+    {
+        tb_rope_slice_t const* slice = &rope->slices[i];
+        list[n].data = tb_rope_chunk_data(slice->chunk) + slice->offset + offset;
+        list[n].size = (tb_iovec_size_t)(slice->size - offset);
+        offset = 0;
+    }
+
+    // the iovec count
+    return n;
+}
+tb_size_t tb_rope_copy(tb_rope_ref_t rope, tb_size_t offset, tb_byte_t* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(rope && data, 0);
+
+    // copy data
+    tb_size_t read = 0;
+    tb_size_t i = tb_rope_slices_find(rope, &offset);
+    for (; i < rope->tail && read < size; i++)
+    {
+        tb_rope_slice_t const* slice = &rope->slices[i];
+        tb_size_t n = tb_min(slice->size - offset, size - read);
+        tb_memcpy(data + read, tb_rope_chunk_data(slice->chunk) + slice->offset + offset, n);
+        read    += n;
+        offset  = 0;
+    }
+
+    // the copied size
+    return read;
+}
+tb_byte_t const* tb_rope_flatten(tb_rope_ref_t rope, tb_buffer_ref_t buffer)
+{
+    // check
+    tb_assert_and_check_return_val(rope && buffer, tb_null);
+
+    // resize buffer
+    tb_size_t size = tb_buffer_size(buffer);
+    tb_byte_t* data = tb_buffer_resize(buffer, size + rope->size);
+    tb_assert_and_check_return_val(data, tb_null);
+
+    // copy data
+    tb_rope_copy(rope, 0, data + size, rope->size);
+    return data;
+}
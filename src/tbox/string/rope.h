@@ -0,0 +1,264 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        rope.h
+ * @ingroup     string
+ *
+ */
+#ifndef TB_STRING_ROPE_H
+#define TB_STRING_ROPE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../memory/buffer.h"
+#include "../platform/prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the rope type
+ *
+ * the rope is a list of the slices of the refcounted chunks, 
+ * so appending and prepending never move the written data, 
+ * and concatenating or slicing the ropes only share the chunks without copying data.
+ *
+ * <pre>
+ * rope: [slice0][slice1][slice2]...
+ *          |       |       |
+ *        chunk0  chunk1  chunk1 (shared)
+ * </pre>
+ *
+ * it can be written by the writv/sendv interfaces directly with tb_rope_iovec() without flattening.
+ *
+ * @note the rope is not thread-safe, but the shared chunks can be used by the ropes in the different threads
+ */
+typedef struct __tb_rope_t
+{
+    /// the slices
+    struct __tb_rope_slice_t*   slices;
+
+    /// the head index of the slices
+    tb_size_t                   head;
+
+    /// the tail index of the slices
+    tb_size_t                   tail;
+
+    /// the slices maxn
+    tb_size_t                   maxn;
+
+    /// the data size
+    tb_size_t                   size;
+
+}tb_rope_t;
+
+/// the rope ref type
+typedef tb_rope_t*              tb_rope_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init rope
+ *
+ * @param rope          the rope
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_rope_init(tb_rope_ref_t rope);
+
+/*! exit rope
+ *
+ * @param rope          the rope
+ */
+tb_void_t               tb_rope_exit(tb_rope_ref_t rope);
+
+/*! clear rope
+ *
+ * @param rope          the rope
+ */
+tb_void_t               tb_rope_clear(tb_rope_ref_t rope);
+
+/*! the rope size
+ *
+ * @param rope          the rope
+ *
+ * @return              the data size
+ */
+tb_size_t               tb_rope_size(tb_rope_ref_t rope);
+
+/*! the slices count of the rope
+ *
+ * @param rope          the rope
+ *
+ * @return              the slices count, the iovec count for writing the whole rope
+ */
+tb_size_t               tb_rope_slices(tb_rope_ref_t rope);
+
+/*! append data
+ *
+ * @param rope          the rope
+ * @param data          the data
+ * @param size          the size
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_rope_memncat(tb_rope_ref_t rope, tb_byte_t const* data, tb_size_t size);
+
+/*! append c-string
+ *
+ * @param rope          the rope
+ * @param s             the c-string
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_rope_cstrcat(tb_rope_ref_t rope, tb_char_t const* s);
+
+/*! append c-string with the given size
+ *
+ * @param rope          the rope
+ * @param s             the c-string
+ * @param n             the c-string size
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_rope_cstrncat(tb_rope_ref_t rope, tb_char_t const* s, tb_size_t n);
+
+/*! append format c-string
+ *
+ * @param rope          the rope
+ * @param fmt           the format
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_rope_cstrfcat(tb_rope_ref_t rope, tb_char_t const* fmt, ...);
+
+/*! append charactor
+ *
+ * @param rope          the rope
+ * @param c             the charactor
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_rope_chrcat(tb_rope_ref_t rope, tb_char_t c);
+
+/*! prepend data
+ *
+ * @param rope          the rope
+ * @param data          the data
+ * @param size          the size
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_rope_memnpre(tb_rope_ref_t rope, tb_byte_t const* data, tb_size_t size);
+
+/*! prepend c-string
+ *
+ * @param rope          the rope
+ * @param s             the c-string
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_rope_cstrpre(tb_rope_ref_t rope, tb_char_t const* s);
+
+/*! append the other rope, only share the chunks of it
+ *
+ * @param rope          the rope
+ * @param other         the other rope, maybe the rope self
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_rope_ropecat(tb_rope_ref_t rope, tb_rope_ref_t other);
+
+/*! prepend the other rope, only share the chunks of it
+ *
+ * @param rope          the rope
+ * @param other         the other rope, maybe the rope self
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_rope_ropepre(tb_rope_ref_t rope, tb_rope_ref_t other);
+
+/*! make the sub-rope which shares the chunks of the rope
+ *
+ * @param rope          the rope
+ * @param sub           the initialized sub-rope, the old data will be cleared
+ * @param offset        the data offset
+ * @param size          the data size
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_rope_subrope(tb_rope_ref_t rope, tb_rope_ref_t sub, tb_size_t offset, tb_size_t size);
+
+/*! get the iovec list of the rope data
+ *
+ * @code
+    tb_size_t   offset = 0;
+    tb_iovec_t  list[64];
+    while (offset < tb_rope_size(rope))
+    {
+        tb_size_t count = tb_rope_iovec(rope, offset, list, tb_arrayn(list));
+        tb_long_t real = tb_socket_sendv(sock, list, count);
+        if (real > 0) offset += real;
+        else ...
+    }
+ * @endcode
+ *
+ * @param rope          the rope
+ * @param offset        the data offset
+ * @param list          the iovec list
+ * @param maxn          the iovec list maxn
+ *
+ * @return              the iovec count
+ */
+tb_size_t               tb_rope_iovec(tb_rope_ref_t rope, tb_size_t offset, tb_iovec_t* list, tb_size_t maxn);
+
+/*! copy the rope data
+ *
+ * @param rope          the rope
+ * @param offset        the data offset
+ * @param data          the data
+ * @param size          the data size
+ *
+ * @return              the copied size
+ */
+tb_size_t               tb_rope_copy(tb_rope_ref_t rope, tb_size_t offset, tb_byte_t* data, tb_size_t size);
+
+/*! flatten the rope data and append it to the buffer 
+ *
+ * @param rope          the rope
+ * @param buffer        the buffer
+ *
+ * @return              the buffer data
+ */
+tb_byte_t const*        tb_rope_flatten(tb_rope_ref_t rope, tb_buffer_ref_t buffer);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -66,7 +66,7 @@ tb_char_t const* tb_string_cstr(tb_string_ref_t string)
     tb_assert_and_check_return_val(string, tb_null);
 
     // the cstr
-    return tb_string_size(string)? (tb_char_t const*)tb_buffer_data((tb_buffer_ref_t)string) : tb_null;
+    return tb_string_size(string)? (tb_char_t const*)tb_buffer_cdata((tb_buffer_ref_t)string) : tb_null;
 }
 tb_size_t tb_string_size(tb_string_ref_t string)
 {
@@ -77,6 +77,10 @@ tb_size_t tb_string_size(tb_string_ref_t string)
     tb_size_t n = tb_buffer_size(string);
     return n > 0? n - 1 : 0;
 }
+tb_string_view_t tb_string_view(tb_string_ref_t string)
+{
+    return tb_string_view_init(tb_string_cstr(string), tb_string_size(string));
+}
 tb_void_t tb_string_clear(tb_string_ref_t string)
 {
     // check
@@ -272,15 +276,28 @@ tb_char_t const* tb_string_strcpy(tb_string_ref_t string, tb_string_ref_t s)
     // check
     tb_assert_and_check_return_val(s, tb_null);
 
-    // done
+    // share the string data, the static data will be copied directly
     tb_size_t n = tb_string_size(s);
-    if (n) return tb_string_cstrncpy(string, tb_string_cstr(s), n);
+    if (n) return tb_buffer_share(string, s)? tb_string_cstr(string) : tb_null;
     else
     {
         tb_string_clear(string);
         return tb_null;
     }
 }
+tb_char_t const* tb_string_viewcpy(tb_string_ref_t string, tb_string_view_t view)
+{
+    // clear it
+    tb_string_clear(string);
+    tb_check_return_val(view.size, tb_null);
+
+    // the view may be not null-terminated, copy it and append '\0' 
+    tb_char_t* p = (tb_char_t*)tb_buffer_resize(string, view.size + 1);
+    tb_assert_and_check_return_val(p, tb_null);
+    tb_memcpy(p, view.data, view.size);
+    p[view.size] = '\0';
+    return p;
+}
 tb_char_t const* tb_string_cstrcpy(tb_string_ref_t string, tb_char_t const* s)
 {
     // check
@@ -368,6 +385,27 @@ tb_char_t const* tb_string_cstrfcat(tb_string_ref_t string, tb_char_t const* fmt
     // done
     return tb_string_cstrncat(string, p, n);
 }
+tb_char_t const* tb_string_viewcat(tb_string_ref_t string, tb_string_view_t view)
+{
+    // check
+    tb_check_return_val(view.size, tb_string_cstr(string));
+
+    // the view may be not null-terminated, copy it and append '\0' 
+    tb_size_t   n = tb_string_size(string);
+    tb_char_t*  p = (tb_char_t*)tb_buffer_resize(string, n + view.size + 1);
+    tb_assert_and_check_return_val(p, tb_null);
+    tb_memcpy(p + n, view.data, view.size);
+    p[n + view.size] = '\0';
+    return p;
+}
+tb_long_t tb_string_viewcmp(tb_string_ref_t string, tb_string_view_t view)
+{
+    return tb_string_view_cmp(tb_string_view(string), view);
+}
+tb_long_t tb_string_viewicmp(tb_string_ref_t string, tb_string_view_t view)
+{
+    return tb_string_view_icmp(tb_string_view(string), view);
+}
 tb_long_t tb_string_strcmp(tb_string_ref_t string, tb_string_ref_t s)
 {
     // check
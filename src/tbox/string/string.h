@@ -28,6 +28,8 @@
  * includes
  */
 #include "static_string.h"
+#include "rope.h"
+#include "string_view.h"
 #include "../memory/memory.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -39,7 +41,11 @@ __tb_extern_c_enter__
  * types
  */
 
-/// the string type
+/*! the string type
+ *
+ * the short string is stored in the static buffer without allocation,
+ * and the long string data is refcounted and shared by tb_string_strcpy() with copy-on-write.
+ */
 typedef tb_buffer_t         tb_string_t;
 
 /// the string ref type
@@ -79,6 +85,16 @@ tb_char_t const*        tb_string_cstr(tb_string_ref_t string);
  */
 tb_size_t               tb_string_size(tb_string_ref_t string);
 
+/*! the string view 
+ *
+ * @note the view will be invalid after the string is modified
+ *
+ * @param string        the string
+ *
+ * @return              the string view
+ */
+tb_string_view_t        tb_string_view(tb_string_ref_t string);
+
 /*! clear the string
  *
  * @param string        the string
@@ -240,6 +256,8 @@ tb_long_t               tb_string_cstrrstr(tb_string_ref_t string, tb_size_t p,
 tb_long_t               tb_string_cstrirstr(tb_string_ref_t string, tb_size_t p, tb_char_t const* s);
 
 /*! copy string
+ *
+ * the long string data will be shared and be copied only when one of them is modified
  *
  * @param string        the string
  * @param s             the copied string
@@ -248,6 +266,15 @@ tb_long_t               tb_string_cstrirstr(tb_string_ref_t string, tb_size_t p,
  */
 tb_char_t const*        tb_string_strcpy(tb_string_ref_t string, tb_string_ref_t s);
 
+/*! copy string view
+ *
+ * @param string        the string
+ * @param view          the copied string view
+ *
+ * @return              the c-string
+ */
+tb_char_t const*        tb_string_viewcpy(tb_string_ref_t string, tb_string_view_t view);
+
 /*! copy c-string
  *
  * @param string        the string
@@ -332,6 +359,33 @@ tb_char_t const*        tb_string_cstrncat(tb_string_ref_t string, tb_char_t con
  */
 tb_char_t const*        tb_string_cstrfcat(tb_string_ref_t string, tb_char_t const* fmt, ...);
 
+/*! append string view
+ *
+ * @param string        the string
+ * @param view          the appended string view
+ *
+ * @return              the c-string
+ */
+tb_char_t const*        tb_string_viewcat(tb_string_ref_t string, tb_string_view_t view);
+
+/*! compare string view
+ *
+ * @param string        the string
+ * @param view          the compared string view
+ *
+ * @return              equal: 0
+ */
+tb_long_t               tb_string_viewcmp(tb_string_ref_t string, tb_string_view_t view);
+
+/*! compare string view with ignoring case
+ *
+ * @param string        the string
+ * @param view          the compared string view
+ *
+ * @return              equal: 0
+ */
+tb_long_t               tb_string_viewicmp(tb_string_ref_t string, tb_string_view_t view);
+
 /*! compare string
  *
  * @param string        the string
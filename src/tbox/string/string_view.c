@@ -0,0 +1,90 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        string_view.c
+ * @ingroup     string
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "string_view.h"
+#include "../libc/libc.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_string_view_t tb_string_view_cstr(tb_char_t const* s)
+{
+    return tb_string_view_init(s, s? tb_strlen(s) : 0);
+}
+tb_long_t tb_string_view_cmp(tb_string_view_t view, tb_string_view_t s)
+{
+    // compare the common data
+    tb_size_t n = tb_min(view.size, s.size);
+    tb_long_t r = n? tb_memcmp(view.data, s.data, n) : 0;
+
+    // compare the size
+    return r? r : (view.size > s.size? 1 : (view.size < s.size? -1 : 0));
+}
+tb_long_t tb_string_view_icmp(tb_string_view_t view, tb_string_view_t s)
+{
+    // compare the common data, the view may contain '\0'
+    tb_size_t           n = tb_min(view.size, s.size);
+    tb_char_t const*    p = view.data;
+    tb_char_t const*    q = s.data;
+    tb_char_t const*    e = p + n;
+    for (; p < e; p++, q++)
+    {
+        tb_char_t c1 = *p;
+        tb_char_t c2 = *q;
+        if (c1 != c2)
+        {
+            c1 = tb_tolower(c1);
+            c2 = tb_tolower(c2);
+            if (c1 != c2) return (tb_long_t)(tb_byte_t)c1 - (tb_long_t)(tb_byte_t)c2;
+        }
+    }
+
+    // compare the size
+    return view.size > s.size? 1 : (view.size < s.size? -1 : 0);
+}
+tb_long_t tb_string_view_chr(tb_string_view_t view, tb_size_t p, tb_char_t c)
+{
+    // find it
+    tb_char_t const* q = view.data + p;
+    tb_char_t const* e = view.data + view.size;
+    for (; q < e; q++) if (*q == c) return q - view.data;
+
+    // no find
+    return -1;
+}
+tb_long_t tb_string_view_str(tb_string_view_t view, tb_size_t p, tb_string_view_t s)
+{
+    // check
+    tb_check_return_val(p <= view.size && s.size <= view.size - p, -1);
+
+    // the empty string?
+    tb_check_return_val(s.size, p);
+
+    // find it
+    tb_char_t const* q = (tb_char_t const*)tb_memmem(view.data + p, view.size - p, s.data, s.size);
+    return q? q - view.data : -1;
+}
@@ -0,0 +1,151 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        string_view.h
+ * @ingroup     string
+ *
+ */
+#ifndef TB_STRING_VIEW_H
+#define TB_STRING_VIEW_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// make the string view from the c-string literal
+#define tb_string_view_literal(s)       tb_string_view_init(s, sizeof(s) - 1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the string view type 
+ *
+ * the borrowed slice of the string data, it does not own the data and may be not null-terminated.
+ */
+typedef struct __tb_string_view_t
+{
+    /// the data
+    tb_char_t const*            data;
+
+    /// the size
+    tb_size_t                   size;
+
+}tb_string_view_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+
+/*! init string view
+ *
+ * @param data          the data
+ * @param size          the size
+ *
+ * @return              the string view
+ */
+static __tb_inline__ tb_string_view_t tb_string_view_init(tb_char_t const* data, tb_size_t size)
+{
+    tb_string_view_t view;
+    view.data = data;
+    view.size = data? size : 0;
+    return view;
+}
+
+/*! the sub-view
+ *
+ * @param view          the string view
+ * @param offset        the offset
+ * @param size          the size, will be truncated to the view size
+ *
+ * @return              the sub-view
+ */
+static __tb_inline__ tb_string_view_t tb_string_view_sub(tb_string_view_t view, tb_size_t offset, tb_size_t size)
+{
+    if (offset > view.size) offset = view.size;
+    if (size > view.size - offset) size = view.size - offset;
+    return tb_string_view_init(view.data + offset, size);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init string view from the c-string
+ *
+ * @param s             the c-string
+ *
+ * @return              the string view
+ */
+tb_string_view_t        tb_string_view_cstr(tb_char_t const* s);
+
+/*! compare the string views
+ *
+ * @param view          the string view
+ * @param s             the compared string view
+ *
+ * @return              equal: 0
+ */
+tb_long_t               tb_string_view_cmp(tb_string_view_t view, tb_string_view_t s);
+
+/*! compare the string views with ignoring case
+ *
+ * @param view          the string view
+ * @param s             the compared string view
+ *
+ * @return              equal: 0
+ */
+tb_long_t               tb_string_view_icmp(tb_string_view_t view, tb_string_view_t s);
+
+/*! find the charactor
+ *
+ * @param view          the string view
+ * @param p             the start position
+ * @param c             the finded charactor
+ *
+ * @return              the real position, no find: -1
+ */
+tb_long_t               tb_string_view_chr(tb_string_view_t view, tb_size_t p, tb_char_t c);
+
+/*! find the string
+ *
+ * @param view          the string view
+ * @param p             the start position
+ * @param s             the finded string view
+ *
+ * @return              the real position, no find: -1
+ */
+tb_long_t               tb_string_view_str(tb_string_view_t view, tb_size_t p, tb_string_view_t s);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
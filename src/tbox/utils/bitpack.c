@@ -0,0 +1,226 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        bitpack.c
+ * @ingroup     utils
+ *
+ */
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "bitpack.h"
+#include "bits.h"
+#include "varint.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+#if defined(TB_ARCH_SSE2)
+#   include "impl/bitpack_x86.h"
+#elif defined(TB_ARCH_ARM_NEON)
+#   include "impl/bitpack_arm.h"
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_byte_t* tb_bitpack_encode_u32_impl(tb_byte_t* p, tb_uint32_t const* values, tb_size_t count, tb_size_t nbits, tb_uint32_t base)
+{
+    // done
+    tb_size_t   i = 0;
+    tb_uint64_t c = 0;
+    tb_size_t   n = 0;
+    tb_uint64_t m = nbits < 32? ((tb_uint64_t)1 << nbits) - 1 : 0xffffffff;
+    for (i = 0; i < count; i++)
+    {
+        // append the value to the cache, n < 32
+        c |= ((tb_uint32_t)(values[i] - base) & m) << n;
+        n += nbits;
+
+        // flush the low 32-bits
+        if (n >= 32)
+        {
+            tb_bits_set_u32_le(p, (tb_uint32_t)c);
+            p += 4;
+            c >>= 32;
+            n -= 32;
+        }
+    }
+
+    // flush the left bytes
+    for (; n > 0; n = n > 8? n - 8 : 0, c >>= 8) *p++ = (tb_byte_t)c;
+    return p;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t tb_bitpack_delta_encode_u32(tb_uint32_t* values, tb_size_t count, tb_uint32_t base)
+{
+    // check
+    tb_assert_and_check_return(values);
+
+    // done
+    tb_size_t   i = 0;
+    tb_uint32_t prev = base;
+    for (i = 0; i < count; i++)
+    {
+        tb_uint32_t v = values[i];
+        values[i] = v - prev;
+        prev = v;
+    }
+}
+tb_void_t tb_bitpack_delta_decode_u32(tb_uint32_t* values, tb_size_t count, tb_uint32_t base)
+{
+    // check
+    tb_assert_and_check_return(values);
+
+    // done
+    tb_size_t   i = 0;
+    tb_uint32_t prev = base;
+#ifdef TB_BITPACK_DELTA_DECODE_SIMD_ENABLE
+    // the prefix sum of the four values at once
+    i = tb_bitpack_delta_decode_u32_simd(values, count, &prev);
+#endif
+    for (; i < count; i++) 
+    {
+        prev += values[i];
+        values[i] = prev;
+    }
+}
+tb_size_t tb_bitpack_nbits_u32(tb_uint32_t const* values, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(values, 0);
+
+    // or the all values
+    tb_size_t   i = 0;
+    tb_uint32_t m = 0;
+    for (i = 0; i < count; i++) m |= values[i];
+
+    // the bits count
+    return m? 32 - tb_bits_cl0_u32_be(m) : 0;
+}
+tb_size_t tb_bitpack_encode_u32(tb_byte_t* data, tb_size_t maxn, tb_uint32_t const* values, tb_size_t count, tb_size_t nbits)
+{
+    // check
+    tb_assert_and_check_return_val(data && values && nbits <= 32, 0);
+
+    // the output size
+    tb_uint64_t size = TB_BITPACK_SIZE(count, nbits);
+    tb_check_return_val(size <= maxn, 0);
+
+    // pack values
+    tb_byte_t* p = tb_bitpack_encode_u32_impl(data, values, count, nbits, 0);
+
+    // the packed size
+    return p - data;
+}
+tb_size_t tb_bitpack_decode_u32(tb_byte_t const* data, tb_size_t size, tb_uint32_t* values, tb_size_t count, tb_size_t nbits)
+{
+    // check
+    tb_assert_and_check_return_val(data && values && nbits <= 32, 0);
+
+    // the input size
+    tb_uint64_t need = TB_BITPACK_SIZE(count, nbits);
+    tb_check_return_val(need <= size, 0);
+
+    // done
+    tb_size_t   i = 0;
+    tb_size_t   b = 0;
+    tb_uint64_t m = nbits < 32? ((tb_uint64_t)1 << nbits) - 1 : 0xffffffff;
+
+    // unpack the values with the unaligned 64-bits loads, (b & 7) + nbits <= 39
+    tb_size_t safe = size >= 8? ((size - 8) << 3) : 0;
+    for (; i < count && b <= safe; i++, b += nbits)
+        values[i] = (tb_uint32_t)((tb_bits_get_u64_le(data + (b >> 3)) >> (b & 7)) & m);
+
+    // unpack the left values byte by byte
+    for (; i < count; i++, b += nbits)
+    {
+        tb_size_t   j = b >> 3;
+        tb_size_t   e = (b + nbits + 7) >> 3;
+        tb_uint64_t v = 0;
+        tb_size_t   k = 0;
+        for (; j < e; j++, k += 8) v |= (tb_uint64_t)data[j] << k;
+        values[i] = (tb_uint32_t)((v >> (b & 7)) & m);
+    }
+
+    // ok
+    return (tb_size_t)need;
+}
+tb_size_t tb_bitpack_for_encode_u32(tb_byte_t* data, tb_size_t maxn, tb_uint32_t const* values, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(data && values, 0);
+
+    // the minimum and maximum value
+    tb_size_t   i = 0;
+    tb_uint32_t minv = count? values[0] : 0;
+    tb_uint32_t maxv = minv;
+    for (i = 1; i < count; i++)
+    {
+        if (values[i] < minv) minv = values[i];
+        if (values[i] > maxv) maxv = values[i];
+    }
+
+    // the bits count of the range
+    tb_uint32_t range = maxv - minv;
+    tb_size_t   nbits = range? 32 - tb_bits_cl0_u32_be(range) : 0;
+
+    // check the header size
+    tb_byte_t   head[TB_VARINT_MAXN_U32 + 1];
+    tb_size_t   n = tb_varint_encode_u32(head, minv);
+    head[n++] = (tb_byte_t)nbits;
+    tb_check_return_val(n + TB_BITPACK_SIZE(count, nbits) <= maxn, 0);
+
+    // save the header
+    for (i = 0; i < n; i++) data[i] = head[i];
+
+    // pack values with the minimum value
+    tb_byte_t* p = tb_bitpack_encode_u32_impl(data + n, values, count, nbits, minv);
+
+    // the encoded size
+    return p - data;
+}
+tb_size_t tb_bitpack_for_decode_u32(tb_byte_t const* data, tb_size_t size, tb_uint32_t* values, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(data && values, 0);
+
+    // decode the header
+    tb_uint32_t minv = 0;
+    tb_size_t   n = tb_varint_decode_u32(data, size, &minv);
+    tb_check_return_val(n && n < size, 0);
+
+    // the bits count
+    tb_size_t nbits = data[n++];
+    tb_check_return_val(nbits <= 32, 0);
+
+    // unpack values
+    tb_size_t packed = tb_bitpack_decode_u32(data + n, size - n, values, count, nbits);
+    tb_check_return_val(packed || !TB_BITPACK_SIZE(count, nbits), 0);
+
+    // add the minimum value
+    tb_size_t i = 0;
+    if (minv) for (i = 0; i < count; i++) values[i] += minv;
+
+    // the decoded size
+    return n + packed;
+}
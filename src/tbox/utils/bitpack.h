@@ -0,0 +1,133 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        bitpack.h
+ * @ingroup     utils
+ *
+ */
+#ifndef TB_UTILS_BITPACK_H
+#define TB_UTILS_BITPACK_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the bit-packed size for the given count of nbits values
+#define TB_BITPACK_SIZE(count, nbits)           (((tb_uint64_t)(count) * (nbits) + 7) >> 3)
+
+/// the maximum frame-of-reference size for the given count of uint32, the header and the packed data
+#define TB_BITPACK_FOR_MAXN(count)              (6 + ((count) << 2))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! encode the delta of the sorted uint32 values in place
+ *
+ * values[i] = values[i] - values[i - 1], values[-1] = base
+ *
+ * @param values    the values
+ * @param count     the values count
+ * @param base      the base value
+ */
+tb_void_t           tb_bitpack_delta_encode_u32(tb_uint32_t* values, tb_size_t count, tb_uint32_t base);
+
+/*! decode the delta of the uint32 values in place, the prefix sum
+ *
+ * @param values    the values
+ * @param count     the values count
+ * @param base      the base value
+ */
+tb_void_t           tb_bitpack_delta_decode_u32(tb_uint32_t* values, tb_size_t count, tb_uint32_t base);
+
+/*! the bits count for packing the all uint32 values
+ *
+ * @param values    the values
+ * @param count     the values count
+ *
+ * @return          the bits count, 0 - 32
+ */
+tb_size_t           tb_bitpack_nbits_u32(tb_uint32_t const* values, tb_size_t count);
+
+/*! pack the low nbits of the uint32 values, the lsb first
+ *
+ * @param data      the output data
+ * @param maxn      the output maxn, TB_BITPACK_SIZE(count, nbits) bytes at least
+ * @param values    the values
+ * @param count     the values count
+ * @param nbits     the bits count, 0 - 32
+ *
+ * @return          the packed size, return zero if the output data is not enough
+ */
+tb_size_t           tb_bitpack_encode_u32(tb_byte_t* data, tb_size_t maxn, tb_uint32_t const* values, tb_size_t count, tb_size_t nbits);
+
+/*! unpack the nbits uint32 values
+ *
+ * @param data      the input data
+ * @param size      the input size
+ * @param values    the values
+ * @param count     the values count
+ * @param nbits     the bits count, 0 - 32
+ *
+ * @return          the unpacked size, return zero if the input data is truncated
+ */
+tb_size_t           tb_bitpack_decode_u32(tb_byte_t const* data, tb_size_t size, tb_uint32_t* values, tb_size_t count, tb_size_t nbits);
+
+/*! encode the uint32 values with the frame-of-reference
+ *
+ * <pre>
+ * [minimum value: leb128 varint][nbits: 1 byte][bit-packed values - minimum value]
+ * </pre>
+ *
+ * @param data      the output data
+ * @param maxn      the output maxn, TB_BITPACK_FOR_MAXN(count) bytes is always enough
+ * @param values    the values
+ * @param count     the values count
+ *
+ * @return          the encoded size, return zero if the output data is not enough
+ */
+tb_size_t           tb_bitpack_for_encode_u32(tb_byte_t* data, tb_size_t maxn, tb_uint32_t const* values, tb_size_t count);
+
+/*! decode the uint32 values with the frame-of-reference
+ *
+ * @param data      the input data
+ * @param size      the input size
+ * @param values    the values
+ * @param count     the values count
+ *
+ * @return          the decoded size, return zero if the input data is truncated or invalid
+ */
+tb_size_t           tb_bitpack_for_decode_u32(tb_byte_t const* data, tb_size_t size, tb_uint32_t* values, tb_size_t count);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -0,0 +1,66 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        bitpack_arm.h
+ *
+ */
+#ifndef TB_UTILS_IMPL_BITPACK_ARM_H
+#define TB_UTILS_IMPL_BITPACK_ARM_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include <arm_neon.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+#define TB_BITPACK_DELTA_DECODE_SIMD_ENABLE
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+
+// the prefix sum of the four values at once, return the decoded values count
+static tb_size_t tb_bitpack_delta_decode_u32_simd(tb_uint32_t* values, tb_size_t count, tb_uint32_t* pprev)
+{
+    // done
+    tb_size_t   i = 0;
+    uint32x4_t  z = vdupq_n_u32(0);
+    uint32x4_t  prev = vdupq_n_u32(*pprev);
+    for (; i + 4 <= count; i += 4)
+    {
+        // [a, b, c, d] => [a, a + b, a + b + c, a + b + c + d]
+        uint32x4_t v = vld1q_u32(values + i);
+        v = vaddq_u32(v, vextq_u32(z, v, 3));
+        v = vaddq_u32(v, vextq_u32(z, v, 2));
+        v = vaddq_u32(v, prev);
+        vst1q_u32(values + i, v);
+
+        // broadcast the last value
+        prev = vdupq_n_u32(vgetq_lane_u32(v, 3));
+    }
+
+    // save the last value
+    *pprev = vgetq_lane_u32(prev, 0);
+    return i;
+}
+
+#endif
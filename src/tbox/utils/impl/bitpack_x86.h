@@ -0,0 +1,65 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        bitpack_x86.h
+ *
+ */
+#ifndef TB_UTILS_IMPL_BITPACK_X86_H
+#define TB_UTILS_IMPL_BITPACK_X86_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include <emmintrin.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+#define TB_BITPACK_DELTA_DECODE_SIMD_ENABLE
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+
+// the prefix sum of the four values at once, return the decoded values count
+static tb_size_t tb_bitpack_delta_decode_u32_simd(tb_uint32_t* values, tb_size_t count, tb_uint32_t* pprev)
+{
+    // done
+    tb_size_t   i = 0;
+    __m128i     prev = _mm_set1_epi32((tb_int_t)*pprev);
+    for (; i + 4 <= count; i += 4)
+    {
+        // [a, b, c, d] => [a, a + b, a + b + c, a + b + c + d]
+        __m128i v = _mm_loadu_si128((__m128i const*)(values + i));
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 8));
+        v = _mm_add_epi32(v, prev);
+        _mm_storeu_si128((__m128i*)(values + i), v);
+
+        // broadcast the last value
+        prev = _mm_shuffle_epi32(v, 0xff);
+    }
+
+    // save the last value
+    *pprev = (tb_uint32_t)_mm_cvtsi128_si32(prev);
+    return i;
+}
+
+#endif
@@ -0,0 +1,56 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        varint_arm.h
+ *
+ */
+#ifndef TB_UTILS_IMPL_VARINT_ARM_H
+#define TB_UTILS_IMPL_VARINT_ARM_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include <arm_neon.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+
+// decode the stream-vbyte groups with tbl, return the decoded values count
+static tb_size_t tb_varint_svb_decode_u32_simd(tb_byte_t const* ctrl, tb_byte_t const** pdata, tb_byte_t const* e, tb_uint32_t* values, tb_size_t count)
+{
+    // done, we need load 16 bytes for each group
+    tb_size_t           i = 0;
+    tb_byte_t const*    p = *pdata;
+    for (; i + 4 <= count && p + 16 <= e; i += 4)
+    {
+        tb_size_t   c = ctrl[i >> 2];
+        uint8x16_t  d = vld1q_u8(p);
+        uint8x16_t  m = vld1q_u8(g_varint_svb_shuf[c]);
+        vst1q_u32(values + i, vreinterpretq_u32_u8(vqtbl1q_u8(d, m)));
+        p += g_varint_svb_size[c];
+    }
+
+    // update the data position
+    *pdata = p;
+    return i;
+}
+
+#endif
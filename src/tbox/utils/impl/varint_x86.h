@@ -0,0 +1,56 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        varint_x86.h
+ *
+ */
+#ifndef TB_UTILS_IMPL_VARINT_X86_H
+#define TB_UTILS_IMPL_VARINT_X86_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include <tmmintrin.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+
+// decode the stream-vbyte groups with pshufb, return the decoded values count
+static tb_size_t tb_varint_svb_decode_u32_simd(tb_byte_t const* ctrl, tb_byte_t const** pdata, tb_byte_t const* e, tb_uint32_t* values, tb_size_t count)
+{
+    // done, we need load 16 bytes for each group
+    tb_size_t           i = 0;
+    tb_byte_t const*    p = *pdata;
+    for (; i + 4 <= count && p + 16 <= e; i += 4)
+    {
+        tb_size_t c = ctrl[i >> 2];
+        __m128i   d = _mm_loadu_si128((__m128i const*)p);
+        __m128i   m = _mm_loadu_si128((__m128i const*)g_varint_svb_shuf[c]);
+        _mm_storeu_si128((__m128i*)(values + i), _mm_shuffle_epi8(d, m));
+        p += g_varint_svb_size[c];
+    }
+
+    // update the data position
+    *pdata = p;
+    return i;
+}
+
+#endif
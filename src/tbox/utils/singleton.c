@@ -63,6 +63,27 @@ typedef struct __tb_singleton_t
 // the singletons
 static tb_singleton_t g_singletons[TB_SINGLETON_TYPE_MAXN] = {{0}};
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+
+/* the singleton type at the given killing and exiting order, they are killed and exited from the last order
+ *
+ * order: builtin types => reserved types => user defined types
+ */
+static __tb_inline__ tb_size_t tb_singleton_type(tb_size_t order)
+{
+    // the builtin types
+    if (order < TB_SINGLETON_TYPE_USER) return order;
+
+    // the reserved types
+    tb_size_t reserved = TB_SINGLETON_TYPE_MAXN - TB_SINGLETON_TYPE_RESERVED;
+    if (order < TB_SINGLETON_TYPE_USER + reserved) return TB_SINGLETON_TYPE_RESERVED + order - TB_SINGLETON_TYPE_USER;
+
+    // the user defined types
+    return order - reserved;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -88,9 +109,10 @@ tb_bool_t tb_singleton_init()
 }
 tb_void_t tb_singleton_kill()
 {
-    tb_size_t i = TB_SINGLETON_TYPE_MAXN;
-    while (i--)
+    tb_size_t n = TB_SINGLETON_TYPE_MAXN;
+    while (n--)
     {
+        tb_size_t i = tb_singleton_type(n);
         if (g_singletons[i].kill) 
         {
             // the instance
@@ -109,9 +131,10 @@ tb_void_t tb_singleton_kill()
 tb_void_t tb_singleton_exit()
 {
     // done
-    tb_size_t i = TB_SINGLETON_TYPE_MAXN;
-    while (i--)
+    tb_size_t n = TB_SINGLETON_TYPE_MAXN;
+    while (n--)
     {
+        tb_size_t i = tb_singleton_type(n);
         if (g_singletons[i].exit) 
         {
             // the instance
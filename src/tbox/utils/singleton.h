@@ -83,7 +83,7 @@ typedef enum __tb_singleton_type_e
     /// the cookies type
 ,   TB_SINGLETON_TYPE_COOKIES               = 13
 
-    /// the user defined type
+    /// the user defined type, the user defined types must be less than TB_SINGLETON_TYPE_RESERVED
 ,   TB_SINGLETON_TYPE_USER                  = 14
 
     /// the max count of the singleton type
@@ -93,6 +93,18 @@ typedef enum __tb_singleton_type_e
 ,   TB_SINGLETON_TYPE_MAXN                  = 128
 #endif
 
+    /*! the reserved types for the new builtin types, which keeps the value of TB_SINGLETON_TYPE_USER
+     *
+     * they will be killed and exited after the user defined types and before the other builtin types
+     */
+,   TB_SINGLETON_TYPE_RESERVED              = TB_SINGLETON_TYPE_MAXN - 4
+
+    /// the polarssl library type
+,   TB_SINGLETON_TYPE_LIBRARY_POLARSSL      = TB_SINGLETON_TYPE_RESERVED
+
+    /// the coroutine pool type
+,   TB_SINGLETON_TYPE_CO_POOL               = TB_SINGLETON_TYPE_RESERVED + 1
+
 }tb_singleton_type_e;
 
 /// the singleton init func type
@@ -43,5 +43,7 @@
 #include "singleton.h"
 #include "lock_profiler.h"
 #include "fnv32.h"
+#include "varint.h"
+#include "bitpack.h"
 
 #endif
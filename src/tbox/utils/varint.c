@@ -0,0 +1,465 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        varint.c
+ * @ingroup     utils
+ *
+ */
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "varint.h"
+#include "bits.h"
+#include "../libc/libc.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// enable the simd stream-vbyte decoder?
+#if defined(TB_ARCH_SSSE3) || (defined(TB_ARCH_ARM64) && defined(TB_ARCH_ARM_NEON))
+#   define TB_VARINT_SVB_SIMD_ENABLE
+#endif
+
+// the size of the value i in the group for the control byte c
+#define TB_VARINT_SVB_L(c, i)           ((((c) >> ((i) << 1)) & 3) + 1)
+
+// the total size of the group for the control byte c
+#define TB_VARINT_SVB_N(c)              (TB_VARINT_SVB_L(c, 0) + TB_VARINT_SVB_L(c, 1) + TB_VARINT_SVB_L(c, 2) + TB_VARINT_SVB_L(c, 3))
+
+// the offset of the value i in the group for the control byte c
+#define TB_VARINT_SVB_O0(c)             (0)
+#define TB_VARINT_SVB_O1(c)             (TB_VARINT_SVB_L(c, 0))
+#define TB_VARINT_SVB_O2(c)             (TB_VARINT_SVB_O1(c) + TB_VARINT_SVB_L(c, 1))
+#define TB_VARINT_SVB_O3(c)             (TB_VARINT_SVB_O2(c) + TB_VARINT_SVB_L(c, 2))
+
+// the shuffle index of the byte j of the value i, 0xff: zero
+#define TB_VARINT_SVB_B(c, i, j)        ((j) < TB_VARINT_SVB_L(c, i)? TB_VARINT_SVB_O##i(c) + (j) : 0xff)
+#define TB_VARINT_SVB_V(c, i)           TB_VARINT_SVB_B(c, i, 0), TB_VARINT_SVB_B(c, i, 1), TB_VARINT_SVB_B(c, i, 2), TB_VARINT_SVB_B(c, i, 3)
+#define TB_VARINT_SVB_S(c)              {TB_VARINT_SVB_V(c, 0), TB_VARINT_SVB_V(c, 1), TB_VARINT_SVB_V(c, 2), TB_VARINT_SVB_V(c, 3)}
+
+// make table for the control bytes
+#define TB_VARINT_SVB_4(m, c)           m(c), m(c + 1), m(c + 2), m(c + 3)
+#define TB_VARINT_SVB_16(m, c)          TB_VARINT_SVB_4(m, c), TB_VARINT_SVB_4(m, c + 4), TB_VARINT_SVB_4(m, c + 8), TB_VARINT_SVB_4(m, c + 12)
+#define TB_VARINT_SVB_64(m, c)          TB_VARINT_SVB_16(m, c), TB_VARINT_SVB_16(m, c + 16), TB_VARINT_SVB_16(m, c + 32), TB_VARINT_SVB_16(m, c + 48)
+#define TB_VARINT_SVB_256(m)            TB_VARINT_SVB_64(m, 0), TB_VARINT_SVB_64(m, 64), TB_VARINT_SVB_64(m, 128), TB_VARINT_SVB_64(m, 192)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+#ifdef TB_VARINT_SVB_SIMD_ENABLE
+// the group size for the control byte
+static tb_byte_t const g_varint_svb_size[256] = {TB_VARINT_SVB_256(TB_VARINT_SVB_N)};
+
+// the shuffle mask for the control byte
+static tb_byte_t const g_varint_svb_shuf[256][16] = {TB_VARINT_SVB_256(TB_VARINT_SVB_S)};
+#endif
+
+// the mask for the value size
+static tb_uint32_t const g_varint_svb_mask[5] = {0, 0xff, 0xffff, 0xffffff, 0xffffffff};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+#if defined(TB_ARCH_SSSE3)
+#   include "impl/varint_x86.h"
+#elif defined(TB_ARCH_ARM64) && defined(TB_ARCH_ARM_NEON)
+#   include "impl/varint_arm.h"
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline_force__ tb_size_t tb_varint_decode_u32_inline(tb_byte_t const* data, tb_size_t size, tb_uint32_t* pval)
+{
+    // one byte?
+    if (__tb_likely__(size && !(data[0] & 0x80)))
+    {
+        *pval = data[0];
+        return 1;
+    }
+
+    // decode it, the fifth byte can only have the four bits
+    tb_size_t   i = 0;
+    tb_size_t   n = tb_min(size, TB_VARINT_MAXN_U32);
+    tb_uint32_t v = 0;
+    for (i = 0; i < n; i++)
+    {
+        tb_byte_t b = data[i];
+        v |= (tb_uint32_t)(b & 0x7f) << (i * 7);
+        if (!(b & 0x80))
+        {
+            // overflow?
+            tb_check_return_val(i < 4 || b <= 0x0f, 0);
+
+            // ok
+            *pval = v;
+            return i + 1;
+        }
+    }
+
+    // truncated or overflow
+    return 0;
+}
+static __tb_inline_force__ tb_size_t tb_varint_decode_u64_inline(tb_byte_t const* data, tb_size_t size, tb_uint64_t* pval)
+{
+    // one byte?
+    if (__tb_likely__(size && !(data[0] & 0x80)))
+    {
+        *pval = data[0];
+        return 1;
+    }
+
+    // decode it, the tenth byte can only have the one bit
+    tb_size_t   i = 0;
+    tb_size_t   n = tb_min(size, TB_VARINT_MAXN_U64);
+    tb_uint64_t v = 0;
+    for (i = 0; i < n; i++)
+    {
+        tb_byte_t b = data[i];
+        v |= (tb_uint64_t)(b & 0x7f) << (i * 7);
+        if (!(b & 0x80))
+        {
+            // overflow?
+            tb_check_return_val(i < 9 || b <= 0x01, 0);
+
+            // ok
+            *pval = v;
+            return i + 1;
+        }
+    }
+
+    // truncated or overflow
+    return 0;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_size_t tb_varint_size_u64(tb_uint64_t val)
+{
+    // (bits + 6) / 7
+    return (64 - tb_bits_cl0_u64_be(val | 1) + 6) / 7;
+}
+tb_size_t tb_varint_encode_u32(tb_byte_t* data, tb_uint32_t val)
+{
+    // check
+    tb_assert_and_check_return_val(data, 0);
+
+    // encode the low 7 bits with the continuation bit
+    tb_byte_t* p = data;
+    while (val >= 0x80)
+    {
+        *p++ = (tb_byte_t)(val | 0x80);
+        val >>= 7;
+    }
+    *p++ = (tb_byte_t)val;
+
+    // the encoded size
+    return p - data;
+}
+tb_size_t tb_varint_encode_u64(tb_byte_t* data, tb_uint64_t val)
+{
+    // check
+    tb_assert_and_check_return_val(data, 0);
+
+    // encode the low 7 bits with the continuation bit
+    tb_byte_t* p = data;
+    while (val >= 0x80)
+    {
+        *p++ = (tb_byte_t)(val | 0x80);
+        val >>= 7;
+    }
+    *p++ = (tb_byte_t)val;
+
+    // the encoded size
+    return p - data;
+}
+tb_size_t tb_varint_decode_u32(tb_byte_t const* data, tb_size_t size, tb_uint32_t* pval)
+{
+    // check
+    tb_assert_and_check_return_val(data && pval, 0);
+
+    // decode it
+    return tb_varint_decode_u32_inline(data, size, pval);
+}
+tb_size_t tb_varint_decode_u64(tb_byte_t const* data, tb_size_t size, tb_uint64_t* pval)
+{
+    // check
+    tb_assert_and_check_return_val(data && pval, 0);
+
+    // decode it
+    return tb_varint_decode_u64_inline(data, size, pval);
+}
+tb_size_t tb_varint_encode_u32_n(tb_byte_t* data, tb_size_t maxn, tb_uint32_t const* values, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(data && values, 0);
+
+    // done
+    tb_byte_t*          p = data;
+    tb_byte_t*          e = data + maxn;
+    tb_uint32_t const*  v = values;
+    tb_uint32_t const*  ve = values + count;
+    while (v < ve)
+    {
+        // enough? encode it directly
+        if (__tb_likely__(p + TB_VARINT_MAXN_U32 <= e)) p += tb_varint_encode_u32(p, *v++);
+        else
+        {
+            // check the size
+            tb_byte_t b[TB_VARINT_MAXN_U32];
+            tb_size_t n = tb_varint_encode_u32(b, *v++);
+            tb_check_return_val(p + n <= e, 0);
+
+            // copy it
+            tb_memcpy(p, b, n);
+            p += n;
+        }
+    }
+
+    // the encoded size
+    return p - data;
+}
+tb_size_t tb_varint_decode_u32_n(tb_byte_t const* data, tb_size_t size, tb_uint32_t* values, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(data && values, 0);
+
+    // done
+    tb_byte_t const*    p = data;
+    tb_byte_t const*    e = data + size;
+    tb_uint32_t*        v = values;
+    tb_uint32_t*        ve = values + count;
+    while (v < ve)
+    {
+        // decode the eight one-byte varints at once
+        if (p + 8 <= e && v + 8 <= ve)
+        {
+            tb_uint64_t w = tb_bits_get_u64_le(p);
+            if (!(w & 0x8080808080808080ULL))
+            {
+                v[0] = (tb_uint32_t)(w & 0xff);
+                v[1] = (tb_uint32_t)((w >> 8) & 0xff);
+                v[2] = (tb_uint32_t)((w >> 16) & 0xff);
+                v[3] = (tb_uint32_t)((w >> 24) & 0xff);
+                v[4] = (tb_uint32_t)((w >> 32) & 0xff);
+                v[5] = (tb_uint32_t)((w >> 40) & 0xff);
+                v[6] = (tb_uint32_t)((w >> 48) & 0xff);
+                v[7] = (tb_uint32_t)(w >> 56);
+                v += 8;
+                p += 8;
+                continue ;
+            }
+        }
+
+        // decode the next varint
+        tb_size_t n = tb_varint_decode_u32_inline(p, e - p, v);
+        tb_check_return_val(n, 0);
+
+        // next
+        p += n;
+        v++;
+    }
+
+    // the decoded size
+    return p - data;
+}
+tb_size_t tb_varint_encode_u64_n(tb_byte_t* data, tb_size_t maxn, tb_uint64_t const* values, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(data && values, 0);
+
+    // done
+    tb_byte_t*          p = data;
+    tb_byte_t*          e = data + maxn;
+    tb_uint64_t const*  v = values;
+    tb_uint64_t const*  ve = values + count;
+    while (v < ve)
+    {
+        // enough? encode it directly
+        if (__tb_likely__(p + TB_VARINT_MAXN_U64 <= e)) p += tb_varint_encode_u64(p, *v++);
+        else
+        {
+            // check the size
+            tb_byte_t b[TB_VARINT_MAXN_U64];
+            tb_size_t n = tb_varint_encode_u64(b, *v++);
+            tb_check_return_val(p + n <= e, 0);
+
+            // copy it
+            tb_memcpy(p, b, n);
+            p += n;
+        }
+    }
+
+    // the encoded size
+    return p - data;
+}
+tb_size_t tb_varint_decode_u64_n(tb_byte_t const* data, tb_size_t size, tb_uint64_t* values, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(data && values, 0);
+
+    // done
+    tb_byte_t const*    p = data;
+    tb_byte_t const*    e = data + size;
+    tb_uint64_t*        v = values;
+    tb_uint64_t*        ve = values + count;
+    while (v < ve)
+    {
+        // decode the next varint
+        tb_size_t n = tb_varint_decode_u64_inline(p, e - p, v);
+        tb_check_return_val(n, 0);
+
+        // next
+        p += n;
+        v++;
+    }
+
+    // the decoded size
+    return p - data;
+}
+tb_bool_t tb_varint_encode_u32_buffer(tb_buffer_ref_t buffer, tb_uint32_t const* values, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(buffer && values, tb_false);
+
+    // grow the buffer for the maximum size
+    tb_size_t   size = tb_buffer_size(buffer);
+    tb_size_t   maxn = count * TB_VARINT_MAXN_U32;
+    tb_byte_t*  data = tb_buffer_resize(buffer, size + maxn);
+    tb_assert_and_check_return_val(data, tb_false);
+
+    // encode it
+    tb_size_t real = tb_varint_encode_u32_n(data + size, maxn, values, count);
+
+    // trim the buffer
+    return tb_buffer_resize(buffer, size + real)? tb_true : tb_false;
+}
+tb_size_t tb_varint_svb_encode_u32(tb_byte_t* data, tb_size_t maxn, tb_uint32_t const* values, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(data && values, 0);
+
+    // the control bytes
+    tb_size_t   n = (count + 3) >> 2;
+    tb_byte_t*  c = data;
+    tb_check_return_val(n <= maxn, 0);
+    if (n) tb_memset(c, 0, n);
+
+    // encode the values
+    tb_size_t   i = 0;
+    tb_byte_t*  p = data + n;
+    tb_byte_t*  e = data + maxn;
+    for (i = 0; i < count; i++)
+    {
+        // the value size
+        tb_uint32_t v = values[i];
+        tb_size_t   l = (v >> 8)? (v >> 16)? (v >> 24)? 4 : 3 : 2 : 1;
+
+        // save the size - 1 to the control bits
+        c[i >> 2] |= (tb_byte_t)((l - 1) << ((i & 3) << 1));
+
+        // save the value
+        if (__tb_likely__(p + 4 <= e)) tb_bits_set_u32_le(p, v);
+        else
+        {
+            // check
+            tb_check_return_val(p + l <= e, 0);
+
+            // save the low bytes
+            tb_size_t j = 0;
+            for (j = 0; j < l; j++) p[j] = (tb_byte_t)(v >> (j << 3));
+        }
+        p += l;
+    }
+
+    // the encoded size
+    return p - data;
+}
+tb_size_t tb_varint_svb_decode_u32(tb_byte_t const* data, tb_size_t size, tb_uint32_t* values, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(data && values, 0);
+
+    // the control bytes
+    tb_size_t           n = (count + 3) >> 2;
+    tb_byte_t const*    c = data;
+    tb_check_return_val(n <= size, 0);
+
+    // the data bytes
+    tb_size_t           i = 0;
+    tb_byte_t const*    p = data + n;
+    tb_byte_t const*    e = data + size;
+
+#ifdef TB_VARINT_SVB_SIMD_ENABLE
+    // decode the groups with the shuffle
+    i = tb_varint_svb_decode_u32_simd(c, &p, e, values, count);
+#endif
+
+    // decode the groups with the word loads
+    for (; i + 4 <= count && p + 16 <= e; i += 4)
+    {
+        tb_size_t ctrl = c[i >> 2];
+        tb_size_t l0 = TB_VARINT_SVB_L(ctrl, 0);
+        tb_size_t l1 = TB_VARINT_SVB_L(ctrl, 1);
+        tb_size_t l2 = TB_VARINT_SVB_L(ctrl, 2);
+        tb_size_t l3 = TB_VARINT_SVB_L(ctrl, 3);
+        values[i]       = tb_bits_get_u32_le(p) & g_varint_svb_mask[l0]; p += l0;
+        values[i + 1]   = tb_bits_get_u32_le(p) & g_varint_svb_mask[l1]; p += l1;
+        values[i + 2]   = tb_bits_get_u32_le(p) & g_varint_svb_mask[l2]; p += l2;
+        values[i + 3]   = tb_bits_get_u32_le(p) & g_varint_svb_mask[l3]; p += l3;
+    }
+
+    // decode the left values
+    for (; i < count; i++)
+    {
+        // the value size
+        tb_size_t l = TB_VARINT_SVB_L(c[i >> 2], i & 3);
+        tb_check_return_val(p + l <= e, 0);
+
+        // the value
+        tb_size_t   j = 0;
+        tb_uint32_t v = 0;
+        for (j = 0; j < l; j++) v |= (tb_uint32_t)p[j] << (j << 3);
+        values[i] = v;
+        p += l;
+    }
+
+    // the decoded size
+    return p - data;
+}
+tb_bool_t tb_varint_svb_encode_u32_buffer(tb_buffer_ref_t buffer, tb_uint32_t const* values, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(buffer && values, tb_false);
+
+    // grow the buffer for the maximum size
+    tb_size_t   size = tb_buffer_size(buffer);
+    tb_size_t   maxn = TB_VARINT_SVB_MAXN(count);
+    tb_byte_t*  data = tb_buffer_resize(buffer, size + maxn);
+    tb_assert_and_check_return_val(data, tb_false);
+
+    // encode it
+    tb_size_t real = tb_varint_svb_encode_u32(data + size, maxn, values, count);
+
+    // trim the buffer
+    return tb_buffer_resize(buffer, size + real)? tb_true : tb_false;
+}
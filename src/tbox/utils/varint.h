@@ -0,0 +1,208 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        varint.h
+ * @ingroup     utils
+ *
+ */
+#ifndef TB_UTILS_VARINT_H
+#define TB_UTILS_VARINT_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../memory/buffer.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the maximum varint size for uint32
+#define TB_VARINT_MAXN_U32                  (5)
+
+/// the maximum varint size for uint64
+#define TB_VARINT_MAXN_U64                  (10)
+
+/// the maximum stream-vbyte size for the given count of uint32, the control bytes and the data bytes
+#define TB_VARINT_SVB_MAXN(count)           ((((count) + 3) >> 2) + ((count) << 2))
+
+/// encode zigzag: 0 => 0, -1 => 1, 1 => 2, -2 => 3, ...
+#define tb_zigzag_encode_s32(x)             ((((tb_uint32_t)(x)) << 1) ^ (tb_uint32_t)(((tb_sint32_t)(x)) >> 31))
+#define tb_zigzag_encode_s64(x)             ((((tb_uint64_t)(x)) << 1) ^ (tb_uint64_t)(((tb_sint64_t)(x)) >> 63))
+
+/// decode zigzag
+#define tb_zigzag_decode_u32(x)             ((tb_sint32_t)(((tb_uint32_t)(x)) >> 1) ^ -(tb_sint32_t)(((tb_uint32_t)(x)) & 1))
+#define tb_zigzag_decode_u64(x)             ((tb_sint64_t)(((tb_uint64_t)(x)) >> 1) ^ -(tb_sint64_t)(((tb_uint64_t)(x)) & 1))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! the leb128 varint size of the given value
+ *
+ * @param val       the value
+ *
+ * @return          the size, 1 - 10
+ */
+tb_size_t           tb_varint_size_u64(tb_uint64_t val);
+
+/*! encode the uint32 value to the leb128 varint
+ *
+ * @param data      the output data, TB_VARINT_MAXN_U32 bytes at least
+ * @param val       the value
+ *
+ * @return          the encoded size
+ */
+tb_size_t           tb_varint_encode_u32(tb_byte_t* data, tb_uint32_t val);
+
+/*! encode the uint64 value to the leb128 varint
+ *
+ * @param data      the output data, TB_VARINT_MAXN_U64 bytes at least
+ * @param val       the value
+ *
+ * @return          the encoded size
+ */
+tb_size_t           tb_varint_encode_u64(tb_byte_t* data, tb_uint64_t val);
+
+/*! decode the uint32 value from the leb128 varint
+ *
+ * @param data      the input data
+ * @param size      the input size
+ * @param pval      the decoded value
+ *
+ * @return          the decoded size, return zero if the varint is truncated or overflow
+ */
+tb_size_t           tb_varint_decode_u32(tb_byte_t const* data, tb_size_t size, tb_uint32_t* pval);
+
+/*! decode the uint64 value from the leb128 varint
+ *
+ * @param data      the input data
+ * @param size      the input size
+ * @param pval      the decoded value
+ *
+ * @return          the decoded size, return zero if the varint is truncated or overflow
+ */
+tb_size_t           tb_varint_decode_u64(tb_byte_t const* data, tb_size_t size, tb_uint64_t* pval);
+
+/*! encode the uint32 values to the leb128 varints
+ *
+ * @param data      the output data
+ * @param maxn      the output maxn, count * TB_VARINT_MAXN_U32 bytes is always enough
+ * @param values    the values
+ * @param count     the values count
+ *
+ * @return          the encoded size, return zero if the output data is not enough
+ */
+tb_size_t           tb_varint_encode_u32_n(tb_byte_t* data, tb_size_t maxn, tb_uint32_t const* values, tb_size_t count);
+
+/*! decode the uint32 values from the leb128 varints
+ *
+ * the one-byte varints are decoded eight at a time
+ *
+ * @param data      the input data
+ * @param size      the input size
+ * @param values    the values
+ * @param count     the values count
+ *
+ * @return          the decoded size, return zero if the input data is truncated or invalid
+ */
+tb_size_t           tb_varint_decode_u32_n(tb_byte_t const* data, tb_size_t size, tb_uint32_t* values, tb_size_t count);
+
+/*! encode the uint64 values to the leb128 varints
+ *
+ * @param data      the output data
+ * @param maxn      the output maxn, count * TB_VARINT_MAXN_U64 bytes is always enough
+ * @param values    the values
+ * @param count     the values count
+ *
+ * @return          the encoded size, return zero if the output data is not enough
+ */
+tb_size_t           tb_varint_encode_u64_n(tb_byte_t* data, tb_size_t maxn, tb_uint64_t const* values, tb_size_t count);
+
+/*! decode the uint64 values from the leb128 varints
+ *
+ * @param data      the input data
+ * @param size      the input size
+ * @param values    the values
+ * @param count     the values count
+ *
+ * @return          the decoded size, return zero if the input data is truncated or invalid
+ */
+tb_size_t           tb_varint_decode_u64_n(tb_byte_t const* data, tb_size_t size, tb_uint64_t* values, tb_size_t count);
+
+/*! encode the uint32 values to the leb128 varints and append them to the buffer
+ *
+ * @param buffer    the buffer
+ * @param values    the values
+ * @param count     the values count
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_varint_encode_u32_buffer(tb_buffer_ref_t buffer, tb_uint32_t const* values, tb_size_t count);
+
+/*! encode the uint32 values with the stream-vbyte format
+ *
+ * <pre>
+ * [control bytes: 2-bits size - 1 for each value, (count + 3) / 4 bytes][data bytes: 1 - 4 bytes for each value, little-endian]
+ * </pre>
+ *
+ * @param data      the output data
+ * @param maxn      the output maxn, TB_VARINT_SVB_MAXN(count) bytes is always enough
+ * @param values    the values
+ * @param count     the values count
+ *
+ * @return          the encoded size, return zero if the output data is not enough
+ */
+tb_size_t           tb_varint_svb_encode_u32(tb_byte_t* data, tb_size_t maxn, tb_uint32_t const* values, tb_size_t count);
+
+/*! decode the uint32 values with the stream-vbyte format
+ *
+ * the four values are decoded by one shuffle if the ssse3 or arm64 neon is enabled
+ *
+ * @param data      the input data
+ * @param size      the input size
+ * @param values    the values
+ * @param count     the values count
+ *
+ * @return          the decoded size, return zero if the input data is truncated
+ */
+tb_size_t           tb_varint_svb_decode_u32(tb_byte_t const* data, tb_size_t size, tb_uint32_t* values, tb_size_t count);
+
+/*! encode the uint32 values with the stream-vbyte format and append them to the buffer
+ *
+ * @param buffer    the buffer
+ * @param values    the values
+ * @param count     the values count
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_varint_svb_encode_u32_buffer(tb_buffer_ref_t buffer, tb_uint32_t const* values, tb_size_t count);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -97,6 +97,12 @@ target("tbox")
     -- add the source files for arm
     if is_arch("arm.*") then
         add_files("utils/impl/crc_arm.S")
+        add_files("platform/arch/arm/context.S")
+    end
+
+    -- add the source files for x86_64
+    if is_arch("x86_64") and not is_os("windows") then
+        add_files("platform/arch/x64/context.S")
     end
 
     -- add the source files for the float type
@@ -132,6 +138,7 @@ target("tbox")
     if is_option("asio") then 
         add_files("asio/aico.c")
         add_files("asio/aicp.c")
+        add_files("asio/co.c")
         add_files("asio/http.c")
         add_files("asio/dns.c")
         add_files("stream/**async_**.c")
@@ -289,6 +296,7 @@ target("tbox")
     add_cfuncs("posix", nil,        "ifaddrs.h",                        "getifaddrs")
     add_cfuncs("posix", nil,        "semaphore.h",                      "sem_init")
     add_cfuncs("posix", nil,        "unistd.h",                         "getpagesize", "sysconf")
+    add_cfuncs("posix", nil,        "sys/mman.h",                       "mmap", "mprotect")
     add_cfuncs("posix", nil,        "sched.h",                          "sched_yield")
     add_cfuncs("posix", nil,        "regex.h",                          "regcomp", "regexec")
     add_cfuncs("posix", nil,        "sys/uio.h",                        "readv", "writev", "preadv", "pwritev")
@@ -299,6 +307,7 @@ target("tbox")
     add_cfuncs("posix", nil,        "spawn.h",                          "posix_spawnp")
     add_cfuncs("posix", nil,        "unistd.h",                         "execvp", "execvpe", "fork", "vfork")
     add_cfuncs("posix", nil,        "sys/wait.h",                       "waitpid")
+    add_cfuncs("posix", nil,        "time.h",                           "clock_gettime")
 
     -- add the interfaces for systemv
     add_cfuncs("systemv", nil,      {"sys/sem.h", "sys/ipc.h"},         "semget", "semtimedop")
@@ -0,0 +1,55 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        scan_x86.h
+ *
+ */
+#ifndef TB_XML_IMPL_SCAN_X86_H
+#define TB_XML_IMPL_SCAN_X86_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include <emmintrin.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+
+// find the first charactor c0 or c1 with sse2, the scanned position will be saved if not found
+static __tb_inline__ tb_byte_t const* tb_xml_reader_find_simd(tb_byte_t const** pdata, tb_byte_t const* e, tb_byte_t c0, tb_byte_t c1)
+{
+    // done, compare 16 bytes at once
+    tb_byte_t const*    p = *pdata;
+    __m128i             v0 = _mm_set1_epi8((tb_char_t)c0);
+    __m128i             v1 = _mm_set1_epi8((tb_char_t)c1);
+    for (; p + 16 <= e; p += 16)
+    {
+        __m128i     d = _mm_loadu_si128((__m128i const*)p);
+        tb_uint32_t m = (tb_uint32_t)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(d, v0), _mm_cmpeq_epi8(d, v1)));
+        if (m) return p + tb_bits_fb1_u32_le(m);
+    }
+
+    // save the scanned position
+    *pdata = p;
+    return tb_null;
+}
+
+#endif
@@ -33,6 +33,11 @@
  */
 #include "reader.h"
 #include "../charset/charset.h"
+#if defined(TB_ARCH_SSE2)
+#   include "impl/scan_x86.h"
+#elif defined(TB_ARCH_ARM64) && defined(TB_ARCH_ARM_NEON)
+#   include "impl/scan_arm.h"
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -44,10 +49,26 @@
 #   define TB_XML_READER_ATTRIBUTES_MAXN        (128)
 #endif
 
+// enable the simd scanner?
+#if defined(TB_ARCH_SSE2) || (defined(TB_ARCH_ARM64) && defined(TB_ARCH_ARM_NEON))
+#   define TB_XML_READER_SIMD_ENABLE
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
+// the xml reader path type
+typedef struct __tb_xml_reader_path_t
+{
+    // the callback
+    tb_xml_reader_path_func_t   func;
+
+    // the user private data
+    tb_cpointer_t               priv;
+
+}tb_xml_reader_path_t;
+
 // the xml reader impl type
 typedef struct __tb_xml_reader_impl_t
 {
@@ -78,67 +99,327 @@ typedef struct __tb_xml_reader_impl_t
     // the element
     tb_string_t             element;
 
+    // the element data, it refers to the stream cache or the element string
+    tb_char_t const*        element_data;
+
+    // the element size
+    tb_size_t               element_size;
+
     // the element name
     tb_string_t             element_name;
 
     // the text
     tb_string_t             text;
 
-    // the attribute name
-    tb_string_t             attribute_name;
+    // the text data, it refers to the stream cache or the text string
+    tb_char_t const*        text_data;
 
-    // the attribute data
-    tb_string_t             attribute_data;
+    // the text size
+    tb_size_t               text_size;
 
     // the attributes
     tb_xml_attribute_t      attributes[TB_XML_READER_ATTRIBUTES_MAXN];
 
+    // the registered paths: path => tb_xml_reader_path_t
+    tb_hash_map_ref_t       paths;
+
+    // the path offsets index: path => the stream offset of the first node
+    tb_hash_map_ref_t       index;
+
+    // the index has been built?
+    tb_bool_t               indexed;
+
 }tb_xml_reader_impl_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * scanner implementation
+ */
+static __tb_inline__ tb_byte_t const* tb_xml_reader_find(tb_byte_t const* p, tb_byte_t const* e, tb_byte_t c0, tb_byte_t c1)
+{
+#ifdef TB_XML_READER_SIMD_ENABLE
+    // find it with simd
+    tb_byte_t const* q = tb_xml_reader_find_simd(&p, e, c0, c1);
+    if (q) return q;
+#endif
+
+    // find the left charactors
+    for (; p < e; p++) if (*p == c0 || *p == c1) return p;
+    return tb_null;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * parser implementation
  */
-static tb_char_t const* tb_xml_reader_element_parse(tb_xml_reader_impl_t* reader)
+static tb_bool_t tb_xml_reader_element_parse(tb_xml_reader_impl_t* reader)
 {
     // clear element
     tb_string_clear(&reader->element);
-
-    // parse element
-    tb_char_t ch = '\0';
-    tb_size_t in = 0;
-    while (tb_stream_bread_s8(reader->rstream, (tb_sint8_t*)&ch))
+    reader->element_data = tb_null;
+    reader->element_size = 0;
+
+    // parse element: <...>
+    tb_bool_t   in = tb_false;
+    tb_size_t   size = 0;
+    tb_byte_t*  data = tb_null;
+    while ((size = tb_stream_peek(reader->rstream, &data)))
     {
-        // append element
-        if (!in && ch == '<') in = 1;
-        else if (in)
+        // skip '<'
+        tb_byte_t const* p = data;
+        tb_byte_t const* e = data + size;
+        if (!in)
+        {
+            p = tb_xml_reader_find(p, e, '<', '<');
+            if (!p)
+            {
+                if (!tb_stream_skip(reader->rstream, size)) break;
+                continue;
+            }
+            in = tb_true;
+            p++;
+        }
+
+        // find '>'
+        tb_byte_t const* q = tb_xml_reader_find(p, e, '>', '>');
+        if (q)
         {
-            if (ch != '>') tb_string_chrcat(&reader->element, ch);
-            else return tb_string_cstr(&reader->element);
+            // refer to the stream cache directly if the whole element is cached
+            if (!tb_string_size(&reader->element))
+            {
+                reader->element_data = (tb_char_t const*)p;
+                reader->element_size = q - p;
+            }
+            // append the element tail if the cache has been refilled
+            else
+            {
+                tb_string_viewcat(&reader->element, tb_string_view_init((tb_char_t const*)p, q - p));
+                reader->element_data = tb_string_cstr(&reader->element);
+                reader->element_size = tb_string_size(&reader->element);
+            }
+
+            // skip it
+            return tb_stream_skip(reader->rstream, q + 1 - data);
         }
+
+        // save the partial element and refill the cache
+        if (p < e) tb_string_viewcat(&reader->element, tb_string_view_init((tb_char_t const*)p, e - p));
+        if (!tb_stream_skip(reader->rstream, size)) break;
     }
 
     // failed
     tb_assertf(0, "invalid element: %s from %s", tb_string_cstr(&reader->element), tb_url_cstr(tb_stream_url(reader->istream)));
-    return tb_null;
+    return tb_false;
+}
+static tb_bool_t tb_xml_reader_element_seek(tb_xml_reader_impl_t* reader, tb_char_t c)
+{
+    // the element must be saved to the string
+    tb_assert(reader->element_data == tb_string_cstr(&reader->element));
+
+    // seek to the element end, .e.g --> or ]]>
+    tb_size_t   size = 0;
+    tb_byte_t*  data = tb_null;
+    while ((size = tb_stream_peek(reader->rstream, &data)))
+    {
+        // find '>'
+        tb_byte_t const* p = data;
+        tb_byte_t const* e = data + size;
+        tb_byte_t const* q = tb_null;
+        while ((q = tb_xml_reader_find(p, e, '>', '>')))
+        {
+            // append it
+            tb_string_viewcat(&reader->element, tb_string_view_init((tb_char_t const*)p, q - p));
+            p = q + 1;
+
+            // end?
+            tb_char_t const*    b = tb_string_cstr(&reader->element);
+            tb_size_t           n = tb_string_size(&reader->element);
+            if (n >= 2 && b[n - 1] == c && b[n - 2] == c)
+            {
+                reader->element_data = b;
+                reader->element_size = n;
+                return tb_stream_skip(reader->rstream, p - data);
+            }
+
+            // patch '>'
+            tb_string_chrcat(&reader->element, '>');
+        }
+
+        // save the left data and refill the cache
+        if (p < e) tb_string_viewcat(&reader->element, tb_string_view_init((tb_char_t const*)p, e - p));
+        if (!tb_stream_skip(reader->rstream, size)) break;
+    }
+
+    // update element
+    reader->element_data = tb_string_cstr(&reader->element);
+    reader->element_size = tb_string_size(&reader->element);
+    return tb_false;
 }
-static tb_char_t const* tb_xml_reader_text_parse(tb_xml_reader_impl_t* reader)
+static tb_char_t const* tb_xml_reader_element_cstr(tb_xml_reader_impl_t* reader)
+{
+    // copy the element from the stream cache
+    if (reader->element_data != tb_string_cstr(&reader->element))
+    {
+        tb_string_viewcpy(&reader->element, tb_string_view_init(reader->element_data, reader->element_size));
+        reader->element_data = tb_string_cstr(&reader->element);
+    }
+    return reader->element_data;
+}
+static tb_bool_t tb_xml_reader_text_parse(tb_xml_reader_impl_t* reader)
 {
     // clear text
     tb_string_clear(&reader->text);
+    reader->text_data = tb_null;
+    reader->text_size = 0;
 
-    // parse text
-    tb_char_t* pc = tb_null;
-    while (tb_stream_need(reader->rstream, (tb_byte_t**)&pc, 1) && pc)
+    // parse text until '<'
+    tb_size_t   size = 0;
+    tb_byte_t*  data = tb_null;
+    while ((size = tb_stream_peek(reader->rstream, &data)))
     {
-        // is end? </ ..>
-        if (pc[0] == '<') return tb_string_cstr(&reader->text);
-        else
+        // find '<'
+        tb_byte_t const* q = tb_xml_reader_find(data, data + size, '<', '<');
+        if (q)
         {
-            tb_string_chrcat(&reader->text, *pc);
-            if (!tb_stream_skip(reader->rstream, 1)) return tb_null;
+            // refer to the stream cache directly if the whole text is cached
+            if (!tb_string_size(&reader->text))
+            {
+                reader->text_data = (tb_char_t const*)data;
+                reader->text_size = q - data;
+            }
+            // append the text tail if the cache has been refilled
+            else
+            {
+                tb_string_viewcat(&reader->text, tb_string_view_init((tb_char_t const*)data, q - data));
+                reader->text_data = tb_string_cstr(&reader->text);
+                reader->text_size = tb_string_size(&reader->text);
+            }
+
+            // skip it
+            return tb_stream_skip(reader->rstream, q - data);
         }
+
+        // save the partial text and refill the cache
+        tb_string_viewcat(&reader->text, tb_string_view_init((tb_char_t const*)data, size));
+        if (!tb_stream_skip(reader->rstream, size)) break;
     }
-    return tb_null;
+    return tb_false;
+}
+static tb_size_t tb_xml_reader_attributes_parse(tb_xml_reader_impl_t* reader, tb_xml_attribute_view_t* attrs, tb_size_t maxn)
+{
+    // init
+    tb_char_t const* p = reader->element_data;
+    tb_char_t const* e = p + reader->element_size;
+    tb_check_return_val(p, 0);
+
+    // skip name
+    while (p < e && *p && !tb_isspace(*p)) p++;
+    while (p < e && *p && tb_isspace(*p)) p++;
+
+    // parse attributes: name = "data" or name = 'data'
+    tb_size_t n = 0;
+    while (p < e && n < maxn)
+    {
+        // parse name
+        tb_char_t const* q = (tb_char_t const*)tb_xml_reader_find((tb_byte_t const*)p, (tb_byte_t const*)e, '=', '=');
+        tb_check_break(q);
+
+        // trim name
+        tb_char_t const* b = p;
+        tb_char_t const* d = q;
+        while (b < d && tb_isspace(*b)) b++;
+        while (d > b && tb_isspace(d[-1])) d--;
+
+        // parse data
+        p = (tb_char_t const*)tb_xml_reader_find((tb_byte_t const*)q + 1, (tb_byte_t const*)e, '\'', '\"');
+        tb_check_break(p);
+        q = (tb_char_t const*)tb_xml_reader_find((tb_byte_t const*)p + 1, (tb_byte_t const*)e, *p, *p);
+        tb_check_break(q);
+
+        // save attribute
+        if (d > b)
+        {
+            attrs[n].name = tb_string_view_init(b, d - b);
+            attrs[n].data = tb_string_view_init(p + 1, q - p - 1);
+            n++;
+        }
+
+        // next
+        p = q + 1;
+    }
+
+    // ok
+    return n;
+}
+
+static tb_void_t tb_xml_reader_path_enter(tb_xml_reader_impl_t* reader, tb_string_ref_t path)
+{
+    // append "/name"
+    tb_string_chrcat(path, '/');
+    tb_string_viewcat(path, tb_xml_reader_element_view((tb_xml_reader_ref_t)reader));
+}
+static tb_void_t tb_xml_reader_path_leave(tb_string_ref_t path)
+{
+    // remove "/name"
+    tb_long_t p = tb_string_strrchr(path, 0, '/');
+    if (p >= 0) tb_string_strip(path, p);
+}
+static tb_bool_t tb_xml_reader_path_match(tb_string_ref_t path, tb_char_t const* name)
+{
+    // the empty path is the document root
+    return tb_string_size(path)? !tb_string_cstricmp(path, name) : !*name;
+}
+static tb_bool_t tb_xml_reader_index_build(tb_xml_reader_impl_t* reader)
+{
+    // seek to the stream head
+    if (!tb_stream_seek(reader->rstream, 0)) return tb_false;
+
+    // clear index
+    tb_hash_map_clear(reader->index);
+
+    // init path
+    tb_string_t path;
+    if (!tb_string_init(&path)) return tb_false;
+
+    // save the offset of the first node for all paths
+    tb_size_t event = TB_XML_READER_EVENT_NONE;
+    tb_hize_t offset = tb_stream_offset(reader->rstream);
+    while ((event = tb_xml_reader_next((tb_xml_reader_ref_t)reader)))
+    {
+        switch (event)
+        {
+        case TB_XML_READER_EVENT_ELEMENT_EMPTY: 
+        case TB_XML_READER_EVENT_ELEMENT_BEG: 
+            {
+                // enter
+                tb_xml_reader_path_enter(reader, &path);
+
+                // save the first offset
+                if (!tb_hash_map_find(reader->index, tb_string_cstr(&path)))
+                    tb_hash_map_insert(reader->index, tb_string_cstr(&path), &offset);
+
+                // leave the empty element
+                if (event == TB_XML_READER_EVENT_ELEMENT_EMPTY) tb_xml_reader_path_leave(&path);
+            }
+            break;
+        case TB_XML_READER_EVENT_ELEMENT_END: 
+            tb_xml_reader_path_leave(&path);
+            break;
+        default:
+            break;
+        }
+
+        // save offset
+        offset = tb_stream_offset(reader->rstream);
+    }
+
+    // exit path
+    tb_string_exit(&path);
+
+    // trace
+    tb_trace_d("index: %lu paths", tb_hash_map_size(reader->index));
+
+    // ok
+    reader->indexed = tb_true;
+    return tb_true;
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -156,8 +437,6 @@ tb_xml_reader_ref_t tb_xml_reader_init()
     tb_string_init(&reader->charset);
     tb_string_init(&reader->element);
     tb_string_init(&reader->element_name);
-    tb_string_init(&reader->attribute_name);
-    tb_string_init(&reader->attribute_data);
     tb_string_cstrcpy(&reader->version, "2.0");
     tb_string_cstrcpy(&reader->charset, "utf-8");
 
@@ -185,6 +464,14 @@ tb_void_t tb_xml_reader_exit(tb_xml_reader_ref_t reader)
     // exit the filter stream
     if (impl->fstream) tb_stream_exit(impl->fstream);
 
+    // exit paths
+    if (impl->paths) tb_hash_map_exit(impl->paths);
+    impl->paths = tb_null;
+
+    // exit index
+    if (impl->index) tb_hash_map_exit(impl->index);
+    impl->index = tb_null;
+
     // exit text
     tb_string_exit(&impl->text);
 
@@ -200,12 +487,6 @@ tb_void_t tb_xml_reader_exit(tb_xml_reader_ref_t reader)
     // exit element name
     tb_string_exit(&impl->element_name);
 
-    // exit attribute name
-    tb_string_exit(&impl->attribute_name);
-
-    // exit attribute data
-    tb_string_exit(&impl->attribute_data);
-
     // exit attributes
     tb_long_t i = 0;
     for (i = 0; i < TB_XML_READER_ATTRIBUTES_MAXN; i++)
@@ -255,11 +536,11 @@ tb_bool_t tb_xml_reader_open(tb_xml_reader_ref_t reader, tb_stream_ref_t stream,
         // clear name
         tb_string_clear(&impl->element_name);
 
-        // clear attribute name
-        tb_string_clear(&impl->attribute_name);
-
-        // clear attribute data
-        tb_string_clear(&impl->attribute_data);
+        // clear the element and text data
+        impl->element_data = tb_null;
+        impl->element_size = 0;
+        impl->text_data = tb_null;
+        impl->text_size = 0;
 
         // clear attributes
         tb_long_t i = 0;
@@ -301,6 +582,10 @@ tb_void_t tb_xml_reader_clos(tb_xml_reader_ref_t reader)
     // clear owner
     impl->bowner = tb_false;
 
+    // clear index
+    if (impl->index) tb_hash_map_clear(impl->index);
+    impl->indexed = tb_false;
+
     // clear text
     tb_string_clear(&impl->text);
 
@@ -310,11 +595,11 @@ tb_void_t tb_xml_reader_clos(tb_xml_reader_ref_t reader)
     // clear name
     tb_string_clear(&impl->element_name);
 
-    // clear attribute name
-    tb_string_clear(&impl->attribute_name);
-
-    // clear attribute data
-    tb_string_clear(&impl->attribute_data);
+    // clear the element and text data
+    impl->element_data = tb_null;
+    impl->element_size = 0;
+    impl->text_data = tb_null;
+    impl->text_size = 0;
 
     // clear attributes
     tb_long_t i = 0;
@@ -355,17 +640,17 @@ tb_size_t tb_xml_reader_next(tb_xml_reader_ref_t reader)
     {
         // peek character
         tb_char_t* pc = tb_null;
-        if (!tb_stream_need(impl->rstream, (tb_byte_t**)&pc, 1) || !pc) break;
+        if (!tb_stream_peek(impl->rstream, (tb_byte_t**)&pc) || !pc) break;
 
         // is element?
         if (*pc == '<') 
         {
             // parse element: <...>
-            tb_char_t const* element = tb_xml_reader_element_parse(impl);
-            tb_assert_and_check_break(element);
+            if (!tb_xml_reader_element_parse(impl)) break;
 
             // is document begin: <?xml version="..." charset=".." ?>
-            tb_size_t size = tb_string_size(&impl->element);
+            tb_char_t const*    element = impl->element_data;
+            tb_size_t           size = impl->element_size;
             if (size > 4 && !tb_strnicmp(element, "?xml", 4))
             {
                 // update event
@@ -441,60 +726,28 @@ tb_size_t tb_xml_reader_next(tb_xml_reader_ref_t reader)
             else if (size >= 3 && !tb_strncmp(element, "!--", 3))
             {
                 // no comment end?
-                if (element[size - 2] != '-' || element[size - 1] != '-')
+                if (size < 5 || element[size - 2] != '-' || element[size - 1] != '-')
                 {
                     // patch '>'
+                    tb_xml_reader_element_cstr(impl);
                     tb_string_chrcat(&impl->element, '>');
 
                     // seek to comment end
-                    tb_char_t ch = '\0';
-                    tb_int_t n = 0;
-                    while (tb_stream_bread_s8(impl->rstream, (tb_sint8_t*)&ch))
-                    {
-                        // -->
-                        if (n == 2 && ch == '>') break;
-                        else
-                        {
-                            // append it
-                            tb_string_chrcat(&impl->element, ch);
-
-                            if (ch == '-') n++;
-                            else n = 0;
-                        }
-                    }
-
-                    // update event
-                    if (ch != '\0') impl->event = TB_XML_READER_EVENT_COMMENT;
+                    if (tb_xml_reader_element_seek(impl, '-')) impl->event = TB_XML_READER_EVENT_COMMENT;
                 }
                 else impl->event = TB_XML_READER_EVENT_COMMENT;
             }
             // is cdata: <![CDATA[ text ]]>
             else if (size >= 8 && !tb_strnicmp(element, "![CDATA[", 8))
             {
-                if (element[size - 2] != ']' || element[size - 1] != ']')
+                if (size < 10 || element[size - 2] != ']' || element[size - 1] != ']')
                 {
                     // patch '>'
+                    tb_xml_reader_element_cstr(impl);
                     tb_string_chrcat(&impl->element, '>');
 
                     // seek to cdata end
-                    tb_char_t ch = '\0';
-                    tb_int_t n = 0;
-                    while (tb_stream_bread_s8(impl->rstream, (tb_sint8_t*)&ch))
-                    {
-                        // ]]>
-                        if (n == 2 && ch == '>') break;
-                        else
-                        {
-                            // append it
-                            tb_string_chrcat(&impl->element, ch);
-
-                            if (ch == ']') n++;
-                            else n = 0;
-                        }
-                    }
-
-                    // update event
-                    if (ch != '\0') impl->event = TB_XML_READER_EVENT_CDATA;
+                    if (tb_xml_reader_element_seek(impl, ']')) impl->event = TB_XML_READER_EVENT_CDATA;
                 }
                 else impl->event = TB_XML_READER_EVENT_CDATA;
             }
@@ -520,13 +773,14 @@ tb_size_t tb_xml_reader_next(tb_xml_reader_ref_t reader)
         // is text: <> text </>
         else if (*pc)
         {
-            // parse text: <> ... <>
-            tb_char_t const* text = tb_xml_reader_text_parse(impl);
-            if (text && tb_string_cstrcmp(&impl->text, "\r\n") && tb_string_cstrcmp(&impl->text, "\n"))
-                impl->event = TB_XML_READER_EVENT_TEXT;
-
-            // trace
-//          tb_trace_d("%s", text);
+            // parse text: <> ... <>, skip the empty line
+            if (tb_xml_reader_text_parse(impl))
+            {
+                tb_char_t const*    text = impl->text_data;
+                tb_size_t           size = impl->text_size;
+                if (!(size == 1 && text[0] == '\n') && !(size == 2 && text[0] == '\r' && text[1] == '\n'))
+                    impl->event = TB_XML_READER_EVENT_TEXT;
+            }
         }
         else 
         {
@@ -550,13 +804,30 @@ tb_bool_t tb_xml_reader_goto(tb_xml_reader_ref_t reader, tb_char_t const* path)
     // init level
     impl->level = 0;
 
+    // goto it from the index
+    if (impl->index)
+    {
+        // build index first
+        if (!impl->indexed && !tb_xml_reader_index_build(impl)) return tb_false;
+
+        // clear level
+        impl->level = 0;
+
+        // seek to the node directly
+        tb_hize_t const* offset = (tb_hize_t const*)tb_hash_map_get(impl->index, path);
+        if (offset && tb_stream_seek(impl->rstream, *offset)) return tb_true;
+
+        // failed? restore to the stream head
+        tb_stream_seek(impl->rstream, 0);
+        return tb_false;
+    }
+
     // seek to the stream head
     if (!tb_stream_seek(impl->rstream, 0)) return tb_false;
 
-    // init
-    tb_static_string_t  s;
-    tb_char_t           data[8192];
-    if (!tb_static_string_init(&s, data, 8192)) return tb_false;
+    // init path
+    tb_string_t s;
+    if (!tb_string_init(&s)) return tb_false;
 
     // save the current offset
     tb_hize_t save = tb_stream_offset(impl->rstream);
@@ -571,23 +842,17 @@ tb_bool_t tb_xml_reader_goto(tb_xml_reader_ref_t reader, tb_char_t const* path)
         {
         case TB_XML_READER_EVENT_ELEMENT_EMPTY: 
             {
-                // name
-                tb_char_t const* name = tb_xml_reader_element(reader);
-                tb_assert_and_check_break_state(name, leave, tb_true);
-
-                // append 
-                tb_size_t n = tb_static_string_size(&s);
-                tb_static_string_chrcat(&s, '/');
-                tb_static_string_cstrcat(&s, name);
+                // enter
+                tb_xml_reader_path_enter(impl, &s);
 
                 // ok?
-                if (!tb_static_string_cstricmp(&s, path)) ok = tb_true;
+                if (tb_xml_reader_path_match(&s, path)) ok = tb_true;
                 
                 // trace
-                tb_trace_d("path: %s", tb_static_string_cstr(&s));
+                tb_trace_d("path: %s", tb_string_cstr(&s));
 
-                // remove 
-                tb_static_string_strip(&s, n);
+                // leave
+                tb_xml_reader_path_leave(&s);
 
                 // restore
                 if (ok) if (!(ok = tb_stream_seek(impl->rstream, save))) leave = tb_true;
@@ -595,19 +860,14 @@ tb_bool_t tb_xml_reader_goto(tb_xml_reader_ref_t reader, tb_char_t const* path)
             break;
         case TB_XML_READER_EVENT_ELEMENT_BEG: 
             {
-                // name
-                tb_char_t const* name = tb_xml_reader_element(reader);
-                tb_assert_and_check_break_state(name, leave, tb_true);
-
-                // append 
-                tb_static_string_chrcat(&s, '/');
-                tb_static_string_cstrcat(&s, name);
+                // enter
+                tb_xml_reader_path_enter(impl, &s);
 
                 // ok?
-                if (!tb_static_string_cstricmp(&s, path)) ok = tb_true;
+                if (tb_xml_reader_path_match(&s, path)) ok = tb_true;
 
                 // trace
-                tb_trace_d("path: %s", tb_static_string_cstr(&s));
+                tb_trace_d("path: %s", tb_string_cstr(&s));
 
                 // restore
                 if (ok) if (!(ok = tb_stream_seek(impl->rstream, save))) leave = tb_true;
@@ -615,15 +875,14 @@ tb_bool_t tb_xml_reader_goto(tb_xml_reader_ref_t reader, tb_char_t const* path)
             break;
         case TB_XML_READER_EVENT_ELEMENT_END: 
             {
-                // remove 
-                tb_long_t p = tb_static_string_strrchr(&s, 0, '/');
-                if (p >= 0) tb_static_string_strip(&s, p);
+                // leave
+                tb_xml_reader_path_leave(&s);
 
                 // ok?
-                if (!tb_static_string_cstricmp(&s, path)) ok = tb_true;
+                if (tb_xml_reader_path_match(&s, path)) ok = tb_true;
 
                 // trace
-                tb_trace_d("path: %s", tb_static_string_cstr(&s));
+                tb_trace_d("path: %s", tb_string_cstr(&s));
 
                 // restore
                 if (ok) if (!(ok = tb_stream_seek(impl->rstream, save))) leave = tb_true;
@@ -637,8 +896,8 @@ tb_bool_t tb_xml_reader_goto(tb_xml_reader_ref_t reader, tb_char_t const* path)
         save = tb_stream_offset(impl->rstream);
     }
 
-    // exit string
-    tb_static_string_exit(&s);
+    // exit path
+    tb_string_exit(&s);
 
     // clear level
     impl->level = 0;
@@ -649,6 +908,102 @@ tb_bool_t tb_xml_reader_goto(tb_xml_reader_ref_t reader, tb_char_t const* path)
     // ok?
     return ok;
 }
+tb_bool_t tb_xml_reader_index(tb_xml_reader_ref_t reader, tb_bool_t enable)
+{
+    // check
+    tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl, tb_false);
+
+    // disable it
+    if (!enable)
+    {
+        if (impl->index) tb_hash_map_exit(impl->index);
+        impl->index = tb_null;
+        impl->indexed = tb_false;
+        return tb_true;
+    }
+
+    // init index, it will be built by the first tb_xml_reader_goto()
+    if (!impl->index) impl->index = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_SMALL, tb_element_str(tb_false), tb_element_mem(sizeof(tb_hize_t), tb_null, tb_null));
+    return impl->index? tb_true : tb_false;
+}
+tb_bool_t tb_xml_reader_path_add(tb_xml_reader_ref_t reader, tb_char_t const* path, tb_xml_reader_path_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && path && func, tb_false);
+
+    // init paths
+    if (!impl->paths) impl->paths = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, tb_element_str(tb_false), tb_element_mem(sizeof(tb_xml_reader_path_t), tb_null, tb_null));
+    tb_assert_and_check_return_val(impl->paths, tb_false);
+
+    // add path
+    tb_xml_reader_path_t item;
+    item.func = func;
+    item.priv = priv;
+    return tb_hash_map_insert(impl->paths, path, &item)? tb_true : tb_false;
+}
+tb_void_t tb_xml_reader_path_clear(tb_xml_reader_ref_t reader)
+{
+    // check
+    tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
+    tb_assert_and_check_return(impl);
+
+    // clear paths
+    if (impl->paths) tb_hash_map_clear(impl->paths);
+}
+tb_bool_t tb_xml_reader_path_done(tb_xml_reader_ref_t reader)
+{
+    // check
+    tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && impl->rstream && impl->paths, tb_false);
+
+    // init level
+    impl->level = 0;
+
+    // seek to the stream head
+    if (!tb_stream_seek(impl->rstream, 0)) return tb_false;
+
+    // init path
+    tb_string_t s;
+    if (!tb_string_init(&s)) return tb_false;
+
+    // done
+    tb_bool_t               stop = tb_false;
+    tb_size_t               event = TB_XML_READER_EVENT_NONE;
+    tb_xml_reader_path_t*   item = tb_null;
+    while (!stop && (event = tb_xml_reader_next(reader)))
+    {
+        // update path
+        switch (event)
+        {
+        case TB_XML_READER_EVENT_ELEMENT_EMPTY: 
+        case TB_XML_READER_EVENT_ELEMENT_BEG: 
+            tb_xml_reader_path_enter(impl, &s);
+            break;
+        case TB_XML_READER_EVENT_ELEMENT_END: 
+        case TB_XML_READER_EVENT_TEXT: 
+        case TB_XML_READER_EVENT_CDATA: 
+            break;
+        default:
+            continue;
+        }
+
+        // the current path has been registered? call it
+        item = tb_string_size(&s)? (tb_xml_reader_path_t*)tb_hash_map_get(impl->paths, tb_string_cstr(&s)) : tb_null;
+        if (item && !item->func(reader, tb_string_cstr(&s), event, item->priv)) stop = tb_true;
+
+        // leave
+        if (event == TB_XML_READER_EVENT_ELEMENT_EMPTY || event == TB_XML_READER_EVENT_ELEMENT_END)
+            tb_xml_reader_path_leave(&s);
+    }
+
+    // exit path
+    tb_string_exit(&s);
+
+    // ok
+    return tb_true;
+}
 tb_xml_node_ref_t tb_xml_reader_load(tb_xml_reader_ref_t reader)
 {
     // check
@@ -801,13 +1156,13 @@ tb_char_t const* tb_xml_reader_comment(tb_xml_reader_ref_t reader)
     tb_assert_and_check_return_val(impl && impl->event == TB_XML_READER_EVENT_COMMENT, tb_null);
 
     // init
-    tb_char_t const*    p = tb_string_cstr(&impl->element);
-    tb_size_t           n = tb_string_size(&impl->element);
-    tb_assert_and_check_return_val(p && n >= 6, tb_null);
+    tb_char_t const*    p = impl->element_data;
+    tb_size_t           n = impl->element_size;
+    tb_assert_and_check_return_val(p && n >= 5, tb_null);
 
-    // comment
-    tb_string_cstrncpy(&impl->text, p + 3, n - 5);
-    return tb_string_cstr(&impl->text);
+    // comment, the empty comment: <!---->
+    tb_char_t const* comment = tb_string_viewcpy(&impl->text, tb_string_view_init(p + 3, n - 5));
+    return comment? comment : "";
 }
 tb_char_t const* tb_xml_reader_cdata(tb_xml_reader_ref_t reader)
 {
@@ -816,13 +1171,13 @@ tb_char_t const* tb_xml_reader_cdata(tb_xml_reader_ref_t reader)
     tb_assert_and_check_return_val(impl && impl->event == TB_XML_READER_EVENT_CDATA, tb_null);
 
     // init
-    tb_char_t const*    p = tb_string_cstr(&impl->element);
-    tb_size_t           n = tb_string_size(&impl->element);
-    tb_assert_and_check_return_val(p && n >= 11, tb_null);
+    tb_char_t const*    p = impl->element_data;
+    tb_size_t           n = impl->element_size;
+    tb_assert_and_check_return_val(p && n >= 10, tb_null);
 
-    // comment
-    tb_string_cstrncpy(&impl->text, p + 8, n - 10);
-    return tb_string_cstr(&impl->text);
+    // cdata, the empty cdata: <![CDATA[]]>
+    tb_char_t const* cdata = tb_string_viewcpy(&impl->text, tb_string_view_init(p + 8, n - 10));
+    return cdata? cdata : "";
 }
 tb_char_t const* tb_xml_reader_text(tb_xml_reader_ref_t reader)
 {
@@ -830,29 +1185,55 @@ tb_char_t const* tb_xml_reader_text(tb_xml_reader_ref_t reader)
     tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
     tb_assert_and_check_return_val(impl && impl->event == TB_XML_READER_EVENT_TEXT, tb_null);
 
+    // copy the text from the stream cache
+    if (impl->text_data != tb_string_cstr(&impl->text))
+    {
+        tb_string_viewcpy(&impl->text, tb_string_view_init(impl->text_data, impl->text_size));
+        impl->text_data = tb_string_cstr(&impl->text);
+    }
+
     // text
-    return tb_string_cstr(&impl->text);
+    return impl->text_data;
+}
+tb_string_view_t tb_xml_reader_text_view(tb_xml_reader_ref_t reader)
+{
+    // check
+    tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && impl->event == TB_XML_READER_EVENT_TEXT, tb_string_view_init(tb_null, 0));
+
+    // text
+    return tb_string_view_init(impl->text_data, impl->text_size);
 }
 tb_char_t const* tb_xml_reader_element(tb_xml_reader_ref_t reader)
+{
+    // the element name
+    tb_string_view_t name = tb_xml_reader_element_view(reader);
+    tb_check_return_val(name.size, tb_null);
+
+    // copy it
+    tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
+    return tb_string_viewcpy(&impl->element_name, name);
+}
+tb_string_view_t tb_xml_reader_element_view(tb_xml_reader_ref_t reader)
 {
     // check
     tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
     tb_assert_and_check_return_val(impl && ( impl->event == TB_XML_READER_EVENT_ELEMENT_BEG
                                             ||  impl->event == TB_XML_READER_EVENT_ELEMENT_END
-                                            ||  impl->event == TB_XML_READER_EVENT_ELEMENT_EMPTY), tb_null);
+                                            ||  impl->event == TB_XML_READER_EVENT_ELEMENT_EMPTY), tb_string_view_init(tb_null, 0));
 
     // init
     tb_char_t const* p = tb_null;
-    tb_char_t const* b = tb_string_cstr(&impl->element);
-    tb_char_t const* e = b + tb_string_size(&impl->element);
-    tb_assert_and_check_return_val(b, tb_null);
+    tb_char_t const* b = impl->element_data;
+    tb_char_t const* e = b + impl->element_size;
+    tb_assert_and_check_return_val(b, tb_string_view_init(tb_null, 0));
 
     // </name> or <name ... />
     if (b < e && *b == '/') b++;
     for (p = b; p < e && *p && !tb_isspace(*p) && *p != '/'; p++) ;
 
     // ok?
-    return p > b? tb_string_cstrncpy(&impl->element_name, b, p - b) : tb_null;
+    return tb_string_view_init(b, p - b);
 }
 tb_char_t const* tb_xml_reader_doctype(tb_xml_reader_ref_t reader)
 {
@@ -861,7 +1242,7 @@ tb_char_t const* tb_xml_reader_doctype(tb_xml_reader_ref_t reader)
     tb_assert_and_check_return_val(impl && impl->event == TB_XML_READER_EVENT_DOCUMENT_TYPE, tb_null);
 
     // doctype
-    tb_char_t const* p = tb_string_cstr(&impl->element);
+    tb_char_t const* p = tb_xml_reader_element_cstr(impl);
     tb_assert_and_check_return_val(p, tb_null);
 
     // skip !DOCTYPE
@@ -869,58 +1250,44 @@ tb_char_t const* tb_xml_reader_doctype(tb_xml_reader_ref_t reader)
 }
 tb_xml_node_ref_t tb_xml_reader_attributes(tb_xml_reader_ref_t reader)
 {
-    // check
-    tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
-    tb_assert_and_check_return_val(impl && ( impl->event == TB_XML_READER_EVENT_DOCUMENT
-                                            ||  impl->event == TB_XML_READER_EVENT_ELEMENT_BEG
-                                            ||  impl->event == TB_XML_READER_EVENT_ELEMENT_END
-                                            ||  impl->event == TB_XML_READER_EVENT_ELEMENT_EMPTY), tb_null);
-
-    // init
-    tb_char_t const* p = tb_string_cstr(&impl->element);
-    tb_char_t const* e = p + tb_string_size(&impl->element);
-
-    // skip name
-    while (p < e && *p && !tb_isspace(*p)) p++;
-    while (p < e && *p && tb_isspace(*p)) p++;
-
     // parse attributes
-    tb_size_t n = 0;
-    while (p < e)
+    tb_xml_attribute_view_t attrs[TB_XML_READER_ATTRIBUTES_MAXN];
+    tb_size_t               n = tb_xml_reader_attributes_view(reader, attrs, tb_arrayn(attrs));
+    tb_check_return_val(n, tb_null);
+
+    // save attributes
+    tb_size_t               i = 0;
+    tb_size_t               m = 0;
+    tb_xml_node_ref_t       prev = tb_null;
+    tb_xml_reader_impl_t*   impl = (tb_xml_reader_impl_t*)reader;
+    for (i = 0; i < n; i++)
     {
-        // parse name
-        tb_string_clear(&impl->attribute_name);
-        for (; p < e && *p != '='; p++) if (!tb_isspace(*p)) tb_string_chrcat(&impl->attribute_name, *p);
-        if (*p != '=') break;
+        // skip the empty attribute, the attribute node always has name and data
+        tb_check_continue(attrs[i].name.size && attrs[i].data.size);
 
-        // parse data
-        tb_string_clear(&impl->attribute_data);
-        for (p++; p < e && (*p != '\'' && *p != '\"'); p++) ;
-        if (*p != '\'' && *p != '\"') break;
-        for (p++; p < e && (*p != '\'' && *p != '\"'); p++) tb_string_chrcat(&impl->attribute_data, *p);
-        if (*p != '\'' && *p != '\"') break;
-        p++;
+        // init node
+        tb_xml_node_ref_t node = (tb_xml_node_ref_t)&impl->attributes[m++];
+        tb_string_viewcpy(&node->name, attrs[i].name);
+        tb_string_viewcpy(&node->data, attrs[i].data);
+        node->next = tb_null;
 
         // append node
-        if (tb_string_cstr(&impl->attribute_name) && tb_string_cstr(&impl->attribute_data))
-        {
-            // node
-            tb_xml_node_ref_t prev = n > 0? (tb_xml_node_ref_t)&impl->attributes[n - 1] : tb_null;
-            tb_xml_node_ref_t node = (tb_xml_node_ref_t)&impl->attributes[n];
-
-            // init node
-            tb_string_strcpy(&node->name, &impl->attribute_name);
-            tb_string_strcpy(&node->data, &impl->attribute_data);
-
-            // append node
-            if (prev) prev->next = node;
-            node->next = tb_null;
-
-            // next
-            n++;
-        }
+        if (prev) prev->next = node;
+        prev = node;
     }
 
     // ok?
-    return n? (tb_xml_node_ref_t)&impl->attributes[0] : tb_null;
+    return m? (tb_xml_node_ref_t)&impl->attributes[0] : tb_null;
+}
+tb_size_t tb_xml_reader_attributes_view(tb_xml_reader_ref_t reader, tb_xml_attribute_view_t* attrs, tb_size_t maxn)
+{
+    // check
+    tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && attrs && maxn && ( impl->event == TB_XML_READER_EVENT_DOCUMENT
+                                            ||  impl->event == TB_XML_READER_EVENT_ELEMENT_BEG
+                                            ||  impl->event == TB_XML_READER_EVENT_ELEMENT_END
+                                            ||  impl->event == TB_XML_READER_EVENT_ELEMENT_EMPTY), 0);
+
+    // parse attributes
+    return tb_xml_reader_attributes_parse(impl, attrs, maxn);
 }
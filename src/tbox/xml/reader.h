@@ -54,9 +54,31 @@ typedef enum __tb_xml_reader_event_t
 
 }tb_xml_reader_event_t;
 
+/// the xml attribute view type, the slices are only valid until the next tb_xml_reader_next()
+typedef struct __tb_xml_attribute_view_t
+{
+    /// the attribute name
+    tb_string_view_t    name;
+
+    /// the attribute data
+    tb_string_view_t    data;
+
+}tb_xml_attribute_view_t;
+
 /// the xml reader ref type
 typedef struct{}*       tb_xml_reader_ref_t;
 
+/*! the xml reader path func type
+ *
+ * @param reader        the xml reader
+ * @param path          the matched path, .e.g /root/node/item
+ * @param event         the event of the matched node: element_beg, element_empty, element_end, text or cdata
+ * @param priv          the user private data
+ *
+ * @return              tb_true: continue, tb_false: stop it
+ */
+typedef tb_bool_t       (*tb_xml_reader_path_func_t)(tb_xml_reader_ref_t reader, tb_char_t const* path, tb_size_t event, tb_cpointer_t priv);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -225,6 +247,59 @@ tb_size_t               tb_xml_reader_level(tb_xml_reader_ref_t reader);
  */
 tb_bool_t               tb_xml_reader_goto(tb_xml_reader_ref_t reader, tb_char_t const* path);
 
+/*! enable or disable the path offset index for tb_xml_reader_goto()
+ *
+ * the first goto scans the whole document once and saves the offset of the first node for all paths,
+ * and the later gotos will seek to the node directly. the index will be cleared if the reader is closed.
+ *
+ * @param reader        the reader handle
+ * @param enable        enable the index?
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_xml_reader_index(tb_xml_reader_ref_t reader, tb_bool_t enable);
+
+/*! register a path for tb_xml_reader_path_done()
+ *
+ * @param reader        the reader handle
+ * @param path          the xml path, .e.g /root/node/item, will replace the func of the same path
+ * @param func          the path func
+ * @param priv          the user private data
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_xml_reader_path_add(tb_xml_reader_ref_t reader, tb_char_t const* path, tb_xml_reader_path_func_t func, tb_cpointer_t priv);
+
+/*! clear all registered paths
+ *
+ * @param reader        the reader handle
+ */
+tb_void_t               tb_xml_reader_path_clear(tb_xml_reader_ref_t reader);
+
+/*! extract all registered paths in one pass
+ *
+ * the path func will be called for the element events of the matched nodes and their own text and cdata,
+ * and the current element, attributes and text can be accessed in it. 
+ * please do not call tb_xml_reader_next() in the path func.
+ *
+ * @param reader        the reader handle
+ * @return              tb_true or tb_false
+ *
+ * @note the stream will be reseted
+ *
+ * @code
+    static tb_bool_t tb_demo_path_func(tb_xml_reader_ref_t reader, tb_char_t const* path, tb_size_t event, tb_cpointer_t priv)
+    {
+        if (event == TB_XML_READER_EVENT_TEXT) tb_trace_i("%s: %s", path, tb_xml_reader_text(reader));
+        return tb_true;
+    }
+
+    tb_xml_reader_path_add(reader, "/config/name", tb_demo_path_func, tb_null);
+    tb_xml_reader_path_add(reader, "/config/server/port", tb_demo_path_func, tb_null);
+    tb_xml_reader_path_done(reader);
+ * @endcode
+ */
+tb_bool_t               tb_xml_reader_path_done(tb_xml_reader_ref_t reader);
+
 /*! load the xml 
  *
  * @param reader        the xml reader
@@ -253,6 +328,15 @@ tb_char_t const*        tb_xml_reader_charset(tb_xml_reader_ref_t reader);
  */
 tb_char_t const*        tb_xml_reader_element(tb_xml_reader_ref_t reader);
 
+/*! the current xml element name without copying
+ *
+ * @note the view points into the stream cache and is only valid until the next tb_xml_reader_next()
+ *
+ * @param reader        the xml reader
+ * @return              the current xml element name view
+ */
+tb_string_view_t        tb_xml_reader_element_view(tb_xml_reader_ref_t reader);
+
 /*! the current xml node text
  *
  * @param reader        the xml reader
@@ -260,6 +344,15 @@ tb_char_t const*        tb_xml_reader_element(tb_xml_reader_ref_t reader);
  */
 tb_char_t const*        tb_xml_reader_text(tb_xml_reader_ref_t reader);
 
+/*! the current xml node text without copying
+ *
+ * @note the view is only valid until the next tb_xml_reader_next()
+ *
+ * @param reader        the xml reader
+ * @return              the current xml node text view
+ */
+tb_string_view_t        tb_xml_reader_text_view(tb_xml_reader_ref_t reader);
+
 /*! the current xml node cdata
  *
  * @param reader        the xml reader
@@ -288,6 +381,18 @@ tb_char_t const*        tb_xml_reader_doctype(tb_xml_reader_ref_t reader);
  */
 tb_xml_node_ref_t       tb_xml_reader_attributes(tb_xml_reader_ref_t reader);
 
+/*! the current xml node attributes without copying
+ *
+ * @note the views are only valid until the next tb_xml_reader_next()
+ *
+ * @param reader        the xml reader
+ * @param attrs         the attribute views
+ * @param maxn          the attribute views maxn
+ *
+ * @return              the attributes count
+ */
+tb_size_t               tb_xml_reader_attributes_view(tb_xml_reader_ref_t reader, tb_xml_attribute_view_t* attrs, tb_size_t maxn);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -44,6 +44,9 @@
 #   define TB_XML_WRITER_ELEMENTS_GROW      (64)
 #endif
 
+// writ the constant string without formating it
+#define tb_xml_writer_writ_const(impl, s)   tb_stream_bwrit((impl)->stream, (tb_byte_t const*)(s), sizeof(s) - 1)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -68,6 +71,48 @@ typedef struct __tb_xml_writer_impl_t
 
 }tb_xml_writer_impl_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_void_t tb_xml_writer_writ_cstr(tb_xml_writer_impl_t* impl, tb_char_t const* s)
+{
+    // writ the string directly
+    tb_size_t n = s? tb_strlen(s) : 0;
+    if (n) tb_stream_bwrit(impl->stream, (tb_byte_t const*)s, n);
+}
+static tb_void_t tb_xml_writer_writ_tabs(tb_xml_writer_impl_t* impl, tb_size_t t)
+{
+    // the tabs
+    static tb_char_t const s_tabs[] = "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t";
+
+    // writ tabs
+    while (t)
+    {
+        tb_size_t n = tb_min(t, sizeof(s_tabs) - 1);
+        if (!tb_stream_bwrit(impl->stream, (tb_byte_t const*)s_tabs, n)) break;
+        t -= n;
+    }
+}
+static tb_void_t tb_xml_writer_writ_attributes(tb_xml_writer_impl_t* impl)
+{
+    // writ attributes: name="data"
+    if (tb_hash_map_size(impl->attributes))
+    {
+        tb_for_all (tb_hash_map_item_ref_t, item, impl->attributes)
+        {
+            if (item && item->name && item->data)
+            {
+                tb_xml_writer_writ_const(impl, " ");
+                tb_xml_writer_writ_cstr(impl, (tb_char_t const*)item->name);
+                tb_xml_writer_writ_const(impl, "=\"");
+                tb_xml_writer_writ_cstr(impl, (tb_char_t const*)item->data);
+                tb_xml_writer_writ_const(impl, "\"");
+            }
+        }
+        tb_hash_map_clear(impl->attributes);
+    }
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -282,8 +327,12 @@ tb_void_t tb_xml_writer_document(tb_xml_writer_ref_t writer, tb_char_t const* ve
     tb_xml_writer_impl_t* impl = (tb_xml_writer_impl_t*)writer;
     tb_assert_and_check_return(impl && impl->stream);
 
-    tb_stream_printf(impl->stream, "<?xml version=\"%s\" encoding=\"%s\"?>", version? version : "2.0", charset? charset : "utf-8");
-    if (impl->bformat) tb_stream_printf(impl->stream, "\n");
+    tb_xml_writer_writ_const(impl, "<?xml version=\"");
+    tb_xml_writer_writ_cstr(impl, version? version : "2.0");
+    tb_xml_writer_writ_const(impl, "\" encoding=\"");
+    tb_xml_writer_writ_cstr(impl, charset? charset : "utf-8");
+    tb_xml_writer_writ_const(impl, "\"?>");
+    if (impl->bformat) tb_xml_writer_writ_const(impl, "\n");
 }
 tb_void_t tb_xml_writer_document_type(tb_xml_writer_ref_t writer, tb_char_t const* type)
 {
@@ -291,8 +340,10 @@ tb_void_t tb_xml_writer_document_type(tb_xml_writer_ref_t writer, tb_char_t cons
     tb_xml_writer_impl_t* impl = (tb_xml_writer_impl_t*)writer;
     tb_assert_and_check_return(impl && impl->stream);
 
-    tb_stream_printf(impl->stream, "<!DOCTYPE %s>", type? type : "");
-    if (impl->bformat) tb_stream_printf(impl->stream, "\n");
+    tb_xml_writer_writ_const(impl, "<!DOCTYPE ");
+    tb_xml_writer_writ_cstr(impl, type);
+    tb_xml_writer_writ_const(impl, ">");
+    if (impl->bformat) tb_xml_writer_writ_const(impl, "\n");
 }
 tb_void_t tb_xml_writer_cdata(tb_xml_writer_ref_t writer, tb_char_t const* data)
 {
@@ -304,11 +355,13 @@ tb_void_t tb_xml_writer_cdata(tb_xml_writer_ref_t writer, tb_char_t const* data)
     if (impl->bformat)
     {
         tb_size_t t = tb_stack_size(impl->elements);
-        while (t--) tb_stream_printf(impl->stream, "\t");
+        tb_xml_writer_writ_tabs(impl, t);
     }
 
-    tb_stream_printf(impl->stream, "<![CDATA[%s]]>", data);
-    if (impl->bformat) tb_stream_printf(impl->stream, "\n");
+    tb_xml_writer_writ_const(impl, "<![CDATA[");
+    tb_xml_writer_writ_cstr(impl, data);
+    tb_xml_writer_writ_const(impl, "]]>");
+    if (impl->bformat) tb_xml_writer_writ_const(impl, "\n");
 }
 tb_void_t tb_xml_writer_text(tb_xml_writer_ref_t writer, tb_char_t const* text)
 {
@@ -320,11 +373,11 @@ tb_void_t tb_xml_writer_text(tb_xml_writer_ref_t writer, tb_char_t const* text)
     if (impl->bformat)
     {
         tb_size_t t = tb_stack_size(impl->elements);
-        while (t--) tb_stream_printf(impl->stream, "\t");
+        tb_xml_writer_writ_tabs(impl, t);
     }
 
-    tb_stream_printf(impl->stream, "%s", text);
-    if (impl->bformat) tb_stream_printf(impl->stream, "\n");
+    tb_xml_writer_writ_cstr(impl, text);
+    if (impl->bformat) tb_xml_writer_writ_const(impl, "\n");
 }
 tb_void_t tb_xml_writer_comment(tb_xml_writer_ref_t writer, tb_char_t const* comment)
 {
@@ -336,11 +389,13 @@ tb_void_t tb_xml_writer_comment(tb_xml_writer_ref_t writer, tb_char_t const* com
     if (impl->bformat)
     {
         tb_size_t t = tb_stack_size(impl->elements);
-        while (t--) tb_stream_printf(impl->stream, "\t");
+        tb_xml_writer_writ_tabs(impl, t);
     }
 
-    tb_stream_printf(impl->stream, "<!--%s-->", comment);
-    if (impl->bformat) tb_stream_printf(impl->stream, "\n");
+    tb_xml_writer_writ_const(impl, "<!--");
+    tb_xml_writer_writ_cstr(impl, comment);
+    tb_xml_writer_writ_const(impl, "-->");
+    if (impl->bformat) tb_xml_writer_writ_const(impl, "\n");
 }
 tb_void_t tb_xml_writer_element_empty(tb_xml_writer_ref_t writer, tb_char_t const* name)
 {
@@ -352,26 +407,19 @@ tb_void_t tb_xml_writer_element_empty(tb_xml_writer_ref_t writer, tb_char_t cons
     if (impl->bformat)
     {
         tb_size_t t = tb_stack_size(impl->elements);
-        while (t--) tb_stream_printf(impl->stream, "\t");
+        tb_xml_writer_writ_tabs(impl, t);
     }
 
     // writ name
-    tb_stream_printf(impl->stream, "<%s", name);
+    tb_xml_writer_writ_const(impl, "<");
+    tb_xml_writer_writ_cstr(impl, name);
 
     // writ attributes
-    if (tb_hash_map_size(impl->attributes))
-    {
-        tb_for_all (tb_hash_map_item_ref_t, item, impl->attributes)
-        {
-            if (item && item->name && item->data)
-                tb_stream_printf(impl->stream, " %s=\"%s\"", item->name, item->data);
-        }
-        tb_hash_map_clear(impl->attributes);
-    }
+    tb_xml_writer_writ_attributes(impl);
 
     // writ end
-    tb_stream_printf(impl->stream, "/>");
-    if (impl->bformat) tb_stream_printf(impl->stream, "\n");
+    tb_xml_writer_writ_const(impl, "/>");
+    if (impl->bformat) tb_xml_writer_writ_const(impl, "\n");
 }
 tb_void_t tb_xml_writer_element_enter(tb_xml_writer_ref_t writer, tb_char_t const* name)
 {
@@ -383,26 +431,19 @@ tb_void_t tb_xml_writer_element_enter(tb_xml_writer_ref_t writer, tb_char_t cons
     if (impl->bformat)
     {
         tb_size_t t = tb_stack_size(impl->elements);
-        while (t--) tb_stream_printf(impl->stream, "\t");
+        tb_xml_writer_writ_tabs(impl, t);
     }
 
     // writ name
-    tb_stream_printf(impl->stream, "<%s", name);
+    tb_xml_writer_writ_const(impl, "<");
+    tb_xml_writer_writ_cstr(impl, name);
 
     // writ attributes
-    if (tb_hash_map_size(impl->attributes))
-    {
-        tb_for_all (tb_hash_map_item_ref_t, item, impl->attributes)
-        {
-            if (item && item->name && item->data)
-                tb_stream_printf(impl->stream, " %s=\"%s\"", item->name, item->data);
-        }
-        tb_hash_map_clear(impl->attributes);
-    }
+    tb_xml_writer_writ_attributes(impl);
 
     // writ end
-    tb_stream_printf(impl->stream, ">");
-    if (impl->bformat) tb_stream_printf(impl->stream, "\n");
+    tb_xml_writer_writ_const(impl, ">");
+    if (impl->bformat) tb_xml_writer_writ_const(impl, "\n");
 
     // put name
     tb_stack_put(impl->elements, name);
@@ -418,15 +459,17 @@ tb_void_t tb_xml_writer_element_leave(tb_xml_writer_ref_t writer)
     {
         tb_size_t t = tb_stack_size(impl->elements);
         if (t) t--;
-        while (t--) tb_stream_printf(impl->stream, "\t");
+        tb_xml_writer_writ_tabs(impl, t);
     }
 
     // writ name
     tb_char_t const* name = (tb_char_t const*)tb_stack_top(impl->elements);
     tb_assert_and_check_return(name);
 
-    tb_stream_printf(impl->stream, "</%s>", name);
-    if (impl->bformat) tb_stream_printf(impl->stream, "\n");
+    tb_xml_writer_writ_const(impl, "</");
+    tb_xml_writer_writ_cstr(impl, name);
+    tb_xml_writer_writ_const(impl, ">");
+    if (impl->bformat) tb_xml_writer_writ_const(impl, "\n");
 
     // pop name
     tb_stack_pop(impl->elements);
@@ -437,8 +480,8 @@ tb_void_t tb_xml_writer_attributes_long(tb_xml_writer_ref_t writer, tb_char_t co
     tb_xml_writer_impl_t* impl = (tb_xml_writer_impl_t*)writer;
     tb_assert_and_check_return(impl && impl->attributes && name);
 
-    tb_char_t data[64] = {0};
-    tb_snprintf(data, 64, "%ld", value);
+    tb_char_t data[64];
+    tb_s64tos10(data, sizeof(data), value);
     tb_hash_map_insert(impl->attributes, name, data);
 }
 tb_void_t tb_xml_writer_attributes_bool(tb_xml_writer_ref_t writer, tb_char_t const* name, tb_bool_t value)
@@ -447,9 +490,7 @@ tb_void_t tb_xml_writer_attributes_bool(tb_xml_writer_ref_t writer, tb_char_t co
     tb_xml_writer_impl_t* impl = (tb_xml_writer_impl_t*)writer;
     tb_assert_and_check_return(impl && impl->attributes && name);
 
-    tb_char_t data[64] = {0};
-    tb_snprintf(data, 64, "%s", value? "true" : "false");
-    tb_hash_map_insert(impl->attributes, name, data);
+    tb_hash_map_insert(impl->attributes, name, value? "true" : "false");
 }
 tb_void_t tb_xml_writer_attributes_cstr(tb_xml_writer_ref_t writer, tb_char_t const* name, tb_char_t const* value)
 {